@@ -0,0 +1,70 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "utils/TextureCooker.hpp"
+
+// Offline texture cooker: pre-populates the KTX2 cache that
+// TextureArrayManager reads at startup, so even the first run of the app
+// skips JPEG decoding and mip generation.
+//
+//   cook [--size W H] [--cache DIR] [--rgba8] [--srgb|--normal|--linear] image...
+//
+// Without an explicit role flag the role is guessed from the file name
+// (COLOR/basecolor -> sRGB albedo, NORM/NRM/normal -> normal map). Textures
+// are block compressed the way TextureArrayManager samples them (BC7 sRGB
+// albedo, BC5 normals, BC4 single-channel maps); --rgba8 cooks the fallback
+// used on devices without BC support.
+static void guessRole(const std::string& name, TextureCookParams& params) {
+    auto has = [&](const char* s) { return name.find(s) != std::string::npos; };
+    params.srgb = has("COLOR") || has("basecolor") || has("_color");
+    params.normalMap = has("NORM") || has("NRM") || has("normal");
+}
+
+int main(int argc, char** argv) {
+    TextureCookParams params;
+    params.width = 1024;
+    params.height = 1024;
+    int forcedRole = -1; // -1 = guess, 0 = linear, 1 = srgb, 2 = normal
+    bool rgba8 = false;
+    size_t cooked = 0, hits = 0, failed = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 2 < argc) {
+            params.width = static_cast<uint32_t>(std::stoul(argv[++i]));
+            params.height = static_cast<uint32_t>(std::stoul(argv[++i]));
+            continue;
+        }
+        if (arg == "--cache" && i + 1 < argc) { TextureCooker::cacheDirectory = argv[++i]; continue; }
+        if (arg == "--linear") { forcedRole = 0; continue; }
+        if (arg == "--srgb") { forcedRole = 1; continue; }
+        if (arg == "--normal") { forcedRole = 2; continue; }
+        if (arg == "--rgba8") { rgba8 = true; continue; }
+
+        params.mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(params.width, params.height)))) + 1;
+        if (forcedRole < 0) {
+            guessRole(arg, params);
+        } else {
+            params.srgb = (forcedRole == 1);
+            params.normalMap = (forcedRole == 2);
+        }
+        params.format = rgba8 ? COOKED_FORMAT_RGBA8_UNORM : TextureCooker::blockFormatFor(params.srgb, params.normalMap);
+
+        CookedTexture out;
+        bool hit = false;
+        if (!TextureCooker::cook(arg.c_str(), params, out, &hit)) {
+            std::cerr << "cook: failed " << arg << std::endl;
+            ++failed;
+            continue;
+        }
+        ++cooked;
+        if (hit) ++hits;
+        std::cout << (hit ? "cached " : "cooked ") << arg
+                  << " (" << out.width << "x" << out.height << ", " << out.mipLevels() << " mips)" << std::endl;
+    }
+
+    std::cout << "cook: " << cooked << " textures (" << hits << " already cached), " << failed << " failed" << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,260 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "space/MeshSimplifier.hpp"
+#include "math/Geometry.hpp"
+#include "math/BoundingCube.hpp"
+
+// LoD geomorph triangles / quality benchmark (no GPU).
+//
+//   lodbench [--frames N] [--band W] [--cells C] [--height H]
+//
+// Flies a camera over a procedural heightfield and replays the slotted
+// renderer's band selection (indirect.comp) per root cell for a sweep of
+// lodBias values. Chunks are dual-grid heightfield patches (one vertex per
+// cell centre, like the Surface Nets tessellator) of C cells per side at
+// every level; their geomorph targets come from computeGeomorphTargets.
+// Every level switch is scored by the largest screen-space jump of a fine
+// vertex against the coarser level's surface, once with discrete switching
+// and once with the vertex shader's morph over the last W of the band.
+// Reports triangles per frame (before frustum culling), the screen-space
+// geometric error of the drawn levels and the pop size per bias.
+
+namespace {
+
+constexpr int MAX_LEVEL = 4;          // IndirectRenderer::MAX_LOD_LEVEL
+constexpr float BASE_CELL = 16.0f;    // frontier chunk side
+constexpr float ROOT_SIDE = BASE_CELL * (1 << MAX_LEVEL);
+constexpr float NEAR_PLANE = 0.5f;
+constexpr float FAR_PLANE = 2048.0f;
+constexpr uint32_t WARMUP_FRAMES = 60;
+
+float terrainHeight(float x, float z) {
+    return 40.0f * std::sin(x * 0.011f) * std::cos(z * 0.013f)
+         + 6.0f * std::sin(x * 0.031f + z * 0.023f)
+         + 1.5f * std::cos(x * 0.09f - z * 0.11f);
+}
+
+// Surface of a level with vertex spacing s: the terrain sampled at the cell
+// centres of a world-aligned grid, interpolated bilinearly.
+float levelHeight(float x, float z, float s) {
+    const float gx = x / s - 0.5f, gz = z / s - 0.5f;
+    const float ix = std::floor(gx), iz = std::floor(gz);
+    const float fx = gx - ix, fz = gz - iz;
+    auto sample = [s](float cx, float cz) { return terrainHeight((cx + 0.5f) * s, (cz + 0.5f) * s); };
+    const float h0 = sample(ix, iz) * (1.0f - fx) + sample(ix + 1.0f, iz) * fx;
+    const float h1 = sample(ix, iz + 1.0f) * (1.0f - fx) + sample(ix + 1.0f, iz + 1.0f) * fx;
+    return h0 * (1.0f - fz) + h1 * fz;
+}
+
+struct Options {
+    uint32_t frames = 1200;
+    float band = 0.3f;
+    uint32_t cells = 16;
+    uint32_t height = 720;
+};
+
+float levelSpacing(int level, uint32_t cells) {
+    return std::ldexp(BASE_CELL, level) / static_cast<float>(cells);
+}
+
+// One chunk at `level` with its min corner at (x0, z0). The chunk cube is
+// centred on the patch's height range so the border strip is the x/z rim.
+void buildChunk(int level, float x0, float z0, uint32_t cells, Geometry& geom, BoundingCube& cube) {
+    const float side = std::ldexp(BASE_CELL, level);
+    const float s = levelSpacing(level, cells);
+    geom.vertices.clear();
+    geom.indices.clear();
+    float hmin = 1e30f, hmax = -1e30f;
+    for (uint32_t j = 0; j < cells; ++j) {
+        for (uint32_t i = 0; i < cells; ++i) {
+            const float x = x0 + (i + 0.5f) * s, z = z0 + (j + 0.5f) * s;
+            const float y = terrainHeight(x, z);
+            hmin = std::min(hmin, y);
+            hmax = std::max(hmax, y);
+            geom.vertices.emplace_back(glm::vec3(x, y, z));
+        }
+    }
+    for (uint32_t j = 0; j + 1 < cells; ++j) {
+        for (uint32_t i = 0; i + 1 < cells; ++i) {
+            const uint32_t a = j * cells + i, b = a + 1, c = a + cells, d = c + 1;
+            geom.indices.insert(geom.indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    cube = BoundingCube(glm::vec3(x0, 0.5f * (hmin + hmax) - 0.5f * side, z0), side);
+}
+
+struct Pop {
+    float discrete = 0.0f;
+    float morphed = 0.0f;
+};
+
+// Largest on-screen jump when root (rx, rz) swaps `fineLevel` for the next
+// coarser level, with the fine mesh unmorphed and morphed by `t`.
+Pop scoreSwitch(int fineLevel, int rx, int rz, float t, const glm::vec3& camPos,
+                float pixelScale, uint32_t cells) {
+    Pop pop;
+    const int perSide = 1 << (MAX_LEVEL - fineLevel);
+    const float side = std::ldexp(BASE_CELL, fineLevel);
+    const float coarseSpacing = 2.0f * levelSpacing(fineLevel, cells);
+    Geometry geom;
+    BoundingCube cube;
+    for (int cz = 0; cz < perSide; ++cz) {
+        for (int cx = 0; cx < perSide; ++cx) {
+            buildChunk(fineLevel, rx * ROOT_SIDE + cx * side, rz * ROOT_SIDE + cz * side, cells, geom, cube);
+            computeGeomorphTargets(geom, cube, fineLevel, MAX_LEVEL);
+            for (const Vertex& v : geom.vertices) {
+                const float scale = pixelScale / std::max(glm::distance(camPos, v.position), NEAR_PLANE);
+                const float e0 = std::fabs(v.position.y - levelHeight(v.position.x, v.position.z, coarseSpacing));
+                const glm::vec3 p = v.position + unpackMorphDelta(v.morph) * t;
+                const float e1 = std::fabs(p.y - levelHeight(p.x, p.z, coarseSpacing));
+                pop.discrete = std::max(pop.discrete, e0 * scale);
+                pop.morphed = std::max(pop.morphed, e1 * scale);
+            }
+        }
+    }
+    return pop;
+}
+
+struct RootState {
+    int level;
+    float band;
+};
+
+struct Result {
+    float bias = 0.0f;
+    double trianglesSum = 0.0;
+    double geomErrSum = 0.0;
+    float geomErrMax = 0.0f;
+    uint64_t switches = 0;
+    double popSum[2] = {};
+    float popMax[2] = {};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--frames" && i + 1 < argc) { opt.frames = static_cast<uint32_t>(std::stoul(argv[++i])); continue; }
+        if (arg == "--band" && i + 1 < argc) { opt.band = std::stof(argv[++i]); continue; }
+        if (arg == "--cells" && i + 1 < argc) { opt.cells = std::max(2u, static_cast<uint32_t>(std::stoul(argv[++i]))); continue; }
+        if (arg == "--height" && i + 1 < argc) { opt.height = static_cast<uint32_t>(std::stoul(argv[++i])); continue; }
+        std::cerr << "usage: lodbench [--frames N] [--band W] [--cells C] [--height H]\n";
+        return 1;
+    }
+    opt.band = std::clamp(opt.band, 0.0f, 1.0f);
+
+    const float fovY = glm::radians(60.0f);
+    const float pixelScale = static_cast<float>(opt.height) / (2.0f * std::tan(fovY * 0.5f));
+    const double chunkTriangles = 2.0 * (opt.cells - 1) * (opt.cells - 1);
+
+    // Vertical error of each level against the terrain, sampled over a patch.
+    float levelError[MAX_LEVEL + 1] = {};
+    for (int l = 0; l <= MAX_LEVEL; ++l) {
+        const float s = levelSpacing(l, opt.cells);
+        for (float z = 0.0f; z < 512.0f; z += 1.0f)
+            for (float x = 0.0f; x < 512.0f; x += 1.0f)
+                levelError[l] = std::max(levelError[l], std::fabs(terrainHeight(x, z) - levelHeight(x, z, s)));
+    }
+
+    const float biases[] = {2.0f, 3.0f, 4.0f, 6.0f, 8.0f, 12.0f, 16.0f};
+    std::vector<Result> results;
+    for (float bias : biases) {
+        Result r;
+        r.bias = bias;
+        std::unordered_map<int64_t, RootState> roots;
+        uint32_t measured = 0;
+
+        for (uint32_t f = 0; f < opt.frames; ++f) {
+            float t = static_cast<float>(f) / 60.0f;
+            glm::vec3 camPos(t * 18.0f, 0.0f, 40.0f * std::sin(t * 0.3f));
+            camPos.y = terrainHeight(camPos.x, camPos.z) + 25.0f;
+            const bool measure = f >= WARMUP_FRAMES;
+
+            const int reach = static_cast<int>(std::ceil(FAR_PLANE / ROOT_SIDE));
+            const int cx = static_cast<int>(std::floor(camPos.x / ROOT_SIDE));
+            const int cz = static_cast<int>(std::floor(camPos.z / ROOT_SIDE));
+            double triangles = 0.0;
+            float frameErr = 0.0f;
+            for (int rz = cz - reach; rz <= cz + reach; ++rz) {
+                for (int rx = cx - reach; rx <= cx + reach; ++rx) {
+                    const glm::vec2 rootMin(rx * ROOT_SIDE, rz * ROOT_SIDE);
+                    const glm::vec3 anchor(rootMin.x + 0.5f * ROOT_SIDE, 0.5f * ROOT_SIDE, rootMin.y + 0.5f * ROOT_SIDE);
+                    const float band = glm::distance(camPos, anchor) / (BASE_CELL * bias);
+                    const int level = static_cast<int>(std::min(std::floor(band), static_cast<float>(MAX_LEVEL)));
+
+                    const glm::vec2 closest = glm::clamp(glm::vec2(camPos.x, camPos.z), rootMin, rootMin + ROOT_SIDE);
+                    const glm::vec3 nearest(closest.x, terrainHeight(closest.x, closest.y), closest.y);
+                    const float nearDist = glm::distance(camPos, nearest);
+                    if (nearDist > FAR_PLANE) continue;
+
+                    const int perSide = 1 << (MAX_LEVEL - level);
+                    triangles += chunkTriangles * perSide * perSide;
+                    frameErr = std::max(frameErr, levelError[level] * pixelScale / std::max(nearDist, NEAR_PLANE));
+
+                    const int64_t key = (static_cast<int64_t>(rx) << 32) ^ static_cast<uint32_t>(rz);
+                    auto it = roots.find(key);
+                    if (it != roots.end() && it->second.level != level && measure) {
+                        // The fine level's morph factor on the frame it was last
+                        // (or is first) drawn, as the vertex shader computes it.
+                        const int fine = std::min(it->second.level, level);
+                        const float fineBand = it->second.level < level ? it->second.band : band;
+                        float morphT = 0.0f;
+                        if (opt.band > 0.0f)
+                            morphT = std::clamp((fineBand - (fine + 1.0f - opt.band)) / opt.band, 0.0f, 1.0f);
+                        const Pop pop = scoreSwitch(fine, rx, rz, morphT, camPos, pixelScale, opt.cells);
+                        ++r.switches;
+                        r.popSum[0] += pop.discrete;
+                        r.popSum[1] += pop.morphed;
+                        r.popMax[0] = std::max(r.popMax[0], pop.discrete);
+                        r.popMax[1] = std::max(r.popMax[1], pop.morphed);
+                    }
+                    roots[key] = RootState{level, band};
+                }
+            }
+            if (measure) {
+                r.trianglesSum += triangles;
+                r.geomErrSum += frameErr;
+                r.geomErrMax = std::max(r.geomErrMax, frameErr);
+                ++measured;
+            }
+        }
+        measured = std::max(1u, measured);
+        r.trianglesSum /= measured;
+        r.geomErrSum /= measured;
+        results.push_back(r);
+    }
+
+    std::printf("frames %u  screen height %u px  %u cells/chunk  frontier chunk %.0f  geomorph band %.2f\n",
+                opt.frames, opt.height, opt.cells, BASE_CELL, opt.band);
+    std::printf("\n  bias   tris/frame   geom err px avg/max   switches   pop px discrete avg/max   pop px geomorph avg/max\n");
+    for (const Result& r : results) {
+        const double n = std::max<uint64_t>(1, r.switches);
+        std::printf("  %4.1f  %11.0f   %8.2f / %-8.2f   %8llu   %10.2f / %-10.2f   %10.2f / %-10.2f\n",
+                    r.bias, r.trianglesSum, r.geomErrSum, r.geomErrMax,
+                    static_cast<unsigned long long>(r.switches),
+                    r.popSum[0] / n, r.popMax[0], r.popSum[1] / n, r.popMax[1]);
+    }
+
+    // Lowest bias whose geomorphed pops stay within the discrete pops of the
+    // default bias (Settings::lodBias = 8).
+    const Result* reference = nullptr;
+    for (const Result& r : results) if (r.bias == 8.0f) reference = &r;
+    if (reference && reference->switches > 0) {
+        const double refPop = reference->popSum[0] / reference->switches;
+        for (const Result& r : results) {
+            if (r.switches == 0 || r.popSum[1] / r.switches > refPop) continue;
+            std::printf("\ngeomorph at bias %.1f pops no more than discrete bias 8.0 (avg %.2f px): %.0f%% of its triangles\n",
+                        r.bias, refPop, 100.0 * r.trianglesSum / std::max(1.0, reference->trianglesSum));
+            break;
+        }
+    }
+    return 0;
+}
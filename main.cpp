@@ -57,7 +57,11 @@
 #include "sdf/SweepSignedDistanceFunction.hpp"
 #include "utils/MainSceneLoader.hpp"
 #include "space/UniqueChangeCollector.hpp"
+#include "space/MeshSimplifier.hpp"
+#include "space/MeshOptimizer.hpp"
 #include "utils/Settings.hpp"
+#include "utils/TextureCooker.hpp"
+#include "utils/FileReader.hpp"
 #include "widgets/WidgetManager.hpp"
 #include "widgets/RadialMenu.hpp"
 #include "math/Camera.hpp"
@@ -89,13 +93,14 @@
 #include "services/TextureMixer.hpp"
 #include "services/BillboardService.hpp"
 #include "utils/ShadowParams.hpp"
+#include "utils/VirtualShadowMap.hpp"
 #include "space/ThreadPool.hpp"
 #include "space/Octree.hpp"
 
-// Build the {onAdded, onDeleted} renderer lambdas for one space. The main
-// scene drives the ChunkManager state machine and SDF debug markers; the
-// brush scene routes geometry to the separate brush queue and chunk maps
-// instead. Returns the pair of renderer-side lambdas; the caller wires them
+// Build the {onAdded, onDeleted, onAddedBatch} renderer lambdas for one
+// space. The main scene drives the ChunkManager state machine and SDF debug
+// markers; the brush scene routes geometry to the separate brush queue and
+// chunk maps instead. Returns the renderer-side lambdas; the caller wires them
 // behind a UniqueChangeCollector dedup stage and dispatches on the main
 // thread.
 //
@@ -123,10 +128,19 @@ struct PublishTarget {
     bool chunkManaged;
 };
 
-std::pair<Octree::OctreeNodeDataHandler, Octree::OctreeNodeDataHandler> build(SceneRenderer* renderer, VulkanApp* app, Scene* scene,
+// Renderer lambdas for one stream. onAdded/onDeleted do the per-node
+// bookkeeping during UniqueChangeCollector::dispatch; onAddedBatch then
+// re-meshes the whole dispatch's added set in one planned pass.
+struct ChangeHandlers {
+    Octree::OctreeNodeDataHandler onAdded;
+    Octree::OctreeNodeDataHandler onDeleted;
+    UniqueChangeCollector::BatchHandler onAddedBatch;
+};
+
+ChangeHandlers build(SceneRenderer* renderer, VulkanApp* app, Scene* scene,
               Layer layer, float minSize, ThreadPool* genPool, const PublishTarget& target) {
 
-    Octree::OctreeNodeDataHandler onAdded = [renderer, app, scene, layer, minSize, genPool, target](const OctreeNodeData& nd) {
+    Octree::OctreeNodeDataHandler onAdded = [renderer, scene, layer, target](const OctreeNodeData& nd) {
         NodeID nid = reinterpret_cast<NodeID>(nd.node);
         ChunkManager::ChunkId cid = static_cast<ChunkManager::ChunkId>(nid);
 
@@ -147,14 +161,17 @@ std::pair<Octree::OctreeNodeDataHandler, Octree::OctreeNodeDataHandler> build(Sc
                 renderer->world()->chunkManager().beginBuild(cid);
             }
         }
+    };
 
-        OctreeNodeData nodeCopy = nd;
-        // Single-mesh handler: each chunk emits exactly one LoDMesh and it is
-        // queued as its own entry — the consumer publishes it into the chunk's
-        // stable slot.
-        renderer->processNodeLayer(*scene, layer, nid, nodeCopy,
-            [renderer, cid, nodeCopy, target](Layer layer_, NodeID nid_, const Octree::LoDMesh& lodMesh) {
-                if (lodMesh.geom.vertices.empty() || lodMesh.geom.indices.empty()) {
+    UniqueChangeCollector::BatchHandler onAddedBatch = [renderer, scene, layer, minSize, genPool, target](std::vector<OctreeNodeData>& added) {
+        // Single-mesh handler: each ladder cell emits exactly one LoDMesh and
+        // it is queued as its own entry — the consumer publishes it into the
+        // chunk's stable slot.
+        renderer->processNodeBatch(*scene, layer, added,
+            [renderer, target](Layer layer_, NodeID nid_, const Octree::LoDMesh& lodMesh) {
+                const ChunkManager::ChunkId cid = static_cast<ChunkManager::ChunkId>(nid_);
+                const bool gpuMeshed = (lodMesh.brick != nullptr);
+                if (!gpuMeshed && (lodMesh.geom.vertices.empty() || lodMesh.geom.indices.empty())) {
                     return; // no surface: nothing to publish
                 }
                 if (target.chunkManaged && lodMesh.lod == 0) {
@@ -170,23 +187,40 @@ std::pair<Octree::OctreeNodeDataHandler, Octree::OctreeNodeDataHandler> build(Sc
                 // pushing again for the same node overwrites in place, so the
                 // last tessellation result wins). One shared queue for every
                 // stream — each entry is tagged brush vs main.
+                const OctreeNodeData emitting(reinterpret_cast<OctreeNode*>(nid_), lodMesh.key,
+                                              BoundingCube(lodMesh.boundsMin, lodMesh.cellSize), nullptr);
+                SceneRenderer::PendingMeshData entry{layer_, nid_, lodMesh, emitting, /*isBrush=*/!target.chunkManaged};
+                // Brick entries carry no CPU geometry: they are meshed by the
+                // Surface Nets kernel (no geomorph targets, emission order).
+                if (target.chunkManaged && layer_ == LAYER_OPAQUE && !gpuMeshed) {
+                    // Geomorph targets (main solid ladder only — the vertex
+                    // shader bands use the main IR's frontier cell size).
+                    const BoundingCube chunkCube(lodMesh.boundsMin, lodMesh.cellSize);
+                    computeGeomorphTargets(entry.lodMesh.geom, chunkCube, lodMesh.lod,
+                                           IndirectRenderer::MAX_LOD_LEVEL);
+                }
+                if (!gpuMeshed && renderer->meshOptimizationEnabled()) {
+                    // Cache/overdraw/fetch reorder, cluster-aligned so the
+                    // main-thread MeshClusters build keeps the order.
+                    optimizeMeshForGpu(entry.lodMesh.geom, MeshClusters::TRIANGLES_PER_CLUSTER);
+                }
                 std::lock_guard<std::mutex> lock(target.queueMutex);
-                target.meshData[nid_] = {layer_, nid_, lodMesh, nodeCopy, /*isBrush=*/!target.chunkManaged};
+                auto [slot, inserted] = target.meshData.try_emplace(nid_);
+                if (!inserted) {
+                    // The previous result was never drained: its tessellation
+                    // is wasted work.
+                    renderer->tessellationScheduler.noteWasted();
+                }
+                slot->second = std::move(entry);
             },
             minSize,
-            genPool);
+            genPool,
+            /*allowGpuMeshing=*/target.chunkManaged);
     };
 
-    Octree::OctreeNodeDataHandler onDeleted = [renderer, app, scene, target](const OctreeNodeData& nd) {
+    Octree::OctreeNodeDataHandler onDeleted = [renderer, app, target](const OctreeNodeData& nd) {
         NodeID nid = reinterpret_cast<NodeID>(nd.node);
 
-        // Forget the node's tessellation dedupe record: the node memory may be
-        // reused, and a stale entry would suppress re-tessellation of the new
-        // occupant.
-        if (auto* ls = dynamic_cast<LocalScene*>(scene)) {
-            ls->noteDeletedNode(static_cast<uintptr_t>(nid));
-        }
-
         if (target.chunkManaged && renderer->world()) {
             // One slot per chunk: defer the chunk's single slot until its
             // matching re-publish completes (or it ages out in
@@ -237,7 +271,7 @@ std::pair<Octree::OctreeNodeDataHandler, Octree::OctreeNodeDataHandler> build(Sc
             if (renderer->debugSDFRenderer) renderer->debugSDFRenderer->removeCubesForNode(nid);
         }
     };
-    return { onAdded, onDeleted };
+    return { onAdded, onDeleted, onAddedBatch };
 }
 
 class MyApp : public VulkanApp, public IEventHandler {
@@ -322,7 +356,13 @@ public:
     float brushAnimTime = 0.0f;
     // Last frame delta, forwarded to postSubmit for the per-frame brush rebuild
     float lastFrameDelta = 0.0f;
+    float autosaveTimer = 0.0f;
     ShadowParams shadowParams;
+    // Clipmapped virtual shadow map page state (Settings::shadowMode == 1)
+    VirtualShadowMap virtualShadowMap;
+    std::vector<VirtualShadowMap::PageRender> virtualShadowPages; // reused per frame
+    bool virtualShadowActive = false;
+    std::vector<ChunkManager::ChunkBounds> changedChunkRegions; // reused per frame
     // When user clicks "Apply Brush" from ImGui we defer the heavy rebuild
     // until after the current frame is submitted to avoid waiting on fences
     // while the frame is being recorded (causes deadlock). Set by UI,
@@ -351,11 +391,7 @@ public:
     // dispatch them after setup() returns.
     std::thread sceneProcessThread; // tessellates chunks after octree is built
 
-    // Pre-allocated descriptor pool+set rings to avoid per-frame create/destroy
     static constexpr uint32_t ASYNC_RING_SIZE = 3;
-    struct PoolSetPair { VkDescriptorPool pool; VkDescriptorSet set; };
-    PoolSetPair cachedBackfaceCompute[ASYNC_RING_SIZE]{};
-    uint32_t ringBackfaceCompute = 0;
 
 
     Octree::OctreeNodeDataHandler brushSolidAddHandler;
@@ -368,6 +404,11 @@ public:
     Octree::OctreeNodeDataHandler mainSolidRemoveHandler;
     Octree::OctreeNodeDataHandler mainLiquidRemoveHandler;
 
+    UniqueChangeCollector::BatchHandler brushSolidBatchHandler;
+    UniqueChangeCollector::BatchHandler brushLiquidBatchHandler;
+    UniqueChangeCollector::BatchHandler mainSolidBatchHandler;
+    UniqueChangeCollector::BatchHandler mainLiquidBatchHandler;
+
     UniqueChangeCollector mainSolidCollector;
     UniqueChangeCollector mainLiquidCollector;
     UniqueChangeCollector brushSolidCollector;
@@ -386,8 +427,8 @@ public:
         Buffer compact{};                          // cull output: VkDrawIndexedIndirectCommand[]
         Buffer visible{};                          // cull output: draw count (uint32_t)
         uint32_t compactCapacity = 0;              // elements `compact` can hold
-        VkDescriptorPool pool = VK_NULL_HANDLE;    // per-slot pool (maxSets=1)
-        VkDescriptorSet waterDs = VK_NULL_HANDLE;  // water-depth set, rewritten per task
+        uint32_t compactSlot = BindlessHeap::INVALID_INDEX; // bindless heap slots
+        uint32_t visibleSlot = BindlessHeap::INVALID_INDEX; // of the two buffers
     };
     BackfaceSlot cachedBackfaceRing[ASYNC_RING_SIZE]{};
     uint32_t ringBackface = 0;
@@ -400,11 +441,11 @@ public:
     Buffer cube360WaterCompact{};
     Buffer cube360WaterVisible{};
     VkDescriptorSet cube360GfxDs = VK_NULL_HANDLE;
-    VkDescriptorSet cube360ComputeDs = VK_NULL_HANDLE;
-    VkDescriptorSet cube360WaterComputeDs = VK_NULL_HANDLE;
-    std::array<VkBuffer, 5> cube360ComputeBuffers = {};
-    std::array<VkBuffer, 5> cube360WaterComputeBuffers = {};
-    uint32_t cube360TexVersion = 0;
+    // Bindless heap slots of the four cull outputs above
+    uint32_t cube360CompactSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t cube360VisibleSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t cube360WaterCompactSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t cube360WaterVisibleSlot = BindlessHeap::INVALID_INDEX;
 
     ~MyApp() {}
 
@@ -597,14 +638,8 @@ public:
         // Allocate GPU-side material storage via MaterialManager
         materialManager.allocate(materialCount, this);
         for (size_t i = 0; i < materialCount; ++i) materialManager.update(i, materials[i], this);
-
-        // The descriptor set was bound to a dummy buffer at SceneRenderer::init() time
-        // because materialManager hadn't been allocated yet (runs on a background thread).
-        // Now that the real buffer exists, rebind descriptor set binding 5 so the GPU
-        // reads from the actual materials SSBO.
-        if (sceneRenderer) {
-            sceneRenderer->updateTextureDescriptorSet(this, &textureArrayManager);
-        }
+        // SceneRenderer::writeFrameSlots moves the materials heap slot to the
+        // new buffer on the next frame.
 
     }
 
@@ -697,13 +732,14 @@ public:
         // minSize = tessellation frontier (MainSceneLoader default 30); the
         // octree walk emits cells at every ladder level (chunkLod 1..5) and
         // the GPU cull keeps the level matching the camera distance.
-        // build() creates the {onAdded, onDeleted} renderer lambdas for each
-        // main-scene space; the dedup collectors in front of them (fed to
-        // Scene::loadScene/action and Octree::apply) replay final per-node
-        // state into these handlers on the tessellation threads.
+        // build() creates the {onAdded, onDeleted, onAddedBatch} renderer
+        // lambdas for each main-scene space; the dedup collectors in front of
+        // them (fed to Scene::loadScene/action and Octree::apply) replay final
+        // per-node state into these handlers, then the added set into the
+        // batch handler, which re-meshes it on the generation pools.
         Scene* sceneForChanges = &world->scene();
         float minSize = 30.0f;
-        std::pair<Octree::OctreeNodeDataHandler,Octree::OctreeNodeDataHandler> mainOpaqueHandlers = build(
+        ChangeHandlers mainOpaqueHandlers = build(
             sceneRenderer, 
             this, 
             sceneForChanges, 
@@ -721,10 +757,11 @@ public:
                 true
             }
         );
-        mainSolidAddHandler = mainOpaqueHandlers.first;
-        mainSolidRemoveHandler = mainOpaqueHandlers.second;
+        mainSolidAddHandler = mainOpaqueHandlers.onAdded;
+        mainSolidRemoveHandler = mainOpaqueHandlers.onDeleted;
+        mainSolidBatchHandler = mainOpaqueHandlers.onAddedBatch;
 
-        std::pair<Octree::OctreeNodeDataHandler,Octree::OctreeNodeDataHandler> mainTransparentHandlers = build(
+        ChangeHandlers mainTransparentHandlers = build(
             sceneRenderer, 
             this, 
             sceneForChanges, 
@@ -741,10 +778,11 @@ public:
                 true
             }
         );
-        mainLiquidAddHandler = mainTransparentHandlers.first;
-        mainLiquidRemoveHandler = mainTransparentHandlers.second;
+        mainLiquidAddHandler = mainTransparentHandlers.onAdded;
+        mainLiquidRemoveHandler = mainTransparentHandlers.onDeleted;
+        mainLiquidBatchHandler = mainTransparentHandlers.onAddedBatch;
 
-        std::pair<Octree::OctreeNodeDataHandler,Octree::OctreeNodeDataHandler> brushOpaqueHandlers = build(
+        ChangeHandlers brushOpaqueHandlers = build(
             sceneRenderer,
             this, 
             world->brushScene(), 
@@ -761,10 +799,11 @@ public:
                 false
             }
         );
-        brushSolidAddHandler = brushOpaqueHandlers.first;
-        brushSolidRemoveHandler = brushOpaqueHandlers.second;
+        brushSolidAddHandler = brushOpaqueHandlers.onAdded;
+        brushSolidRemoveHandler = brushOpaqueHandlers.onDeleted;
+        brushSolidBatchHandler = brushOpaqueHandlers.onAddedBatch;
 
-        std::pair<Octree::OctreeNodeDataHandler,Octree::OctreeNodeDataHandler> brushTransparentHandlers = build(
+        ChangeHandlers brushTransparentHandlers = build(
             sceneRenderer,
             this, 
             world->brushScene(), 
@@ -781,14 +820,27 @@ public:
                 false
             }
         );
-        brushLiquidAddHandler = brushTransparentHandlers.first;
-        brushLiquidRemoveHandler = brushTransparentHandlers.second;
+        brushLiquidAddHandler = brushTransparentHandlers.onAdded;
+        brushLiquidRemoveHandler = brushTransparentHandlers.onDeleted;
+        brushLiquidBatchHandler = brushTransparentHandlers.onAddedBatch;
 
 
 
         // 5. Brush collectors are members; rebuildBrushScene feeds them via
         // apply and dispatches on the main thread.
 
+        // 6. Out-of-core paging for the main scene (budget in Settings; 0 =
+        // nothing is paged). Chunks meshed while paged out come back through
+        // the main collectors.
+        world->scene().enablePaging("cache/pages",
+            mainSolidCollector.updateHandler, mainLiquidCollector.updateHandler);
+        // 7. Autosave journal (interval in Settings; starts once the scene
+        // is saved or loaded).
+        world->scene().enableJournal();
+        // 8. Node re-layout once edits have fragmented the octree
+        // allocators (toggled in Settings).
+        world->scene().enableCompaction();
+
 
         // Scene starts empty — use File > Generate Map to populate it.
         if (octreeExplorerWidget)
@@ -803,15 +855,13 @@ public:
         setupVegetationTextures();
         setupTextures();
 
+        // Before init: the Surface Nets kernel is only built when enabled.
+        sceneRenderer->setGpuMeshing(settings.gpuMeshing);
         sceneRenderer->init(this, &textureArrayManager, &materialManager, waterParams);
 
         // Re-wire impostors now that VegetationRenderer::init() has stored the render pass.
         if (impostorService) impostorService->rewire();
 
-        // Keep the vegetation array manager wired for editor/atlas updates.
-        if (sceneRenderer->vegetationRenderer)
-            sceneRenderer->vegetationRenderer->setTextureArrayManager(&vegetationTextureArrayManager, this);
-
         // Bind billboard array textures (sampler2DArray per channel) to the vegetation renderer.
         if (sceneRenderer->vegetationRenderer && billboardCreator) {
             sceneRenderer->vegetationRenderer->setBillboardArrayTextures(
@@ -952,7 +1002,6 @@ public:
                 }
             };
         }
-        preAllocateAsyncDescriptorPools();
         // Try loading the default scene; fall back to procedural generation if it fails
         const std::string defaultScenePath = "scenes/default.scene";
         if (std::filesystem::exists(defaultScenePath)) {
@@ -969,8 +1018,6 @@ public:
     void setupVegetationTextures();
     // Move scene-loading into its own method for clarity
     void setupScene();
-    // Pre-allocate descriptor pool+set rings for async tasks
-    void preAllocateAsyncDescriptorPools();
     // Rebuild the brush preview scene from Brush3dWidget entries
     void rebuildBrushScene();
     // Apply the selected brush SDF to the main scene's octree on the selected layer
@@ -1026,7 +1073,28 @@ public:
             radialMenuVisible = radialMenuHandler->update(loadedTextureLayers);
         }
 
+        // Chunks whose live mesh changed since last frame invalidate the cached
+        // shadow cascades, virtual shadow pages and cubemap faces they overlap.
+        if (sceneRenderer && sceneRenderer->world()) {
+            changedChunkRegions.clear();
+            sceneRenderer->world()->chunkManager().takeChangedRegions(changedChunkRegions);
+            for (const auto& r : changedChunkRegions) {
+                glm::vec3 rMin(r.min[0], r.min[1], r.min[2]);
+                glm::vec3 rMax(r.max[0], r.max[1], r.max[2]);
+                shadowParams.markDirtyRegion(rMin, rMax);
+                virtualShadowMap.markDirtyRegion(rMin, rMax);
+                if (sceneRenderer->solid360Renderer) sceneRenderer->solid360Renderer->invalidateRegion(rMin, rMax);
+            }
+        }
         shadowParams.update(camera.getPosition(), light, camera.getViewProjectionMatrix(), settings.nearPlane, settings.farPlane);
+        {
+            // Pages are not re-rendered while the mode is off, so switching it
+            // back on starts from an empty pool.
+            bool virtualShadows = settings.enableShadows && settings.shadowMode == 1;
+            if (virtualShadows && !virtualShadowActive) virtualShadowMap.invalidateAll();
+            virtualShadowActive = virtualShadows;
+            virtualShadowMap.update(camera.getPosition(), light.getDirection(), settings.farPlane);
+        }
 
         // Drain the pending mesh queue populated by the background scene-loading
         // thread.  GPU uploads happen here on the main thread so newly generated
@@ -1034,6 +1102,33 @@ public:
         // Process pending meshes at a controlled rate (10 per frame).
         // Chunks closest to the camera are uploaded first. Drains both the
         // main scene and brush scene entries from the ONE shared queue.
+        if (sceneRenderer) {
+            // Re-ranks queued tessellation around the camera (throttled).
+            sceneRenderer->tessellationScheduler.setView(camera.getPosition(), camera.getViewProjectionMatrix());
+        }
+        if (world && !isLoading) {
+            // Pages idle chunks out past the budget and back in near the
+            // camera (throttled inside); restored chunks that were meshed
+            // while on disk re-mesh like a brush edit.
+            const LocalScene::PagingUpdate paging = world->scene().updatePaging(
+                camera.getPosition(), static_cast<size_t>(settings.octreeMemoryBudgetMB) << 20, settings.pagingDistance);
+            if (paging.opaqueRemeshed > 0) dispatchSolidEvents();
+            if (paging.transparentRemeshed > 0) dispatchLiquidEvents();
+        }
+        if (world && !isLoading && settings.octreeCompaction) {
+            // Starts a re-layout pass on the compactors' threads once edits
+            // have fragmented the allocators.
+            world->scene().updateCompaction();
+        }
+        if (world && !isLoading && settings.autosaveSeconds > 0) {
+            // Appends the chunks edited since the last autosave to the
+            // bundle's journal on a background thread.
+            autosaveTimer += deltaTime;
+            if (autosaveTimer >= static_cast<float>(settings.autosaveSeconds)) {
+                autosaveTimer = 0.0f;
+                world->scene().autosave(&settings, static_cast<size_t>(settings.journalCompactMB) << 20);
+            }
+        }
         if (sceneRenderer && !isLoading) {
             std::deque<SceneRenderer::PendingMeshData> pendingBatch;
             sceneRenderer->drainPendingMeshes(pendingBatch, 16);
@@ -1073,12 +1168,20 @@ public:
         if (sceneRenderer)
             sceneRenderer->streamer.update(this);
 
-        // Drain the CPU vegetation-generation queue so chunkBuffers is
-        // populated before preRenderPass records read barriers.  Must
+        // Upload the chunks the vegetation scatter workers have finished (up
+        // to a byte budget) before preRenderPass records read barriers.  Must
         // happen here because barriers cannot be emitted inside dynamic
         // rendering, and draw() runs inside beginPass/endPass.
         if (sceneRenderer && sceneRenderer->vegetationRenderer) {
-            sceneRenderer->vegetationRenderer->processPendingChunks(10);
+            sceneRenderer->vegetationRenderer->processPendingChunks(VegetationRenderer::UPLOAD_BYTES_PER_FRAME);
+        }
+
+        // Impostor layout changes re-create the capture arrays; missing
+        // billboard types are then captured one per frame.
+        if (impostorService) {
+            impostorService->configure(static_cast<ImpostorCapture::ViewLayout>(settings.impostorLayout),
+                                       static_cast<uint32_t>(settings.impostorGrid));
+            impostorService->update();
         }
 
         mainTime += deltaTime;
@@ -1258,6 +1361,21 @@ public:
             uboStatic.brushHSV = glm::vec4(brushHSV, 0.0f);
         }
 
+        sceneRenderer->setMeshOptimization(settings.optimizeChunkMeshes);
+        sceneRenderer->setGpuMeshing(settings.gpuMeshing);
+        if (world) {
+            world->scene().setLadderSimplifier(settings.ladderSimplifier == 1
+                ? LocalScene::LadderSimplifier::Quadric : LocalScene::LadderSimplifier::Octree);
+        }
+
+        // LoD params for the geomorph vertex shader: the same band test as the
+        // GPU cull (frontier cell size of the published solid chunks, lodBias).
+        uboStatic.lodParams = glm::vec4(
+            sceneRenderer->mainSolidRenderer->getIndirectRenderer().getFrontierCellSize(),
+            settings.lodBias,
+            settings.geomorphBand,
+            static_cast<float>(IndirectRenderer::MAX_LOD_LEVEL));
+
         // Reset command buffer state tracker and wire it to all sub-renderers.
         // NOTE: backFaceRenderer and the water IndirectRenderer are deliberately
         // excluded by SceneRenderer::setCmdState — they are accessed by the
@@ -1266,6 +1384,12 @@ public:
         sceneRenderer->frameCmdState.reset();
         sceneRenderer->setCmdState(&sceneRenderer->frameCmdState);
 
+        // Bindless heap slots for this frame (texture arrays, shadow maps,
+        // scene targets, materials), then bind the heap once: every scene
+        // pipeline layout shares it at set 1.
+        sceneRenderer->writeFrameSlots(this, uboStatic, frameIdx);
+        bindBindlessHeap(commandBuffer);
+
         // ── GPU culling: must run BEFORE shadow pass so drawPrepared has
         // current-frame compact/visibleCount buffers populated. ──
         if (profilingEnabled && queryPools[frameIdx] != VK_NULL_HANDLE)
@@ -1296,7 +1420,23 @@ public:
         if (profilingEnabled && queryPools[frameIdx] != VK_NULL_HANDLE)
             vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPools[frameIdx], 0);
         if (sceneRenderer) {
-            sceneRenderer->shadowMapper->render(this, commandBuffer, frameIdx, sceneRenderer->mainUniformBuffers[frameIdx], uboStatic, settings.enableShadows, settings.renderSolid, settings.vegetationEnabled, settings.shadowTessellationEnabled, settings.lodBias, camera.getPosition());
+            VirtualShadowRenderer& vsmRenderer = *sceneRenderer->virtualShadowRenderer;
+            if (virtualShadowActive) {
+                // Pages requested by this slot's last mark pass, then the
+                // newly allocated / dirty pages within the per-frame budget.
+                vsmRenderer.collectRequests(frameIdx, virtualShadowMap);
+                uint32_t budget = static_cast<uint32_t>(std::clamp(settings.virtualShadowPageBudget, 1,
+                    static_cast<int>(ShadowRenderer::MAX_VIRTUAL_PAGES_PER_FRAME)));
+                virtualShadowPages.clear();
+                virtualShadowMap.takeRenderBatch(budget, virtualShadowPages);
+                vsmRenderer.uploadPageTable(commandBuffer, frameIdx, virtualShadowMap, true);
+                sceneRenderer->shadowMapper->renderVirtualPages(this, commandBuffer, frameIdx, sceneRenderer->mainUniformBuffers[frameIdx], uboStatic, virtualShadowMap, virtualShadowPages, vsmRenderer, settings.renderSolid, settings.vegetationEnabled, settings.shadowTessellationEnabled, settings.lodBias, camera.getPosition());
+            } else {
+                vsmRenderer.uploadPageTable(commandBuffer, frameIdx, virtualShadowMap, false);
+                sceneRenderer->shadowMapper->setParallelRecording(settings.parallelShadowRecording);
+                sceneRenderer->shadowMapper->setCascadeRenderMask(shadowParams.cascadeRenderMask());
+                sceneRenderer->shadowMapper->render(this, commandBuffer, frameIdx, sceneRenderer->mainUniformBuffers[frameIdx], uboStatic, settings.enableShadows, settings.renderSolid, settings.vegetationEnabled, settings.shadowTessellationEnabled, settings.lodBias, camera.getPosition());
+            }
         }
         if (profilingEnabled && queryPools[frameIdx] != VK_NULL_HANDLE)
             vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPools[frameIdx], 1);
@@ -1374,20 +1514,21 @@ public:
             ubo360.materialFlags.x = 1.0f; // skipEnvMap flag
 
             auto tCubemap = std::chrono::high_resolution_clock::now();
+            this->sceneRenderer->solid360Renderer->setFaceBudget(
+                static_cast<uint32_t>(std::max(settings.cubemapFacesPerFrame, 1)),
+                static_cast<Solid360Renderer::FaceUpdateMode>(settings.cubemapUpdateMode));
+            this->sceneRenderer->solid360Renderer->setParallelRecording(settings.parallelCubemapRecording);
             this->sceneRenderer->solid360Renderer->render(
                 this, commandBuffer,
                 this->sceneRenderer->skyRenderer.get(), this->sceneRenderer->getSkySettings().mode,
                 this->sceneRenderer->mainSolidRenderer.get(),
                 cube360GfxDs,
-                this->sceneRenderer->brushRenderer->getDepthDescriptorSet(frameIdx),
                 cube360UBO, ubo360,
                 settings.renderSolid, waterEnabled,
-                cube360ComputeDs,
-                cube360Compact.buffer,
-                cube360Visible.buffer,
-                cube360WaterComputeDs,
-                cube360WaterCompact.buffer,
-                cube360WaterVisible.buffer,
+                cube360Compact.buffer, cube360CompactSlot,
+                cube360Visible.buffer, cube360VisibleSlot,
+                cube360WaterCompact.buffer, cube360WaterCompactSlot,
+                cube360WaterVisible.buffer, cube360WaterVisibleSlot,
                 frameIdx);
             this->profileSolid360 = std::chrono::duration<float, std::milli>(
                 std::chrono::high_resolution_clock::now() - tCubemap).count();
@@ -1508,8 +1649,7 @@ public:
 
             // Solid geometry color (LESS_OR_EQUAL, no depth write)
             if (settings.renderSolid) {
-                VkDescriptorSet brushDepthSet = sceneRenderer->brushRenderer->getDepthDescriptorSet(frameIdx);
-                sceneRenderer->mainSolidRenderer->drawColor(commandBuffer, this, getMainDescriptorSet(), brushDepthSet);
+                sceneRenderer->mainSolidRenderer->drawColor(commandBuffer, this, getMainDescriptorSet());
             }
 
             if (profilingEnabled && queryPools[frameIdx] != VK_NULL_HANDLE)
@@ -1623,6 +1763,16 @@ public:
                 setImageLayoutTracked(solidDepthImg, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
         }
 
+        // Virtual shadow pages the camera depth needs; read back when this
+        // frame slot comes round again.
+        if (virtualShadowActive && sceneRenderer) {
+            sceneRenderer->virtualShadowRenderer->recordMarkPages(commandBuffer, frameIdx,
+                sceneRenderer->mainSolidRenderer->getDepthView(frameIdx),
+                glm::inverse(uboStatic.viewProjection),
+                static_cast<uint32_t>(getWidth()), static_cast<uint32_t>(getHeight()),
+                virtualShadowMap);
+        }
+
         // If water is disabled, clear its offscreen targets here (outside any active
         // dynamic rendering instance) so the post-process compositor won't sample
         // stale content.
@@ -1673,132 +1823,39 @@ public:
                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
                     slot.compactCapacity = numCmds;
+                    slot.compactSlot = app->getBindlessHeap().replaceBuffer(slot.compactSlot, slot.compact.buffer);
                 }
                 if (slot.visible.buffer == VK_NULL_HANDLE) {
                     slot.visible = app->createBuffer(sizeof(uint32_t),
                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-                }
-
-                VkDevice dev = app->getDevice();
-                auto lazyComputeSlot = [&](PoolSetPair* ring, uint32_t& idx, VkDescriptorSetLayout layout, const char* label) -> PoolSetPair& {
-                    auto& s = ring[idx++ % ASYNC_RING_SIZE];
-                    if (s.pool != VK_NULL_HANDLE) return s;
-                    if (layout == VK_NULL_HANDLE) return s;
-                    VkDescriptorPoolSize ps{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 };
-                    VkDescriptorPoolCreateInfo pci{};
-                    pci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-                    pci.poolSizeCount = 1; pci.pPoolSizes = &ps; pci.maxSets = 1;
-                    pci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
-                    vkCreateDescriptorPool(dev, &pci, nullptr, &s.pool);
-                    app->resources.addDescriptorPool(s.pool, label);
-                    VkDescriptorSetAllocateInfo ai{};
-                    ai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-                    ai.descriptorPool = s.pool; ai.descriptorSetCount = 1; ai.pSetLayouts = &layout;
-                    vkAllocateDescriptorSets(dev, &ai, &s.set);
-                    app->resources.addDescriptorSet(s.set, label);
-                    return s;
-                };
-                VkDescriptorSet computeDs = VK_NULL_HANDLE;
-                {
-                    VkDescriptorSetLayout bfLayout = ind.getComputeDescriptorSetLayout();
-                    auto& dsSlot = lazyComputeSlot(cachedBackfaceCompute, ringBackfaceCompute, bfLayout, "Lazy cachedBackfaceCompute");
-                    computeDs = dsSlot.set;
-                }
-
-                // Update descriptor set with buffers: inCmds, outCmds, bounds,
-                // visibleCount, visibleLods (binding 4 = persistent scratch).
-                if (computeDs != VK_NULL_HANDLE) {
-                    DescriptorWriter(dev)
-                        .writeBuffer(computeDs, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                     ind.getIndirectBuffer().buffer, 0, VK_WHOLE_SIZE)
-                        .writeBuffer(computeDs, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                     slot.compact.buffer, 0, VK_WHOLE_SIZE)
-                        .writeBuffer(computeDs, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                     ind.getBoundsBuffer().buffer, 0, VK_WHOLE_SIZE)
-                        .writeBuffer(computeDs, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                     slot.visible.buffer, 0, VK_WHOLE_SIZE)
-                        .writeBuffer(computeDs, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                     ind.getVisibleLodsScratchBuffer(), 0, VK_WHOLE_SIZE)
-                        .flush();
+                    slot.visibleSlot = app->getBindlessHeap().registerBuffer(slot.visible.buffer);
                 }
 
                 // Run cull into per-task buffers - only when compute pipeline is ready (meshes loaded)
-                if (computeDs != VK_NULL_HANDLE) {
-                    ind.prepareCullWithDescriptor(cmd, viewProj, computeDs, slot.compact.buffer, slot.visible.buffer,
-                                                  camera.getPosition());
-                }
-
-                // Water-depth descriptor set for THIS task: pre-allocated per ring slot
-                // and rewritten each frame before submission. Reuse is safe because the
-                // slot's previous submission, which bound this set on the GPU, has
-                // completed before we rewrite it (see the cachedBackfaceRing comment).
-                // A dedicated set per slot keeps the async back-face pass from sharing
-                // the per-frame set with the main command buffer (which would require
-                // UPDATE_AFTER_BIND and trip GPU-assisted validation's descriptor-count
-                // check).
-                VkDescriptorSet asyncWaterDs = VK_NULL_HANDLE;
-                {
-                    VkImageView bfBack = (this->sceneRenderer->backFaceRenderer) ? this->sceneRenderer->backFaceRenderer->getBackFaceDepthView(frameIdx) : VK_NULL_HANDLE;
-                    VkImageView bfCube = (this->sceneRenderer->solid360Renderer) ? this->sceneRenderer->solid360Renderer->getSolid360View() : VK_NULL_HANDLE;
-                    VkDescriptorSetLayout wdsLayout = this->sceneRenderer->mainLiquidRenderer->getWaterDepthDescriptorSetLayout();
-                    if (wdsLayout != VK_NULL_HANDLE && bfBack != VK_NULL_HANDLE && bfCube != VK_NULL_HANDLE) {
-                        if (slot.pool == VK_NULL_HANDLE) {
-                            // Per-slot pool (maxSets=1) so the set is allocated once and
-                            // rewritten every task; flags mirror the renderer's async
-                            // pool (the water-depth layout has no UPDATE_AFTER_BIND
-                            // bindings, so none is required here).
-                            VkDescriptorPoolSize ps{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 5 };
-                            VkDescriptorPoolCreateInfo pci{};
-                            pci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-                            pci.poolSizeCount = 1; pci.pPoolSizes = &ps; pci.maxSets = 1;
-                            pci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-                            if (vkCreateDescriptorPool(dev, &pci, nullptr, &slot.pool) == VK_SUCCESS) {
-                                app->resources.addDescriptorPool(slot.pool, "cachedBackfaceWaterDepth pool");
-                                VkDescriptorSetAllocateInfo ai{};
-                                ai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-                                ai.descriptorPool = slot.pool; ai.descriptorSetCount = 1; ai.pSetLayouts = &wdsLayout;
-                                if (vkAllocateDescriptorSets(dev, &ai, &slot.waterDs) != VK_SUCCESS) {
-                                    slot.waterDs = VK_NULL_HANDLE; // retried on a later task
-                                } else {
-                                    app->resources.addDescriptorSet(slot.waterDs, "cachedBackfaceWaterDepth DS");
-                                }
-                            }
-                        }
-                        if (slot.waterDs != VK_NULL_HANDLE) {
-                            VkImageView bfColor = this->sceneRenderer->mainSolidRenderer->getColorView(frameIdx);
-                            VkImageView bfDepth = this->sceneRenderer->mainSolidRenderer->getDepthView(frameIdx);
-                            VkImageView bfSky   = (this->sceneRenderer->skyRenderer) ? this->sceneRenderer->skyRenderer->getSkyView(frameIdx) : VK_NULL_HANDLE;
-                            this->sceneRenderer->mainLiquidRenderer->updateSceneTexturesBinding(this, slot.waterDs, bfColor, bfDepth, frameIdx, bfSky, bfBack, bfCube);
-                            asyncWaterDs = slot.waterDs;
-                        }
-                    }
-                }
-
-                // Patch binding #3 to the dummy depth to avoid the back-face
-                // pass reading-from the same image it writes-to as depth
-                // attachment (SYNC-HAZARD READ_AFTER_WRITE).
-                if (asyncWaterDs != VK_NULL_HANDLE) {
-                    WaterBackFaceRenderer* bfr = this->sceneRenderer->backFaceRenderer.get();
-                    if (bfr && bfr->getDummyDepthView() != VK_NULL_HANDLE) {
-                        bfr->patchBinding3(asyncWaterDs, bfr->getDummyDepthView());
-                    }
+                const bool culled = ind.isCullReady() &&
+                    slot.compactSlot != BindlessHeap::INVALID_INDEX && slot.visibleSlot != BindlessHeap::INVALID_INDEX;
+                if (culled) {
+                    ind.prepareCullWithSlots(cmd, viewProj, slot.compact.buffer, slot.compactSlot,
+                                             slot.visible.buffer, slot.visibleSlot, camera.getPosition());
                 }
 
                 // Render back-face pass using this slot's (ring-reused) compact/visible
-                // buffers so draws consume the cull results
+                // buffers so draws consume the cull results. The water stages read
+                // the scene depth through the heap; the back-face tessellation
+                // variant skips the back-face depth this pass writes.
                 auto tBackface = std::chrono::high_resolution_clock::now();
+                app->bindBindlessHeap(cmd);
                 this->sceneRenderer->backFaceRenderer->render(app, cmd, frameIdx,
                                             ind,
                                             this->sceneRenderer->mainLiquidRenderer->getWaterGeometryPipelineLayout(),
                                             app->getMainDescriptorSet(),
-                                            asyncWaterDs,
-                                            (computeDs != VK_NULL_HANDLE) ? slot.compact.buffer : VK_NULL_HANDLE,
-                                            (computeDs != VK_NULL_HANDLE) ? slot.visible.buffer : VK_NULL_HANDLE);
+                                            culled ? slot.compact.buffer : VK_NULL_HANDLE,
+                                            culled ? slot.visible.buffer : VK_NULL_HANDLE);
 
                 this->profileBackface = std::chrono::duration<float, std::milli>(
                     std::chrono::high_resolution_clock::now() - tBackface).count();
-                // Submit. The ring slot's buffers/set are NOT defer-destroyed: they are
+                // Submit. The ring slot's buffers are NOT defer-destroyed: they are
                 // reused ASYNC_RING_SIZE tasks later, by which time this submission has
                 // completed (guaranteed by the frame-fence chain described on
                 // cachedBackfaceRing). Use submitCommandBufferAsyncToQueue on the
@@ -1917,6 +1974,12 @@ public:
                 size_t opaqueLoaded = sceneRenderer->mainSolidRenderer->getIndirectRenderer().getMeshCount();
                 uint32_t opaqueVisible = sceneRenderer->mainSolidRenderer->getIndirectRenderer().readVisibleCount(this);
                 ImGui::Text("Opaque - Loaded (GPU): %zu  Visible (GPU cull): %u", opaqueLoaded, opaqueVisible);
+                if (sceneRenderer->mainSolidRenderer->getIndirectRenderer().isClusterCullingActive()) {
+                    auto clusterStats = sceneRenderer->mainSolidRenderer->getIndirectRenderer().readClusterCullStats();
+                    ImGui::Text("Opaque Triangles - Submitted: %u  Visible (cluster cull): %u  Clusters: %u",
+                                clusterStats.submittedTriangles, clusterStats.visibleTriangles,
+                                clusterStats.visibleClusters);
+                }
                 size_t opaqueTracked = sceneRenderer ? sceneRenderer->getRegisteredModelCount() : 0;
                 ImGui::Text("Opaque Models Tracked: %zu", opaqueTracked);
 
@@ -1933,6 +1996,31 @@ public:
                 ImGui::Text("Vegetation Chunks: %zu", vegChunks);
                 ImGui::Text("Vegetation Instances: %zu", vegInstances);
 
+                // Tessellation scheduling
+                const TessellationScheduler::Counters tess = sceneRenderer->tessellationScheduler.counters();
+                ImGui::Text("Tessellations - Meshed: %llu  Cancelled: %llu  Wasted: %llu",
+                            static_cast<unsigned long long>(tess.meshed),
+                            static_cast<unsigned long long>(tess.cancelled),
+                            static_cast<unsigned long long>(tess.wasted));
+
+                // Out-of-core paging
+                if (world) {
+                    const OctreePager::Stats solidPages = world->scene().pagingStats(LAYER_OPAQUE);
+                    const OctreePager::Stats liquidPages = world->scene().pagingStats(LAYER_TRANSPARENT);
+                    ImGui::Text("Octree Chunks - Resident: %zu  Evicted: %zu  Unreadable: %zu  (%.1f MB in RAM)",
+                                solidPages.residentChunks + liquidPages.residentChunks,
+                                solidPages.evictedChunks + liquidPages.evictedChunks,
+                                solidPages.unreadablePages + liquidPages.unreadablePages,
+                                (solidPages.residentBytes + liquidPages.residentBytes) / (1024.0 * 1024.0));
+                    const OctreeCompactor::Stats solidCompaction = world->scene().compactionStats(LAYER_OPAQUE);
+                    const OctreeCompactor::Stats liquidCompaction = world->scene().compactionStats(LAYER_TRANSPARENT);
+                    ImGui::Text("Octree Compaction - Passes: %llu  Chunks: %llu  Pending: %zu  Blocks Released: %llu",
+                                static_cast<unsigned long long>(solidCompaction.passes + liquidCompaction.passes),
+                                static_cast<unsigned long long>(solidCompaction.unitsCompacted + liquidCompaction.unitsCompacted),
+                                solidCompaction.pendingUnits + liquidCompaction.pendingUnits,
+                                static_cast<unsigned long long>(solidCompaction.releasedBlocks + liquidCompaction.releasedBlocks));
+                }
+
               
                 if (profilingEnabled) {
                     ImGui::Separator();
@@ -1942,6 +2030,20 @@ public:
                                      profileVegetationImpostor + profileWater +
                                      profilePostProcess + profileImGui;
                     ImGui::Text("Shadow:        %.2f", profileShadow);
+                    if (sceneRenderer && sceneRenderer->shadowMapper) {
+                        uint32_t rendered = sceneRenderer->shadowMapper->getRenderedCascadeMask();
+                        ImGui::Text("  cascades %c%c%c  draws %u",
+                                    (rendered & 1u) ? '0' : '-', (rendered & 2u) ? '1' : '-', (rendered & 4u) ? '2' : '-',
+                                    sceneRenderer->shadowMapper->getDrawCallCount());
+                        if (virtualShadowActive) {
+                            const VirtualShadowMap::Stats& vs = virtualShadowMap.stats();
+                            ImGui::Text("  pages %u/%u res  %u req  %u drawn  %u evict",
+                                        vs.residentPages, virtualShadowMap.config().physicalPages,
+                                        vs.requestedPages, sceneRenderer->shadowMapper->getRenderedPageCount(),
+                                        vs.evictions);
+                            ImGui::Text("  atlas %.1f MB", sceneRenderer->virtualShadowRenderer->getGpuBytes() / (1024.0 * 1024.0));
+                        }
+                    }
                     ImGui::Text("GPU Cull:      %.2f", profileMainCull);
                     ImGui::Text("Brush:         %.2f", profileBrush);
                     ImGui::Text("Depth Prepass: %.2f", profileDepthPrepass);
@@ -1954,8 +2056,13 @@ public:
                     ImGui::Text("--- GPU Total:  %.2f ---", gpuTotal);
                     ImGui::Separator();
                     ImGui::Text("--- CPU Timing (ms) ---");
-                    ImGui::Text("Solid360*:     %.2f", profileSolid360);
+                    ImGui::Text("Solid360*:     %.2f (%u faces)", profileSolid360,
+                                sceneRenderer && sceneRenderer->solid360Renderer
+                                    ? sceneRenderer->solid360Renderer->getFacesRenderedLastFrame() : 0u);
                     ImGui::Text("Backface*:     %.2f", profileBackface);
+                    if (sceneRenderer && sceneRenderer->shadowMapper) {
+                        ImGui::Text("Shadow Rec:    %.2f", sceneRenderer->shadowMapper->getRecordWallMs());
+                    }
                     ImGui::Text("* = CPU-timed (async)");
                     ImGui::Separator();
                     ImGui::Text("FPS:           %.1f", profileFps);
@@ -2176,9 +2283,8 @@ public:
                 queryPools[f] = VK_NULL_HANDLE;
             }
         }
-        // Pre-allocated ring pools are tracked by VulkanResourceManager, so
+        // Ring buffers are tracked by VulkanResourceManager, so
         // resources.cleanup() will destroy them. Just zero our arrays.
-        for (auto& slot : cachedBackfaceCompute) slot = {};
         for (auto& slot : cachedBackfaceRing) slot = {};
 
         // NOTE: Vulkan-owned objects for global managers are now cleaned up by
@@ -2187,6 +2293,11 @@ public:
         // double-destruction ordering issues. If a manager needs CPU-only
         // cleanup, add a dedicated method and call it here.
 
+        // Drop texture-layer jobs that were queued but never submitted (CPU-only;
+        // the device is idle so nothing is in flight any more).
+        textureArrayManager.uploadQueue.destroy();
+        vegetationTextureArrayManager.uploadQueue.destroy();
+
         // Delete scene objects while the Vulkan device is still alive. Their
         // destructors (TerrainStreamer → UploadManager → MPSCQueue) must not
         // run after vkDestroyDevice().
@@ -2401,9 +2512,11 @@ void MyApp::setupVegetationTextures() {
     // Provide VulkanApp to the creator so it can initialize GPU-backed preview textures
     billboardCreator->setVulkanApp(this);
     impostorService = std::make_shared<ImpostorService>();
-    // Must be set before init(): the capture pipeline shares the renderer's
-    // set=2 wind params descriptor set/layout instead of duplicating them.
+    // Must be set before init(): the capture pipeline reads the renderer's
+    // wind params and billboard arrays through their heap slots.
     impostorService->setVegetationRenderer(sceneRenderer->vegetationRenderer.get());
+    impostorService->configure(static_cast<ImpostorCapture::ViewLayout>(settings.impostorLayout),
+                               static_cast<uint32_t>(settings.impostorGrid));
     impostorService->init(this);
     impostorWidget = std::make_shared<ImpostorWidget>(impostorService);
     impostorWidget->setVegetationRenderer(sceneRenderer->vegetationRenderer.get());
@@ -2501,60 +2614,37 @@ void MyApp::setupVegetationTextures() {
         );
     }
 
-    // Notify ImpostorService about the freshly baked texture arrays.
+    // Notify ImpostorService about the freshly baked texture arrays. Each
+    // billboard's content key (layers + source atlas bytes) selects its entry
+    // in the impostor disk cache, so unchanged billboards are not re-captured.
     if (impostorService && billboardCreator) {
+        std::vector<uint64_t> atlasHashes;
+        for (const TextureTriple& triple : vegTriples) {
+            uint64_t h = TextureCooker::hashBytes(nullptr, 0);
+            for (const char* path : { triple.albedo, triple.normal, triple.bump }) {
+                try {
+                    std::vector<char> bytes = FileReader::readFile(path);
+                    h = TextureCooker::hashBytes(bytes.data(), bytes.size(), h);
+                } catch (const std::exception&) {
+                    // Missing source: the default layer colour is hashed as "nothing"
+                }
+            }
+            atlasHashes.push_back(h);
+        }
+        std::vector<uint64_t> contentKeys;
+        for (size_t i = 0; i < billboardManager.getBillboardCount(); ++i) {
+            const Billboard* billboard = billboardManager.getBillboard(i);
+            contentKeys.push_back(billboard
+                ? ImpostorService::billboardContentKey(*billboard, vegetationAtlasManager, atlasHashes)
+                : 0);
+        }
         impostorService->setSource(
             billboardCreator->getAlbedoArrayView(),
             billboardCreator->getNormalArrayView(),
             billboardCreator->getOpacityArrayView(),
             billboardCreator->getArraySampler(),
-            static_cast<int>(billboardManager.getBillboardCount()));
-    }
-}
-
-// Implementation: pre-allocate descriptor pool+set rings for async tasks
-void MyApp::preAllocateAsyncDescriptorPools() {
-    VkDevice dev = getDevice();
-
-    auto allocateComputeRing = [&](PoolSetPair* ring, VkDescriptorSetLayout dsLayout, const char* label) {
-        if (dsLayout == VK_NULL_HANDLE) return;
-        VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 };
-        VkDescriptorPoolCreateInfo poolInfo{};
-        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolInfo.poolSizeCount = 1;
-        poolInfo.pPoolSizes = &poolSize;
-        poolInfo.maxSets = 1;
-        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
-        for (uint32_t i = 0; i < ASYNC_RING_SIZE; ++i) {
-            VkDescriptorPool pool;
-            if (vkCreateDescriptorPool(dev, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
-                std::cerr << "[Async] Failed to pre-allocate " << label << " pool " << i << "\n";
-                ring[i] = {};
-                continue;
-            }
-            { std::string s = std::string(label) + " ring #" + std::to_string(i); resources.addDescriptorPool(pool, s.c_str()); }
-            VkDescriptorSet set;
-            VkDescriptorSetAllocateInfo ainfo{};
-            ainfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            ainfo.descriptorPool = pool;
-            ainfo.descriptorSetCount = 1;
-            ainfo.pSetLayouts = &dsLayout;
-            if (vkAllocateDescriptorSets(dev, &ainfo, &set) != VK_SUCCESS) {
-                resources.removeDescriptorPool(pool);
-                vkDestroyDescriptorPool(dev, pool, nullptr);
-                std::cerr << "[Async] Failed to pre-allocate " << label << " set " << i << "\n";
-                ring[i] = {};
-                continue;
-            }
-            { std::string s = std::string(label) + " DS #" + std::to_string(i); resources.addDescriptorSet(set, s.c_str()); }
-            ring[i] = {pool, set};
-        }
-    };
-
-    // Backface compute (same layout as water compute)
-    if (sceneRenderer && sceneRenderer->mainLiquidRenderer) {
-        auto& waterInd = sceneRenderer->mainLiquidRenderer->getIndirectRenderer();
-        allocateComputeRing(cachedBackfaceCompute, waterInd.getComputeDescriptorSetLayout(), "cachedBackfaceCompute");
+            static_cast<int>(billboardManager.getBillboardCount()),
+            contentKeys);
     }
 }
 
@@ -2791,8 +2881,8 @@ void MyApp::rebuildBrushScene() {
         forEachBrushSDF(entry, model, cachedSweepStart, entry.minSize, "[rebuildBrushScene]", applyEntry);
     // 5. Flush queued change events on the MAIN thread (triggers mesh
     // creation via the SceneRenderer brush handlers).
-    brushSolidCollector.dispatch(brushSolidAddHandler, brushSolidRemoveHandler);
-    brushLiquidCollector.dispatch(brushLiquidAddHandler, brushLiquidRemoveHandler);
+    brushSolidCollector.dispatch(brushSolidAddHandler, brushSolidRemoveHandler, brushSolidBatchHandler);
+    brushLiquidCollector.dispatch(brushLiquidAddHandler, brushLiquidRemoveHandler, brushLiquidBatchHandler);
 
     // 6. Process all brush meshes IMMEDIATELY (synchronous, not deferred to
     // the next frame's update()). The brush scene is small — this avoids the
@@ -2858,8 +2948,8 @@ void MyApp::applyBrushToScene() {
     forEachBrushSDF(entry, model, cachedSweepStart, entry.minSize, "[applyBrushToScene]", applyEntry);
 
     // Flush queued change events to trigger mesh creation
-    mainSolidCollector.dispatch(mainSolidAddHandler, mainSolidRemoveHandler);
-    mainLiquidCollector.dispatch(mainLiquidAddHandler, mainLiquidRemoveHandler);
+    mainSolidCollector.dispatch(mainSolidAddHandler, mainSolidRemoveHandler, mainSolidBatchHandler);
+    mainLiquidCollector.dispatch(mainLiquidAddHandler, mainLiquidRemoveHandler, mainLiquidBatchHandler);
 
     // Mark indirect buffers dirty so the mesh changes are visible
     sceneRenderer->mainSolidRenderer->getIndirectRenderer().setDirty(true);
@@ -2937,6 +3027,8 @@ void MyApp::action() {
 
 void MyApp::resetSceneState() {
     if (sceneProcessThread.joinable()) sceneProcessThread.join();
+    // The trees are replaced below: stop autosaving into the old bundle.
+    world->scene().detachJournal();
     deviceWaitIdle();
     processPendingCommandBuffers();
 
@@ -2959,11 +3051,11 @@ void MyApp::resetSceneState() {
 }
 
 void MyApp::dispatchSolidEvents() {
-    mainSolidCollector.dispatch(mainSolidAddHandler, mainSolidRemoveHandler);
+    mainSolidCollector.dispatch(mainSolidAddHandler, mainSolidRemoveHandler, mainSolidBatchHandler);
 }
 
 void MyApp::dispatchLiquidEvents() {
-    mainLiquidCollector.dispatch(mainLiquidAddHandler, mainLiquidRemoveHandler);
+    mainLiquidCollector.dispatch(mainLiquidAddHandler, mainLiquidRemoveHandler, mainLiquidBatchHandler);
 }
 
 void MyApp::generateMap() {
@@ -3011,19 +3103,6 @@ void MyApp::loadSceneFromFile(const std::string& path) {
 void MyApp::ensureCubemapResources() {
     VkDevice dev = getDevice();
 
-    // Always write dummy cubemap to cube360GfxDs binding #11,
-    // even if the DS was already allocated (e.g. before this fix was compiled).
-    if (cube360GfxDs != VK_NULL_HANDLE && sceneRenderer && sceneRenderer->solid360Renderer) {
-        VkImageView dummyView = sceneRenderer->solid360Renderer->getDummyCubeView();
-        VkSampler cubeSamp = sceneRenderer->solid360Renderer->getSolid360Sampler();
-        if (dummyView != VK_NULL_HANDLE && cubeSamp != VK_NULL_HANDLE) {
-            DescriptorWriter(dev)
-                .writeImage(cube360GfxDs, 11, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                            cubeSamp, dummyView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-                .flush();
-        }
-    }
-
     // 1. UBO buffer
     if (cube360UBO.buffer == VK_NULL_HANDLE) {
         cube360UBO = createBuffer(sizeof(UniformObject),
@@ -3032,7 +3111,7 @@ void MyApp::ensureCubemapResources() {
     }
 
     // Helper to destroy and recreate a buffer if its size is insufficient
-    auto ensureBufferSize = [&](Buffer& buf, VkDeviceSize needed,
+    auto ensureBufferSize = [&](Buffer& buf, uint32_t& slot, VkDeviceSize needed,
                                 VkBufferUsageFlags usage, const char* label) {
         if (buf.buffer != VK_NULL_HANDLE) {
             VkMemoryRequirements reqs;
@@ -3049,6 +3128,9 @@ void MyApp::ensureCubemapResources() {
             buf = Buffer{};
         }
         buf = createBuffer(needed, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        // The cull shader writes it through the bindless heap; the old slot
+        // is recycled once the frames using it retire.
+        slot = getBindlessHeap().replaceBuffer(slot, buf.buffer);
     };
 
     // 2. Solid culling buffers (reallocate if mesh count grew)
@@ -3063,10 +3145,10 @@ void MyApp::ensureCubemapResources() {
         1u
     });
     VkDeviceSize compactSize = sizeof(VkDrawIndexedIndirectCommand) * solidCmds;
-    ensureBufferSize(cube360Compact, compactSize,
+    ensureBufferSize(cube360Compact, cube360CompactSlot, compactSize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         "cube360Compact");
-    ensureBufferSize(cube360Visible, std::max(sizeof(uint32_t), VkDeviceSize(4)),
+    ensureBufferSize(cube360Visible, cube360VisibleSlot, std::max(sizeof(uint32_t), VkDeviceSize(4)),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
         "cube360Visible");
 
@@ -3078,24 +3160,21 @@ void MyApp::ensureCubemapResources() {
         1u
     });
     VkDeviceSize waterCompactSize = sizeof(VkDrawIndexedIndirectCommand) * waterCmds;
-    ensureBufferSize(cube360WaterCompact, waterCompactSize,
+    ensureBufferSize(cube360WaterCompact, cube360WaterCompactSlot, waterCompactSize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         "cube360WaterCompact");
-    ensureBufferSize(cube360WaterVisible, std::max(sizeof(uint32_t), VkDeviceSize(4)),
+    ensureBufferSize(cube360WaterVisible, cube360WaterVisibleSlot, std::max(sizeof(uint32_t), VkDeviceSize(4)),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
         "cube360WaterVisible");
 
     // 4. Graphics descriptor set (mirrors main DS but uses cube360UBO)
     if (cube360GfxDs == VK_NULL_HANDLE) {
         VkDescriptorPoolSize ps{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3 };
-        VkDescriptorPoolSize ps2{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 11 };
-        VkDescriptorPoolSize ps3{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 };
-        VkDescriptorPoolSize poolSizes[] = {ps, ps2, ps3};
 
         VkDescriptorPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolInfo.poolSizeCount = 3;
-        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &ps;
         poolInfo.maxSets = 1;
         poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
 
@@ -3120,36 +3199,6 @@ void MyApp::ensureCubemapResources() {
             gfxWriter.writeBuffer(cube360GfxDs, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
                                   cube360UBO.buffer, 0, sizeof(UniformObject));
 
-            auto addImg = [&](uint32_t binding, VkSampler sampler, VkImageView view, VkImageLayout layout) {
-                if (view == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE) return;
-                gfxWriter.writeImage(cube360GfxDs, binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                     sampler, view, layout);
-            };
-
-            if (textureArrayManager.albedoSampler != VK_NULL_HANDLE) {
-                addImg(1, textureArrayManager.albedoSampler, textureArrayManager.albedoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-                addImg(2, textureArrayManager.normalSampler, textureArrayManager.normalArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-                addImg(3, textureArrayManager.bumpSampler, textureArrayManager.bumpArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-                addImg(12, textureArrayManager.roughnessSampler, textureArrayManager.roughnessArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-                addImg(13, textureArrayManager.aoSampler, textureArrayManager.aoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            }
-            addImg(4, sceneRenderer->shadowMapper->getShadowMapSampler(), sceneRenderer->shadowMapper->getShadowMapView(0), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(8, sceneRenderer->shadowMapper->getShadowMapSampler(), sceneRenderer->shadowMapper->getShadowMapView(1), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(9, sceneRenderer->shadowMapper->getShadowMapSampler(), sceneRenderer->shadowMapper->getShadowMapView(2), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-            if (sceneRenderer->solid360Renderer) {
-                VkImageView dummyCubeView = sceneRenderer->solid360Renderer->getDummyCubeView();
-                VkSampler cubeSampler = sceneRenderer->solid360Renderer->getSolid360Sampler();
-                if (dummyCubeView != VK_NULL_HANDLE && cubeSampler != VK_NULL_HANDLE)
-                    addImg(11, cubeSampler, dummyCubeView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            }
-
-            if (sceneRenderer->materialsBuffer.buffer != VK_NULL_HANDLE)
-                gfxWriter.writeBuffer(cube360GfxDs, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                      sceneRenderer->materialsBuffer.buffer, 0, VK_WHOLE_SIZE);
-            if (sceneRenderer->waterParamsBuffer_.buffer != VK_NULL_HANDLE)
-                gfxWriter.writeBuffer(cube360GfxDs, 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                      sceneRenderer->waterParamsBuffer_.buffer, 0, VK_WHOLE_SIZE);
             {
                 Buffer skyBuf = sceneRenderer->skyRenderer->getSkyUniformBuffer();
                 if (skyBuf.buffer != VK_NULL_HANDLE)
@@ -3162,135 +3211,17 @@ void MyApp::ensureCubemapResources() {
 
             gfxWriter.flush();
         }
-        cube360TexVersion = textureArrayManager.getVersion();
-    }
-
-    // Refresh texture bindings on cube360GfxDs if texture arrays were re-allocated
-    // (e.g. after TextureMixer generates new layers). Without this, the cubemap
-    // capture would sample stale/deleted image views, producing wrong reflections.
-    if (cube360GfxDs != VK_NULL_HANDLE && cube360TexVersion != textureArrayManager.getVersion()) {
-        cube360TexVersion = textureArrayManager.getVersion();
-        DescriptorWriter texWriter(dev);
-        auto addImg = [&](uint32_t binding, VkSampler sampler, VkImageView view, VkImageLayout layout) {
-            if (view == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE) return;
-            texWriter.writeImage(cube360GfxDs, binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                 sampler, view, layout);
-        };
-        if (textureArrayManager.albedoSampler != VK_NULL_HANDLE) {
-            addImg(1, textureArrayManager.albedoSampler, textureArrayManager.albedoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(2, textureArrayManager.normalSampler, textureArrayManager.normalArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(3, textureArrayManager.bumpSampler, textureArrayManager.bumpArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(12, textureArrayManager.roughnessSampler, textureArrayManager.roughnessArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(13, textureArrayManager.aoSampler, textureArrayManager.aoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
-        if (sceneRenderer && sceneRenderer->shadowMapper) {
-            addImg(4, sceneRenderer->shadowMapper->getShadowMapSampler(), sceneRenderer->shadowMapper->getShadowMapView(0), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(8, sceneRenderer->shadowMapper->getShadowMapSampler(), sceneRenderer->shadowMapper->getShadowMapView(1), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(9, sceneRenderer->shadowMapper->getShadowMapSampler(), sceneRenderer->shadowMapper->getShadowMapView(2), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
-        if (sceneRenderer->solid360Renderer) {
-            VkImageView dummyCubeView = sceneRenderer->solid360Renderer->getDummyCubeView();
-            VkSampler cubeSampler = sceneRenderer->solid360Renderer->getSolid360Sampler();
-            if (dummyCubeView != VK_NULL_HANDLE && cubeSampler != VK_NULL_HANDLE)
-                addImg(11, cubeSampler, dummyCubeView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
-        texWriter.flush();
-    }
-
-    // 5. Solid compute descriptor set — allocate lazily, refresh buffer bindings only when buffers change
-    {
-        VkDescriptorSetLayout dsLayout = solidInd.getComputeDescriptorSetLayout();
-        if (dsLayout != VK_NULL_HANDLE && cube360ComputeDs == VK_NULL_HANDLE) {
-            VkDescriptorPoolSize ps{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 };
-            VkDescriptorPoolCreateInfo pci{};
-            pci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-            pci.poolSizeCount = 1; pci.pPoolSizes = &ps; pci.maxSets = 1;
-            pci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
-            VkDescriptorPool pool;
-            if (vkCreateDescriptorPool(dev, &pci, nullptr, &pool) == VK_SUCCESS) {
-                resources.addDescriptorPool(pool, "cubemap compute pool");
-                VkDescriptorSetAllocateInfo ai{};
-                ai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-                ai.descriptorPool = pool; ai.descriptorSetCount = 1; ai.pSetLayouts = &dsLayout;
-                if (vkAllocateDescriptorSets(dev, &ai, &cube360ComputeDs) == VK_SUCCESS)
-                    resources.addDescriptorSet(cube360ComputeDs, "cubemap compute DS");
-            }
-        }
-        if (cube360ComputeDs != VK_NULL_HANDLE) {
-            std::array<VkBuffer, 5> bufs = {
-                solidInd.getIndirectBuffer().buffer,
-                cube360Compact.buffer,
-                solidInd.getBoundsBuffer().buffer,
-                cube360Visible.buffer,
-                solidInd.getVisibleLodsScratchBuffer(),
-            };
-            if (bufs != cube360ComputeBuffers) {
-                cube360ComputeBuffers = bufs;
-                DescriptorWriter(dev)
-                    .writeBuffer(cube360ComputeDs, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[0], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360ComputeDs, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[1], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360ComputeDs, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[2], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360ComputeDs, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[3], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360ComputeDs, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[4], 0, VK_WHOLE_SIZE)
-                    .flush();
-            }
-        }
-    }
-
-    // 6. Water compute descriptor set — allocate lazily, refresh buffer bindings only when buffers change
-    {
-        VkDescriptorSetLayout wDsLayout = waterInd.getComputeDescriptorSetLayout();
-        if (wDsLayout != VK_NULL_HANDLE && cube360WaterComputeDs == VK_NULL_HANDLE) {
-            VkDescriptorPoolSize ps{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 };
-            VkDescriptorPoolCreateInfo pci{};
-            pci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-            pci.poolSizeCount = 1; pci.pPoolSizes = &ps; pci.maxSets = 1;
-            pci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
-            VkDescriptorPool pool;
-            if (vkCreateDescriptorPool(dev, &pci, nullptr, &pool) == VK_SUCCESS) {
-                resources.addDescriptorPool(pool, "cubemap water compute pool");
-                VkDescriptorSetAllocateInfo ai{};
-                ai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-                ai.descriptorPool = pool; ai.descriptorSetCount = 1; ai.pSetLayouts = &wDsLayout;
-                if (vkAllocateDescriptorSets(dev, &ai, &cube360WaterComputeDs) == VK_SUCCESS)
-                    resources.addDescriptorSet(cube360WaterComputeDs, "cubemap water compute DS");
-            }
-        }
-        if (cube360WaterComputeDs != VK_NULL_HANDLE) {
-            std::array<VkBuffer, 5> bufs = {
-                waterInd.getIndirectBuffer().buffer,
-                cube360WaterCompact.buffer,
-                waterInd.getBoundsBuffer().buffer,
-                cube360WaterVisible.buffer,
-                waterInd.getVisibleLodsScratchBuffer(),
-            };
-            if (bufs != cube360WaterComputeBuffers) {
-                cube360WaterComputeBuffers = bufs;
-                DescriptorWriter(dev)
-                    .writeBuffer(cube360WaterComputeDs, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[0], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360WaterComputeDs, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[1], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360WaterComputeDs, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[2], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360WaterComputeDs, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[3], 0, VK_WHOLE_SIZE)
-                    .writeBuffer(cube360WaterComputeDs, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 bufs[4], 0, VK_WHOLE_SIZE)
-                    .flush();
-            }
-        }
     }
 }
 
 void MyApp::postSubmit() {
     if (textureMixer) {
         textureMixer->flushPendingRequests(this);
+    }
+    // Retire finished texture-layer jobs and submit queued ones (never blocks)
+    textureArrayManager.uploadQueue.processUploads();
+    vegetationTextureArrayManager.uploadQueue.processUploads();
+    if (textureMixer) {
         textureMixer->pollPendingGenerations(this);
     }
 
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+// Counter-based random numbers: the value is a pure function of
+// (key, counter), with no state carried between draws. Any element of a
+// stream can be computed independently, so loops that draw one number per
+// element parallelise across threads and vectorise (the mixing is only
+// 32-bit multiplies, shifts and xors).
+//
+// pcgHash is the PCG-RXS-M-XS output permutation applied to one LCG step
+// (Jarzynski & Olano, "Hash Functions for GPU Rendering", 2020).
+inline uint32_t pcgHash(uint32_t v) {
+    uint32_t state = v * 747796405u + 2891336453u;
+    uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+// Two chained rounds so that nearby keys and nearby counters both decorrelate.
+inline uint32_t counterRandom(uint32_t key, uint32_t counter) {
+    return pcgHash(counter + pcgHash(key));
+}
+
+// Uniform float in [0, 1) from the top 24 bits.
+inline float counterRandomFloat(uint32_t key, uint32_t counter) {
+    return float(counterRandom(key, counter) >> 8) * (1.0f / 16777216.0f);
+}
@@ -2,6 +2,7 @@
 #include "Vertex.hpp"
 #include "VertexHasher.hpp"
 #include "BoundingCube.hpp"
+#include "../space/OctreeCellKey.hpp"
 #include <vector>
 #include <type_traits>
 #include <tsl/robin_map.h>
@@ -15,6 +16,9 @@ public:
     std::vector<Vertex> vertices;
     std::vector<uint> indices;
     tsl::robin_map<Vertex, size_t, VertexHasher> compactMap;
+    // Triangles are already grouped into culling-cluster runs (optimizeMeshForGpu);
+    // MeshClusters keeps the order instead of re-sorting.
+    bool clusterOrdered = false;
 
     // Calculates tangents for all vertices using indexed triangles
     void calculateTangents();
@@ -36,6 +40,7 @@ using GeometryLodCallback = std::function<void(
     uint8_t lod,
     uint version,
     uintptr_t emittingNodeId,
-    const BoundingCube& cube // the emitting cell's OWN cube (not the added node's)
+    const BoundingCube& cube, // the emitting cell's OWN cube (not the added node's)
+    const OctreeCellKey& key  // ... and its key
 )>;
  
@@ -0,0 +1,435 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include "utils/LocalScene.hpp"
+#include "utils/MainSceneLoader.hpp"
+#include "space/OctreeAllocator.hpp"
+#include "space/OctreeCompactor.hpp"
+
+// Octree node layout benchmark: memory and traversal speed of the node layout
+// this binary was built with.
+//
+//   make octreebench                   -> bin/octreebench-compact
+//   make octreebench NODE_LAYOUT=wide  -> bin/octreebench-wide
+//   octreebench-<layout> [--passes N] [--chunks N] [--edits N]
+//
+// Loads the MainSceneLoader terrain (no GPU, like the server) and reports for
+// the opaque tree:
+//   apply      scene load time (every brush of the scene goes through apply)
+//   memory     bytes per node, node + child-block bytes, allocator reservation
+//   traverse   full depth-first walk reading type + SDF corners (ns/node)
+//   vertices   the same walk also materialising every surface vertex
+//   tessellate requestModel3D over the first N added nodes (every ladder level,
+//              i.e. iterateTriangles)
+//   bricks     the same ladder cells through iterateTriangles with and without
+//              the dense-brick path; exits 1 unless the triangle sets match
+//   compaction after N sphere add/remove edits on surface points (fragmenting
+//              the allocators), traverse and point lookups (getNodeAt) before
+//              and after an OctreeCompactor pass, plus the blocks it released
+//   roundtrip  pages chunks out, saves the scene, edits it and checkpoints the
+//              journal, then loads the bundle into a second scene; exits 1
+//              unless both scenes hold the same trees
+// Run both binaries on the same machine to compare the layouts.
+
+namespace {
+
+#ifdef OCTREE_WIDE_NODES
+constexpr const char* LAYOUT_NAME = "wide";
+#else
+constexpr const char* LAYOUT_NAME = "compact";
+#endif
+
+struct WalkStats {
+    size_t nodes = 0;
+    size_t leaves = 0;
+    size_t surface = 0;
+    size_t childBlocks = 0;
+    double checksum = 0.0;  // keeps the reads observable
+};
+
+// Depth-first walk of the whole tree. withVertices also decodes the vertex
+// of every Surface node, as the tessellator does.
+WalkStats walk(Octree& tree, bool withVertices) {
+    WalkStats stats;
+    struct Item {
+        OctreeNode* node;
+        OctreeCellKey key;
+    };
+    std::vector<Item> stack;
+    if (tree.root) stack.push_back({tree.root, OctreeCellKey()});
+    float sdf[8];
+    while (!stack.empty()) {
+        const Item item = stack.back();
+        stack.pop_back();
+        OctreeNode* node = item.node;
+        ++stats.nodes;
+        node->getSDF(sdf);
+        const SpaceType type = node->getType();
+        if (type == SpaceType::Surface) {
+            ++stats.surface;
+            int negative = 0;
+            for (float d : sdf) negative += d < 0.0f;
+            stats.checksum += negative;
+            if (withVertices) {
+                const Vertex v = node->getVertex(item.key.cube(tree));
+                stats.checksum += v.position.x + v.normal.y;
+            }
+        }
+        if (node->isLeaf()) {
+            ++stats.leaves;
+            continue;
+        }
+        ++stats.childBlocks;
+        OctreeNode* children[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+        node->getChildren(*tree.allocator, children);
+        for (int i = 0; i < 8; ++i) {
+            if (children[i]) stack.push_back({children[i], item.key.child(i)});
+        }
+    }
+    return stats;
+}
+
+// Vertex positions of up to `limit` Surface leaves, spread over the walk.
+std::vector<glm::vec3> surfacePoints(Octree& tree, size_t limit) {
+    std::vector<glm::vec3> points;
+    std::vector<std::pair<OctreeNode*, OctreeCellKey>> stack;
+    if (tree.root) stack.emplace_back(tree.root, OctreeCellKey());
+    while (!stack.empty()) {
+        const auto [node, key] = stack.back();
+        stack.pop_back();
+        if (node->isLeaf()) {
+            if (node->getType() == SpaceType::Surface) points.push_back(node->getPosition(key.cube(tree)));
+            continue;
+        }
+        OctreeNode* children[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+        node->getChildren(*tree.allocator, children);
+        for (int i = 0; i < 8; ++i) {
+            if (children[i]) stack.emplace_back(children[i], key.child(i));
+        }
+    }
+    if (points.size() > limit) {
+        std::vector<glm::vec3> spread;
+        spread.reserve(limit);
+        for (size_t i = 0; i < limit; ++i) spread.push_back(points[i * points.size() / limit]);
+        points.swap(spread);
+    }
+    return points;
+}
+
+// Corners as a bundle round-trips them: through the node's own encoding.
+bool sameCorner(float a, float b) {
+    if (a == b) return true;
+    if (!std::isfinite(a) || !std::isfinite(b)) return false;
+    return std::fabs(a - b) <= 1e-4f * std::max(std::fabs(a), std::fabs(b));
+}
+
+// Cells whose bundle fields (structure, corners, brush, colour, flags)
+// differ between the two trees; `nodes` counts the cells compared.
+size_t compareTrees(Octree& a, Octree& b, size_t& nodes) {
+    if (!(static_cast<const BoundingCube&>(a) == static_cast<const BoundingCube&>(b))) return 1;
+    if ((a.root == nullptr) != (b.root == nullptr)) return 1;
+    size_t mismatches = 0;
+    std::vector<std::pair<OctreeNode*, OctreeNode*>> stack;
+    if (a.root) stack.emplace_back(a.root, b.root);
+    float sdfA[8], sdfB[8];
+    while (!stack.empty()) {
+        const auto [na, nb] = stack.back();
+        stack.pop_back();
+        ++nodes;
+        na->getSDF(sdfA);
+        nb->getSDF(sdfB);
+        bool same = na->bits == nb->bits && na->getBrush() == nb->getBrush() &&
+                    glm::all(glm::lessThanEqual(glm::abs(na->getHSV() - nb->getHSV()), glm::vec3(1e-3f)));
+        for (int k = 0; k < 8 && same; ++k) same = sameCorner(sdfA[k], sdfB[k]);
+        OctreeNode* childrenA[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+        OctreeNode* childrenB[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+        na->getChildren(*a.allocator, childrenA);
+        nb->getChildren(*b.allocator, childrenB);
+        for (int i = 0; i < 8; ++i) {
+            if ((childrenA[i] == nullptr) != (childrenB[i] == nullptr)) {
+                same = false;
+            } else if (childrenA[i]) {
+                stack.emplace_back(childrenA[i], childrenB[i]);
+            }
+        }
+        if (!same) ++mismatches;
+    }
+    return mismatches;
+}
+
+template <typename F>
+double bestOf(int passes, F&& body) {
+    double best = 1e300;
+    for (int p = 0; p < passes; ++p) {
+        const auto t0 = std::chrono::steady_clock::now();
+        body();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+// Triangles as position triples, each rotated to start at its smallest
+// vertex (winding kept), sorted: emission order differs between the
+// dense-brick and sparse paths, the triangle set must not.
+class TriangleSet : public OctreeNodeTriangleHandler {
+public:
+    using Triangle = std::array<glm::vec3, 3>;
+    std::vector<Triangle> triangles;
+    long emitted = 0;
+
+    TriangleSet() : OctreeNodeTriangleHandler(&emitted) {}
+
+    void handle(Vertex& v0, Vertex& v1, Vertex& v2) override {
+        Triangle t = {v0.position, v1.position, v2.position};
+        int first = 0;
+        for (int k = 1; k < 3; ++k) {
+            if (less(t[k], t[first])) first = k;
+        }
+        std::rotate(t.begin(), t.begin() + first, t.end());
+        triangles.push_back(t);
+    }
+
+    void sort() {
+        std::sort(triangles.begin(), triangles.end(), [](const Triangle& a, const Triangle& b) {
+            for (int k = 0; k < 3; ++k) {
+                if (less(a[k], b[k])) return true;
+                if (less(b[k], a[k])) return false;
+            }
+            return false;
+        });
+    }
+
+private:
+    static bool less(const glm::vec3& a, const glm::vec3& b) {
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        return a.z < b.z;
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int passes = 5;
+    size_t maxChunks = 64;
+    size_t edits = 256;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--passes" && i + 1 < argc) { passes = std::max(1, std::stoi(argv[++i])); continue; }
+        if (arg == "--chunks" && i + 1 < argc) { maxChunks = std::stoul(argv[++i]); continue; }
+        if (arg == "--edits" && i + 1 < argc) { edits = std::stoul(argv[++i]); continue; }
+        std::cerr << "usage: octreebench [--passes N] [--chunks N] [--edits N]\n";
+        return 1;
+    }
+
+    std::vector<OctreeNodeData> added;
+    std::mutex addedMutex;
+    Octree::OctreeNodeDataHandler onAdded = [&](const OctreeNodeData& nd) {
+        std::lock_guard<std::mutex> lock(addedMutex);
+        added.push_back(nd);
+    };
+    Octree::OctreeNodeDataHandler ignore = [](const OctreeNodeData&) {};
+
+    LocalScene scene;
+    MainSceneLoader loader;
+    const auto load0 = std::chrono::steady_clock::now();
+    scene.loadScene(loader, onAdded, ignore, ignore, ignore);
+    const double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load0).count();
+
+    Octree& tree = scene.getOpaqueOctree();
+    const WalkStats stats = walk(tree, false);
+    if (stats.nodes == 0) {
+        std::cerr << "octreebench: empty opaque tree\n";
+        return 1;
+    }
+
+    const size_t nodeBytes = stats.nodes * sizeof(OctreeNode);
+    const size_t blockBytes = stats.childBlocks * sizeof(ChildBlock);
+    const size_t reserved = tree.allocator->getAllocatedBlocksCount() * tree.allocator->getBlockSize() * sizeof(OctreeNode);
+    std::printf("layout %s  sizeof(OctreeNode) %zu  sizeof(ChildBlock) %zu  apply (scene load) %.0f ms\n",
+                LAYOUT_NAME, sizeof(OctreeNode), sizeof(ChildBlock), loadMs);
+    std::printf("nodes %zu (%zu leaves, %zu surface)  child blocks %zu\n",
+                stats.nodes, stats.leaves, stats.surface, stats.childBlocks);
+    std::printf("memory  nodes %.2f MiB + child blocks %.2f MiB = %.1f bytes/node   (node allocator reserved %.2f MiB)\n",
+                nodeBytes / 1048576.0, blockBytes / 1048576.0,
+                static_cast<double>(nodeBytes + blockBytes) / stats.nodes, reserved / 1048576.0);
+
+    volatile double sink = 0.0;
+    const double traverseMs = bestOf(passes, [&]() { sink = walk(tree, false).checksum; });
+    const double vertexMs = bestOf(passes, [&]() { sink = walk(tree, true).checksum; });
+    std::printf("traverse  %.2f ms  %.1f ns/node   (best of %d)\n", traverseMs, traverseMs * 1e6 / stats.nodes, passes);
+    std::printf("vertices  %.2f ms  %.1f ns/node\n", vertexMs, vertexMs * 1e6 / stats.nodes);
+
+    // Tessellation of the first added nodes (each request walks the node's
+    // root path and emits every ladder level).
+    size_t chunks = 0, triangles = 0;
+    std::mutex trianglesMutex;
+    const auto tess0 = std::chrono::steady_clock::now();
+    for (OctreeNodeData& nd : added) {
+        if (chunks >= maxChunks) break;
+        if (!nd.node) continue;
+        ++chunks;
+        scene.requestModel3D(LAYER_OPAQUE, nd,
+            [&](const Geometry& geo, uint8_t, uint, uintptr_t, const BoundingCube&, const OctreeCellKey&) {
+                std::lock_guard<std::mutex> lock(trianglesMutex);
+                triangles += geo.indices.size() / 3;
+            });
+    }
+    const double tessMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tess0).count();
+    if (chunks > 0) {
+        std::printf("tessellate  %zu chunks  %zu triangles  %.2f ms/chunk\n", chunks, triangles, tessMs / chunks);
+    }
+
+    // Dense bricks against the sparse walker on every ladder cell above the
+    // same chunks: both must emit exactly the same triangles.
+    {
+        std::vector<OctreeNodeData> cells;
+        std::vector<OctreeNodeData> path;
+        size_t checked = 0;
+        for (OctreeNodeData& nd : added) {
+            if (checked >= maxChunks) break;
+            if (!nd.node) continue;
+            ++checked;
+            path.clear();
+            tree.ladderPath(nd, path);
+            cells.insert(cells.end(), path.begin(), path.end());
+        }
+        size_t mismatches = 0, compared = 0, brickTriangles = 0;
+        double brickMs = 0.0, sparseMs = 0.0;
+        for (const OctreeNodeData& cell : cells) {
+            const int targetLod = cell.node->getChunkLod();
+            TriangleSet withBricks, sparse;
+            tree.denseBricks = true;
+            const auto b0 = std::chrono::steady_clock::now();
+            tree.iterateTriangles(cell.node, cell.key, withBricks, targetLod);
+            const auto b1 = std::chrono::steady_clock::now();
+            tree.denseBricks = false;
+            tree.iterateTriangles(cell.node, cell.key, sparse, targetLod);
+            const auto b2 = std::chrono::steady_clock::now();
+            brickMs += std::chrono::duration<double, std::milli>(b1 - b0).count();
+            sparseMs += std::chrono::duration<double, std::milli>(b2 - b1).count();
+            withBricks.sort();
+            sparse.sort();
+            ++compared;
+            brickTriangles += withBricks.triangles.size();
+            if (withBricks.triangles != sparse.triangles) ++mismatches;
+        }
+        tree.denseBricks = true;
+        std::printf("bricks  %zu ladder cells  %zu triangles  dense %.2f ms  sparse %.2f ms  %zu mismatching cells\n",
+                    compared, brickTriangles, brickMs, sparseMs, mismatches);
+        if (mismatches > 0) {
+            std::cerr << "octreebench: dense-brick output differs from the sparse walker\n";
+            return 1;
+        }
+    }
+
+    // Edit-heavy replay: sphere adds and removes on surface points free and
+    // reallocate nodes all over the allocator, as a long editing session
+    // does. Traversal is measured on the fragmented tree, then again after
+    // a full compaction pass.
+    if (edits == 0) return 0;
+    std::vector<glm::vec3> points = surfacePoints(tree, 4096);
+    if (points.empty()) return 0;
+    std::mt19937 rng(12345);
+    const float minSize = 30.0f;
+    const auto edit0 = std::chrono::steady_clock::now();
+    for (size_t e = 0; e < edits; ++e) {
+        const glm::vec3 center = points[rng() % points.size()];
+        const float radius = 40.0f + static_cast<float>(rng() % 160);
+        const Transformation model(glm::vec3(radius), center, 0, 0, 0);
+        const SphereDistanceFunction function(model, minSize);
+        if (e % 2 == 0) {
+            tree.apply(AddSignedDistanceOperation(), function, model, SimpleBrush(5), minSize, loader.simplifier, ignore, ignore);
+        } else {
+            tree.apply(DeleteSignedDistanceOperation(), function, model, SimpleBrush(4), minSize, loader.simplifier, ignore, ignore);
+        }
+    }
+    const double editMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - edit0).count();
+
+    std::shuffle(points.begin(), points.end(), rng);
+    const auto lookups = [&]() {
+        double checksum = 0.0;
+        for (const glm::vec3& p : points) {
+            const OctreeNode* node = tree.getNodeAt(p, false);
+            if (node) checksum += node->getLod();
+        }
+        sink = checksum;
+    };
+    const auto report = [&](const char* label) {
+        const size_t nodes = walk(tree, false).nodes;
+        const size_t used = tree.allocator->nodeAllocator.getUsedCount();
+        const size_t slots = tree.allocator->getAllocatedBlocksCount() * tree.allocator->getBlockSize();
+        const double walkMs = bestOf(passes, [&]() { sink = walk(tree, false).checksum; });
+        const double lookupMs = bestOf(passes, lookups);
+        std::printf("%-18s traverse %.1f ns/node (%.1f Mnodes/s)  lookups %.0f ns  node allocator %.2f MiB, %.0f%% free\n",
+                    label, walkMs * 1e6 / nodes, nodes / (walkMs * 1e3), lookupMs * 1e6 / points.size(),
+                    slots * sizeof(OctreeNode) / 1048576.0, slots ? 100.0 * (slots - used) / slots : 0.0);
+    };
+    std::printf("edits  %zu sphere adds/removes  %.0f ms\n", edits, editMs);
+    report("before compaction");
+    OctreeCompactor compactor(tree);
+    const auto compact0 = std::chrono::steady_clock::now();
+    compactor.compactAll();
+    const double compactMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compact0).count();
+    const OctreeCompactor::Stats compaction = compactor.stats();
+    std::printf("compaction  %llu chunks  %.0f ms  %llu blocks released\n",
+                static_cast<unsigned long long>(compaction.unitsCompacted), compactMs,
+                static_cast<unsigned long long>(compaction.releasedBlocks));
+    report("after compaction");
+
+    // Save round trip on the live scene: some chunks paged out (the save
+    // streams them from their page files), edits after the save reaching the
+    // journal, then a second scene loading the bundle and replaying it.
+    const std::filesystem::path folder = std::filesystem::temp_directory_path() / "octreebench-roundtrip";
+    std::filesystem::remove_all(folder);
+    const std::string bundle = (folder / "scene.bin").string();
+    scene.enableJournal();
+    scene.enablePaging((folder / "pages").string(), ignore, ignore);
+    // Far camera, 1-byte budget: idle chunks go out a few per update.
+    const glm::vec3 farCamera(1e9f);
+    for (int u = 0; u < 40 && scene.pagingStats(LAYER_OPAQUE).evictedChunks < 8; ++u) {
+        scene.updatePaging(farCamera, 1, 0.0f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(260));
+    }
+    const size_t pagedOut = scene.pagingStats(LAYER_OPAQUE).evictedChunks;
+    const auto save0 = std::chrono::steady_clock::now();
+    scene.save(bundle);
+    const double saveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - save0).count();
+    const size_t journalEdits = std::min<size_t>(edits, 16);
+    for (size_t e = 0; e < journalEdits; ++e) {
+        const glm::vec3 center = points[rng() % points.size()];
+        const float radius = 40.0f + static_cast<float>(rng() % 160);
+        const Transformation model(glm::vec3(radius), center, 0, 0, 0);
+        const SphereDistanceFunction function(model, minSize);
+        tree.apply(AddSignedDistanceOperation(), function, model, SimpleBrush(5), minSize, loader.simplifier, ignore, ignore);
+    }
+    scene.autosave(nullptr, 0);
+    scene.flushAutosave();
+    // Compared fully resident.
+    tree.pager->pageInAll();
+    scene.transparentOctree.pager->pageInAll();
+
+    LocalScene reloaded;
+    reloaded.enableJournal();
+    reloaded.load(bundle);
+    size_t compared = 0;
+    const size_t roundtripMismatches = compareTrees(tree, reloaded.opaqueOctree, compared) +
+                                       compareTrees(scene.transparentOctree, reloaded.transparentOctree, compared);
+    std::printf("roundtrip  %zu chunks saved from pages  save %.0f ms  %zu journal edits  %zu nodes  %zu mismatching\n",
+                pagedOut, saveMs, journalEdits, compared, roundtripMismatches);
+    std::filesystem::remove_all(folder);
+    if (roundtripMismatches > 0) {
+        std::cerr << "octreebench: the reloaded scene differs from the saved one\n";
+        return 1;
+    }
+    return 0;
+}
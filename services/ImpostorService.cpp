@@ -1,6 +1,17 @@
 #include "ImpostorService.hpp"
 #include "../vulkan/VulkanApp.hpp"
 #include "../vulkan/renderer/VegetationRenderer.hpp"
+#include "../utils/AtlasManager.hpp"
+#include "../utils/Billboard.hpp"
+#include "../utils/TextureCooker.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+// Bump when billboard baking or capture changes in a way the content key
+// cannot see, so stale cache entries stop matching.
+constexpr uint32_t IMPOSTOR_CONTENT_VERSION = 1;
+}
 
 ImpostorService::ImpostorService() {}
 
@@ -10,7 +21,7 @@ void ImpostorService::init(VulkanApp* app) {
     // supplies the shared set=2 wind params descriptor set/layout used by
     // the capture pipeline, instead of ImpostorCapture allocating a
     // duplicate wind params UBO + descriptor set.
-    capture.init(app, vegRenderer);
+    capture.init(app, vegRenderer, layout, octahedralGrid);
 }
 
 void ImpostorService::cleanup() {
@@ -20,19 +31,73 @@ void ImpostorService::cleanup() {
     srcOpacity = VK_NULL_HANDLE;
     srcSampler = VK_NULL_HANDLE;
     billboardCount = 0;
+    contentKeys.clear();
+    pendingTypes = 0;
+}
+
+void ImpostorService::configure(ImpostorCapture::ViewLayout newLayout, uint32_t grid) {
+    grid = std::clamp(grid, ImpostorCapture::MIN_OCTAHEDRAL_GRID, ImpostorCapture::MAX_OCTAHEDRAL_GRID);
+    // The grid only matters for the octahedral layout
+    const bool changed = newLayout != layout ||
+                         (newLayout == ImpostorCapture::ViewLayout::Octahedral && grid != octahedralGrid);
+    layout = newLayout;
+    octahedralGrid = grid;
+    if (!changed || !vulkanApp || capture.getCaptureArrayView() == VK_NULL_HANDLE) return;
+
+    // The scene samples the capture arrays every frame: let in-flight frames
+    // finish before they are destroyed.
+    vulkanApp->waitForFrameFences();
+    capture.cleanup(vulkanApp);
+    capture.init(vulkanApp, vegRenderer, layout, octahedralGrid);
+    restoreOrQueueAll();
+    rewire();
 }
 
 void ImpostorService::setSource(VkImageView albedo, VkImageView normal,
                                  VkImageView opacity, VkSampler sampler,
-                                 int numBillboards) {
+                                 int numBillboards, const std::vector<uint64_t>& keys) {
     srcAlbedo      = albedo;
     srcNormal      = normal;
     srcOpacity     = opacity;
     srcSampler     = sampler;
     billboardCount = numBillboards;
+    contentKeys    = keys;
 
     if (vulkanApp && srcAlbedo != VK_NULL_HANDLE && srcSampler != VK_NULL_HANDLE) {
-        captureAll(10.0f);
+        restoreOrQueueAll();
+        rewire();
+    }
+}
+
+void ImpostorService::restoreOrQueueAll() {
+    pendingTypes = 0;
+    if (srcAlbedo == VK_NULL_HANDLE || srcSampler == VK_NULL_HANDLE) return;
+    const uint32_t types = std::min<uint32_t>(ImpostorCapture::NUM_BILLBOARD_TYPES,
+                                              static_cast<uint32_t>(std::max(billboardCount, 0)));
+    for (uint32_t t = 0; t < types; ++t) {
+        const bool cached = t < contentKeys.size() &&
+                            capture.loadCached(vulkanApp, t, contentKeys[t], captureScale);
+        if (!cached) pendingTypes |= 1u << t;
+    }
+}
+
+void ImpostorService::update() {
+    if (!vulkanApp || pendingTypes == 0) return;
+    if (srcAlbedo == VK_NULL_HANDLE || srcSampler == VK_NULL_HANDLE) return;
+
+    uint32_t type = 0;
+    while (!((pendingTypes >> type) & 1u)) ++type;
+    pendingTypes &= ~(1u << type);
+
+    // The layers being overwritten may still be sampled by in-flight frames
+    vulkanApp->waitForFrameFences();
+    captureType(type);
+}
+
+void ImpostorService::captureType(uint32_t type) {
+    capture.capture(vulkanApp, srcAlbedo, srcNormal, srcOpacity, srcSampler, captureScale, type);
+    if (type < contentKeys.size() && !capture.storeCached(vulkanApp, type, contentKeys[type], captureScale)) {
+        fprintf(stderr, "[ImpostorService] could not write cache entry for billboard type %u\n", type);
     }
 }
 
@@ -40,15 +105,20 @@ void ImpostorService::captureAll(float scale) {
     if (!vulkanApp || srcAlbedo == VK_NULL_HANDLE || srcSampler == VK_NULL_HANDLE)
         return;
 
-    capture.captureAll(vulkanApp,
-                       srcAlbedo, srcNormal, srcOpacity, srcSampler,
-                       scale);
+    captureScale = scale;
+    pendingTypes = 0;
+    vulkanApp->waitForFrameFences();
+    for (uint32_t t = 0; t < ImpostorCapture::NUM_BILLBOARD_TYPES; ++t) {
+        captureType(t);
+    }
     rewire();
 }
 
 void ImpostorService::rewire() {
-    if (vulkanApp && vegRenderer && capture.isReady() &&
-        capture.getCaptureArrayView() != VK_NULL_HANDLE) {
+    // The capture arrays exist (cleared) from init(), so the renderer can be
+    // wired before any type is captured; missing types simply draw nothing.
+    if (vulkanApp && vegRenderer && capture.getCaptureArrayView() != VK_NULL_HANDLE) {
+        vegRenderer->setImpostorViewLayout(capture.getOctahedralGrid(), capture.viewCount());
         vegRenderer->setImpostorData(vulkanApp,
                                      capture.getCaptureArrayView(),
                                      capture.getCaptureNormalArrayView(),
@@ -79,3 +149,26 @@ VkDescriptorSet ImpostorService::getImGuiNormalDescSet(uint32_t billboardType, u
 VkDescriptorSet ImpostorService::getImGuiDepthDescSet(uint32_t billboardType, uint32_t viewIdx) const {
     return capture.getImGuiDepthDescSet(billboardType, viewIdx);
 }
+
+uint64_t ImpostorService::billboardContentKey(const Billboard& billboard, const AtlasManager& atlases,
+                                              const std::vector<uint64_t>& atlasSourceHashes) {
+    uint64_t h = TextureCooker::hashBytes(&IMPOSTOR_CONTENT_VERSION, sizeof(IMPOSTOR_CONTENT_VERSION));
+    const float dims[2] = { billboard.width, billboard.height };
+    h = TextureCooker::hashBytes(dims, sizeof(dims), h);
+    for (const BillboardLayer& layer : billboard.layers) {
+        // Field by field: BillboardLayer has no padding guarantees
+        const int ints[3] = { layer.atlasIndex, layer.tileIndex, layer.renderOrder };
+        const float floats[6] = { layer.offsetX, layer.offsetY, layer.scaleX, layer.scaleY,
+                                  layer.rotation, layer.opacity };
+        h = TextureCooker::hashBytes(ints, sizeof(ints), h);
+        h = TextureCooker::hashBytes(floats, sizeof(floats), h);
+        if (const AtlasTile* tile = atlases.getTile(layer.atlasIndex, static_cast<size_t>(layer.tileIndex))) {
+            const float rect[4] = { tile->offsetX, tile->offsetY, tile->scaleX, tile->scaleY };
+            h = TextureCooker::hashBytes(rect, sizeof(rect), h);
+        }
+        if (layer.atlasIndex >= 0 && static_cast<size_t>(layer.atlasIndex) < atlasSourceHashes.size()) {
+            h = TextureCooker::hashBytes(&atlasSourceHashes[layer.atlasIndex], sizeof(uint64_t), h);
+        }
+    }
+    return h;
+}
@@ -4,9 +4,12 @@
 #include "../vulkan/renderer/ImpostorCapture.hpp"
 #include <vulkan/vulkan.h>
 #include <cstdint>
+#include <vector>
 
 class VulkanApp;
 class VegetationRenderer;
+class AtlasManager;
+struct Billboard;
 
 class ImpostorService : public Service {
 public:
@@ -14,15 +17,36 @@ public:
     void init(VulkanApp* app) override;
     void cleanup() override;
 
+    // Select the view layout. Before init() this only records the choice;
+    // afterwards a change re-creates the capture arrays and re-captures.
+    void configure(ImpostorCapture::ViewLayout layout, uint32_t octahedralGrid);
+
+    // New billboard textures. `contentKeys` (one per billboard type, see
+    // billboardContentKey) select disk cache entries; types found in the
+    // cache are restored immediately, the rest are captured by update().
     void setSource(VkImageView albedo, VkImageView normal, VkImageView opacity,
-                   VkSampler sampler, int billboardCount);
+                   VkSampler sampler, int billboardCount,
+                   const std::vector<uint64_t>& contentKeys = {});
     void setVegetationRenderer(VegetationRenderer* renderer) { vegRenderer = renderer; }
+    // Re-capture every type now (and refresh the cache).
     void captureAll(float scale);
+    // Capture at most one missing billboard type per call (once per frame).
+    void update();
     void rewire();
     void invalidateImGuiDescriptors();
     void recreateImGuiDescriptors();
 
     bool isReady() const { return capture.isReady(); }
+    ImpostorCapture::ViewLayout getLayout() const { return capture.getLayout(); }
+    uint32_t getOctahedralGrid() const { return capture.getOctahedralGrid(); }
+    uint32_t viewCount() const { return capture.viewCount(); }
+    uint32_t frameSize() const { return capture.frameSize(); }
+
+    // Hash of everything a billboard's impostor depends on: its layers and
+    // size, the atlas tiles they reference, and the source atlas images
+    // (`atlasSourceHashes[atlasIndex]`, e.g. TextureCooker::hashBytes of the files).
+    static uint64_t billboardContentKey(const Billboard& billboard, const AtlasManager& atlases,
+                                        const std::vector<uint64_t>& atlasSourceHashes);
 
     VkDescriptorSet getImGuiDescSet(uint32_t billboardType, uint32_t viewIdx) const;
     VkDescriptorSet getImGuiNormalDescSet(uint32_t billboardType, uint32_t viewIdx) const;
@@ -39,4 +63,13 @@ private:
     VkImageView srcOpacity = VK_NULL_HANDLE;
     VkSampler srcSampler = VK_NULL_HANDLE;
     int billboardCount = 0;
+
+    ImpostorCapture::ViewLayout layout = ImpostorCapture::ViewLayout::Octahedral;
+    uint32_t octahedralGrid = 8;
+    float captureScale = 10.0f;
+    std::vector<uint64_t> contentKeys;
+    uint32_t pendingTypes = 0;   // bitmask of types still to capture
+
+    void captureType(uint32_t type);
+    void restoreOrQueueAll();
 };
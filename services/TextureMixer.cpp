@@ -78,7 +78,7 @@ void TextureMixer::generateInitialTextures(std::vector<MixerParameters> &mixerPa
 }
 
 
-// Queue a generation request from UI thread; will be flushed synchronously from the main update loop
+// Queue a generation request from UI thread; will be flushed from the main update loop
 void TextureMixer::enqueueGenerate(const MixerParameters &params, int map) {
 	std::lock_guard<std::mutex> lk(pendingRequestsMutex);
 	// Coalesce requests for the same target layer and map: replace older request if present
@@ -100,7 +100,7 @@ void TextureMixer::enqueueGenerate(const MixerParameters &params, int map) {
 	}
 }
 
-// Flush pending requests synchronously; intended to be called from main update() before frame command buffers are recorded
+// Hand pending requests to the upload queue; intended to be called from main update() before frame command buffers are recorded
 void TextureMixer::flushPendingRequests(VulkanApp* app) {
 	std::vector<std::pair<MixerParameters,int>> tasks;
 	{
@@ -122,88 +122,34 @@ void TextureMixer::flushPendingRequests(VulkanApp* app) {
 }
 
 void TextureMixer::pollPendingGenerations(VulkanApp* app) {
-	// Pull any completed fences and promote their logs (check fences BEFORE letting VulkanApp destroy them)
-	completed.clear();
+	// Generations run on TextureArrayManager::uploadQueue: its processUploads()
+	// retires finished jobs (and fires their onResident bookkeeping) without
+	// blocking, so all that is left here is the summary log for the widget.
+	(void)app;
+	size_t reqs = 0;
 	{
-		std::lock_guard<std::mutex> lk(pendingFencesMutex);
-		for (auto it = pendingFences.begin(); it != pendingFences.end(); ) {
-			VkFence f = std::get<0>(*it);
-			uint32_t layer = std::get<1>(*it);
-			if (!app) { ++it; continue; }
-			// If VulkanApp doesn't know about this fence any more, treat it as completed (it was cleaned up elsewhere)
-			if (!app || !app->isFencePending(f)) {
-				completed.push_back(*it);
-				it = pendingFences.erase(it);
-				continue;
-			}
-			VkResult st = vkGetFenceStatus(app->getDevice(), f);
-			if (st == VK_SUCCESS) {
-				// generation complete
-				completed.push_back(*it);
-				it = pendingFences.erase(it);
-			} else if (st == VK_ERROR_DEVICE_LOST) {
-				std::lock_guard<std::mutex> lkll(logsMutex);
-				char buf[256];
-				snprintf(buf, sizeof(buf), "CRITICAL: Device lost detected for fence=%p layer=%u. Aborting resource destruction/reuse for this layer!", (void*)f, layer);
-				logs.emplace_back(buf);
-				std::cerr << "[TextureMixer] " << buf << std::endl;
-				// Do not erase the fence here, keep it for diagnostics
-				++it;
-				continue;
-			} else {
-				// Defensive: if the fence is not signaled, do NOT destroy or reuse any resource for this layer
-				char buf[256];
-				snprintf(buf, sizeof(buf), "WARNING: Fence not signaled for fence=%p layer=%u. Resource destruction/reuse is blocked until signaled.", (void*)f, layer);
-				std::lock_guard<std::mutex> lkll(logsMutex);
-				logs.emplace_back(buf);
-				++it;
-			}
-		}
-	}
-
-	// Let VulkanApp process and cleanup any pending command buffers/fences now that we've recorded completed ones
-	if (app) app->processPendingCommandBuffers();
-
-	for (auto &c : completed) {
-		uint32_t layer = std::get<1>(c);
-		// Mark layer initialized so previews show up
-		if (textureArrayManager) {
-			textureArrayManager->setLayerInitialized(layer, true);
-			// After generation completes, ensure tracked layout is SHADER_READ_ONLY_OPTIMAL for all maps
-			textureArrayManager->setLayerLayout(0, layer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-			textureArrayManager->setLayerLayout(1, layer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-			textureArrayManager->setLayerLayout(2, layer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-			textureArrayManager->setLayerLayout(3, layer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-			textureArrayManager->setLayerLayout(4, layer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		}
-		if (onTextureGeneratedCallback) onTextureGeneratedCallback();
-		{
-			std::lock_guard<std::mutex> lkll(logsMutex);
-			char buf[128];
-			snprintf(buf, sizeof(buf), "Generation complete: layer=%u", layer);
-			logs.emplace_back(buf);
-		}
+		std::lock_guard<std::mutex> lk(pendingRequestsMutex);
+		reqs = pendingRequests.size();
 	}
-
-	// also append a simple summary log line for diagnostics
-	{
-		size_t reqs = pendingRequests.size();
-		size_t fences = pendingFences.size();
-		if (reqs != lastLoggedRequests || fences != lastLoggedFences) {
-			std::lock_guard<std::mutex> lkll(logsMutex);
-			char buf[128];
-			snprintf(buf, sizeof(buf), "Pending: requests=%zu fences=%zu", reqs, fences);
-			logs.emplace_back(buf);
-			lastLoggedRequests = reqs;
-			lastLoggedFences = fences;
-		}
+	size_t inFlight = textureArrayManager ? textureArrayManager->uploadQueue.queuedCount() + textureArrayManager->uploadQueue.inFlightCount() : 0;
+	if (reqs != lastLoggedRequests || inFlight != lastLoggedFences) {
+		std::lock_guard<std::mutex> lkll(logsMutex);
+		char buf[128];
+		snprintf(buf, sizeof(buf), "Pending: requests=%zu gpu=%zu", reqs, inFlight);
+		logs.emplace_back(buf);
+		lastLoggedRequests = reqs;
+		lastLoggedFences = inFlight;
 	}
 }
 
 size_t TextureMixer::getPendingGenerationCount() {
-	std::lock_guard<std::mutex> lk1(pendingRequestsMutex);
-	std::lock_guard<std::mutex> lk2(pendingFencesMutex);
-	return pendingRequests.size() + pendingFences.size();
+	size_t n = 0;
+	{
+		std::lock_guard<std::mutex> lk(pendingRequestsMutex);
+		n = pendingRequests.size();
+	}
+	if (textureArrayManager) n += textureArrayManager->uploadQueue.queuedCount() + textureArrayManager->uploadQueue.inFlightCount();
+	return n;
 }
 
 std::vector<std::string> TextureMixer::consumeLogs() {
@@ -215,41 +161,14 @@ std::vector<std::string> TextureMixer::consumeLogs() {
 
 
 bool TextureMixer::isLayerGenerationPending(uint32_t layer) {
-	std::lock_guard<std::mutex> lk(pendingFencesMutex);
-	for (auto &t : pendingFences) {
-		if (std::get<1>(t) == layer) return true;
-	}
-	return false;
+	return textureArrayManager && textureArrayManager->uploadQueue.isLayerBusy(layer);
 }
 
 bool TextureMixer::waitForLayerGeneration(VulkanApp* app, uint32_t layer, uint64_t timeoutNs) {
-	TextureMixer* g = getGlobalInstance();
-	if (!g || !app) return false;
-	std::vector<VkFence> fences;
-	{
-		std::lock_guard<std::mutex> lk(pendingFencesMutex);
-		for (auto &t : pendingFences) {
-			if (std::get<1>(t) == layer) fences.push_back(std::get<0>(t));
-		}
-	}
-	if (fences.empty()) return false;
-	// Poll each fence via VulkanApp::waitFence instead of vkWaitForFences: the
-	// validation layer's vkWaitForFences performs an internal state-tracking wait
-	// with a finite timeout that spuriously reports INTERNAL-ERROR-VkFence-state-timeout
-	// (most likely a validation bug) and aborts the app. Polling vkGetFenceStatus
-	// is spec-valid and validation-clean.
-	VkResult r = VK_SUCCESS;
-	for (VkFence f : fences) {
-		VkResult fr = VulkanApp::waitFence(app->getDevice(), f, timeoutNs);
-		if (fr != VK_SUCCESS) r = fr;
-	}
-	if (r == VK_SUCCESS) {
-		// process pending generations so state advances
-		if (app) app->processPendingCommandBuffers();
-		g->pollPendingGenerations(app);
-		return true;
-	}
-	return false;
+	if (!app || !isLayerGenerationPending(layer)) return false;
+	// Blocking drain of this layer's queued and in-flight jobs (fence polling
+	// via VulkanApp::waitFence, see TextureUploadQueue::flushLayer).
+	return textureArrayManager->uploadQueue.flushLayer(layer, timeoutNs);
 }
 
 void TextureMixer::cleanup() {
@@ -477,11 +396,13 @@ void TextureMixer::createComputePipeline(VulkanApp* app) {
 				continue;
 			}
 
-			VkDescriptorImageInfo albedoStorageInfo{}; albedoStorageInfo.imageView = textureArrayManager->albedoLayerViews[i]; albedoStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-			VkDescriptorImageInfo normalStorageInfo{}; normalStorageInfo.imageView = textureArrayManager->normalLayerViews[i]; normalStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-			VkDescriptorImageInfo bumpStorageInfo{}; bumpStorageInfo.imageView = textureArrayManager->bumpLayerViews[i]; bumpStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-			VkDescriptorImageInfo roughnessStorageInfo{}; roughnessStorageInfo.imageView = textureArrayManager->roughnessLayerViews[i]; roughnessStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-			VkDescriptorImageInfo aoStorageInfo{}; aoStorageInfo.imageView = textureArrayManager->aoLayerViews[i]; aoStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+			// Compressed maps are written through their work image (layer 0)
+			auto layerStorage = [&](int map, VkImageView layerView) { return textureArrayManager->isMapCompressed(map) ? textureArrayManager->storageView(map) : layerView; };
+			VkDescriptorImageInfo albedoStorageInfo{}; albedoStorageInfo.imageView = layerStorage(0, textureArrayManager->albedoLayerViews[i]); albedoStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+			VkDescriptorImageInfo normalStorageInfo{}; normalStorageInfo.imageView = layerStorage(1, textureArrayManager->normalLayerViews[i]); normalStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+			VkDescriptorImageInfo bumpStorageInfo{}; bumpStorageInfo.imageView = layerStorage(2, textureArrayManager->bumpLayerViews[i]); bumpStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+			VkDescriptorImageInfo roughnessStorageInfo{}; roughnessStorageInfo.imageView = layerStorage(3, textureArrayManager->roughnessLayerViews[i]); roughnessStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+			VkDescriptorImageInfo aoStorageInfo{}; aoStorageInfo.imageView = layerStorage(4, textureArrayManager->aoLayerViews[i]); aoStorageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 			// For sampling in the shader (sampler2DArray) we must bind the ARRAY image view
 			// (VK_IMAGE_VIEW_TYPE_2D_ARRAY). Per-layer 2D views are only for storage writes
@@ -543,27 +464,27 @@ void TextureMixer::createTripleComputeDescriptorSet(VulkanApp* app) {
 
 	// Storage image infos: albedo (binding 0), normal (binding 4), bump (binding 5), roughness (binding 8), ao (binding 9)
 	VkDescriptorImageInfo albedoImageInfo{};
-	if (textureArrayManager) albedoImageInfo.imageView = textureArrayManager->albedoArray.view;
+	if (textureArrayManager) albedoImageInfo.imageView = textureArrayManager->storageView(0);
 	else albedoImageInfo.imageView = VK_NULL_HANDLE;
 	albedoImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo normalImageInfo{};
-	if (textureArrayManager) normalImageInfo.imageView = textureArrayManager->normalArray.view;
+	if (textureArrayManager) normalImageInfo.imageView = textureArrayManager->storageView(1);
 	else normalImageInfo.imageView = VK_NULL_HANDLE;
 	normalImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo bumpImageInfo{};
-	if (textureArrayManager) bumpImageInfo.imageView = textureArrayManager->bumpArray.view;
+	if (textureArrayManager) bumpImageInfo.imageView = textureArrayManager->storageView(2);
 	else bumpImageInfo.imageView = VK_NULL_HANDLE;
 	bumpImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo roughnessImageInfo{};
-	if (textureArrayManager) roughnessImageInfo.imageView = textureArrayManager->roughnessArray.view;
+	if (textureArrayManager) roughnessImageInfo.imageView = textureArrayManager->storageView(3);
 	else roughnessImageInfo.imageView = VK_NULL_HANDLE;
 	roughnessImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo aoImageInfo{};
-	if (textureArrayManager) aoImageInfo.imageView = textureArrayManager->aoArray.view;
+	if (textureArrayManager) aoImageInfo.imageView = textureArrayManager->storageView(4);
 	else aoImageInfo.imageView = VK_NULL_HANDLE;
 	aoImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
@@ -662,23 +583,23 @@ void TextureMixer::updateComputeDescriptorSets(VulkanApp* app) {
 	VkDevice dev = app->getDevice();
 
 	VkDescriptorImageInfo albedoImageInfo{};
-	albedoImageInfo.imageView = textureArrayManager->albedoArray.view;
+	albedoImageInfo.imageView = textureArrayManager->storageView(0);
 	albedoImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo normalImageInfo{};
-	normalImageInfo.imageView = textureArrayManager->normalArray.view;
+	normalImageInfo.imageView = textureArrayManager->storageView(1);
 	normalImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo bumpImageInfo{};
-	bumpImageInfo.imageView = textureArrayManager->bumpArray.view;
+	bumpImageInfo.imageView = textureArrayManager->storageView(2);
 	bumpImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo roughnessImageInfo{};
-	roughnessImageInfo.imageView = textureArrayManager->roughnessArray.view;
+	roughnessImageInfo.imageView = textureArrayManager->storageView(3);
 	roughnessImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo aoImageInfo{};
-	aoImageInfo.imageView = textureArrayManager->aoArray.view;
+	aoImageInfo.imageView = textureArrayManager->storageView(4);
 	aoImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkDescriptorImageInfo albedoSamplerInfo{}; albedoSamplerInfo.imageView = textureArrayManager->albedoArray.view; albedoSamplerInfo.sampler = textureArrayManager->albedoSampler; albedoSamplerInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
@@ -827,11 +748,8 @@ void TextureMixer::createComputeDescriptorSet(int map, VkDescriptorSet& descSet,
 	}
 	VkDescriptorImageInfo imageInfo{};
 	// Storage image for per-map generation: bind the array view (entire array) and use push constant to select layer
-	if (map == 0) imageInfo.imageView = textureArrayManager->albedoArray.view;
-	else if (map == 1) imageInfo.imageView = textureArrayManager->normalArray.view;
-	else if (map == 2) imageInfo.imageView = textureArrayManager->bumpArray.view;
-	else if (map == 3) imageInfo.imageView = textureArrayManager->roughnessArray.view;
-	else imageInfo.imageView = textureArrayManager->aoArray.view;
+	// (the work image for block-compressed maps, see TextureArrayManager::storageView)
+	imageInfo.imageView = textureArrayManager->storageView(map < 0 || map > 4 ? 4 : map);
 	imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 	VkWriteDescriptorSet descriptorWrite{};
@@ -913,7 +831,7 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 		return;
 	}
 
-	PerlinPushConstants pushConstants;
+	PerlinPushConstants pushConstants{};
 	pushConstants.scale = params.perlinScale;
 	pushConstants.octaves = params.perlinOctaves;
 	pushConstants.persistence = params.perlinPersistence;
@@ -928,6 +846,12 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 	pushConstants.secondaryLayer = static_cast<uint32_t>(params.secondaryTextureIdx);
     // Destination layer to write into (if using array layers)
     pushConstants.targetLayer = static_cast<uint32_t>(params.targetLayer);
+	// Block-compressed maps are written to their work image, then encoded
+	if (textureArrayManager) {
+		for (int m = 0; m < 5; ++m) {
+			if (textureArrayManager->isMapCompressed(m)) pushConstants.workLayerMask |= 1u << m;
+		}
+	}
 
 
 	// Require a TextureArrayManager for array-based generation
@@ -948,19 +872,6 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 			if (genB) textureArrayManager->getImTexture(targetLayer, 2);
 			if (genR) textureArrayManager->getImTexture(targetLayer, 3);
 			if (genAO) textureArrayManager->getImTexture(targetLayer, 4);
-
-			// Before recording the async command buffer, ensure any prior generation
-			// that touches this layer has completed. Only wait for layer-specific
-			// fences — do NOT block on unrelated async work (geometry uploads, etc.).
-			if (app) {
-				// Pump pending completions so fences we need to wait on can signal.
-				app->processPendingCommandBuffers();
-			}
-			// If another generation for this layer is pending, wait for it.
-			if (isLayerGenerationPending(targetLayer)) {
-				waitForLayerGeneration(app, targetLayer);
-			}
-
 		}
 	}
 
@@ -968,12 +879,20 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 		throw std::runtime_error("TextureMixer: invalid target layer or missing TextureArrayManager");
 	}
 
-	// Submit the command buffer synchronously — the GPU work for texture
-	// generation is infrequent (happens only when mixer parameters change)
-	// and blocking here is acceptable.  The critical improvement is that we
-	// no longer call waitForAllPendingCommandBuffers() (which would block on
-	// unrelated geometry uploads) and we no longer spin-wait for TRANSFER_DST.
-	app->runSingleTimeCommands([&](VkCommandBuffer cmd) {
+	// Queue the generation on the texture upload queue instead of submitting it
+	// synchronously: slider edits used to stall the frame on a fence wait. The
+	// queue records this job when the layer is idle (coalescing newer requests
+	// for the same layer/map meanwhile), so everything the recording needs is
+	// captured by value. Shaders keep sampling the previous content until the
+	// job retires.
+	streaming::TextureLayerJob job;
+	job.layer = targetLayer;
+	job.map = map;
+	job.record = [=, this](VkCommandBuffer cmd) {
+	// The shader stores to all five maps: every compressed map's work image
+	// must be writable, even when only another map is regenerated.
+	auto compressed = [&](int m) { return textureArrayManager->isMapCompressed(m); };
+	for (int m = 0; m < 5; ++m) textureArrayManager->recordPrepareWorkImage(cmd, m, VK_IMAGE_LAYOUT_GENERAL);
 
 	// Helper to build an image memory barrier for a specific array layer range
 	auto mkBarrierLayer = [&](VkImage img, uint32_t baseArrayLayer, uint32_t layerCount, uint32_t mipLevels) {
@@ -1124,11 +1043,11 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 				return b;
 			};
 
-			if (genA) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->albedoArray.image, targetLayer, textureArrayManager->albedoArray.mipLevels));
-			if (genN) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->normalArray.image, targetLayer, textureArrayManager->normalArray.mipLevels));
-			if (genB) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->bumpArray.image, targetLayer, textureArrayManager->bumpArray.mipLevels));
-			if (genR) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->roughnessArray.image, targetLayer, textureArrayManager->roughnessArray.mipLevels));
-			if (genAO) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->aoArray.image, targetLayer, textureArrayManager->aoArray.mipLevels));
+			if (genA && !compressed(0)) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->albedoArray.image, targetLayer, textureArrayManager->albedoArray.mipLevels));
+			if (genN && !compressed(1)) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->normalArray.image, targetLayer, textureArrayManager->normalArray.mipLevels));
+			if (genB && !compressed(2)) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->bumpArray.image, targetLayer, textureArrayManager->bumpArray.mipLevels));
+			if (genR && !compressed(3)) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->roughnessArray.image, targetLayer, textureArrayManager->roughnessArray.mipLevels));
+			if (genAO && !compressed(4)) mipPrepBarriers.push_back(mkBaseLevelPrep(textureArrayManager->aoArray.image, targetLayer, textureArrayManager->aoArray.mipLevels));
 
 				if (!mipPrepBarriers.empty()) {
 				for (auto &b : mipPrepBarriers) {
@@ -1138,19 +1057,19 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 
 			// Record mipmap generation into the same command buffer
 			if (textureArrayManager) {
-				if (genA && textureArrayManager->albedoArray.mipLevels > 1 && textureArrayManager->albedoArray.image != VK_NULL_HANDLE) {
+				if (genA && !compressed(0) && textureArrayManager->albedoArray.mipLevels > 1 && textureArrayManager->albedoArray.image != VK_NULL_HANDLE) {
 					app->recordGenerateMipmaps(cmd, textureArrayManager->albedoArray.image, VK_FORMAT_R8G8B8A8_UNORM, static_cast<int32_t>(width), static_cast<int32_t>(height), textureArrayManager->albedoArray.mipLevels, 1, targetLayer);
 				}
-				if (genN && textureArrayManager->normalArray.mipLevels > 1 && textureArrayManager->normalArray.image != VK_NULL_HANDLE) {
+				if (genN && !compressed(1) && textureArrayManager->normalArray.mipLevels > 1 && textureArrayManager->normalArray.image != VK_NULL_HANDLE) {
 					app->recordGenerateMipmaps(cmd, textureArrayManager->normalArray.image, VK_FORMAT_R8G8B8A8_UNORM, static_cast<int32_t>(width), static_cast<int32_t>(height), textureArrayManager->normalArray.mipLevels, 1, targetLayer);
 				}
-				if (genB && textureArrayManager->bumpArray.mipLevels > 1 && textureArrayManager->bumpArray.image != VK_NULL_HANDLE) {
+				if (genB && !compressed(2) && textureArrayManager->bumpArray.mipLevels > 1 && textureArrayManager->bumpArray.image != VK_NULL_HANDLE) {
 					app->recordGenerateMipmaps(cmd, textureArrayManager->bumpArray.image, VK_FORMAT_R8G8B8A8_UNORM, static_cast<int32_t>(width), static_cast<int32_t>(height), textureArrayManager->bumpArray.mipLevels, 1, targetLayer);
 				}
-				if (genR && textureArrayManager->roughnessArray.mipLevels > 1 && textureArrayManager->roughnessArray.image != VK_NULL_HANDLE) {
+				if (genR && !compressed(3) && textureArrayManager->roughnessArray.mipLevels > 1 && textureArrayManager->roughnessArray.image != VK_NULL_HANDLE) {
 					app->recordGenerateMipmaps(cmd, textureArrayManager->roughnessArray.image, VK_FORMAT_R8G8B8A8_UNORM, static_cast<int32_t>(width), static_cast<int32_t>(height), textureArrayManager->roughnessArray.mipLevels, 1, targetLayer);
 				}
-				if (genAO && textureArrayManager->aoArray.mipLevels > 1 && textureArrayManager->aoArray.image != VK_NULL_HANDLE) {
+				if (genAO && !compressed(4) && textureArrayManager->aoArray.mipLevels > 1 && textureArrayManager->aoArray.image != VK_NULL_HANDLE) {
 					app->recordGenerateMipmaps(cmd, textureArrayManager->aoArray.image, VK_FORMAT_R8G8B8A8_UNORM, static_cast<int32_t>(width), static_cast<int32_t>(height), textureArrayManager->aoArray.mipLevels, 1, targetLayer);
 				}
 			}
@@ -1172,16 +1091,16 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 						b.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
 						return b;
 					};
-				if (genA && textureArrayManager->albedoArray.mipLevels <= 1)
+				if (genA && !compressed(0) && textureArrayManager->albedoArray.mipLevels <= 1)
 						postBarriers.push_back(mkPost(textureArrayManager->albedoArray.image));
-				if (genN && textureArrayManager->normalArray.mipLevels <= 1)
+				if (genN && !compressed(1) && textureArrayManager->normalArray.mipLevels <= 1)
 						postBarriers.push_back(mkPost(textureArrayManager->normalArray.image));
-				if (genB && textureArrayManager->bumpArray.mipLevels <= 1) {
+				if (genB && !compressed(2) && textureArrayManager->bumpArray.mipLevels <= 1) {
 					postBarriers.push_back(mkPost(textureArrayManager->bumpArray.image));
 				}
-				if (genR && textureArrayManager->roughnessArray.mipLevels <= 1)
+				if (genR && !compressed(3) && textureArrayManager->roughnessArray.mipLevels <= 1)
 					postBarriers.push_back(mkPost(textureArrayManager->roughnessArray.image));
-				if (genAO && textureArrayManager->aoArray.mipLevels <= 1)
+				if (genAO && !compressed(4) && textureArrayManager->aoArray.mipLevels <= 1)
 					postBarriers.push_back(mkPost(textureArrayManager->aoArray.image));
 				if (!postBarriers.empty()) {
 					for (auto &b : postBarriers) {
@@ -1189,6 +1108,13 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 					}
 				}
 			}
+
+			// Block-compressed maps: mip the work image and encode it into the
+			// target layer, which ends in SHADER_READ_ONLY_OPTIMAL as well.
+			const bool gen[5] = { genA, genN, genB, genR, genAO };
+			for (int m = 0; m < 5; ++m) {
+				if (gen[m] && compressed(m)) textureArrayManager->recordEncodeLayer(app, cmd, m, targetLayer, VK_IMAGE_LAYOUT_GENERAL);
+			}
 				}
 
 	// Restore all NON-target layers from GENERAL back to SHADER_READ_ONLY_OPTIMAL.
@@ -1227,18 +1153,24 @@ void TextureMixer::generatePerlinNoise(VulkanApp* app, MixerParameters &params,
 		}
 	}
 
-	}); // runSingleTimeCommands: recorded and submitted synchronously
-
-	// Synchronous generation complete: mark layer initialized and update layouts
-	if (textureArrayManager) {
-		textureArrayManager->setLayerInitialized(targetLayer, true);
-		textureArrayManager->setLayerLayout(0, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		textureArrayManager->setLayerLayout(1, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		textureArrayManager->setLayerLayout(2, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		textureArrayManager->setLayerLayout(3, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		textureArrayManager->setLayerLayout(4, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-	}
-	if (onTextureGeneratedCallback) {
-		onTextureGeneratedCallback();
-	}
+	// Tracked layouts describe the state at the end of the queue (every layer
+	// is back in SHADER_READ_ONLY_OPTIMAL), which is what the next recorded job
+	// must use as its oldLayout.
+	textureArrayManager->setLayerLayout(0, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	textureArrayManager->setLayerLayout(1, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	textureArrayManager->setLayerLayout(2, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	textureArrayManager->setLayerLayout(3, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	textureArrayManager->setLayerLayout(4, targetLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	}; // job.record: runs from TextureUploadQueue::processUploads()
+
+	job.onResident = [this, targetLayer]() {
+		// Generation retired on the GPU: the layer now holds valid data
+		if (textureArrayManager) textureArrayManager->setLayerInitialized(targetLayer, true);
+		if (onTextureGeneratedCallback) onTextureGeneratedCallback();
+		std::lock_guard<std::mutex> lkll(logsMutex);
+		char buf[128];
+		snprintf(buf, sizeof(buf), "Generation complete: layer=%u", targetLayer);
+		logs.emplace_back(buf);
+	};
+	textureArrayManager->uploadQueue.enqueue(std::move(job));
 }
@@ -45,15 +45,16 @@ public:
     // Generate all textures initially
     void generateInitialTextures(std::vector<MixerParameters> &mixerParams);
 
-    // Queue a generation request from UI thread; flushed synchronously from main update
+    // Queue a generation request from UI thread; flushed from the main update loop
     void enqueueGenerate(const MixerParameters &params, int map = -1);
-    // Flush pending generation requests synchronously (call from main update loop)
+    // Hand pending generation requests to the TextureArrayManager upload queue
+    // (call from main update loop). Does not wait for the GPU.
     void flushPendingRequests(VulkanApp* app);
 
-    // Poll for completed async generation fences and invoke callbacks (called from update()/preRender)
+    // Log a summary of pending generations; completion itself is handled by the upload queue
     void pollPendingGenerations(VulkanApp* app);
 
-    // Diagnostics: number of pending async generations and a small log buffer
+    // Diagnostics: number of pending generations (requests + queued/in-flight GPU jobs) and a small log buffer
     size_t getPendingGenerationCount();
     std::vector<std::string> consumeLogs();
 
@@ -62,6 +63,7 @@ public:
     uint32_t getLayerHeight() const;
     // Generate Perlin noise for a texture using explicit parameters (used by UI widget)
     // map: -1 = all maps, 0 = albedo, 1 = normal, 2 = bump
+    // The GPU work is queued on TextureArrayManager::uploadQueue and completes asynchronously.
     void generatePerlinNoise(VulkanApp* app, MixerParameters &params, int map = -1);
 
     // Debug output mode: when enabled the compute shader writes the noise value to
@@ -104,11 +106,6 @@ private:
     std::mutex pendingRequestsMutex;
     std::vector<std::pair<MixerParameters,int>> pendingRequests;
 
-    // Pending async fences (fence, layer) for in-flight generation submissions
-    std::mutex pendingFencesMutex;
-    std::vector<std::tuple<VkFence, uint32_t>> pendingFences;
-    std::vector<std::tuple<VkFence, uint32_t>> completed;
-
     // If editable textures are represented inside a TextureArrayManager, store the layer index
     // NOTE: placed BEFORE logs to avoid aliasing with vector internal pointers
     uint32_t editableLayer = UINT32_MAX;
@@ -124,8 +121,9 @@ public:
 
     // Query whether a layer currently has an in-flight generation
     bool isLayerGenerationPending(uint32_t layer);
-    // Block until generation for a specific layer completes (returns true if waited)
-    // This uses Vulkan fences and will block until the generation fence signals.
+    // Block until generation for a specific layer completes or timeoutNs elapses.
+    // Returns true when a pending generation finished within the timeout.
+    // Drains the layer on the upload queue; only for rare callers that must read it back.
     bool waitForLayerGeneration(VulkanApp* app, uint32_t layer, uint64_t timeoutNs = UINT64_MAX);
 
     // Global instance accessor (set on init) so external systems can wait for generations
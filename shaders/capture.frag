@@ -1,8 +1,10 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 // Impostor capture — stores composite albedo WITHOUT baked lighting.
 // Real-time ambient + diffuse + specular is applied in impostors.frag.
 
 #include "includes/locations.glsl"
+#include "includes/normal_encoding.glsl"
 
 layout(location = VARY_UV) in vec3 inTexCoord;
 layout(location = VARY_BRUSHPATCH) flat in int inBrushIndex;
@@ -21,30 +23,25 @@ layout(set = 0, binding = 0) uniform SolidParamsUBO {
     vec4 lightColor;
 } ubo;
 
-layout(set = 1, binding = 0) uniform sampler2DArray albedoArray;
-layout(set = 1, binding = 1) uniform sampler2DArray normalArray;
-layout(set = 1, binding = 2) uniform sampler2DArray opacityArray;
+#include "includes/vegetation_params.glsl"
 
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#define albedoArray  bindlessTextureArrays[albedoTexture]
+#define normalArray  bindlessTextureArrays[normalTexture]
+#define opacityArray bindlessTextureArrays[opacityTexture]
 
 void main() {
     vec3 coord = vec3(inTexCoord.xy, inTexCoord.z);
 
     vec4  leafAlbedo  = texture(albedoArray,  coord);
     float opacity     = texture(opacityArray, coord).r;
-    vec3  leafNormEnc = texture(normalArray,  coord).rgb;
+    vec4  leafNormEnc = texture(normalArray,  coord);
 
     const float kAvgMip = 5.0;
     vec3 bgAlbedo  = textureLod(albedoArray, coord, kAvgMip).rgb;
-    vec3 bgNormEnc = textureLod(normalArray, coord, kAvgMip).rgb;
+    vec4 bgNormEnc = textureLod(normalArray, coord, kAvgMip);
 
-    vec3 leafNorm = normalize(leafNormEnc * 2.0 - 1.0);
-    vec3 bgNorm   = normalize(bgNormEnc   * 2.0 - 1.0);
+    vec3 leafNorm = unpackNormalMap(leafNormEnc);
+    vec3 bgNorm   = unpackNormalMap(bgNormEnc);
 
     float leafNConf     = clamp(leafNorm.z, 0.0, 1.0);
     float bgNConf       = clamp(bgNorm.z,   0.0, 1.0);
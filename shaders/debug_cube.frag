@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -7,11 +8,17 @@ layout(location = VARY_COLOR) in vec3 fragColor;
 
 layout(location = FRAG_OUT_COLOR) out vec4 outColor;
 
-layout(set = 1, binding = 1) uniform sampler2D gridTexture;
+#include "includes/bindless.glsl"
+
+// Heap slots (DebugCubeRenderer::render)
+layout(push_constant) uniform PushConstants {
+    uint instanceBuffer;
+    uint gridTexture;
+};
 
 void main() {
     // Sample the grid texture using XY coordinates (triplanar could be used too)
-    vec4 texColor = texture(gridTexture, fragTexCoord.xy);
+    vec4 texColor = texture(bindlessTextures[gridTexture], fragTexCoord.xy);
     
     // Modulate grid texture by node color to tint it while keeping pattern
     vec3 finalColor = texColor.rgb * fragColor;
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -16,12 +17,18 @@ struct InstanceData {
     vec4 color;  // vec4 for proper alignment
 };
 
-layout(set = 1, binding = 2, std430) readonly buffer InstanceBuffer {
-    InstanceData instances[];
+// Heap slots (DebugCubeRenderer::render)
+layout(push_constant) uniform PushConstants {
+    uint instanceBuffer;
+    uint gridTexture;
 };
 
+layout(std430, set = BINDLESS_SET, binding = 1) readonly buffer InstanceBuffer {
+    InstanceData instances[];
+} bindlessDebugCubes[];
+
 void main() {
-    InstanceData inst = instances[gl_InstanceIndex];
+    InstanceData inst = bindlessDebugCubes[instanceBuffer].instances[gl_InstanceIndex];
     vec4 worldPos = inst.model * vec4(inPosition, 1.0);
     gl_Position = ubo.viewProjection * worldPos;
     fragTexCoord = inTexCoord;
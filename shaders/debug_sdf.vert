@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -17,10 +18,15 @@ struct InstanceData {
     vec4 meta; // meta.x = brushIndex (stored as float)
 };
 
-layout(set = 1, binding = 0, std430) readonly buffer InstanceBuffer {
-    InstanceData instances[];
+// Heap slot (DebugSDFRenderer::render)
+layout(push_constant) uniform PushConstants {
+    uint instanceBuffer;
 };
 
+layout(std430, set = BINDLESS_SET, binding = 1) readonly buffer InstanceBuffer {
+    InstanceData instances[];
+} bindlessDebugSDF[];
+
 float getCornerSdf(InstanceData inst, uint cornerIndex) {
     if (cornerIndex == 0u) return inst.sdf0.x;
     if (cornerIndex == 1u) return inst.sdf0.y;
@@ -33,7 +39,7 @@ float getCornerSdf(InstanceData inst, uint cornerIndex) {
 }
 
 void main() {
-    InstanceData inst = instances[gl_InstanceIndex];
+    InstanceData inst = bindlessDebugSDF[instanceBuffer].instances[gl_InstanceIndex];
     vec4 worldPos = inst.model * vec4(inPosition, 1.0);
     gl_Position = ubo.viewProjection * worldPos;
     fragSdf = getCornerSdf(inst, inCornerIndex);
@@ -1,58 +1,56 @@
 
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
-// xy=UV, z=float(layerIdx) packed by the geometry shader.
+// xy=UV, z=float(layerIdx) of the dominant capture frame.
 layout(location = VARY_UV) in vec3 inTexCoord;
 layout(location = VARY_POSWORLD) in vec3 inWorldPos;
 layout(location = VARY_FACE_NORMAL) flat in vec3 inFaceNormal;
 layout(location = VARY_ROTFRAC) flat in float inRotFrac;
 layout(location = VARY_POSLIGHT) flat in vec3 inInstanceOffset;
+layout(location = VARY_BRUSHPATCH) flat in ivec3 inFrameLayers;
+layout(location = VARY_TEXWEIGHTS) flat in vec3 inFrameWeights;
 
 layout(location = FRAG_OUT_COLOR) out vec4 outColor;
 
 #include "includes/ubo.glsl"
 
-layout(set = 0, binding = 4) uniform sampler2D shadowMap;
-layout(set = 0, binding = 8) uniform sampler2D shadowMap1;
-layout(set = 0, binding = 9) uniform sampler2D shadowMap2;
+#include "includes/vegetation_params.glsl"
+#include "includes/textures.glsl"
 
-// 60-layer impostor arrays: 3 billboard types × 20 Fibonacci views.
-layout(set = 1, binding = 0) uniform sampler2DArray impostorArray;
-layout(set = 1, binding = 1) uniform sampler2DArray impostorNormalArray;
+// Impostor arrays: 3 billboard types × views per type (Fibonacci or octahedral).
+#define impostorArray       bindlessTextureArrays[impostorTexture]
+#define impostorNormalArray bindlessTextureArrays[impostorNormalTexture]
 
 // Depth data for deferred depth test: reconstruct world position from captured
 // depth and write gl_FragDepth so the EQUAL compare in the shading pass matches
 // the depth written by the impostor depth prepass.
-layout(set = 1, binding = 2) uniform sampler2DArray depthArray;
-layout(set = 1, binding = 3) readonly buffer CaptureInvVP {
-    mat4 invVP[];
-};
-
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#define depthArray bindlessTextureArrays[impostorDepthTexture]
+#define invVP      bindlessCaptureInvVP[captureInvVPBuffer].invVP
 
 vec3 fragPosWorld; // set in main() — required by shadows.glsl cascades 1 & 2
 
 #include "includes/shadows.glsl"
 
 void main() {
-    vec4 color = texture(impostorArray, inTexCoord);
+    // Blend the capture frames around the view direction (a single frame for
+    // the Fibonacci layout). Colour and normal are alpha weighted so the
+    // transparent surround of one frame does not darken the others.
+    vec4 color = vec4(0.0);
+    vec3 normalSum = vec3(0.0);
+    for (int i = 0; i < 3; ++i) {
+        float w = inFrameWeights[i];
+        if (w <= 0.0) continue;
+        vec3 uvw = vec3(inTexCoord.xy, float(inFrameLayers[i]));
+        vec4 c = texture(impostorArray, uvw);
+        float wa = w * c.a;
+        color += vec4(c.rgb * wa, wa);
+        normalSum += (texture(impostorNormalArray, uvw).rgb * 2.0 - 1.0) * wa;
+    }
     if (color.a < 0.3) discard;
+    color.rgb /= color.a;
     fragPosWorld = inWorldPos; // must be set before any ShadowCalculation call
 
     // Reconstruct per-pixel depth from captured depth map so the deferred
@@ -87,7 +85,7 @@ void main() {
     // The capture was done for a canonical (theta=0) plant orientation, so we must
     // rotate the decoded normal by the per-instance Y-axis rotation to match the
     // actual plant orientation at runtime (same rotateY convention as vegetation_common.glsl).
-    vec3 N_raw = normalize(texture(impostorNormalArray, inTexCoord).rgb * 2.0 - 1.0);
+    vec3 N_raw = normalize(normalSum);
     float theta = inRotFrac * 6.28318530718;
     float cosT  = cos(theta);
     float sinT  = sin(theta);
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -10,30 +11,20 @@ layout(location = VARY_POSWORLD) out vec3 outWorldPos;
 layout(location = VARY_FACE_NORMAL) flat out vec3 outFaceNormal;
 layout(location = VARY_ROTFRAC) flat out float outRotFrac;
 layout(location = VARY_POSLIGHT) flat out vec3 outInstanceOffset;
+// Array layers of the 3 capture frames to blend, and their weights.
+layout(location = VARY_BRUSHPATCH) flat out ivec3 outFrameLayers;
+layout(location = VARY_TEXWEIGHTS) flat out vec3 outFrameWeights;
 
 layout(set = 0, binding = 0) uniform SolidParamsUBO {
     mat4 viewProjection;
     vec4 viewPos;
 } ubo;
 
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#include "includes/vegetation_params.glsl"
 
 #include "includes/perlin2d.glsl"
 #include "includes/vegetation_common.glsl"
+#include "includes/impostor_views.glsl"
 
 void main() {
     vec3 worldPos = instanceData.xyz;
@@ -47,6 +38,7 @@ void main() {
     if (impostorDistance <= 0.0 || dist < impostorDistance * 0.50) {
         outTexCoord = vec3(0.0); outWorldPos = worldPos; outFaceNormal = vec3(0.0, 1.0, 0.0);
         outInstanceOffset = worldPos;
+        outFrameLayers = ivec3(0); outFrameWeights = vec3(1.0, 0.0, 0.0);
         gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
         return;
     }
@@ -57,6 +49,7 @@ void main() {
         if (keep > densityFactor) {
             outTexCoord = vec3(0.0); outWorldPos = worldPos; outFaceNormal = vec3(0.0, 1.0, 0.0);
             outInstanceOffset = worldPos;
+            outFrameLayers = ivec3(0); outFrameWeights = vec3(1.0, 0.0, 0.0);
             gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
             return;
         }
@@ -64,9 +57,6 @@ void main() {
 
     outInstanceOffset = worldPos;
 
-    const float goldenAngle = 3.14159265358979323846 * (3.0 - 2.2360679774997896);
-    const int NUM_VIEWS = 20;
-
     vec3 toCamera = normalize(camPos - worldPos);
 
     float instTheta = rotFrac * 6.28318530718;
@@ -78,18 +68,14 @@ void main() {
         -sI * toCamera.x + cI * toCamera.z
     );
 
-    int bestIdx = 0;
-    float bestDot = -2.0;
-    for (int i = 0; i < NUM_VIEWS; i++) {
-        float y = 1.0 - (float(i) + 0.5) / float(NUM_VIEWS) * 2.0;
-        float r = sqrt(max(0.0, 1.0 - y * y));
-        float theta = goldenAngle * float(i);
-        vec3 d = vec3(cos(theta) * r, y, sin(theta) * r);
-        float dt = dot(toCamera_canonical, d);
-        if (dt > bestDot) { bestDot = dt; bestIdx = i; }
-    }
+    ivec3 frames;
+    vec3 frameWeights;
+    impostorViewFrames(toCamera_canonical, frames, frameWeights);
 
-    int layerIdx = clamp(billboardIdx, 0, 2) * NUM_VIEWS + bestIdx;
+    int layerBase = clamp(billboardIdx, 0, 2) * impostorViewsPerType();
+    outFrameLayers = layerBase + frames;
+    outFrameWeights = frameWeights;
+    int layerIdx = layerBase + impostorDominantFrame(frames, frameWeights);
 
     float hs = vegetationHeightScale(worldPos.xz);
 
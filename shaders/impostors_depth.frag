@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -10,27 +11,10 @@ layout(set = 0, binding = 0) uniform SolidParamsUBO {
     vec4 viewPos;
 } ubo;
 
-layout(set = 1, binding = 0) uniform sampler2DArray depthArray;
+#include "includes/vegetation_params.glsl"
 
-layout(set = 1, binding = 1) readonly buffer CaptureInvVP {
-    mat4 invVP[];
-};
-
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#define depthArray bindlessTextureArrays[impostorDepthTexture]
+#define invVP      bindlessCaptureInvVP[captureInvVPBuffer].invVP
 
 void main() {
     int layer = int(inTexCoord.z);
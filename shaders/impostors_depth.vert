@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -14,24 +15,11 @@ layout(set = 0, binding = 0) uniform SolidParamsUBO {
     vec4 viewPos;
 } ubo;
 
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#include "includes/vegetation_params.glsl"
 
 #include "includes/perlin2d.glsl"
 #include "includes/vegetation_common.glsl"
+#include "includes/impostor_views.glsl"
 
 void main() {
     // Sentinel: instance was skipped by generator (empty biome or steep slope).
@@ -71,9 +59,6 @@ void main() {
 
     outInstanceOffset = worldPos;
 
-    const float goldenAngle = 3.14159265358979323846 * (3.0 - 2.2360679774997896);
-    const int NUM_VIEWS = 20;
-
     vec3 toCamera = normalize(ubo.viewPos.xyz - worldPos);
 
     float instTheta = rotFrac * 6.28318530718;
@@ -85,18 +70,13 @@ void main() {
         -sI * toCamera.x + cI * toCamera.z
     );
 
-    int bestIdx = 0;
-    float bestDot = -2.0;
-    for (int i = 0; i < NUM_VIEWS; i++) {
-        float y = 1.0 - (float(i) + 0.5) / float(NUM_VIEWS) * 2.0;
-        float r = sqrt(max(0.0, 1.0 - y * y));
-        float theta = goldenAngle * float(i);
-        vec3 d = vec3(cos(theta) * r, y, sin(theta) * r);
-        float dt = dot(toCamera_canonical, d);
-        if (dt > bestDot) { bestDot = dt; bestIdx = i; }
-    }
-
-    int layerIdx = clamp(billboardIdx, 0, 2) * NUM_VIEWS + bestIdx;
+    // Depth and shadow passes read a single frame: the most heavily weighted
+    // one, which the color pass also uses for its depth.
+    ivec3 frames;
+    vec3 frameWeights;
+    impostorViewFrames(toCamera_canonical, frames, frameWeights);
+    int layerIdx = clamp(billboardIdx, 0, 2) * impostorViewsPerType()
+                 + impostorDominantFrame(frames, frameWeights);
 
     float hs = vegetationHeightScale(worldPos.xz);
 
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // Impostor EVSM2 shadow pass: uses vertex position from vertex shader
 // to write EVSM moments.
@@ -16,21 +17,7 @@ layout(set = 0, binding = 0) uniform SolidParamsUBO {
 
 layout(location = FRAG_OUT_COLOR) out vec2 outEVSM;
 
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#include "includes/vegetation_params.glsl"
 
 void main() {
     // Dithered cross-fade (same as impostors_depth.frag).
@@ -0,0 +1,20 @@
+// Global bindless heap (BindlessHeap.cpp). Requires
+// GL_EXT_nonuniform_qualifier in the including shader.
+//   binding 0: combined image samplers, declared once per sampler type
+//              (aliasing the same binding is allowed)
+//   binding 1: storage buffers, declared by each user as a runtime array of
+//              its own block type (see ubo.glsl, vegetation_params.glsl)
+// Slots come from the frame UBO, push constants or per-draw data; wrap them
+// in nonuniformEXT() when they vary within a draw.
+#ifndef BINDLESS_GLSL
+#define BINDLESS_GLSL
+
+#ifndef BINDLESS_SET
+#define BINDLESS_SET 1
+#endif
+
+layout(set = BINDLESS_SET, binding = 0) uniform sampler2D      bindlessTextures[];
+layout(set = BINDLESS_SET, binding = 0) uniform sampler2DArray bindlessTextureArrays[];
+layout(set = BINDLESS_SET, binding = 0) uniform samplerCube    bindlessCubes[];
+
+#endif
@@ -0,0 +1,70 @@
+// Frustum and LoD-band tests shared by the GPU cull passes (indirect.comp,
+// cluster_cull.comp, cascade_cull.comp, veg_cascade_cull.comp). Keep every
+// pass on these helpers: a chunk the main pass keeps must be kept by the
+// cluster pass too, or whole chunks flicker out when cluster culling is on.
+
+#ifndef CULL_GLSL
+#define CULL_GLSL
+
+// selectLodBand() result for entries without LoD meta (always kept).
+const uint NO_LOD_LEVEL = 0xFFFFFFFFu;
+
+// Normalize a frustum plane (n, d) by its normal length so the distance test is
+// stable. Length is never zero for a valid view-projection matrix.
+vec4 normalizePlane(vec4 pl) {
+    float len = length(pl.xyz);
+    return pl / max(len, 1e-8);
+}
+
+// Plane `i` (left, right, bottom, top, near, far) of `viewProj`, normalized.
+// GLSL `mat4` is column-major, so the rows are gathered by hand.
+vec4 frustumPlane(mat4 viewProj, uint i) {
+    vec4 row0 = vec4(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+    vec4 row1 = vec4(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+    vec4 row2 = vec4(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+    vec4 row3 = vec4(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+    if (i == 0u) return normalizePlane(row3 + row0); // left
+    if (i == 1u) return normalizePlane(row3 - row0); // right
+    if (i == 2u) return normalizePlane(row3 + row1); // bottom
+    if (i == 3u) return normalizePlane(row3 - row1); // top
+    if (i == 4u) return normalizePlane(row2);        // near (Vulkan NDC z in [0,w])
+    return normalizePlane(row3 - row2);              // far
+}
+
+// AABB vs frustum: for each plane, test the box's most positive vertex.
+// False only when the box lies entirely outside one plane.
+bool aabbVisible(vec4 planes[6], vec3 minp, vec3 maxp) {
+    for (int i = 0; i < 6; ++i) {
+        vec3 n = planes[i].xyz;
+        vec3 p;
+        p.x = (n.x >= 0.0) ? maxp.x : minp.x;
+        p.y = (n.y >= 0.0) ? maxp.y : minp.y;
+        p.z = (n.z >= 0.0) ? maxp.z : minp.z;
+        if (dot(n, p) + planes[i].w < 0.0) return false;
+    }
+    return true;
+}
+
+// Per-chunk LoD band: the level the camera distance selects for the pyramid
+// the entry belongs to. lodMeta = {cellSize, level, maxLevel, unused} with
+// cellSize the entry's own cube length; cellSize <= 0 returns NO_LOD_LEVEL.
+//   band = dist(camPos, anchor) / (baseCell * lodBias)
+// baseCell = cellSize / 2^level is the frontier cell size and anchor the
+// centre of the pyramid root cube (side cellSize * 2^(maxLevel - level), min
+// corner the grid-aligned floor of the entry's AABB min). Every level of a
+// pyramid derives the same anchor, so the bands tile distance and exactly one
+// level matches; the coarsest level covers everything beyond its band.
+uint selectLodBand(vec3 minp, vec4 lodMeta, vec3 camPos, float lodBias) {
+    float cellSize = lodMeta.x;
+    if (cellSize <= 0.0) return NO_LOD_LEVEL;
+    int entryLevel = int(lodMeta.y + 0.5);
+    int maxLevel   = int(lodMeta.z + 0.5);
+    float baseCell = cellSize / exp2(float(max(entryLevel, 0)));
+    float rootSide = cellSize * exp2(float(maxLevel - entryLevel));
+    vec3 rootMin = floor(minp / rootSide) * rootSide;
+    vec3 anchor = rootMin + 0.5 * rootSide;
+    float band = distance(camPos, anchor) / (baseCell * lodBias);
+    return uint(min(floor(band), float(maxLevel)));
+}
+
+#endif
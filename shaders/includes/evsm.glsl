@@ -14,13 +14,10 @@ float chebyshevUpperBound(vec2 moments, float t) {
     return p_max;
 }
 
-float ShadowEVSM(sampler2D smap, vec3 projCoords, float bias) {
-    float fragDepth = clamp(projCoords.z, 0.0, 1.0) - bias;
-
+// Shadow factor from filtered moments for an already biased test depth.
+float evsmShadow(vec2 moments, float fragDepth) {
     float posDepth = exp( EVSM_C * fragDepth);
 
-    vec2 moments = texture(smap, projCoords.xy).xy;
-
     float posProb = chebyshevUpperBound(moments, posDepth);
 
     float shadow = 1.0 - posProb;
@@ -32,3 +29,16 @@ float ShadowEVSM(sampler2D smap, vec3 projCoords, float bias) {
 
     return shadow;
 }
+
+float ShadowEVSM(sampler2D smap, vec3 projCoords, float bias) {
+    float fragDepth = clamp(projCoords.z, 0.0, 1.0) - bias;
+    vec2 moments = texture(smap, projCoords.xy).xy;
+    return evsmShadow(moments, fragDepth);
+}
+
+// Layered variant used by the virtual shadow map atlas (uvLayer.z = layer).
+float ShadowEVSMLayer(sampler2DArray smap, vec3 uvLayer, float depth, float bias) {
+    float fragDepth = clamp(depth, 0.0, 1.0) - bias;
+    vec2 moments = texture(smap, uvLayer).xy;
+    return evsmShadow(moments, fragDepth);
+}
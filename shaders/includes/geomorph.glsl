@@ -0,0 +1,29 @@
+// Continuous LoD geomorphing (matches packMorph in space/MeshSimplifier.hpp).
+// Requires the SolidParamsUBO block `ubo`:
+//   lodParams.x = frontier cell size (0 = geomorph off)
+//   lodParams.y = lodBias, lodParams.z = band width, lodParams.w = maxLevel
+//
+// A chunk at level L is drawn while floor(band) == L, with band measured from
+// its root cell's centre exactly as in indirect.comp. Over the last `width` of
+// that range every vertex slides linearly onto its coarser-level position, so
+// the switch to L + 1 at band == L + 1 swaps two (nearly) identical surfaces.
+// All chunks of one root cell share the anchor, so a chunk morphs as a whole.
+
+vec3 geomorphDelta(uint morph) {
+    float step = exp2(float(morph >> 27u) - 16.0);
+    ivec3 q = ivec3(int(morph << 24u), int(morph << 16u), int(morph << 8u)) >> 24;
+    return vec3(q) * step;
+}
+
+vec3 applyGeomorph(vec3 pos, uint morph) {
+    float baseCell = ubo.lodParams.x;
+    float width = ubo.lodParams.z;
+    if (morph == 0u || baseCell <= 0.0 || width <= 0.0) return pos;
+
+    float level = float((morph >> 24u) & 7u);
+    float rootSide = baseCell * exp2(ubo.lodParams.w);
+    vec3 anchor = floor(pos / rootSide) * rootSide + 0.5 * rootSide;
+    float band = distance(ubo.viewPos.xyz, anchor) / (baseCell * ubo.lodParams.y);
+    float t = clamp((band - (level + 1.0 - width)) / width, 0.0, 1.0);
+    return pos + geomorphDelta(morph) * t;
+}
@@ -0,0 +1,66 @@
+// Impostor capture view selection (matches ImpostorCapture::generateViewDirs).
+// Requires the WindParamsUBO block `windParams`:
+//   impostorParams.x = octahedral grid size (0 = 20 Fibonacci views)
+//   impostorParams.y = views per billboard type (layer = type * views + frame)
+
+int impostorViewsPerType() {
+    return max(int(windParams.impostorParams.y + 0.5), 1);
+}
+
+// Octahedral map of the unit sphere (y up) to [0,1]².
+vec2 impostorOctEncode(vec3 d) {
+    vec3 n = d / (abs(d.x) + abs(d.y) + abs(d.z));
+    vec2 p = n.xz;
+    if (n.y < 0.0) {
+        p = (1.0 - abs(p.yx)) * vec2(p.x >= 0.0 ? 1.0 : -1.0, p.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return p * 0.5 + 0.5;
+}
+
+// Capture frames (within one billboard type) to sample for the direction
+// from the billboard to the camera in the plant's canonical orientation,
+// with blend weights summing to 1.
+//  - Octahedral: the 3 grid vertices of the triangle containing the
+//    direction, weighted barycentrically.
+//  - Fibonacci: the closest view, weight 1 (all three entries equal).
+void impostorViewFrames(vec3 dirCanonical, out ivec3 frames, out vec3 weights) {
+    int grid = int(windParams.impostorParams.x + 0.5);
+    if (grid < 2) {
+        const float goldenAngle = 3.14159265358979323846 * (3.0 - 2.2360679774997896);
+        int numViews = impostorViewsPerType();
+        int bestIdx = 0;
+        float bestDot = -2.0;
+        for (int i = 0; i < numViews; i++) {
+            float y = 1.0 - (float(i) + 0.5) / float(numViews) * 2.0;
+            float r = sqrt(max(0.0, 1.0 - y * y));
+            float theta = goldenAngle * float(i);
+            vec3 d = vec3(cos(theta) * r, y, sin(theta) * r);
+            float dt = dot(dirCanonical, d);
+            if (dt > bestDot) { bestDot = dt; bestIdx = i; }
+        }
+        frames = ivec3(bestIdx);
+        weights = vec3(1.0, 0.0, 0.0);
+        return;
+    }
+
+    vec2 g = impostorOctEncode(dirCanonical) * float(grid - 1);
+    vec2 cell = min(floor(g), vec2(float(grid - 2)));
+    vec2 f = g - cell;
+    ivec2 c = ivec2(cell);
+    int base = c.y * grid + c.x;
+    if (f.x + f.y <= 1.0) {
+        frames = ivec3(base, base + 1, base + grid);
+        weights = vec3(1.0 - f.x - f.y, f.x, f.y);
+    } else {
+        frames = ivec3(base + grid + 1, base + grid, base + 1);
+        weights = vec3(f.x + f.y - 1.0, 1.0 - f.x, 1.0 - f.y);
+    }
+}
+
+// Frame with the largest weight (used where only one frame can be read,
+// e.g. depth-only passes).
+int impostorDominantFrame(ivec3 frames, vec3 weights) {
+    if (weights.y > weights.x && weights.y >= weights.z) return frames.y;
+    if (weights.z > weights.x) return frames.z;
+    return frames.x;
+}
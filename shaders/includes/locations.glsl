@@ -9,6 +9,7 @@
 #define ATTR_BRUSH_INDEX 4
 #define ATTR_HSV 6
 #define ATTR_INSTANCE 5
+#define ATTR_MORPH 7
 
 // Fragment outputs (color attachments)
 // Keep these matching render pass attachment locations (0 = primary color)
@@ -0,0 +1,8 @@
+// Tangent-space normal map decoding
+
+// Normal arrays may be BC5, which keeps only x and y: rebuild z from the unit
+// length instead of reading the blue channel (RGBA8 arrays decode the same).
+vec3 unpackNormalMap(in vec4 enc) {
+    vec2 xy = enc.xy * 2.0 - 1.0;
+    return vec3(xy, sqrt(max(0.0, 1.0 - dot(xy, xy))));
+}
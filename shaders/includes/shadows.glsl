@@ -4,6 +4,7 @@
 // bounds check so fragments near any cascade boundary always get a
 // valid shadow value instead of falling through to return 0.0.
 #include "evsm.glsl"
+#include "virtual_shadows.glsl"
 
 bool insideShadowMap(vec3 p, float margin) {
     return p.x >= margin && p.x <= 1.0 - margin &&
@@ -32,6 +33,9 @@ float cascadeBlendZ(float z, float margin) {
 float ShadowCalculation(vec4 fragPosLightSpace, vec3 worldPos, float bias) {
     const float BLEND_MARGIN = 0.04;
 
+    // Virtual shadow map mode: the cascades are not rendered.
+    if (vsmEnabled()) return VirtualShadowCalculation(worldPos, bias);
+
     vec3 proj0 = fragPosLightSpace.xyz / fragPosLightSpace.w;
     proj0.xy = proj0.xy * 0.5 + 0.5;
 
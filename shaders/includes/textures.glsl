@@ -1,12 +1,13 @@
-// Texture bindings for fragment shaders
-// texture arrays: binding 1 = albedo array, 2 = normal array, 3 = height array, 4 = shadow map (cascade 0)
-// Bind into main descriptor set (set = 0)
-layout(set = 0, binding = 1) uniform sampler2DArray albedoArray;
-layout(set = 0, binding = 2) uniform sampler2DArray normalArray;
-layout(set = 0, binding = 3) uniform sampler2DArray heightArray;
-layout(set = 0, binding = 4) uniform sampler2D shadowMap;
-layout(set = 0, binding = 8) uniform sampler2D shadowMap1;  // cascade 1 (4x ortho0)
-layout(set = 0, binding = 9) uniform sampler2D shadowMap2;  // cascade 2 (16x ortho0)
-layout(set = 0, binding = 11) uniform samplerCube environmentMap;
-layout(set = 0, binding = 12) uniform sampler2DArray roughnessArray;
-layout(set = 0, binding = 13) uniform sampler2DArray aoArray;
\ No newline at end of file
+// Texture bindings for fragment shaders. Everything lives in the bindless
+// heap; the slots are per-frame values in the frame UBO (ubo.glsl).
+#include "bindless.glsl"
+
+#define albedoArray    bindlessTextureArrays[ubo.textureSlots.x]
+#define normalArray    bindlessTextureArrays[ubo.textureSlots.y]
+#define heightArray    bindlessTextureArrays[ubo.textureSlots.z]
+#define roughnessArray bindlessTextureArrays[ubo.textureSlots.w]
+#define aoArray        bindlessTextureArrays[ubo.textureSlots1.x]
+#define shadowMap      bindlessTextures[ubo.shadowSlots.x]  // cascade 0
+#define shadowMap1     bindlessTextures[ubo.shadowSlots.y]  // cascade 1 (4x ortho0)
+#define shadowMap2     bindlessTextures[ubo.shadowSlots.z]  // cascade 2 (16x ortho0)
+#define environmentMap bindlessCubes[ubo.textureSlots1.y]
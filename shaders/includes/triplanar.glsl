@@ -45,7 +45,7 @@ vec3 reorientNormal(in vec3 blendedWorld, in vec3 geomN) {
 
 // Helper: compute normal from a single projection with given tangent basis
 vec3 computeProjectionNormal(vec2 uv, int brushIndex, vec3 surfaceN) {
-    vec3 nSample = texture(normalArray, vec3(uv, float(brushIndex))).rgb * 2.0 - 1.0;
+    vec3 nSample = unpackNormalMap(texture(normalArray, vec3(uv, float(brushIndex))));
     nSample = normalize(applyNormalConvention(nSample, materials[brushIndex].normalParams));
     vec3 axis = surfaceN;
     vec3 up = abs(axis.y) < 0.999 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
@@ -17,6 +17,13 @@ layout(set = 0, binding = 0) uniform SolidParamsUBO {
     mat4 invViewProjection; // inverse of viewProjection (camera-constant)
     vec4 brushParams;       // x=brushTextureIndex, y=brushMode (0=overlay, 2=PAINT)
     vec4 brushHSV;          // x=H(0..360), y=S(0..1), z=V(0..1), w=unused
+    vec4 lodParams;         // x=frontier cell size (0 = no geomorph), y=lodBias, z=geomorph band width (in bands), w=maxLevel
+    uvec4 textureSlots;     // bindless heap slots: albedo, normal, height, roughness arrays
+    uvec4 textureSlots1;    // x=AO array, y=environment cubemap, z=virtual shadow atlas
+    uvec4 shadowSlots;      // xyz=shadow cascades 0-2
+    uvec4 sceneSlots;       // x=brush depth, y=brush back-face depth, z=scene color, w=scene depth
+    uvec4 sceneSlots1;      // x=water back-face depth, y=scene sky cubemap
+    uvec4 bufferSlots;      // x=materials, y=water params, z=virtual shadow table
 } ubo;
 
 // Packed material data uploaded once to GPU. Matches the CPU-side MaterialGPU (6 vec4s).
@@ -31,9 +38,12 @@ struct MaterialGPU {
     vec4 roughnessAOParams; // x = roughnessFactor, y = aoFactor, z = useAO (1.0/0.0)
 };
 
-layout(std430, set = 0, binding = 5) readonly buffer Materials {
+#include "bindless.glsl"
+
+layout(std430, set = BINDLESS_SET, binding = 1) readonly buffer Materials {
     MaterialGPU materials[];
-};
+} bindlessMaterials[];
+#define materials bindlessMaterials[ubo.bufferSlots.x].materials
 
 // Per-draw model matrices for indirect rendering
 // Models SSBO removed — shaders use identity models
@@ -70,6 +80,7 @@ struct WaterParamsGPU {
     vec4 causticExtraParams; // x = lineScale, y = lineMix, z = causticType (0=perlin,1=voronoi), w = causticVelocity
 };
 
-layout(std430, set = 0, binding = 7) readonly buffer WaterParamsBlock {
+layout(std430, set = BINDLESS_SET, binding = 1) readonly buffer WaterParamsBlock {
     WaterParamsGPU waterParams[];
-};
\ No newline at end of file
+} bindlessWaterParams[];
+#define waterParams bindlessWaterParams[ubo.bufferSlots.y].waterParams
\ No newline at end of file
@@ -0,0 +1,34 @@
+// Shared by the vegetation and impostor pipelines (VegetationRenderer,
+// ImpostorCapture). The push block mirrors WindPushConstants; the
+// *Texture / *Buffer members are bindless heap slots (bindless.glsl).
+#include "bindless.glsl"
+
+layout(push_constant) uniform PushConstants {
+    float billboardScale;
+    float windEnabled;
+    float windTime;
+    float impostorDistance;
+    uint  windParamsBuffer;
+    uint  albedoTexture;
+    uint  normalTexture;
+    uint  opacityTexture;
+    uint  impostorTexture;        // impostor color array
+    uint  impostorNormalTexture;  // impostor normal array
+    uint  impostorDepthTexture;   // impostor capture depth array
+    uint  captureInvVPBuffer;     // per-layer inverse capture view-projection
+};
+
+layout(std430, set = BINDLESS_SET, binding = 1) readonly buffer WindParamsBlock {
+    vec4 windDirAndStrength;
+    vec4 windNoise;
+    vec4 windShape;
+    vec4 windTurbulence;
+    vec4 densityParams;
+    vec4 cameraPosAndFalloff;
+    vec4 impostorParams;
+} bindlessWindParams[];
+#define windParams bindlessWindParams[windParamsBuffer]
+
+layout(std430, set = BINDLESS_SET, binding = 1) readonly buffer CaptureInvVP {
+    mat4 invVP[];
+} bindlessCaptureInvVP[];
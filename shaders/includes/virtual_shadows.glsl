@@ -0,0 +1,83 @@
+// Virtual (clipmapped) shadow map addressing — mirrors utils/VirtualShadowMap.
+// Light space is cut into square pages; level L pages are pageWorldSize * 2^L
+// wide and each level keeps a pagesPerLevel² window around the camera. The
+// table stores physical page + 1 per window slot (0 = not resident), indexed
+// toroidally: level * N² + (page.y mod N) * N + (page.x mod N).
+//
+// Scene shaders read the table and the atlas from the bindless heap, at the
+// frame UBO's bufferSlots.z / textureSlots1.z. Includers may instead define
+// VSM_SET / VSM_TABLE_BINDING to place the table in their own set, and
+// VSM_NO_ATLAS to skip the atlas sampler (mark pass).
+
+const int VSM_MAX_LEVELS = 8;
+
+struct VirtualShadowHeader {
+    mat4 lightView;
+    vec4 params;                    // x = levelCount, y = pagesPerLevel, z = pageWorldSize, w = enabled
+    vec4 depth;                     // x = near, y = far
+    ivec4 origin[VSM_MAX_LEVELS];   // xy = window origin in pages
+};
+
+#ifdef VSM_SET
+#ifndef VSM_TABLE_BINDING
+#define VSM_TABLE_BINDING 0
+#endif
+layout(std430, set = VSM_SET, binding = VSM_TABLE_BINDING) readonly buffer VirtualShadowTable {
+    VirtualShadowHeader header;
+    uint pages[];
+} vsmTable;
+#else
+#include "bindless.glsl"
+layout(std430, set = BINDLESS_SET, binding = 1) readonly buffer VirtualShadowTable {
+    VirtualShadowHeader header;
+    uint pages[];
+} bindlessVsmTables[];
+#define vsmTable bindlessVsmTables[ubo.bufferSlots.z]
+#endif
+
+#ifndef VSM_NO_ATLAS
+#define virtualShadowAtlas bindlessTextureArrays[ubo.textureSlots1.z]
+#endif
+
+bool vsmEnabled() {
+    return vsmTable.header.params.w > 0.5;
+}
+
+float vsmPageSize(int level) {
+    return vsmTable.header.params.z * float(1 << level);
+}
+
+// Light-space page of `lsXY` at `level`; false when outside the level window.
+bool vsmPageAt(int level, vec2 lsXY, out ivec2 page) {
+    int n = int(vsmTable.header.params.y + 0.5);
+    page = ivec2(floor(lsXY / vsmPageSize(level)));
+    ivec2 rel = page - vsmTable.header.origin[level].xy;
+    return all(greaterThanEqual(rel, ivec2(0))) && all(lessThan(rel, ivec2(n)));
+}
+
+uint vsmSlot(int level, ivec2 page) {
+    int n = int(vsmTable.header.params.y + 0.5);
+    ivec2 t = ((page % n) + n) % n;
+    return uint(level * n * n + t.y * n + t.x);
+}
+
+#ifndef VSM_NO_ATLAS
+// Shadow factor from the finest resident page covering worldPos; 0 (lit)
+// when no level has it resident yet.
+float VirtualShadowCalculation(vec3 worldPos, float bias) {
+    vec3 ls = (vsmTable.header.lightView * vec4(worldPos, 1.0)).xyz;
+    float range = max(vsmTable.header.depth.y - vsmTable.header.depth.x, 1e-6);
+    float depth = (-ls.z - vsmTable.header.depth.x) / range;
+
+    int levels = int(vsmTable.header.params.x + 0.5);
+    for (int l = 0; l < levels; ++l) {
+        ivec2 page;
+        if (!vsmPageAt(l, ls.xy, page)) continue;
+        uint entry = vsmTable.pages[vsmSlot(l, page)];
+        if (entry == 0u) continue;
+        vec2 uv = ls.xy / vsmPageSize(l) - vec2(page);
+        return ShadowEVSMLayer(virtualShadowAtlas, vec3(uv, float(entry - 1u)), depth, bias);
+    }
+    return 0.0;
+}
+#endif
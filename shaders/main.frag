@@ -1,5 +1,6 @@
 
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 #include "includes/locations.glsl"
 
 layout(location = VARY_COLOR) in vec3 fragColor;
@@ -18,8 +19,8 @@ layout(location = VARY_SHARPNORMAL) in vec3 fragSharpNormal; // face normal comp
 #include "includes/textures.glsl"
 
 #ifndef BRUSH_PASS
-layout(set = 1, binding = 0) uniform sampler2D brushDepthTex;
-layout(set = 1, binding = 1) uniform sampler2D brushBackFaceDepthTex;
+#define brushDepthTex         bindlessTextures[ubo.sceneSlots.x]
+#define brushBackFaceDepthTex bindlessTextures[ubo.sceneSlots.y]
 #endif
 
 layout(location = FRAG_OUT_COLOR) out vec4 outColor;
@@ -27,6 +28,7 @@ layout(location = FRAG_OUT_COLOR) out vec4 outColor;
 #include "includes/common.glsl"
 
 #include "includes/tbn.glsl"
+#include "includes/normal_encoding.glsl"
 #include "includes/triplanar.glsl"
 
 #ifndef BRUSH_PASS
@@ -153,9 +155,9 @@ void main() {
     // Compute normal mapping if enabled (per-material or global toggle)
     if (!usedTriplanar && ((materials[texIndices.x].mappingParams.x * w.x + materials[texIndices.y].mappingParams.x * w.y + materials[texIndices.z].mappingParams.x * w.z) > 0.5 || ubo.materialFlags.w > 0.5)) {
         // Sample normal map per-layer and blend in tangent space
-        vec3 n0 = texture(normalArray, vec3(uv, float(texIndices.x))).rgb * 2.0 - 1.0;
-        vec3 n1 = texture(normalArray, vec3(uv, float(texIndices.y))).rgb * 2.0 - 1.0;
-        vec3 n2 = texture(normalArray, vec3(uv, float(texIndices.z))).rgb * 2.0 - 1.0;
+        vec3 n0 = unpackNormalMap(texture(normalArray, vec3(uv, float(texIndices.x))));
+        vec3 n1 = unpackNormalMap(texture(normalArray, vec3(uv, float(texIndices.y))));
+        vec3 n2 = unpackNormalMap(texture(normalArray, vec3(uv, float(texIndices.z))));
         vec3 nmap = normalize(n0 * w.x + n1 * w.y + n2 * w.z);
         // Build TBN matrix from geometry for UV-space normal mapping
         vec3 T = normalize(dFdx(fragPosWorld));
@@ -306,9 +308,9 @@ void main() {
         return;
     }
     if (debugMode == 6) {
-        vec3 rn0 = texture(normalArray, vec3(uv, float(texIndices.x))).rgb;
-        vec3 rn1 = texture(normalArray, vec3(uv, float(texIndices.y))).rgb;
-        vec3 rn2 = texture(normalArray, vec3(uv, float(texIndices.z))).rgb;
+        vec3 rn0 = unpackNormalMap(texture(normalArray, vec3(uv, float(texIndices.x)))) * 0.5 + 0.5;
+        vec3 rn1 = unpackNormalMap(texture(normalArray, vec3(uv, float(texIndices.y)))) * 0.5 + 0.5;
+        vec3 rn2 = unpackNormalMap(texture(normalArray, vec3(uv, float(texIndices.z)))) * 0.5 + 0.5;
         vec3 rawNormalTex = rn0 * w.x + rn1 * w.y + rn2 * w.z;
         outColor = vec4(rawNormalTex, 1.0);
         return;
@@ -1,8 +1,10 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 #extension GL_ARB_shader_draw_parameters : require
 
 #include "includes/ubo.glsl"
 #include "includes/locations.glsl"
+#include "includes/geomorph.glsl"
 
 layout(location = ATTR_POS) in vec3 inPos;
 layout(location = ATTR_COLOR) in vec3 inColor;
@@ -10,6 +12,7 @@ layout(location = ATTR_UV) in vec2 inUV;
 layout(location = ATTR_NORMAL) in vec3 inNormal;
 layout(location = ATTR_BRUSH_INDEX) in int inBrushIndex;
 layout(location = ATTR_HSV) in vec3 inHSV;
+layout(location = ATTR_MORPH) in uint inMorph;
 
 layout(location = VARY_COLOR) out vec3 fragColor;
 layout(location = VARY_UV) out vec2 fragUV;
@@ -35,7 +38,8 @@ void main() {
     fragBrushIndex = inBrushIndex;
     
     // compute world-space position and pass to fragment
-    vec4 worldPos = model * vec4(inPos, 1.0);
+    // (blended toward the coarser LoD level near the band switch)
+    vec4 worldPos = model * vec4(applyGeomorph(inPos, inMorph), 1.0);
     fragPosWorld = worldPos.xyz;
     fragLocalPos = worldPos.xyz;       // Use world-space position as local basis for displacement
     
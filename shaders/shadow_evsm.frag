@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // Shadow EVSM2 pass: outputs EVSM moments (exp(c*d), exp(2*c*d))
 // for positive-only exponential variance shadow maps with light-bleeding reduction.
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // Fullscreen triangle that reconstructs world-space position from clip space.
 // The sky fragment shader only needs the view direction, which we reconstruct
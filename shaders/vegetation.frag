@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -11,29 +12,10 @@ layout(location = FRAG_OUT_COLOR) out vec4 outColor;
 
 #include "includes/ubo.glsl"
 
-layout(set = 0, binding = 4) uniform sampler2D shadowMap;
-layout(set = 0, binding = 8) uniform sampler2D shadowMap1;
-layout(set = 0, binding = 9) uniform sampler2D shadowMap2;
-
-layout(set = 1, binding = 0) uniform sampler2DArray albedoArray;
-layout(set = 1, binding = 1) uniform sampler2DArray normalArray;
-layout(set = 1, binding = 2) uniform sampler2DArray opacityArray;
-
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#include "includes/textures.glsl"
+#include "includes/normal_encoding.glsl"
+
+#include "includes/vegetation_params.glsl"
 
 vec3 fragPosWorld; // set in main() — required by shadows.glsl cascades 1 & 2
 
@@ -45,12 +27,12 @@ void main() {
     fragPosWorld = inWorldPos; // must be set before any ShadowCalculation call
 
     // Per-pixel leaf samples.
-    vec4  leafAlbedo  = texture(albedoArray,  coord);
-    float opacity     = texture(opacityArray, coord).r;
-    vec3  leafNormEnc = texture(normalArray,  coord).rgb;
+    vec4  leafAlbedo  = texture(bindlessTextureArrays[albedoTexture],  coord);
+    float opacity     = texture(bindlessTextureArrays[opacityTexture], coord).r;
+    vec4  leafNormEnc = texture(bindlessTextureArrays[normalTexture],  coord);
 
     // Decode tangent-space normal from [0,1] to [-1,1].
-    vec3 leafNorm = normalize(leafNormEnc * 2.0 - 1.0);
+    vec3 leafNorm = unpackNormalMap(leafNormEnc);
 
     // Normal confidence: Z in tangent space — 1 = facing viewer, 0 = grazing.
     float leafNConf = clamp(leafNorm.z, 0.0, 1.0);
@@ -79,10 +61,10 @@ void main() {
 
     // Background: nearest-leaf-filled by CPU compositor; high-mip gives spatial blend.
     const float kAvgMip = 5.0;
-    vec3 bgAlbedo  = textureLod(albedoArray, coord, kAvgMip).rgb;
-    vec3 bgNormEnc = textureLod(normalArray, coord, kAvgMip).rgb;
+    vec3 bgAlbedo  = textureLod(bindlessTextureArrays[albedoTexture], coord, kAvgMip).rgb;
+    vec4 bgNormEnc = textureLod(bindlessTextureArrays[normalTexture], coord, kAvgMip);
 
-    vec3  bgNorm  = normalize(bgNormEnc * 2.0 - 1.0);
+    vec3  bgNorm  = unpackNormalMap(bgNormEnc);
     float bgNConf = clamp(bgNorm.z,   0.0, 1.0);
 
     // Compositing weight: opacity sigmoid + normal confidence.
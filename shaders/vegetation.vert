@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // Vertex-shader billboard expansion — replaces the old geometry-shader approach.
 // 24 pre-computed corner vertices (6 planes × 4 corners) are drawn as a
@@ -25,21 +26,7 @@ layout(set = 0, binding = 0) uniform SolidParamsUBO {
     vec4 viewPos;
 } ubo;
 
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#include "includes/vegetation_params.glsl"
 
 #include "includes/perlin2d.glsl"
 #include "includes/vegetation_common.glsl"
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 #include "includes/ubo.glsl"
@@ -9,34 +10,20 @@ layout(location = VARY_POSWORLD) in vec3 inWorldPos;
 layout(location = VARY_PLANE_NORMAL) flat in vec3 inPlaneNormal;
 layout(location = VARY_POSLIGHT) flat in vec3 inTangentWS;
 
-layout(set = 1, binding = 1) uniform sampler2DArray normalArray;
-layout(set = 1, binding = 2) uniform sampler2DArray opacityArray;
-
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#include "includes/bindless.glsl"
+#include "includes/normal_encoding.glsl"
+
+#include "includes/vegetation_params.glsl"
 
 void main() {
     vec3 coord = vec3(inTexCoord.xy, inTexCoord.z);
 
-    float opacity     = texture(opacityArray, coord).r;
-    vec3  leafNormEnc = texture(normalArray,  coord).rgb;
-    vec3  bgNormEnc   = textureLod(normalArray, coord, 5.0).rgb;
+    float opacity     = texture(bindlessTextureArrays[opacityTexture], coord).r;
+    vec4  leafNormEnc = texture(bindlessTextureArrays[normalTexture],  coord);
+    vec4  bgNormEnc   = textureLod(bindlessTextureArrays[normalTexture], coord, 5.0);
 
-    vec3 leafNorm = normalize(leafNormEnc * 2.0 - 1.0);
-    vec3 bgNorm   = normalize(bgNormEnc   * 2.0 - 1.0);
+    vec3 leafNorm = unpackNormalMap(leafNormEnc);
+    vec3 bgNorm   = unpackNormalMap(bgNormEnc);
 
     float leafNConf = clamp(leafNorm.z, 0.0, 1.0);
     float bgNConf   = clamp(bgNorm.z,   0.0, 1.0);
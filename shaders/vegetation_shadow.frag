@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // Vegetation EVSM2 shadow fragment shader.
 // Writes EVSM moments from the vertex world position.
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // Vegetation EVSM shadow vertex shader.
 // Expands 24-corner billboard mesh into world space.
@@ -13,21 +14,7 @@ layout(location = ATTR_INSTANCE) in vec4 instanceData;
 
 layout(location = VARY_POSWORLD) out vec3 outWorldPos;
 
-layout(set = 2, binding = 0) uniform WindParamsUBO {
-    vec4 windDirAndStrength;
-    vec4 windNoise;
-    vec4 windShape;
-    vec4 windTurbulence;
-    vec4 densityParams;
-    vec4 cameraPosAndFalloff;
-} windParams;
-
-layout(push_constant) uniform PushConstants {
-    float billboardScale;
-    float windEnabled;
-    float windTime;
-    float impostorDistance;
-};
+#include "includes/vegetation_params.glsl"
 
 layout(set = 0, binding = 0) uniform SolidParamsUBO {
     mat4 viewProjection;
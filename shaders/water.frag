@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
@@ -25,11 +26,11 @@ layout(location = FRAG_OUT_COLOR) out vec4 outColor;
 #include "includes/shadows.glsl"
 
 
-// Scene color and depth textures for refraction and edge foam (set 2)
-layout(set = 2, binding = 0) uniform sampler2D sceneColorTex;
-layout(set = 2, binding = 1) uniform sampler2D sceneDepthTex;
-layout(set = 2, binding = 3) uniform sampler2D waterBackDepthTex;  // back-face depth for volume thickness
-layout(set = 2, binding = 4) uniform samplerCube sceneSkyCube;    // solid 360 cubemap (used directly)
+// Scene color and depth textures for refraction and edge foam (bindless heap)
+#define sceneColorTex     bindlessTextures[ubo.sceneSlots.z]
+#define sceneDepthTex     bindlessTextures[ubo.sceneSlots.w]
+#define waterBackDepthTex bindlessTextures[ubo.sceneSlots1.x]  // back-face depth for volume thickness
+#define sceneSkyCube      bindlessCubes[ubo.sceneSlots1.y]     // solid 360 cubemap (used directly)
 // `scenePositionTex` removed: world-position is reconstructed from depth when needed
 
 // Near/far planes for linearizing depth – read from UBO passParams (z = near, w = far)
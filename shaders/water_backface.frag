@@ -1,11 +1,14 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "includes/locations.glsl"
 
 // Back-face depth pass: writes water back-face depth, clipping fragments
 // that are behind the scene by sampling the scene depth texture.
 
-layout(set = 2, binding = 1) uniform sampler2D sceneDepthTex;
+#include "includes/ubo.glsl"
+
+#define sceneDepthTex bindlessTextures[ubo.sceneSlots.w]
 
 layout(location = VARY_LOCALPOS) in vec3 fragPos;
 layout(location = VARY_NORMAL) in vec3 fragNormal;
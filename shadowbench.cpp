@@ -0,0 +1,204 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "utils/VirtualShadowMap.hpp"
+#include "utils/ShadowParams.hpp"
+
+// Virtual shadow map memory / quality benchmark (no GPU).
+//
+//   shadowbench [--frames N] [--budget P] [--pages P] [--width W] [--height H]
+//
+// Flies a camera over a procedural heightfield and replays what the mark pass
+// would request: every screen sample is ray-cast against the terrain and
+// requests the finest clipmap level containing the hit plus the next coarser
+// one. Requests reach VirtualShadowMap three frames late, like the readback
+// in VirtualShadowRenderer. Every 60 frames a crater edit dirties a region.
+// Reports page residency, per-frame page renders and the light-space texel
+// density reached on screen compared with the EVSM cascades (ShadowParams
+// fitted to the same camera).
+
+namespace {
+
+constexpr uint32_t REQUEST_LATENCY = 3;   // MAX_FRAMES_IN_FLIGHT
+
+float terrainHeight(float x, float z) {
+    return 40.0f * std::sin(x * 0.011f) * std::cos(z * 0.013f)
+         + 12.0f * std::sin(x * 0.047f + z * 0.031f)
+         + 3.0f * std::cos(x * 0.17f - z * 0.23f);
+}
+
+// March the view ray until it drops below the terrain; false for sky.
+bool castRay(const glm::vec3& origin, const glm::vec3& dir, float maxDist, glm::vec3& hit) {
+    float t = 0.5f;
+    while (t < maxDist) {
+        glm::vec3 p = origin + dir * t;
+        float h = terrainHeight(p.x, p.z);
+        if (p.y <= h) { hit = p; return true; }
+        t += std::max(0.25f, (p.y - h) * 0.5f) + t * 0.002f;
+    }
+    return false;
+}
+
+struct Options {
+    uint32_t frames = 1200;
+    uint32_t budget = 16;
+    uint32_t width = 320;
+    uint32_t height = 180;
+    uint32_t physicalPages = 256;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() { return static_cast<uint32_t>(std::stoul(argv[++i])); };
+        if (arg == "--frames" && i + 1 < argc) { opt.frames = next(); continue; }
+        if (arg == "--budget" && i + 1 < argc) { opt.budget = next(); continue; }
+        if (arg == "--pages" && i + 1 < argc) { opt.physicalPages = next(); continue; }
+        if (arg == "--width" && i + 1 < argc) { opt.width = next(); continue; }
+        if (arg == "--height" && i + 1 < argc) { opt.height = next(); continue; }
+        std::cerr << "usage: shadowbench [--frames N] [--budget P] [--pages P] [--width W] [--height H]\n";
+        return 1;
+    }
+
+    VirtualShadowMap::Config config;
+    config.physicalPages = std::max(1u, opt.physicalPages);
+    VirtualShadowMap vsm(config);
+    const uint32_t n = config.pagesPerLevel;
+    const size_t entries = vsm.pageTableEntries();
+
+    const glm::vec3 lightDir = glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f));
+    const float farPlane = 2048.0f;
+    const float fovY = glm::radians(60.0f);
+    const float nearPlane = 0.1f;
+    const float aspect = static_cast<float>(opt.width) / static_cast<float>(opt.height);
+    Light light(lightDir);
+    ShadowParams shadowParams;
+    shadowParams.cacheCascades = false;
+
+    struct Pending { VirtualShadowMap::RequestFrame frame; std::vector<uint32_t> flags; };
+    std::vector<Pending> inFlight(REQUEST_LATENCY);
+    std::vector<VirtualShadowMap::PageRender> batch;
+
+    uint64_t renderedTotal = 0, evictedTotal = 0, droppedTotal = 0;
+    uint32_t peakResident = 0, peakRequested = 0, maxQueue = 0;
+    double residentSum = 0.0, densitySum = 0.0, missSum = 0.0;
+    double evsmDensitySum[SHADOW_CASCADE_COUNT] = {};
+    uint32_t measured = 0;
+
+    for (uint32_t f = 0; f < opt.frames; ++f) {
+        float t = static_cast<float>(f) / 60.0f;
+        glm::vec3 camPos(t * 18.0f, 0.0f, 40.0f * std::sin(t * 0.3f));
+        camPos.y = terrainHeight(camPos.x, camPos.z) + 25.0f;
+        glm::vec3 forward = glm::normalize(glm::vec3(1.0f, -0.25f, 0.35f * std::cos(t * 0.3f)));
+        glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+        glm::vec3 up = glm::cross(right, forward);
+
+        glm::mat4 viewProj = glm::perspective(fovY, aspect, nearPlane, farPlane)
+                           * glm::lookAt(camPos, camPos + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+        shadowParams.update(camPos, light, viewProj, nearPlane, farPlane);
+
+        if (f > 0 && f % 60 == 0) {
+            glm::vec3 c = camPos + forward * 80.0f;
+            vsm.markDirtyRegion(c - glm::vec3(16.0f, 64.0f, 16.0f), c + glm::vec3(16.0f, 64.0f, 16.0f));
+        }
+
+        // Same slot as the mark pass of REQUEST_LATENCY frames ago
+        Pending& slot = inFlight[f % REQUEST_LATENCY];
+        if (!slot.flags.empty()) vsm.submitRequests(slot.frame, slot.flags.data(), slot.flags.size());
+
+        vsm.update(camPos, lightDir, farPlane);
+        batch.clear();
+        vsm.takeRenderBatch(opt.budget, batch);
+
+        // Mark pass against the table as published this frame
+        slot.frame = vsm.requestFrame();
+        slot.flags.assign(entries, 0u);
+        const glm::mat4& lightView = vsm.lightView();
+        float tanHalf = std::tan(fovY * 0.5f);
+        uint32_t hits = 0, finestSum = 0;
+        for (uint32_t y = 0; y < opt.height; ++y) {
+            for (uint32_t x = 0; x < opt.width; ++x) {
+                float sx = ((x + 0.5f) / opt.width * 2.0f - 1.0f) * tanHalf * aspect;
+                float sy = (1.0f - (y + 0.5f) / opt.height * 2.0f) * tanHalf;
+                glm::vec3 dir = glm::normalize(forward + right * sx + up * sy);
+                glm::vec3 hit;
+                if (!castRay(camPos, dir, farPlane, hit)) continue;
+                glm::vec2 ls = glm::vec2(lightView * glm::vec4(hit, 1.0f));
+                for (uint32_t l = 0; l < config.levelCount; ++l) {
+                    float s = vsm.levelPageSize(l);
+                    int32_t px = static_cast<int32_t>(std::floor(ls.x / s));
+                    int32_t py = static_cast<int32_t>(std::floor(ls.y / s));
+                    int32_t rx = px - slot.frame.origin[l][0];
+                    int32_t ry = py - slot.frame.origin[l][1];
+                    if (rx < 0 || ry < 0 || rx >= static_cast<int32_t>(n) || ry >= static_cast<int32_t>(n)) continue;
+                    auto slotOf = [&](uint32_t level, int32_t qx, int32_t qy) {
+                        uint32_t tx = static_cast<uint32_t>(((qx % static_cast<int32_t>(n)) + n) % n);
+                        uint32_t ty = static_cast<uint32_t>(((qy % static_cast<int32_t>(n)) + n) % n);
+                        return static_cast<size_t>(level) * n * n + ty * n + tx;
+                    };
+                    slot.flags[slotOf(l, px, py)] = 1u;
+                    if (l + 1 < config.levelCount) {
+                        float s1 = vsm.levelPageSize(l + 1);
+                        slot.flags[slotOf(l + 1, static_cast<int32_t>(std::floor(ls.x / s1)),
+                                          static_cast<int32_t>(std::floor(ls.y / s1)))] = 1u;
+                    }
+                    ++hits;
+                    finestSum += l;
+                    break;
+                }
+            }
+        }
+
+        const VirtualShadowMap::Stats& st = vsm.stats();
+        renderedTotal += st.renderedPages;
+        evictedTotal += st.evictions;
+        droppedTotal += st.droppedRequests;
+        peakResident = std::max(peakResident, st.residentPages);
+        peakRequested = std::max(peakRequested, st.requestedPages);
+        maxQueue = std::max(maxQueue, st.queuedPages);
+        if (f >= 60) { // skip warm-up
+            residentSum += st.residentPages;
+            missSum += st.queuedPages;
+            if (hits > 0) densitySum += vsm.levelTexelDensity(0) / std::pow(2.0, static_cast<double>(finestSum) / hits);
+            // Ortho x scale is 2 / width, so texels per unit = size * m00 / 2
+            for (int i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+                evsmDensitySum[i] += shadowParams.shadowMapSizes[i] * shadowParams.lightSpaceMatrix[i][0][0] * 0.5;
+            ++measured;
+        }
+    }
+
+    const double mb = 1024.0 * 1024.0;
+    // EVSM: per cascade RG32F moments + D32 depth, plus one shared RG32F blur target
+    size_t evsmBytes = 0;
+    for (int i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+        evsmBytes += static_cast<size_t>(shadowParams.shadowMapSizes[i]) * shadowParams.shadowMapSizes[i] * (8 + 4);
+    evsmBytes += static_cast<size_t>(shadowParams.shadowMapSizes[0]) * shadowParams.shadowMapSizes[0] * 8;
+    measured = std::max(1u, measured);
+
+    std::printf("frames %u  screen %ux%u  budget %u pages/frame\n", opt.frames, opt.width, opt.height, opt.budget);
+    std::printf("levels %u  window %ux%u pages  page %u texels / %.1f units at level 0\n",
+                config.levelCount, n, n, config.pageTexels, config.pageWorldSize);
+    std::printf("\nmemory\n");
+    std::printf("  virtual atlas   %8.1f MB  (%u physical pages)\n", vsm.atlasBytes() / mb, config.physicalPages);
+    std::printf("  EVSM cascades   %8.1f MB  (%u/%u/%u)\n", evsmBytes / mb, shadowParams.shadowMapSizes[0],
+                shadowParams.shadowMapSizes[1], shadowParams.shadowMapSizes[2]);
+    std::printf("\nresidency\n");
+    std::printf("  resident avg %.1f  peak %u   requested peak %u\n", residentSum / measured, peakResident, peakRequested);
+    std::printf("  pages rendered %llu (%.2f/frame)  evicted %llu  dropped requests %llu\n",
+                static_cast<unsigned long long>(renderedTotal), static_cast<double>(renderedTotal) / opt.frames,
+                static_cast<unsigned long long>(evictedTotal), static_cast<unsigned long long>(droppedTotal));
+    std::printf("  queued (not yet drawn) avg %.1f  peak %u\n", missSum / measured, maxQueue);
+    std::printf("\nquality (light-space texels per world unit)\n");
+    std::printf("  virtual, level 0          %8.2f\n", vsm.levelTexelDensity(0));
+    std::printf("  virtual, screen average   %8.2f\n", densitySum / measured);
+    for (int i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+        std::printf("  EVSM cascade %d            %8.2f\n", i, evsmDensitySum[i] / measured);
+    return 0;
+}
@@ -0,0 +1,268 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "utils/LocalScene.hpp"
+#include "utils/MainSceneLoader.hpp"
+#include "space/MeshSimplifier.hpp"
+#include "space/MeshOptimizer.hpp"
+#include "vulkan/renderer/MeshClusters.hpp"
+#include "space/ThreadPool.hpp"
+
+// LoD ladder simplification benchmark: vertex clustering vs quadric collapse,
+// plus the GPU reorder every published chunk gets (optimizeMeshForGpu).
+//
+//   simplifybench [--chunks N] [--lod L] [--per-chunk]
+//
+// Loads the MainSceneLoader terrain (no GPU, like the server), tessellates
+// opaque chunks of ladder level L and coarsens each one step with both
+// simplifiers on a worker pool:
+//   cluster     decimateVertexCluster at twice the mesh's vertex spacing
+//   quadric     simplifyQuadric down to the clustering's triangle count
+//   quadric@err simplifyQuadric bounded by the clustering's Hausdorff error
+// Both lock the same border strip (one vertex spacing). Reports time per
+// chunk, triangles kept and the symmetric Hausdorff distance to the input,
+// sampled at the vertices of both meshes. The input chunk is then run through
+// optimizeMeshForGpu and its ACMR / ATVR (simulated FIFO post-transform cache)
+// is reported before and after; --per-chunk lists them for every chunk.
+
+namespace {
+
+glm::vec3 closestOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    const glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    const float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+    const glm::vec3 bp = p - b;
+    const float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+    const glm::vec3 cp = p - c;
+    const float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    const float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+// One-sided distance: largest distance from a vertex of `from` (up to
+// `maxSamples`, evenly strided) to the surface of `to`.
+float directedHausdorff(const Geometry& from, const Geometry& to, size_t maxSamples = 4096) {
+    if (from.vertices.empty() || to.indices.size() < 3) return 0.0f;
+    const size_t stride = std::max<size_t>(1, from.vertices.size() / maxSamples);
+    float worst = 0.0f;
+    for (size_t vi = 0; vi < from.vertices.size(); vi += stride) {
+        const glm::vec3& p = from.vertices[vi].position;
+        float best = 1e30f;
+        for (size_t ti = 0; ti + 2 < to.indices.size(); ti += 3) {
+            const glm::vec3 q = closestOnTriangle(p, to.vertices[to.indices[ti]].position,
+                                                  to.vertices[to.indices[ti + 1]].position,
+                                                  to.vertices[to.indices[ti + 2]].position);
+            const glm::vec3 d = q - p;
+            best = std::min(best, glm::dot(d, d));
+        }
+        worst = std::max(worst, best);
+    }
+    return std::sqrt(worst);
+}
+
+float hausdorff(const Geometry& a, const Geometry& b) {
+    return std::max(directedHausdorff(a, b), directedHausdorff(b, a));
+}
+
+struct Chunk {
+    Geometry geom;
+    BoundingCube cube;
+};
+
+struct Sample {
+    double ms = 0.0;
+    size_t triangles = 0;
+    float error = 0.0f;
+    bool ok = false;
+};
+
+struct ChunkResult {
+    size_t inputTriangles = 0;
+    float cellSize = 0.0f;
+    Sample cluster, quadric, quadricErr;
+    VertexCacheStats cacheBefore, cacheAfter;
+    double optimizeMs = 0.0;
+};
+
+VertexCacheStats cacheStats(const Geometry& geom) {
+    return measureVertexCache(geom.indices.data(), geom.indices.size(), geom.vertices.size());
+}
+
+template <typename F>
+Sample measure(const Geometry& input, F&& simplify) {
+    Sample s;
+    Geometry out;
+    const auto t0 = std::chrono::steady_clock::now();
+    s.ok = simplify(out);
+    s.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    if (s.ok) {
+        s.triangles = out.indices.size() / 3;
+        s.error = hausdorff(input, out);
+    } else {
+        s.triangles = input.indices.size() / 3;
+    }
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t maxChunks = 128;
+    int lod = 0;
+    bool perChunk = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--chunks" && i + 1 < argc) { maxChunks = std::stoul(argv[++i]); continue; }
+        if (arg == "--lod" && i + 1 < argc) { lod = std::stoi(argv[++i]); continue; }
+        if (arg == "--per-chunk") { perChunk = true; continue; }
+        std::cerr << "usage: simplifybench [--chunks N] [--lod L] [--per-chunk]\n";
+        return 1;
+    }
+
+    std::vector<OctreeNodeData> added;
+    std::mutex addedMutex;
+    Octree::OctreeNodeDataHandler onAdded = [&](const OctreeNodeData& nd) {
+        std::lock_guard<std::mutex> lock(addedMutex);
+        added.push_back(nd);
+    };
+    Octree::OctreeNodeDataHandler ignore = [](const OctreeNodeData&) {};
+
+    LocalScene scene;
+    MainSceneLoader loader;
+    scene.loadScene(loader, onAdded, ignore, ignore, ignore);
+
+    // Tessellate until enough chunks of the requested level have surfaced
+    // (each request walks the node's root path and emits every ladder level).
+    std::vector<Chunk> chunks;
+    std::mutex chunksMutex;
+    for (OctreeNodeData& nd : added) {
+        if (chunks.size() >= maxChunks) break;
+        scene.requestModel3D(LAYER_OPAQUE, nd,
+            [&](const Geometry& geo, uint8_t level, uint, uintptr_t, const BoundingCube& cube, const OctreeCellKey&) {
+                if (level != lod || geo.indices.size() < 3) return;
+                std::lock_guard<std::mutex> lock(chunksMutex);
+                if (chunks.size() < maxChunks) chunks.push_back(Chunk{geo, cube});
+            });
+    }
+    if (chunks.empty()) {
+        std::cerr << "simplifybench: no level " << lod << " chunks tessellated\n";
+        return 1;
+    }
+
+    ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<ChunkResult>> futures;
+    futures.reserve(chunks.size());
+    const auto wall0 = std::chrono::steady_clock::now();
+    for (const Chunk& chunk : chunks) {
+        futures.push_back(pool.enqueue([&chunk]() {
+            ChunkResult r;
+            const Geometry& in = chunk.geom;
+            r.inputTriangles = in.indices.size() / 3;
+            r.cellSize = chunk.cube.getLengthX();
+            const float measured = meshVertexSpacing(in, r.cellSize);
+            const float spacing = measured > 0.0f ? measured : r.cellSize;
+
+            r.cluster = measure(in, [&](Geometry& out) {
+                return decimateVertexCluster(in, 2.0f * spacing, spacing, chunk.cube, out);
+            });
+            QuadricSimplifyParams count;
+            count.targetTriangles = static_cast<uint32_t>(r.cluster.triangles);
+            count.borderStrip = spacing;
+            r.quadric = measure(in, [&](Geometry& out) { return simplifyQuadric(in, count, chunk.cube, out); });
+
+            QuadricSimplifyParams bounded;
+            bounded.maxError = std::max(r.cluster.error, 1e-3f);
+            bounded.borderStrip = spacing;
+            r.quadricErr = measure(in, [&](Geometry& out) { return simplifyQuadric(in, bounded, chunk.cube, out); });
+
+            Geometry optimized = in;
+            r.cacheBefore = cacheStats(optimized);
+            const auto t0 = std::chrono::steady_clock::now();
+            optimizeMeshForGpu(optimized, MeshClusters::TRIANGLES_PER_CLUSTER);
+            r.optimizeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            r.cacheAfter = cacheStats(optimized);
+            return r;
+        }));
+    }
+    std::vector<ChunkResult> results;
+    results.reserve(futures.size());
+    for (auto& f : futures) results.push_back(f.get());
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall0).count();
+    const size_t threads = pool.threadCount();
+    pool.stop();
+
+    size_t inputTris = 0;
+    for (const ChunkResult& r : results) inputTris += r.inputTriangles;
+    std::printf("chunks %zu at level %d  input triangles %zu  (%.1f per chunk)  %zu threads, %.0f ms wall\n",
+                results.size(), lod, inputTris, static_cast<double>(inputTris) / results.size(),
+                threads, wallMs);
+    std::printf("\n  method        ms/chunk    triangles   kept   Hausdorff avg / max   (rel. to chunk size)\n");
+    auto report = [&](const char* name, Sample ChunkResult::*field) {
+        double ms = 0.0, errSum = 0.0, relSum = 0.0;
+        size_t tris = 0;
+        float errMax = 0.0f;
+        for (const ChunkResult& r : results) {
+            const Sample& s = r.*field;
+            ms += s.ms;
+            tris += s.triangles;
+            errSum += s.error;
+            relSum += s.error / std::max(r.cellSize, 1e-6f);
+            errMax = std::max(errMax, s.error);
+        }
+        const double n = static_cast<double>(results.size());
+        std::printf("  %-11s  %8.3f  %11zu  %4.0f%%   %8.3f / %-8.3f   %.4f\n", name, ms / n, tris,
+                    100.0 * tris / std::max<size_t>(1, inputTris), errSum / n, errMax, relSum / n);
+    };
+    report("cluster", &ChunkResult::cluster);
+    report("quadric", &ChunkResult::quadric);
+    report("quadric@err", &ChunkResult::quadricErr);
+
+    std::printf("\n  vertex cache (FIFO %u)   ACMR avg  min / max          ATVR avg  min / max\n", VERTEX_CACHE_SIZE);
+    auto reportCache = [&](const char* name, VertexCacheStats ChunkResult::*field) {
+        double acmr = 0.0, atvr = 0.0;
+        float acmrMin = 1e30f, acmrMax = 0.0f, atvrMin = 1e30f, atvrMax = 0.0f;
+        for (const ChunkResult& r : results) {
+            const VertexCacheStats& c = r.*field;
+            acmr += c.acmr;
+            atvr += c.atvr;
+            acmrMin = std::min(acmrMin, c.acmr);
+            acmrMax = std::max(acmrMax, c.acmr);
+            atvrMin = std::min(atvrMin, c.atvr);
+            atvrMax = std::max(atvrMax, c.atvr);
+        }
+        const double n = static_cast<double>(results.size());
+        std::printf("  %-22s  %6.3f  %6.3f / %-6.3f     %6.3f  %6.3f / %-6.3f\n", name,
+                    acmr / n, acmrMin, acmrMax, atvr / n, atvrMin, atvrMax);
+    };
+    reportCache("as tessellated", &ChunkResult::cacheBefore);
+    reportCache("optimizeMeshForGpu", &ChunkResult::cacheAfter);
+    double optimizeMs = 0.0;
+    for (const ChunkResult& r : results) optimizeMs += r.optimizeMs;
+    std::printf("  optimize time %.3f ms/chunk\n", optimizeMs / static_cast<double>(results.size()));
+
+    if (perChunk) {
+        std::printf("\n  chunk  triangles   ACMR before / after   ATVR before / after\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const ChunkResult& r = results[i];
+            std::printf("  %5zu  %9zu   %6.3f / %-6.3f       %6.3f / %-6.3f\n", i, r.inputTriangles,
+                        r.cacheBefore.acmr, r.cacheAfter.acmr, r.cacheBefore.atvr, r.cacheAfter.atvr);
+        }
+    }
+    return 0;
+}
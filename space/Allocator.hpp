@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <functional>
 #include <unordered_set>
 #include <mutex>
 #include <shared_mutex>
@@ -20,6 +22,18 @@ private:
 
     std::vector<Block> blocks;
     std::vector<T*> freeList;
+    // Leading freeList entries sorted by descending address (orderFreeList),
+    // so allocate() hands out the lowest free element first.
+    size_t orderedFree = 0;
+    // Elements freed while holdFrees() is on: kept off the free list, so
+    // it stays ordered, until released or the free list runs dry.
+    std::vector<T*> heldFree;
+    bool holding = false;
+    // Blocks whose memory went back to the OS (releaseFreeBlocks): data is
+    // null and the slot is reused by the next allocateBlock, so indices of
+    // the other blocks never move.
+    std::vector<size_t> releasedBlocks;
+    size_t deallocations = 0;
     #ifndef NDEBUG
     std::unordered_set<T*> deallocatedSet;
     #endif
@@ -28,6 +42,8 @@ private:
     mutable std::shared_mutex mutex;    
 
     void allocateBlock();
+    void orderFreeListLocked();
+    void releaseHeldLocked();
 
 public:
     Allocator(size_t blockSize_);
@@ -57,6 +73,27 @@ public:
 
     size_t getAllocatedBlocksCount();
 
+    // Elements currently handed out (allocated and not yet returned).
+    size_t getUsedCount() const;
+
+    // Elements returned since construction (fragmentation churn).
+    size_t getDeallocationCount() const;
+
+    // Sorts the free list so allocations come from the lowest addresses
+    // first. Only the entries freed since the last call are sorted, then
+    // merged in.
+    void orderFreeList();
+
+    // While on, deallocated elements are held aside instead of going back
+    // on the free list, so allocations keep coming from its ordered lowest
+    // addresses without re-sorting after every free. Turning it on orders
+    // the list; turning it off merges the held elements in with one sort.
+    void holdFrees(bool hold);
+
+    // Frees the memory of every block with no element in use. Returns how
+    // many blocks were released.
+    size_t releaseFreeBlocks();
+
     size_t getBlockSize() const { return blockSize; }
 };
 
@@ -8,6 +8,19 @@ void Allocator<T>::allocateBlock() {
     T* data = static_cast<T*>(std::malloc(blockSize * sizeof(T)));
     if (!data) throw std::bad_alloc();
 
+    if (!releasedBlocks.empty()) {
+        // Refill a released slot: its index range is still reserved.
+        blocks[releasedBlocks.back()].data = data;
+        releasedBlocks.pop_back();
+        for (size_t i = 0; i < blockSize; ++i) {
+            freeList.push_back(&data[i]);
+            #ifndef NDEBUG
+            deallocatedSet.insert(&data[i]);
+            #endif
+        }
+        return;
+    }
+
     blocks.push_back({ data, totalAllocated });
 
     for (size_t i = 0; i < blockSize; ++i) {
@@ -32,10 +45,14 @@ Allocator<T>::~Allocator() {
 template <typename T>
 T* Allocator<T>::allocate() {
     std::unique_lock lock(mutex);
-    if (freeList.empty()) allocateBlock();
+    if (freeList.empty()) {
+        if (!heldFree.empty()) releaseHeldLocked();
+        else allocateBlock();
+    }
 
     T* ptr = freeList.back();
     freeList.pop_back();
+    orderedFree = std::min(orderedFree, freeList.size());
 
     #ifndef NDEBUG
     if (deallocatedSet.find(ptr) == deallocatedSet.end()) {
@@ -68,7 +85,9 @@ void Allocator<T>::deallocate(T* ptr) {
     #ifndef NDEBUG
     deallocatedSet.insert(ptr);
     #endif
-    freeList.push_back(ptr);
+    if (holding) heldFree.push_back(ptr);
+    else freeList.push_back(ptr);
+    ++deallocations;
 }
 
 template <typename T>
@@ -79,7 +98,7 @@ uint Allocator<T>::getIndex(T* ptr) {
 
     for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
         auto &b = *it;
-        if (ptr >= b.data && ptr < b.data + blockSize) {
+        if (b.data && ptr >= b.data && ptr < b.data + blockSize) {
             return static_cast<uint>(b.startIndex + (ptr - b.data));
         }
     }
@@ -98,6 +117,9 @@ T* Allocator<T>::getFromIndex(uint index) {
     uint offset = index % blockSize;
 
     Block& b = blocks[blockIdx];
+    if (!b.data) {
+        throw std::runtime_error("Invalid index");
+    }
 
     T* ptr = b.data + offset;
 
@@ -126,6 +148,9 @@ void Allocator<T>::getFromIndices(T * nodes[8], uint indices[8]) {
             throw std::runtime_error("Invalid index");
         }
         uint offset = index % blockSize;
+        if (!blocks[blockIdx].data) {
+            throw std::runtime_error("Invalid index");
+        }
         T* ptr = &blocks[blockIdx].data[offset];
 
         #ifndef NDEBUG
@@ -142,12 +167,15 @@ template <typename T>
 void Allocator<T>::reset() {
     std::unique_lock lock(mutex);
     freeList.clear();
+    heldFree.clear();
+    orderedFree = 0;
     #ifndef NDEBUG
     deallocatedSet.clear();
     #endif
 
     for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
         auto &b = *it;
+        if (!b.data) continue;
         for (size_t i = 0; i < blockSize; ++i) {
             T* ptr = &b.data[i];
             freeList.push_back(ptr);
@@ -167,6 +195,96 @@ uint Allocator<T>::allocateIndex() {
 template <typename T>
 size_t Allocator<T>::getAllocatedBlocksCount() {
     std::shared_lock lock(mutex);
-    return blocks.size();
+    return blocks.size() - releasedBlocks.size();
+}
+
+
+template <typename T>
+size_t Allocator<T>::getUsedCount() const {
+    std::shared_lock lock(mutex);
+    return totalAllocated - releasedBlocks.size() * blockSize - freeList.size() - heldFree.size();
+}
+
+template <typename T>
+size_t Allocator<T>::getDeallocationCount() const {
+    std::shared_lock lock(mutex);
+    return deallocations;
+}
+
+template <typename T>
+void Allocator<T>::orderFreeList() {
+    std::unique_lock lock(mutex);
+    orderFreeListLocked();
 }
 
+template <typename T>
+void Allocator<T>::orderFreeListLocked() {
+    const auto middle = freeList.begin() + orderedFree;
+    std::sort(middle, freeList.end(), std::greater<T*>());
+    std::inplace_merge(freeList.begin(), middle, freeList.end(), std::greater<T*>());
+    orderedFree = freeList.size();
+}
+
+template <typename T>
+void Allocator<T>::releaseHeldLocked() {
+    freeList.insert(freeList.end(), heldFree.begin(), heldFree.end());
+    heldFree.clear();
+    orderFreeListLocked();
+}
+
+template <typename T>
+void Allocator<T>::holdFrees(bool hold) {
+    std::unique_lock lock(mutex);
+    holding = hold;
+    if (hold) orderFreeListLocked();
+    else releaseHeldLocked();
+}
+
+template <typename T>
+size_t Allocator<T>::releaseFreeBlocks() {
+    std::unique_lock lock(mutex);
+    releaseHeldLocked();
+
+    // Live blocks by descending address, matching the free list order: each
+    // free element belongs to the first block starting at or below it.
+    std::vector<size_t> byAddress;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].data) byAddress.push_back(i);
+    }
+    if (byAddress.empty()) return 0;
+    std::sort(byAddress.begin(), byAddress.end(), [&](size_t a, size_t b) {
+        return std::greater<T*>()(blocks[a].data, blocks[b].data);
+    });
+    std::vector<size_t> owner(freeList.size());
+    std::vector<size_t> freeCount(blocks.size(), 0);
+    size_t cursor = 0;
+    for (size_t i = 0; i < freeList.size(); ++i) {
+        while (std::less<T*>()(freeList[i], blocks[byAddress[cursor]].data)) ++cursor;
+        owner[i] = byAddress[cursor];
+        ++freeCount[owner[i]];
+    }
+
+    size_t released = 0;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].data && freeCount[i] == blockSize) {
+            std::free(blocks[i].data);
+            blocks[i].data = nullptr;
+            releasedBlocks.push_back(i);
+            ++released;
+        }
+    }
+    if (released == 0) return 0;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < freeList.size(); ++i) {
+        if (blocks[owner[i]].data) {
+            freeList[kept++] = freeList[i];
+        }
+        #ifndef NDEBUG
+        else deallocatedSet.erase(freeList[i]);
+        #endif
+    }
+    freeList.resize(kept);
+    orderedFree = kept;
+    return released;
+}
@@ -58,10 +58,11 @@ void IteratorHandler::iterateParallelBFS(const Octree &tree, OctreeNodeData &roo
                         }
 
                         if (child != NULL && child != params.node) {
+                                            const OctreeCellKey childKey = params.key.child(j);
                                             OctreeNodeData childData(
-                                                params.level + 1,
                                                 child,
-                                                params.cube.getChild(j), 
+                                                childKey,
+                                                childKey.cube(tree),
                                                 params.context
                                             );
 
@@ -132,10 +133,11 @@ void IteratorHandler::iterateBFS(const Octree &tree, OctreeNodeData &rootParams,
                 }
 
                 if (child != NULL && child != params.node) {
+                    const OctreeCellKey childKey = params.key.child(j);
                     OctreeNodeData childData(
-                        params.level + 1,
                         child,
-                        params.cube.getChild(j),
+                        childKey,
+                        childKey.cube(tree),
                         params.context
                     );
 
@@ -172,19 +174,20 @@ void IteratorHandler::iterateMultiThreaded(
             for(int i=0; i <8 ; ++i) {
                 uint8_t j = internalOrder[i];
                 OctreeNode * child = children[j];
-                BoundingCube childCube = params.cube.getChild(j);
+                const OctreeCellKey childKey = params.key.child(j);
+                BoundingCube childCube = childKey.cube(tree);
                 if (child == params.node) {
                     throw std::runtime_error("Wrong pointer @ iter!");
                 }                
                 if(child != NULL && params.node != child) {
                     isThreaded = iterateThreadedHandler(tree, params);
                     if(isThreaded) {
-                        futures.push_back(pool.enqueue([this, &tree, &pool,child,childCube, params, &iterateHandler, &getOrderHandler, &iterateThreadedHandler]() mutable {
-                            OctreeNodeData data = OctreeNodeData( params.level+1, child, childCube, params.context);
+                        futures.push_back(pool.enqueue([this, &tree, &pool,child,childCube,childKey, params, &iterateHandler, &getOrderHandler, &iterateThreadedHandler]() mutable {
+                            OctreeNodeData data = OctreeNodeData(child, childKey, childCube, params.context);
                             this->iterateMultiThreaded(tree, data, pool, iterateHandler, getOrderHandler, iterateThreadedHandler);
                         }));
                     } else {
-                        OctreeNodeData data = OctreeNodeData( params.level+1, child, childCube, params.context);
+                        OctreeNodeData data = OctreeNodeData(child, childKey, childCube, params.context);
                         this->iterateMultiThreaded(tree, data, pool, iterateHandler, getOrderHandler, iterateThreadedHandler);
                     }
                 }
@@ -222,7 +225,8 @@ void IteratorHandler::iterate(
                 throw std::runtime_error("Wrong pointer @ iter!");
             }                
             if(child != NULL && params.node != child) {
-                OctreeNodeData data = OctreeNodeData( params.level+1, child, params.cube.getChild(j), params.context);
+                const OctreeCellKey childKey = params.key.child(j);
+                OctreeNodeData data = OctreeNodeData(child, childKey, childKey.cube(tree), params.context);
                 this->iterate(tree, data, iterateHandler, getOrderHandler);
             }
         }
@@ -236,39 +240,6 @@ void IteratorHandler::iterateFlatIn(
     const Octree::IterateHandler &iterateHandler, 
     const Octree::IterateOrderHandler &getOrderHandler
 ) {
-    if (params.context != NULL) {
-        ThreadContext *tc = reinterpret_cast<ThreadContext*>(params.context);
-        tc->parentOf.clear();
-
-        // Seed parentOf with the world-root path down to params.node (the chunk
-        // root) so findCellAt can rebuild root-consistent cubes. Without this,
-        // the cached cubes drift from the root-descended cubes and getNodeIndex
-        // flips at chunk-boundary faces, returning the wrong (cross-chunk) cell
-        // and leaving holes in the mesh.
-        OctreeNode *n = tree.root;
-        BoundingCube c = static_cast<const BoundingCube&>(tree);
-        for (uint l = 0; l < params.level && n != NULL; ++l) {
-            ChildBlock *block = n->getBlock(*tree.allocator);
-            if (block == NULL) break;
-            const glm::vec3 center = params.cube.getCenter();
-            const glm::vec3 cc = c.getCenter();
-            int idx = (center.x >= cc.x ? 4 : 0)
-                    + (center.y >= cc.y ? 2 : 0)
-                    + (center.z >= cc.z ? 1 : 0);
-            OctreeNode *child = block->get(idx, *tree.allocator);
-            if (child == NULL) break;
-            tc->parentOf.try_emplace(child, n, idx);
-            c = c.getChild(idx);
-            n = child;
-        }
-        // If the descent didn't land exactly on params.node, the seed is
-        // unusable; disable the cache (findCellAt falls back to root descent,
-        // which is correct, just not optimized).
-        if (n != params.node) {
-            tc->parentOf.clear();
-        }
-    }
-
     uint8_t internalOrder[8];
 
     flatData.push(params);
@@ -291,16 +262,11 @@ void IteratorHandler::iterateFlatIn(
                 }
 
                 if (child != NULL) {
-                    // Cache the parent link (with child index) for upper
-                    // traversal during triangle iteration.
-                    if (data.context != NULL) {
-                        reinterpret_cast<ThreadContext*>(data.context)
-                            ->parentOf.try_emplace(child, node, j);
-                    }
+                    const OctreeCellKey childKey = data.key.child(j);
                     flatData.push(OctreeNodeData(
-                        data.level + 1,
                         child,
-                        data.cube.getChild(j),
+                        childKey,
+                        childKey.cube(tree),
                         data.context
                     ));
                 }
@@ -349,7 +315,8 @@ void IteratorHandler::iterateFlatOut(
                 ChildBlock * block = node->getBlock(*tree.allocator);
                 OctreeNode* child = block->get(j, *tree.allocator);
                 if (child) {
-                    stackOut.push(StackFrameOut(OctreeNodeData(frame.level + 1, child, frame.cube.getChild(j), frame.context), false));
+                    const OctreeCellKey childKey = frame.key.child(j);
+                    stackOut.push(StackFrameOut(OctreeNodeData(child, childKey, childKey.cube(tree), frame.context), false));
                 }
             }
         } else {
@@ -0,0 +1,262 @@
+#include "MeshOptimizer.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Spread the low 10 bits of v so there are two zero bits between each.
+uint32_t expandBits(uint32_t v) {
+    v &= 0x3FFu;
+    v = (v | (v << 16)) & 0x030000FFu;
+    v = (v | (v << 8))  & 0x0300F00Fu;
+    v = (v | (v << 4))  & 0x030C30C3u;
+    v = (v | (v << 2))  & 0x09249249u;
+    return v;
+}
+
+uint32_t morton3(const glm::vec3& unit) {
+    const glm::vec3 q = glm::clamp(unit, glm::vec3(0.0f), glm::vec3(1.0f)) * 1023.0f;
+    return (expandBits(static_cast<uint32_t>(q.x)) << 2)
+         | (expandBits(static_cast<uint32_t>(q.y)) << 1)
+         |  expandBits(static_cast<uint32_t>(q.z));
+}
+
+// Tipsify (Sander, Nehab, Barczak 2007) over `triCount` triangles of
+// `tris` whose vertices are local ids in [0, vertexCount). Appends the
+// reordered triangle indices (into `tris`) to `order`.
+void tipsify(const uint32_t* tris, uint32_t triCount, uint32_t vertexCount,
+             uint32_t cacheSize, std::vector<uint32_t>& order) {
+    // Vertex -> triangle adjacency (CSR).
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t i = 0; i < triCount * 3; ++i) ++offsets[tris[i] + 1];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<uint32_t> adjacency(triCount * 3);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32_t t = 0; t < triCount; ++t)
+            for (int k = 0; k < 3; ++k) adjacency[fill[tris[t * 3 + k]]++] = t;
+    }
+
+    std::vector<uint32_t> live(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v) live[v] = offsets[v + 1] - offsets[v];
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> emitted(triCount, 0);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    uint32_t timestamp = cacheSize + 1;
+    uint32_t cursor = 0;
+
+    int64_t fan = 0;
+    while (fan >= 0) {
+        candidates.clear();
+        const uint32_t f = static_cast<uint32_t>(fan);
+        for (uint32_t a = offsets[f]; a < offsets[f + 1]; ++a) {
+            const uint32_t t = adjacency[a];
+            if (emitted[t]) continue;
+            emitted[t] = 1;
+            order.push_back(t);
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = tris[t * 3 + k];
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (timestamp - cacheTime[v] > cacheSize) cacheTime[v] = timestamp++;
+            }
+        }
+
+        // Next fanning vertex: the candidate still in cache that stays there
+        // longest after its remaining triangles are emitted.
+        fan = -1;
+        int64_t best = -1;
+        for (uint32_t v : candidates) {
+            if (live[v] == 0) continue;
+            int64_t priority = 0;
+            if (timestamp - cacheTime[v] + 2 * live[v] <= cacheSize) priority = timestamp - cacheTime[v];
+            if (priority > best) {
+                best = priority;
+                fan = v;
+            }
+        }
+        if (fan >= 0) continue;
+
+        // Dead end: most recent vertex with live triangles, else scan.
+        while (!deadEnd.empty()) {
+            const uint32_t d = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[d] > 0) {
+                fan = d;
+                break;
+            }
+        }
+        while (fan < 0 && cursor < vertexCount) {
+            if (live[cursor] > 0) fan = cursor;
+            else ++cursor;
+        }
+    }
+}
+
+} // namespace
+
+VertexCacheStats measureVertexCache(const uint32_t* indices, size_t indexCount,
+                                    size_t vertexCount, uint32_t cacheSize) {
+    VertexCacheStats stats;
+    if (indices == nullptr || indexCount < 3 || vertexCount == 0 || cacheSize == 0) return stats;
+
+    // FIFO: a vertex is in cache while fewer than cacheSize misses happened
+    // since its own miss.
+    std::vector<int64_t> missAt(vertexCount, -1);
+    std::vector<uint8_t> referenced(vertexCount, 0);
+    int64_t misses = 0;
+    size_t unique = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        const uint32_t v = indices[i];
+        if (v >= vertexCount) continue;
+        if (!referenced[v]) {
+            referenced[v] = 1;
+            ++unique;
+        }
+        if (missAt[v] < 0 || misses - missAt[v] >= static_cast<int64_t>(cacheSize)) {
+            missAt[v] = misses++;
+        }
+    }
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+    stats.atvr = unique ? static_cast<float>(misses) / static_cast<float>(unique) : 0.0f;
+    return stats;
+}
+
+void sortTrianglesMorton(const Vertex* vertices, uint32_t vertexCount,
+                         uint32_t* indices, uint32_t indexCount) {
+    const uint32_t triangles = indexCount / 3;
+    if (triangles < 2 || vertices == nullptr || indices == nullptr) return;
+
+    auto position = [&](uint32_t i) {
+        return i < vertexCount ? vertices[i].position : glm::vec3(0.0f);
+    };
+
+    std::vector<glm::vec3> centroids(triangles);
+    glm::vec3 cmin(FLT_MAX), cmax(-FLT_MAX);
+    for (uint32_t t = 0; t < triangles; ++t) {
+        const glm::vec3 c = (position(indices[t * 3]) + position(indices[t * 3 + 1])
+                           + position(indices[t * 3 + 2])) * (1.0f / 3.0f);
+        centroids[t] = c;
+        cmin = glm::min(cmin, c);
+        cmax = glm::max(cmax, c);
+    }
+    const glm::vec3 extent = glm::max(cmax - cmin, glm::vec3(1e-6f));
+
+    std::vector<std::pair<uint32_t, uint32_t>> order(triangles); // {morton, triangle}
+    for (uint32_t t = 0; t < triangles; ++t) {
+        order[t] = { morton3((centroids[t] - cmin) / extent), t };
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<uint32_t> sorted(static_cast<size_t>(triangles) * 3);
+    for (uint32_t t = 0; t < triangles; ++t) {
+        const uint32_t src = order[t].second * 3;
+        sorted[t * 3]     = indices[src];
+        sorted[t * 3 + 1] = indices[src + 1];
+        sorted[t * 3 + 2] = indices[src + 2];
+    }
+    std::copy(sorted.begin(), sorted.end(), indices);
+}
+
+void optimizeMeshForGpu(Geometry& geom, uint32_t clusterTriangles) {
+    const uint32_t vertexCount = static_cast<uint32_t>(geom.vertices.size());
+    const uint32_t triangles = static_cast<uint32_t>(geom.indices.size() / 3);
+    if (triangles == 0 || vertexCount == 0 || clusterTriangles == 0) return;
+    geom.indices.resize(static_cast<size_t>(triangles) * 3);
+    for (uint32_t i : geom.indices) {
+        if (i >= vertexCount) return; // malformed: leave the mesh as tessellated
+    }
+
+    uint32_t* indices = geom.indices.data();
+    sortTrianglesMorton(geom.vertices.data(), vertexCount, indices, triangles * 3);
+
+    // Tipsify each run on local vertex ids.
+    const uint32_t runs = (triangles + clusterTriangles - 1) / clusterTriangles;
+    std::vector<uint32_t> reordered(static_cast<size_t>(triangles) * 3);
+    std::vector<uint32_t> localOf(vertexCount, UINT32_MAX);
+    std::vector<uint32_t> globalOf;
+    std::vector<uint32_t> local;
+    std::vector<uint32_t> order;
+    for (uint32_t r = 0; r < runs; ++r) {
+        const uint32_t first = r * clusterTriangles;
+        const uint32_t count = std::min(clusterTriangles, triangles - first);
+        globalOf.clear();
+        local.resize(static_cast<size_t>(count) * 3);
+        for (uint32_t i = 0; i < count * 3; ++i) {
+            const uint32_t v = indices[first * 3 + i];
+            if (localOf[v] == UINT32_MAX) {
+                localOf[v] = static_cast<uint32_t>(globalOf.size());
+                globalOf.push_back(v);
+            }
+            local[i] = localOf[v];
+        }
+        order.clear();
+        tipsify(local.data(), count, static_cast<uint32_t>(globalOf.size()), TIPSIFY_CACHE_SIZE, order);
+        for (uint32_t k = 0; k < count; ++k) {
+            const uint32_t src = (first + order[k]) * 3;
+            std::copy(indices + src, indices + src + 3, reordered.begin() + (first + k) * 3);
+        }
+        for (uint32_t v : globalOf) localOf[v] = UINT32_MAX;
+    }
+
+    // Overdraw order: runs whose mean normal points away from the mesh centre
+    // are the outer surface and go first (Sander et al., "linear-speed"
+    // reordering). The partial tail run is not sorted.
+    glm::vec3 meshCentre(0.0f);
+    for (const Vertex& v : geom.vertices) meshCentre += v.position;
+    meshCentre /= static_cast<float>(vertexCount);
+    const uint32_t fullRuns = triangles / clusterTriangles;
+    std::vector<std::pair<float, uint32_t>> runOrder(fullRuns); // {-facing, run}
+    for (uint32_t r = 0; r < fullRuns; ++r) {
+        glm::vec3 centroid(0.0f), normal(0.0f);
+        for (uint32_t t = r * clusterTriangles; t < (r + 1) * clusterTriangles; ++t) {
+            const glm::vec3& p0 = geom.vertices[reordered[t * 3]].position;
+            const glm::vec3& p1 = geom.vertices[reordered[t * 3 + 1]].position;
+            const glm::vec3& p2 = geom.vertices[reordered[t * 3 + 2]].position;
+            centroid += p0 + p1 + p2;
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            // Orient by the shading normals, as MeshClusters does for cones.
+            const glm::vec3 vn = geom.vertices[reordered[t * 3]].normal
+                               + geom.vertices[reordered[t * 3 + 1]].normal
+                               + geom.vertices[reordered[t * 3 + 2]].normal;
+            if (glm::dot(n, vn) < 0.0f) n = -n;
+            normal += n; // area-weighted
+        }
+        centroid /= static_cast<float>(clusterTriangles * 3);
+        const float len = glm::length(normal);
+        const float facing = len > 0.0f ? glm::dot(centroid - meshCentre, normal / len) : 0.0f;
+        runOrder[r] = { -facing, r };
+    }
+    std::stable_sort(runOrder.begin(), runOrder.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (uint32_t r = 0; r < fullRuns; ++r) {
+        const uint32_t src = runOrder[r].second * clusterTriangles * 3;
+        std::copy(reordered.begin() + src, reordered.begin() + src + clusterTriangles * 3,
+                  indices + static_cast<size_t>(r) * clusterTriangles * 3);
+    }
+    const uint32_t tailFirst = fullRuns * clusterTriangles * 3;
+    std::copy(reordered.begin() + tailFirst, reordered.end(), indices + tailFirst);
+
+    // Vertex fetch order: renumber vertices by first use; unreferenced
+    // vertices are dropped.
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    std::vector<Vertex> vertices;
+    vertices.reserve(vertexCount);
+    for (uint32_t& i : geom.indices) {
+        if (remap[i] == UINT32_MAX) {
+            remap[i] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(geom.vertices[i]);
+        }
+        i = remap[i];
+    }
+    geom.vertices = std::move(vertices);
+    // The dedup map indexes the old vertex order; nothing adds to a published
+    // mesh, so drop it instead of rebuilding.
+    geom.compactMap.clear();
+    geom.clusterOrdered = true;
+}
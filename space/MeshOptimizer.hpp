@@ -0,0 +1,39 @@
+#pragma once
+#include "../math/Geometry.hpp"
+#include <cstdint>
+
+// Post-transform cache size assumed by the reorder and by the statistics.
+// Tipsify is tuned for a slightly smaller cache than the simulated one so
+// the order stays good on hardware with less reuse.
+constexpr uint32_t VERTEX_CACHE_SIZE = 32;
+constexpr uint32_t TIPSIFY_CACHE_SIZE = 16;
+
+// Post-transform vertex cache behaviour of an index buffer, simulated on a
+// FIFO cache of `cacheSize` entries:
+//   acmr = transformed vertices / triangles           (>= 0.5, lower is better)
+//   atvr = transformed vertices / referenced vertices (>= 1.0, 1.0 is ideal)
+struct VertexCacheStats {
+    float acmr = 0.0f;
+    float atvr = 0.0f;
+};
+
+VertexCacheStats measureVertexCache(const uint32_t* indices, size_t indexCount,
+                                    size_t vertexCount, uint32_t cacheSize = VERTEX_CACHE_SIZE);
+
+// Sorts whole triangles along a Morton curve over their centroid bounds, so
+// every fixed-size run of the result is a compact patch. Winding and the set
+// of triangles are unchanged.
+void sortTrianglesMorton(const Vertex* vertices, uint32_t vertexCount,
+                         uint32_t* indices, uint32_t indexCount);
+
+// GPU-friendly reorder of a published chunk mesh, run on the generation
+// workers before upload:
+//  1. Morton runs of `clusterTriangles` triangles (the MeshClusters size, so
+//     every culled cluster is one run),
+//  2. Tipsify vertex-cache order inside each run,
+//  3. runs sorted front-to-back from the mesh centre along their mean normal
+//     (outward-facing patches first, so they occlude the rest for early-Z);
+//     the partial tail run stays last to keep run boundaries aligned,
+//  4. vertices renumbered in first-use order for fetch locality.
+// Marks the geometry clusterOrdered so MeshClusters keeps this order.
+void optimizeMeshForGpu(Geometry& geom, uint32_t clusterTriangles);
@@ -1,8 +1,13 @@
 #include "MeshSimplifier.hpp"
 #include "../math/BoundingCube.hpp"
 #include <tsl/robin_map.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <functional>
+#include <limits>
+#include <queue>
 
 namespace {
 
@@ -39,6 +44,63 @@ struct hash<CellKey> {
 
 } // namespace std
 
+namespace {
+
+// Symmetric 4x4 error quadric, upper triangle: xx xy xz xw yy yz yw zz zw ww.
+struct Quadric {
+    double m[10] = {};
+
+    static Quadric fromPlane(const glm::dvec3& n, double d) {
+        Quadric q;
+        q.m[0] = n.x * n.x; q.m[1] = n.x * n.y; q.m[2] = n.x * n.z; q.m[3] = n.x * d;
+        q.m[4] = n.y * n.y; q.m[5] = n.y * n.z; q.m[6] = n.y * d;
+        q.m[7] = n.z * n.z; q.m[8] = n.z * d;
+        q.m[9] = d * d;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        for (int i = 0; i < 10; ++i) m[i] += o.m[i];
+        return *this;
+    }
+
+    double error(const glm::dvec3& p) const {
+        const double e = m[0] * p.x * p.x + 2.0 * m[1] * p.x * p.y + 2.0 * m[2] * p.x * p.z + 2.0 * m[3] * p.x
+                       + m[4] * p.y * p.y + 2.0 * m[5] * p.y * p.z + 2.0 * m[6] * p.y
+                       + m[7] * p.z * p.z + 2.0 * m[8] * p.z
+                       + m[9];
+        return std::max(e, 0.0);
+    }
+
+    // Position minimizing the error; false when the system is (near) singular
+    // (flat or cylindrical neighbourhoods), in which case callers fall back
+    // to the edge endpoints / midpoint.
+    bool optimum(glm::dvec3& p) const {
+        const double a = m[0], b = m[1], c = m[2], e = m[4], f = m[5], i = m[7];
+        const double c0 = e * i - f * f;
+        const double c1 = c * f - b * i;
+        const double c2 = b * f - c * e;
+        const double det = a * c0 + b * c1 + c * c2;
+        const double scale = std::fabs(a) + std::fabs(e) + std::fabs(i);
+        if (std::fabs(det) <= 1e-9 * scale * scale * scale) return false;
+        const double rx = -m[3], ry = -m[6], rz = -m[8];
+        p.x = (c0 * rx + c1 * ry + c2 * rz) / det;
+        p.y = (c1 * rx + (a * i - c * c) * ry + (b * c - a * f) * rz) / det;
+        p.z = (c2 * rx + (b * c - a * f) * ry + (a * e - b * b) * rz) / det;
+        return true;
+    }
+};
+
+struct Collapse {
+    double cost;
+    uint32_t a, b;
+    uint32_t stampA, stampB;
+    glm::dvec3 target;
+    bool operator>(const Collapse& o) const { return cost > o.cost; }
+};
+
+} // namespace
+
 bool decimateVertexCluster(const Geometry& in,
                            float clusterSize,
                            float borderStrip,
@@ -150,3 +212,360 @@ bool decimateVertexCluster(const Geometry& in,
     out.setCenter();
     return !out.indices.empty();
 }
+
+uint32_t packMorph(const glm::vec3& delta, int level) {
+    const float largest = std::max(std::fabs(delta.x), std::max(std::fabs(delta.y), std::fabs(delta.z)));
+    if (!(largest > 0.0f)) {
+        return 0u; // nothing to morph (also rejects NaN)
+    }
+    int e = static_cast<int>(std::ceil(std::log2(largest / 127.0f))) + 16;
+    e = std::clamp(e, 0, 31);
+    const float step = std::ldexp(1.0f, e - 16);
+
+    auto quantize = [step](float d) {
+        const int q = static_cast<int>(std::lround(d / step));
+        return static_cast<uint32_t>(static_cast<uint8_t>(static_cast<int8_t>(std::clamp(q, -127, 127))));
+    };
+    return quantize(delta.x)
+         | (quantize(delta.y) << 8)
+         | (quantize(delta.z) << 16)
+         | (static_cast<uint32_t>(std::clamp(level, 0, 7)) << 24)
+         | (static_cast<uint32_t>(e) << 27);
+}
+
+glm::vec3 unpackMorphDelta(uint32_t morph) {
+    if (morph == 0u) {
+        return glm::vec3(0.0f);
+    }
+    const float step = std::ldexp(1.0f, static_cast<int>(morph >> 27) - 16);
+    auto component = [morph, step](int shift) {
+        return static_cast<float>(static_cast<int8_t>(static_cast<uint8_t>(morph >> shift))) * step;
+    };
+    return glm::vec3(component(0), component(8), component(16));
+}
+
+float meshVertexSpacing(const Geometry& geom, float cellSize) {
+    double edgeSum = 0.0;
+    size_t edgeCount = 0;
+    for (size_t ti = 0; ti + 2 < geom.indices.size(); ti += 3) {
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t a = geom.indices[ti + k];
+            const uint32_t b = geom.indices[ti + (k + 1) % 3];
+            if (a >= geom.vertices.size() || b >= geom.vertices.size()) continue;
+            edgeSum += glm::length(geom.vertices[a].position - geom.vertices[b].position);
+            ++edgeCount;
+        }
+    }
+    if (edgeCount == 0 || edgeSum <= 0.0 || cellSize <= 0.0f) return 0.0f;
+    const float meanEdge = static_cast<float>(edgeSum / static_cast<double>(edgeCount));
+    const int subdivisions = std::max(0, static_cast<int>(std::lround(std::log2(cellSize / meanEdge))));
+    return std::ldexp(cellSize, -subdivisions);
+}
+
+void computeGeomorphTargets(Geometry& geom,
+                            const BoundingCube& chunkBounds,
+                            int level,
+                            int maxLevel) {
+    const float cellSize = chunkBounds.getLengthX();
+    const float spacing = (level >= maxLevel || geom.indices.size() < 3)
+        ? 0.0f : meshVertexSpacing(geom, cellSize);
+    if (spacing <= 0.0f) {
+        for (Vertex& v : geom.vertices) v.morph = 0u;
+        return;
+    }
+    const float invCoarse = 1.0f / (2.0f * spacing);
+
+    const glm::vec3 minP = chunkBounds.getMin();
+    const glm::vec3 maxP = chunkBounds.getMax();
+    auto nearBorder = [&](const glm::vec3& p) {
+        return (p.x - minP.x < spacing) || (maxP.x - p.x < spacing) ||
+               (p.y - minP.y < spacing) || (maxP.y - p.y < spacing) ||
+               (p.z - minP.z < spacing) || (maxP.z - p.z < spacing);
+    };
+    auto cellOf = [invCoarse](const glm::vec3& p) {
+        return CellKey{
+            static_cast<int64_t>(std::floor(p.x * invCoarse)),
+            static_cast<int64_t>(std::floor(p.y * invCoarse)),
+            static_cast<int64_t>(std::floor(p.z * invCoarse))};
+    };
+
+    // Average the interior vertices per coarse cell (the welded position the
+    // coarser level would place there).
+    struct CellSum {
+        glm::vec3 sum;
+        uint32_t count;
+    };
+    tsl::robin_map<CellKey, CellSum> cells;
+    for (const Vertex& v : geom.vertices) {
+        if (nearBorder(v.position)) continue;
+        auto it = cells.find(cellOf(v.position));
+        if (it == cells.end()) {
+            cells.emplace(cellOf(v.position), CellSum{v.position, 1u});
+        } else {
+            it.value().sum += v.position;
+            ++it.value().count;
+        }
+    }
+
+    for (Vertex& v : geom.vertices) {
+        if (nearBorder(v.position)) {
+            v.morph = 0u;
+            continue;
+        }
+        const CellSum& cell = cells.at(cellOf(v.position));
+        const glm::vec3 target = cell.sum / static_cast<float>(cell.count);
+        v.morph = packMorph(target - v.position, level);
+    }
+}
+
+bool simplifyQuadric(const Geometry& in,
+                     const QuadricSimplifyParams& params,
+                     const BoundingCube& chunkBounds,
+                     Geometry& out) {
+    if (in.vertices.empty() || in.indices.size() < 3 ||
+        (params.targetTriangles == 0 && params.maxError <= 0.0f)) {
+        return false;
+    }
+
+    const glm::vec3 minP = chunkBounds.getMin();
+    const glm::vec3 maxP = chunkBounds.getMax();
+    const float strip = std::max(params.borderStrip, 1e-3f);
+
+    // Weld by exact position (quantized to 1e-4 like the clustering border
+    // grid) so attribute splits do not tear the surface apart.
+    const int64_t quant = 10000;
+    tsl::robin_map<CellKey, uint32_t> weldMap;
+    std::vector<glm::dvec3> pos;
+    std::vector<uint32_t> src;
+    std::vector<uint8_t> locked;
+    std::vector<uint32_t> remap(in.vertices.size());
+    for (size_t vi = 0; vi < in.vertices.size(); ++vi) {
+        const glm::vec3& p = in.vertices[vi].position;
+        const CellKey key{
+            static_cast<int64_t>(std::llround(static_cast<double>(p.x) * quant)),
+            static_cast<int64_t>(std::llround(static_cast<double>(p.y) * quant)),
+            static_cast<int64_t>(std::llround(static_cast<double>(p.z) * quant))};
+        auto it = weldMap.find(key);
+        if (it != weldMap.end()) {
+            remap[vi] = it->second;
+            continue;
+        }
+        const uint32_t idx = static_cast<uint32_t>(pos.size());
+        weldMap.emplace(key, idx);
+        pos.push_back(glm::dvec3(p));
+        src.push_back(static_cast<uint32_t>(vi));
+        locked.push_back(
+            (p.x - minP.x < strip) || (maxP.x - p.x < strip) ||
+            (p.y - minP.y < strip) || (maxP.y - p.y < strip) ||
+            (p.z - minP.z < strip) || (maxP.z - p.z < strip));
+        remap[vi] = idx;
+    }
+
+    std::vector<std::array<uint32_t, 3>> tris;
+    tris.reserve(in.indices.size() / 3);
+    for (size_t ti = 0; ti + 2 < in.indices.size(); ti += 3) {
+        const uint32_t a = remap[in.indices[ti]];
+        const uint32_t b = remap[in.indices[ti + 1]];
+        const uint32_t c = remap[in.indices[ti + 2]];
+        if (a == b || b == c || a == c) continue;
+        tris.push_back({a, b, c});
+    }
+    if (tris.empty()) return false;
+
+    const size_t vertexCount = pos.size();
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<std::vector<uint32_t>> vertexTris(vertexCount);
+    std::vector<uint64_t> edges;
+    edges.reserve(tris.size() * 3);
+    auto edgeKey = [](uint32_t a, uint32_t b) {
+        return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+    };
+    for (uint32_t t = 0; t < tris.size(); ++t) {
+        const auto& tri = tris[t];
+        const glm::dvec3 n = glm::cross(pos[tri[1]] - pos[tri[0]], pos[tri[2]] - pos[tri[0]]);
+        const double len = glm::length(n);
+        for (int k = 0; k < 3; ++k) {
+            vertexTris[tri[k]].push_back(t);
+            edges.push_back(edgeKey(tri[k], tri[(k + 1) % 3]));
+        }
+        if (len <= 0.0) continue;
+        const glm::dvec3 unit = n / len;
+        const Quadric q = Quadric::fromPlane(unit, -glm::dot(unit, pos[tri[0]]));
+        for (int k = 0; k < 3; ++k) quadrics[tri[k]] += q;
+    }
+
+    // Open edges (used by one triangle) bound holes in the surface: lock
+    // their vertices so the outline is kept, like the chunk border.
+    std::sort(edges.begin(), edges.end());
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i;
+        while (j < edges.size() && edges[j] == edges[i]) ++j;
+        if (j - i == 1) {
+            locked[static_cast<uint32_t>(edges[i] >> 32)] = 1;
+            locked[static_cast<uint32_t>(edges[i] & 0xFFFFFFFFu)] = 1;
+        }
+        i = j;
+    }
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<uint8_t> triAlive(tris.size(), 1);
+    std::vector<uint8_t> vertexAlive(vertexCount, 1);
+    std::vector<uint32_t> stamp(vertexCount, 0);
+    size_t liveTris = tris.size();
+
+    auto planCollapse = [&](uint32_t a, uint32_t b, Collapse& c) {
+        if (locked[a] && locked[b]) return false;
+        const Quadric q = [&] { Quadric sum = quadrics[a]; sum += quadrics[b]; return sum; }();
+        glm::dvec3 target;
+        if (locked[a] || locked[b]) {
+            target = locked[a] ? pos[a] : pos[b];
+        } else {
+            const glm::dvec3 mid = 0.5 * (pos[a] + pos[b]);
+            const double edgeLen = glm::length(pos[a] - pos[b]);
+            target = mid;
+            double best = q.error(mid);
+            for (const glm::dvec3& candidate : {pos[a], pos[b]}) {
+                const double e = q.error(candidate);
+                if (e < best) { best = e; target = candidate; }
+            }
+            glm::dvec3 opt;
+            // The optimum of a nearly flat neighbourhood can land far off the
+            // edge; only trust it within one edge length of the midpoint.
+            if (q.optimum(opt) && glm::length(opt - mid) <= edgeLen && q.error(opt) < best) target = opt;
+        }
+        c = Collapse{q.error(target), a, b, stamp[a], stamp[b], target};
+        return true;
+    };
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+    for (uint64_t key : edges) {
+        Collapse c;
+        if (planCollapse(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key & 0xFFFFFFFFu), c)) heap.push(c);
+    }
+
+    const double maxCost = params.maxError > 0.0f
+        ? static_cast<double>(params.maxError) * params.maxError
+        : std::numeric_limits<double>::infinity();
+    const size_t target = params.targetTriangles;
+    std::vector<uint32_t> ringA, ringB;
+    size_t collapses = 0;
+
+    auto ring = [&](uint32_t v, std::vector<uint32_t>& outRing) {
+        outRing.clear();
+        for (uint32_t t : vertexTris[v]) {
+            if (!triAlive[t]) continue;
+            for (uint32_t w : tris[t]) if (w != v) outRing.push_back(w);
+        }
+        std::sort(outRing.begin(), outRing.end());
+        outRing.erase(std::unique(outRing.begin(), outRing.end()), outRing.end());
+    };
+
+    while (!heap.empty() && liveTris > target) {
+        const Collapse c = heap.top();
+        heap.pop();
+        if (!vertexAlive[c.a] || !vertexAlive[c.b] || stamp[c.a] != c.stampA || stamp[c.b] != c.stampB) continue;
+        if (c.cost > maxCost) break;
+
+        // Keep the locked endpoint (it cannot move); otherwise keep a.
+        const uint32_t keep = locked[c.b] ? c.b : c.a;
+        const uint32_t drop = keep == c.a ? c.b : c.a;
+
+        // Link condition: the endpoints may only share the neighbours of the
+        // triangles on the collapsed edge, or the result is non-manifold.
+        ring(keep, ringA);
+        ring(drop, ringB);
+        size_t sharedRing = 0, sharedTris = 0;
+        {
+            size_t i = 0, j = 0;
+            while (i < ringA.size() && j < ringB.size()) {
+                if (ringA[i] < ringB[j]) ++i;
+                else if (ringB[j] < ringA[i]) ++j;
+                else { ++sharedRing; ++i; ++j; }
+            }
+        }
+        for (uint32_t t : vertexTris[drop]) {
+            if (!triAlive[t]) continue;
+            const auto& tri = tris[t];
+            if (tri[0] == keep || tri[1] == keep || tri[2] == keep) ++sharedTris;
+        }
+        if (sharedTris == 0 || sharedRing > sharedTris) continue;
+
+        // Reject collapses that flip or degenerate a surviving triangle.
+        bool flips = false;
+        for (uint32_t v : {keep, drop}) {
+            for (uint32_t t : vertexTris[v]) {
+                if (!triAlive[t]) continue;
+                const auto& tri = tris[t];
+                const bool hasKeep = tri[0] == keep || tri[1] == keep || tri[2] == keep;
+                const bool hasDrop = tri[0] == drop || tri[1] == drop || tri[2] == drop;
+                if (hasKeep && hasDrop) continue; // removed by the collapse
+                glm::dvec3 p[3], q[3];
+                for (int k = 0; k < 3; ++k) {
+                    p[k] = pos[tri[k]];
+                    q[k] = (tri[k] == keep || tri[k] == drop) ? c.target : p[k];
+                }
+                const glm::dvec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                const glm::dvec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+                const double la = glm::length(after), lb = glm::length(before);
+                if (la <= 1e-12 * std::max(lb, 1.0) || glm::dot(before, after) < 0.2 * la * lb) {
+                    flips = true;
+                    break;
+                }
+            }
+            if (flips) break;
+        }
+        if (flips) continue;
+
+        pos[keep] = c.target;
+        quadrics[keep] += quadrics[drop];
+        vertexAlive[drop] = 0;
+        for (uint32_t t : vertexTris[drop]) {
+            if (!triAlive[t]) continue;
+            auto& tri = tris[t];
+            if (tri[0] == keep || tri[1] == keep || tri[2] == keep) {
+                triAlive[t] = 0;
+                --liveTris;
+                continue;
+            }
+            for (uint32_t& w : tri) if (w == drop) w = keep;
+            vertexTris[keep].push_back(t);
+        }
+        vertexTris[drop].clear();
+        auto& keepTris = vertexTris[keep];
+        keepTris.erase(std::remove_if(keepTris.begin(), keepTris.end(),
+                                      [&](uint32_t t) { return !triAlive[t]; }), keepTris.end());
+        ++stamp[keep];
+        ++collapses;
+
+        ring(keep, ringA);
+        for (uint32_t n : ringA) {
+            Collapse next;
+            if (planCollapse(keep, n, next)) heap.push(next);
+        }
+    }
+
+    if (collapses == 0 || liveTris == 0) {
+        return false;
+    }
+
+    // Compact: surviving vertices keep their source vertex's attributes.
+    std::vector<uint32_t> outIndex(vertexCount, UINT32_MAX);
+    out.vertices.clear();
+    out.indices.clear();
+    out.indices.reserve(liveTris * 3);
+    for (uint32_t t = 0; t < tris.size(); ++t) {
+        if (!triAlive[t]) continue;
+        for (uint32_t v : tris[t]) {
+            if (outIndex[v] == UINT32_MAX) {
+                outIndex[v] = static_cast<uint32_t>(out.vertices.size());
+                Vertex vert = in.vertices[src[v]];
+                vert.position = glm::vec3(pos[v]);
+                out.vertices.push_back(vert);
+            }
+            out.indices.push_back(outIndex[v]);
+        }
+    }
+
+    out.setCenter();
+    return true;
+}
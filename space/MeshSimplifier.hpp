@@ -22,3 +22,63 @@ bool decimateVertexCluster(const Geometry& in,
                            float borderStrip,
                            const BoundingCube& chunkBounds,
                            Geometry& out);
+
+// ── Geomorphing ──
+// Vertex::morph packs the offset from a vertex to its position on the next
+// coarser ladder level, decoded by shaders/includes/geomorph.glsl:
+//   bits  0..23  delta x/y/z as signed 8-bit steps
+//   bits 24..26  the mesh's LoD level (0..7)
+//   bits 27..31  step exponent e, step = 2^(e - 16) world units
+// The step is the smallest power of two that fits the largest component in
+// 127 steps, so the residual at t = 1 is below 1/254 of the delta. 0 = no morph.
+uint32_t packMorph(const glm::vec3& delta, int level);
+glm::vec3 unpackMorphDelta(uint32_t morph);
+
+// Vertex spacing of a tessellated chunk mesh: the tessellator emits one
+// vertex per walk cell, so the mean edge length snaps to a power-of-two
+// subdivision of `cellSize` (the chunk cube's side). 0 when the mesh has no
+// edges.
+float meshVertexSpacing(const Geometry& geom, float cellSize);
+
+// Fill Vertex::morph for one ladder level. The coarser level is approximated
+// the way decimateVertexCluster builds it: interior vertices weld to the
+// average of their cell on a world-aligned grid of twice this mesh's vertex
+// spacing (estimated from the mean edge length, snapped to cellSize / 2^n),
+// and vertices within one spacing of the chunk boundary stay exact (delta 0)
+// so seams never open while a chunk morphs. The coarsest level
+// (level >= maxLevel) has nothing to morph to and is cleared.
+void computeGeomorphTargets(Geometry& geom,
+                            const BoundingCube& chunkBounds,
+                            int level,
+                            int maxLevel);
+
+// ── Quadric-error simplification ──
+// Error-driven alternative to decimateVertexCluster for building coarser
+// ladder levels: greedy edge collapse ordered by the Garland-Heckbert quadric
+// error (sum of squared distances to the planes of the original faces merged
+// into a vertex). Vertices within `borderStrip` of the chunk's AABB boundary
+// and vertices on open edges are locked exactly like the clustering path's
+// border slots, so seams stay watertight against any neighbour level.
+// Collapses that would flip a face or make the mesh non-manifold are skipped.
+//
+// Stops when the mesh reaches `targetTriangles` or when the cheapest
+// remaining collapse costs more than `maxError` (either bound may be 0 =
+// unused, not both). `maxError` is a distance in world units, compared with
+// the square root of the collapse's quadric error: the summed squared
+// distances from the new position to every original face plane merged into
+// it. It therefore also bounds the distance to any single one of those
+// planes. Keeps no shared state, so the ladders of
+// different chunks can be simplified concurrently on the generation pool.
+//
+// Returns true and fills `out` when at least one collapse happened and a
+// triangle survives; false (out untouched) otherwise.
+struct QuadricSimplifyParams {
+    uint32_t targetTriangles = 0;
+    float maxError = 0.0f;
+    float borderStrip = 0.0f;
+};
+
+bool simplifyQuadric(const Geometry& in,
+                     const QuadricSimplifyParams& params,
+                     const BoundingCube& chunkBounds,
+                     Geometry& out);
@@ -2,7 +2,9 @@
 #include <memory>
 #include <atomic>
 #include <thread>
+#include <mutex>
 #include "../math/BrushMode.hpp"
+#include "OctreePager.hpp"
 #include "NodeOperationResult.hpp"
 #include "OctreeNodeCubeSerialized.hpp"
 #include <cmath>
@@ -20,11 +22,12 @@
 #include "OctreeNode.hpp"
 #include "IteratorHandler.hpp"
 #include "../sdf/SDF.hpp"
+#include "SurfaceNets.hpp"
 #include "../math/BrushMode.hpp"
 
 // Read guard for Octree::treeMutex. iterate* can nest (an iterate handler may
-// re-enter the octree, e.g. LocalScene::requestModel3D calls iterateTriangles
-// from inside an iterateFlat handler), and std::shared_mutex is not recursive,
+// re-enter the octree, e.g. LocalScene::requestModel3DBatch calls
+// iterateTriangles inside readLocked), and std::shared_mutex is not recursive,
 // so only the OUTERMOST iterate acquires the lock; inner ones (same thread)
 // piggyback on the outer read. apply takes the exclusive path (it is the only
 // writer) and is never re-entered from an iterate handler.
@@ -39,10 +42,52 @@ public:
     OctreeSharedLock(const OctreeSharedLock&) = delete;
     OctreeSharedLock& operator=(const OctreeSharedLock&) = delete;
 private:
+    friend class OctreeExclusiveLock;
     static inline thread_local int depth_ = 0;
     std::shared_mutex &m_;
 };
 
+// Write guard (apply, pager page-in/out). Counts as the outermost read for
+// this thread, so lookups made while writing (findCell, ladderPath while the
+// pager restores a subtree inside apply) do not self-deadlock.
+class OctreeExclusiveLock {
+public:
+    explicit OctreeExclusiveLock(std::shared_mutex &m) : m_(m), owns_(true) {
+        m_.lock();
+        ++OctreeSharedLock::depth_;
+    }
+    // Takes the lock only when nobody holds it (owns() tells).
+    OctreeExclusiveLock(std::shared_mutex &m, std::try_to_lock_t) : m_(m), owns_(m_.try_lock()) {
+        if (owns_) ++OctreeSharedLock::depth_;
+    }
+    ~OctreeExclusiveLock() {
+        if (!owns_) return;
+        --OctreeSharedLock::depth_;
+        m_.unlock();
+    }
+    bool owns() const { return owns_; }
+    OctreeExclusiveLock(const OctreeExclusiveLock&) = delete;
+    OctreeExclusiveLock& operator=(const OctreeExclusiveLock&) = delete;
+private:
+    std::shared_mutex &m_;
+    bool owns_;
+};
+
+// With a pager attached, every page unit an iterate walk reaches counts as
+// a use (LRU), and a paged-out stub asks for its subtree back. The walk
+// itself sees the stub this time.
+static Octree::IterateHandler pagedHandler(OctreePager * pager, const Octree::IterateHandler &handler) {
+    if(pager == nullptr) {
+        return handler;
+    }
+    return [pager, &handler](const Octree &tree, OctreeNodeData &params) {
+        if(params.node != nullptr && OctreePager::isPageUnit(params.node)) {
+            pager->touch(params.node, params.cube);
+        }
+        return handler(tree, params);
+    };
+}
+
 
 //      6-----7
 //     /|    /|
@@ -62,6 +107,46 @@ static uint8_t lodForCellSize(float nodeLength, float chunkSize) {
     return static_cast<uint8_t>(std::max(1, levelsAboveFrontier + 1));
 }
 
+// Surface-Nets edge tables over SDF_EDGES: the edges crossed for each 8-bit
+// corner sign mask (bit i = corner i negative), each edge's axis and corner
+// side on the two other axes (u, v as in iterateTriangles' edgeAxes), and
+// the edge at a given (axis, u side, v side).
+struct SurfaceEdgeTables {
+    uint16_t crossings[256];
+    int axis[12];
+    int sideU[12];
+    int sideV[12];
+    int edgeOf[3][2][2];
+
+    SurfaceEdgeTables() {
+        for(int e = 0; e < 12; ++e) {
+            const glm::ivec3 &c0 = CUBE_CORNERS[SDF_EDGES[e].x];
+            const glm::ivec3 &c1 = CUBE_CORNERS[SDF_EDGES[e].y];
+            const int a = c0.x != c1.x ? 0 : (c0.y != c1.y ? 1 : 2);
+            const int u = a == 0 ? 1 : 0;
+            const int v = a == 2 ? 1 : 2;
+            axis[e] = a;
+            sideU[e] = c0[u];
+            sideV[e] = c0[v];
+            edgeOf[a][c0[u]][c0[v]] = e;
+        }
+        for(int mask = 0; mask < 256; ++mask) {
+            uint16_t crossed = 0;
+            for(int e = 0; e < 12; ++e) {
+                if(((mask >> SDF_EDGES[e].x) & 1) != ((mask >> SDF_EDGES[e].y) & 1)) {
+                    crossed |= uint16_t(1u << e);
+                }
+            }
+            crossings[mask] = crossed;
+        }
+    }
+};
+
+static const SurfaceEdgeTables &surfaceEdgeTables() {
+    static const SurfaceEdgeTables tables;
+    return tables;
+}
+
 static std::vector<glm::ivec4> TESSELATION_ORDERS;
 static std::vector<glm::ivec2> TESSELATION_EDGES;
 static bool initialized = false;
@@ -81,7 +166,7 @@ static void initialize() {
 }
 Octree::Octree(const BoundingCube &minCube, float chunkSize_) : BoundingCube(minCube), allocator(new OctreeAllocator()) {
     this->chunkSize = chunkSize_;
-	this->root = allocator->allocate()->init(glm::vec3(minCube.getCenter()));
+	this->root = allocator->allocate()->init(minCube);
     this->shapeCounter = std::make_shared<std::atomic<int>>(0);
     this->prunedEmptyNodes = 0;
     this->prunedSolidNodes = 0;
@@ -116,9 +201,9 @@ bool Octree::intersect(const Ray& ray, glm::vec3& outPos) const {
     if (!ray.intersects(*this, &tNear, &tFar))
         return false;
 
-    struct Entry { OctreeNode* node; BoundingCube cube; float tNear; };
+    struct Entry { OctreeNode* node; OctreeCellKey key; float tNear; };
     std::vector<Entry> stack;
-    stack.push_back({root, *this, tNear});
+    stack.push_back({root, OctreeCellKey(), tNear});
 
     float bestT = tFar;
     bool found = false;
@@ -132,7 +217,7 @@ bool Octree::intersect(const Ray& ray, glm::vec3& outPos) const {
         if (e.node->isLeaf()) {
             if (e.node->getType() == SpaceType::Surface) {
                 float tn, tf;
-                if (ray.intersects(e.cube, &tn, &tf) && tn < bestT) {
+                if (ray.intersects(e.key.cube(*this), &tn, &tf) && tn < bestT) {
                     bestT = tn;
                     found = true;
                 }
@@ -148,7 +233,7 @@ bool Octree::intersect(const Ray& ray, glm::vec3& outPos) const {
         for (int i = 0; i < 8; ++i) {
             OctreeNode* child = block->get(i, *allocator);
             if (!child) continue;
-            BoundingCube childCube = e.cube.getChild(i);
+            const BoundingCube childCube = e.key.child(i).cube(*this);
             float tn, tf;
             if (ray.intersects(childCube, &tn, &tf) && tf >= 0.0f && tn < bestT) {
                 children.push_back({i, tn});
@@ -160,7 +245,7 @@ bool Octree::intersect(const Ray& ray, glm::vec3& outPos) const {
         for (int i = static_cast<int>(children.size()) - 1; i >= 0; --i) {
             int idx = children[i].idx;
             OctreeNode* child = block->get(idx, *allocator);
-            stack.push_back({child, e.cube.getChild(idx), children[i].tNear});
+            stack.push_back({child, e.key.child(idx), children[i].tNear});
         }
     }
 
@@ -177,7 +262,7 @@ bool Octree::intersect(const Ray& ray, glm::vec3& outPos) const {
 OctreeNodeLevel Octree::getNodeAt(const glm::vec3 &pos, int level, bool simplification) const{
     OctreeNode * candidate = root;
     OctreeNode* node = candidate;
-    BoundingCube cube = *this;
+    OctreeCellKey key;
     uint currentLevel = 0;
 	if(!contains(pos)) {
 		return OctreeNodeLevel(NULL, 0);
@@ -186,8 +271,8 @@ OctreeNodeLevel Octree::getNodeAt(const glm::vec3 &pos, int level, bool simplifi
         if (simplification && node->getLod() == 1u) {
             break;
         }
-        int i = getNodeIndex(pos, cube);
-        cube = cube.getChild(i);
+        int i = getNodeIndex(pos, key.cube(*this));
+        key = key.child(i);
         ChildBlock * block = node->getBlock(*allocator);
         candidate = block != NULL ? block->get(i, *allocator) : NULL;
         if(candidate != NULL) {
@@ -201,7 +286,7 @@ OctreeNodeLevel Octree::getNodeAt(const glm::vec3 &pos, int level, bool simplifi
 OctreeNode* Octree::getNodeAt(const glm::vec3 &pos, bool simplification) const {
     OctreeNode * candidate = root;
     OctreeNode* node = candidate;
-    BoundingCube cube = *this;
+    OctreeCellKey key;
 	if(!contains(pos)) {
 		return NULL;
 	}
@@ -209,8 +294,8 @@ OctreeNode* Octree::getNodeAt(const glm::vec3 &pos, bool simplification) const {
         if (simplification && node->getLod() == 1u) {
             break;
         }
-        int i = getNodeIndex(pos, cube);
-        cube = cube.getChild(i);
+        int i = getNodeIndex(pos, key.cube(*this));
+        key = key.child(i);
         ChildBlock * block = node->getBlock(*allocator);
         candidate = block != NULL ? block->get(i, *allocator) : NULL;
         if(candidate != NULL) {
@@ -220,44 +305,65 @@ OctreeNode* Octree::getNodeAt(const glm::vec3 &pos, bool simplification) const {
     return node;
 }
 
+OctreeNodeLevel Octree::getNodeAt(const OctreeCellKey &key, bool simplification) const {
+    OctreeNode * node = root;
+    uint8_t depth = 0;
+    while (node != NULL && depth < key.level) {
+        if (simplification && node->getLod() == 1u) {
+            break;
+        }
+        ChildBlock * block = node->getBlock(*allocator);
+        OctreeNode * child = block != NULL ? block->get(key.pathIndex(depth), *allocator) : NULL;
+        if (child == NULL) {
+            break;
+        }
+        node = child;
+        ++depth;
+    }
+    return OctreeNodeLevel(node, depth);
+}
+
 float Octree::getSdfAt(const glm::vec3 &pos) {
     OctreeNode * candidate = root;
     OctreeNode * node = candidate;
-    BoundingCube candidateCube = *this;
-    BoundingCube nodeCube = candidateCube;
+    OctreeCellKey candidateKey;
+    OctreeCellKey nodeKey;
 
 	if(!contains(pos)) {
 		return INFINITY;
 	}
     while (candidate) {
         node = candidate;
-        nodeCube = candidateCube;
-        int i = getNodeIndex(pos, candidateCube);
-        candidateCube = nodeCube.getChild(i);
+        nodeKey = candidateKey;
+        int i = getNodeIndex(pos, nodeKey.cube(*this));
+        candidateKey = nodeKey.child(i);
         ChildBlock * block = node->getBlock(*allocator);
         candidate = block != NULL ? block->get(i, *allocator) : NULL;
     }
 
     if(node) {
-        return SDF::interpolate(node->sdf, pos, nodeCube);
+        float corners[8];
+        node->getSDF(corners);
+        return SDF::interpolate(corners, pos, nodeKey.cube(*this));
     }
     return INFINITY;
 }
 
 void Octree::iterateTriangles(
         OctreeNode * from,
-            const BoundingCube &fromCube,
-            int fromLevel,
+            const OctreeCellKey &fromKey,
             OctreeNodeTriangleHandler &func,
-            ThreadContext * context,
             int targetLod) const {
-    (void)fromLevel;
     OctreeSharedLock lock(treeMutex);
+    if(pager != nullptr && from != NULL) {
+        pager->touchRegion(from, fromKey.cube(*this), targetLod);
+    }
 
     struct EdgeCell {
         OctreeNode *node = NULL;
-        BoundingCube cube;
-        int level = 0;
+        BoundingCube cube;  // == key.cube(*this)
+        OctreeCellKey key;
+        const Vertex *vertex = NULL;  // decoded once by a dense brick
 
         // A cell is "surface at the walk's resolution": either a frontier
         // simplified cell (targetLod == 0 — legacy full-walk mode) or a ladder
@@ -272,31 +378,53 @@ void Octree::iterateTriangles(
         }
     };
 
-    // Anchor for the upper-traversal cache: findCellAt climbs from a cached
-    // ancestor of this cell (via context->parentOf) instead of the root. The
-    // parent links (and their child indices) are registered/seeded by the tree
-    // traversal (IteratorHandler), so they are NOT stored inside the nodes.
-    EdgeCell hint;
-
-    // Cache for the parent-chain rebuild below. The chain (and therefore its
-    // reversed node/index arrays) depends ONLY on hint.node, never on the
-    // queried position, so we rebuild it at most once per distinct anchor and
-    // reuse it across findCellAt calls. This avoids O(depth) repeated
-    // parentOf hash-map lookups on every findCellAt invocation.
-    static constexpr int MAX_CHAIN = 64;
-    OctreeNode *cachedChainNode = NULL;
-    OctreeNode *cachedChainNodes[MAX_CHAIN] = {};
-    int cachedChainIndices[MAX_CHAIN] = {};
-    int cachedChainLen = 0;
-    bool cachedChainOk = false;
-
-    // Per-node cache for findCellAt. The 12 edges and their segments repeatedly
-    // query identical quadrant/face sample positions (the same edge midpoint is
-    // sampled by both collectBreaks and emitSegment, and adjacent edges share
-    // corners), so memoizing avoids repeated O(depth) descents. findCellAt is a
-    // pure function of pos (the octree/context are constant during this call),
-    // so cached results are reusable and bit-identical to a fresh lookup.
-    tsl::robin_map<glm::vec3, EdgeCell> cellCache;
+    // The walk's resolution: a node is a cell (descent stops at it) when it is
+    // a leaf or its lod reaches targetLod; otherwise its children refine it.
+    auto isCell = [targetLod](const OctreeNode *node) {
+        return node->isLeaf() ||
+            !((targetLod == 0) ? (node->getLod() == 0u) : (node->getLod() > targetLod));
+    };
+
+    // Neighbour table of a cell: entry (dx,dy,dz) of the 3x3x3 neighbourhood
+    // holds what covers the same-size neighbour at that offset — the
+    // neighbour cell itself, a coarser cell containing it, or a same-size node
+    // refined by finer cells (resolved along an edge by collectLine). node ==
+    // NULL means no data there (outside the root, missing child). Tables are
+    // built top-down from the parent's table, so emission never climbs or
+    // re-descends the tree and needs no hash map.
+    struct NeighbourRef {
+        OctreeNode *node = NULL;
+        OctreeCellKey key;
+    };
+    struct Neighbourhood {
+        NeighbourRef cells[27];
+    };
+    auto neighbourIndex = [](int dx, int dy, int dz) {
+        return (dx + 1) * 9 + (dy + 1) * 3 + (dz + 1);
+    };
+
+    // Offset d of child c lands in the parent's entry floor((c + d) / 2), at
+    // child (c + d) mod 2 of it.
+    auto childNeighbourhood = [&](const Neighbourhood &parent, int childIndex, Neighbourhood &out) {
+        const int c[3] = { (childIndex >> 2) & 1, (childIndex >> 1) & 1, childIndex & 1 };
+        for(int dx = -1; dx <= 1; ++dx) {
+            for(int dy = -1; dy <= 1; ++dy) {
+                for(int dz = -1; dz <= 1; ++dz) {
+                    const int q[3] = { c[0] + dx + 2, c[1] + dy + 2, c[2] + dz + 2 };
+                    const NeighbourRef &p = parent.cells[neighbourIndex(q[0] / 2 - 1, q[1] / 2 - 1, q[2] / 2 - 1)];
+                    NeighbourRef &n = out.cells[neighbourIndex(dx, dy, dz)];
+                    if(p.node == NULL || isCell(p.node)) {
+                        n = p;
+                        continue;
+                    }
+                    const int sub = ((q[0] & 1) << 2) | ((q[1] & 1) << 1) | (q[2] & 1);
+                    ChildBlock *block = p.node->getBlock(*allocator);
+                    n.node = block != NULL ? block->get(sub, *allocator) : NULL;
+                    n.key = p.key.child(sub);
+                }
+            }
+        }
+    };
 
     // Bit-pattern key for a vertex position (exact, no hashing of floats).
     auto vertexKey = [](const glm::vec3 &p) {
@@ -336,122 +464,8 @@ void Octree::iterateTriangles(
         }
     };
 
-    auto findCellAt = [this, context, &hint, &fromCube, &cachedChainNode, &cachedChainNodes,
-            &cachedChainIndices, &cachedChainLen, &cachedChainOk, &cellCache, targetLod](const glm::vec3 &pos) {
-        auto cacheHit = cellCache.find(pos);
-        if(cacheHit != cellCache.end()) {
-            return cacheHit->second;
-        }
-        EdgeCell result;
-        if(root == NULL || !contains(pos)) {
-            cellCache[pos] = result;
-            return result;
-        }
-
-        // Default to the original root descent; the cache below only shortens it.
-        OctreeNode *startNode = root;
-        BoundingCube startCube = *this;
-
-        if(context != NULL && hint.node != NULL) {
-            // Rebuild root-consistent cubes by replaying the parent-index chain
-            // stored in context->parentOf. This is essential: the cached cubes
-            // (fromCube / data.cube) drift from the root-descended cubes by
-            // floating-point error, and at a chunk-boundary face that drift
-            // flips getNodeIndex, sending descent into the wrong (cross-chunk)
-            // cell and leaving holes. Rebuilding from *this keeps every cube
-            // bit-identical to a root descent, so the result matches HEAD.
-            // Rebuild root-consistent cubes without any heap allocation: the
-            // parent chain is a single path from root, so we store it in fixed
-            // stack arrays and pick the deepest ancestor whose cube still
-            // contains pos. (Depth is bounded; MAX_CHAIN matches the
-            // collectBreaks recursion cap. If exceeded we simply fall through to
-            // the default root descent below — correct, just less optimal.)
-            // The chain is cached in cachedChain* and only rebuilt when the
-            // anchor (hint.node) changes; it is independent of pos.
-            if(hint.node != cachedChainNode) {
-                cachedChainNode = hint.node;
-                cachedChainLen = 0;
-                cachedChainOk = true;
-                OctreeNode *n = hint.node;
-                while(n != NULL && n != root) {
-                    auto it = context->parentOf.find(n);
-                    if(it == context->parentOf.end()) { cachedChainOk = false; break; }
-                    if(cachedChainLen >= MAX_CHAIN) { cachedChainOk = false; break; }
-                    cachedChainNodes[cachedChainLen] = n;
-                    cachedChainIndices[cachedChainLen] = it->second.second;
-                    ++cachedChainLen;
-                    n = it->second.first;
-                }
-                if(!(cachedChainOk && n == root && cachedChainLen > 0)) {
-                    cachedChainOk = false;
-                } else {
-                    for(int i = 0; i < cachedChainLen / 2; ++i) {
-                        std::swap(cachedChainNodes[i], cachedChainNodes[cachedChainLen - 1 - i]);
-                        std::swap(cachedChainIndices[i], cachedChainIndices[cachedChainLen - 1 - i]);
-                    }
-                }
-            }
-            if(cachedChainOk) {
-                BoundingCube c = *this;
-                int chosen = -1;
-                for(int i = 0; i < cachedChainLen; ++i) {
-                    c = c.getChild(cachedChainIndices[i]);
-                    if(c.contains(pos)) chosen = i;
-                    else break;
-                }
-                if(chosen >= 0) {
-                    BoundingCube cc = *this;
-                    for(int i = 0; i <= chosen; ++i) cc = cc.getChild(cachedChainIndices[i]);
-                    startNode = cachedChainNodes[chosen];
-                    startCube = cc;
-                }
-            }
-        }
-
-        OctreeNode *node = startNode;
-        BoundingCube cube = startCube;
-
-        while(node != NULL && !node->isLeaf() &&
-              ((targetLod == 0) ? (node->getLod() == 0u) : (node->getLod() > targetLod))) {
-            ChildBlock *block = node->getBlock(*allocator);
-            if(block == NULL) {
-                node = NULL;
-                break;
-            }
-
-            int childIndex = getNodeIndex(pos, cube);
-            OctreeNode *child = block->get(childIndex, *allocator);
-            if(child == NULL) {
-                node = NULL;
-                break;
-            }
-
-            cube = cube.getChild(childIndex);
-            node = child;
-        }
-
-        if(node != NULL) {
-            result.node = node;
-            result.cube = cube;
-        }
-        if(result.node != NULL) {
-            hint = result;
-        }
-        cellCache[pos] = result;
-        return result;
-    };
-
-    // Anchor the cache on `from`: its ancestor chain (seeded by the traversal,
-    // rooted at the world root) is already in context->parentOf, so neighbor
-    // lookups climb from a cached parent instead of the root.
-    hint.node = from;
-    hint.cube = fromCube;
-
-    auto sideCoordinate = [](float value, int side) {
-        return std::nextafter(value, side < 0 ? -std::numeric_limits<float>::infinity()
-                                               :  std::numeric_limits<float>::infinity());
-    };
-
+    // Side of the edge line (on u and v) of each of the four cells around it,
+    // in polygon order.
     auto quadrantSigns = [](int axis, int quadrant, int &su, int &sv) {
         static const int SIGNS[3][4][2] = {
             {{-1, -1}, {-1,  1}, { 1,  1}, { 1, -1}},
@@ -470,102 +484,6 @@ void Octree::iterateTriangles(
         return p;
     };
 
-    auto edgeSamplePoint = [&](const EdgeSpan &edge, float t, int quadrant) {
-        int su, sv;
-        quadrantSigns(edge.axis, quadrant, su, sv);
-
-        glm::vec3 p(0.0f);
-        p[edge.axis] = t;
-        p[edge.u] = sideCoordinate(edge.fixedU, su);
-        p[edge.v] = sideCoordinate(edge.fixedV, sv);
-        return p;
-    };
-
-    auto addBreak = [](std::vector<float> &breaks, float value, float start, float end, float eps) {
-        if(value <= start + eps || value >= end - eps) {
-            return false;
-        }
-        for(float existing : breaks) {
-            if(std::fabs(existing - value) <= eps) {
-                return false;
-            }
-        }
-        breaks.push_back(value);
-        return true;
-    };
-
-    auto sortUnique = [](std::vector<float> &values, float eps) {
-        std::sort(values.begin(), values.end());
-        values.erase(std::unique(values.begin(), values.end(), [eps](float a, float b) {
-            return std::fabs(a - b) <= eps;
-        }), values.end());
-    };
-
-    // Fixed-buffer variant of addBreak/sortUnique to avoid a heap allocation in
-    // the per-recursion localBreaks (its size is bounded; see collectBreaks).
-    auto addToBuffer = [](float *buf, int &count, int cap, float value, float start, float end, float eps) {
-        if(value <= start + eps || value >= end - eps) {
-            return false;
-        }
-        for(int k = 0; k < count; ++k) {
-            if(std::fabs(buf[k] - value) <= eps) {
-                return false;
-            }
-        }
-        if(count < cap) {
-            buf[count++] = value;
-            return true;
-        }
-        return false;
-    };
-
-    auto sortUniqueBuf = [](float *buf, int &count, float eps) {
-        std::sort(buf, buf + count);
-        float *newEnd = std::unique(buf, buf + count, [eps](float a, float b) {
-            return std::fabs(a - b) <= eps;
-        });
-        count = int(newEnd - buf);
-    };
-
-    std::function<void(const EdgeSpan&, float, float, std::vector<float>&, int)> collectBreaks;
-    collectBreaks = [&](const EdgeSpan &edge, float start, float end, std::vector<float> &breaks, int depth) {
-        if(depth > 64 || end - start <= edge.eps * 2.0f) {
-            return;
-        }
-
-        float mid = start + (end - start) * 0.5f;
-        // Bounded stack buffer: at most the 4 quadrant cells contribute their cube
-        // min/max faces on the axis (<=8 interior values) plus start/end (<=10
-        // total), so 32 has wide margin and avoids a per-recursion heap alloc.
-        float localBreaks[32];
-        int localCount = 0;
-        localBreaks[localCount++] = start;
-        localBreaks[localCount++] = end;
-
-        for(int q = 0; q < 4; ++q) {
-            EdgeCell cell = findCellAt(edgeSamplePoint(edge, mid, q));
-            if(cell.node == NULL) {
-                continue;
-            }
-
-            addToBuffer(localBreaks, localCount, 32, cell.cube.getMin()[edge.axis], start, end, edge.eps);
-            addToBuffer(localBreaks, localCount, 32, cell.cube.getMax()[edge.axis], start, end, edge.eps);
-        }
-
-        sortUniqueBuf(localBreaks, localCount, edge.eps);
-        if(localCount <= 2) {
-            return;
-        }
-
-        for(int i = 1; i + 1 < localCount; ++i) {
-            addBreak(breaks, localBreaks[i], start, end, edge.eps);
-        }
-
-        for(int i = 1; i < localCount; ++i) {
-            collectBreaks(edge, localBreaks[i - 1], localBreaks[i], breaks, depth + 1);
-        }
-    };
-
     auto makeEdgeSpan = [&](int edgeIndex, const BoundingCube &cellCube) {
         glm::ivec2 edgeCorners = SDF_EDGES[edgeIndex];
         glm::vec3 p0 = cellCube.getCorner(edgeCorners.x);
@@ -589,16 +507,12 @@ void Octree::iterateTriangles(
         return edge;
     };
 
+    // Finest cell first, then lowest position.
     auto ownerLess = [](const EdgeCell &a, const EdgeCell &b) {
-        float al = a.cube.getLengthX();
-        float bl = b.cube.getLengthX();
-        if(al != bl) return al < bl;
-
-        glm::vec3 amin = a.cube.getMin();
-        glm::vec3 bmin = b.cube.getMin();
-        if(amin.x != bmin.x) return amin.x < bmin.x;
-        if(amin.y != bmin.y) return amin.y < bmin.y;
-        if(amin.z != bmin.z) return amin.z < bmin.z;
+        if(a.key.level != b.key.level) return a.key.level > b.key.level;
+        if(a.key.x != b.key.x) return a.key.x < b.key.x;
+        if(a.key.y != b.key.y) return a.key.y < b.key.y;
+        if(a.key.z != b.key.z) return a.key.z < b.key.z;
         return std::less<OctreeNode*>()(a.node, b.node);
     };
 
@@ -626,13 +540,9 @@ void Octree::iterateTriangles(
         func.handle(*a, *b, *c);
     };
 
-    auto emitSegment = [&](const EdgeSpan &edge, float start, float end) {
-        float mid = start + (end - start) * 0.5f;
-        EdgeCell cells[4];
-        for(int q = 0; q < 4; ++q) {
-            cells[q] = findCellAt(edgeSamplePoint(edge, mid, q));
-        }
-
+    // One segment [start, end] of an edge line with the four cells around it
+    // (quadrantSigns order; node == NULL where there is no data).
+    auto emitSegment = [&](const EdgeSpan &edge, float start, float end, const EdgeCell cells[4]) {
         // Owner = positionally-smallest SURFACE ring cell. Non-surface
         // quadrants (Empty/Solid space, cells of a neighboring LOD level)
         // never own the segment, but they do NOT abort it either: the segment
@@ -653,22 +563,23 @@ void Octree::iterateTriangles(
         }
 
         // Attribute the segment to the walk root `from`: it is emitted iff
-        // its owner cell lies inside from's cube. For per-leaf walks (legacy
-        // targetLod < 0 mode) this is exactly the old `owner == from` test —
-        // adjacent cells' centers are never inside from's cube — so behavior
-        // is unchanged. For per-node ladder walks (from = a chunk or ladder
-        // ancestor, targetLod >= 0) the owner is a finer lod cell inside
-        // from's cube, so the WHOLE node tessellates in ONE call instead of
-        // one call per frontier leaf, and boundary segments are emitted by
-        // exactly the node that contains their owner.
-        if(owner.node != from && !fromCube.contains(owner.cube.getCenter())) {
+        // its owner cell lies inside from's cell (key ancestry, exact). For
+        // per-leaf walks (legacy targetLod == 0 mode) this is exactly the old
+        // `owner == from` test. For per-node ladder walks (from = a chunk or
+        // ladder ancestor, targetLod >= 1) the owner is a finer lod cell
+        // inside from's cell, so the WHOLE node tessellates in ONE call
+        // instead of one call per frontier leaf, and boundary segments are
+        // emitted by exactly the node that contains their owner.
+        if(owner.node != from && !fromKey.contains(owner.key)) {
             return;
         }
 
         glm::vec3 p0 = edgePoint(edge, start);
         glm::vec3 p1 = edgePoint(edge, end);
-        float d0 = SDF::interpolate(owner.node->sdf, p0, owner.cube);
-        float d1 = SDF::interpolate(owner.node->sdf, p1, owner.cube);
+        float ownerSDF[8];
+        owner.node->getSDF(ownerSDF);
+        float d0 = SDF::interpolate(ownerSDF, p0, owner.cube);
+        float d1 = SDF::interpolate(ownerSDF, p1, owner.cube);
         if((d0 < 0.0f) == (d1 < 0.0f)) {
             return;
         }
@@ -678,15 +589,19 @@ void Octree::iterateTriangles(
         // heap allocation. Non-surface quadrants are skipped: their nodes
         // have no usable vertex and their cells never tessellate.
         EdgeCell plist[4];
+        glm::vec3 ppos[4];
         int pcount = 0;
         for(int q = 0; q < 4; ++q) {
             if(!cells[q].isSurface(targetLod)) {
                 continue;
             }
+            const glm::vec3 position = cells[q].vertex != NULL ? cells[q].vertex->position
+                                                               : cells[q].node->getPosition(cells[q].cube);
             bool duplicate = (pcount > 0)
                 && (plist[pcount - 1].node == cells[q].node
-                    || samePosition(plist[pcount - 1].node->vertex.position, cells[q].node->vertex.position, edge.eps));
+                    || samePosition(ppos[pcount - 1], position, edge.eps));
             if(!duplicate && pcount < 4) {
+                ppos[pcount] = position;
                 plist[pcount++] = cells[q];
             }
         }
@@ -694,7 +609,7 @@ void Octree::iterateTriangles(
         if(pcount > 1) {
             const EdgeCell &first = plist[0];
             const EdgeCell &last = plist[pcount - 1];
-            if(first.node == last.node || samePosition(first.node->vertex.position, last.node->vertex.position, edge.eps)) {
+            if(first.node == last.node || samePosition(ppos[0], ppos[pcount - 1], edge.eps)) {
                 --pcount;
             }
         }
@@ -702,7 +617,7 @@ void Octree::iterateTriangles(
         for(int i = 0; i < pcount; ++i) {
             for(int j = i + 1; j < pcount; ++j) {
                 if(plist[i].node == plist[j].node
-                    || samePosition(plist[i].node->vertex.position, plist[j].node->vertex.position, edge.eps)) {
+                    || samePosition(ppos[i], ppos[j], edge.eps)) {
                     return;
                 }
             }
@@ -729,18 +644,27 @@ void Octree::iterateTriangles(
         // d0 > 0: empty at the lower-axis end → surface faces the negative axis → reverse.
         // Reversal keeps plist[0] (= `from`) as the pivot so Tesselator UV is consistent.
         const bool solidAtStart = (d0 < 0.0f);
+        if(pcount < 3) {
+            return;
+        }
+        // Materialise the cell vertices once per polygon (the compact node
+        // layout derives normals from the SDF).
+        Vertex pv[4];
+        for(int k = 0; k < pcount; ++k) {
+            pv[k] = plist[k].vertex != NULL ? *plist[k].vertex : plist[k].node->getVertex(plist[k].cube);
+        }
         if(pcount == 3) {
             if(solidAtStart)
-                emitTriangle(&plist[0].node->vertex, &plist[1].node->vertex, &plist[2].node->vertex, edge.eps);
+                emitTriangle(&pv[0], &pv[1], &pv[2], edge.eps);
             else
-                emitTriangle(&plist[0].node->vertex, &plist[2].node->vertex, &plist[1].node->vertex, edge.eps);
+                emitTriangle(&pv[0], &pv[2], &pv[1], edge.eps);
         } else if(pcount == 4) {
             if(solidAtStart) {
-                emitTriangle(&plist[0].node->vertex, &plist[1].node->vertex, &plist[2].node->vertex, edge.eps);
-                emitTriangle(&plist[0].node->vertex, &plist[2].node->vertex, &plist[3].node->vertex, edge.eps);
+                emitTriangle(&pv[0], &pv[1], &pv[2], edge.eps);
+                emitTriangle(&pv[0], &pv[2], &pv[3], edge.eps);
             } else {
-                emitTriangle(&plist[0].node->vertex, &plist[3].node->vertex, &plist[2].node->vertex, edge.eps);
-                emitTriangle(&plist[0].node->vertex, &plist[2].node->vertex, &plist[1].node->vertex, edge.eps);
+                emitTriangle(&pv[0], &pv[3], &pv[2], edge.eps);
+                emitTriangle(&pv[0], &pv[2], &pv[1], edge.eps);
             }
         }
     };
@@ -754,104 +678,511 @@ void Octree::iterateTriangles(
         return;
     }
 
-    // Scan ONE Surface-Nets cell: walk the 12 edges of cellCube with the
-    // cell's OWN stored corner samples and emit the segments whose owner
-    // (finest of the four quadrant cells at the walk's resolution) lies
-    // inside the outer from-cube. Cells one level finer/coarser stay out of
-    // the segment via the isSurface(targetLod) quadrant filter; the polygon
-    // then closes with the remaining surface quadrants instead of leaving
-    // open edges at LOD band boundaries and shape faces.
-    auto scanCell = [&](OctreeNode *cellNode, const BoundingCube &cellCube) {
+    // Pass 1 — adjacency: collect every cell the walk scans together with its
+    // neighbour table. from's own table is derived down the root path.
+    struct SurfaceCell {
+        OctreeNode *node;
+        OctreeCellKey key;
+        Neighbourhood neighbours;
+        uint16_t brickEdges;  // edges emitted by the dense brick pass instead
+    };
+    std::vector<SurfaceCell> surfaceCells;
+    const SurfaceEdgeTables &edgeTables = surfaceEdgeTables();
+
+    // Dense bricks: a subtree refined uniformly down to the walk's resolution
+    // (every cell present at the same depth, 4^3..16^3 cells) is flattened
+    // into arrays. Its interior edge lines are emitted in one table-driven
+    // sweep. Crossings come from per-cell sign masks and each vertex is
+    // decoded once. Lines on the brick's faces touch cells outside it and stay
+    // with the sparse walker below. Both paths feed the same emitSegment with
+    // the same cells and extents, so seams match the sparse output exactly.
+    static constexpr int BRICK_MIN_DEPTH = 2;
+    static constexpr int BRICK_MAX_DEPTH = 4;
+    struct BrickCell {
+        OctreeNode *node = NULL;
+        OctreeCellKey key;
+        uint16_t crossings = 0;  // scanned cells only (lod == targetLod)
+        int vertex = -1;         // into brickVertices, surface cells only
+    };
+    struct Brick {
+        OctreeCellKey key;
+        int depth = 0;
+        int size = 0;                  // cells per axis
+        std::vector<BrickCell> cells;  // (x * size + y) * size + z
+    };
+    std::vector<Brick> bricks;
+    std::vector<Vertex> brickVertices;
+
+    // Depth below `node` at which every path reaches a cell, or -1 when the
+    // subtree is not uniform (missing child, mixed depths) within
+    // BRICK_MAX_DEPTH. Memoized per walk: walkLadder asks at every level it
+    // descends through, and each answer is built from the children's, so
+    // every node is evaluated once instead of once per ancestor.
+    std::unordered_map<const OctreeNode*, int> uniformDepths;
+    std::function<int(OctreeNode*)> uniformDepth;
+    uniformDepth = [&](OctreeNode *node) {
+        if(isCell(node)) return 0;
+        auto it = uniformDepths.find(node);
+        if(it != uniformDepths.end()) return it->second;
+        int depth = -1;
+        if(ChildBlock *block = node->getBlock(*allocator)) {
+            for(int i = 0; i < 8; ++i) {
+                OctreeNode *child = block->get(i, *allocator);
+                const int d = child != NULL ? uniformDepth(child) : -1;
+                if(d < 0 || (i > 0 && d != depth)) {
+                    depth = -1;
+                    break;
+                }
+                depth = d;
+            }
+        }
+        const int result = depth >= 0 && depth < BRICK_MAX_DEPTH ? depth + 1 : -1;
+        uniformDepths.emplace(node, result);
+        return result;
+    };
+
+    auto brickLocal = [](const Brick &brick, const OctreeCellKey &key, int axis) {
+        const int shift = key.level - brick.key.level;
+        const uint32_t c = axis == 0 ? key.x : (axis == 1 ? key.y : key.z);
+        const uint32_t b = axis == 0 ? brick.key.x : (axis == 1 ? brick.key.y : brick.key.z);
+        return static_cast<int>(c - (b << shift));
+    };
+
+    // Cells on the brick's faces still go through the sparse walker for their
+    // face lines, so only subtrees touching a face carry neighbour tables.
+    std::function<void(Brick&, OctreeNode*, const OctreeCellKey&, const Neighbourhood*)> fillBrick;
+    fillBrick = [&](Brick &brick, OctreeNode *node, const OctreeCellKey &key, const Neighbourhood *neighbours) {
+        if(isCell(node)) {
+            const int local[3] = { brickLocal(brick, key, 0), brickLocal(brick, key, 1), brickLocal(brick, key, 2) };
+            BrickCell &cell = brick.cells[(size_t(local[0]) * brick.size + local[1]) * brick.size + local[2]];
+            cell.node = node;
+            cell.key = key;
+            if(node->getLod() == targetLod) {
+                float sdf[8];
+                node->getSDF(sdf);
+                int signs = 0;
+                for(int i = 0; i < 8; ++i) signs |= (sdf[i] < 0.0f ? 1 : 0) << i;
+                cell.crossings = edgeTables.crossings[signs];
+                if(neighbours != NULL) {
+                    uint16_t interior = 0;
+                    for(int e = 0; e < 12; ++e) {
+                        int u, v;
+                        edgeAxes(edgeTables.axis[e], u, v);
+                        const int lu = local[u] + edgeTables.sideU[e];
+                        const int lv = local[v] + edgeTables.sideV[e];
+                        if(lu > 0 && lu < brick.size && lv > 0 && lv < brick.size) {
+                            interior |= uint16_t(1u << e);
+                        }
+                    }
+                    surfaceCells.push_back(SurfaceCell{node, key, *neighbours, interior});
+                }
+                if(node->getType() == SpaceType::Surface) {
+                    cell.vertex = static_cast<int>(brickVertices.size());
+                    brickVertices.push_back(node->getVertex(key.cube(*this)));
+                }
+            }
+            return;
+        }
+        ChildBlock *block = node->getBlock(*allocator);
+        const int depth = key.level + 1 - brick.key.level;
+        const int last = (1 << depth) - 1;
+        for(int i = 0; i < 8; ++i) {
+            const OctreeCellKey childKey = key.child(i);
+            const Neighbourhood *childTable = NULL;
+            Neighbourhood childNeighbours;
+            if(neighbours != NULL) {
+                for(int a = 0; a < 3; ++a) {
+                    const int c = brickLocal(brick, childKey, a);
+                    if(c == 0 || c == last) {
+                        childNeighbourhood(*neighbours, i, childNeighbours);
+                        childTable = &childNeighbours;
+                        break;
+                    }
+                }
+            }
+            fillBrick(brick, block->get(i, *allocator), childKey, childTable);
+        }
+    };
+
+    Neighbourhood fromNeighbours;
+    {
+        Neighbourhood path;
+        path.cells[neighbourIndex(0, 0, 0)] = NeighbourRef{root, OctreeCellKey()};
+        for(uint8_t depth = 0; depth < fromKey.level; ++depth) {
+            Neighbourhood next;
+            childNeighbourhood(path, fromKey.pathIndex(depth), next);
+            path = next;
+        }
+        fromNeighbours = path;
+        fromNeighbours.cells[neighbourIndex(0, 0, 0)] = NeighbourRef{from, fromKey};
+    }
+
+    if(targetLod == 0) {
+        // Legacy mode: `from` IS the frontier cell.
+        surfaceCells.push_back(SurfaceCell{from, fromKey, fromNeighbours, 0});
+    } else {
+        // Ladder mode: the level-k mesh is the AGGREGATE of the cells at lod k
+        // inside the anchor (each cell's own stored corner samples, which are
+        // correct). A single Surface-Nets cell over the whole anchor would miss
+        // interior surface detail — the anchor's own corners have no zero
+        // crossing when the surface is inside it — so every level emits its own
+        // cell resolution (cell size frontierCell*2^k), which is what the
+        // distance bands consume.
+        std::function<void(OctreeNode*, const OctreeCellKey&, const Neighbourhood&)> walkLadder;
+        walkLadder = [&](OctreeNode *node, const OctreeCellKey &key, const Neighbourhood &neighbours) {
+            if(node == NULL) return;
+            // Stored (+1-shifted → uint8) lod: 0 = unset, 1 = frontier, k+1 = parent.
+            const uint8_t lod = node->getLod();
+            // A leaf is part of the level-k mesh ONLY when its stored lod IS k.
+            // Coarse leaves carry their true interpolated lod (60^3→2, 120^3→3…),
+            // so they never leak into finer levels (mixed-resolution L0 meshes,
+            // duplicate triangles across levels) and their own level still
+            // tessellates them.
+            if(node->isLeaf()) {
+                if(lod == targetLod) {
+                    surfaceCells.push_back(SurfaceCell{node, key, neighbours, 0});
+                }
+                return;
+            }
+            if(lod == targetLod) {
+                surfaceCells.push_back(SurfaceCell{node, key, neighbours, 0});
+                return;
+            }
+            if(lod < targetLod) {
+                return;
+            }
+            const int depth = denseBricks ? uniformDepth(node) : -1;
+            if(depth >= BRICK_MIN_DEPTH) {
+                bricks.emplace_back();
+                Brick &brick = bricks.back();
+                brick.key = key;
+                brick.depth = depth;
+                brick.size = 1 << depth;
+                brick.cells.resize(size_t(brick.size) * brick.size * brick.size);
+                fillBrick(brick, node, key, &neighbours);
+                return;
+            }
+            ChildBlock *block = node->getBlock(*allocator);
+            if(block == NULL) {
+                return;
+            }
+            for(uint i = 0; i < 8; ++i) {
+                OctreeNode *child = block->get(i, *allocator);
+                if(child != NULL) {
+                    Neighbourhood childNeighbours;
+                    childNeighbourhood(neighbours, i, childNeighbours);
+                    walkLadder(child, key.child(i), childNeighbours);
+                }
+            }
+        };
+        walkLadder(from, fromKey, fromNeighbours);
+    }
+
+    // Pass 2 — emission. For each crossed edge of a cell, the four regions
+    // around the edge line come straight from the table; a region refined
+    // below the walk's resolution contributes its cells along the line. The
+    // segment breaks are the union of those cells' extents, in integer units
+    // of the finest cell involved, so no float break merging is needed.
+    struct LineCell {
+        OctreeNode *node;
+        OctreeCellKey key;
+        bool whole;  // no data: covers the whole edge
+    };
+
+    // Cells of a refined region along the edge line, ascending along `axis`.
+    // Such a region has the scanned cell's size and the line runs along one
+    // of its edges, so only the two children touching that edge are followed
+    // (sideBits fixes their u/v child bits at every level).
+    std::function<void(OctreeNode*, const OctreeCellKey&, int, int, std::vector<LineCell>&)> collectLine;
+    collectLine = [&](OctreeNode *node, const OctreeCellKey &key, int sideBits, int axis, std::vector<LineCell> &out) {
+        ChildBlock *block = node->getBlock(*allocator);
+        if(block == NULL) {
+            out.push_back(LineCell{NULL, key, false});
+            return;
+        }
+        for(int t = 0; t < 2; ++t) {
+            const int childIndex = sideBits | (t << (2 - axis));
+            const OctreeCellKey childKey = key.child(childIndex);
+            OctreeNode *child = block->get(childIndex, *allocator);
+            if(child == NULL || isCell(child)) {
+                out.push_back(LineCell{child, childKey, false});
+            } else {
+                collectLine(child, childKey, sideBits, axis, out);
+            }
+        }
+    };
+
+    auto keyCoord = [](const OctreeCellKey &key, int axis) {
+        return axis == 0 ? key.x : (axis == 1 ? key.y : key.z);
+    };
+
+    std::vector<LineCell> line[4];
+    std::vector<uint64_t> breaks;
+    for(const SurfaceCell &cell : surfaceCells) {
+        const BoundingCube cellCube = cell.key.cube(*this);
+        float cellSDF[8];
+        cell.node->getSDF(cellSDF);
         for(int edgeIndex = 0; edgeIndex < 12; ++edgeIndex) {
+            if(cell.brickEdges & (1u << edgeIndex)) {
+                continue;
+            }
             glm::ivec2 edgeCorners = SDF_EDGES[edgeIndex];
-            bool sign0 = cellNode->sdf[edgeCorners.x] < 0.0f;
-            bool sign1 = cellNode->sdf[edgeCorners.y] < 0.0f;
+            bool sign0 = cellSDF[edgeCorners.x] < 0.0f;
+            bool sign1 = cellSDF[edgeCorners.y] < 0.0f;
 
             if(sign0 == sign1) {
                 continue;
             }
 
-            EdgeSpan edge = makeEdgeSpan(edgeIndex, cellCube);
-            if(edge.end - edge.start <= edge.eps * 2.0f) {
-                continue;
+            const EdgeSpan edge = makeEdgeSpan(edgeIndex, cellCube);
+            const glm::ivec3 &corner = CUBE_CORNERS[edgeCorners.x];
+
+            uint8_t finest = cell.key.level;
+            for(int q = 0; q < 4; ++q) {
+                int su, sv;
+                quadrantSigns(edge.axis, q, su, sv);
+                int d[3] = {0, 0, 0};
+                d[edge.u] = corner[edge.u] + (su > 0 ? 0 : -1);
+                d[edge.v] = corner[edge.v] + (sv > 0 ? 0 : -1);
+                const NeighbourRef &region = cell.neighbours.cells[neighbourIndex(d[0], d[1], d[2])];
+                line[q].clear();
+                if(region.node == NULL) {
+                    line[q].push_back(LineCell{NULL, region.key, true});
+                } else if(isCell(region.node)) {
+                    line[q].push_back(LineCell{region.node, region.key, false});
+                } else {
+                    const int sideBits = ((corner[edge.u] - d[edge.u]) << (2 - edge.u))
+                                       | ((corner[edge.v] - d[edge.v]) << (2 - edge.v));
+                    collectLine(region.node, region.key, sideBits, edge.axis, line[q]);
+                }
+                for(const LineCell &lc : line[q]) {
+                    if(!lc.whole) finest = std::max(finest, lc.key.level);
+                }
             }
 
-            std::vector<float> breaks;
-            breaks.reserve(64);
-            breaks.push_back(edge.start);
-            breaks.push_back(edge.end);
-            collectBreaks(edge, edge.start, edge.end, breaks, 0);
-            sortUnique(breaks, edge.eps);
-
+            const int cellShift = finest - cell.key.level;
+            const uint64_t edgeLo = uint64_t(keyCoord(cell.key, edge.axis)) << cellShift;
+            const uint64_t edgeHi = uint64_t(keyCoord(cell.key, edge.axis) + 1u) << cellShift;
+            auto extent = [&](const LineCell &lc, uint64_t &lo, uint64_t &hi) {
+                if(lc.whole) {
+                    lo = edgeLo;
+                    hi = edgeHi;
+                    return;
+                }
+                const int shift = finest - lc.key.level;
+                lo = std::max(edgeLo, uint64_t(keyCoord(lc.key, edge.axis)) << shift);
+                hi = std::min(edgeHi, uint64_t(keyCoord(lc.key, edge.axis) + 1u) << shift);
+            };
+
+            breaks.clear();
+            breaks.push_back(edgeLo);
+            breaks.push_back(edgeHi);
+            for(int q = 0; q < 4; ++q) {
+                for(const LineCell &lc : line[q]) {
+                    uint64_t lo, hi;
+                    extent(lc, lo, hi);
+                    if(lo > edgeLo && lo < edgeHi) breaks.push_back(lo);
+                    if(hi > edgeLo && hi < edgeHi) breaks.push_back(hi);
+                }
+            }
+            std::sort(breaks.begin(), breaks.end());
+            breaks.erase(std::unique(breaks.begin(), breaks.end()), breaks.end());
+
+            // Same arithmetic as OctreeCellKey::cube, so segment ends coincide
+            // with the cells' own faces.
+            const float unit = std::ldexp(getLengthX(), -static_cast<int>(finest));
+            const float origin = getMin()[edge.axis];
+            size_t cursor[4] = {0, 0, 0, 0};
             for(size_t i = 1; i < breaks.size(); ++i) {
-                if(breaks[i] - breaks[i - 1] > edge.eps * 2.0f) {
-                    emitSegment(edge, breaks[i - 1], breaks[i]);
+                EdgeCell cells[4];
+                for(int q = 0; q < 4; ++q) {
+                    uint64_t lo, hi;
+                    while(cursor[q] + 1 < line[q].size()) {
+                        extent(line[q][cursor[q]], lo, hi);
+                        if(hi > breaks[i - 1]) break;
+                        ++cursor[q];
+                    }
+                    const LineCell &lc = line[q][cursor[q]];
+                    if(lc.node != NULL) {
+                        cells[q].node = lc.node;
+                        cells[q].key = lc.key;
+                        cells[q].cube = lc.key.cube(*this);
+                    }
                 }
+                emitSegment(edge,
+                            origin + static_cast<float>(breaks[i - 1]) * unit,
+                            origin + static_cast<float>(breaks[i]) * unit,
+                            cells);
             }
         }
-    };
-
-    if(targetLod == 0) {
-        // Legacy mode: `from` IS the frontier cell.
-        scanCell(from, fromCube);
-        return;
     }
 
-    // Ladder mode: the level-k mesh is the AGGREGATE of the cells at lod k
-    // inside the anchor (each cell's own stored corner samples, which are
-    // correct). A single Surface-Nets cell over the whole anchor would miss
-    // interior surface detail — the anchor's own corners have no zero
-    // crossing when the surface is inside it — so every level emits its own
-    // cell resolution (cell size frontierCell*2^k), which is what the
-    // distance bands consume.
-    std::function<void(OctreeNode*, const BoundingCube&)> walkLadder;
-    walkLadder = [&](OctreeNode *node, const BoundingCube &cube) {
-        if(node == NULL) return;
-        // Stored (+1-shifted → uint8) lod: 0 = unset, 1 = frontier, k+1 = parent.
-        const uint8_t lod = node->getLod();
-        // A leaf is part of the level-k mesh ONLY when its stored lod IS k.
-        // Coarse leaves carry their true interpolated lod (60^3→2, 120^3→3…),
-        // so they never leak into finer levels (mixed-resolution L0 meshes,
-        // duplicate triangles across levels) and their own level still
-        // tessellates them.
-        if(node->isLeaf()) {
-            if(lod == targetLod) {
-                scanCell(node, cube);
+    // Brick interiors: every line strictly inside the brick on u and v, one
+    // cell long. A line is emitted when one of its four cells is scanned and
+    // crosses on it — the sparse rule, evaluated once per line instead of
+    // once per flanking cell.
+    for(const Brick &brick : bricks) {
+        const int n = brick.size;
+        const float unit = std::ldexp(getLengthX(), -static_cast<int>(brick.key.level + brick.depth));
+        for(int axis = 0; axis < 3; ++axis) {
+            int u, v;
+            edgeAxes(axis, u, v);
+            const float origin = getMin()[axis];
+            for(int lu = 1; lu < n; ++lu) {
+                for(int lv = 1; lv < n; ++lv) {
+                    for(int t = 0; t < n; ++t) {
+                        const BrickCell *ring[4];
+                        int first = -1;
+                        int firstEdge = 0;
+                        for(int q = 0; q < 4; ++q) {
+                            int su, sv;
+                            quadrantSigns(axis, q, su, sv);
+                            int c[3];
+                            c[axis] = t;
+                            c[u] = lu + (su > 0 ? 0 : -1);
+                            c[v] = lv + (sv > 0 ? 0 : -1);
+                            ring[q] = &brick.cells[(size_t(c[0]) * n + c[1]) * n + c[2]];
+                            const int e = edgeTables.edgeOf[axis][lu - c[u]][lv - c[v]];
+                            if(first < 0 && (ring[q]->crossings & (1u << e))) {
+                                first = q;
+                                firstEdge = e;
+                            }
+                        }
+                        if(first < 0) {
+                            continue;
+                        }
+                        EdgeCell cells[4];
+                        for(int q = 0; q < 4; ++q) {
+                            cells[q].node = ring[q]->node;
+                            cells[q].key = ring[q]->key;
+                            cells[q].cube = ring[q]->key.cube(*this);
+                            cells[q].vertex = ring[q]->vertex >= 0 ? &brickVertices[ring[q]->vertex] : NULL;
+                        }
+                        const EdgeSpan edge = makeEdgeSpan(firstEdge, cells[first].cube);
+                        const uint32_t lo = keyCoord(cells[first].key, axis);
+                        emitSegment(edge,
+                                    origin + static_cast<float>(lo) * unit,
+                                    origin + static_cast<float>(lo + 1u) * unit,
+                                    cells);
+                    }
+                }
             }
-            return;
-        }
-        if(lod == targetLod) {
-            scanCell(node, cube);
-            return;
-        }
-        if(lod < targetLod) {
-            return;
         }
+    }
+}
+
+bool Octree::buildSurfaceNetsBrick(OctreeNode * from, const OctreeCellKey &fromKey, int targetLod, SurfaceNetsBrick &brick) const {
+    OctreeSharedLock lock(treeMutex);
+    if(from == NULL || root == NULL || targetLod <= 0) {
+        return false;
+    }
+    if(pager != nullptr) {
+        pager->touchRegion(from, fromKey.cube(*this), targetLod);
+    }
+
+    // Same resolution predicates as iterateTriangles (ladder mode only).
+    auto isCell = [targetLod](const OctreeNode *node) {
+        return node->isLeaf() || node->getLod() <= targetLod;
+    };
+    auto isSurface = [targetLod](const OctreeNode *node) {
+        return node->getType() == SpaceType::Surface && node->getLod() == targetLod;
+    };
+
+    std::function<int(OctreeNode*, int)> uniformDepth;
+    uniformDepth = [&](OctreeNode *node, int budget) {
+        if(isCell(node)) return 0;
+        if(budget == 0) return -1;
         ChildBlock *block = node->getBlock(*allocator);
-        if(block == NULL) {
-            return;
-        }
-        for(uint i = 0; i < 8; ++i) {
+        if(block == NULL) return -1;
+        int depth = -1;
+        for(int i = 0; i < 8; ++i) {
             OctreeNode *child = block->get(i, *allocator);
-            if(child != NULL) {
-                walkLadder(child, cube.getChild(i));
-            }
+            if(child == NULL) return -1;
+            const int d = uniformDepth(child, budget - 1);
+            if(d < 0 || (depth >= 0 && d != depth)) return -1;
+            depth = d;
         }
+        return depth + 1;
     };
-    walkLadder(from, fromCube);
-}
+    const int depth = uniformDepth(from, SurfaceNets::BRICK_MAX_DEPTH);
+    if(depth < SurfaceNets::BRICK_MIN_DEPTH) {
+        return false;
+    }
 
+    const uint8_t level = static_cast<uint8_t>(fromKey.level + depth);
+    const int64_t side = int64_t(1) << level;
+    brick.cells = 1u << depth;
+    brick.base[0] = int32_t(int64_t(fromKey.x) << depth) - 1;
+    brick.base[1] = int32_t(int64_t(fromKey.y) << depth) - 1;
+    brick.base[2] = int32_t(int64_t(fromKey.z) << depth) - 1;
+    brick.rootMin = getMin();
+    brick.cellSize = std::ldexp(getLengthX(), -static_cast<int>(level));
+    brick.invCellSize = 1.0f / brick.cellSize;
+    brick.eps = getLengthX() * 1e-6f;
+    const uint32_t g = brick.gridSize();
+    brick.grid.assign(size_t(g) * g * g, SurfaceNetsCell());
+
+    // Every grid cell must be a cell of exactly this size or carry no surface
+    // at the walk's resolution: a coarser surface cell or a finer refinement
+    // (apron included) changes the polygons, so such chunks stay on the CPU.
+    for(uint32_t gx = 0; gx < g; ++gx) {
+        for(uint32_t gy = 0; gy < g; ++gy) {
+            for(uint32_t gz = 0; gz < g; ++gz) {
+                const int64_t kx = int64_t(brick.base[0]) + gx;
+                const int64_t ky = int64_t(brick.base[1]) + gy;
+                const int64_t kz = int64_t(brick.base[2]) + gz;
+                if(kx < 0 || ky < 0 || kz < 0 || kx >= side || ky >= side || kz >= side) {
+                    continue;
+                }
+                const OctreeCellKey key(uint32_t(kx), uint32_t(ky), uint32_t(kz), level);
+                OctreeNode *node = root;
+                uint8_t d = 0;
+                while(node != NULL && d < level && !isCell(node)) {
+                    ChildBlock *block = node->getBlock(*allocator);
+                    node = block != NULL ? block->get(key.pathIndex(d), *allocator) : NULL;
+                    ++d;
+                }
+                if(node == NULL) {
+                    continue;
+                }
+                if(d < level) {
+                    if(isSurface(node)) return false;
+                    continue;
+                }
+                if(!isCell(node)) {
+                    return false;
+                }
+                SurfaceNetsCell &cell = brick.grid[(size_t(gx) * g + gy) * g + gz];
+                node->getSDF(cell.sdf);
+                uint32_t signs = 0;
+                for(int i = 0; i < 8; ++i) signs |= (cell.sdf[i] < 0.0f ? 1u : 0u) << i;
+                cell.flags = signs;
+                if(isSurface(node)) {
+                    const glm::vec3 position = node->getPosition(key.cube(*this));
+                    const glm::vec3 hsv = node->getHSV();
+                    for(int k = 0; k < 3; ++k) {
+                        cell.position[k] = position[k];
+                        cell.hsv[k] = hsv[k];
+                    }
+                    cell.brushIndex = node->getBrush();
+                    cell.flags |= SurfaceNets::FLAG_SURFACE;
+                }
+            }
+        }
+    }
+    surfaceNetsCount(brick);
+    return true;
+}
 
 
-OctreeNodeLevel Octree::fetch(glm::vec3 pos, uint level, bool simplification, ThreadContext * context) const {
-    glm::vec4 key = glm::vec4(pos, level);
-    if(context->nodeCache.find(key) != context->nodeCache.end()) {
-        return context->nodeCache[key];
-    } else {
-        OctreeNodeLevel nodeLevel = getNodeAt(pos, level, simplification);
-        context->nodeCache[key] = nodeLevel;
-        return nodeLevel;
+OctreeNodeLevel Octree::fetch(const OctreeCellKey &key, bool simplification, ThreadContext * context) const {
+    auto it = context->nodeCache.find(key);
+    if(it != context->nodeCache.end()) {
+        return it->second;
     }
+    OctreeNodeLevel nodeLevel = getNodeAt(key, simplification);
+    context->nodeCache.try_emplace(key, nodeLevel);
+    return nodeLevel;
 }
 
 
@@ -865,7 +1196,7 @@ void Octree::expand(const ShapeArgs &args) {
         setLength(getLengthX()*2);
 
         OctreeNode* oldRoot = root;
-        OctreeNode* newRoot = allocator->allocate()->init(getCenter());
+        OctreeNode* newRoot = allocator->allocate()->init(*this);
         ChildBlock* newBlock = newRoot->allocate(*allocator)->init();
 
         if (oldRoot != NULL) {
@@ -891,24 +1222,24 @@ void Octree::expand(const ShapeArgs &args) {
     }
 }
 
-float Octree::evaluateSDF(const ShapeArgs &args, tsl::robin_map<glm::vec3, float> *cache, glm::vec3 p) const {
-    auto it = cache->find(p);
+float Octree::evaluateSDF(const ShapeArgs &args, tsl::robin_map<OctreeCellKey, float, OctreeCellKeyHasher> *cache, const OctreeCellKey &point, const glm::vec3 &p) const {
+    auto it = cache->find(point);
     if (it != cache->end())
         return it->second;
 
     float d = args.function.distance(p);
-    cache->try_emplace(p, d);
+    cache->try_emplace(point, d);
     return d;
 }
 
 void Octree::buildShapeSDF(const ShapeArgs &args, OctreeNodeFrame &frame, NodeOperationResult &r, NodeOperationResult children[8], ThreadContext * threadContext, bool force) const {
     const glm::vec3 cubeMin = frame.cube.getMin();
     const glm::vec3 cubeLength = frame.cube.getLength();
-    tsl::robin_map<glm::vec3, float> * shapeSdfCache = &threadContext->shapeSdfCache;
+    tsl::robin_map<OctreeCellKey, float, OctreeCellKeyHasher> * shapeSdfCache = &threadContext->shapeSdfCache;
 
     if(r.isLeaf || force) {
         for (uint i = 0; i < 8; ++i) {
-            r.shapeSDF[i] = evaluateSDF(args, shapeSdfCache, cubeMin + cubeLength * Octree::getShift(i));
+            r.shapeSDF[i] = evaluateSDF(args, shapeSdfCache, frame.key.corner(i), cubeMin + cubeLength * Octree::getShift(i));
         }
         r.shapeType = SDF::eval(r.shapeSDF);
     } else {
@@ -953,7 +1284,7 @@ void Octree::apply(
         OctreeNodeDataHandler &updateHandler,
         OctreeNodeDataHandler &deleteHandler
     ) {
-    std::unique_lock<std::shared_mutex> writeLock(treeMutex);
+    OctreeExclusiveLock writeLock(treeMutex);
     threadsCreated = 0;
     prunedEmptyNodes = 0;
     prunedSolidNodes = 0;
@@ -961,10 +1292,23 @@ void Octree::apply(
     *shapeCounter = 0;
     ShapeArgs args = ShapeArgs(operation, function, painter, model, simplifier, minSize);	
     expand(args);
-    OctreeNodeFrame frame = OctreeNodeFrame(root, NULL, *this, root ? root->getType() : SpaceType::Empty, 0, root ? root->sdf : nullptr, DISCARD_BRUSH_INDEX, *this);
+    const ReachTest reaches = [&function](const BoundingCube &cube) {
+        return function.check(cube) != ContainmentType::Disjoint;
+    };
+    if(pager != nullptr) {
+        // The shape must see real subtrees: restore every paged-out chunk the
+        // brush reaches (same reach test as shape's descent) before walking.
+        pager->pageInLocked(reaches);
+    }
+    float rootSDF[8];
+    if(root) root->getSDF(rootSDF);
+    OctreeNodeFrame frame = OctreeNodeFrame(root, NULL, *this, OctreeCellKey(), root ? root->getType() : SpaceType::Empty, root ? rootSDF : nullptr, DISCARD_BRUSH_INDEX, *this);
     ThreadContext localChunkContext = ThreadContext(*this);
     NodeOperationResult r = NodeOperationResult();
     shape(r, frame, args, &localChunkContext, updateHandler, deleteHandler);
+    if(editListener) {
+        editListener(reaches);
+    }
 }
 
 int Octree::heightRootToChunk(int lod, float minSize) const {
@@ -1002,11 +1346,11 @@ void Octree::shapeChildren(
         node->getChildren(*allocator, children);
     }
 
-    int brushIndex = node ? node->vertex.brushIndex : frame.brushIndex;
+    int brushIndex = node ? node->getBrush() : frame.brushIndex;
     if(brushIndex == DISCARD_BRUSH_INDEX) {
         brushIndex = frame.brushIndex;
     }
-    glm::vec3 hsv = node ? node->vertex.hsv : frame.hsv;
+    glm::vec3 hsv = node ? node->getHSV() : frame.hsv;
 
     // Iterate nodes and submit threaded children to the pool
     for (uint i = 0; i < 8; ++i) {
@@ -1016,24 +1360,25 @@ void Octree::shapeChildren(
         }
 
         float childSDF[8] = {INFINITY,INFINITY,INFINITY,INFINITY,INFINITY,INFINITY,INFINITY,INFINITY};
-        int childBrushIndex = child ? child->vertex.brushIndex : brushIndex;
+        int childBrushIndex = child ? child->getBrush() : brushIndex;
         if(childBrushIndex == DISCARD_BRUSH_INDEX) {
             childBrushIndex = brushIndex;
         }
-        glm::vec3 childHsv = child ? child->vertex.hsv : hsv;
+        glm::vec3 childHsv = child ? child->getHSV() : hsv;
 
         if(child != NULL) {
-            SDF::copySDF(child->sdf, childSDF);
+            child->getSDF(childSDF);
         } else {
             SDF::getChildSDF(frame.sdf, i, childSDF);
         }
-        BoundingCube childCube = frame.cube.getChild(i);
+        const OctreeCellKey childKey = frame.key.child(i);
+        BoundingCube childCube = childKey.cube(*this);
         OctreeNodeFrame childFrame = OctreeNodeFrame(
             child,
             child ? frame.iteratedNode : frame.node,
             childCube,
+            childKey,
             child ? child->getType() : frame.type,
-            frame.level + 1,
             childSDF,
             childBrushIndex,
             isChildChunk ? childCube : frame.chunkCube
@@ -1076,12 +1421,23 @@ void Octree::shape(
     const float nodeLength = frame.cube.getLengthX();
     const bool isShapeLeaf = nodeLength <= args.minSize;
     const bool isNodeLeaf = r.node == NULL || r.node->isLeaf();
-    r.brushIndex = r.node ? r.node->vertex.brushIndex : frame.brushIndex;
-    r.brushHsv = r.node ? r.node->vertex.hsv : frame.hsv;
+    r.brushIndex = r.node ? r.node->getBrush() : frame.brushIndex;
+    r.brushHsv = r.node ? r.node->getHSV() : frame.hsv;
     r.isChunk = isChunkNode(nodeLength);
     r.isLeaf = isShapeLeaf && isNodeLeaf;
     r.selectedLod = r.isLeaf ? 1 : 0;
 
+    if(r.node != NULL && r.node->isPagedOut()) {
+        // A stub whose page could not be restored (OctreePager): the edit
+        // passes it by instead of overwriting the subtree kept on disk.
+        r.shapeType = SpaceType::Empty;
+        r.resultType = frame.type;
+        SDF::copySDF(frame.sdf, r.resultSDF);
+        r.selectedLod = r.node->getLod();
+        r.selectedChunkLod = r.node->getChunkLod();
+        return;
+    }
+
     NodeOperationResult children[8] = { 
         NodeOperationResult(), NodeOperationResult(), 
         NodeOperationResult(), NodeOperationResult(),
@@ -1092,7 +1448,7 @@ void Octree::shape(
     buildShapeSDF(args, frame, r, children, threadContext, true);
 
     const glm::vec3 center = frame.cube.getCenter();
-    float shapeSdfCenter = evaluateSDF(args, &threadContext->shapeSdfCache, center);
+    float shapeSdfCenter = evaluateSDF(args, &threadContext->shapeSdfCache, frame.key.center(), center);
 
     bool process = true;
     bool processed = false;
@@ -1158,11 +1514,11 @@ void Octree::shape(
             // node center to keep the paint stroke visible in solid regions.
             if(args.operation->paintsVertices() && r.shapeType != SpaceType::Empty) {
                 if(r.node != NULL) {
-                    r.brushIndex = args.painter.paint(r.node->vertex);
-                    r.brushHsv = args.painter.paintHSV(r.node->vertex);
-                    r.node->vertex.normal = SDF::getNormalFromPosition(r.resultSDF, frame.cube, r.node->vertex.position);
-                    r.node->vertex.hsv = r.brushHsv;
-                    r.node->vertex.brushIndex = r.brushIndex;
+                    const Vertex nodeVertex = r.node->getVertex(frame.cube);
+                    r.brushIndex = args.painter.paint(nodeVertex);
+                    r.brushHsv = args.painter.paintHSV(nodeVertex);
+                    r.node->setNormal(SDF::getNormalFromPosition(r.resultSDF, frame.cube, nodeVertex.position));
+                    r.node->setHSV(r.brushHsv);
                     r.node->setBrush(r.brushIndex);
                 }
             }
@@ -1222,11 +1578,11 @@ void Octree::shape(
                 // pruned here still leave a visible stroke.
                 if(args.operation->paintsVertices() && r.shapeType != SpaceType::Empty) {
                     if(r.node != NULL) {
-                        r.brushIndex = args.painter.paint(r.node->vertex);
-                        r.brushHsv = args.painter.paintHSV(r.node->vertex);
-                        r.node->vertex.normal = SDF::getNormalFromPosition(r.resultSDF, frame.cube, r.node->vertex.position);
-                        r.node->vertex.hsv = r.brushHsv;
-                        r.node->vertex.brushIndex = r.brushIndex;
+                        const Vertex nodeVertex = r.node->getVertex(frame.cube);
+                        r.brushIndex = args.painter.paint(nodeVertex);
+                        r.brushHsv = args.painter.paintHSV(nodeVertex);
+                        r.node->setNormal(SDF::getNormalFromPosition(r.resultSDF, frame.cube, nodeVertex.position));
+                        r.node->setHSV(r.brushHsv);
                         r.node->setBrush(r.brushIndex);
                     }
                 }
@@ -1300,19 +1656,23 @@ void Octree::shape(
         if(r.resultType == SpaceType::Surface) {
             // Create nodes for surface results if they don't exist
             if(r.node == NULL) {
-                r.node = allocator->allocate()->init(Vertex(frame.cube.getCenter()));   
+                r.node = allocator->allocate()->init(frame.cube);   
             }
 
             if(r.node!= NULL) {
-                r.node->vertex.position = SDF::getPosition(r.resultSDF, frame.cube);
-                r.node->vertex.normal = SDF::getNormalFromPosition(r.resultSDF, frame.cube, r.node->vertex.position);
+                Vertex surfaceVertex(SDF::getPosition(r.resultSDF, frame.cube));
+                surfaceVertex.brushIndex = r.node->getBrush();
+                surfaceVertex.hsv = r.node->getHSV();
+                surfaceVertex.normal = SDF::getNormalFromPosition(r.resultSDF, frame.cube, surfaceVertex.position);
+                r.node->setPosition(surfaceVertex.position, frame.cube);
+                r.node->setNormal(surfaceVertex.normal);
                 // Simplification & Painting
                 if(r.isLeaf) {
                     if(r.shapeType != SpaceType::Empty) {
-                        r.brushIndex = args.painter.paint(r.node->vertex);
-                        r.node->vertex.hsv = args.painter.paintHSV(r.node->vertex);
-                        r.node->vertex.brushIndex = r.brushIndex;
-                        r.brushHsv = r.node->vertex.hsv;
+                        r.brushIndex = args.painter.paint(surfaceVertex);
+                        r.node->setHSV(args.painter.paintHSV(surfaceVertex));
+                        r.node->setBrush(r.brushIndex);
+                        r.brushHsv = r.node->getHSV();
                     }  
                 } else if(process) {
                     // Only manage children when this cell actually descended
@@ -1325,7 +1685,7 @@ void Octree::shape(
                     // combined corners written below.
                     if (!r.isChunk) {
                         // Pass frame.chunkCube so the simplifier can guard chunk borders.
-                        SimplificationResult simplificationResult = args.simplifier.simplify(frame.cube, r.resultSDF, children, frame.chunkCube);
+                        SimplificationResult simplificationResult = args.simplifier.simplify(*this, frame.key, r.resultSDF, children, frame.chunkCube);
                         r.selectedLod = simplificationResult.isSimplified ? 1 : 0;
                     }
                     OctreeNode * childNodes[8] = {NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL};
@@ -1340,8 +1700,7 @@ void Octree::shape(
                             // all-zero-or-negative corners — may return without
                             // one; never store a NULL slot for them.
                             if(childNode == NULL) {
-                                BoundingCube childCube = frame.cube.getChild(i);
-                                childNode = allocator->allocate()->init(Vertex(childCube.getCenter()));
+                                childNode = allocator->allocate()->init(frame.key.child(i).cube(*this));
                                 children[i].node = childNode;
                             }
                             childNode->setType(child.resultType);
@@ -1350,7 +1709,7 @@ void Octree::shape(
                             childNode->setBrush(r.brushIndex);
                             childNode->setChunkLod(child.selectedChunkLod);
                             childNode->setLod(child.selectedLod);
-                            childNode->vertex.hsv = child.brushHsv;
+                            childNode->setHSV(child.brushHsv);
                         }
                                                 
                         if(frame.node != NULL && childNode == r.node) {
@@ -1399,7 +1758,7 @@ void Octree::shape(
                                 if(count > bestCount) {
                                     bestCount = count;
                                     r.brushIndex = childBrush;
-                                    r.brushHsv = childNode->vertex.hsv;
+                                    r.brushHsv = childNode->getHSV();
                                 }
                             }
                         }
@@ -1419,7 +1778,7 @@ void Octree::shape(
 
 
             r.node->setBrush(r.brushIndex);
-            r.node->vertex.hsv = r.brushHsv;
+            r.node->setHSV(r.brushHsv);
           
             if(r.isChunk) {
                 r.node->setChunkLod(1);
@@ -1452,8 +1811,8 @@ void Octree::shape(
             // only cells marked Surface, and the renderer skips empty
             // geometry.
             if(r.node->getChunkLod() > 0) {
-                ++r.node->version;
-                OctreeNodeData data = OctreeNodeData(frame.level, r.node, frame.cube, nullptr);
+                r.node->bumpVersion();
+                OctreeNodeData data = OctreeNodeData(r.node, frame.key, frame.cube, nullptr);
                 r.resultType == SpaceType::Surface ? updateHandler(data) : deleteHandler(data);
             }
         }
@@ -1476,47 +1835,119 @@ void Octree::shape(
 void Octree::iterate(OctreeNodeData &data, const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler) {
     OctreeSharedLock lock(treeMutex);
 	IteratorHandler handler;
-	handler.iterate(*this, data, iterateHandler, getOrderHandler);
+	const IterateHandler paged = pagedHandler(pager, iterateHandler);
+	handler.iterate(*this, data, paged, getOrderHandler);
 }
 
 void Octree::iterate(const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler) {
     OctreeSharedLock lock(treeMutex);
-    OctreeNodeData data(0, root, *this, nullptr);
+    OctreeNodeData data(root, OctreeCellKey(), *this, nullptr);
 	IteratorHandler handler;
-	handler.iterate(*this, data, iterateHandler, getOrderHandler);
+	const IterateHandler paged = pagedHandler(pager, iterateHandler);
+	handler.iterate(*this, data, paged, getOrderHandler);
 }
 
 void Octree::iterateFlat(OctreeNodeData &data, const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler) {
     OctreeSharedLock lock(treeMutex);
     IteratorHandler handler;
-    handler.iterateFlatIn(*this, data, iterateHandler, getOrderHandler);
+    const IterateHandler paged = pagedHandler(pager, iterateHandler);
+    handler.iterateFlatIn(*this, data, paged, getOrderHandler);
 }
 
 void Octree::iterateMultiThreaded(const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler, const IterateThreadedHandler &iterateThreadedHandler) {
     OctreeSharedLock lock(treeMutex);
-    OctreeNodeData data(0, root, *this, nullptr);
+    OctreeNodeData data(root, OctreeCellKey(), *this, nullptr);
     IteratorHandler handler;
-    handler.iterateMultiThreaded(*this, data, threadPool, iterateHandler, getOrderHandler, iterateThreadedHandler);
+    const IterateHandler paged = pagedHandler(pager, iterateHandler);
+    handler.iterateMultiThreaded(*this, data, threadPool, paged, getOrderHandler, iterateThreadedHandler);
+}
+
+void Octree::ladderPath(const OctreeNodeData &target, std::vector<OctreeNodeData> &out) const {
+    OctreeSharedLock lock(treeMutex);
+    OctreeNode * node = root;
+    OctreeCellKey key;
+    // Down the target's key. Same stop rules as the former per-node
+    // requestModel3D walk: a non-Surface cell or one without a chunkLod ends
+    // the path (finer cells carry no ladder level).
+    while(node != nullptr && node->getType() == SpaceType::Surface && node->getChunkLod() > 0) {
+        out.emplace_back(node, key, key.cube(*this), nullptr);
+        if(node->isLeaf() || key.level >= target.key.level) {
+            break;
+        }
+        const int i = target.key.pathIndex(key.level);
+        OctreeNode * children[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+        node->getChildren(*allocator, children);
+        node = children[i];
+        key = key.child(i);
+    }
+}
+
+OctreeNodeData Octree::findCell(const BoundingCube &target) const {
+    OctreeSharedLock lock(treeMutex);
+    // The key in one step: lengths halve exactly per level and a cell's min
+    // corner sits on its level's grid, so rounding only absorbs float noise
+    // in the recorded cube. The walk is then by key.
+    const double levels = std::log2(double(getLengthX()) / double(target.getLengthX()));
+    const long level = std::lround(levels);
+    if(!std::isfinite(levels) || level < 0 || level > OctreeCellKey::MAX_LEVEL) {
+        return OctreeNodeData(nullptr, OctreeCellKey(), target, nullptr);
+    }
+    const double size = std::ldexp(double(getLengthX()), -int(level));
+    const double side = std::ldexp(1.0, int(level));
+    uint32_t coords[3];
+    for(int k = 0; k < 3; ++k) {
+        const double c = std::round((double(target.getMin()[k]) - double(getMin()[k])) / size);
+        if(c < 0.0 || c >= side) {
+            return OctreeNodeData(nullptr, OctreeCellKey(), target, nullptr);
+        }
+        coords[k] = uint32_t(c);
+    }
+    const OctreeCellKey key(coords[0], coords[1], coords[2], uint8_t(level));
+    const OctreeNodeLevel found = getNodeAt(key, false);
+    OctreeNode * node = found.level == key.level ? found.node : nullptr;
+    return OctreeNodeData(node, key, key.cube(*this), nullptr);
+}
+
+void Octree::readLocked(const std::function<void()> &body) const {
+    OctreeSharedLock lock(treeMutex);
+    body();
+}
+
+void Octree::writeLocked(const std::function<void()> &body) {
+    OctreeExclusiveLock lock(treeMutex);
+    body();
+}
+
+bool Octree::tryWriteLocked(const std::function<void()> &body) {
+    OctreeExclusiveLock lock(treeMutex, std::try_to_lock);
+    if (!lock.owns()) {
+        return false;
+    }
+    body();
+    return true;
 }
 
 void Octree::iterateFlat(const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler) {
     OctreeSharedLock lock(treeMutex);
-    OctreeNodeData data(0, root, *this, nullptr);
+    OctreeNodeData data(root, OctreeCellKey(), *this, nullptr);
     IteratorHandler handler;
-    handler.iterateFlatIn(*this, data, iterateHandler, getOrderHandler);
+    const IterateHandler paged = pagedHandler(pager, iterateHandler);
+    handler.iterateFlatIn(*this, data, paged, getOrderHandler);
 }
 
 void Octree::iterateParallel(OctreeNodeData &data, const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler) {
     OctreeSharedLock lock(treeMutex);
     IteratorHandler handler;
-    handler.iterateBFS(*this, data, iterateHandler, getOrderHandler);
+    const IterateHandler paged = pagedHandler(pager, iterateHandler);
+    handler.iterateBFS(*this, data, paged, getOrderHandler);
 }
 
 void Octree::iterateParallel(const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler) {
     OctreeSharedLock lock(treeMutex);
-    OctreeNodeData data(0, root, *this, nullptr);
+    OctreeNodeData data(root, OctreeCellKey(), *this, nullptr);
     IteratorHandler handler;
-    handler.iterateBFS(*this, data, iterateHandler, getOrderHandler);
+    const IterateHandler paged = pagedHandler(pager, iterateHandler);
+    handler.iterateBFS(*this, data, paged, getOrderHandler);
     //handler.iterateParallelBFS(*this, data, threadPool);
 }
 
@@ -1553,10 +1984,13 @@ void Octree::reset() {
     while (inFlightShapeOps.load() > 0) {
         std::this_thread::yield();
     }
+    if(pager != nullptr) {
+        pager->reset();
+    }
     if(root != NULL) {
         allocator->childAllocator.reset();
         allocator->nodeAllocator.reset();
-        this->root = allocator->allocate()->init(glm::vec3(getCenter()));
+        this->root = allocator->allocate()->init(*this);
     }
 }
 
@@ -1576,7 +2010,7 @@ void Octree::exportToJson(const std::string &filename) const {
             return;
         }
         file << "{";
-        const Vertex &v = node->vertex;
+        const Vertex v = node->getVertex(cube);
         file << "\"position\":[" << v.position.x << "," << v.position.y << "," << v.position.z << "],";
         file << "\"normal\":[" << v.normal.x << "," << v.normal.y << "," << v.normal.z << "],";
         file << "\"texCoord\":[" << v.texCoord.x << "," << v.texCoord.y << "],";
@@ -1672,24 +2106,25 @@ void Octree::exportToBson(const std::string &filename) const {
         }
 
         // position (array)
-        std::vector<double> pos = { node->vertex.position.x, node->vertex.position.y, node->vertex.position.z };
+        const Vertex v = node->getVertex(cube);
+        std::vector<double> pos = { v.position.x, v.position.y, v.position.z };
         std::vector<uint8_t> posArr = makeDoubleArrayDoc(pos);
         doc.push_back(0x04); appendCString(doc, "position"); doc.insert(doc.end(), posArr.begin(), posArr.end());
 
         // normal
-        std::vector<double> nrm = { node->vertex.normal.x, node->vertex.normal.y, node->vertex.normal.z };
+        std::vector<double> nrm = { v.normal.x, v.normal.y, v.normal.z };
         std::vector<uint8_t> nrmArr = makeDoubleArrayDoc(nrm);
         doc.push_back(0x04); appendCString(doc, "normal"); doc.insert(doc.end(), nrmArr.begin(), nrmArr.end());
 
         // texCoord
-        std::vector<double> tex = { node->vertex.texCoord.x, node->vertex.texCoord.y };
+        std::vector<double> tex = { v.texCoord.x, v.texCoord.y };
         std::vector<uint8_t> texArr = makeDoubleArrayDoc(tex);
         doc.push_back(0x04); appendCString(doc, "texCoord"); doc.insert(doc.end(), texArr.begin(), texArr.end());
 
         // brushIndex (int32)
-        doc.push_back(0x10); appendCString(doc, "brushIndex"); appendInt32(doc, node->vertex.brushIndex);
+        doc.push_back(0x10); appendCString(doc, "brushIndex"); appendInt32(doc, v.brushIndex);
         // hsv
-        std::vector<double> hsvArr = { node->vertex.hsv.x, node->vertex.hsv.y, node->vertex.hsv.z };
+        std::vector<double> hsvArr = { v.hsv.x, v.hsv.y, v.hsv.z };
         std::vector<uint8_t> hsvDoc = makeDoubleArrayDoc(hsvArr);
         doc.push_back(0x04); appendCString(doc, "hsv"); doc.insert(doc.end(), hsvDoc.begin(), hsvDoc.end());
 
@@ -20,6 +20,8 @@
 // (previously defined in the removed OctreeChangeHandler.hpp).
 typedef uintptr_t NodeID;
 class IteratorHandler;
+class OctreePager;
+struct SurfaceNetsBrick;
 
 
 
@@ -36,6 +38,10 @@ class Octree: public BoundingCube {
         float    cellSize = 0;  // the chunk's own cell size
         glm::vec3 boundsMin = glm::vec3(0.0f); // emitting cell's world bounds (band center + meta)
         glm::vec3 boundsMax = glm::vec3(0.0f);
+        OctreeCellKey key;      // emitting cell's key
+        // Set instead of geom when the chunk is meshed on the GPU
+        // (IndirectRenderer::addBrickSlotted).
+        std::shared_ptr<const SurfaceNetsBrick> brick;
     };
 
 
@@ -56,13 +62,25 @@ class Octree: public BoundingCube {
     int prunedSolidNodes;
     std::shared_ptr<std::atomic<int>> shapeCounter;
     std::atomic<int> inFlightShapeOps{0};
-    tsl::robin_map<glm::vec3, ThreadContext> chunks;
     ThreadPool threadPool = ThreadPool(std::thread::hardware_concurrency());
     std::mutex mutex;
     // Read/write guard for tree structure + node data. iterate* take a shared
     // (read) lock; apply takes a unique (write) lock so traversal threads never
     // walk nodes that a concurrent brush/mesh op is mutating.
     mutable std::shared_mutex treeMutex;
+    // Out-of-core paging (OctreePager.hpp), owned by the scene; null keeps
+    // the whole tree resident. Walks report chunk visits to it and apply
+    // pages back in whatever the brush reaches.
+    OctreePager * pager = nullptr;
+    // Brush reach test: true for the cells an apply may have changed.
+    using ReachTest = std::function<bool(const BoundingCube&)>;
+    // Called by apply under the write lock once the shape is done
+    // (SceneJournal.hpp records the chunks it reached). Empty = unused.
+    std::function<void(const ReachTest&)> editListener;
+    // iterateTriangles emits uniformly refined regions through dense bricks;
+    // false keeps every cell on the sparse walker. The two produce the same
+    // triangles (octreebench compares them).
+    bool denseBricks = true;
 
     Octree(const BoundingCube &minCube, float chunkSize);
     Octree();
@@ -95,21 +113,53 @@ class Octree: public BoundingCube {
     void iterateMultiThreaded(const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler, const IterateThreadedHandler &iterateThreadedHandler);
     void iterateParallel(OctreeNodeData &data, const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler);
     void iterateParallel(const IterateHandler &iterateHandler, const IterateOrderHandler &getOrderHandler);
+    // Ladder cells (Surface, chunkLod > 0) on the root path down to
+    // `target.key`, root first: the cells whose meshes cover it. The key
+    // must be relative to the current root (findCell re-keys a cell recorded
+    // before the root grew). Caller holds the read lock (readLocked) while
+    // it uses them.
+    void ladderPath(const OctreeNodeData &target, std::vector<OctreeNodeData> &out) const;
+    // The cell currently at `cube` (a cell of this grid, possibly recorded
+    // before the root grew), with its key relative to the current root and
+    // that key's cube; node == nullptr when that cell no longer exists.
+    // Caller holds the read lock (readLocked).
+    OctreeNodeData findCell(const BoundingCube &cube) const;
+    // Runs `body` under the tree read lock (nests like the iterate* walks).
+    void readLocked(const std::function<void()> &body) const;
+    // Runs `body` under the tree write lock (as apply does); reads nested in
+    // `body` on this thread piggyback on it.
+    void writeLocked(const std::function<void()> &body);
+    // writeLocked without waiting: false, `body` not run, while any walk or
+    // writer holds the tree (background work that must not stall readers).
+    bool tryWriteLocked(const std::function<void()> &body);
     bool intersect(const Ray& ray, glm::vec3& outPos) const;
     OctreeNodeLevel getNodeAt(const glm::vec3 &pos, int level, bool simplification) const;
     OctreeNode* getNodeAt(const glm::vec3 &pos, bool simplification) const;
+    // Exact lookup by cell key: follows the key's child indices from the root
+    // and returns the deepest existing node on that path.
+    OctreeNodeLevel getNodeAt(const OctreeCellKey &key, bool simplification) const;
     float getSdfAt(const glm::vec3 &pos);
-    OctreeNodeLevel fetch(glm::vec3 pos, uint level, bool simplification, ThreadContext * context) const;
+    OctreeNodeLevel fetch(const OctreeCellKey &key, bool simplification, ThreadContext * context) const;
 
+    // fromKey addresses `from` relative to the current root. Neighbours are
+    // resolved once per scanned cell into a 3x3x3 table derived top-down from
+    // the root path, so emission does no hash lookups or repeated descents.
     void iterateTriangles(OctreeNode * from,
-        const BoundingCube &fromCube,
-        int fromLevel,
+        const OctreeCellKey &fromKey,
         OctreeNodeTriangleHandler &func,
-        ThreadContext * context,
         // targetLod uses the +1-shifted STORED ladder level:
         // 0 = no LoD (legacy full-walk mode), 1 = frontier, k = ancestor.
         int targetLod = 0) const;
 
+    // Flattens the ladder cell `from` into a Surface Nets brick (see
+    // SurfaceNets.hpp) at the same targetLod. False when the chunk is not
+    // uniformly refined or its surroundings differ in size; such chunks go
+    // through iterateTriangles.
+    bool buildSurfaceNetsBrick(OctreeNode * from,
+        const OctreeCellKey &fromKey,
+        int targetLod,
+        SurfaceNetsBrick &brick) const;
+
     // HeightRootToChunk(N): how many LoD levels a chunk can hold above its
     // tessellation frontier before reaching the chunk-size boundary, i.e.
     // floor(log2(chunkSize / minSize)) - N. >= 0 means a cell at LoD N is
@@ -126,7 +176,7 @@ class Octree: public BoundingCube {
 private:
     void buildShapeSDF(const ShapeArgs &args, OctreeNodeFrame &frame, NodeOperationResult &r, NodeOperationResult children[8], ThreadContext * threadContext, bool force) const;
     void buildResultSDF(const ShapeArgs &args, OctreeNodeFrame &frame, NodeOperationResult &r, NodeOperationResult children[8], ThreadContext * threadContext) const;
-    float evaluateSDF(const ShapeArgs &args, tsl::robin_map<glm::vec3, float> * threadContext, glm::vec3 p) const;
+    float evaluateSDF(const ShapeArgs &args, tsl::robin_map<OctreeCellKey, float, OctreeCellKeyHasher> * cache, const OctreeCellKey &point, const glm::vec3 &p) const;
     void shapeChildren(
         const OctreeNodeFrame &frame, 
         const ShapeArgs &args, 
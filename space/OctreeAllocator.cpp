@@ -33,3 +33,17 @@ size_t OctreeAllocator::getBlockSize() const {
 size_t OctreeAllocator::getAllocatedBlocksCount() {
     return nodeAllocator.getAllocatedBlocksCount();    
 }
+
+size_t OctreeAllocator::getUsedBytes() const {
+    return nodeAllocator.getUsedCount() * sizeof(OctreeNode) +
+           childAllocator.getUsedCount() * sizeof(ChildBlock);
+}
+
+void OctreeAllocator::holdFrees(bool hold) {
+    nodeAllocator.holdFrees(hold);
+    childAllocator.holdFrees(hold);
+}
+
+size_t OctreeAllocator::releaseFreeBlocks() {
+    return nodeAllocator.releaseFreeBlocks() + childAllocator.releaseFreeBlocks();
+}
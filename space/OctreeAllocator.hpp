@@ -17,6 +17,13 @@ public:
     uint getIndex(OctreeNode * node);
     size_t getBlockSize() const;
     size_t getAllocatedBlocksCount();
+    // Bytes of nodes and child blocks currently in use (the paging budget).
+    size_t getUsedBytes() const;
+    // Compaction support (OctreeCompactor.hpp): allocate nodes and child
+    // blocks lowest address first while a pass holds the frees aside
+    // (Allocator::holdFrees), and free the blocks left unused.
+    void holdFrees(bool hold);
+    size_t releaseFreeBlocks();
 };
 
  
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <glm/glm.hpp>
+#include "../math/BoundingCube.hpp"
+
+// Integer address of an octree cell: depth below the tree root plus the
+// cell's coordinates on that depth's grid (0 .. 2^level - 1 per axis).
+// Keys hash and compare exactly, child/parent/neighbour steps are integer
+// arithmetic, and cube() derives the float cube from the root in one step,
+// so a cell's cube no longer depends on the path that reached it (getChild
+// chains round at every level).
+//
+// Keys are relative to the root they were computed from: Octree::expand
+// re-roots the tree, so a key must not outlive the traversal that built it.
+//
+// corner()/center() address lattice POINTS with the same type: a point is
+// stored on the coarsest grid that contains it, so a corner shared by a cell
+// and its descendants has a single key (used by the shape SDF cache).
+struct OctreeCellKey {
+    // Coordinates are 32-bit and corners need one extra bit.
+    static constexpr uint8_t MAX_LEVEL = 31;
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t z = 0;
+    uint8_t level = 0;
+
+    OctreeCellKey() = default;
+    OctreeCellKey(uint32_t x_, uint32_t y_, uint32_t z_, uint8_t level_)
+        : x(x_), y(y_), z(z_), level(level_) {}
+
+    // Child index layout matches BoundingCube::getChild / getChildIndex:
+    // x -> 4, y -> 2, z -> 1.
+    OctreeCellKey child(int i) const {
+        return OctreeCellKey((x << 1) | ((i >> 2) & 1u), (y << 1) | ((i >> 1) & 1u),
+                             (z << 1) | (i & 1u), static_cast<uint8_t>(level + 1));
+    }
+
+    OctreeCellKey parent() const {
+        return ancestor(level > 0 ? level - 1 : 0);
+    }
+
+    // The ancestor at depth `depth` (<= level).
+    OctreeCellKey ancestor(uint8_t depth) const {
+        const uint32_t shift = level - depth;
+        return OctreeCellKey(x >> shift, y >> shift, z >> shift, depth);
+    }
+
+    // Index of this cell inside its parent.
+    int childIndex() const {
+        return static_cast<int>(((x & 1u) << 2) | ((y & 1u) << 1) | (z & 1u));
+    }
+
+    // Child index taken below depth `depth` on the root path to this cell
+    // (depth 0 = the root's child); depth < level.
+    int pathIndex(uint8_t depth) const {
+        return ancestor(depth + 1).childIndex();
+    }
+
+    // True when `other` is this cell or one of its descendants.
+    bool contains(const OctreeCellKey &other) const {
+        return other.level >= level && other.ancestor(level) == *this;
+    }
+
+    // Same-level neighbour offset by (dx, dy, dz) cells; false when it falls
+    // outside the root.
+    bool neighbour(int dx, int dy, int dz, OctreeCellKey &out) const {
+        const int64_t side = int64_t(1) << level;
+        const int64_t nx = int64_t(x) + dx, ny = int64_t(y) + dy, nz = int64_t(z) + dz;
+        if(nx < 0 || ny < 0 || nz < 0 || nx >= side || ny >= side || nz >= side) {
+            return false;
+        }
+        out = OctreeCellKey(uint32_t(nx), uint32_t(ny), uint32_t(nz), level);
+        return true;
+    }
+
+    BoundingCube cube(const BoundingCube &root) const {
+        const float size = std::ldexp(root.getLengthX(), -static_cast<int>(level));
+        return BoundingCube(root.getMin() + glm::vec3(float(x), float(y), float(z)) * size, size);
+    }
+
+    // Lattice point at corner i (CUBE_CORNERS order) / at the cell centre.
+    OctreeCellKey corner(int i) const {
+        return point(x + ((i >> 2) & 1u), y + ((i >> 1) & 1u), z + (i & 1u), level);
+    }
+
+    OctreeCellKey center() const {
+        return point((x << 1) | 1u, (y << 1) | 1u, (z << 1) | 1u, static_cast<uint8_t>(level + 1));
+    }
+
+    // Canonical key of the grid point (px, py, pz) at depth `depth`.
+    static OctreeCellKey point(uint32_t px, uint32_t py, uint32_t pz, uint8_t depth) {
+        while(depth > 0 && ((px | py | pz) & 1u) == 0u) {
+            px >>= 1;
+            py >>= 1;
+            pz >>= 1;
+            --depth;
+        }
+        return OctreeCellKey(px, py, pz, depth);
+    }
+
+    bool operator==(const OctreeCellKey &o) const {
+        return x == o.x && y == o.y && z == o.z && level == o.level;
+    }
+    bool operator!=(const OctreeCellKey &o) const { return !(*this == o); }
+};
+
+struct OctreeCellKeyHasher {
+    std::size_t operator()(const OctreeCellKey &k) const {
+        uint64_t h = (uint64_t(k.x) * 0x9E3779B97F4A7C15ull)
+                   ^ (uint64_t(k.y) * 0xC2B2AE3D27D4EB4Full)
+                   ^ (uint64_t(k.z) * 0x165667B19E3779F9ull)
+                   ^ (uint64_t(k.level) << 56);
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 32;
+        return static_cast<std::size_t>(h);
+    }
+};
@@ -0,0 +1,284 @@
+#include "OctreeCompactor.hpp"
+#include "Octree.hpp"
+#include "OctreeAllocator.hpp"
+#include "OctreePager.hpp"
+#include "OctreeSubtree.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <utility>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+OctreeCompactor::OctreeCompactor(Octree &tree)
+    : tree(tree) {
+}
+
+OctreeCompactor::~OctreeCompactor() {
+    stop();
+}
+
+void OctreeCompactor::stop() {
+    stopping = true;
+    worker.stop();
+    // A pass cut short leaves the allocators holding its frees.
+    std::lock_guard<std::mutex> lock(mutex);
+    if(running) {
+        running = false;
+        pending.clear();
+        tree.allocator->holdFrees(false);
+    }
+}
+
+bool OctreeCompactor::update() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(running || queued) {
+        return true;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if(now - lastCheck < kCheckInterval) {
+        return false;
+    }
+    lastCheck = now;
+    const Allocator<OctreeNode> &nodes = tree.allocator->nodeAllocator;
+    const size_t churn = nodes.getDeallocationCount() - deallocationsAtPass;
+    if(churn < nodes.getBlockSize() || churn < kChurnFraction * nodes.getUsedCount()) {
+        return false;
+    }
+    queued = true;
+    worker.enqueueDetached([this, forGeneration = generation]() {
+        runPass(forGeneration);
+    });
+    return true;
+}
+
+void OctreeCompactor::requestPass() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(running || queued || stopping) {
+        return;
+    }
+    queued = true;
+    worker.enqueueDetached([this, forGeneration = generation]() {
+        runPass(forGeneration);
+    });
+}
+
+void OctreeCompactor::compactAll() {
+    uint64_t forGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(running) {
+            return;
+        }
+        forGeneration = generation;
+    }
+    if(beginPass(forGeneration)) {
+        while(step()) {
+        }
+    }
+}
+
+void OctreeCompactor::runPass(uint64_t forGeneration) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued = false;
+    }
+    if(stopping || !beginPass(forGeneration)) {
+        return;
+    }
+    while(!stopping && step()) {
+        std::this_thread::sleep_for(kSliceInterval);
+    }
+}
+
+bool OctreeCompactor::step() {
+    OctreeCellKey key;
+    BoundingCube root;
+    bool hasUnit = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!running) {
+            return false;
+        }
+        hasUnit = !pending.empty();
+        if(hasUnit) {
+            key = pending.back();
+            pending.pop_back();
+            root = passRoot;
+        }
+    }
+    bool busy = false;
+    if(hasUnit) {
+        const UnitResult result = compactUnit(key, root);
+        std::lock_guard<std::mutex> lock(mutex);
+        if(result == UnitResult::Compacted) {
+            ++totals.unitsCompacted;
+        }
+        // Walks hold the tree: the unit goes back on top, after a short wait.
+        busy = result == UnitResult::Busy && running;
+        if(busy) {
+            pending.push_back(key);
+        }
+    }
+    if(busy) {
+        std::this_thread::sleep_for(kBusyBackoff);
+        return true;
+    }
+
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = running && pending.empty();
+    }
+    if(done) {
+        finishPass();
+    }
+    return !done;
+}
+
+void OctreeCompactor::reset() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.clear();
+        ++generation;
+        deallocationsAtPass = tree.allocator->nodeAllocator.getDeallocationCount();
+    }
+    // The slice in flight finishes before the tree goes.
+    std::lock_guard<std::mutex> slice(sliceMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    if(running) {
+        running = false;
+        tree.allocator->holdFrees(false);
+    }
+}
+
+OctreeCompactor::Stats OctreeCompactor::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = totals;
+    result.pendingUnits = pending.size();
+    return result;
+}
+
+bool OctreeCompactor::beginPass(uint64_t forGeneration) {
+    // Child 0 first at every level: the units come out in Morton order, and
+    // since each one is rebuilt from the lowest free addresses, the pass
+    // lays them out in memory in that order too.
+    std::lock_guard<std::mutex> slice(sliceMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(forGeneration != generation || running) {
+            return false;
+        }
+    }
+    std::vector<OctreeCellKey> units;
+    BoundingCube root;
+    tree.readLocked([&]() {
+        root = tree;
+        std::vector<std::pair<OctreeNode*, OctreeCellKey>> stack;
+        if(tree.root != NULL) {
+            stack.emplace_back(tree.root, OctreeCellKey());
+        }
+        while(!stack.empty()) {
+            auto [node, key] = stack.back();
+            stack.pop_back();
+            if(OctreePager::isPageUnit(node)) {
+                if(!node->isLeaf()) {
+                    units.push_back(key);
+                }
+                continue;
+            }
+            OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+            node->getChildren(*tree.allocator, children);
+            for(int i = 7; i >= 0; --i) {
+                if(children[i] != NULL) {
+                    stack.emplace_back(children[i], key.child(i));
+                }
+            }
+        }
+    });
+    std::reverse(units.begin(), units.end());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(forGeneration != generation) {
+        return false;
+    }
+    pending = std::move(units);
+    passRoot = root;
+    running = true;
+    // Ordered once here; the frees of the pass wait until it ends.
+    tree.allocator->holdFrees(true);
+    return true;
+}
+
+OctreeCompactor::UnitResult OctreeCompactor::compactUnit(const OctreeCellKey &key, const BoundingCube &root) {
+    std::lock_guard<std::mutex> slice(sliceMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!running) {
+            return UnitResult::Skipped;
+        }
+    }
+    UnitResult result = UnitResult::Skipped;
+    const bool locked = tree.tryWriteLocked([&]() {
+        // Keys are relative to the root: an expand since the pass started
+        // moved every cell, so the rest of the pass finds nothing.
+        if(!(static_cast<const BoundingCube&>(tree) == root)) {
+            return;
+        }
+        const OctreeNodeLevel cell = tree.getNodeAt(key, false);
+        OctreeNode * node = cell.level == key.level ? cell.node : nullptr;
+        // Removed, restructured or paged out since the pass started.
+        if(node == nullptr || !OctreePager::isPageUnit(node) || node->isLeaf() || node->isPagedOut()) {
+            return;
+        }
+        OctreeAllocator &allocator = *tree.allocator;
+        scratch.clear();
+        uint32_t count = 0;
+        if(!writeOctreeSubtree(allocator, node, scratch, count)) {
+            return;
+        }
+        // Rebuilt into the lowest free slots before the old subtree is
+        // freed; its slots are held aside until the pass ends.
+        const uint oldBlock = node->blockId;
+        node->blockId = UINT_MAX;
+        size_t pos = 0;
+        if(!readOctreeSubtree(allocator, node, true, scratch, pos)) {
+            node->clear(allocator, NULL);
+            node->blockId = oldBlock;
+            std::cerr << "OctreeCompactor::compactUnit() Truncated snapshot" << std::endl;
+            return;
+        }
+        OctreeNode old;
+        old.blockId = oldBlock;
+        old.clear(allocator, NULL);
+        result = UnitResult::Compacted;
+    });
+    return locked ? result : UnitResult::Busy;
+}
+
+void OctreeCompactor::finishPass() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!running) {
+            return;
+        }
+        running = false;
+    }
+    tree.allocator->holdFrees(false);
+    const size_t released = tree.allocator->releaseFreeBlocks();
+#ifdef __GLIBC__
+    // The blocks are below the mmap threshold: ask the heap to hand their
+    // pages back.
+    if(released > 0) {
+        malloc_trim(0);
+    }
+#endif
+    std::lock_guard<std::mutex> lock(mutex);
+    deallocationsAtPass = tree.allocator->nodeAllocator.getDeallocationCount();
+    lastCheck = std::chrono::steady_clock::now();
+    ++totals.passes;
+    totals.releasedBlocks += released;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "../math/BoundingCube.hpp"
+#include "OctreeCellKey.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Octree;
+
+// Online re-layout of one octree's node and child-block arrays. Edits free
+// and reallocate nodes all over the allocator's blocks, so after a long
+// session parents, children and siblings sit far apart and every walk
+// (iterate*, getNodeAt, iterateTriangles) misses cache on each step.
+//
+// A pass runs on the compactor's own thread and visits the page units
+// (frontier ladder cells, OctreePager::isPageUnit) in Morton order, one per
+// slice. A slice only takes the tree write lock when no walk holds the tree
+// (tryWriteLocked), so it never queues behind tessellation readers or holds
+// new ones back; a busy unit is retried after a short backoff. Each slice
+// snapshots the unit's subtree (OctreeSubtree.hpp), rebuilds it from the
+// lowest free addresses, depth-first with siblings together, then frees the
+// old nodes. The unit node itself stays in place, as do the ladder cells
+// above it: renderer keys, pager stubs and journal cells stay valid, and
+// node contents (versions, stamps) are copied unchanged, so nothing
+// re-meshes. While a pass runs the allocators hold freed elements aside
+// (OctreeAllocator::holdFrees), so the free list is ordered once per pass
+// rather than once per unit. Once every unit has moved down, the allocator
+// blocks left without a live element go back to the OS.
+//
+// A pass starts when the nodes freed since the last one reach
+// kChurnFraction of the nodes in use.
+class OctreeCompactor {
+public:
+    struct Stats {
+        size_t pendingUnits = 0;        // units left in the running pass
+        uint64_t passes = 0;            // completed passes
+        uint64_t unitsCompacted = 0;
+        uint64_t releasedBlocks = 0;    // allocator blocks freed, total
+    };
+
+    explicit OctreeCompactor(Octree &tree);
+    ~OctreeCompactor();
+
+    // Renderer thread, once per frame (throttled to kCheckInterval): starts a
+    // pass on the compactor thread once enough churn has built up. Returns
+    // true while a pass is running.
+    bool update();
+    // Starts a pass on the compactor thread now (unless one is running),
+    // regardless of churn.
+    void requestPass();
+    // Runs a whole pass on the calling thread (benchmarks, tools).
+    void compactAll();
+    // The tree is about to be reset: drops the running pass and waits for
+    // the compactor thread to let go of the tree.
+    void reset();
+    void stop();
+
+    Stats stats() const;
+
+private:
+    enum class UnitResult { Compacted, Skipped, Busy };
+
+    static constexpr double kChurnFraction = 0.25;
+    static constexpr std::chrono::milliseconds kCheckInterval{1000};
+    // Pause between slices, so edits and page-ins get the write lock too.
+    static constexpr std::chrono::milliseconds kSliceInterval{1};
+    // Wait before retrying a unit whose write lock was busy.
+    static constexpr std::chrono::milliseconds kBusyBackoff{4};
+
+    // Starts a pass of `forGeneration` unless reset() came first. False when
+    // there is nothing to run.
+    bool beginPass(uint64_t forGeneration);
+    void runPass(uint64_t forGeneration);
+    // Compacts the next unit of the running pass and finishes the pass after
+    // its last one. False once no pass is running.
+    bool step();
+    // Compacts the unit at `key` (relative to `root`) under the write lock.
+    // Skipped when it is gone, paged out, a leaf, or the tree was re-rooted
+    // since the pass started; Busy when the write lock was taken.
+    UnitResult compactUnit(const OctreeCellKey &key, const BoundingCube &root);
+    void finishPass();
+
+    Octree &tree;
+
+    mutable std::mutex mutex;
+    std::vector<OctreeCellKey> pending;  // reversed: the next unit is at the back
+    BoundingCube passRoot;  // tree cube the pending keys are relative to
+    bool running = false;
+    bool queued = false;    // a pass waits on the thread
+    uint64_t generation = 0;
+    size_t deallocationsAtPass = 0;
+    std::chrono::steady_clock::time_point lastCheck;
+    Stats totals;
+    // Held while a pass reads or rebuilds the tree, so reset() can wait for
+    // the slice in flight. Taken before the tree lock.
+    std::mutex sliceMutex;
+    std::atomic<bool> stopping{false};
+    // Reused snapshot buffer (one pass at a time).
+    std::string scratch;
+
+    // One thread runs the passes, like the pager's I/O thread.
+    ThreadPool worker = ThreadPool(1);
+};
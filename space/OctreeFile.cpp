@@ -4,12 +4,83 @@
 #include "OctreeAllocator.hpp"
 #include "ChildBlock.hpp"
 #include "OctreeNodeFile.hpp"
+#include "OctreePager.hpp"
 #include "../sdf/SDF.hpp"
 #include "../math/BrushMode.hpp"
 #include "../math/Math.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <unordered_map>
 
+namespace {
+
+// Passes at a paged-out unit whose page vanished under the snapshot (paged
+// back in, or out again) before it is written as the stub alone.
+constexpr int kMaxUnitAttempts = 3;
+
+struct SliceUnit {
+	OctreeCellKey key;
+	uint parent;	// node linking the unit
+	int slot;		// its child index there, -1 when the unit is the root
+};
+
+OctreeNodeSerialized serializeNode(const OctreeNode &node) {
+	OctreeNodeSerialized n = OctreeNodeSerialized();
+	n.brushIndex = node.getBrush();
+	n.hsv = node.getHSV();
+	n.bits = node.bits;
+	node.getSDF(n.sdf);
+	return n;
+}
+
+// Flattens the nodes above the page units, listing the units to write.
+uint saveSpine(Octree &tree, OctreeNode * node, const OctreeCellKey &key, std::vector<OctreeNodeSerialized> * nodes, std::vector<SliceUnit> &units) {
+	const uint index = nodes->size();
+	nodes->push_back(serializeNode(*node));
+	OctreeNode * children[8] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+	node->getChildren(*tree.allocator, children);
+	for(int i = 0; i < 8; ++i) {
+		if(children[i] == NULL) {
+			continue;
+		}
+		if(OctreePager::isPageUnit(children[i])) {
+			units.push_back({ key.child(i), index, i });
+		} else {
+			(*nodes)[index].children[i] = saveSpine(tree, children[i], key.child(i), nodes, units);
+		}
+	}
+	return index;
+}
+
+// Skips the raw subtree record at `pos` (OctreeSubtree.hpp) and flattens
+// its descendants under `index`. False on a truncated record.
+bool appendRecordChildren(const std::string &in, size_t &pos, std::vector<OctreeNodeSerialized> * nodes, uint index) {
+	if(pos + sizeof(OctreeNode) + 1 > in.size()) {
+		return false;
+	}
+	pos += sizeof(OctreeNode);
+	const uint8_t mask = static_cast<uint8_t>(in[pos++]);
+	for(int i = 0; i < 8; ++i) {
+		if(!(mask & (1u << i))) {
+			continue;
+		}
+		if(pos + sizeof(OctreeNode) + 1 > in.size()) {
+			return false;
+		}
+		OctreeNode child;
+		std::memcpy(static_cast<void*>(&child), in.data() + pos, sizeof(OctreeNode));
+		const uint childIndex = nodes->size();
+		nodes->push_back(serializeNode(child));
+		(*nodes)[index].children[i] = childIndex;
+		if(!appendRecordChildren(in, pos, nodes, childIndex)) {
+			return false;
+		}
+	}
+	return true;
+}
 
+}
 
 OctreeFile::OctreeFile(Octree * tree_, std::string filename_) {
 	this->tree = tree_;
@@ -59,19 +130,118 @@ void OctreeFile::writeToStream(std::ostream& out) {
 	}
 }
 
+bool OctreeFile::writeToStreamSliced(std::ostream& out) {
+	std::vector<OctreeNodeSerialized> nodes;
+	std::vector<SliceUnit> units;
+	BoundingCube root;
+	float chunkSize = 0.0f;
+	tree->readLocked([&]() {
+		root = *tree;
+		chunkSize = tree->chunkSize;
+		if (tree->root == nullptr) {
+			return;
+		}
+		if (OctreePager::isPageUnit(tree->root)) {
+			units.push_back({ OctreeCellKey(), 0, -1 });
+		} else {
+			saveSpine(*tree, tree->root, OctreeCellKey(), &nodes, units);
+		}
+	});
+
+	for (const SliceUnit &unit : units) {
+		for (int attempt = 1; ; ++attempt) {
+			bool moved = false;
+			bool done = false;
+			OctreeNode stub;
+			std::shared_ptr<const std::string> page;
+			std::string pagePath;
+			uint index = 0;
+			tree->readLocked([&]() {
+				// Keys are relative to the root: an expand moved every cell.
+				if (!(static_cast<const BoundingCube&>(*tree) == root)) {
+					moved = true;
+					return;
+				}
+				const OctreeNodeLevel cell = tree->getNodeAt(unit.key, false);
+				OctreeNode * node = cell.level == unit.key.level ? cell.node : nullptr;
+				if (node == nullptr) {
+					// Removed since the spine was written.
+					done = true;
+					return;
+				}
+				if (!node->isPagedOut()) {
+					index = saveRecursive(node, &nodes, 0.0f, filename, unit.key, "");
+					done = true;
+					return;
+				}
+				stub = *node;
+				stub.setPagedOut(false);
+				if (tree->pager != nullptr) {
+					page = tree->pager->pageOf(unit.key.cube(*tree), pagePath);
+				}
+			});
+			if (moved) {
+				return false;
+			}
+			if (!done) {
+				// The page file is read outside the lock.
+				if (!page && !pagePath.empty()) {
+					page = tree->pager->readPage(pagePath);
+				}
+				index = nodes.size();
+				nodes.push_back(serializeNode(stub));
+				size_t pos = 0;
+				if (page && OctreePager::pageRecords(*page, pos) && appendRecordChildren(*page, pos, &nodes, index)) {
+					done = true;
+				} else if (attempt >= kMaxUnitAttempts) {
+					// Kept as the stub leaf, as a failed page in would.
+					nodes.resize(index + 1);
+					std::fill(std::begin(nodes[index].children), std::end(nodes[index].children), 0u);
+					std::cerr << "OctreeFile::writeToStreamSliced() Unreadable page: " << pagePath << std::endl;
+					done = true;
+				} else {
+					nodes.resize(index);
+				}
+			}
+			if (done) {
+				if (unit.slot >= 0) {
+					nodes[unit.parent].children[unit.slot] = index;
+				}
+				break;
+			}
+		}
+	}
+
+	OctreeSerialized octreeSerialized;
+	octreeSerialized.min = root.getMin();
+	octreeSerialized.length = root.getLengthX();
+	octreeSerialized.chunkSize = chunkSize;
+
+	out.write(reinterpret_cast<const char*>(&octreeSerialized), sizeof(OctreeSerialized));
+	size_t size = nodes.size();
+	out.write(reinterpret_cast<const char*>(&size), sizeof(size_t));
+	if (size > 0) {
+		out.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(OctreeNodeSerialized));
+	}
+	return true;
+}
+
 std::string getChunkName(const BoundingCube &cube) {
 	glm::vec3 p = cube.getMin();
 	return std::to_string(cube.getLengthX()) + "_" + std::to_string(p.x) + "_" +  std::to_string(p.y) + "_" + std::to_string(p.z);
 }
 
-OctreeNode * OctreeFile::loadRecursive(int i, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const BoundingCube &cube, std::string baseFolder) {
+OctreeNode * OctreeFile::loadRecursive(int i, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const OctreeCellKey &key, std::string baseFolder) {
 	OctreeNodeSerialized serialized = nodes->at(i);
+	const BoundingCube cube = key.cube(*tree);
 	glm::vec3 position = SDF::getPosition(serialized.sdf, cube);
 	glm::vec3 normal = SDF::getNormalFromPosition(serialized.sdf, cube, position);
-	Vertex vertex(position, normal, glm::vec2(0), serialized.brushIndex);
-	vertex.hsv = serialized.hsv;
 
-	OctreeNode * node = tree->allocator->allocate()->init(vertex);
+	OctreeNode * node = tree->allocator->allocate()->init(cube);
+	node->setPosition(position, cube);
+	node->setNormal(normal);
+	node->setBrush(serialized.brushIndex);
+	node->setHSV(serialized.hsv);
 	node->setSDF(serialized.sdf);
 	node->bits = serialized.bits;
 	bool isLeaf = true;
@@ -86,8 +256,7 @@ OctreeNode * OctreeFile::loadRecursive(int i, std::vector<OctreeNodeSerialized>
 		for(int j=0 ; j <8 ; ++j){
 			int index = serialized.children[j];
 			if(index != 0) {
-				BoundingCube c = cube.getChild(j);
-				block->set(j , loadRecursive(index, nodes, chunkSize, filename_, c,baseFolder), *tree->allocator);
+				block->set(j , loadRecursive(index, nodes, chunkSize, filename_, key.child(j), baseFolder), *tree->allocator);
 			}
 		}
 	} else {
@@ -95,7 +264,7 @@ OctreeNode * OctreeFile::loadRecursive(int i, std::vector<OctreeNodeSerialized>
 			OctreeNodeFile * file = new OctreeNodeFile(tree, node, baseFolder + "/" + filename_+ "_" + chunkName + ".bin");
 		//NodeInfo info(INFO_TYPE_FILE, file, NULL, true);
 		//node->info.push_back(info);
-		file->load(baseFolder, cube);
+		file->load(baseFolder, key);
 		delete file;
 	}
 
@@ -178,7 +347,7 @@ void OctreeFile::load(std::string baseFolder, float chunkSize) {
 		tree->setMin(octreeSerialized.min);
 		tree->setLength(octreeSerialized.length);
 		tree->chunkSize = octreeSerialized.chunkSize;
-		tree->root = loadRecursive(0,&nodes, chunkSize, filename, *tree, baseFolder);
+		tree->root = loadRecursive(0,&nodes, chunkSize, filename, OctreeCellKey(), baseFolder);
 	}
 
     file.close();
@@ -187,24 +356,18 @@ void OctreeFile::load(std::string baseFolder, float chunkSize) {
 }
 
 
-uint OctreeFile::saveRecursive(OctreeNode * node, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const BoundingCube &cube, std::string baseFolder) {
+uint OctreeFile::saveRecursive(OctreeNode * node, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const OctreeCellKey &key, std::string baseFolder) {
 	if(node!=NULL) {
-		OctreeNodeSerialized n = OctreeNodeSerialized();
-		n.brushIndex = node->vertex.brushIndex;
-		n.hsv = node->vertex.hsv;
-		n.bits = node->bits;
-		SDF::copySDF(node->sdf, n.sdf);
-
+		const BoundingCube cube = key.cube(*tree);
 		uint index = nodes->size(); 
-		nodes->push_back(n);
+		nodes->push_back(serializeNode(*node));
 
 		if(cube.getLengthX() > chunkSize) {
 			OctreeNode * children[8] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
 			node->getChildren(*tree->allocator, children);
 
 			for(int i=0; i < 8; ++i) {
-				BoundingCube c = cube.getChild(i);
-				(*nodes)[index].children[i] = saveRecursive(children[i], nodes, chunkSize, filename, c, baseFolder);
+				(*nodes)[index].children[i] = saveRecursive(children[i], nodes, chunkSize, filename, key.child(i), baseFolder);
 			}
 		} else {
 			std::string chunkName = getChunkName(cube);
@@ -226,7 +389,7 @@ void OctreeFile::save(std::string baseFolder, float chunkSize){
         return;
     }
 
-	saveRecursive(tree->root, &nodes, chunkSize, filename, *tree, baseFolder);
+	saveRecursive(tree->root, &nodes, chunkSize, filename, OctreeCellKey(), baseFolder);
 
     std::ostringstream decompressed;
 	if (chunkSize == 0.0f) {
@@ -8,12 +8,19 @@ class OctreeFile {
 public:
     OctreeFile(Octree * tree, std::string filename);
     void writeToStream(std::ostream& out);
+    // writeToStream for a live tree: the read lock is held one slice at a
+    // time, first for the nodes above the page units, then for each unit.
+    // Paged-out units are streamed from their page files, not restored.
+    // Edits landing between slices leave units from different states, so
+    // the caller records them to replay over the result (SceneJournal).
+    // False when the root moved meanwhile.
+    bool writeToStreamSliced(std::ostream& out);
     void readFromStream(std::istream& in);
     void save(std::string baseFolder, float chunkSize);
     void load(std::string baseFolder, float chunkSize);
     AbstractBoundingBox& getBox();
-    OctreeNode * loadRecursive(int i, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const BoundingCube &cube, std::string baseFolder);
-    uint saveRecursive(OctreeNode * node, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const BoundingCube &cube, std::string baseFolder);
+    OctreeNode * loadRecursive(int i, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const OctreeCellKey &key, std::string baseFolder);
+    uint saveRecursive(OctreeNode * node, std::vector<OctreeNodeSerialized> * nodes, float chunkSize, std::string filename_, const OctreeCellKey &key, std::string baseFolder);
 };
 
  
@@ -3,25 +3,43 @@
 #include "OctreeAllocator.hpp"
 #include "OctreeNodeData.hpp"
 #include "../sdf/SDF.hpp"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <climits>
 
 
 const float FAR_ARRAY [8] = {INFINITY,INFINITY,INFINITY,INFINITY,INFINITY,INFINITY,INFINITY,INFINITY};
 
-
-OctreeNode::OctreeNode() {
-	version = 0u;
-	init(glm::vec3());
+#ifndef OCTREE_WIDE_NODES
+namespace {
+
+// Finite corners map to [-SDF_QUANT_MAX, SDF_QUANT_MAX]; the two remaining
+// int16 values are the +/-INFINITY sentinels.
+constexpr int SDF_QUANT_MAX = 32766;
+constexpr int16_t SDF_FAR = INT16_MAX;
+constexpr int16_t SDF_NEG_FAR = INT16_MIN;
+// Even, so the cube centre (and both faces) quantise exactly.
+constexpr float POSITION_QUANT_MAX = 65534.0f;
+// Saturation/value use 254 steps so the neutral 0.5 is exact.
+constexpr float HSV_QUANT_MAX = 254.0f;
+constexpr float HUE_QUANT_MAX = 255.0f;
+
+uint8_t quantizeUnit(float v, float steps) {
+	return static_cast<uint8_t>(std::lround(glm::clamp(v, 0.0f, 1.0f) * steps));
 }
 
-OctreeNode::OctreeNode(Vertex vertex_) {
+} // namespace
+#endif
+
+
+OctreeNode::OctreeNode() {
 	version = 0u;
-	init(vertex_);
+	init(BoundingCube());
 }
 
-OctreeNode * OctreeNode::init(Vertex vert) {
-	memcpy(this->sdf, FAR_ARRAY, sizeof(float)*8);
+OctreeNode * OctreeNode::init(const BoundingCube &cube) {
+	setSDF(FAR_ARRAY);
 	this->bits = 0x0;
 	// lod / chunkLod must be reset too: the allocator hands out raw (malloc'd) or
 	// recycled memory without running the constructor, so the member
@@ -31,9 +49,17 @@ OctreeNode * OctreeNode::init(Vertex vert) {
 	// +1-shifted uint8_t representation.
 	this->lod = 0;
 	this->chunkLod = 0;
+	this->meshedStamp = 0;
 	this->setChunk(false);
 	this->setType(SpaceType::Surface);
-	this->vertex = vert;
+#ifdef OCTREE_WIDE_NODES
+	this->vertex = Vertex(cube.getCenter());
+#else
+	(void)cube;
+	this->position[0] = this->position[1] = this->position[2] = static_cast<uint16_t>(POSITION_QUANT_MAX / 2);
+	this->brushIndex = 0;
+	setHSV(Vertex().hsv);
+#endif
 	this->blockId = UINT_MAX;
 	this->version = 0u;
 	return this;
@@ -116,8 +142,116 @@ ChildBlock * OctreeNode::clear(OctreeAllocator &allocator, ChildBlock * block) {
 	return block;
 }
 
-void OctreeNode::setSDF(float value[8]) {
+void OctreeNode::setSDF(const float value[8]) {
+#ifdef OCTREE_WIDE_NODES
 	memcpy(this->sdf, value, sizeof(float)*8);
+#else
+	float maxAbs = 0.0f;
+	for(int i = 0; i < 8; ++i) {
+		if(std::isfinite(value[i])) maxAbs = glm::max(maxAbs, std::fabs(value[i]));
+	}
+	int exponent = 0;
+	if(maxAbs > 0.0f) {
+		std::frexp(maxAbs, &exponent); // maxAbs < 2^exponent
+	}
+	exponent = std::clamp(exponent, -126, 127);
+	this->sdfExponent = static_cast<int8_t>(exponent);
+	const float scale = std::ldexp(static_cast<float>(SDF_QUANT_MAX), -exponent);
+	for(int i = 0; i < 8; ++i) {
+		const float v = value[i];
+		if(std::isnan(v) || v == INFINITY) {
+			this->sdf[i] = SDF_FAR;
+		} else if(v == -INFINITY) {
+			this->sdf[i] = SDF_NEG_FAR;
+		} else {
+			long q = std::lround(v * scale);
+			// Never round a non-zero corner to zero: the sign decides the
+			// cell type and the edge crossings.
+			if(q == 0 && v != 0.0f) q = v < 0.0f ? -1 : 1;
+			this->sdf[i] = static_cast<int16_t>(std::clamp<long>(q, -SDF_QUANT_MAX, SDF_QUANT_MAX));
+		}
+	}
+#endif
+}
+
+void OctreeNode::getSDF(float value[8]) const {
+#ifdef OCTREE_WIDE_NODES
+	memcpy(value, this->sdf, sizeof(float)*8);
+#else
+	const float step = std::ldexp(1.0f / SDF_QUANT_MAX, this->sdfExponent);
+	for(int i = 0; i < 8; ++i) {
+		const int16_t q = this->sdf[i];
+		value[i] = q == SDF_FAR ? INFINITY : (q == SDF_NEG_FAR ? -INFINITY : static_cast<float>(q) * step);
+	}
+#endif
+}
+
+glm::vec3 OctreeNode::getPosition(const BoundingCube &cube) const {
+#ifdef OCTREE_WIDE_NODES
+	(void)cube;
+	return this->vertex.position;
+#else
+	const glm::vec3 t(this->position[0] / POSITION_QUANT_MAX,
+	                  this->position[1] / POSITION_QUANT_MAX,
+	                  this->position[2] / POSITION_QUANT_MAX);
+	return cube.getMin() + cube.getLength() * t;
+#endif
+}
+
+void OctreeNode::setPosition(const glm::vec3 &value, const BoundingCube &cube) {
+#ifdef OCTREE_WIDE_NODES
+	(void)cube;
+	this->vertex.position = value;
+#else
+	const float length = cube.getLengthX();
+	const glm::vec3 t = length > 0.0f ? (value - cube.getMin()) / length : glm::vec3(0.5f);
+	for(int i = 0; i < 3; ++i) {
+		this->position[i] = static_cast<uint16_t>(std::lround(glm::clamp(t[i], 0.0f, 1.0f) * POSITION_QUANT_MAX));
+	}
+#endif
+}
+
+void OctreeNode::setNormal(const glm::vec3 &normal) {
+#ifdef OCTREE_WIDE_NODES
+	this->vertex.normal = normal;
+#else
+	(void)normal;
+#endif
+}
+
+Vertex OctreeNode::getVertex(const BoundingCube &cube) const {
+#ifdef OCTREE_WIDE_NODES
+	(void)cube;
+	return this->vertex;
+#else
+	float corners[8];
+	getSDF(corners);
+	Vertex v(getPosition(cube));
+	v.normal = SDF::getNormalFromPosition(corners, cube, v.position);
+	v.brushIndex = this->brushIndex;
+	v.hsv = getHSV();
+	return v;
+#endif
+}
+
+glm::vec3 OctreeNode::getHSV() const {
+#ifdef OCTREE_WIDE_NODES
+	return this->vertex.hsv;
+#else
+	return glm::vec3(this->hsv[0] * (360.0f / HUE_QUANT_MAX),
+	                 this->hsv[1] / HSV_QUANT_MAX,
+	                 this->hsv[2] / HSV_QUANT_MAX);
+#endif
+}
+
+void OctreeNode::setHSV(const glm::vec3 &value) {
+#ifdef OCTREE_WIDE_NODES
+	this->vertex.hsv = value;
+#else
+	this->hsv[0] = quantizeUnit(value.x / 360.0f, HUE_QUANT_MAX);
+	this->hsv[1] = quantizeUnit(value.y, HSV_QUANT_MAX);
+	this->hsv[2] = quantizeUnit(value.z, HSV_QUANT_MAX);
+#endif
 }
 
 void OctreeNode::setType(SpaceType type) {
@@ -138,6 +272,14 @@ bool OctreeNode::isLeaf() const {
 	return this->blockId == UINT_MAX;
 }
 
+bool OctreeNode::isPagedOut() const {
+	return this->bits & (0x1 << 6);
+}
+void OctreeNode::setPagedOut(bool value) {
+	uint8_t mask = (0x1 << 6);
+	this->bits = (this->bits & ~mask) | (value ? mask : 0x0);
+}
+
 
 SpaceType OctreeNode::getType() const {
 	if(this->bits & (0x1 << 0)) {
@@ -181,7 +323,9 @@ uint OctreeNode::exportSerialization(OctreeAllocator &allocator, std::vector<Oct
 	}
 	uint index = nodes->size(); 
 
-	OctreeNodeCubeSerialized n(this->sdf, cube, this->vertex, this->bits, level);
+	float corners[8];
+	getSDF(corners);
+	OctreeNodeCubeSerialized n(corners, cube, getVertex(cube), this->bits, level);
 	nodes->push_back(n);
 	if(isLeaf()) {
 		++(*leafNodes);
@@ -200,9 +344,17 @@ uint OctreeNode::exportSerialization(OctreeAllocator &allocator, std::vector<Oct
 	return index;
 }
 
-void OctreeNode::setBrush(int brushIndex) {
-	vertex.brushIndex = brushIndex;
+void OctreeNode::setBrush(int brush) {
+#ifdef OCTREE_WIDE_NODES
+	vertex.brushIndex = brush;
+#else
+	this->brushIndex = static_cast<int8_t>(std::clamp(brush, -128, 127));
+#endif
 }
 int OctreeNode::getBrush() const {
+#ifdef OCTREE_WIDE_NODES
 	return this->vertex.brushIndex;
-}
\ No newline at end of file
+#else
+	return this->brushIndex;
+#endif
+}
@@ -8,10 +8,18 @@
 class OctreeAllocator;
 struct OctreeNodeCubeSerialized;
 
+// Node storage layout. The default (compact) layout keeps the 8 SDF corners
+// as 16-bit values normalised by a per-node power of two, the cell's
+// dual-contouring vertex quantised inside the node cube and brush/HSV in four
+// bytes; the normal is recomputed from the SDF on demand. Building with
+// -DOCTREE_WIDE_NODES restores the original layout (a full Vertex plus float
+// corners, 128 bytes per node) for comparison — see octreebench.
+//
+// Every vertex/SDF access goes through the accessors below, so callers are
+// layout-agnostic. Accessors taking a cube expect the node's OWN cube.
 class OctreeNode {
 
 public:
-    Vertex vertex;
     uint blockId;
     uint8_t bits;
     // Stored LoD levels are +1 shifted: getLod() returns the ladder level
@@ -21,19 +29,26 @@ public:
     // representation consistently.
     uint8_t lod = 0;
     uint8_t chunkLod = 0;
-    float sdf[8];
+    // Tessellation stamp: 1 once this ladder cell was meshed at its current
+    // version, 0 otherwise. Every version bump clears it (bumpVersion), so
+    // no version is ever mistaken for another. Lives in the padding byte
+    // before `version`; read and claimed lock-free (TessellationPlanner.hpp).
+    uint8_t meshedStamp = 0;
     uint version;
 
     OctreeNode();
-    OctreeNode(Vertex vertex);
     ~OctreeNode();
-    OctreeNode * init(Vertex vert);
+    // Resets the node to an empty Surface leaf whose vertex sits at the
+    // centre of `cube`.
+    OctreeNode * init(const BoundingCube &cube);
     ChildBlock * clear(OctreeAllocator &allocator, ChildBlock * block);
     ChildBlock * getBlock(OctreeAllocator &allocator) const;
     ChildBlock * allocate(OctreeAllocator &allocator);
     void getChildren(OctreeAllocator &allocator, OctreeNode * childNodes[8]) const;
     void setChildren(OctreeAllocator &allocator, uint children[8]);
     void setChildren(OctreeAllocator &allocator, OctreeNode * children[8]);
+    // Tree write lock held: the cell changed and needs a new mesh.
+    void bumpVersion() { ++version; meshedStamp = 0; }
 
     void setType(SpaceType type);
 
@@ -49,13 +64,49 @@ public:
 
     bool isLeaf() const ;
 
+    // Paged-out chunk stub (OctreePager.hpp): the subtree below lives in a
+    // page file, the node itself keeps its corners, vertex and ladder fields
+    // and looks like a leaf to every walk.
+    bool isPagedOut() const ;
+    void setPagedOut(bool value);
+
     void setBrush(int brushIndex);
     int getBrush() const;
+    glm::vec3 getHSV() const;
+    void setHSV(const glm::vec3 &hsv);
     SpaceType getType() const ;
 
-    void setSDF(float value[8]);
+    // Corner samples (INFINITY = no data). The compact layout keeps the sign
+    // and exact zeros of every corner; magnitudes are rounded to 1/32766 of
+    // the node's largest finite corner.
+    void getSDF(float value[8]) const;
+    void setSDF(const float value[8]);
+
+    // The cell's vertex as the tessellator consumes it: position, normal,
+    // brush and hsv (texCoord/colour at their defaults).
+    Vertex getVertex(const BoundingCube &cube) const;
+    glm::vec3 getPosition(const BoundingCube &cube) const;
+    void setPosition(const glm::vec3 &position, const BoundingCube &cube);
+    // Stored by the wide layout only; the compact layout derives the normal
+    // from the SDF at the vertex position.
+    void setNormal(const glm::vec3 &normal);
+
     uint exportSerialization(OctreeAllocator &allocator, std::vector<OctreeNodeCubeSerialized> * nodes, int * leafNodes, const BoundingCube &cube, const BoundingCube &chunk, uint level);
     OctreeNode * compress(OctreeAllocator &allocator, BoundingCube * cube, const BoundingCube &chunk);
+
+private:
+#ifdef OCTREE_WIDE_NODES
+    Vertex vertex;
+    float sdf[8];
+#else
+    int16_t sdf[8];         // corner * SDF_QUANT_MAX / 2^sdfExponent, or a FAR sentinel
+    uint16_t position[3];   // vertex in the cube, 0..POSITION_QUANT_MAX per axis
+    uint8_t hsv[3];         // hue / 360, saturation, value
+    int8_t brushIndex;
+    int8_t sdfExponent;
+#endif
 };
 
- 
+#ifndef OCTREE_WIDE_NODES
+static_assert(sizeof(OctreeNode) == 40, "compact OctreeNode layout grew");
+#endif
@@ -4,16 +4,18 @@
 #include <functional>
 #include "../math/BoundingCube.hpp"
 #include "../math/ContainmentType.hpp"
+#include "OctreeCellKey.hpp"
 
 class OctreeNode;
 
 struct OctreeNodeData {
 public:
-    uint level;
+    uint level;     // == key.level
     OctreeNode * node;
-    BoundingCube cube;
+    BoundingCube cube;  // == key.cube(tree)
+    OctreeCellKey key;
     void * context;
-    OctreeNodeData(uint level, OctreeNode * node, const BoundingCube &cube, void * context);
+    OctreeNodeData(OctreeNode * node, const OctreeCellKey &key, const BoundingCube &cube, void * context);
     OctreeNodeData(const OctreeNodeData &data);
     OctreeNodeData();
 };
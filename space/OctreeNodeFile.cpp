@@ -14,14 +14,17 @@ OctreeNodeFile::OctreeNodeFile(Octree * tree_, OctreeNode * node_, std::string f
 	this->tree = tree_;
 }
 
-OctreeNode * OctreeNodeFile::loadRecursive(OctreeNode * workingNode, int i, const BoundingCube &cube, std::vector<OctreeNodeSerialized> * nodes) {
+OctreeNode * OctreeNodeFile::loadRecursive(OctreeNode * workingNode, int i, const OctreeCellKey &key, std::vector<OctreeNodeSerialized> * nodes) {
 	OctreeNodeSerialized serialized = nodes->at(i);
 	if(workingNode == NULL) {
+		const BoundingCube cube = key.cube(*tree);
 		glm::vec3 position = SDF::getPosition(serialized.sdf, cube);
 		glm::vec3 normal = SDF::getNormalFromPosition(serialized.sdf, cube, position);
-		Vertex vertex(position, normal, glm::vec2(0), serialized.brushIndex);
-		vertex.hsv = serialized.hsv;
-		workingNode = tree->allocator->allocate()->init(vertex);
+		workingNode = tree->allocator->allocate()->init(cube);
+		workingNode->setPosition(position, cube);
+		workingNode->setNormal(normal);
+		workingNode->setBrush(serialized.brushIndex);
+		workingNode->setHSV(serialized.hsv);
 		workingNode->setSDF(serialized.sdf);
 		workingNode->bits = serialized.bits;
 	}
@@ -38,8 +41,7 @@ OctreeNode * OctreeNodeFile::loadRecursive(OctreeNode * workingNode, int i, cons
 	for(int j=0 ; j <8 ; ++j){
 		int index = serialized.children[j];
 		if(index != 0) {
-			BoundingCube c = cube.getChild(j);
-			block->set(j , loadRecursive(NULL, index, c, nodes), *tree->allocator);
+			block->set(j , loadRecursive(NULL, index, key.child(j), nodes), *tree->allocator);
 		}
 	}
 
@@ -47,7 +49,7 @@ OctreeNode * OctreeNodeFile::loadRecursive(OctreeNode * workingNode, int i, cons
 }
 
 
-void OctreeNodeFile::load(std::string baseFolder, const BoundingCube &cube) {
+void OctreeNodeFile::load(std::string baseFolder, const OctreeCellKey &key) {
 	std::ifstream file = std::ifstream(filename, std::ios::binary);
     if (!file) {
         std::cerr << "Error opening file for reading: " << filename << std::endl;
@@ -63,7 +65,7 @@ void OctreeNodeFile::load(std::string baseFolder, const BoundingCube &cube) {
 	nodes.resize(size);
 
    	decompressed.read(reinterpret_cast<char*>(nodes.data()), size * sizeof(OctreeNodeSerialized));
-	loadRecursive(node, 0, cube, &nodes);
+	loadRecursive(node, 0, key, &nodes);
     file.close();
 	nodes.clear();
 }
@@ -72,10 +74,10 @@ void OctreeNodeFile::load(std::string baseFolder, const BoundingCube &cube) {
 uint OctreeNodeFile::saveRecursive(OctreeNode * inNode, std::vector<OctreeNodeSerialized> * nodes) {
 	if(inNode != NULL) {
 		OctreeNodeSerialized n = OctreeNodeSerialized();
-		n.brushIndex = inNode->vertex.brushIndex;
-		n.hsv = inNode->vertex.hsv;
+		n.brushIndex = inNode->getBrush();
+		n.hsv = inNode->getHSV();
 		n.bits = inNode->bits;
-		SDF::copySDF(inNode->sdf, n.sdf);
+		inNode->getSDF(n.sdf);
 
 		uint index = nodes->size(); 
 		nodes->push_back(n);
@@ -9,8 +9,8 @@ class OctreeNodeFile {
 public:
     OctreeNodeFile(Octree * tree, OctreeNode * node, std::string filename);
     void save(std::string baseFolder);
-    void load(std::string baseFolder, const BoundingCube &cube);
-    OctreeNode * loadRecursive(OctreeNode * node, int i, const BoundingCube &cube, std::vector<OctreeNodeSerialized> * nodes);
+    void load(std::string baseFolder, const OctreeCellKey &key);
+    OctreeNode * loadRecursive(OctreeNode * node, int i, const OctreeCellKey &key, std::vector<OctreeNodeSerialized> * nodes);
     uint saveRecursive(OctreeNode * node, std::vector<OctreeNodeSerialized> * nodes);
 };
 
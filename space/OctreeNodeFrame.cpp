@@ -5,19 +5,19 @@
 
 
 OctreeNodeFrame::OctreeNodeFrame()
-    : node(NULL), iteratedNode(NULL), cube(), type(SpaceType::Empty), level(0), brushIndex(DISCARD_BRUSH_INDEX), hsv(0.0f, 0.5f, 0.5f), chunkCube()
+    : node(NULL), iteratedNode(NULL), cube(), key(), type(SpaceType::Empty), level(0), brushIndex(DISCARD_BRUSH_INDEX), hsv(0.0f, 0.5f, 0.5f), chunkCube()
 {
     for(int i=0;i<8;++i) sdf[i] = INFINITY;
 }
 
 OctreeNodeFrame::OctreeNodeFrame(const OctreeNodeFrame &t)
-    : node(t.node), iteratedNode(t.iteratedNode), cube(t.cube), type(t.type), level(t.level), brushIndex(t.brushIndex), hsv(t.hsv), chunkCube(t.chunkCube)
+    : node(t.node), iteratedNode(t.iteratedNode), cube(t.cube), key(t.key), type(t.type), level(t.level), brushIndex(t.brushIndex), hsv(t.hsv), chunkCube(t.chunkCube)
 {
     std::memcpy(this->sdf, t.sdf, sizeof(this->sdf));
 }
 
-OctreeNodeFrame::OctreeNodeFrame(OctreeNode* node_, OctreeNode* iteratedNode_, const BoundingCube &cube_, SpaceType type_, uint level_, float * sdf_, int brushIndex_, const BoundingCube &chunkCube_)
-    : node(node_), iteratedNode(iteratedNode_), cube(cube_), type(type_), level(level_), brushIndex(brushIndex_), hsv(0.0f, 0.5f, 0.5f), chunkCube(chunkCube_)
+OctreeNodeFrame::OctreeNodeFrame(OctreeNode* node_, OctreeNode* iteratedNode_, const BoundingCube &cube_, const OctreeCellKey &key_, SpaceType type_, float * sdf_, int brushIndex_, const BoundingCube &chunkCube_)
+    : node(node_), iteratedNode(iteratedNode_), cube(cube_), key(key_), type(type_), level(key_.level), brushIndex(brushIndex_), hsv(0.0f, 0.5f, 0.5f), chunkCube(chunkCube_)
 {
     if (sdf_) std::memcpy(this->sdf, sdf_, sizeof(this->sdf)); else for(int i=0;i<8;++i) this->sdf[i]=INFINITY;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "OctreeNode.hpp"
+#include "OctreeCellKey.hpp"
 #include "../math/BoundingCube.hpp"
 #include "../math/BrushMode.hpp"
 #include <glm/glm.hpp>
@@ -11,14 +12,15 @@ struct OctreeNodeFrame {
     OctreeNode* node;
     OctreeNode * iteratedNode; // used for iteration to keep track of the current node being processed, can be different from node when iterating children
     BoundingCube cube;
+    OctreeCellKey key;
     SpaceType type;
-    uint level;
+    uint level;     // == key.level
     float sdf[8];
     int brushIndex;
     glm::vec3 hsv;
     BoundingCube chunkCube;
     OctreeNodeFrame();
     OctreeNodeFrame(const OctreeNodeFrame &t);
-    OctreeNodeFrame(OctreeNode* node, OctreeNode* iteratedNode, const BoundingCube &cube, SpaceType type, uint level, float * sdf, int brushIndex, const BoundingCube &chunkCube);
+    OctreeNodeFrame(OctreeNode* node, OctreeNode* iteratedNode, const BoundingCube &cube, const OctreeCellKey &key, SpaceType type, float * sdf, int brushIndex, const BoundingCube &chunkCube);
 };
 
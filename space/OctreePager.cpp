@@ -0,0 +1,463 @@
+#include "OctreePager.hpp"
+#include "Octree.hpp"
+#include "OctreeAllocator.hpp"
+#include "OctreeSubtree.hpp"
+#include "../math/Math.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+struct PageHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t nodeSize;  // sizeof(OctreeNode): pages do not cross layouts
+    uint32_t count;
+};
+
+constexpr const char kPageMagic[4] = {'O', 'P', 'G', '1'};
+constexpr uint32_t kPageVersion = 1;
+// Stands in for a page that could not be read (restore keeps the stub).
+const std::string kNoPage;
+
+float distanceTo(const glm::vec3 &point, const BoundingCube &cube) {
+    return glm::distance(point, glm::clamp(point, cube.getMin(), cube.getMax()));
+}
+
+// `unit` lies inside `region` or shares a face with it: overlapping on at
+// least two axes and at least touching on the third. Both are cells of the
+// same grid; the tolerance only absorbs float noise on shared boundaries.
+bool withinFaceReach(const BoundingCube &region, const BoundingCube &unit) {
+    const float eps = unit.getLengthX() * 1e-3f;
+    int overlapping = 0;
+    for(int k = 0; k < 3; ++k) {
+        const float overlap = std::min(region.getMax()[k], unit.getMax()[k]) -
+                              std::max(region.getMin()[k], unit.getMin()[k]);
+        if(overlap < -eps) {
+            return false;
+        }
+        if(overlap > eps) {
+            ++overlapping;
+        }
+    }
+    return overlapping >= 2;
+}
+
+} // namespace
+
+OctreePager::OctreePager(Octree &tree, const std::string &folder, const std::string &name)
+    : tree(tree), folder(folder), name(name) {
+    ensureFolderExists(folder);
+}
+
+OctreePager::~OctreePager() {
+    stop();
+    if(tree.pager == this) {
+        tree.pager = nullptr;
+    }
+}
+
+void OctreePager::stop() {
+    io.stop();
+}
+
+void OctreePager::setRemeshHandler(const std::function<void(const OctreeNodeData&)> &handler) {
+    std::lock_guard<std::mutex> lock(mutex);
+    remeshHandler = handler;
+}
+
+size_t OctreePager::update(const glm::vec3 &camera, size_t budgetBytes, float keepDistance) {
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(now - lastUpdate < kUpdateInterval) {
+            return remeshed.exchange(0);
+        }
+        lastUpdate = now;
+        ++tick;
+    }
+
+    struct Unit {
+        BoundingCube cube;
+        bool pagedOut;
+        bool leaf;
+    };
+    std::vector<Unit> units;
+    tree.readLocked([&]() {
+        std::vector<std::pair<OctreeNode*, OctreeCellKey>> stack;
+        if(tree.root != NULL) {
+            stack.emplace_back(tree.root, OctreeCellKey());
+        }
+        while(!stack.empty()) {
+            auto [node, key] = stack.back();
+            stack.pop_back();
+            if(isPageUnit(node)) {
+                units.push_back({key.cube(tree), node->isPagedOut(), node->isLeaf()});
+                continue;
+            }
+            OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+            node->getChildren(*tree.allocator, children);
+            for(int i = 0; i < 8; ++i) {
+                if(children[i] != NULL) {
+                    stack.emplace_back(children[i], key.child(i));
+                }
+            }
+        }
+    });
+    const bool overBudget = budgetBytes > 0 && tree.allocator->getUsedBytes() > budgetBytes;
+
+    struct Candidate {
+        BoundingCube cube;
+        uint64_t lastTouched;
+        float distance;
+    };
+    std::vector<Candidate> candidates;
+    std::lock_guard<std::mutex> lock(mutex);
+    residentCount = 0;
+    for(const Unit &unit : units) {
+        auto [it, created] = entries.try_emplace(unit.cube);
+        Entry &entry = it->second;
+        if(created) {
+            entry.lastTouched = tick;
+        }
+        entry.lastSeen = tick;
+        const float distance = distanceTo(camera, unit.cube);
+        if(unit.pagedOut) {
+            if(distance <= keepDistance) {
+                requestPageIn(entry, unit.cube, false);
+            }
+            continue;
+        }
+        ++residentCount;
+        if(overBudget && !unit.leaf && entry.state == State::Resident &&
+           distance > keepDistance && tick - entry.lastTouched >= kMinIdleTicks) {
+            candidates.push_back({unit.cube, entry.lastTouched, distance});
+        }
+    }
+    // Units gone from the tree (removed by edits) drop their LRU record.
+    for(auto it = entries.begin(); it != entries.end();) {
+        if(it->second.state == State::Resident && it->second.lastSeen != tick) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        if(a.lastTouched != b.lastTouched) {
+            return a.lastTouched < b.lastTouched;
+        }
+        return a.distance > b.distance;
+    });
+    const size_t count = std::min(candidates.size(), kMaxPageOutsPerUpdate);
+    for(size_t i = 0; i < count; ++i) {
+        const BoundingCube cube = candidates[i].cube;
+        entries[cube].state = State::PagingOut;
+        io.enqueueDetached([this, cube, forGeneration = generation]() {
+            pageOut(cube, forGeneration);
+        });
+    }
+    return remeshed.exchange(0);
+}
+
+void OctreePager::touch(const OctreeNode *node, const BoundingCube &cube) {
+    if(!isPageUnit(node)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry &entry = entries[cube];
+    entry.lastTouched = tick;
+    if(node->isPagedOut()) {
+        requestPageIn(entry, cube, false);
+    }
+}
+
+void OctreePager::touchRegion(const OctreeNode *from, const BoundingCube &cube, int targetLod) {
+    if(from != NULL && isPageUnit(from)) {
+        touch(from, cube);
+    }
+    if(!hasPagedOut()) {
+        return;
+    }
+    // Coarse walks read stubs as leaves and are only marked, so their path
+    // re-meshes whenever the unit comes back; faulting them in would page
+    // in everything under the coarse cells.
+    const bool frontier = targetLod <= 1;
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto &[unitCube, entry] : entries) {
+        if(entry.state != State::PagedOut && entry.state != State::PagingIn) {
+            continue;
+        }
+        if(frontier && withinFaceReach(cube, unitCube)) {
+            requestPageIn(entry, unitCube, true);
+        } else if(!frontier && cube.intersects(unitCube)) {
+            entry.remesh = true;
+        }
+    }
+}
+
+void OctreePager::requestPageIn(Entry &entry, const BoundingCube &cube, bool remesh) {
+    if(remesh) {
+        entry.remesh = true;
+    }
+    if(entry.state != State::PagedOut || entry.failedReads >= kMaxReadAttempts) {
+        return;
+    }
+    entry.state = State::PagingIn;
+    io.enqueueDetached([this, cube, forGeneration = generation]() {
+        pageIn(cube, forGeneration);
+    });
+}
+
+void OctreePager::pageOut(const BoundingCube &cube, uint64_t forGeneration) {
+    std::shared_ptr<std::string> data;
+    std::string path;
+    tree.writeLocked([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(cube);
+        if(forGeneration != generation || it == entries.end() || it->second.state != State::PagingOut) {
+            return;
+        }
+        Entry &entry = it->second;
+        entry.state = State::Resident;
+        const OctreeNodeData cell = tree.findCell(cube);
+        OctreeNode * node = cell.node;
+        // Touched or restructured while queued: keep it.
+        if(node == nullptr || !isPageUnit(node) || node->isLeaf() || node->isPagedOut() ||
+           tick - entry.lastTouched < kMinIdleTicks) {
+            return;
+        }
+        auto page = std::make_shared<std::string>();
+        PageHeader header = {};
+        std::memcpy(header.magic, kPageMagic, sizeof(header.magic));
+        header.version = kPageVersion;
+        header.nodeSize = sizeof(OctreeNode);
+        page->append(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint32_t count = 0;
+        writeOctreeSubtree(*tree.allocator, node, *page, count);
+        std::memcpy(page->data() + offsetof(PageHeader, count), &count, sizeof(count));
+
+        node->clear(*tree.allocator, NULL);
+        node->setPagedOut(true);
+        entry.state = State::PagedOut;
+        entry.remesh = false;
+        entry.path = folder + "/" + name + "_" + std::to_string(++fileSequence) + ".page";
+        entry.pending = page;
+        data = page;
+        path = entry.path;
+        evicted.fetch_add(1, std::memory_order_relaxed);
+        pagedOutTotal.fetch_add(1, std::memory_order_relaxed);
+    });
+    if(!data) {
+        return;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if(!file) {
+        // The page stays in memory (pending); paging in still works.
+        std::cerr << "OctreePager::pageOut() Error opening file: " << path << std::endl;
+        return;
+    }
+    bool written = true;
+    try {
+        std::istringstream input(*data);
+        gzipCompressToOfstream(input, file);
+    } catch(const std::exception &e) {
+        std::cerr << "OctreePager::pageOut() " << e.what() << std::endl;
+        written = false;
+    }
+    file.close();
+    if(!written || !file.good()) {
+        // A short write (disk full) must not replace the only copy: the page
+        // stays pending and the partial file goes.
+        std::cerr << "OctreePager::pageOut() Error writing file: " << path << std::endl;
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(cube);
+    if(it != entries.end() && it->second.pending == data) {
+        it->second.pending.reset();
+    }
+}
+
+void OctreePager::pageIn(const BoundingCube &cube, uint64_t forGeneration) {
+    std::shared_ptr<const std::string> data;
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(cube);
+        if(forGeneration != generation || it == entries.end() || it->second.state != State::PagingIn) {
+            return;
+        }
+        data = it->second.pending;
+        path = it->second.path;
+    }
+    // Only this thread writes page files, so the file is complete here.
+    if(!data) {
+        data = readPage(path);
+    }
+    tree.writeLocked([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(cube);
+        // apply may have restored it meanwhile (pageInLocked).
+        if(forGeneration != generation || it == entries.end() || it->second.state != State::PagingIn) {
+            return;
+        }
+        restoreLocked(cube, it->second, data ? *data : kNoPage);
+    });
+}
+
+void OctreePager::pageInLocked(const std::function<bool(const BoundingCube&)> &reaches) {
+    if(!hasPagedOut()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto &[cube, entry] : entries) {
+        if((entry.state != State::PagedOut && entry.state != State::PagingIn) ||
+           entry.failedReads >= kMaxReadAttempts || !reaches(cube)) {
+            continue;
+        }
+        std::shared_ptr<const std::string> data = entry.pending ? entry.pending : readPage(entry.path);
+        restoreLocked(cube, entry, data ? *data : kNoPage);
+    }
+}
+
+void OctreePager::pageInAll() {
+    tree.writeLocked([&]() {
+        pageInLocked([](const BoundingCube&) { return true; });
+    });
+}
+
+void OctreePager::restoreLocked(const BoundingCube &cube, Entry &entry, const std::string &data) {
+    const OctreeNodeData cell = tree.findCell(cube);
+    OctreeNode * node = cell.node;
+    if(node != nullptr && node->isPagedOut()) {
+        size_t pos = 0;
+        bool restored = pageRecords(data, pos);
+        if(restored) {
+            node->setPagedOut(false);
+            restored = readOctreeSubtree(*tree.allocator, node, true, data, pos);
+            if(!restored) {
+                node->clear(*tree.allocator, NULL);
+                node->setPagedOut(true);
+            }
+        }
+        if(!restored) {
+            // The stub, its page file and any pending copy stay as they are,
+            // so nothing of the subtree is lost; the next touch retries.
+            entry.state = State::PagedOut;
+            if(++entry.failedReads == kMaxReadAttempts) {
+                unreadable.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::cerr << "OctreePager::restore() Unreadable page (attempt " << entry.failedReads
+                      << " of " << kMaxReadAttempts << "): " << entry.path << std::endl;
+            return;
+        }
+        if(entry.remesh) {
+            // The stub was meshed as a leaf. Bump the ladder path so the
+            // planner treats it as changed, then queue it.
+            std::vector<OctreeNodeData> path;
+            tree.ladderPath(cell, path);
+            for(const OctreeNodeData &ladderCell : path) {
+                ladderCell.node->bumpVersion();
+            }
+            if(remeshHandler) {
+                remeshHandler(cell);
+                remeshed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        pagedInTotal.fetch_add(1, std::memory_order_relaxed);
+    }
+    if(!entry.path.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(entry.path, ec);
+    }
+    if(entry.failedReads >= kMaxReadAttempts) {
+        unreadable.fetch_sub(1, std::memory_order_relaxed);
+    }
+    entry.state = State::Resident;
+    entry.remesh = false;
+    entry.failedReads = 0;
+    entry.path.clear();
+    entry.pending.reset();
+    entry.lastTouched = tick;
+    evicted.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<const std::string> OctreePager::pageOf(const BoundingCube &cube, std::string &path) const {
+    path.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(cube);
+    if(it == entries.end() || (it->second.state != State::PagedOut && it->second.state != State::PagingIn)) {
+        return nullptr;
+    }
+    path = it->second.path;
+    return it->second.pending;
+}
+
+bool OctreePager::pageRecords(const std::string &data, size_t &pos) {
+    PageHeader header = {};
+    if(data.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    pos = sizeof(header);
+    return std::memcmp(header.magic, kPageMagic, sizeof(header.magic)) == 0 &&
+           header.version == kPageVersion && header.nodeSize == sizeof(OctreeNode);
+}
+
+std::shared_ptr<const std::string> OctreePager::readPage(const std::string &path) const {
+    std::ifstream file(path, std::ios::binary);
+    if(!file) {
+        std::cerr << "OctreePager::readPage() Error opening file: " << path << std::endl;
+        return nullptr;
+    }
+    try {
+        std::stringstream raw = gzipDecompressFromIfstream(file);
+        return std::make_shared<const std::string>(raw.str());
+    } catch(const std::exception &e) {
+        // Truncated or corrupt: callers keep the stub paged out.
+        std::cerr << "OctreePager::readPage() " << e.what() << ": " << path << std::endl;
+        return nullptr;
+    }
+}
+
+void OctreePager::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++generation;
+    for(auto &[cube, entry] : entries) {
+        if(!entry.path.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(entry.path, ec);
+        }
+    }
+    entries.clear();
+    residentCount = 0;
+    evicted.store(0, std::memory_order_relaxed);
+    unreadable.store(0, std::memory_order_relaxed);
+    pagedOutTotal.store(0, std::memory_order_relaxed);
+    pagedInTotal.store(0, std::memory_order_relaxed);
+}
+
+OctreePager::Stats OctreePager::stats() const {
+    Stats result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result.residentChunks = residentCount;
+    }
+    result.evictedChunks = evicted.load(std::memory_order_relaxed);
+    result.unreadablePages = unreadable.load(std::memory_order_relaxed);
+    result.residentBytes = tree.allocator->getUsedBytes();
+    result.pagedOut = pagedOutTotal.load(std::memory_order_relaxed);
+    result.pagedIn = pagedInTotal.load(std::memory_order_relaxed);
+    return result;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include "OctreeNode.hpp"
+#include "OctreeNodeData.hpp"
+#include "ThreadPool.hpp"
+#include "../math/BoundingCube.hpp"
+#include "../math/BoundingCubeHasher.hpp"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class Octree;
+
+// Out-of-core paging for one octree. The page unit is a frontier ladder cell
+// (stored chunkLod == 1, the cells ChunkManager tracks as chunks): nothing
+// below it owns a mesh, so paging its descendants never invalidates a
+// renderer key. A paged-out unit keeps its own node as a stub leaf (corners,
+// vertex, lod and chunkLod intact, OctreeNode::isPagedOut set); its subtree
+// goes to a gzip page file under `folder` and its nodes back to the
+// allocator's free list (the allocator keeps its blocks, so RSS does not
+// shrink; new growth reuses them).
+//
+// Paging out: update() picks resident units beyond the keep distance that
+// no walk touched for a while, least recently used first, then farthest.
+// Paging in happens on the pager's I/O thread when a walk reaches a stub
+// (iterate*, a tessellation covering it) or the camera comes near; apply
+// restores whatever the brush reaches synchronously, because the shape must
+// see the real subtree. A unit meshed while it was a stub is re-meshed once
+// back: its ladder path versions bump and the remesh handler (the layer's
+// change collector) receives it.
+//
+// Locks: the tree lock is always taken before the pager's own mutex.
+class OctreePager {
+public:
+    struct Stats {
+        size_t residentChunks = 0;  // page units in memory (last update)
+        size_t evictedChunks = 0;   // page units on disk
+        size_t unreadablePages = 0; // units kept paged out: their page can't be read
+        size_t residentBytes = 0;   // nodes + child blocks in use
+        uint64_t pagedOut = 0;      // totals since the last reset
+        uint64_t pagedIn = 0;
+    };
+
+    OctreePager(Octree &tree, const std::string &folder, const std::string &name);
+    ~OctreePager();
+
+    static bool isPageUnit(const OctreeNode *node) { return node->getChunkLod() == 1; }
+
+    // Receives each unit that must be re-meshed after paging in.
+    void setRemeshHandler(const std::function<void(const OctreeNodeData&)> &handler);
+
+    // Renderer thread, once per frame (throttled to kUpdateInterval). Pages
+    // in stubs within `keepDistance` of the camera and, while the tree uses
+    // more than `budgetBytes` (0 = unlimited), pages out idle units beyond
+    // it. Returns how many units were handed to the remesh handler since the
+    // last call, so the owner knows to dispatch its change collector.
+    size_t update(const glm::vec3 &camera, size_t budgetBytes, float keepDistance);
+
+    // A walk reached `node` at `cube` (tree read lock held): refreshes its
+    // LRU tick; a stub is queued for paging in.
+    void touch(const OctreeNode *node, const BoundingCube &cube);
+    // A tessellation of `from` at `targetLod` (stored chunkLod space) is
+    // about to read `cube`. At full resolution (targetLod 1) the stubs inside
+    // it and across its faces are queued for paging in and re-meshing; a
+    // coarser walk only marks the stubs it covers or borders for re-meshing
+    // once something else pages them in.
+    void touchRegion(const OctreeNode *from, const BoundingCube &cube, int targetLod);
+    // Restores, before returning, every stub whose cube `reaches` accepts.
+    // Caller holds the tree write lock (apply). A stub whose page cannot be
+    // read stays paged out, and apply's shape passes it by.
+    void pageInLocked(const std::function<bool(const BoundingCube&)> &reaches);
+    // Restores every stub.
+    void pageInAll();
+    // Snapshot support (OctreeFile::writeToStreamSliced), tree read lock
+    // held: the page of the stub at `cube` while it is still in memory,
+    // else null with `path` set to its file (empty when not paged out).
+    // Read the file outside the lock; it is gone once the unit is back.
+    std::shared_ptr<const std::string> pageOf(const BoundingCube &cube, std::string &path) const;
+    // Null when the file is missing, truncated or corrupt.
+    std::shared_ptr<const std::string> readPage(const std::string &path) const;
+    // Checks a page's header and sets `pos` to the unit's own record.
+    static bool pageRecords(const std::string &data, size_t &pos);
+    // The tree was reset: forgets every unit and deletes the page files.
+    void reset();
+    void stop();
+
+    bool hasPagedOut() const { return evicted.load(std::memory_order_relaxed) > 0; }
+    Stats stats() const;
+
+private:
+    enum class State { Resident, PagingOut, PagedOut, PagingIn };
+    struct Entry {
+        State state = State::Resident;
+        uint64_t lastTouched = 0;   // update tick of the last walk visit
+        uint64_t lastSeen = 0;      // update tick the unit last existed
+        bool remesh = false;        // meshed as a stub, re-mesh once restored
+        uint32_t failedReads = 0;   // restores that found the page unreadable
+        std::string path;
+        // The serialized subtree until its file is written (a page in can
+        // race the write).
+        std::shared_ptr<const std::string> pending;
+    };
+
+    static constexpr std::chrono::milliseconds kUpdateInterval{250};
+    // Updates a unit must go untouched before it can be paged out, so the
+    // cells a frame walks stay resident.
+    static constexpr uint64_t kMinIdleTicks = 8;
+    static constexpr size_t kMaxPageOutsPerUpdate = 8;
+    // Restores tried on an unreadable page before the unit is left paged
+    // out for good (its file is kept; see Stats::unreadablePages).
+    static constexpr uint32_t kMaxReadAttempts = 3;
+
+    void requestPageIn(Entry &entry, const BoundingCube &cube, bool remesh);
+    void pageOut(const BoundingCube &cube, uint64_t forGeneration);
+    void pageIn(const BoundingCube &cube, uint64_t forGeneration);
+    // Both locks held. Rebuilds the stub's subtree from the page `data`.
+    void restoreLocked(const BoundingCube &cube, Entry &entry, const std::string &data);
+
+    Octree &tree;
+    std::string folder;
+    std::string name;
+    std::function<void(const OctreeNodeData&)> remeshHandler;
+
+    mutable std::mutex mutex;
+    std::unordered_map<BoundingCube, Entry, BoundingCubeHasher> entries;
+    uint64_t generation = 0;
+    uint64_t tick = 0;
+    uint64_t fileSequence = 0;
+    size_t residentCount = 0;
+    std::chrono::steady_clock::time_point lastUpdate;
+
+    std::atomic<size_t> evicted{0};
+    std::atomic<size_t> unreadable{0};
+    std::atomic<size_t> remeshed{0};
+    std::atomic<uint64_t> pagedOutTotal{0};
+    std::atomic<uint64_t> pagedInTotal{0};
+
+    // One I/O thread: page outs and page ins of a unit run in request order.
+    ThreadPool io = ThreadPool(1);
+};
@@ -0,0 +1,62 @@
+#include "OctreeSubtree.hpp"
+#include "OctreeAllocator.hpp"
+#include "OctreeNode.hpp"
+#include <climits>
+#include <cstring>
+
+bool writeOctreeSubtree(OctreeAllocator &allocator, const OctreeNode *node, std::string &out, uint32_t &count) {
+    if(node->isPagedOut()) {
+        return false;
+    }
+    OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    node->getChildren(allocator, children);
+    uint8_t mask = 0;
+    for(int i = 0; i < 8; ++i) {
+        if(children[i] != NULL) {
+            mask |= uint8_t(1u << i);
+        }
+    }
+    out.append(reinterpret_cast<const char*>(node), sizeof(OctreeNode));
+    out.push_back(static_cast<char>(mask));
+    ++count;
+    for(int i = 0; i < 8; ++i) {
+        if(children[i] != NULL && !writeOctreeSubtree(allocator, children[i], out, count)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readOctreeSubtree(OctreeAllocator &allocator, OctreeNode *node, bool keepNode, const std::string &in, size_t &pos) {
+    if(pos + sizeof(OctreeNode) + 1 > in.size()) {
+        return false;
+    }
+    if(!keepNode) {
+        std::memcpy(static_cast<void*>(node), in.data() + pos, sizeof(OctreeNode));
+        node->blockId = UINT_MAX;
+    }
+    pos += sizeof(OctreeNode);
+    const uint8_t mask = static_cast<uint8_t>(in[pos++]);
+    if(mask == 0) {
+        return true;
+    }
+    // Siblings are allocated together before any of them is read, so they
+    // sit next to each other (getChildren fetches all eight). Each is linked
+    // at once, so a failed restore frees it with the rest of the partial
+    // subtree.
+    ChildBlock * block = node->allocate(allocator)->init();
+    OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    for(int i = 0; i < 8; ++i) {
+        if(mask & (1u << i)) {
+            children[i] = allocator.allocate();
+            children[i]->blockId = UINT_MAX;
+            block->set(i, children[i], allocator);
+        }
+    }
+    for(int i = 0; i < 8; ++i) {
+        if(children[i] != NULL && !readOctreeSubtree(allocator, children[i], false, in, pos)) {
+            return false;
+        }
+    }
+    return true;
+}
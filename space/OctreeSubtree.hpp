@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class OctreeAllocator;
+class OctreeNode;
+
+// Raw subtree records shared by the pager's page files and the scene
+// journal. Pre-order: each node as stored (lod, chunkLod and version
+// included, unlike OctreeNodeFile), then a byte with one bit per present
+// child. Records are only valid for the node layout that wrote them.
+
+// Appends `node` and its descendants to `out`, counting records in `count`.
+// False when the subtree holds a paged-out stub (its data is not here).
+bool writeOctreeSubtree(OctreeAllocator &allocator, const OctreeNode *node, std::string &out, uint32_t &count);
+
+// Rebuilds the children of `node` from the record at `pos`, first copying
+// the record into `node` unless `keepNode`. `node` must be a leaf. Nodes are
+// allocated depth-first with siblings together, so on an ordered free list
+// (OctreeAllocator::holdFrees) the subtree comes out contiguous. False
+// on a truncated record; the partial subtree stays linked so clearing `node`
+// frees it.
+bool readOctreeSubtree(OctreeAllocator &allocator, OctreeNode *node, bool keepNode, const std::string &in, size_t &pos);
@@ -12,12 +12,14 @@ Simplifier::Simplifier(float angle_, float distance_, bool texturing_) {
 
 
 SimplificationResult Simplifier::simplify(
-        const BoundingCube &cube,
+        const BoundingCube &root,
+        const OctreeCellKey &key,
         const float * sdf,
         NodeOperationResult * children,
         const BoundingCube& chunkCube) const 
 {
     SimplificationResult res(0u);
+    const BoundingCube cube = key.cube(root);
     int brushIndex = DISCARD_BRUSH_INDEX;
 
     // --- 1. Brush consistency and simplification-chain check (unchanged) ---
@@ -61,11 +63,13 @@ SimplificationResult Simplifier::simplify(
     // Curved patches (high normal variance) get half the tolerance so sharp
     // ridges and concave features are not smoothed away.
     glm::vec3 avgNormal(0.0f);
+    glm::vec3 childNormals[8];
     int surfaceCount = 0;
     for(uint i = 0; i < 8; ++i) {
         NodeOperationResult * child = &children[i];
         if(child && child->resultType == SpaceType::Surface && child->node) {
-            avgNormal += child->node->vertex.normal;
+            childNormals[i] = child->node->getVertex(key.child(i).cube(root)).normal;
+            avgNormal += childNormals[i];
             ++surfaceCount;
         }
     }
@@ -83,7 +87,7 @@ SimplificationResult Simplifier::simplify(
         for(uint i = 0; i < 8; ++i) {
             NodeOperationResult * child = &children[i];
             if(child && child->resultType == SpaceType::Surface && child->node) {
-                const glm::vec3 n = child->node->vertex.normal;
+                const glm::vec3 n = childNormals[i];
                 const float nLen = glm::length(n);
                 if(nLen > 1e-6f) {
                     minDot = glm::min(minDot, glm::dot(avgNormal, n / nLen));
@@ -108,7 +112,7 @@ SimplificationResult Simplifier::simplify(
     for(uint i = 0; i < 8; ++i) {
         NodeOperationResult * child = &children[i];
         if(child && child->resultType == SpaceType::Surface) {
-            BoundingCube childCube = cube.getChild(i);
+            const BoundingCube childCube = key.child(i).cube(root);
             for(int j = 0; j < 8; ++j) {
                 glm::vec3 corner = childCube.getCorner(j);
                 float d = SDF::interpolate(sdf, corner, cube);
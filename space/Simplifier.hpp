@@ -1,5 +1,6 @@
 #pragma once
 #include "../math/BoundingCube.hpp"
+#include "OctreeCellKey.hpp"
 #include <glm/glm.hpp>
 #include <utility>
 
@@ -21,10 +22,12 @@ class Simplifier {
     bool texturing;
 public:
     Simplifier(float angle, float distance, bool texturing);
+    // `key` addresses the node under `root` (the tree's cube); its children's
+    // cubes come from the key, not from repeated float subdivision.
     // `chunkCube` is the bounding cube of the GPU-upload chunk that this node
     // belongs to.  Direct children of the chunk root are never simplified to
     // guarantee consistent detail at chunk boundaries.
-    SimplificationResult simplify(const BoundingCube &cube, const float * sdf, NodeOperationResult * children, const BoundingCube& chunkCube) const;
+    SimplificationResult simplify(const BoundingCube &root, const OctreeCellKey &key, const float * sdf, NodeOperationResult * children, const BoundingCube& chunkCube) const;
 };
 
  
@@ -0,0 +1,282 @@
+#include "SurfaceNets.hpp"
+#include "Tesselator.hpp"
+#include "../math/BrushMode.hpp"
+#include <bit>
+#include <cstring>
+
+// Mirrors shaders/surface_nets.comp operation for operation; keep the two in
+// step. Built with -ffp-contract=off (Makefile) so no product is fused into
+// an add, exactly like the shader's `precise` results.
+
+namespace {
+
+using namespace SurfaceNets;
+
+// Cells around a line along `axis`, as {du, dv} offsets from the line's low
+// cell, in iterateTriangles' quadrant order (quadrantSigns).
+const int RING[3][4][2] = {
+    {{0, 0}, {0, 1}, {1, 1}, {1, 0}},
+    {{0, 0}, {1, 0}, {1, 1}, {0, 1}},
+    {{0, 0}, {0, 1}, {1, 1}, {1, 0}}
+};
+const int AXIS_U[3] = {1, 0, 0};
+const int AXIS_V[3] = {2, 2, 1};
+
+bool samePosition(const float *a, const float *b, float eps) {
+    const float dx = a[0] - b[0];
+    const float dy = a[1] - b[1];
+    const float dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz <= eps * eps;
+}
+
+bool nonFinite(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return (bits & 0x7F800000u) == 0x7F800000u;
+}
+
+// Triangles of the line along `axis` whose low cell is grid cell `cell`, as
+// grid cell indices (iterateTriangles' emitSegment + emitTriangle for four
+// same-size cells). Returns 0, 1 or 2.
+int lineTriangles(const SurfaceNetsBrick &brick, uint32_t cell, int axis, uint32_t tris[6]) {
+    const uint32_t g = brick.gridSize();
+    const uint32_t n = brick.cells;
+    int c[3] = { int(cell / (g * g)), int((cell / g) % g), int(cell % g) };
+    const int u = AXIS_U[axis];
+    const int v = AXIS_V[axis];
+    // Lines crossing the chunk: segment inside it along the axis, line
+    // coordinates on the chunk's faces or inside (the ring reaches the apron).
+    if(c[axis] < 1 || c[axis] > int(n) || c[u] > int(n) || c[v] > int(n)) {
+        return 0;
+    }
+
+    uint32_t ring[4];
+    bool surface[4];
+    int owner = -1;
+    for(int q = 0; q < 4; ++q) {
+        int r[3] = { c[0], c[1], c[2] };
+        r[u] += RING[axis][q][0];
+        r[v] += RING[axis][q][1];
+        ring[q] = (uint32_t(r[0]) * g + uint32_t(r[1])) * g + uint32_t(r[2]);
+        surface[q] = (brick.grid[ring[q]].flags & FLAG_SURFACE) != 0u;
+        // Same-size cells: the smallest key is the smallest grid index.
+        if(surface[q] && (owner < 0 || ring[q] < ring[owner])) {
+            owner = q;
+        }
+    }
+    if(owner < 0) {
+        return 0;
+    }
+    // Emitted by the chunk containing the owner.
+    const uint32_t o = ring[owner];
+    const int oc[3] = { int(o / (g * g)), int((o / g) % g), int(o % g) };
+    for(int k = 0; k < 3; ++k) {
+        if(oc[k] < 1 || oc[k] > int(n)) {
+            return 0;
+        }
+    }
+    // The owner's corners at both ends of the line.
+    int lc[3];
+    lc[axis] = 0;
+    lc[u] = 1 - RING[axis][owner][0];
+    lc[v] = 1 - RING[axis][owner][1];
+    const int corner0 = (lc[0] << 2) | (lc[1] << 1) | lc[2];
+    const int corner1 = corner0 | (1 << (2 - axis));
+    const uint32_t signs = brick.grid[o].flags & FLAG_SIGNS;
+    const bool solid0 = ((signs >> corner0) & 1u) != 0u;
+    const bool solid1 = ((signs >> corner1) & 1u) != 0u;
+    if(solid0 == solid1) {
+        return 0;
+    }
+
+    // Polygon of the surface cells, consecutive duplicates dropped.
+    uint32_t plist[4];
+    int pcount = 0;
+    for(int q = 0; q < 4; ++q) {
+        if(!surface[q]) {
+            continue;
+        }
+        if(pcount > 0 && samePosition(brick.grid[plist[pcount - 1]].position,
+                                      brick.grid[ring[q]].position, brick.eps)) {
+            continue;
+        }
+        plist[pcount++] = ring[q];
+    }
+    if(pcount > 1 && samePosition(brick.grid[plist[0]].position,
+                                  brick.grid[plist[pcount - 1]].position, brick.eps)) {
+        --pcount;
+    }
+    for(int i = 0; i < pcount; ++i) {
+        for(int j = i + 1; j < pcount; ++j) {
+            if(samePosition(brick.grid[plist[i]].position, brick.grid[plist[j]].position, brick.eps)) {
+                return 0;
+            }
+        }
+    }
+    if(pcount < 3) {
+        return 0;
+    }
+
+    uint32_t candidates[6];
+    int candidateCount;
+    if(pcount == 3) {
+        candidates[0] = plist[0];
+        candidates[1] = solid0 ? plist[1] : plist[2];
+        candidates[2] = solid0 ? plist[2] : plist[1];
+        candidateCount = 1;
+    } else if(solid0) {
+        const uint32_t t[6] = { plist[0], plist[1], plist[2], plist[0], plist[2], plist[3] };
+        std::memcpy(candidates, t, sizeof(t));
+        candidateCount = 2;
+    } else {
+        const uint32_t t[6] = { plist[0], plist[3], plist[2], plist[0], plist[2], plist[1] };
+        std::memcpy(candidates, t, sizeof(t));
+        candidateCount = 2;
+    }
+
+    int count = 0;
+    for(int t = 0; t < candidateCount; ++t) {
+        const SurfaceNetsCell &a = brick.grid[candidates[t * 3 + 0]];
+        const SurfaceNetsCell &b = brick.grid[candidates[t * 3 + 1]];
+        const SurfaceNetsCell &cc = brick.grid[candidates[t * 3 + 2]];
+        if(samePosition(a.position, b.position, brick.eps)
+            || samePosition(b.position, cc.position, brick.eps)
+            || samePosition(cc.position, a.position, brick.eps)) {
+            continue;
+        }
+        if(a.brushIndex <= DISCARD_BRUSH_INDEX || b.brushIndex <= DISCARD_BRUSH_INDEX
+            || cc.brushIndex <= DISCARD_BRUSH_INDEX) {
+            continue;
+        }
+        tris[count * 3 + 0] = candidates[t * 3 + 0];
+        tris[count * 3 + 1] = candidates[t * 3 + 1];
+        tris[count * 3 + 2] = candidates[t * 3 + 2];
+        ++count;
+    }
+    return count;
+}
+
+// Tesselator::handle's triplanarScale.
+constexpr float TRIPLANAR_SCALE = 0.1f;
+
+// The cell's vertex normal: trilinear SDF gradient at the stored position
+// (unnormalised; +Y when a corner carries no data).
+glm::vec3 cellNormal(const SurfaceNetsBrick &brick, uint32_t cell) {
+    const uint32_t g = brick.gridSize();
+    const SurfaceNetsCell &sc = brick.grid[cell];
+    const int ci[3] = { brick.base[0] + int(cell / (g * g)),
+                        brick.base[1] + int((cell / g) % g),
+                        brick.base[2] + int(cell % g) };
+    const float *s = sc.sdf;
+
+    bool finite = true;
+    for(int i = 0; i < 8; ++i) {
+        finite = finite && !nonFinite(s[i]);
+    }
+    if(finite) {
+        float l[3];
+        for(int k = 0; k < 3; ++k) {
+            const float cellMin = brick.rootMin[k] + float(ci[k]) * brick.cellSize;
+            l[k] = (sc.position[k] - cellMin) * brick.invCellSize;
+        }
+        const float x0 = 1.0f - l[0], y0 = 1.0f - l[1], z0 = 1.0f - l[2];
+        const float dx = y0 * z0 * (s[4] - s[0]) + y0 * l[2] * (s[5] - s[1])
+                       + l[1] * z0 * (s[6] - s[2]) + l[1] * l[2] * (s[7] - s[3]);
+        const float dy = x0 * z0 * (s[2] - s[0]) + x0 * l[2] * (s[3] - s[1])
+                       + l[0] * z0 * (s[6] - s[4]) + l[0] * l[2] * (s[7] - s[5]);
+        const float dz = x0 * y0 * (s[1] - s[0]) + x0 * l[1] * (s[3] - s[2])
+                       + l[0] * y0 * (s[5] - s[4]) + l[0] * l[1] * (s[7] - s[6]);
+        if(dx != 0.0f || dy != 0.0f || dz != 0.0f) {
+            return glm::vec3(dx, dy, dz);
+        }
+    }
+    return glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
+// The cell's vertex with the UVs of triplanar plane `plane`.
+Vertex cellVertex(const SurfaceNetsBrick &brick, uint32_t cell, int plane) {
+    const SurfaceNetsCell &sc = brick.grid[cell];
+    Vertex vertex;
+    vertex.position = glm::vec3(sc.position[0], sc.position[1], sc.position[2]);
+    vertex.brushIndex = sc.brushIndex;
+    vertex.hsv = glm::vec3(sc.hsv[0], sc.hsv[1], sc.hsv[2]);
+    vertex.normal = cellNormal(brick, cell);
+    vertex.texCoord = triplanarMapping(vertex.position, plane) * TRIPLANAR_SCALE;
+    return vertex;
+}
+
+// UV plane of a triangle: like Tesselator::handle, its first vertex's.
+int trianglePlane(const SurfaceNetsBrick &brick, const uint32_t *tri) {
+    return triplanarPlane(cellNormal(brick, tri[0]));
+}
+
+// Bit p of masks[cell] is set when a triangle with UV plane p uses the cell:
+// the cell gets one vertex per plane set, since the UVs differ per plane.
+// Returns the index count.
+uint32_t planeMasks(const SurfaceNetsBrick &brick, std::vector<uint32_t> &masks) {
+    const uint32_t total = brick.gridSize() * brick.gridSize() * brick.gridSize();
+    masks.assign(total, 0u);
+    uint32_t indices = 0;
+    uint32_t tris[6];
+    for(uint32_t cell = 0; cell < total; ++cell) {
+        for(int axis = 0; axis < 3; ++axis) {
+            const int count = lineTriangles(brick, cell, axis, tris);
+            for(int t = 0; t < count; ++t) {
+                const uint32_t bit = 1u << trianglePlane(brick, tris + t * 3);
+                for(int k = 0; k < 3; ++k) {
+                    masks[tris[t * 3 + k]] |= bit;
+                }
+            }
+            indices += 3u * uint32_t(count);
+        }
+    }
+    return indices;
+}
+
+} // namespace
+
+void surfaceNetsCount(SurfaceNetsBrick &brick) {
+    std::vector<uint32_t> masks;
+    brick.indexCount = planeMasks(brick, masks);
+    uint32_t vertices = 0;
+    for(uint32_t mask : masks) {
+        vertices += uint32_t(std::popcount(mask));
+    }
+    brick.vertexCount = vertices;
+}
+
+void surfaceNetsReference(const SurfaceNetsBrick &brick,
+                          std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+    std::vector<uint32_t> masks;
+    planeMasks(brick, masks);
+    const uint32_t total = uint32_t(masks.size());
+    // Vertices in grid order (the kernel's scan order), planes ascending
+    // within a cell.
+    std::vector<uint32_t> vertexBase(total, UINT32_MAX);
+    vertices.clear();
+    for(uint32_t cell = 0; cell < total; ++cell) {
+        if(masks[cell] == 0u) {
+            continue;
+        }
+        vertexBase[cell] = uint32_t(vertices.size());
+        for(int plane = 0; plane < 6; ++plane) {
+            if(masks[cell] & (1u << plane)) {
+                vertices.push_back(cellVertex(brick, cell, plane));
+            }
+        }
+    }
+    indices.clear();
+    uint32_t tris[6];
+    for(uint32_t cell = 0; cell < total; ++cell) {
+        for(int axis = 0; axis < 3; ++axis) {
+            const int count = lineTriangles(brick, cell, axis, tris);
+            for(int t = 0; t < count; ++t) {
+                const uint32_t below = (1u << trianglePlane(brick, tris + t * 3)) - 1u;
+                for(int k = 0; k < 3; ++k) {
+                    const uint32_t c = tris[t * 3 + k];
+                    indices.push_back(vertexBase[c] + uint32_t(std::popcount(masks[c] & below)));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "../math/Vertex.hpp"
+#include "../math/BoundingCube.hpp"
+#include "OctreeCellKey.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Surface Nets over a chunk brick: the chunk's cells flattened into a dense
+// grid (one apron cell on every side), meshed either by
+// shaders/surface_nets.comp straight into the IndirectRenderer packed pools or
+// by surfaceNetsReference() below. Both produce the SAME BYTES: the kernel is
+// integer bookkeeping plus IEEE +, -, * only (no division, sqrt or fused
+// multiply-add — the shader marks its results `precise` and this module is
+// built with -ffp-contract=off), so lavapipe output can be diffed against the
+// reference (see surfacenetscheck).
+//
+// The mesh follows iterateTriangles' rules for a uniform region: the node's
+// stored vertex per surface cell, one polygon per crossed cell edge line,
+// emitted by the chunk that owns the line's smallest surface cell, wound by
+// the owner's corner signs. Normals are the trilinear SDF gradient at the
+// vertex, left unnormalised (the vertex shaders normalise). texCoord is
+// Tesselator::handle's triplanar UV: each triangle takes the plane of its
+// first vertex's normal, so a cell gets one vertex per plane its triangles
+// use. morph stays zero.
+//
+// Bricks are built by Octree::buildSurfaceNetsBrick from chunks whose cells
+// all sit at one depth below the chunk (BRICK_MIN_DEPTH..BRICK_MAX_DEPTH) and
+// whose apron cells are that size or absent.
+
+static_assert(sizeof(Vertex) == 64, "surface_nets.comp writes 16-word vertices");
+
+namespace SurfaceNets {
+
+constexpr int BRICK_MIN_DEPTH = 2;
+constexpr int BRICK_MAX_DEPTH = 4;
+constexpr uint32_t MAX_CELLS = 1u << BRICK_MAX_DEPTH;   // chunk cells per axis
+constexpr uint32_t MAX_GRID = MAX_CELLS + 2;            // with the apron
+constexpr uint32_t WORKGROUP_SIZE = 256;                // surface_nets.comp local_size_x
+
+// Cell flags: corner signs (bit i = corner i negative, CUBE_CORNERS order)
+// and whether the cell has a vertex at the walk's resolution.
+constexpr uint32_t FLAG_SIGNS = 0xFFu;
+constexpr uint32_t FLAG_SURFACE = 1u << 8;
+
+} // namespace SurfaceNets
+
+// One grid cell as the shader reads it (16 words, std430).
+struct SurfaceNetsCell {
+    float position[3] = {0.0f, 0.0f, 0.0f};
+    int32_t brushIndex = 0;
+    float hsv[3] = {0.0f, 0.0f, 0.0f};
+    uint32_t flags = 0;
+    float sdf[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+};
+static_assert(sizeof(SurfaceNetsCell) == 64, "SurfaceNetsCell must match surface_nets.comp");
+
+struct SurfaceNetsBrick {
+    uint32_t cells = 0;            // chunk cells per axis (the grid is cells + 2)
+    int32_t base[3] = {0, 0, 0};   // key coordinates of grid cell (0,0,0) (chunk - 1)
+    glm::vec3 rootMin = glm::vec3(0.0f);
+    float cellSize = 0.0f;         // == ldexp(root length, -level)
+    float invCellSize = 0.0f;
+    float eps = 0.0f;              // iterateTriangles' position-equality epsilon
+    std::vector<SurfaceNetsCell> grid;  // x-major: ((x * g) + y) * g + z
+    uint32_t vertexCount = 0;      // exact output sizes (surfaceNetsCount)
+    uint32_t indexCount = 0;
+
+    uint32_t gridSize() const { return cells + 2; }
+};
+
+// Per-brick record at the head of a dispatch's input buffer (32 words). The
+// kernel writes the vertices/indices into the spans given here, then patches
+// draw entry `entryIndex` (command + bounds triple).
+struct SurfaceNetsHeader {
+    uint32_t cellOffset = 0;       // first grid cell (in SurfaceNetsCell units)
+    uint32_t cells = 0;
+    uint32_t baseVertex = 0;
+    uint32_t firstIndex = 0;
+    uint32_t entryIndex = 0;
+    uint32_t vertexCapacity = 0;
+    uint32_t indexCapacity = 0;
+    uint32_t scratchOffset = 0;    // per-cell plane mask + vertex base scratch (uints)
+    int32_t base[3] = {0, 0, 0};
+    float cellSize = 0.0f;
+    float rootMin[3] = {0.0f, 0.0f, 0.0f};
+    float invCellSize = 0.0f;
+    float eps = 0.0f;
+    uint32_t pad[3] = {0, 0, 0};
+    float bounds[12] = {};         // draw entry bounds triple: min, max, LoD meta
+};
+static_assert(sizeof(SurfaceNetsHeader) == 128, "SurfaceNetsHeader must match surface_nets.comp");
+
+// Exact vertex/index counts of the brick's mesh (stored into the brick).
+void surfaceNetsCount(SurfaceNetsBrick &brick);
+
+// The kernel on the CPU: the vertices and indices (local to the vertex span)
+// surface_nets.comp writes for `brick`, byte for byte.
+void surfaceNetsReference(const SurfaceNetsBrick &brick,
+                          std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+
+// Hand-off of a brick-meshed ladder cell by LocalScene::requestModel3D, with
+// the same lod/version/id/cube/key arguments as GeometryLodCallback.
+using SurfaceNetsBrickCallback = std::function<void(
+    std::shared_ptr<const SurfaceNetsBrick> brick,
+    uint8_t lod,
+    unsigned int version,
+    uintptr_t emittingNodeId,
+    const BoundingCube& cube,
+    const OctreeCellKey& key
+)>;
+
+// Optional GPU route for requestModel3D: ladder levels >= minLevel whose
+// cell builds a brick go to onBrick instead of the CPU tessellator.
+struct SurfaceNetsRoute {
+    SurfaceNetsBrickCallback onBrick;
+    uint8_t minLevel = 0;
+};
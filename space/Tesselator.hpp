@@ -5,6 +5,12 @@
 #include "../math/Geometry.hpp"
 #include "../math/Vertex.hpp"
 
+// Triplanar UVs as handle() assigns them: the plane (0-5: +X, -X, +Y, -Y,
+// +Z, -Z) of the dominant normal axis and the position projected onto it.
+// SurfaceNets and shaders/surface_nets.comp mirror both.
+int triplanarPlane(glm::vec3 normal);
+glm::vec2 triplanarMapping(glm::vec3 position, int plane);
+
 // Collects the triangles of ONE tessellated node (one chunk or one ladder
 // ancestor). Each node gets its own Tesselator instance, so the class stays
 // a plain single-geometry collector: per-node meshes are bucketed by level
@@ -0,0 +1,299 @@
+#include "TessellationPlanner.hpp"
+#include "Octree.hpp"
+#include "OctreeNode.hpp"
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
+bool isLadderCellMeshed(const OctreeNode *node) {
+    // atomic_ref needs a mutable object; the load does not write.
+    std::atomic_ref<uint8_t> stamp(const_cast<OctreeNode*>(node)->meshedStamp);
+    return stamp.load(std::memory_order_acquire) != 0;
+}
+
+bool claimLadderCell(OctreeNode *node) {
+    // Versions only bump under the write lock, which also clears the stamp;
+    // claims run under the read lock, so the stamp belongs to the version
+    // the caller checked.
+    std::atomic_ref<uint8_t> stamp(node->meshedStamp);
+    uint8_t unmeshed = 0;
+    return stamp.compare_exchange_strong(unmeshed, 1, std::memory_order_acq_rel);
+}
+
+void planLadderCells(const Octree &tree, const std::vector<OctreeNodeData> &changed,
+                     std::vector<LadderCell> &out) {
+    out.clear();
+    std::unordered_set<const OctreeNode*> seen;
+    std::vector<OctreeNodeData> path;
+    for(const OctreeNodeData &target : changed) {
+        if(target.node == nullptr) {
+            continue;
+        }
+        // Re-keyed: the root may have grown since the change was recorded.
+        const OctreeNodeData current = tree.findCell(target.cube);
+        if(current.node == nullptr) {
+            continue;
+        }
+        path.clear();
+        tree.ladderPath(current, path);
+        for(const OctreeNodeData &cell : path) {
+            if(!seen.insert(cell.node).second || isLadderCellMeshed(cell.node)) {
+                continue;
+            }
+            out.push_back({cell, cell.node->getChunkLod(), cell.node->version});
+        }
+    }
+    std::stable_sort(out.begin(), out.end(), [](const LadderCell &a, const LadderCell &b) {
+        return a.chunkLod < b.chunkLod;
+    });
+}
+
+LadderReuse::LadderReuse(const std::vector<LadderCell> &planned) {
+    for(const LadderCell &cell : planned) {
+        if(cell.chunkLod >= 2) {
+            parents.insert(cell.data.key);
+        }
+    }
+}
+
+bool LadderReuse::wanted(const OctreeCellKey &key) const {
+    return key.level > 0 && parents.count(key.parent()) > 0;
+}
+
+void LadderReuse::put(const OctreeCellKey &key, const OctreeNode *node, unsigned int version,
+                      uint8_t walkLod, const Geometry &geometry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Walk &walk = walks[key];
+    walk.node = node;
+    walk.version = version;
+    walk.walkLod = walkLod;
+    walk.geometry = geometry;
+}
+
+bool LadderReuse::take(const Octree &tree, const OctreeNode *parent, const OctreeCellKey &key,
+                       uint8_t walkLod, Geometry &out) {
+    OctreeNode * children[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+    parent->getChildren(*tree.allocator, children);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<decltype(walks)::iterator> found;
+    for(int i = 0; i < 8; ++i) {
+        if(children[i] == nullptr || children[i]->getType() != SpaceType::Surface) {
+            continue;
+        }
+        const auto it = walks.find(key.child(i));
+        if(it == walks.end() || it->second.node != children[i] ||
+           it->second.version != children[i]->version || it->second.walkLod != walkLod) {
+            return false;
+        }
+        found.push_back(it);
+    }
+    // A leaf (or a cell with no surface child) emits its own triangles.
+    if(found.empty()) {
+        return false;
+    }
+    for(const auto &it : found) {
+        // addTriangle welds the children's shared border vertices.
+        const Geometry &g = it->second.geometry;
+        for(size_t t = 0; t + 2 < g.indices.size(); t += 3) {
+            out.addTriangle(g.vertices[g.indices[t]], g.vertices[g.indices[t + 1]], g.vertices[g.indices[t + 2]]);
+        }
+        walks.erase(it);
+    }
+    return true;
+}
+
+void TessellationScheduler::setView(const glm::vec3 &position, const glm::mat4 &viewProjection) {
+    std::lock_guard<std::mutex> lock(viewMutex);
+    const auto now = std::chrono::steady_clock::now();
+    if(hasView) {
+        if(now - lastRerank < kRerankInterval) {
+            return;
+        }
+        bool changed = glm::distance(position, viewPosition) > 1.0f;
+        for(int c = 0; c < 4 && !changed; ++c) {
+            const glm::vec4 d = glm::abs(viewProjection[c] - viewMatrix[c]);
+            changed = glm::max(glm::max(d.x, d.y), glm::max(d.z, d.w)) > 1e-3f;
+        }
+        if(!changed) {
+            return;
+        }
+    }
+    hasView = true;
+    viewPosition = position;
+    viewMatrix = viewProjection;
+    lastRerank = now;
+    ++viewEpoch;
+}
+
+TessellationScheduler::Counters TessellationScheduler::counters() const {
+    Counters c;
+    c.meshed = meshed_.load(std::memory_order_relaxed);
+    c.cancelled = cancelled_.load(std::memory_order_relaxed);
+    c.wasted = wasted_.load(std::memory_order_relaxed);
+    return c;
+}
+
+void TessellationScheduler::runNext() {
+    Queue *from = nullptr;
+    LadderCell cell;
+    {
+        std::lock_guard<std::mutex> lock(queuesMutex);
+        // Cells only move under queuesMutex, so the best entry seen stays
+        // put while the other queues are looked at.
+        const Queue::Entry *best = nullptr;
+        size_t bestIndex = 0;
+        bool bestReady = false;
+        for(Queue *queue : queues) {
+            std::lock_guard<std::mutex> queueLock(queue->mutex);
+            if(queue->cells.empty()) {
+                continue;
+            }
+            size_t index = 0;
+            const bool ready = queue->pickLocked(index);
+            const Queue::Entry &entry = queue->cells[index];
+            if(best == nullptr || (ready && !bestReady) ||
+               (ready == bestReady && Queue::ranksBefore(entry, *best))) {
+                from = queue;
+                best = &entry;
+                bestIndex = index;
+                bestReady = ready;
+            }
+        }
+        if(from == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> queueLock(from->mutex);
+        cell = from->takeLocked(bestIndex);
+    }
+    // Its batch waits for this cell, so `from` outlives the call.
+    from->mesh(cell);
+    from->finish(cell);
+}
+
+TessellationScheduler::Queue::Queue(TessellationScheduler *owner, std::vector<LadderCell> planned,
+                                    std::function<void(const LadderCell&)> mesh)
+    : scheduler(owner), mesh(std::move(mesh)), plannedCount(planned.size()), unfinished(planned.size()),
+      finishedPromise(std::make_shared<std::promise<void>>()) {
+    finishedFuture = finishedPromise->get_future();
+    std::unordered_set<OctreeCellKey, OctreeCellKeyHasher> keys;
+    for(const LadderCell &cell : planned) {
+        keys.insert(cell.data.key);
+    }
+    for(const LadderCell &cell : planned) {
+        if(cell.data.key.level > 0 && keys.count(cell.data.key.parent()) > 0) {
+            ++unfinishedChildren[cell.data.key.parent()];
+        }
+    }
+    cells.reserve(planned.size());
+    for(auto it = planned.rbegin(); it != planned.rend(); ++it) {
+        cells.push_back({std::move(*it)});
+    }
+    if(unfinished == 0) {
+        finishedPromise->set_value();
+        return;
+    }
+    if(scheduler != nullptr) {
+        std::lock_guard<std::mutex> lock(scheduler->queuesMutex);
+        scheduler->queues.push_back(this);
+    }
+}
+
+TessellationScheduler::Queue::~Queue() {
+    if(scheduler != nullptr) {
+        std::lock_guard<std::mutex> lock(scheduler->queuesMutex);
+        scheduler->queues.erase(std::remove(scheduler->queues.begin(), scheduler->queues.end(), this),
+                                scheduler->queues.end());
+    }
+}
+
+void TessellationScheduler::Queue::runNext() {
+    if(scheduler != nullptr) {
+        scheduler->runNext();
+        return;
+    }
+    LadderCell cell;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(cells.empty()) {
+            return;
+        }
+        size_t index = 0;
+        pickLocked(index);
+        cell = takeLocked(index);
+    }
+    mesh(cell);
+    finish(cell);
+}
+
+bool TessellationScheduler::Queue::ranksBefore(const Entry &a, const Entry &b) {
+    if(a.hidden != b.hidden) return b.hidden;
+    if(a.distance != b.distance) return a.distance < b.distance;
+    return a.cell.chunkLod < b.cell.chunkLod;
+}
+
+bool TessellationScheduler::Queue::pickLocked(size_t &index) {
+    rank();
+    index = cells.size() - 1;
+    for(size_t i = cells.size(); i-- > 0; ) {
+        const auto it = unfinishedChildren.find(cells[i].cell.data.key);
+        if(it == unfinishedChildren.end() || it->second == 0) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+LadderCell TessellationScheduler::Queue::takeLocked(size_t index) {
+    LadderCell cell = std::move(cells[index].cell);
+    cells.erase(cells.begin() + static_cast<std::ptrdiff_t>(index));
+    return cell;
+}
+
+void TessellationScheduler::Queue::finish(const LadderCell &cell) {
+    std::shared_ptr<std::promise<void>> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(cell.data.key.level > 0) {
+            const auto it = unfinishedChildren.find(cell.data.key.parent());
+            if(it != unfinishedChildren.end() && it->second > 0) {
+                --it->second;
+            }
+        }
+        if(--unfinished == 0) {
+            done = finishedPromise;
+        }
+    }
+    // Last touch: the owner may destroy the queue once this is set.
+    if(done) {
+        done->set_value();
+    }
+}
+
+void TessellationScheduler::Queue::rank() {
+    if(scheduler == nullptr) {
+        return;
+    }
+    glm::vec3 position;
+    glm::mat4 viewProjection;
+    {
+        std::lock_guard<std::mutex> lock(scheduler->viewMutex);
+        if(scheduler->viewEpoch == rankedEpoch) {
+            return;
+        }
+        rankedEpoch = scheduler->viewEpoch;
+        position = scheduler->viewPosition;
+        viewProjection = scheduler->viewMatrix;
+    }
+    Frustum frustum(viewProjection);
+    for(Entry &entry : cells) {
+        const BoundingCube &cube = entry.cell.data.cube;
+        const glm::vec3 gap = glm::max(glm::max(cube.getMin() - position, position - cube.getMax()), glm::vec3(0.0f));
+        entry.hidden = frustum.test(cube) == ContainmentType::Disjoint;
+        entry.distance = glm::length(gap);
+    }
+    // Worst first, so the best cell sits at the back.
+    std::stable_sort(cells.begin(), cells.end(), [](const Entry &a, const Entry &b) {
+        return ranksBefore(b, a);
+    });
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include "OctreeNodeData.hpp"
+#include "../math/Frustum.hpp"
+#include "../math/Geometry.hpp"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Octree;
+class OctreeNode;
+
+// Re-mesh planning for one batch of changed nodes (a UniqueChangeCollector
+// dispatch). Every changed ladder cell implies re-meshing the ladder cells on
+// its root path; a brush touching N chunks shares most of those ancestors, so
+// the planner walks each path once into a unique set, drops the cells already
+// meshed at their current version and orders the rest finest level first
+// (frontier chunks publish before the coarse ancestors covering them, which
+// can then reuse their walks, see LadderReuse).
+//
+// The "already meshed" record is OctreeNode::meshedStamp, read and claimed
+// with atomic byte operations: no map, no mutex. A claim made by one batch
+// makes any overlapping batch skip the cell until its version bumps again.
+
+struct LadderCell {
+    OctreeNodeData data;
+    uint8_t chunkLod = 0;   // stored (+1 shifted) ladder level, >= 1
+    unsigned int version = 0; // node version when planned
+};
+
+// Unique ladder cells to re-mesh for `changed`, finest level first, ties in
+// discovery order. Call under the tree read lock (Octree::readLocked); the
+// cells are only a plan afterwards, so whoever meshes one re-resolves it
+// (Octree::findCell) under the lock first.
+void planLadderCells(const Octree &tree, const std::vector<OctreeNodeData> &changed,
+                     std::vector<LadderCell> &out);
+
+// True when `node` was meshed at its current version.
+bool isLadderCellMeshed(const OctreeNode *node);
+
+// Marks `node` meshed at its current version (tree read lock held); false
+// when it already was (another batch got there first), in which case the
+// caller skips it.
+bool claimLadderCell(OctreeNode *node);
+
+// Finer results for coarse cells within one batch. A ladder cell meshed one
+// level finer than its own (the Quadric ladder, LocalScene) walks exactly
+// what its children's own-level walks emit: each line belongs to the child
+// holding its owner cell, and non-surface children own none. Cells whose
+// parent is planned in the same batch leave their raw walk here; the parent,
+// popped after them (finest first), merges its children's walks instead of
+// walking the octree again when every surface child left a current one, and
+// walks as before otherwise.
+class LadderReuse {
+public:
+    explicit LadderReuse(const std::vector<LadderCell> &planned);
+    // True when a walk of `key` may serve its planned parent.
+    bool wanted(const OctreeCellKey &key) const;
+    // Keeps `node`'s raw walk at `walkLod` (stored chunkLod space).
+    void put(const OctreeCellKey &key, const OctreeNode *node, unsigned int version,
+             uint8_t walkLod, const Geometry &geometry);
+    // Merges the walks of `parent`'s children at `walkLod` into `out` and
+    // drops them; false, leaving `out` untouched, when it has no surface
+    // child or one has no walk at its current version. Call under the tree
+    // read lock.
+    bool take(const Octree &tree, const OctreeNode *parent, const OctreeCellKey &key,
+              uint8_t walkLod, Geometry &out);
+
+private:
+    struct Walk {
+        const OctreeNode *node = nullptr;
+        unsigned int version = 0;
+        uint8_t walkLod = 0;
+        Geometry geometry;
+    };
+    std::unordered_set<OctreeCellKey, OctreeCellKeyHasher> parents;
+    std::mutex mutex;
+    std::unordered_map<OctreeCellKey, Walk, OctreeCellKeyHasher> walks;
+};
+
+// Camera-priority ordering and cancellation for planned ladder cells. One
+// scheduler is shared by every stream, and so is its priority queue: each
+// batch registers its cells as a Queue, and every pool task meshes the best
+// cell of all registered batches, whichever batch enqueued the task. A near
+// cell of a new batch therefore goes ahead of far cells of older ones.
+// Ranking puts cells in the view frustum first, then nearest to the camera,
+// then finest level. The renderer publishes the camera every frame, and a
+// moved camera re-ranks the cells still queued (throttled, see setView).
+//
+// Tasks carry the version their cell had when planned. The node version is
+// the one ChunkManager::markDirty records for frontier chunks. A cell whose
+// version moved on before a worker reached it is cancelled: the edit that
+// bumped it queued the newer version through the change collector.
+class TessellationScheduler {
+public:
+    struct Counters {
+        uint64_t meshed = 0;    // cells tessellated (CPU or brick)
+        uint64_t cancelled = 0; // superseded or removed before meshing
+        uint64_t wasted = 0;    // meshed, then overwritten before upload
+    };
+
+    // Renderer thread, once per frame.
+    void setView(const glm::vec3 &position, const glm::mat4 &viewProjection);
+
+    Counters counters() const;
+    void noteMeshed() { meshed_.fetch_add(1, std::memory_order_relaxed); }
+    void noteCancelled() { cancelled_.fetch_add(1, std::memory_order_relaxed); }
+    void noteWasted() { wasted_.fetch_add(1, std::memory_order_relaxed); }
+
+    // One batch's cells, registered with the scheduler while it lives. The
+    // owner enqueues size() tasks that each call runNext(), then waits for
+    // those tasks and for finished(): its cells may be meshed by tasks of
+    // other batches, and its tasks may mesh theirs. A cell still waits for
+    // the planned cells of its batch right below it to finish, so it can
+    // reuse their walks (LadderReuse); when every remaining cell waits, the
+    // best one goes anyway. Without a scheduler the batch ranks alone.
+    class Queue {
+    public:
+        // `planned` in planner order (the fallback until a view is set);
+        // `mesh` tessellates one of them.
+        Queue(TessellationScheduler *owner, std::vector<LadderCell> planned,
+              std::function<void(const LadderCell&)> mesh);
+        ~Queue();
+        Queue(const Queue&) = delete;
+        Queue &operator=(const Queue&) = delete;
+
+        // Pool task body: meshes the best queued cell.
+        void runNext();
+        // Cells planned for this batch.
+        size_t size() const { return plannedCount; }
+        // Ready once every cell of this batch was meshed or dropped.
+        std::future<void> &finished() { return finishedFuture; }
+
+    private:
+        friend class TessellationScheduler;
+        struct Entry {
+            LadderCell cell;
+            bool hidden = false;
+            float distance = 0.0f;
+        };
+        // True when `a` should be meshed before `b`.
+        static bool ranksBefore(const Entry &a, const Entry &b);
+        // Mutex held, cells not empty. Sets `index` to the best cell; false
+        // when it still waits for its children.
+        bool pickLocked(size_t &index);
+        LadderCell takeLocked(size_t index);
+        void finish(const LadderCell &cell);
+        void rank();
+
+        TessellationScheduler *scheduler;
+        std::function<void(const LadderCell&)> mesh;
+        size_t plannedCount = 0;
+        std::mutex mutex;
+        std::vector<Entry> cells;  // worst first: the best is at the back
+        // Planned children not finished yet, per planned parent.
+        std::unordered_map<OctreeCellKey, int, OctreeCellKeyHasher> unfinishedChildren;
+        size_t unfinished = 0;
+        std::shared_ptr<std::promise<void>> finishedPromise;
+        std::future<void> finishedFuture;
+        uint64_t rankedEpoch = 0;
+    };
+
+private:
+    // Re-rank at most this often, and only when the view changed.
+    static constexpr std::chrono::milliseconds kRerankInterval{100};
+
+    // Pops the best cell of every registered queue and meshes it.
+    void runNext();
+
+    mutable std::mutex viewMutex;
+    bool hasView = false;
+    glm::vec3 viewPosition = glm::vec3(0.0f);
+    glm::mat4 viewMatrix = glm::mat4(1.0f);
+    uint64_t viewEpoch = 0;             // 0 = no view yet
+    std::chrono::steady_clock::time_point lastRerank;
+
+    // Registered batches, oldest first. Taken before a queue's mutex; pops
+    // and re-ranks happen under it.
+    std::mutex queuesMutex;
+    std::vector<Queue*> queues;
+
+    std::atomic<uint64_t> meshed_{0};
+    std::atomic<uint64_t> cancelled_{0};
+    std::atomic<uint64_t> wasted_{0};
+};
@@ -24,21 +24,15 @@ namespace tsl {
 #include <shared_mutex>
 #include "../math/BoundingCube.hpp"
 #include "OctreeNodeLevel.hpp"
+#include "OctreeCellKey.hpp"
 
 class ThreadContext {
 public:
-    tsl::robin_map<glm::vec3, float> shapeSdfCache;
-    tsl::robin_map<glm::vec4, OctreeNodeLevel> nodeCache;
-    // Tracks which shifted cubes have already been passed to the border handler
-    // to avoid calling the handler multiple times for the same cube+level.
-    tsl::robin_set<glm::vec4> invokedCubeCalls;
+    // Shape SDF per lattice point (OctreeCellKey::corner/center), shared by
+    // every level of the walk.
+    tsl::robin_map<OctreeCellKey, float, OctreeCellKeyHasher> shapeSdfCache;
+    tsl::robin_map<OctreeCellKey, OctreeNodeLevel, OctreeCellKeyHasher> nodeCache;
     std::shared_mutex mutex;
     BoundingCube cube;
-    // child node -> (parent node, child index within parent). Populated by the
-    // tree traversal (IteratorHandler), seeded with the world-root path to the
-    // chunk root, so neighbor lookups during triangle extraction can rebuild
-    // root-consistent cubes (see Octree::iterateTriangles). The parent link is
-    // NOT stored inside the octree nodes.
-    tsl::robin_map<OctreeNode*, std::pair<OctreeNode*, int>> parentOf;
     ThreadContext(const BoundingCube &cube);
 };
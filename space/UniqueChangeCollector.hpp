@@ -2,6 +2,8 @@
 #include <unordered_map>
 #include <mutex>
 #include <utility>
+#include <vector>
+#include <functional>
 #include "../space/OctreeNodeData.hpp"
 #include "../space/OctreeNode.hpp"
 #include "../space/Octree.hpp"
@@ -48,6 +50,21 @@ public:
         }
     }
 
+    // Batch-aware form: replays per node as above, then hands every ADDED
+    // node of this dispatch to onAddedBatch in one call, so the consumer can
+    // plan shared work (ladder re-meshing, TessellationPlanner.hpp) once per
+    // batch instead of once per node.
+    using BatchHandler = std::function<void(std::vector<OctreeNodeData>&)>;
+    void dispatch(const Octree::OctreeNodeDataHandler& onAdded, const Octree::OctreeNodeDataHandler& onDeleted,
+                  const BatchHandler& onAddedBatch) {
+        std::vector<OctreeNodeData> added;
+        dispatch([&](const OctreeNodeData& data) {
+            if (onAdded) onAdded(data);
+            added.push_back(data);
+        }, onDeleted);
+        if (onAddedBatch && !added.empty()) onAddedBatch(added);
+    }
+
     void clear() {
         std::lock_guard<std::mutex> guard(mtx);
         updates.clear();
@@ -0,0 +1,507 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <vulkan/vulkan.h>
+#include "utils/LocalScene.hpp"
+#include "utils/MainSceneLoader.hpp"
+#include "space/SurfaceNets.hpp"
+#include "space/Tesselator.hpp"
+
+// Surface Nets kernel check: runs shaders/surface_nets.comp headless on the
+// bricks of the MainSceneLoader terrain and compares its output byte for byte
+// with surfaceNetsReference().
+//
+//   make surfacenetscheck
+//   surfacenetscheck [--chunks N] [--gpu]
+//
+// Prefers a CPU Vulkan device (lavapipe) so the check runs without a GPU;
+// --gpu picks the first non-CPU device instead. Needs the compiled shader
+// (bin/shaders/surface_nets.comp.spv, run from the repository root). Bricks
+// are collected through requestModel3D's GPU route over the first N added
+// nodes, exactly as the renderer receives them, and dispatched in batches of
+// BATCH like IndirectRenderer::dispatchSurfaceNets. The reference's UVs are
+// also checked against Tesselator::handle's triplanar rule (every triangle
+// mapped on the plane of its first vertex's normal). Exit status 1 on any
+// mismatch.
+
+namespace {
+
+constexpr uint32_t BATCH = 8;
+constexpr uint32_t GRID_CELLS = SurfaceNets::MAX_GRID * SurfaceNets::MAX_GRID * SurfaceNets::MAX_GRID;
+constexpr uint32_t BINDINGS = 7;
+constexpr uint32_t VERTEX_WORDS = sizeof(Vertex) / sizeof(uint32_t);
+
+#define VK_CHECK(call) \
+    do { \
+        VkResult r_ = (call); \
+        if (r_ != VK_SUCCESS) { \
+            std::fprintf(stderr, "surfacenetscheck: %s failed (%d)\n", #call, static_cast<int>(r_)); \
+            std::exit(1); \
+        } \
+    } while (0)
+
+struct HostBuffer {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+    void* mapped = nullptr;
+};
+
+struct Context {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkPhysicalDevice physical = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueue queue = VK_NULL_HANDLE;
+    uint32_t queueFamily = 0;
+    VkPhysicalDeviceMemoryProperties memory{};
+};
+
+Context createContext(bool preferGpu) {
+    Context ctx;
+    VkApplicationInfo app{};
+    app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app.pApplicationName = "surfacenetscheck";
+    app.apiVersion = VK_API_VERSION_1_1;
+    VkInstanceCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    info.pApplicationInfo = &app;
+    VK_CHECK(vkCreateInstance(&info, nullptr, &ctx.instance));
+
+    uint32_t count = 0;
+    vkEnumeratePhysicalDevices(ctx.instance, &count, nullptr);
+    std::vector<VkPhysicalDevice> devices(count);
+    vkEnumeratePhysicalDevices(ctx.instance, &count, devices.data());
+    for (VkPhysicalDevice pd : devices) {
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(pd, &props);
+        const bool isCpu = props.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+        if (ctx.physical == VK_NULL_HANDLE || isCpu != preferGpu) {
+            ctx.physical = pd;
+            if (isCpu != preferGpu) break;
+        }
+    }
+    if (ctx.physical == VK_NULL_HANDLE) {
+        std::fprintf(stderr, "surfacenetscheck: no Vulkan device\n");
+        std::exit(1);
+    }
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(ctx.physical, &props);
+    std::printf("device  %s\n", props.deviceName);
+    vkGetPhysicalDeviceMemoryProperties(ctx.physical, &ctx.memory);
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.physical, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.physical, &familyCount, families.data());
+    ctx.queueFamily = UINT32_MAX;
+    for (uint32_t i = 0; i < familyCount; ++i) {
+        if (families[i].queueFlags & VK_QUEUE_COMPUTE_BIT) { ctx.queueFamily = i; break; }
+    }
+    if (ctx.queueFamily == UINT32_MAX) {
+        std::fprintf(stderr, "surfacenetscheck: no compute queue\n");
+        std::exit(1);
+    }
+    const float priority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo{};
+    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueInfo.queueFamilyIndex = ctx.queueFamily;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &priority;
+    VkDeviceCreateInfo deviceInfo{};
+    deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pQueueCreateInfos = &queueInfo;
+    VK_CHECK(vkCreateDevice(ctx.physical, &deviceInfo, nullptr, &ctx.device));
+    vkGetDeviceQueue(ctx.device, ctx.queueFamily, 0, &ctx.queue);
+    return ctx;
+}
+
+// Host-visible coherent storage buffer, mapped for its whole life (the check
+// reads the results back directly; speed is not the point here).
+HostBuffer createBuffer(const Context& ctx, VkDeviceSize size) {
+    HostBuffer b;
+    b.size = std::max<VkDeviceSize>(size, 16);
+    VkBufferCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size = b.size;
+    info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VK_CHECK(vkCreateBuffer(ctx.device, &info, nullptr, &b.buffer));
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(ctx.device, b.buffer, &req);
+    const VkMemoryPropertyFlags want = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    uint32_t type = UINT32_MAX;
+    for (uint32_t i = 0; i < ctx.memory.memoryTypeCount; ++i) {
+        if ((req.memoryTypeBits & (1u << i)) && (ctx.memory.memoryTypes[i].propertyFlags & want) == want) {
+            type = i;
+            break;
+        }
+    }
+    if (type == UINT32_MAX) {
+        std::fprintf(stderr, "surfacenetscheck: no host-visible memory type\n");
+        std::exit(1);
+    }
+    VkMemoryAllocateInfo alloc{};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = req.size;
+    alloc.memoryTypeIndex = type;
+    VK_CHECK(vkAllocateMemory(ctx.device, &alloc, nullptr, &b.memory));
+    VK_CHECK(vkBindBufferMemory(ctx.device, b.buffer, b.memory, 0));
+    VK_CHECK(vkMapMemory(ctx.device, b.memory, 0, VK_WHOLE_SIZE, 0, &b.mapped));
+    std::memset(b.mapped, 0, b.size);
+    return b;
+}
+
+void destroyBuffer(const Context& ctx, HostBuffer& b) {
+    if (b.buffer == VK_NULL_HANDLE) return;
+    vkUnmapMemory(ctx.device, b.memory);
+    vkDestroyBuffer(ctx.device, b.buffer, nullptr);
+    vkFreeMemory(ctx.device, b.memory, nullptr);
+    b = HostBuffer{};
+}
+
+std::vector<uint32_t> readSpirv(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return {};
+    const std::streamsize size = file.tellg();
+    std::vector<uint32_t> words(static_cast<size_t>(size) / sizeof(uint32_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+    return words;
+}
+
+struct Kernel {
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+};
+
+Kernel createKernel(const Context& ctx, const std::vector<uint32_t>& spirv) {
+    Kernel k;
+    VkDescriptorSetLayoutBinding bindings[BINDINGS]{};
+    for (uint32_t i = 0; i < BINDINGS; ++i) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+    VkDescriptorSetLayoutCreateInfo setInfo{};
+    setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setInfo.bindingCount = BINDINGS;
+    setInfo.pBindings = bindings;
+    VK_CHECK(vkCreateDescriptorSetLayout(ctx.device, &setInfo, nullptr, &k.setLayout));
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &k.setLayout;
+    VK_CHECK(vkCreatePipelineLayout(ctx.device, &layoutInfo, nullptr, &k.layout));
+
+    VkShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = spirv.size() * sizeof(uint32_t);
+    moduleInfo.pCode = spirv.data();
+    VkShaderModule module;
+    VK_CHECK(vkCreateShaderModule(ctx.device, &moduleInfo, nullptr, &module));
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = module;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = k.layout;
+    VK_CHECK(vkCreateComputePipelines(ctx.device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &k.pipeline));
+    vkDestroyShaderModule(ctx.device, module, nullptr);
+
+    VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, BINDINGS};
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    VK_CHECK(vkCreateDescriptorPool(ctx.device, &poolInfo, nullptr, &k.pool));
+
+    VkCommandPoolCreateInfo commandPoolInfo{};
+    commandPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolInfo.queueFamilyIndex = ctx.queueFamily;
+    VK_CHECK(vkCreateCommandPool(ctx.device, &commandPoolInfo, nullptr, &k.commandPool));
+    return k;
+}
+
+void destroyKernel(const Context& ctx, Kernel& k) {
+    vkDestroyCommandPool(ctx.device, k.commandPool, nullptr);
+    vkDestroyDescriptorPool(ctx.device, k.pool, nullptr);
+    vkDestroyPipeline(ctx.device, k.pipeline, nullptr);
+    vkDestroyPipelineLayout(ctx.device, k.layout, nullptr);
+    vkDestroyDescriptorSetLayout(ctx.device, k.setLayout, nullptr);
+}
+
+// First triangle whose UVs are not Tesselator::handle's, or -1.
+long triplanarMismatch(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const int plane = triplanarPlane(vertices[indices[t]].normal);
+        for (size_t k = 0; k < 3; ++k) {
+            const Vertex& v = vertices[indices[t + k]];
+            const glm::vec2 uv = triplanarMapping(v.position, plane) * 0.1f;
+            if (std::memcmp(&uv, &v.texCoord, sizeof(uv)) != 0) {
+                return static_cast<long>(t / 3);
+            }
+        }
+    }
+    return -1;
+}
+
+struct BatchResult {
+    size_t mismatches = 0;
+    double gpuMs = 0.0;
+};
+
+// One dispatch over `bricks` (at most BATCH), packed into fresh spans the way
+// addBrickSlotted packs them into the pools, then compared with the reference.
+BatchResult runBatch(const Context& ctx, const Kernel& k,
+                     const std::vector<std::shared_ptr<const SurfaceNetsBrick>>& bricks, size_t firstId) {
+    BatchResult result;
+    const uint32_t n = static_cast<uint32_t>(bricks.size());
+    std::vector<SurfaceNetsHeader> headers(n);
+    uint32_t vertexTotal = 0, indexTotal = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const SurfaceNetsBrick& brick = *bricks[i];
+        SurfaceNetsHeader& h = headers[i];
+        h.cellOffset = i * GRID_CELLS;
+        h.scratchOffset = i * GRID_CELLS;
+        h.cells = brick.cells;
+        h.baseVertex = vertexTotal;
+        h.firstIndex = indexTotal;
+        h.entryIndex = i;
+        h.vertexCapacity = brick.vertexCount;
+        h.indexCapacity = brick.indexCount;
+        for (int a = 0; a < 3; ++a) {
+            h.base[a] = brick.base[a];
+            h.rootMin[a] = brick.rootMin[a];
+        }
+        h.cellSize = brick.cellSize;
+        h.invCellSize = brick.invCellSize;
+        h.eps = brick.eps;
+        h.bounds[0] = static_cast<float>(firstId + i);  // any recognisable triple
+        vertexTotal += brick.vertexCount;
+        indexTotal += brick.indexCount;
+    }
+
+    HostBuffer buffers[BINDINGS] = {
+        createBuffer(ctx, sizeof(SurfaceNetsHeader) * n),
+        createBuffer(ctx, sizeof(SurfaceNetsCell) * GRID_CELLS * n),
+        createBuffer(ctx, sizeof(uint32_t) * GRID_CELLS * n),
+        createBuffer(ctx, sizeof(Vertex) * vertexTotal),
+        createBuffer(ctx, sizeof(uint32_t) * indexTotal),
+        createBuffer(ctx, sizeof(VkDrawIndexedIndirectCommand) * n),
+        createBuffer(ctx, sizeof(float) * 12 * n),
+    };
+    std::memcpy(buffers[0].mapped, headers.data(), sizeof(SurfaceNetsHeader) * n);
+    for (uint32_t i = 0; i < n; ++i) {
+        const std::vector<SurfaceNetsCell>& grid = bricks[i]->grid;
+        std::memcpy(static_cast<SurfaceNetsCell*>(buffers[1].mapped) + headers[i].cellOffset,
+                    grid.data(), grid.size() * sizeof(SurfaceNetsCell));
+    }
+
+    VkDescriptorSet set;
+    VkDescriptorSetAllocateInfo setAlloc{};
+    setAlloc.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    setAlloc.descriptorPool = k.pool;
+    setAlloc.descriptorSetCount = 1;
+    setAlloc.pSetLayouts = &k.setLayout;
+    VK_CHECK(vkAllocateDescriptorSets(ctx.device, &setAlloc, &set));
+    VkDescriptorBufferInfo infos[BINDINGS];
+    VkWriteDescriptorSet writes[BINDINGS]{};
+    for (uint32_t i = 0; i < BINDINGS; ++i) {
+        infos[i] = {buffers[i].buffer, 0, VK_WHOLE_SIZE};
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = set;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[i].pBufferInfo = &infos[i];
+    }
+    vkUpdateDescriptorSets(ctx.device, BINDINGS, writes, 0, nullptr);
+
+    VkCommandBuffer cmd;
+    VkCommandBufferAllocateInfo cmdAlloc{};
+    cmdAlloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmdAlloc.commandPool = k.commandPool;
+    cmdAlloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdAlloc.commandBufferCount = 1;
+    VK_CHECK(vkAllocateCommandBuffers(ctx.device, &cmdAlloc, &cmd));
+    VkCommandBufferBeginInfo begin{};
+    begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK(vkBeginCommandBuffer(cmd, &begin));
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, k.pipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, k.layout, 0, 1, &set, 0, nullptr);
+    vkCmdDispatch(cmd, n, 1, 1);
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+    VK_CHECK(vkEndCommandBuffer(cmd));
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence;
+    VK_CHECK(vkCreateFence(ctx.device, &fenceInfo, nullptr, &fence));
+    VkSubmitInfo submit{};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &cmd;
+    const auto t0 = std::chrono::steady_clock::now();
+    VK_CHECK(vkQueueSubmit(ctx.queue, 1, &submit, fence));
+    VK_CHECK(vkWaitForFences(ctx.device, 1, &fence, VK_TRUE, UINT64_MAX));
+    result.gpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    vkDestroyFence(ctx.device, fence, nullptr);
+    vkFreeCommandBuffers(ctx.device, k.commandPool, 1, &cmd);
+    vkFreeDescriptorSets(ctx.device, k.pool, 1, &set);
+
+    const auto* gpuVertices = static_cast<const uint32_t*>(buffers[3].mapped);
+    const auto* gpuIndices = static_cast<const uint32_t*>(buffers[4].mapped);
+    const auto* gpuCmds = static_cast<const VkDrawIndexedIndirectCommand*>(buffers[5].mapped);
+    const auto* gpuBounds = static_cast<const float*>(buffers[6].mapped);
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < n; ++i) {
+        const SurfaceNetsHeader& h = headers[i];
+        surfaceNetsReference(*bricks[i], vertices, indices);
+        std::vector<std::string> errors;
+        if (vertices.size() != h.vertexCapacity || indices.size() != h.indexCapacity) {
+            errors.push_back("reference size differs from surfaceNetsCount");
+        }
+        const long badUv = triplanarMismatch(vertices, indices);
+        if (badUv >= 0) {
+            errors.push_back("reference texCoord of triangle " + std::to_string(badUv));
+        }
+        const VkDrawIndexedIndirectCommand& c = gpuCmds[i];
+        if (c.indexCount != h.indexCapacity || c.instanceCount != 1 || c.firstIndex != h.firstIndex ||
+            c.vertexOffset != static_cast<int32_t>(h.baseVertex) || c.firstInstance != h.entryIndex) {
+            errors.push_back("draw command");
+        }
+        if (std::memcmp(gpuBounds + 12 * i, h.bounds, sizeof(h.bounds)) != 0) {
+            errors.push_back("bounds triple");
+        }
+        const size_t vertexCount = std::min<size_t>(vertices.size(), h.vertexCapacity);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            if (std::memcmp(gpuVertices + (h.baseVertex + v) * VERTEX_WORDS, &vertices[v], sizeof(Vertex)) != 0) {
+                errors.push_back("vertex " + std::to_string(v));
+                break;
+            }
+        }
+        const size_t indexCount = std::min<size_t>(indices.size(), h.indexCapacity);
+        for (size_t x = 0; x < indexCount; ++x) {
+            if (gpuIndices[h.firstIndex + x] != indices[x]) {
+                errors.push_back("index " + std::to_string(x));
+                break;
+            }
+        }
+        if (!errors.empty()) {
+            ++result.mismatches;
+            std::printf("brick %zu (%u cells, %u vertices, %u indices): mismatch in",
+                        firstId + i, h.cells, h.vertexCapacity, h.indexCapacity);
+            for (const std::string& e : errors) std::printf(" [%s]", e.c_str());
+            std::printf("\n");
+        }
+    }
+    for (HostBuffer& b : buffers) destroyBuffer(ctx, b);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t maxChunks = 256;
+    bool preferGpu = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--chunks" && i + 1 < argc) { maxChunks = std::stoul(argv[++i]); continue; }
+        if (arg == "--gpu") { preferGpu = true; continue; }
+        std::cerr << "usage: surfacenetscheck [--chunks N] [--gpu]\n";
+        return 1;
+    }
+
+    const std::vector<uint32_t> spirv = readSpirv("bin/shaders/surface_nets.comp.spv");
+    if (spirv.empty()) {
+        std::cerr << "surfacenetscheck: bin/shaders/surface_nets.comp.spv not found (make shaders)\n";
+        return 1;
+    }
+
+    std::vector<OctreeNodeData> added;
+    std::mutex addedMutex;
+    Octree::OctreeNodeDataHandler onAdded = [&](const OctreeNodeData& nd) {
+        std::lock_guard<std::mutex> lock(addedMutex);
+        added.push_back(nd);
+    };
+    Octree::OctreeNodeDataHandler ignore = [](const OctreeNodeData&) {};
+
+    LocalScene scene;
+    MainSceneLoader loader;
+    scene.loadScene(loader, onAdded, ignore, ignore, ignore);
+
+    // Collect every brick the renderer would receive; cells the brick
+    // builder rejects are tessellated on the CPU and only counted.
+    std::vector<std::shared_ptr<const SurfaceNetsBrick>> bricks;
+    size_t cpuCells = 0;
+    std::mutex collectMutex;
+    SurfaceNetsRoute route;
+    route.onBrick = [&](std::shared_ptr<const SurfaceNetsBrick> brick, uint8_t, unsigned int, uintptr_t, const BoundingCube&, const OctreeCellKey&) {
+        std::lock_guard<std::mutex> lock(collectMutex);
+        bricks.push_back(std::move(brick));
+    };
+    size_t chunks = 0;
+    const auto build0 = std::chrono::steady_clock::now();
+    for (OctreeNodeData& nd : added) {
+        if (chunks >= maxChunks) break;
+        if (!nd.node) continue;
+        ++chunks;
+        scene.requestModel3D(LAYER_OPAQUE, nd,
+            [&](const Geometry&, uint8_t, uint, uintptr_t, const BoundingCube&, const OctreeCellKey&) {
+                std::lock_guard<std::mutex> lock(collectMutex);
+                ++cpuCells;
+            }, nullptr, &route);
+    }
+    const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build0).count();
+    size_t triangles = 0;
+    for (const auto& b : bricks) triangles += b->indexCount / 3;
+    std::printf("requests %zu  bricks %zu (%zu triangles)  cpu-meshed cells %zu  build %.2f ms\n",
+                chunks, bricks.size(), triangles, cpuCells, buildMs);
+    if (bricks.empty()) {
+        std::cerr << "surfacenetscheck: no brick-meshed cells\n";
+        return 1;
+    }
+
+    Context ctx = createContext(preferGpu);
+    Kernel kernel = createKernel(ctx, spirv);
+    size_t mismatches = 0;
+    double gpuMs = 0.0;
+    for (size_t first = 0; first < bricks.size(); first += BATCH) {
+        const size_t last = std::min(bricks.size(), first + BATCH);
+        const std::vector<std::shared_ptr<const SurfaceNetsBrick>> batch(bricks.begin() + first, bricks.begin() + last);
+        const BatchResult r = runBatch(ctx, kernel, batch, first);
+        mismatches += r.mismatches;
+        gpuMs += r.gpuMs;
+    }
+    destroyKernel(ctx, kernel);
+    vkDestroyDevice(ctx.device, nullptr);
+    vkDestroyInstance(ctx.instance, nullptr);
+
+    std::printf("kernel  %.2f ms total (submit + wait, batches of %u)\n", gpuMs, BATCH);
+    std::printf("%s  %zu / %zu bricks differ from surfaceNetsReference\n",
+                mismatches == 0 ? "OK" : "FAIL", mismatches, bricks.size());
+    return mismatches == 0 ? 0 : 1;
+}
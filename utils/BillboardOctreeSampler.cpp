@@ -7,8 +7,8 @@ std::vector<glm::vec3> BillboardOctreeSampler::collectGrassPositions(Octree& oct
         [&positions](const Octree &treeRef, OctreeNodeData &params) {
             // Only process leaf nodes
             bool result = params.node && !params.node->isLeaf();
-            if (params.node && params.node->vertex.brushIndex == 4) {
-                positions.push_back(params.node->vertex.position);
+            if (params.node && params.node->getBrush() == 4) {
+                positions.push_back(params.node->getPosition(params.cube));
             }
             return result;
         },
@@ -2,6 +2,7 @@
 #include "../space/OctreeFile.hpp"
 #include "../space/OctreeNode.hpp"
 #include "../space/OctreeAllocator.hpp"
+#include "../space/MeshSimplifier.hpp"
 #include "../sdf/SDF.hpp"
 #include "../math/Math.hpp"
 #include <iostream>
@@ -9,21 +10,39 @@
 #include <fstream>
 #include <sstream>
 #include <cstring>
+#include <cstddef>
 #include <algorithm>
 #include <cmath>
 #include <cfloat>
 #include <glm/glm.hpp>
 #include <filesystem>
+#include <random>
 
 namespace {
 struct SceneBundleHeader {
     char magic[8];
     uint32_t version;
     uint32_t hasSettings;
+    // Version 2: the key the bundle's autosave journal is replayed under.
+    // Version 1 ends before it and reads as generation 0.
+    uint64_t generation;
 };
 
 constexpr const char kSceneBundleMagic[8] = {'S', 'C', 'N', 'B', 'N', 'D', 'L', '1'};
-constexpr uint32_t kSceneBundleVersion = 1;
+constexpr uint32_t kSceneBundleVersion = 2;
+// Snapshots restarted because an edit grew a root under them.
+constexpr int kMaxSnapshotAttempts = 3;
+
+// Random, so no journal left by another save of the same path (an older
+// base, a bundle copied over this one) shares it. 0 stays version 1's.
+uint64_t newBundleGeneration(uint64_t previous) {
+    std::random_device device;
+    uint64_t generation = 0;
+    while (generation == 0 || generation == previous) {
+        generation = (static_cast<uint64_t>(device()) << 32) | device();
+    }
+    return generation;
+}
 }
 
 LocalScene::LocalScene()
@@ -37,6 +56,11 @@ LocalScene::~LocalScene() = default;
 
 void LocalScene::stopPools() {
     threadPool.stop();
+    if (opaquePager) opaquePager->stop();
+    if (transparentPager) transparentPager->stop();
+    if (opaqueCompactor) opaqueCompactor->stop();
+    if (transparentCompactor) transparentCompactor->stop();
+    if (journal) journal->stop();
     opaqueOctree.threadPool.stop();
     transparentOctree.threadPool.stop();
 }
@@ -45,75 +69,111 @@ Octree& LocalScene::getOpaqueOctree() { return opaqueOctree; }
 const Octree& LocalScene::getOpaqueOctree() const { return opaqueOctree; }
 
 
-void LocalScene::requestModel3D(Layer layer, OctreeNodeData &data, const GeometryLodCallback& callback, ThreadPool* poolOverride) {
+void LocalScene::requestModel3D(Layer layer, OctreeNodeData &data, const GeometryLodCallback& callback, ThreadPool* poolOverride,
+                                const SurfaceNetsRoute* gpuRoute) {
+    requestModel3DBatch(layer, std::vector<OctreeNodeData>{data}, callback, poolOverride, gpuRoute);
+}
+
+void LocalScene::requestModel3DBatch(Layer layer, const std::vector<OctreeNodeData> &changed, const GeometryLodCallback& callback,
+                                     ThreadPool* poolOverride, const SurfaceNetsRoute* gpuRoute, TessellationScheduler* scheduler) {
     Octree* tree = layer == LAYER_OPAQUE ? &opaqueOctree : &transparentOctree;
-    ThreadContext context = ThreadContext(data.cube);
+    ThreadPool& pool = poolOverride ? *poolOverride : tree->threadPool;
+    std::vector<LadderCell> cells;
+    tree->readLocked([&]() {
+        planLadderCells(*tree, changed, cells);
+    });
+    // The lock is not held across the batch: edits (Octree::apply) land
+    // between cells, and each cell re-resolves itself when a worker pops it.
+    // Tasks mesh the best queued cell of any batch, not a fixed one.
+    LadderReuse reuse(cells);
+    TessellationScheduler::Queue queue(scheduler, std::move(cells), [&](const LadderCell &cell) {
+        tessellateLadderCell(*tree, cell, callback, gpuRoute, scheduler, &reuse);
+    });
+    const size_t count = queue.size();
+    std::vector<std::future<void>> done;
+    done.reserve(count);
+    for(size_t i = 0; i < count; ++i) {
+        done.push_back(pool.enqueue([&queue]() {
+            queue.runNext();
+        }));
+    }
+    for(std::future<void>& f : done) {
+        pool.getCooperative(f);
+    }
+    // Cells of this batch may still run in tasks of other batches.
+    pool.getCooperative(queue.finished());
+}
 
-    tree->iterateMultiThreaded(
-        [this, tree,&data,&context,&callback](const Octree &treeRef, OctreeNodeData &params) {
-            if(params.node->getType() != SpaceType::Surface) {
-                return false;
+void LocalScene::tessellateLadderCell(Octree &tree, const LadderCell &cell, const GeometryLodCallback& callback,
+                                      const SurfaceNetsRoute* gpuRoute, TessellationScheduler* scheduler,
+                                      LadderReuse* reuse) {
+    tree.readLocked([&]() {
+        const OctreeNodeData current = tree.findCell(cell.data.cube);
+        OctreeNode* node = current.node;
+        // Superseded (edited again: that edit queued the newer version) or
+        // removed since planning.
+        if(node != cell.data.node || node->version != cell.version || node->getChunkLod() != cell.chunkLod) {
+            if(scheduler) scheduler->noteCancelled();
+            return;
+        }
+        const unsigned int version = cell.version;
+        // Versions only bump in the change walk (edits), so a cell claimed at
+        // its current version already has a current mesh.
+        if(!claimLadderCell(node)) {
+            return;
+        }
+        if(scheduler) scheduler->noteMeshed();
+        const uint8_t chunkLodStored = cell.chunkLod;
+        const uintptr_t nodeId = reinterpret_cast<uintptr_t>(node);
+        // GPU route: uniformly refined cells ship their brick instead;
+        // anything the brick builder rejects falls through to the CPU.
+        if (gpuRoute != nullptr && chunkLodStored - 1 >= gpuRoute->minLevel) {
+            auto brick = std::make_shared<SurfaceNetsBrick>();
+            if (tree.buildSurfaceNetsBrick(node, current.key, chunkLodStored, *brick)) {
+                if (brick->indexCount > 0) {
+                    gpuRoute->onBrick(brick, chunkLodStored - 1, version, nodeId, current.cube, current.key);
+                }
+                return;
             }
-
-            if(!params.cube.contains(data.cube.getCenter())) {
-                return false;
+        }
+        long trianglesCount = 0;
+        Tesselator nodeTesselator(&trianglesCount);
+        const bool quadricLadder = ladderSimplifier.load(std::memory_order_relaxed) == LadderSimplifier::Quadric;
+        const bool quadric = chunkLodStored >= 2 && quadricLadder;
+        const uint8_t walkLod = quadric ? chunkLodStored - 1 : chunkLodStored;
+        // The one-level-finer walk is the union of the children's own walks.
+        if(!(quadric && reuse && reuse->take(tree, node, current.key, walkLod, nodeTesselator.geometry))) {
+            tree.iterateTriangles(node, current.key, nodeTesselator, walkLod);
+            // Raw, before simplification: what the parent's finer walk emits here.
+            if(quadricLadder && reuse && walkLod == chunkLodStored && reuse->wanted(current.key)) {
+                reuse->put(current.key, node, version, walkLod, nodeTesselator.geometry);
             }
-
-            uint8_t chunkLodStored = params.node->getChunkLod();
-
-            if(chunkLodStored > 0) {
-                const uintptr_t nodeId = reinterpret_cast<uintptr_t>(params.node);
-                // Skip cells already tessellated at their current version: the
-                // walk emits the whole root path for every added node, so
-                // without this each cell would be re-tessellated once per added
-                // descendant during load (and its mesh re-uploaded). Versions
-                // only bump in the change walk (edits), so a matching version
-                // proves the mesh is still current.
-                bool skip = false;
-                {
-                    std::lock_guard<std::mutex> lock(emittedMutex_);
-                    auto it = emittedVersion_.find(nodeId);
-                    skip = (it != emittedVersion_.end() && it->second == params.node->version);
-                }
-                if (!skip) {
-                    long trianglesCount = 0;
-                    Tesselator nodeTesselator(&trianglesCount);
-                    tree->iterateTriangles(params.node, params.cube, params.level, nodeTesselator, &context, chunkLodStored);
-                    {
-                        std::lock_guard<std::mutex> lock(emittedMutex_);
-                        emittedVersion_[nodeId] = params.node->version;
-                    }
-                    if(!nodeTesselator.geometry.indices.empty()) {
-                        callback(nodeTesselator.geometry, chunkLodStored - 1, params.node->version,
-                                 reinterpret_cast<uintptr_t>(params.node), params.cube);
-                    }
-                }
+        }
+        if(nodeTesselator.geometry.indices.empty()) {
+            return;
+        }
+        if(quadric) {
+            // The finer walk's spacing is half this level's: allow collapses
+            // up to the error the level's own sampling would have, and lock
+            // the border strip so neighbours at this level still meet.
+            const float spacing = meshVertexSpacing(nodeTesselator.geometry, current.cube.getLengthX());
+            QuadricSimplifyParams params;
+            params.maxError = spacing;
+            params.borderStrip = spacing;
+            Geometry simplified;
+            if(spacing > 0.0f && simplifyQuadric(nodeTesselator.geometry, params, current.cube, simplified)) {
+                callback(simplified, chunkLodStored - 1, version, nodeId, current.cube, current.key);
+                return;
             }
-            // Keep descending along the root path: the children hold the finer ladder
-            // levels. Cells without a chunkLod (stored 0) never tessellate and end the
-            // walk — their parent links are already propagated for neighbor lookups.
-            return chunkLodStored > 0;
-        },
-        [](const Octree &treeRef, OctreeNodeData &params, uint8_t order[8]) {
-            for(int i = 0 ; i < 8 ; ++i) {
-                order[i] = i;
-            }   
-        },
-        [tree,&data,&context](const Octree &treeRef, OctreeNodeData &params) {
-            return params.node ? params.node->chunkLod > 0 : false;
         }
-    );
+        callback(nodeTesselator.geometry, chunkLodStored - 1, version, nodeId, current.cube, current.key);
+    });
 }
 
 bool LocalScene::isNodeUpToDate(Layer layer, OctreeNodeData &data, uint version) {
     return data.node->version >= version;
 }
 
-void LocalScene::noteDeletedNode(uintptr_t nodeId) {
-    std::lock_guard<std::mutex> lock(emittedMutex_);
-    emittedVersion_.erase(nodeId);
-}
-
 int LocalScene::maxChunkLod(Layer layer, float minSize) const {
     // The number of LoD levels a chunk can hold above its tessellation
     // frontier before reaching the chunk-size boundary, clamped to the
@@ -147,7 +207,88 @@ void LocalScene::action(SceneLoaderCallback& callback, Octree::OctreeNodeDataHan
     std::cout << "LocalScene::action Ok! " << std::to_string(elapsed) << "s"  << std::endl;
 }
 
+void LocalScene::enablePaging(const std::string& folder, Octree::OctreeNodeDataHandler opaqueRemeshHandler, Octree::OctreeNodeDataHandler transparentRemeshHandler) {
+    if (!opaquePager) {
+        opaquePager = std::make_unique<OctreePager>(opaqueOctree, folder, "opaque");
+        opaqueOctree.pager = opaquePager.get();
+    }
+    if (!transparentPager) {
+        transparentPager = std::make_unique<OctreePager>(transparentOctree, folder, "transparent");
+        transparentOctree.pager = transparentPager.get();
+    }
+    opaquePager->setRemeshHandler(opaqueRemeshHandler);
+    transparentPager->setRemeshHandler(transparentRemeshHandler);
+}
+
+LocalScene::PagingUpdate LocalScene::updatePaging(const glm::vec3& camera, size_t budgetBytes, float keepDistance) {
+    PagingUpdate result;
+    if (opaquePager) result.opaqueRemeshed = opaquePager->update(camera, budgetBytes, keepDistance);
+    if (transparentPager) result.transparentRemeshed = transparentPager->update(camera, budgetBytes, keepDistance);
+    return result;
+}
+
+OctreePager::Stats LocalScene::pagingStats(Layer layer) const {
+    const std::unique_ptr<OctreePager>& pager = layer == LAYER_OPAQUE ? opaquePager : transparentPager;
+    return pager ? pager->stats() : OctreePager::Stats();
+}
+
+void LocalScene::enableCompaction() {
+    if (!opaqueCompactor) opaqueCompactor = std::make_unique<OctreeCompactor>(opaqueOctree);
+    if (!transparentCompactor) transparentCompactor = std::make_unique<OctreeCompactor>(transparentOctree);
+}
+
+void LocalScene::updateCompaction() {
+    if (opaqueCompactor) opaqueCompactor->update();
+    if (transparentCompactor) transparentCompactor->update();
+}
+
+OctreeCompactor::Stats LocalScene::compactionStats(Layer layer) const {
+    const std::unique_ptr<OctreeCompactor>& compactor = layer == LAYER_OPAQUE ? opaqueCompactor : transparentCompactor;
+    return compactor ? compactor->stats() : OctreeCompactor::Stats();
+}
+
+void LocalScene::enableJournal() {
+    if (!journal) {
+        journal = std::make_unique<SceneJournal>(opaqueOctree, transparentOctree, threadPool);
+    }
+}
+
+void LocalScene::autosave(const Settings* settings, size_t compactBytes) {
+    if (!journal || !journal->isAttached() || journal->autosaveQueued.exchange(true)) {
+        return;
+    }
+    std::shared_ptr<Settings> snapshot = settings ? std::make_shared<Settings>(*settings) : nullptr;
+    journal->io().enqueueDetached([this, snapshot, compactBytes]() {
+        journal->autosaveQueued = false;
+        const std::string bundlePath = journal->bundlePath();
+        if (bundlePath.empty()) {
+            return;
+        }
+        if (!journal->checkpoint() || (compactBytes > 0 && journal->journalBytes() > compactBytes)) {
+            save(bundlePath, snapshot.get());
+        }
+    });
+}
+
+void LocalScene::flushAutosave() {
+    if (journal) {
+        std::future<void> done = journal->io().enqueue([]() {});
+        done.wait();
+    }
+}
+
+void LocalScene::detachJournal() {
+    if (journal) {
+        std::lock_guard<std::mutex> lock(journal->fileMutex());
+        journal->detach();
+    }
+}
+
 void LocalScene::save(const std::string& filePath, const Settings* settings) {
+    // Autosave checkpoints and compacts on the journal thread: one at a time.
+    std::unique_lock<std::mutex> journalLock;
+    if (journal) journalLock = std::unique_lock<std::mutex>(journal->fileMutex());
+
     OctreeFile opaqueSaver(&opaqueOctree, "opaque");
     OctreeFile transparentSaver(&transparentOctree, "transparent");
 
@@ -156,34 +297,77 @@ void LocalScene::save(const std::string& filePath, const Settings* settings) {
         std::filesystem::create_directories(outPath.parent_path());
     }
 
-    std::ofstream file(filePath, std::ios::binary);
-    if (!file) {
-        std::cerr << "LocalScene::save() Error opening file: " << filePath << std::endl;
-        return;
-    }
-
-    std::ostringstream raw;
+    const uint64_t generation = newBundleGeneration(bundleGeneration);
     SceneBundleHeader header = {};
     std::memcpy(header.magic, kSceneBundleMagic, sizeof(header.magic));
     header.version = kSceneBundleVersion;
     header.hasSettings = settings ? 1u : 0u;
-    raw.write(reinterpret_cast<const char*>(&header), sizeof(header));
-
-    opaqueSaver.writeToStream(raw);
-    transparentSaver.writeToStream(raw);
+    header.generation = generation;
+
+    // The trees are written a chunk at a time under short read locks, and
+    // paged-out chunks straight from their page files, so edits, meshing and
+    // paging go on meanwhile (this may run in the background). The journal
+    // attaches first: whatever an edit changes after that is checkpointed
+    // and replayed over the snapshot. Without a journal the caller keeps
+    // edits out while saving. A root grown mid-snapshot moves every chunk
+    // key: start over.
+    std::ostringstream raw;
+    bool written = false;
+    for (int attempt = 0; attempt < kMaxSnapshotAttempts && !written; ++attempt) {
+        raw.str("");
+        raw.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (journal) {
+            opaqueOctree.readLocked([&]() {
+                transparentOctree.readLocked([&]() {
+                    journal->attachLocked(filePath, generation);
+                });
+            });
+        }
+        written = opaqueSaver.writeToStreamSliced(raw) && transparentSaver.writeToStreamSliced(raw);
+    }
+    if (!written) {
+        std::cerr << "LocalScene::save() The octree root kept growing: " << filePath << std::endl;
+        if (journal) journal->detach();
+        return;
+    }
 
     if (settings) {
         raw.write(reinterpret_cast<const char*>(settings), sizeof(Settings));
     }
 
+    // Written aside and renamed over the bundle, so a crash mid-write leaves
+    // the previous bundle (and its journal) intact.
+    const std::string tempPath = filePath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary);
+    if (!file) {
+        std::cerr << "LocalScene::save() Error opening file: " << tempPath << std::endl;
+        if (journal) journal->detach();
+        return;
+    }
     std::istringstream input(raw.str());
     gzipCompressToOfstream(input, file);
     file.close();
 
+    std::error_code ec;
+    std::filesystem::rename(tempPath, filePath, ec);
+    if (ec) {
+        std::cerr << "LocalScene::save() Error replacing file: " << filePath << " (" << ec.message() << ")" << std::endl;
+        if (journal) journal->detach();
+        return;
+    }
+    bundleGeneration = generation;
+    if (journal) journal->openFile(0);
+
     std::cout << "LocalScene::save('" << filePath << "') Ok!" << std::endl;
 }
 
 void LocalScene::load(const std::string& filePath, Settings* settings) {
+    std::unique_lock<std::mutex> journalLock;
+    if (journal) {
+        journalLock = std::unique_lock<std::mutex>(journal->fileMutex());
+        journal->detach();
+    }
+
     OctreeFile opaqueLoader(&opaqueOctree, "opaque");
     OctreeFile transparentLoader(&transparentOctree, "transparent");
 
@@ -196,16 +380,25 @@ void LocalScene::load(const std::string& filePath, Settings* settings) {
     std::stringstream raw = gzipDecompressFromIfstream(file);
 
     SceneBundleHeader header = {};
-    raw.read(reinterpret_cast<char*>(&header), sizeof(header));
+    raw.read(reinterpret_cast<char*>(&header), offsetof(SceneBundleHeader, generation));
     if (!raw || std::memcmp(header.magic, kSceneBundleMagic, sizeof(header.magic)) != 0) {
         std::cerr << "LocalScene::load() Invalid scene bundle: " << filePath << std::endl;
         return;
     }
-    if (header.version != kSceneBundleVersion) {
+    if (header.version != 1 && header.version != kSceneBundleVersion) {
         std::cerr << "LocalScene::load() Unsupported bundle version " << header.version << " in " << filePath << std::endl;
         return;
     }
+    if (header.version >= 2) {
+        raw.read(reinterpret_cast<char*>(&header.generation), sizeof(header.generation));
+    }
+    const uint64_t generation = header.generation;
 
+    // The loaded trees replace the current ones: their page files go stale.
+    if (opaquePager) opaquePager->reset();
+    if (transparentPager) transparentPager->reset();
+    if (opaqueCompactor) opaqueCompactor->reset();
+    if (transparentCompactor) transparentCompactor->reset();
     opaqueLoader.readFromStream(raw);
     transparentLoader.readFromStream(raw);
 
@@ -218,28 +411,39 @@ void LocalScene::load(const std::string& filePath, Settings* settings) {
     }
 
     file.close();
+    bundleGeneration = generation;
+    if (journal) {
+        // Edits autosaved since the bundle was written.
+        const uint64_t validBytes = journal->replay(filePath, generation);
+        opaqueOctree.readLocked([&]() {
+            transparentOctree.readLocked([&]() {
+                journal->attachLocked(filePath, generation);
+            });
+        });
+        journal->openFile(validBytes);
+    }
     std::cout << "LocalScene::load('" << filePath << "') Ok!" << std::endl;
 }
 
-static void notifyChunkNodes(OctreeNode* node, const BoundingCube& cube, uint level,
-                             OctreeAllocator& allocator, Octree::OctreeNodeDataHandler updateHandler, Octree::OctreeNodeDataHandler deleteHandler) {
+static void notifyChunkNodes(const Octree& tree, OctreeNode* node, const OctreeCellKey& key,
+                             Octree::OctreeNodeDataHandler updateHandler, Octree::OctreeNodeDataHandler deleteHandler) {
     if (!node) return;
     if (node->isChunk()) {
-        updateHandler(OctreeNodeData(level, node, cube, nullptr));
+        updateHandler(OctreeNodeData(node, key, key.cube(tree), nullptr));
         return;
     }
     OctreeNode* children[8] = {};
-    node->getChildren(allocator, children);
+    node->getChildren(*tree.allocator, children);
     for (int i = 0; i < 8; ++i) {
         if (children[i])
-            notifyChunkNodes(children[i], cube.getChild(i), level + 1, allocator, updateHandler, deleteHandler);
+            notifyChunkNodes(tree, children[i], key.child(i), updateHandler, deleteHandler);
     }
 }
 
 void LocalScene::load(const std::string& filePath, const Octree::OctreeNodeDataHandler opaqueUpdateHandler, const Octree::OctreeNodeDataHandler opaqueDeleteHandler, const Octree::OctreeNodeDataHandler transparentUpdateHandler, const Octree::OctreeNodeDataHandler transparentDeleteHandler, Settings* settings) {
     load(filePath, settings);
     if (opaqueOctree.root)
-        notifyChunkNodes(opaqueOctree.root, opaqueOctree, 0, *opaqueOctree.allocator, opaqueUpdateHandler, opaqueDeleteHandler);
+        notifyChunkNodes(opaqueOctree, opaqueOctree.root, OctreeCellKey(), opaqueUpdateHandler, opaqueDeleteHandler);
     if (transparentOctree.root)
-        notifyChunkNodes(transparentOctree.root, transparentOctree, 0, *transparentOctree.allocator, transparentUpdateHandler, transparentDeleteHandler);
+        notifyChunkNodes(transparentOctree, transparentOctree.root, OctreeCellKey(), transparentUpdateHandler, transparentDeleteHandler);
 }
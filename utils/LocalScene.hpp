@@ -3,10 +3,16 @@
 #include "Scene.hpp"
 #include "../space/Octree.hpp"
 #include "../space/Tesselator.hpp"
+#include "../space/TessellationPlanner.hpp"
+#include "../space/OctreePager.hpp"
+#include "../space/OctreeCompactor.hpp"
+#include "SceneJournal.hpp"
 #include "../space/InstanceData.hpp"
 #include "../utils/Settings.hpp"
 #include <unordered_map>
+#include <memory>
 #include <mutex>
+#include <atomic>
 #include "OctreeLayer.tpp"
 
 class LocalScene : public Scene {
@@ -30,7 +36,11 @@ public:
     // Must be called before any objects captured by enqueued tasks are destroyed.
     void stopPools();
 
-    void requestModel3D(Layer layer, OctreeNodeData &data, const GeometryLodCallback& callback, ThreadPool* poolOverride = nullptr) override;
+    void requestModel3D(Layer layer, OctreeNodeData &data, const GeometryLodCallback& callback, ThreadPool* poolOverride = nullptr,
+                        const SurfaceNetsRoute* gpuRoute = nullptr) override;
+    void requestModel3DBatch(Layer layer, const std::vector<OctreeNodeData> &changed, const GeometryLodCallback& callback,
+                             ThreadPool* poolOverride = nullptr, const SurfaceNetsRoute* gpuRoute = nullptr,
+                             TessellationScheduler* scheduler = nullptr) override;
     bool isNodeUpToDate(Layer layer, OctreeNodeData &data, uint version) override;
     int maxChunkLod(Layer layer, float minSize) const override;
     void action(SceneLoaderCallback& callback, Octree::OctreeNodeDataHandler opaqueUpdateHandler, Octree::OctreeNodeDataHandler opaqueDeleteHandler, Octree::OctreeNodeDataHandler transparentUpdateHandler, Octree::OctreeNodeDataHandler transparentDeleteHandler) override;
@@ -39,17 +49,67 @@ public:
     void load(const std::string& filePath, Settings* settings = nullptr);
     void load(const std::string& filePath, Octree::OctreeNodeDataHandler opaqueUpdateHandler, Octree::OctreeNodeDataHandler opaqueDeleteHandler, Octree::OctreeNodeDataHandler transparentUpdateHandler, Octree::OctreeNodeDataHandler transparentDeleteHandler, Settings* settings = nullptr);
 
-    // Forget a node's tessellation record when it is deleted (the node memory
-    // may be reused; the stale entry could otherwise suppress a re-tessellation
-    // of the new occupant).
-    void noteDeletedNode(uintptr_t nodeId);
+    // Out-of-core paging (see OctreePager.hpp), off until enabled. Page files
+    // go under `folder`; units meshed while paged out are handed back to the
+    // remesh handlers (the layers' change collectors) once restored.
+    void enablePaging(const std::string& folder, Octree::OctreeNodeDataHandler opaqueRemeshHandler, Octree::OctreeNodeDataHandler transparentRemeshHandler);
+    struct PagingUpdate {
+        size_t opaqueRemeshed = 0;
+        size_t transparentRemeshed = 0;
+    };
+    // Renderer thread, once per frame. `budgetBytes` applies to each layer
+    // (0 = no limit); nothing within `keepDistance` of the camera is paged
+    // out. Reports what went to the remesh handlers, to be dispatched.
+    PagingUpdate updatePaging(const glm::vec3& camera, size_t budgetBytes, float keepDistance);
+    OctreePager::Stats pagingStats(Layer layer) const;
+
+    // Online node re-layout (see OctreeCompactor.hpp), off until enabled.
+    // updateCompaction() runs on the renderer thread once per frame: a cheap
+    // churn check that starts a pass on each layer's compactor thread.
+    void enableCompaction();
+    void updateCompaction();
+    OctreeCompactor::Stats compactionStats(Layer layer) const;
+
+    // Incremental autosave (see SceneJournal.hpp), off until enabled. Once a
+    // bundle is saved or loaded, autosave() appends the chunks edited since
+    // the last call to its journal on a background thread, and compacts
+    // (rewrites the bundle) when the journal passes `compactBytes` (0 =
+    // never) or the edits grew the root. Loading replays the journal.
+    void enableJournal();
+    void autosave(const Settings* settings, size_t compactBytes);
+    // Waits for the autosaves queued so far.
+    void flushAutosave();
+    // The trees are about to be reset or regenerated: stop journaling
+    // against the current bundle (waits for a running autosave).
+    void detachJournal();
+
+    // How the CPU path builds coarse ladder levels (chunkLod >= 2): each
+    // tessellated from the octree at its own resolution, or tessellated one
+    // level finer and collapsed by simplifyQuadric (MeshSimplifier.hpp) to
+    // within half its own vertex spacing, which keeps detail where the
+    // surface bends and drops it where it is flat. Any thread; applies to
+    // cells meshed after the change.
+    enum class LadderSimplifier { Octree, Quadric };
+    void setLadderSimplifier(LadderSimplifier simplifier) { ladderSimplifier.store(simplifier, std::memory_order_relaxed); }
 
 private:
-    // Last-tessellated version per emitting node. requestModel3D's walk emits
-    // every cell on the root path for every added node; without this cache
-    // each cell is re-tessellated (and re-uploaded) once per added descendant
-    // during load. Node versions only bump in the change walk (edits), so a
-    // matching version means the mesh is still current.
-    std::mutex emittedMutex_;
-    std::unordered_map<uintptr_t, uint32_t> emittedVersion_;
+    // Meshes one planned ladder cell under the tree read lock: re-resolves
+    // it (edits may have landed since planning), cancels it when superseded,
+    // then claims its stamp (see TessellationPlanner.hpp) and runs the GPU
+    // route when it takes the cell, the CPU tessellator otherwise. Quadric
+    // cells merge their children's walks from `reuse` when they can.
+    void tessellateLadderCell(Octree &tree, const LadderCell &cell, const GeometryLodCallback& callback,
+                              const SurfaceNetsRoute* gpuRoute, TessellationScheduler* scheduler,
+                              LadderReuse* reuse);
+
+    // Declared after the octrees: destroyed first, detaching themselves.
+    std::unique_ptr<OctreePager> opaquePager;
+    std::unique_ptr<OctreePager> transparentPager;
+    std::unique_ptr<OctreeCompactor> opaqueCompactor;
+    std::unique_ptr<OctreeCompactor> transparentCompactor;
+    std::unique_ptr<SceneJournal> journal;
+    std::atomic<LadderSimplifier> ladderSimplifier{LadderSimplifier::Octree};
+    // Generation of the bundle last saved or loaded (its journal's key):
+    // random per save, written to the bundle header and the journal header.
+    uint64_t bundleGeneration = 0;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "../math/Geometry.hpp"
 #include "../space/Octree.hpp"
 #include "../space/OctreeNodeData.hpp"
+#include "../space/SurfaceNets.hpp"
 
 enum Layer {
     LAYER_OPAQUE = 0,
@@ -20,6 +21,7 @@ enum Layer {
 // requestModel3D so a caller (e.g. brush editing) can tessellate on a
 // dedicated pool instead of the scene's shared generation pool.
 class ThreadPool;
+class TessellationScheduler;
 
 // Visible nodes are reported via a callback lambda taking a NodeID and its version
 using VisibleNodeCallback = std::function<void(std::vector<OctreeNodeData>&)>;
@@ -60,7 +62,18 @@ public:
     ~Scene() = default;
     virtual void action(SceneLoaderCallback& callback, const Octree::OctreeNodeDataHandler opaqueUpdateHandler, const Octree::OctreeNodeDataHandler opaqueDeleteHandler, const Octree::OctreeNodeDataHandler transparentUpdateHandler, const Octree::OctreeNodeDataHandler transparentDeleteHandler) = 0;
     virtual void loadScene(SceneLoaderCallback& callback, const Octree::OctreeNodeDataHandler opaqueUpdateHandler, const Octree::OctreeNodeDataHandler opaqueDeleteHandler, const Octree::OctreeNodeDataHandler transparentUpdateHandler, const Octree::OctreeNodeDataHandler transparentDeleteHandler) = 0;
-    virtual void requestModel3D(Layer layer, OctreeNodeData &data, const GeometryLodCallback& callback, ThreadPool* poolOverride = nullptr) = 0;
+    // gpuRoute (optional): ladder cells that flatten into a Surface Nets
+    // brick are handed to gpuRoute->onBrick instead of being tessellated.
+    virtual void requestModel3D(Layer layer, OctreeNodeData &data, const GeometryLodCallback& callback, ThreadPool* poolOverride = nullptr,
+                                const SurfaceNetsRoute* gpuRoute = nullptr) = 0;
+    // Batched form for one dispatch of changed nodes: every ladder cell on
+    // their root paths is meshed at most once across poolOverride (or the
+    // layer's own pool), in scheduler (camera) order when one is given and
+    // finest level first otherwise. Cells edited again before a worker
+    // reaches them are cancelled. Returns when all are emitted or cancelled.
+    virtual void requestModel3DBatch(Layer layer, const std::vector<OctreeNodeData> &changed, const GeometryLodCallback& callback,
+                                     ThreadPool* poolOverride = nullptr, const SurfaceNetsRoute* gpuRoute = nullptr,
+                                     TessellationScheduler* scheduler = nullptr) = 0;
     virtual bool isNodeUpToDate(Layer layer, OctreeNodeData &data, uint version) = 0;
 
     // Maximum LoD level a chunk can publish for the given layer (>= 0). The
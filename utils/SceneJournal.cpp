@@ -0,0 +1,526 @@
+#include "SceneJournal.hpp"
+#include "../space/OctreeAllocator.hpp"
+#include "../space/OctreeNode.hpp"
+#include "../space/OctreePager.hpp"
+#include "../space/OctreeSubtree.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <vector>
+#include <zlib.h>
+
+namespace {
+
+struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nodeSize;      // sizeof(OctreeNode): records do not cross layouts
+    uint64_t generation;    // base bundle this journal extends
+};
+
+struct JournalRecordHeader {
+    char magic[4];
+    uint32_t layer;
+    float treeMin[3];
+    float treeLength;
+    float cubeMin[3];
+    float cubeLength;
+    uint32_t pathCount;
+    uint32_t hasTarget;
+    uint32_t rawBytes;
+    uint32_t packedBytes;
+    uint32_t crc;           // over this header (crc = 0) and the payload
+};
+
+constexpr const char kJournalMagic[8] = {'S', 'C', 'N', 'J', 'R', 'N', 'L', '1'};
+constexpr const char kRecordMagic[4] = {'J', 'R', 'E', 'C'};
+constexpr uint32_t kJournalVersion = 1;
+// Sanity bound on a record read back (a damaged header passing the magic).
+constexpr uint32_t kMaxRecordBytes = 1u << 30;
+
+uint32_t recordCrc(JournalRecordHeader header, const std::string &packed) {
+    header.crc = 0;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(&header), sizeof(header));
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(packed.data()), static_cast<uInt>(packed.size()));
+    return static_cast<uint32_t>(crc);
+}
+
+void appendPathNode(OctreeAllocator &allocator, const OctreeNode *node, std::string &out) {
+    OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    node->getChildren(allocator, children);
+    uint8_t mask = 0;
+    for(int i = 0; i < 8; ++i) {
+        if(children[i] != NULL) {
+            mask |= uint8_t(1u << i);
+        }
+    }
+    out.append(reinterpret_cast<const char*>(node), sizeof(OctreeNode));
+    out.push_back(static_cast<char>(mask));
+}
+
+// Replayed nodes have no mesh yet: the loader queues them for meshing, and
+// a stamp carried over from the session that saved them would skip it.
+void clearMeshedStamps(OctreeAllocator &allocator, OctreeNode *node) {
+    node->meshedStamp = 0;
+    OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    node->getChildren(allocator, children);
+    for(int i = 0; i < 8; ++i) {
+        if(children[i] != NULL) {
+            clearMeshedStamps(allocator, children[i]);
+        }
+    }
+}
+
+} // namespace
+
+SceneJournal::SceneJournal(Octree &opaque, Octree &transparent, ThreadPool &workers)
+    : trees{&opaque, &transparent}, workers(workers) {
+    for(int layer = 0; layer < 2; ++layer) {
+        trees[layer]->editListener = [this, layer](const Octree::ReachTest &reaches) {
+            noteEdit(layer, reaches);
+        };
+    }
+}
+
+SceneJournal::~SceneJournal() {
+    stop();
+    for(Octree * tree : trees) {
+        tree->editListener = nullptr;
+    }
+}
+
+void SceneJournal::stop() {
+    io_.stop();
+}
+
+std::string SceneJournal::pathFor(const std::string &bundlePath) {
+    return bundlePath + ".journal";
+}
+
+void SceneJournal::attachLocked(const std::string &bundlePath, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    attached = true;
+    bundle = bundlePath;
+    gen = generation;
+    bytes = 0;
+    for(int layer = 0; layer < 2; ++layer) {
+        baseCube[layer] = *trees[layer];
+        dirty[layer].clear();
+    }
+}
+
+bool SceneJournal::openFile(uint64_t validBytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!attached) {
+        return false;
+    }
+    const std::string path = pathFor(bundle);
+    if(validBytes > 0) {
+        // Drops a torn tail so the next append starts on a record boundary.
+        std::error_code ec;
+        std::filesystem::resize_file(path, validBytes, ec);
+        if(!ec) {
+            bytes = validBytes;
+            return true;
+        }
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file) {
+        std::cerr << "SceneJournal::openFile() Error opening file: " << path << std::endl;
+        return false;
+    }
+    JournalHeader header = {};
+    std::memcpy(header.magic, kJournalMagic, sizeof(header.magic));
+    header.version = kJournalVersion;
+    header.nodeSize = sizeof(OctreeNode);
+    header.generation = gen;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes = sizeof(header);
+    return static_cast<bool>(file);
+}
+
+void SceneJournal::detach() {
+    std::lock_guard<std::mutex> lock(mutex);
+    attached = false;
+    bundle.clear();
+    dirty[0].clear();
+    dirty[1].clear();
+}
+
+bool SceneJournal::isAttached() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return attached;
+}
+
+std::string SceneJournal::bundlePath() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bundle;
+}
+
+uint64_t SceneJournal::generation() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return gen;
+}
+
+uint64_t SceneJournal::journalBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+}
+
+void SceneJournal::noteEdit(int layer, const Octree::ReachTest &reaches) {
+    // Tree write lock held (Octree::apply).
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!attached) {
+        return;
+    }
+    ++editEpoch;
+    Octree &tree = *trees[layer];
+    if(tree.root == NULL) {
+        return;
+    }
+    // Chunk-size cells the brush reached, or larger leaves and removed
+    // branches above that size. Anything the shape changed lies inside one.
+    std::vector<std::pair<OctreeNode*, BoundingCube>> stack;
+    stack.emplace_back(tree.root, BoundingCube(tree));
+    while(!stack.empty()) {
+        auto [node, cube] = stack.back();
+        stack.pop_back();
+        if(!reaches(cube)) {
+            continue;
+        }
+        if(node->isLeaf() || cube.getLengthX() <= tree.chunkSize) {
+            dirty[layer].insert(cube);
+            continue;
+        }
+        OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+        node->getChildren(*tree.allocator, children);
+        for(int i = 0; i < 8; ++i) {
+            const BoundingCube child = cube.getChild(i);
+            if(children[i] != NULL) {
+                stack.emplace_back(children[i], child);
+            } else if(reaches(child)) {
+                dirty[layer].insert(child);
+            }
+        }
+    }
+}
+
+void SceneJournal::buildRecord(int layer, const BoundingCube &cube, Record &record) {
+    Octree &tree = *trees[layer];
+    record.layer = static_cast<uint32_t>(layer);
+    record.cube = cube;
+    std::string raw;
+    tree.readLocked([&]() {
+        // Edits of this layer wait for the read lock, so the epoch read here
+        // covers them all; edits of the other layer bump it concurrently,
+        // hence the mutex.
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            record.epoch = editEpoch;
+        }
+        record.treeCube = tree;
+        const glm::vec3 center = cube.getCenter();
+        const float targetLength = cube.getLengthX();
+        OctreeNode * node = tree.contains(center) ? tree.root : NULL;
+        BoundingCube nodeCube = tree;
+        while(node != NULL && nodeCube.getLengthX() > targetLength * 1.5f) {
+            if(node->isPagedOut()) {
+                record.retry = true;
+                return;
+            }
+            appendPathNode(*tree.allocator, node, raw);
+            ++record.pathCount;
+            const int i = nodeCube.getChildIndex(center);
+            OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+            node->getChildren(*tree.allocator, children);
+            node = children[i];
+            nodeCube = nodeCube.getChild(i);
+        }
+        if(node != NULL && nodeCube.getLengthX() >= targetLength * 0.75f) {
+            uint32_t count = 0;
+            if(!writeOctreeSubtree(*tree.allocator, node, raw, count)) {
+                record.retry = true;
+                return;
+            }
+            record.hasTarget = 1;
+        }
+        // Nothing to record when even the root is missing.
+        record.ok = record.pathCount > 0 || record.hasTarget != 0;
+    });
+    if(!record.ok) {
+        return;
+    }
+    // Compressed outside the lock, on this worker.
+    record.rawBytes = static_cast<uint32_t>(raw.size());
+    uLongf packedSize = compressBound(static_cast<uLong>(raw.size()));
+    record.packed.resize(packedSize);
+    if(compress2(reinterpret_cast<Bytef*>(record.packed.data()), &packedSize,
+                 reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()), Z_BEST_SPEED) != Z_OK) {
+        record.ok = false;
+        record.retry = true;
+        return;
+    }
+    record.packed.resize(packedSize);
+}
+
+bool SceneJournal::checkpoint() {
+    std::lock_guard<std::mutex> fileLock(fileMutex_);
+    std::vector<std::pair<int, BoundingCube>> cells;
+    std::string path;
+    bool rootGrew = false;
+    for(int layer = 0; layer < 2; ++layer) {
+        trees[layer]->readLocked([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!attached) {
+                return;
+            }
+            if(!(BoundingCube(*trees[layer]) == baseCube[layer])) {
+                rootGrew = true;
+                return;
+            }
+            for(const BoundingCube &cube : dirty[layer]) {
+                cells.emplace_back(layer, cube);
+            }
+            dirty[layer].clear();
+            path = pathFor(bundle);
+        });
+    }
+    if(rootGrew) {
+        // Keep what was taken: the compaction's snapshot covers it.
+        std::lock_guard<std::mutex> lock(mutex);
+        for(const auto &[layer, cube] : cells) {
+            dirty[layer].insert(cube);
+        }
+        return false;
+    }
+    if(cells.empty()) {
+        return true;
+    }
+
+    // Paged-out chunks inside an edited cell come back first; a cell that
+    // still meets a stub (paged out again meanwhile) waits for the next
+    // checkpoint.
+    for(int layer = 0; layer < 2; ++layer) {
+        OctreePager * pager = trees[layer]->pager;
+        if(pager == nullptr || !pager->hasPagedOut()) {
+            continue;
+        }
+        trees[layer]->writeLocked([&]() {
+            pager->pageInLocked([&](const BoundingCube &unit) {
+                for(const auto &[cellLayer, cube] : cells) {
+                    if(cellLayer == layer && cube.intersects(unit)) {
+                        return true;
+                    }
+                }
+                return false;
+            });
+        });
+    }
+
+    std::vector<Record> records(cells.size());
+    std::vector<std::future<void>> done;
+    done.reserve(cells.size());
+    for(size_t i = 0; i < cells.size(); ++i) {
+        done.push_back(workers.enqueue([this, &cells, &records, i]() {
+            buildRecord(cells[i].first, cells[i].second, records[i]);
+        }));
+    }
+    for(std::future<void> &f : done) {
+        workers.getCooperative(f);
+    }
+    // Records of one state share an epoch; later states replay last.
+    std::stable_sort(records.begin(), records.end(), [](const Record &a, const Record &b) {
+        return a.epoch < b.epoch;
+    });
+
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    uint64_t written = 0;
+    size_t appended = 0;
+    for(const Record &record : records) {
+        if(!record.ok) {
+            continue;
+        }
+        JournalRecordHeader header = {};
+        std::memcpy(header.magic, kRecordMagic, sizeof(header.magic));
+        header.layer = record.layer;
+        const glm::vec3 treeMin = record.treeCube.getMin();
+        const glm::vec3 cubeMin = record.cube.getMin();
+        for(int c = 0; c < 3; ++c) {
+            header.treeMin[c] = treeMin[c];
+            header.cubeMin[c] = cubeMin[c];
+        }
+        header.treeLength = record.treeCube.getLengthX();
+        header.cubeLength = record.cube.getLengthX();
+        header.pathCount = record.pathCount;
+        header.hasTarget = record.hasTarget;
+        header.rawBytes = record.rawBytes;
+        header.packedBytes = static_cast<uint32_t>(record.packed.size());
+        header.crc = recordCrc(header, record.packed);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(record.packed.data(), static_cast<std::streamsize>(record.packed.size()));
+        written += sizeof(header) + record.packed.size();
+        ++appended;
+    }
+    file.flush();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!file) {
+        std::cerr << "SceneJournal::checkpoint() Error writing file: " << path << std::endl;
+        for(const auto &[layer, cube] : cells) {
+            dirty[layer].insert(cube);
+        }
+        return false;
+    }
+    for(const Record &record : records) {
+        if(record.retry) {
+            dirty[record.layer].insert(record.cube);
+        }
+    }
+    bytes += written;
+    std::cout << "SceneJournal::checkpoint() " << appended << " cells, " << written << " bytes" << std::endl;
+    return true;
+}
+
+uint64_t SceneJournal::replay(const std::string &bundlePath, uint64_t generation) {
+    const std::string path = pathFor(bundlePath);
+    std::ifstream file(path, std::ios::binary);
+    if(!file) {
+        return 0;
+    }
+    JournalHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if(!file || std::memcmp(header.magic, kJournalMagic, sizeof(header.magic)) != 0 ||
+       header.version != kJournalVersion || header.nodeSize != sizeof(OctreeNode)) {
+        std::cerr << "SceneJournal::replay() Invalid journal: " << path << std::endl;
+        return 0;
+    }
+    if(header.generation != generation) {
+        // Left by an older base (the save that replaced it stopped before
+        // restarting the journal): already contained in the bundle.
+        return 0;
+    }
+
+    uint64_t valid = sizeof(header);
+    size_t applied = 0;
+    std::string raw;
+    while(true) {
+        JournalRecordHeader recordHeader = {};
+        file.read(reinterpret_cast<char*>(&recordHeader), sizeof(recordHeader));
+        if(file.gcount() != sizeof(recordHeader) ||
+           std::memcmp(recordHeader.magic, kRecordMagic, sizeof(recordHeader.magic)) != 0 ||
+           recordHeader.layer > 1 || recordHeader.packedBytes > kMaxRecordBytes ||
+           recordHeader.rawBytes > kMaxRecordBytes) {
+            break;
+        }
+        Record record;
+        record.packed.resize(recordHeader.packedBytes);
+        file.read(record.packed.data(), static_cast<std::streamsize>(record.packed.size()));
+        if(file.gcount() != static_cast<std::streamsize>(record.packed.size()) ||
+           recordCrc(recordHeader, record.packed) != recordHeader.crc) {
+            break;
+        }
+        raw.resize(recordHeader.rawBytes);
+        uLongf rawSize = recordHeader.rawBytes;
+        if(uncompress(reinterpret_cast<Bytef*>(raw.data()), &rawSize,
+                      reinterpret_cast<const Bytef*>(record.packed.data()), static_cast<uLong>(record.packed.size())) != Z_OK ||
+           rawSize != recordHeader.rawBytes) {
+            break;
+        }
+        record.layer = recordHeader.layer;
+        record.treeCube = BoundingCube(glm::vec3(recordHeader.treeMin[0], recordHeader.treeMin[1], recordHeader.treeMin[2]),
+                                       recordHeader.treeLength);
+        record.cube = BoundingCube(glm::vec3(recordHeader.cubeMin[0], recordHeader.cubeMin[1], recordHeader.cubeMin[2]),
+                                   recordHeader.cubeLength);
+        record.pathCount = recordHeader.pathCount;
+        record.hasTarget = recordHeader.hasTarget;
+        bool ok = false;
+        trees[record.layer]->writeLocked([&]() {
+            ok = applyRecord(record, raw);
+        });
+        if(!ok) {
+            std::cerr << "SceneJournal::replay() Record does not fit the tree: " << path << std::endl;
+            break;
+        }
+        valid += sizeof(recordHeader) + record.packed.size();
+        ++applied;
+    }
+    std::cout << "SceneJournal::replay('" << path << "') " << applied << " cells" << std::endl;
+    return valid;
+}
+
+bool SceneJournal::applyRecord(const Record &record, const std::string &raw) {
+    Octree &tree = *trees[record.layer];
+    OctreeAllocator &allocator = *tree.allocator;
+    if(!(BoundingCube(tree) == record.treeCube)) {
+        return false;
+    }
+    if(tree.root == NULL) {
+        tree.root = allocator.allocate();
+        tree.root->blockId = UINT_MAX;
+    }
+    const glm::vec3 center = record.cube.getCenter();
+    OctreeNode * node = tree.root;
+    BoundingCube nodeCube = tree;
+    size_t pos = 0;
+    for(uint32_t k = 0; k < record.pathCount; ++k) {
+        if(pos + sizeof(OctreeNode) + 1 > raw.size()) {
+            return false;
+        }
+        const uint blockId = node->blockId;
+        std::memcpy(static_cast<void*>(node), raw.data() + pos, sizeof(OctreeNode));
+        node->blockId = blockId;
+        node->meshedStamp = 0;
+        pos += sizeof(OctreeNode);
+        const uint8_t mask = static_cast<uint8_t>(raw[pos++]);
+
+        // Branches the saved state no longer had.
+        OctreeNode * children[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+        node->getChildren(allocator, children);
+        ChildBlock * block = node->getBlock(allocator);
+        for(int j = 0; j < 8; ++j) {
+            if(children[j] != NULL && !(mask & (1u << j))) {
+                children[j]->clear(allocator, NULL);
+                allocator.deallocate(children[j]);
+                block->set(j, NULL, allocator);
+                children[j] = NULL;
+            }
+        }
+        if(mask == 0) {
+            node->clear(allocator, NULL);
+        }
+        // The path ends above a removed cell.
+        if(k + 1 == record.pathCount && record.hasTarget == 0) {
+            return true;
+        }
+        const int i = nodeCube.getChildIndex(center);
+        if(!(mask & (1u << i))) {
+            return false;
+        }
+        if(children[i] == NULL) {
+            const bool wasLeaf = node->isLeaf();
+            ChildBlock * childBlock = node->allocate(allocator);
+            if(wasLeaf) {
+                childBlock->init();
+            }
+            children[i] = allocator.allocate();
+            children[i]->blockId = UINT_MAX;
+            childBlock->set(i, children[i], allocator);
+        }
+        node = children[i];
+        nodeCube = nodeCube.getChild(i);
+    }
+    if(record.hasTarget == 0) {
+        return true;
+    }
+    node->clear(allocator, NULL);
+    if(!readOctreeSubtree(allocator, node, false, raw, pos)) {
+        return false;
+    }
+    clearMeshedStamps(allocator, node);
+    return true;
+}
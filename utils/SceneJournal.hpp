@@ -0,0 +1,104 @@
+#pragma once
+#include "../space/Octree.hpp"
+#include "../space/ThreadPool.hpp"
+#include "../math/BoundingCube.hpp"
+#include "../math/BoundingCubeHasher.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+// Append-only autosave journal for a scene bundle (LocalScene::save).
+//
+// While attached to a bundle, the journal records which chunk cells each
+// Octree::apply reached (the brush's reach test, walked down to chunk size).
+// A checkpoint serialises those cells in parallel on the scene's worker
+// pool. Each cell goes with its root path, so replay can rebuild missing
+// ancestors and prune removed branches. The records are zlib-compressed,
+// carry a CRC each, and are appended to `<bundle>.journal`. Checkpoint cost
+// follows the edits, not the world.
+//
+// Compaction is a full LocalScene::save: the new base carries a fresh
+// random generation, and the journal restarts under it. A journal replays on
+// load only when its generation matches the bundle's, so a crash between
+// writing the base and restarting the journal never reapplies stale
+// records. Replay stops at the first record failing its checksum (a torn
+// append) and later appends overwrite it.
+//
+// Records address cells under the root the base was saved with. Once a
+// brush grows the root, checkpoint() reports that only a compaction can
+// capture the edits.
+class SceneJournal {
+public:
+    SceneJournal(Octree &opaque, Octree &transparent, ThreadPool &workers);
+    ~SceneJournal();
+
+    static std::string pathFor(const std::string &bundlePath);
+
+    // The bundle at `bundlePath` (base generation `generation`) is about to
+    // be snapshot: drops the recorded edits and starts recording against
+    // it, so every edit the snapshot may miss is checkpointed later. Caller
+    // holds both tree read locks, so no edit slips between.
+    void attachLocked(const std::string &bundlePath, uint64_t generation);
+    // Opens the attached bundle's journal keeping its first `validBytes`
+    // (replay's result), or starts an empty one when 0. Caller holds
+    // fileMutex().
+    bool openFile(uint64_t validBytes);
+    // Stops recording (the trees were reset or replaced).
+    void detach();
+    bool isAttached() const;
+    std::string bundlePath() const;
+    uint64_t generation() const;
+    uint64_t journalBytes() const;
+
+    // Appends the cells edited since the last checkpoint. False when only a
+    // compaction can capture the edits (root grew, or the append failed).
+    bool checkpoint();
+
+    // Applies `<bundlePath>.journal` to freshly loaded trees when it belongs
+    // to `generation`. Returns the bytes of valid journal read (header
+    // included), 0 when there was none. Caller holds fileMutex().
+    uint64_t replay(const std::string &bundlePath, uint64_t generation);
+
+    // Serialises checkpoints, compactions and loads touching the journal.
+    std::mutex &fileMutex() { return fileMutex_; }
+    // One background thread for autosave work, in request order.
+    ThreadPool &io() { return io_; }
+    void stop();
+    // Set while an autosave waits on io(), so requests do not pile up.
+    std::atomic<bool> autosaveQueued{false};
+
+private:
+    struct Record {
+        uint32_t layer = 0;
+        uint64_t epoch = 0;     // edits seen: orders the records of a checkpoint
+        BoundingCube treeCube;
+        BoundingCube cube;
+        uint32_t pathCount = 0; // ancestor records before the cell's subtree
+        uint32_t hasTarget = 0; // 0: the cell is gone, the path ends above it
+        uint32_t rawBytes = 0;
+        std::string packed;     // zlib-compressed node records
+        bool ok = false;
+        bool retry = false;     // met a paged-out stub: next checkpoint
+    };
+
+    void noteEdit(int layer, const Octree::ReachTest &reaches);
+    void buildRecord(int layer, const BoundingCube &cube, Record &record);
+    bool applyRecord(const Record &record, const std::string &raw);
+
+    Octree * trees[2];
+    ThreadPool &workers;
+
+    mutable std::mutex mutex;   // guards the fields below; taken after a tree lock
+    bool attached = false;
+    std::string bundle;
+    uint64_t gen = 0;
+    uint64_t bytes = 0;
+    BoundingCube baseCube[2];
+    std::unordered_set<BoundingCube, BoundingCubeHasher> dirty[2];
+    uint64_t editEpoch = 0;
+
+    std::mutex fileMutex_;
+    ThreadPool io_ = ThreadPool(1);
+};
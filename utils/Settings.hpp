@@ -8,6 +8,10 @@ public:
 
     // Global toggles
     bool enableShadows = true;
+    // 0 = EVSM cascades, 1 = clipmapped virtual shadow map (see VirtualShadowMap)
+    int shadowMode = 0;
+    // Virtual shadow pages rendered per frame at most (newly requested and dirty)
+    int virtualShadowPageBudget = 16;
     // Toggle rendering of the main solid scene (terrain/meshes)
     bool renderSolid = true;
     bool waterEnabled = true;
@@ -43,10 +47,42 @@ public:
     // and smaller values switch to coarse meshes sooner (fewer triangles).
     // 0 = always coarsest, 64+ = effectively full detail everywhere.
     float lodBias = 8.0f;
+    // Geomorph transition width, in bands: over the last geomorphBand of each
+    // level's distance band the vertex shader slides vertices onto the next
+    // coarser level, so a band switch no longer pops and lodBias can be
+    // lowered. 0 = discrete switching.
+    float geomorphBand = 0.3f;
+    // Coarse LoD ladder levels: 0 = tessellated from the octree at their own
+    // resolution, 1 = tessellated one level finer and reduced by quadric edge
+    // collapse (LocalScene::LadderSimplifier).
+    int ladderSimplifier = 0;
+    // Reorder every generated chunk mesh on the workers for the post-transform
+    // vertex cache, overdraw and vertex fetch (space/MeshOptimizer.hpp).
+    bool optimizeChunkMeshes = true;
+    // Mesh uniformly refined solid chunks with the Surface Nets compute
+    // kernel (shaders/surface_nets.comp) instead of the CPU tessellator. The
+    // kernel is only built when this is on at startup.
+    bool gpuMeshing = false;
+    // Out-of-core octree paging (space/OctreePager.hpp): RAM budget for each
+    // layer's nodes, in MB (0 = keep everything resident). Chunks within
+    // pagingDistance of the camera are never paged out.
+    int octreeMemoryBudgetMB = 0;
+    float pagingDistance = 2048.0f;
+    // Autosave (utils/SceneJournal.hpp): every autosaveSeconds (0 = off) the
+    // chunks edited since the last one are appended to the saved bundle's
+    // journal; past journalCompactMB the bundle is rewritten instead.
+    int autosaveSeconds = 0;
+    int journalCompactMB = 64;
+    // Re-lay out the octree nodes chunk by chunk on a background thread once
+    // edits have fragmented the allocators (space/OctreeCompactor.hpp).
+    bool octreeCompaction = false;
 
     // Tessellation
     bool tessellationEnabled = false;
     bool shadowTessellationEnabled = false;
+    // Record the shadow cascade draws into secondary command buffers on
+    // worker threads (see ShadowRenderer::setParallelRecording)
+    bool parallelShadowRecording = true;
     bool adaptiveTessellation = true;
     float tessellationFactor = 1.0f;
     float tessMaxDistance = 512.0f;
@@ -62,4 +98,17 @@ public:
     // Impostor rendering: vegetation beyond this distance is drawn as a pre-captured
     // camera-facing quad.  Set to 0 to disable (default: disabled).
     float impostorDistance = 512.0f;
+    // Impostor capture layout: 0 = 20 Fibonacci views (closest view),
+    // 1 = octahedral grid (3 nearest frames blended)
+    int impostorLayout = 1;
+    int impostorGrid = 8;     // octahedral frames per side
+
+    // Reflection cubemap time-slicing: faces re-rendered per frame (the GPU
+    // budget; 6 = all faces every frame) and how they are picked:
+    // 0 = round-robin, 1 = camera-motion priority
+    int cubemapFacesPerFrame = 1;
+    int cubemapUpdateMode = 1;
+    // Record the cubemap face draws into secondary command buffers on worker
+    // threads (see Solid360Renderer::setParallelRecording)
+    bool parallelCubemapRecording = true;
 };
@@ -17,6 +17,63 @@ struct ShadowParams {
     glm::mat4 lightSpaceMatrix[SHADOW_CASCADE_COUNT];
     float splits[SHADOW_CASCADE_COUNT + 1];
 
+    // ---- Cascade caching ----
+    // A cached cascade keeps rendering into the same light-space window
+    // (padded by cacheGuardBand and snapped to its texel grid) and is only
+    // re-rendered when
+    //   - the camera slice leaves the window (or shrinks far inside it),
+    //   - the light direction turns by more than cacheMaxLightAngleDeg,
+    //   - a changed chunk overlaps the window (markDirtyRegion), or
+    //   - refreshInterval frames have passed (animated casters, e.g. wind).
+    // Skipped cascades keep last frame's EVSM image and matrix, so the UBO
+    // must be filled from lightSpaceMatrix[] after update() as before.
+    bool cacheCascades = true;
+    uint32_t refreshInterval[SHADOW_CASCADE_COUNT] = {1, 4, 8}; // 1 = render every frame, uncached
+    float cacheGuardBand = 0.15f;        // extra window size per side, fraction of the fitted extent
+    float cacheMaxLightAngleDeg = 0.05f;
+
+    // Output of update(): cascades that must be re-rendered this frame.
+    bool cascadeNeedsRender[SHADOW_CASCADE_COUNT] = {};
+
+    uint32_t cascadeRenderMask() const {
+        uint32_t mask = 0;
+        for (int i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+            if (cascadeNeedsRender[i]) mask |= 1u << i;
+        return mask;
+    }
+
+    // Force every cascade to refit and re-render on the next update()
+    // (shadow maps were disabled, scene reloaded, render toggles changed).
+    void invalidateCascades() {
+        for (auto& w : windows) w.valid = false;
+    }
+
+    // Invalidate cached cascades whose window overlaps the world-space box.
+    // Casters outside the window's XY rectangle cannot affect its contents.
+    // Depth is not tested: the window already extends to the light (step 4 of
+    // update()), and anything beyond its far plane lies behind every receiver.
+    void markDirtyRegion(const glm::vec3& worldMin, const glm::vec3& worldMax) {
+        for (auto& w : windows) {
+            if (!w.valid || w.dirty) continue;
+            glm::vec2 lo( FLT_MAX), hi(-FLT_MAX);
+            for (int c = 0; c < 8; ++c) {
+                glm::vec3 p((c & 1) ? worldMax.x : worldMin.x,
+                            (c & 2) ? worldMax.y : worldMin.y,
+                            (c & 4) ? worldMax.z : worldMin.z);
+                glm::vec2 ls = glm::vec2(w.lightView * glm::vec4(p, 1.0f));
+                lo = glm::min(lo, ls);
+                hi = glm::max(hi, ls);
+            }
+            glm::vec2 wMin = w.center - w.halfExt;
+            glm::vec2 wMax = w.center + w.halfExt;
+            if (hi.x >= wMin.x && lo.x <= wMax.x && hi.y >= wMin.y && lo.y <= wMax.y)
+                w.dirty = true;
+        }
+    }
+
+    // Per-cascade cache statistics, reset on each re-render.
+    uint32_t framesSinceRender(int cascade) const { return windows[cascade].age; }
+
     void update(const glm::vec3& camPos, Light& light,
                 const glm::mat4& cameraViewProj,
                 float nearPlane, float farPlane) {
@@ -105,22 +162,110 @@ struct ShadowParams {
             // coordinate system fixed, which prevents shadow swimming even
             // without snapping.  Varying the snap grid per frame from AABB
             // changes caused more visible jitter than it prevented.
+            // Cached cascades (see resolveCachedWindow) are the exception:
+            // their window is refit rarely, so it is padded and snapped.
             glm::vec3 centroid = (minLS + maxLS) * 0.5f;
             glm::vec3 halfExt = (maxLS - minLS) * 0.5f;
+            float nearVal = -maxLS.z;
+            float farVal  = -minLS.z;
+
+            if (isCascadeCached(i)) {
+                resolveCachedWindow(i, lightView, lightDir, farPlane, centroid, halfExt, nearVal, farVal);
+                const CascadeWindow& w = windows[i];
+                centroid = glm::vec3(w.center, 0.0f);
+                halfExt = glm::vec3(w.halfExt, 0.0f);
+                nearVal = w.nearVal;
+                farVal = w.farVal;
+            } else {
+                windows[i].valid = false;
+                cascadeNeedsRender[i] = true;
+            }
 
             // ---- 6. Orthographic projection ----
             // nearVal/farVal are derived directly from the (possibly extended
             // and padded) Z bounds, not from centroid ± halfExt.z which would
             // be stale after the Z extension above.
-            float nearVal = -maxLS.z;
-            float farVal  = -minLS.z;
             glm::mat4 proj = glm::ortho(
                 centroid.x - halfExt.x, centroid.x + halfExt.x,
                 centroid.y - halfExt.y, centroid.y + halfExt.y,
                 nearVal, farVal);
 
             light.setProjection(proj);
-            lightSpaceMatrix[i] = light.getViewProjectionMatrix();
+            // A cached cascade keeps the light view it was rendered with; the
+            // light may have turned by up to cacheMaxLightAngleDeg since.
+            lightSpaceMatrix[i] = isCascadeCached(i) ? proj * windows[i].lightView
+                                                     : light.getViewProjectionMatrix();
+        }
+    }
+
+private:
+    struct CascadeWindow {
+        glm::vec2 center = glm::vec2(0.0f);
+        glm::vec2 halfExt = glm::vec2(0.0f);
+        float nearVal = 0.0f;
+        float farVal = 0.0f;
+        glm::vec3 lightDir = glm::vec3(0.0f);
+        float farPlane = 0.0f;
+        glm::mat4 lightView = glm::mat4(1.0f);
+        uint32_t age = 0;
+        bool valid = false;
+        bool dirty = false;
+    };
+    CascadeWindow windows[SHADOW_CASCADE_COUNT];
+
+    bool isCascadeCached(int i) const {
+        return cacheCascades && refreshInterval[i] > 1;
+    }
+
+    // Decide whether cascade i can keep its window, refitting it when not.
+    // Sets cascadeNeedsRender[i].
+    void resolveCachedWindow(int i, const glm::mat4& lightView, const glm::vec3& lightDir, float farPlane,
+                             const glm::vec3& centroid, const glm::vec3& halfExt,
+                             float nearVal, float farVal) {
+        CascadeWindow& w = windows[i];
+        const glm::vec2 c(centroid);
+        const glm::vec2 h(halfExt);
+
+        bool refit = !w.valid || w.farPlane != farPlane;
+        if (!refit) {
+            float cosMax = std::cos(glm::radians(cacheMaxLightAngleDeg));
+            refit = glm::dot(w.lightDir, lightDir) < cosMax;
+        }
+        if (!refit) {
+            // Slice must stay inside the window, and the window must not be
+            // more than twice the size it needs (resolution would suffer).
+            glm::vec2 lo = c - h, hi = c + h;
+            glm::vec2 wLo = w.center - w.halfExt, wHi = w.center + w.halfExt;
+            bool inside = lo.x >= wLo.x && lo.y >= wLo.y && hi.x <= wHi.x && hi.y <= wHi.y &&
+                          nearVal >= w.nearVal && farVal <= w.farVal;
+            bool oversized = std::max(h.x, h.y) * 2.0f < w.halfExt.x;
+            refit = !inside || oversized;
+        }
+
+        if (refit) {
+            // Square window padded by the guard band, center snapped to whole
+            // texels so successive refits land on the same texel grid.
+            glm::vec2 ext = h * (1.0f + cacheGuardBand);
+            float ext1 = std::max(ext.x, ext.y);
+            float texel = (2.0f * ext1) / std::max(1.0f, (float)shadowMapSizes[i]);
+            w.halfExt = glm::vec2(ext1);
+            w.center = glm::floor(c / texel) * texel;
+            float zPad = (farVal - nearVal) * cacheGuardBand;
+            w.nearVal = nearVal - zPad;
+            w.farVal = farVal + zPad;
+            w.lightDir = lightDir;
+            w.farPlane = farPlane;
+            w.lightView = lightView;
+            w.valid = true;
+        }
+
+        bool render = refit || w.dirty || w.age + 1 >= refreshInterval[i];
+        cascadeNeedsRender[i] = render;
+        if (render) {
+            w.dirty = false;
+            w.age = 0;
+        } else {
+            ++w.age;
         }
     }
 };
@@ -0,0 +1,604 @@
+#include "TextureCooker.hpp"
+
+#include <stb/stb_image.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+// Bump when the cooking pipeline changes so stale cache entries are ignored
+static constexpr uint32_t COOKER_VERSION = 3u;
+
+std::string TextureCooker::cacheDirectory = "cache/textures";
+
+uint64_t TextureCooker::hashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+bool TextureCooker::isBlockCompressed(uint32_t format) {
+    return format == COOKED_FORMAT_BC4_UNORM || format == COOKED_FORMAT_BC5_UNORM ||
+           format == COOKED_FORMAT_BC7_UNORM || format == COOKED_FORMAT_BC7_SRGB;
+}
+
+uint32_t TextureCooker::blockFormatFor(bool srgb, bool normalMap) {
+    if (srgb) return COOKED_FORMAT_BC7_SRGB;
+    if (normalMap) return COOKED_FORMAT_BC5_UNORM;
+    return COOKED_FORMAT_BC4_UNORM;
+}
+
+uint64_t TextureCooker::levelSize(uint32_t w, uint32_t h, uint32_t format) {
+    if (!isBlockCompressed(format)) return static_cast<uint64_t>(w) * h * 4u;
+    const uint64_t blocks = static_cast<uint64_t>((w + 3u) / 4u) * ((h + 3u) / 4u);
+    return blocks * (format == COOKED_FORMAT_BC4_UNORM ? 8u : 16u);
+}
+
+uint64_t TextureCooker::mipChainSize(uint32_t w, uint32_t h, uint32_t levels, uint32_t format) {
+    uint64_t total = 0;
+    for (uint32_t l = 0; l < levels; ++l) {
+        total += levelSize(std::max(1u, w >> l), std::max(1u, h >> l), format);
+    }
+    return total;
+}
+
+static void layoutLevels(uint32_t w, uint32_t h, uint32_t levels, uint32_t format, CookedTexture& out) {
+    out.width = w;
+    out.height = h;
+    out.vkFormat = format;
+    out.mipOffsets.resize(levels);
+    out.mipSizes.resize(levels);
+    uint64_t offset = 0;
+    for (uint32_t l = 0; l < levels; ++l) {
+        uint64_t size = TextureCooker::levelSize(std::max(1u, w >> l), std::max(1u, h >> l), format);
+        out.mipOffsets[l] = offset;
+        out.mipSizes[l] = size;
+        offset += size;
+    }
+    out.data.resize(static_cast<size_t>(offset));
+}
+
+// ---------------------------------------------------------------------------
+// 4x4 block encoders. shaders/texture_encode.comp is a port of these for the
+// layers TextureMixer and editable copies write on the GPU; keep the two in
+// step.
+// ---------------------------------------------------------------------------
+
+// BC4: the block's min and max as endpoints (8-value mode), each texel
+// rounded to the nearest of the 8 evenly spaced levels.
+static void encodeBC4(const unsigned char v[16], unsigned char* out) {
+    int lo = 255, hi = 0;
+    for (int i = 0; i < 16; ++i) {
+        lo = std::min<int>(lo, v[i]);
+        hi = std::max<int>(hi, v[i]);
+    }
+    out[0] = static_cast<unsigned char>(hi);
+    out[1] = static_cast<unsigned char>(lo);
+    uint64_t bits = 0;
+    if (hi > lo) {
+        const int range = hi - lo;
+        for (int i = 0; i < 16; ++i) {
+            // Level k in 0..7 sits at lo + k/7 * range; red0 is index 0, red1
+            // index 1 and the interpolants 2..7 run from red0 towards red1.
+            int k = ((v[i] - lo) * 14 + range) / (2 * range);
+            uint64_t index = (k == 7) ? 0u : (k == 0) ? 1u : static_cast<uint64_t>(8 - k);
+            bits |= index << (3 * i);
+        }
+    }
+    for (int b = 0; b < 6; ++b) out[2 + b] = static_cast<unsigned char>(bits >> (8 * b));
+}
+
+static const int BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Appends `count` bits of `value` to a 128-bit little-endian block
+static void putBits(uint64_t bits[2], uint32_t& pos, uint64_t value, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i, ++pos) {
+        if ((value >> i) & 1u) bits[pos >> 6] |= uint64_t(1) << (pos & 63u);
+    }
+}
+
+// BC7 mode 6 (one subset, RGBA 7.7.7.7 endpoints with a p-bit each, 4-bit
+// indices). Endpoints span the block's principal axis; every texel then picks
+// the nearest of the 16 palette entries.
+static void encodeBC7(const unsigned char px[16][4], unsigned char* out) {
+    float mean[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < 4; ++c) mean[c] += px[i][c] / 16.0f;
+    float cov[4][4] = {};
+    float lo[4] = {255, 255, 255, 255}, hi[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        float d[4];
+        for (int c = 0; c < 4; ++c) {
+            d[c] = px[i][c] - mean[c];
+            lo[c] = std::min<float>(lo[c], px[i][c]);
+            hi[c] = std::max<float>(hi[c], px[i][c]);
+        }
+        for (int a = 0; a < 4; ++a)
+            for (int b = 0; b < 4; ++b) cov[a][b] += d[a] * d[b];
+    }
+    // Power iteration from the bounding box diagonal
+    float axis[4];
+    for (int c = 0; c < 4; ++c) axis[c] = hi[c] - lo[c];
+    for (int it = 0; it < 8; ++it) {
+        float next[4] = {0, 0, 0, 0};
+        for (int a = 0; a < 4; ++a)
+            for (int b = 0; b < 4; ++b) next[a] += cov[a][b] * axis[b];
+        float len = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+        if (len < 1e-6f) break;
+        for (int c = 0; c < 4; ++c) axis[c] = next[c] / len;
+    }
+    float axisLen2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3];
+    float tMin = 0.0f, tMax = 0.0f;
+    if (axisLen2 > 1e-12f) {
+        tMin = 1e30f;
+        tMax = -1e30f;
+        for (int i = 0; i < 16; ++i) {
+            float t = 0.0f;
+            for (int c = 0; c < 4; ++c) t += (px[i][c] - mean[c]) * axis[c];
+            tMin = std::min(tMin, t / axisLen2);
+            tMax = std::max(tMax, t / axisLen2);
+        }
+    }
+
+    // Quantize both endpoints to 7 bits plus the p-bit that fits them best
+    int endpoint[2][4];
+    int pbit[2];
+    for (int e = 0; e < 2; ++e) {
+        float target[4];
+        for (int c = 0; c < 4; ++c) target[c] = std::clamp(mean[c] + axis[c] * (e == 0 ? tMin : tMax), 0.0f, 255.0f);
+        float bestErr = 1e30f;
+        for (int p = 0; p < 2; ++p) {
+            int q[4];
+            float err = 0.0f;
+            for (int c = 0; c < 4; ++c) {
+                q[c] = std::clamp(static_cast<int>(std::lround((target[c] - p) * 0.5f)), 0, 127);
+                float d = static_cast<float>(q[c] * 2 + p) - target[c];
+                err += d * d;
+            }
+            if (err < bestErr) {
+                bestErr = err;
+                pbit[e] = p;
+                memcpy(endpoint[e], q, sizeof(q));
+            }
+        }
+    }
+
+    int palette[16][4];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            int e0 = endpoint[0][c] * 2 + pbit[0];
+            int e1 = endpoint[1][c] * 2 + pbit[1];
+            palette[i][c] = ((64 - BC7_WEIGHTS4[i]) * e0 + BC7_WEIGHTS4[i] * e1 + 32) >> 6;
+        }
+    }
+    int index[16];
+    for (int i = 0; i < 16; ++i) {
+        int best = 0, bestErr = 1 << 30;
+        for (int k = 0; k < 16; ++k) {
+            int err = 0;
+            for (int c = 0; c < 4; ++c) {
+                int d = palette[k][c] - px[i][c];
+                err += d * d;
+            }
+            if (err < bestErr) { bestErr = err; best = k; }
+        }
+        index[i] = best;
+    }
+    // The anchor (texel 0) index is stored without its top bit: swap the
+    // endpoints when it is set. The weights are symmetric, so 15 - index
+    // decodes to the same colour.
+    if (index[0] & 8) {
+        for (int c = 0; c < 4; ++c) std::swap(endpoint[0][c], endpoint[1][c]);
+        std::swap(pbit[0], pbit[1]);
+        for (int i = 0; i < 16; ++i) index[i] = 15 - index[i];
+    }
+
+    uint64_t bits[2] = {0, 0};
+    uint32_t pos = 0;
+    putBits(bits, pos, 1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        putBits(bits, pos, static_cast<uint64_t>(endpoint[0][c]), 7);
+        putBits(bits, pos, static_cast<uint64_t>(endpoint[1][c]), 7);
+    }
+    putBits(bits, pos, static_cast<uint64_t>(pbit[0]), 1);
+    putBits(bits, pos, static_cast<uint64_t>(pbit[1]), 1);
+    for (int i = 0; i < 16; ++i) putBits(bits, pos, static_cast<uint64_t>(index[i]), i == 0 ? 3 : 4);
+    for (int b = 0; b < 16; ++b) out[b] = static_cast<unsigned char>(bits[b >> 3] >> (8 * (b & 7)));
+}
+
+// Encode one RGBA8 level (w x h) into `format` blocks at `dst`. Blocks that
+// overhang the level edge repeat its last row/column.
+static void compressLevel(const unsigned char* rgba, uint32_t w, uint32_t h, uint32_t format, unsigned char* dst) {
+    const uint32_t bw = (w + 3u) / 4u, bh = (h + 3u) / 4u;
+    const uint32_t blockBytes = (format == COOKED_FORMAT_BC4_UNORM) ? 8u : 16u;
+    for (uint32_t by = 0; by < bh; ++by) {
+        for (uint32_t bx = 0; bx < bw; ++bx) {
+            unsigned char px[16][4];
+            for (uint32_t i = 0; i < 16; ++i) {
+                uint32_t x = std::min(bx * 4u + (i & 3u), w - 1u);
+                uint32_t y = std::min(by * 4u + (i >> 2), h - 1u);
+                memcpy(px[i], rgba + (static_cast<size_t>(y) * w + x) * 4u, 4);
+            }
+            unsigned char* out = dst + (static_cast<size_t>(by) * bw + bx) * blockBytes;
+            if (format == COOKED_FORMAT_BC7_UNORM || format == COOKED_FORMAT_BC7_SRGB) {
+                encodeBC7(px, out);
+            } else {
+                const int channels = (format == COOKED_FORMAT_BC5_UNORM) ? 2 : 1;
+                for (int c = 0; c < channels; ++c) {
+                    unsigned char v[16];
+                    for (int i = 0; i < 16; ++i) v[i] = px[i][c];
+                    encodeBC4(v, out + c * 8);
+                }
+            }
+        }
+    }
+}
+
+void TextureCooker::fill(const TextureCookParams& params, CookedTexture& out) {
+    layoutLevels(params.width, params.height, params.mipLevels, params.format, out);
+    if (!isBlockCompressed(params.format)) {
+        for (size_t p = 0; p + 4 <= out.data.size(); p += 4) {
+            memcpy(out.data.data() + p, params.defaultVal, 4);
+        }
+        return;
+    }
+    // Every block of a constant colour encodes identically
+    unsigned char px[4 * 4 * 4];
+    for (int i = 0; i < 16; ++i) memcpy(px + i * 4, params.defaultVal, 4);
+    unsigned char block[16];
+    compressLevel(px, 4, 4, params.format, block);
+    const size_t blockBytes = (params.format == COOKED_FORMAT_BC4_UNORM) ? 8u : 16u;
+    for (size_t p = 0; p + blockBytes <= out.data.size(); p += blockBytes) {
+        memcpy(out.data.data() + p, block, blockBytes);
+    }
+}
+
+// Per-axis resampling taps: box footprint when minifying, bilinear when magnifying.
+struct Tap { int index; float weight; };
+
+static std::vector<std::vector<Tap>> axisTaps(int n, int m) {
+    std::vector<std::vector<Tap>> taps(static_cast<size_t>(m));
+    double scale = static_cast<double>(n) / static_cast<double>(m);
+    for (int i = 0; i < m; ++i) {
+        auto &t = taps[static_cast<size_t>(i)];
+        if (scale >= 1.0) {
+            double a = i * scale;
+            double b = (i + 1) * scale;
+            int s0 = static_cast<int>(std::floor(a));
+            int s1 = std::min(n, static_cast<int>(std::ceil(b)));
+            for (int s = s0; s < s1; ++s) {
+                double w = std::min(b, static_cast<double>(s + 1)) - std::max(a, static_cast<double>(s));
+                if (w > 0.0) t.push_back({s, static_cast<float>(w / scale)});
+            }
+        } else {
+            double c = (i + 0.5) * scale - 0.5;
+            int s0 = static_cast<int>(std::floor(c));
+            float f = static_cast<float>(c - s0);
+            t.push_back({std::clamp(s0, 0, n - 1), 1.0f - f});
+            t.push_back({std::clamp(s0 + 1, 0, n - 1), f});
+        }
+    }
+    return taps;
+}
+
+// Separable RGBA float resample (sw x sh) -> (dw x dh)
+static std::vector<float> resample(const std::vector<float>& src, int sw, int sh, int dw, int dh) {
+    if (sw == dw && sh == dh) return src;
+    auto tx = axisTaps(sw, dw);
+    auto ty = axisTaps(sh, dh);
+    std::vector<float> tmp(static_cast<size_t>(dw) * sh * 4, 0.0f);
+    for (int y = 0; y < sh; ++y) {
+        const float* row = &src[static_cast<size_t>(y) * sw * 4];
+        float* out = &tmp[static_cast<size_t>(y) * dw * 4];
+        for (int x = 0; x < dw; ++x) {
+            float acc[4] = {0, 0, 0, 0};
+            for (const Tap &t : tx[static_cast<size_t>(x)]) {
+                const float* s = row + static_cast<size_t>(t.index) * 4;
+                for (int c = 0; c < 4; ++c) acc[c] += s[c] * t.weight;
+            }
+            memcpy(out + static_cast<size_t>(x) * 4, acc, sizeof(acc));
+        }
+    }
+    std::vector<float> dst(static_cast<size_t>(dw) * dh * 4, 0.0f);
+    for (int y = 0; y < dh; ++y) {
+        float* out = &dst[static_cast<size_t>(y) * dw * 4];
+        for (const Tap &t : ty[static_cast<size_t>(y)]) {
+            const float* row = &tmp[static_cast<size_t>(t.index) * dw * 4];
+            for (int i = 0; i < dw * 4; ++i) out[i] += row[i] * t.weight;
+        }
+    }
+    return dst;
+}
+
+static inline float srgbToLinear(float s) {
+    return (s <= 0.04045f) ? (s / 12.92f) : std::pow((s + 0.055f) / 1.055f, 2.4f);
+}
+
+static inline float linearToSrgb(float l) {
+    l = std::clamp(l, 0.0f, 1.0f);
+    return (l <= 0.0031308f) ? (l * 12.92f) : (1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f);
+}
+
+static inline unsigned char quantize(float v) {
+    int q = static_cast<int>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+    return static_cast<unsigned char>(q);
+}
+
+// Store one float level (w x h) into the cooked data; normal maps are
+// renormalized per texel so minified normals keep unit length. `scratch`
+// holds the RGBA8 level for the block encoders.
+static void storeLevel(const std::vector<float>& lvl, uint32_t w, uint32_t h, const TextureCookParams& params,
+                       std::vector<unsigned char>& scratch, unsigned char* dst) {
+    const bool compressed = TextureCooker::isBlockCompressed(params.format);
+    // BC7 sRGB blocks hold encoded colour: the sampler decodes after filtering
+    const bool encodeSrgb = params.format == COOKED_FORMAT_BC7_SRGB;
+    size_t texels = lvl.size() / 4;
+    if (compressed) scratch.resize(texels * 4);
+    unsigned char* texelDst = compressed ? scratch.data() : dst;
+    for (size_t i = 0; i < texels; ++i) {
+        const float* s = &lvl[i * 4];
+        unsigned char* d = texelDst + i * 4;
+        if (params.normalMap) {
+            float n[3] = { s[0] * 2.0f - 1.0f, s[1] * 2.0f - 1.0f, s[2] * 2.0f - 1.0f };
+            float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len > 1e-6f) { n[0] /= len; n[1] /= len; n[2] /= len; }
+            else { n[0] = 0.0f; n[1] = 0.0f; n[2] = 1.0f; }
+            for (int c = 0; c < 3; ++c) d[c] = quantize(n[c] * 0.5f + 0.5f);
+        } else if (encodeSrgb) {
+            for (int c = 0; c < 3; ++c) d[c] = quantize(linearToSrgb(s[c]));
+        } else {
+            for (int c = 0; c < 3; ++c) d[c] = quantize(s[c]);
+        }
+        d[3] = quantize(s[3]);
+    }
+    if (compressed) compressLevel(scratch.data(), w, h, params.format, dst);
+}
+
+std::string TextureCooker::cachePath(const char* path, uint64_t sourceHash, const TextureCookParams& params) {
+    // defaultVal is deliberately not part of the key: it only applies when
+    // there is no source file, and such textures are never cached.
+    uint32_t key[6] = {
+        params.width, params.height, params.mipLevels,
+        (params.srgb ? 1u : 0u) | (params.normalMap ? 2u : 0u),
+        params.format,
+        COOKER_VERSION
+    };
+    uint64_t h = hashBytes(key, sizeof(key), sourceHash);
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+    std::string stem = std::filesystem::path(path).stem().string();
+    return cacheDirectory + "/" + stem + "-" + hex + ".ktx2";
+}
+
+bool TextureCooker::cook(const char* path, const TextureCookParams& params, CookedTexture& out, bool* cacheHit) {
+    if (cacheHit) *cacheHit = false;
+    if (!path) {
+        fill(params, out);
+        return true;
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+    std::vector<unsigned char> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    file.close();
+
+    const std::string cached = cachePath(path, hashBytes(bytes.data(), bytes.size()), params);
+    if (readKtx2(cached, out) && out.width == params.width && out.height == params.height &&
+        out.mipLevels() == params.mipLevels && out.vkFormat == params.format) {
+        if (cacheHit) *cacheHit = true;
+        return true;
+    }
+
+    int texW = 0, texH = 0, texC = 0;
+    unsigned char* pixels = stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &texW, &texH, &texC, 4);
+    if (!pixels) return false;
+
+    // Decode to float (linear for sRGB sources) so resizing and mip filtering
+    // happen before quantization instead of compounding 8-bit rounding.
+    std::vector<float> level(static_cast<size_t>(texW) * texH * 4);
+    float lut[256];
+    for (int i = 0; i < 256; ++i) lut[i] = params.srgb ? srgbToLinear(i / 255.0f) : (i / 255.0f);
+    for (size_t i = 0; i < level.size(); ++i) {
+        level[i] = ((i & 3u) == 3u) ? (pixels[i] / 255.0f) : lut[pixels[i]];
+    }
+    stbi_image_free(pixels);
+
+    layoutLevels(params.width, params.height, params.mipLevels, params.format, out);
+    std::vector<unsigned char> scratch;
+    int curW = texW, curH = texH;
+    for (uint32_t l = 0; l < params.mipLevels; ++l) {
+        int lw = static_cast<int>(std::max(1u, params.width >> l));
+        int lh = static_cast<int>(std::max(1u, params.height >> l));
+        level = resample(level, curW, curH, lw, lh);
+        curW = lw;
+        curH = lh;
+        storeLevel(level, static_cast<uint32_t>(lw), static_cast<uint32_t>(lh), params, scratch, out.data.data() + out.mipOffsets[l]);
+    }
+
+    if (!writeKtx2(cached, out)) {
+        std::cerr << "[TextureCooker] Warning: failed to write cache entry " << cached << std::endl;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// KTX2 container (https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html)
+// Only what the cooker emits is supported: one 2D image in RGBA8 UNORM or one
+// of the BC formats above, no supercompression, no key/value data.
+// ---------------------------------------------------------------------------
+
+static const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+#pragma pack(push, 1)
+struct Ktx2Header {
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+#pragma pack(pop)
+static_assert(sizeof(Ktx2Header) == 68, "KTX2 header must be packed");
+
+struct Ktx2Level {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+// Basic data format descriptor for the cooked formats
+static std::vector<uint32_t> formatDfd(uint32_t format) {
+    struct Sample { uint32_t bitOffset, bitLength, channel, upper; };
+    std::vector<Sample> samples;
+    uint32_t model = 1u;                        // RGBSDA
+    uint32_t blockDims = 0u;                    // 1x1x1x1
+    uint32_t bytesPlane0 = 4u;
+    switch (format) {
+        case COOKED_FORMAT_BC4_UNORM:
+            model = 131u; blockDims = 3u | (3u << 8); bytesPlane0 = 8u;
+            samples = { { 0u, 63u, 0u, 0xFFFFFFFFu } };
+            break;
+        case COOKED_FORMAT_BC5_UNORM:
+            model = 132u; blockDims = 3u | (3u << 8); bytesPlane0 = 16u;
+            samples = { { 0u, 63u, 0u, 0xFFFFFFFFu }, { 64u, 63u, 1u, 0xFFFFFFFFu } };
+            break;
+        case COOKED_FORMAT_BC7_UNORM:
+        case COOKED_FORMAT_BC7_SRGB:
+            model = 134u; blockDims = 3u | (3u << 8); bytesPlane0 = 16u;
+            samples = { { 0u, 127u, 0u, 0xFFFFFFFFu } };
+            break;
+        default:
+            samples = { { 0u, 7u, 0u, 255u }, { 8u, 7u, 1u, 255u }, { 16u, 7u, 2u, 255u }, { 24u, 7u, 15u, 255u } };
+            break;
+    }
+    const uint32_t transfer = (format == COOKED_FORMAT_BC7_SRGB) ? 2u : 1u;
+    const uint32_t blockSize = 24u + 16u * static_cast<uint32_t>(samples.size());
+    std::vector<uint32_t> dfd;
+    dfd.push_back(4u + blockSize);                      // dfdTotalSize
+    dfd.push_back(0u);                                  // vendorId=KHRONOS, descriptorType=BASICFORMAT
+    dfd.push_back((blockSize << 16) | 2u);              // versionNumber=2, descriptorBlockSize
+    dfd.push_back(model | (1u << 8) | (transfer << 16)); // model, primaries=BT709, transfer, flags=0
+    dfd.push_back(blockDims);                           // texelBlockDimension
+    dfd.push_back(bytesPlane0);
+    dfd.push_back(0u);
+    for (const Sample &sm : samples) {
+        dfd.push_back(sm.bitOffset | (sm.bitLength << 16) | (sm.channel << 24));
+        dfd.push_back(0u);
+        dfd.push_back(0u);
+        dfd.push_back(sm.upper);
+    }
+    return dfd;
+}
+
+bool TextureCooker::writeKtx2(const std::string& path, const CookedTexture& tex) {
+    const uint32_t levels = tex.mipLevels();
+    if (levels == 0) return false;
+
+    const std::vector<uint32_t> dfd = formatDfd(tex.vkFormat);
+    Ktx2Header hdr{};
+    hdr.vkFormat = tex.vkFormat;
+    hdr.typeSize = 1;
+    hdr.pixelWidth = tex.width;
+    hdr.pixelHeight = tex.height;
+    hdr.faceCount = 1;
+    hdr.levelCount = levels;
+    hdr.dfdByteOffset = static_cast<uint32_t>(sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header) + levels * sizeof(Ktx2Level));
+    hdr.dfdByteLength = static_cast<uint32_t>(dfd.size() * sizeof(uint32_t));
+
+    // Mip data is stored smallest level first, each level aligned to
+    // lcm(texel block size, 4), as the specification requires
+    const uint64_t texelBlockBytes = (tex.vkFormat == COOKED_FORMAT_BC4_UNORM) ? 8u : isBlockCompressed(tex.vkFormat) ? 16u : 4u;
+    const uint64_t alignment = std::lcm(texelBlockBytes, uint64_t(4u));
+    std::vector<Ktx2Level> index(levels);
+    uint64_t offset = hdr.dfdByteOffset + hdr.dfdByteLength;
+    for (uint32_t l = levels; l-- > 0; ) {
+        offset = (offset + alignment - 1u) / alignment * alignment;
+        index[l] = { offset, tex.mipSizes[l], tex.mipSizes[l] };
+        offset += tex.mipSizes[l];
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    // Write to a per-thread temporary file and rename so concurrent readers
+    // never observe a partially written cache entry.
+    std::string tmp = path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out.is_open()) return false;
+        out.write(reinterpret_cast<const char*>(KTX2_IDENTIFIER), sizeof(KTX2_IDENTIFIER));
+        out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(Ktx2Level)));
+        out.write(reinterpret_cast<const char*>(dfd.data()), static_cast<std::streamsize>(hdr.dfdByteLength));
+        uint64_t pos = hdr.dfdByteOffset + hdr.dfdByteLength;
+        static const char zeros[16] = {};
+        for (uint32_t l = levels; l-- > 0; ) {
+            if (index[l].byteOffset > pos) out.write(zeros, static_cast<std::streamsize>(index[l].byteOffset - pos));
+            out.write(reinterpret_cast<const char*>(tex.data.data() + tex.mipOffsets[l]), static_cast<std::streamsize>(tex.mipSizes[l]));
+            pos = index[l].byteOffset + tex.mipSizes[l];
+        }
+        if (!out.good()) {
+            out.close();
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool TextureCooker::readKtx2(const std::string& path, CookedTexture& out) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+    size_t fileSize = static_cast<size_t>(in.tellg());
+    if (fileSize < sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header)) return false;
+    std::vector<unsigned char> bytes(fileSize);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(fileSize));
+    if (!in.good()) return false;
+
+    if (memcmp(bytes.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) return false;
+    Ktx2Header hdr{};
+    memcpy(&hdr, bytes.data() + sizeof(KTX2_IDENTIFIER), sizeof(hdr));
+    if (hdr.supercompressionScheme != 0 || hdr.levelCount == 0 || hdr.pixelDepth != 0 ||
+        hdr.layerCount > 1 || hdr.faceCount != 1 ||
+        (hdr.vkFormat != COOKED_FORMAT_RGBA8_UNORM && !isBlockCompressed(hdr.vkFormat))) {
+        return false;
+    }
+
+    size_t indexOffset = sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header);
+    if (indexOffset + hdr.levelCount * sizeof(Ktx2Level) > fileSize) return false;
+    std::vector<Ktx2Level> index(hdr.levelCount);
+    memcpy(index.data(), bytes.data() + indexOffset, hdr.levelCount * sizeof(Ktx2Level));
+
+    layoutLevels(hdr.pixelWidth, hdr.pixelHeight, hdr.levelCount, hdr.vkFormat, out);
+    for (uint32_t l = 0; l < hdr.levelCount; ++l) {
+        if (index[l].byteLength != out.mipSizes[l] || index[l].byteOffset + index[l].byteLength > fileSize) return false;
+        memcpy(out.data.data() + out.mipOffsets[l], bytes.data() + index[l].byteOffset, static_cast<size_t>(out.mipSizes[l]));
+    }
+    return true;
+}
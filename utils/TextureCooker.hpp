@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// VkFormat values stored in cooked KTX2 files. Kept as plain integers so the
+// cooker has no Vulkan dependency and can be linked into the headless `cook`
+// tool.
+static constexpr uint32_t COOKED_FORMAT_RGBA8_UNORM = 37u;   // VK_FORMAT_R8G8B8A8_UNORM
+static constexpr uint32_t COOKED_FORMAT_BC4_UNORM = 139u;    // VK_FORMAT_BC4_UNORM_BLOCK
+static constexpr uint32_t COOKED_FORMAT_BC5_UNORM = 141u;    // VK_FORMAT_BC5_UNORM_BLOCK
+static constexpr uint32_t COOKED_FORMAT_BC7_UNORM = 145u;    // VK_FORMAT_BC7_UNORM_BLOCK
+static constexpr uint32_t COOKED_FORMAT_BC7_SRGB = 146u;     // VK_FORMAT_BC7_SRGB_BLOCK
+
+// Parameters that select one cooked variant of a source image. Every field
+// except defaultVal takes part in the cache key, so changing one re-cooks.
+struct TextureCookParams {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipLevels = 1;
+    // Source is sRGB encoded: decode to linear before filtering (albedo maps)
+    bool srgb = false;
+    // Source is a tangent-space normal map: renormalize every mip texel
+    bool normalMap = false;
+    // Storage format of the cooked levels. BC7_SRGB stores sRGB encoded
+    // colour (the sampler decodes it), BC5 keeps a normal's x and y (shaders
+    // rebuild z), BC4 keeps the red channel only.
+    uint32_t format = COOKED_FORMAT_RGBA8_UNORM;
+    // Colour used for every texel when no source path is given
+    unsigned char defaultVal[4] = {0, 0, 0, 255};
+};
+
+// A fully prepared mip chain ready to be copied into a texture array layer.
+// Levels are stored contiguously, level 0 first.
+struct CookedTexture {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t vkFormat = COOKED_FORMAT_RGBA8_UNORM;
+    std::vector<uint64_t> mipOffsets;
+    std::vector<uint64_t> mipSizes;
+    std::vector<unsigned char> data;
+
+    uint32_t mipLevels() const { return static_cast<uint32_t>(mipOffsets.size()); }
+};
+
+// Converts source images into the exact layout TextureArrayManager uploads:
+// resized to the layer size with a box filter, sRGB decoded in float, a
+// CPU-built mip chain, and block-compressed when params.format asks for a BC
+// format. Results are cached on disk as KTX2 files named after a hash of the
+// source bytes and the cook parameters, so the second run skips JPEG
+// decoding, resizing, mip generation and compression entirely.
+// All functions are thread-safe; TextureArrayManager calls cook() from a pool.
+class TextureCooker {
+public:
+    // Directory for cached .ktx2 files (relative to the working directory)
+    static std::string cacheDirectory;
+
+    // FNV-1a 64-bit hash
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 1469598103934665603ull);
+
+    // Total bytes of a mip chain with `levels` levels starting at w x h
+    static uint64_t mipChainSize(uint32_t w, uint32_t h, uint32_t levels, uint32_t format = COOKED_FORMAT_RGBA8_UNORM);
+    // Bytes of one w x h level (whole 4x4 blocks for the BC formats)
+    static uint64_t levelSize(uint32_t w, uint32_t h, uint32_t format);
+    static bool isBlockCompressed(uint32_t format);
+    // Block-compressed format for a map role: BC7 sRGB for colour, BC5 for
+    // normal maps, BC4 for single-channel data (height, roughness, ao, opacity)
+    static uint32_t blockFormatFor(bool srgb, bool normalMap);
+
+    // Cook `path` (or the default colour when path is null) into `out`.
+    // Returns false when the source cannot be read or decoded.
+    // `cacheHit` (optional) reports whether the result came from the KTX2 cache.
+    static bool cook(const char* path, const TextureCookParams& params, CookedTexture& out, bool* cacheHit = nullptr);
+
+    // Fill `out` with a constant-colour mip chain
+    static void fill(const TextureCookParams& params, CookedTexture& out);
+
+    // Minimal KTX2 (one 2D image, no supercompression) reader/writer
+    static bool writeKtx2(const std::string& path, const CookedTexture& tex);
+    static bool readKtx2(const std::string& path, CookedTexture& out);
+
+    // Cache file path for a given source hash and parameters
+    static std::string cachePath(const char* path, uint64_t sourceHash, const TextureCookParams& params);
+};
@@ -0,0 +1,291 @@
+#include "VirtualShadowMap.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+int32_t floorDiv(float v, float size) {
+    return static_cast<int32_t>(std::floor(v / size));
+}
+
+// Positive modulo for toroidal page-table indexing.
+int32_t wrap(int32_t v, int32_t n) {
+    int32_t m = v % n;
+    return m < 0 ? m + n : m;
+}
+
+int32_t signExtend28(uint64_t v) {
+    int32_t x = static_cast<int32_t>(v & 0x0FFFFFFFu);
+    return (x & 0x08000000) ? (x | static_cast<int32_t>(0xF0000000u)) : x;
+}
+
+} // namespace
+
+void VirtualShadowMap::configure(const Config& config) {
+    config_ = config;
+    config_.levelCount = std::clamp<uint32_t>(config_.levelCount, 1u, MAX_LEVELS);
+    config_.pagesPerLevel = std::max<uint32_t>(config_.pagesPerLevel, 2u);
+    config_.physicalPages = std::max<uint32_t>(config_.physicalPages, 1u);
+    config_.pageTexels = std::max<uint32_t>(config_.pageTexels, 1u);
+    physical_.assign(config_.physicalPages, PhysicalPage{});
+    hasLight_ = false;
+    invalidateAll();
+}
+
+void VirtualShadowMap::invalidateAll() {
+    for (auto& p : physical_) p = PhysicalPage{};
+    freeList_.clear();
+    freeList_.reserve(physical_.size());
+    // Popped from the back, so pages are handed out in ascending order.
+    for (uint32_t i = static_cast<uint32_t>(physical_.size()); i-- > 0; ) freeList_.push_back(i);
+    renderQueue_.clear();
+    resident_.clear();
+    ++generation_;
+    ++stats_.invalidations;
+}
+
+uint64_t VirtualShadowMap::makeKey(uint32_t level, int32_t px, int32_t py) {
+    return (static_cast<uint64_t>(level) << 56) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(px) & 0x0FFFFFFFu) << 28) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(py) & 0x0FFFFFFFu));
+}
+
+void VirtualShadowMap::decodeKey(uint64_t key, uint32_t& level, int32_t& px, int32_t& py) {
+    level = static_cast<uint32_t>(key >> 56);
+    px = signExtend28(key >> 28);
+    py = signExtend28(key);
+}
+
+bool VirtualShadowMap::insideWindow(uint32_t level, int32_t px, int32_t py) const {
+    const int32_t n = static_cast<int32_t>(config_.pagesPerLevel);
+    return level < config_.levelCount &&
+           px >= origin_[level][0] && px < origin_[level][0] + n &&
+           py >= origin_[level][1] && py < origin_[level][1] + n;
+}
+
+void VirtualShadowMap::update(const glm::vec3& camPos, const glm::vec3& lightDirection, float farPlane) {
+    ++frame_;
+    glm::vec3 lightDir = glm::normalize(lightDirection);
+
+    // Same stable light view as ShadowParams: anchored to the world origin, so
+    // page coordinates never move while the light is still.
+    bool relight = !hasLight_ || farPlane != farPlane_;
+    if (!relight) {
+        float cosMax = std::cos(glm::radians(config_.maxLightAngleDeg));
+        relight = glm::dot(lightDir_, lightDir) < cosMax;
+    }
+    if (relight) {
+        glm::vec3 worldUp(0.0f, 1.0f, 0.0f);
+        if (std::abs(glm::dot(lightDir, worldUp)) > 0.9f)
+            worldUp = glm::vec3(1.0f, 0.0f, 0.0f);
+        lightView_ = glm::lookAt(-lightDir * farPlane * 2.0f, glm::vec3(0.0f), worldUp);
+        lightDir_ = lightDir;
+        farPlane_ = farPlane;
+        hasLight_ = false;
+    }
+
+    glm::vec3 ls = glm::vec3(lightView_ * glm::vec4(camPos, 1.0f));
+
+    // The depth range is shared by every page so a page rendered once stays
+    // comparable with the receivers sampling it. It only recentres once the
+    // camera has used up half of it.
+    if (!hasLight_ || std::abs(ls.z - depthCenter_) > config_.depthRange * 0.5f) {
+        float step = config_.depthRange * 0.25f;
+        depthCenter_ = std::round(ls.z / step) * step;
+        if (hasLight_ || relight) invalidateAll();
+        hasLight_ = true;
+    }
+
+    const int32_t half = static_cast<int32_t>(config_.pagesPerLevel / 2);
+    for (uint32_t l = 0; l < config_.levelCount; ++l) {
+        float s = levelPageSize(l);
+        origin_[l][0] = floorDiv(ls.x, s) - half;
+        origin_[l][1] = floorDiv(ls.y, s) - half;
+    }
+}
+
+VirtualShadowMap::RequestFrame VirtualShadowMap::requestFrame() const {
+    RequestFrame f;
+    f.generation = generation_;
+    std::memcpy(f.origin, origin_, sizeof(origin_));
+    return f;
+}
+
+void VirtualShadowMap::releasePhysical(uint32_t index) {
+    PhysicalPage& p = physical_[index];
+    if (p.used) resident_.erase(p.key);
+    if (p.queued) renderQueue_.erase(std::remove(renderQueue_.begin(), renderQueue_.end(), index), renderQueue_.end());
+    p = PhysicalPage{};
+    freeList_.push_back(index);
+}
+
+uint32_t VirtualShadowMap::allocatePhysical(uint64_t requestFrame) {
+    if (freeList_.empty()) {
+        // Evict the least recently requested page that was not requested by
+        // this batch. Pages that scrolled out of their window can no longer be
+        // sampled and go first.
+        uint32_t victim = UINT32_MAX;
+        uint64_t victimAge = UINT64_MAX;
+        for (uint32_t i = 0; i < physical_.size(); ++i) {
+            const PhysicalPage& p = physical_[i];
+            if (!p.used || p.lastRequested >= requestFrame) continue;
+            uint32_t level; int32_t px, py;
+            decodeKey(p.key, level, px, py);
+            uint64_t age = insideWindow(level, px, py) ? p.lastRequested : 0;
+            if (age < victimAge) { victimAge = age; victim = i; }
+        }
+        if (victim == UINT32_MAX) return UINT32_MAX;
+        releasePhysical(victim);
+        ++stats_.evictions;
+    }
+    uint32_t index = freeList_.back();
+    freeList_.pop_back();
+    return index;
+}
+
+void VirtualShadowMap::submitRequests(const RequestFrame& frame, const uint32_t* flags, size_t count) {
+    stats_.evictions = 0;
+    stats_.droppedRequests = 0;
+    // Requests written before the last invalidation address a different
+    // light space (or depth range); ignore them.
+    if (frame.generation != generation_ || !flags || count < pageTableEntries()) return;
+
+    const int32_t n = static_cast<int32_t>(config_.pagesPerLevel);
+    struct Missing { uint32_t level; int32_t px, py; };
+    std::vector<Missing> missing;
+    uint32_t requested = 0;
+
+    for (uint32_t l = 0; l < config_.levelCount; ++l) {
+        const uint32_t* levelFlags = flags + static_cast<size_t>(l) * n * n;
+        for (int32_t ty = 0; ty < n; ++ty) {
+            for (int32_t tx = 0; tx < n; ++tx) {
+                if (!levelFlags[ty * n + tx]) continue;
+                int32_t px = frame.origin[l][0] + wrap(tx - frame.origin[l][0], n);
+                int32_t py = frame.origin[l][1] + wrap(ty - frame.origin[l][1], n);
+                ++requested;
+                auto it = resident_.find(makeKey(l, px, py));
+                if (it != resident_.end()) {
+                    physical_[it->second].lastRequested = frame_;
+                } else if (insideWindow(l, px, py)) {
+                    missing.push_back({l, px, py});
+                }
+            }
+        }
+    }
+    stats_.requestedPages = requested;
+
+    // Coarse levels first: a fine page only shows once rendered, and until
+    // then the receiver falls back to the coarser level covering it.
+    std::stable_sort(missing.begin(), missing.end(),
+                     [](const Missing& a, const Missing& b) { return a.level > b.level; });
+    for (const Missing& m : missing) {
+        uint32_t index = allocatePhysical(frame_);
+        if (index == UINT32_MAX) { ++stats_.droppedRequests; continue; }
+        PhysicalPage& p = physical_[index];
+        p.key = makeKey(m.level, m.px, m.py);
+        p.lastRequested = frame_;
+        p.used = true;
+        p.rendered = false;
+        p.queued = true;
+        resident_[p.key] = index;
+        renderQueue_.push_back(index);
+    }
+}
+
+void VirtualShadowMap::markDirtyRegion(const glm::vec3& worldMin, const glm::vec3& worldMax) {
+    if (resident_.empty()) return;
+    glm::vec2 lo( FLT_MAX), hi(-FLT_MAX);
+    for (int c = 0; c < 8; ++c) {
+        glm::vec3 p((c & 1) ? worldMax.x : worldMin.x,
+                    (c & 2) ? worldMax.y : worldMin.y,
+                    (c & 4) ? worldMax.z : worldMin.z);
+        glm::vec2 ls = glm::vec2(lightView_ * glm::vec4(p, 1.0f));
+        lo = glm::min(lo, ls);
+        hi = glm::max(hi, ls);
+    }
+    // Only pages overlapping the box in light-space XY can see the change;
+    // depth is covered by the shared range.
+    for (uint32_t i = 0; i < physical_.size(); ++i) {
+        PhysicalPage& p = physical_[i];
+        if (!p.used || !p.rendered || p.queued) continue;
+        uint32_t level; int32_t px, py;
+        decodeKey(p.key, level, px, py);
+        float s = levelPageSize(level);
+        if (hi.x < px * s || lo.x > (px + 1) * s || hi.y < py * s || lo.y > (py + 1) * s) continue;
+        p.queued = true;
+        renderQueue_.push_back(i);
+    }
+}
+
+glm::mat4 VirtualShadowMap::regionMatrix(const glm::vec2& lsMin, const glm::vec2& lsMax) const {
+    float dist = -depthCenter_;
+    glm::mat4 proj = glm::ortho(lsMin.x, lsMax.x, lsMin.y, lsMax.y,
+                                dist - config_.depthRange, dist + config_.depthRange);
+    return proj * lightView_;
+}
+
+glm::mat4 VirtualShadowMap::pageMatrix(uint32_t level, int32_t px, int32_t py) const {
+    float s = levelPageSize(level);
+    return regionMatrix(glm::vec2(px * s, py * s), glm::vec2((px + 1) * s, (py + 1) * s));
+}
+
+void VirtualShadowMap::takeRenderBatch(uint32_t budget, std::vector<PageRender>& out) {
+    out.clear();
+    size_t take = std::min<size_t>(budget, renderQueue_.size());
+    for (size_t k = 0; k < take; ++k) {
+        uint32_t index = renderQueue_[k];
+        PhysicalPage& p = physical_[index];
+        p.queued = false;
+        p.rendered = true;
+
+        PageRender r;
+        r.physical = index;
+        decodeKey(p.key, r.level, r.px, r.py);
+        float s = levelPageSize(r.level);
+        r.lsMin = glm::vec2(r.px * s, r.py * s);
+        r.lsMax = r.lsMin + glm::vec2(s);
+        r.lightSpaceMatrix = pageMatrix(r.level, r.px, r.py);
+        out.push_back(r);
+    }
+    renderQueue_.erase(renderQueue_.begin(), renderQueue_.begin() + static_cast<std::ptrdiff_t>(take));
+
+    stats_.renderedPages = static_cast<uint32_t>(take);
+    stats_.queuedPages = static_cast<uint32_t>(renderQueue_.size());
+    uint32_t residentCount = 0;
+    for (const auto& p : physical_) if (p.used && p.rendered) ++residentCount;
+    stats_.residentPages = residentCount;
+}
+
+void VirtualShadowMap::buildPageTable(uint32_t* out, bool enabled) const {
+    GpuHeader header{};
+    header.lightView = lightView_;
+    header.params = glm::vec4(static_cast<float>(config_.levelCount),
+                              static_cast<float>(config_.pagesPerLevel),
+                              config_.pageWorldSize, enabled ? 1.0f : 0.0f);
+    float dist = -depthCenter_;
+    header.depth = glm::vec4(dist - config_.depthRange, dist + config_.depthRange, 0.0f, 0.0f);
+    for (uint32_t l = 0; l < MAX_LEVELS; ++l)
+        header.origin[l] = glm::ivec4(origin_[l][0], origin_[l][1], 0, 0);
+    std::memcpy(out, &header, sizeof(header));
+
+    uint32_t* entries = out + sizeof(GpuHeader) / sizeof(uint32_t);
+    std::memset(entries, 0, pageTableEntries() * sizeof(uint32_t));
+    const int32_t n = static_cast<int32_t>(config_.pagesPerLevel);
+    for (uint32_t i = 0; i < physical_.size(); ++i) {
+        const PhysicalPage& p = physical_[i];
+        if (!p.used || !p.rendered) continue;
+        uint32_t level; int32_t px, py;
+        decodeKey(p.key, level, px, py);
+        if (!insideWindow(level, px, py)) continue;
+        size_t idx = static_cast<size_t>(level) * n * n + wrap(py, n) * n + wrap(px, n);
+        entries[idx] = i + 1;
+    }
+}
+
+size_t VirtualShadowMap::atlasBytes() const {
+    size_t pageTexels = static_cast<size_t>(config_.pageTexels) * config_.pageTexels;
+    return pageTexels * 8 * config_.physicalPages + pageTexels * 4;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+// Light.hpp defines GLM_FORCE_DEPTH_ZERO_TO_ONE — include first
+#include "../math/Light.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Clipmapped virtual shadow map (page management only, no Vulkan).
+//
+// Light space is the same stable, origin-anchored light view ShadowParams
+// uses. It is cut into square pages; level L pages are pageWorldSize * 2^L
+// world units wide and every level keeps a pagesPerLevel² window of them
+// centred on the camera, scrolling by whole pages. Pages are backed by a
+// fixed pool of physical pages (one atlas layer each) and are only allocated
+// when the mark pass saw a camera depth sample inside them.
+//
+// Per frame (main thread):
+//   update()            light view / depth window / level origins
+//   submitRequests()    page flags read back from the mark pass
+//   markDirtyRegion()   edited chunks re-render the pages they overlap
+//   takeRenderBatch()   pages to (re)render this frame, at most `budget`
+//   buildPageTable()    GPU page table, including the pages just taken
+//
+// Resident pages stay valid across frames until they are evicted (LRU over
+// the frame they were last requested), touched by an edit, or the light /
+// depth window changes (everything is dropped).
+class VirtualShadowMap {
+public:
+    static constexpr uint32_t MAX_LEVELS = 8;
+
+    struct Config {
+        uint32_t levelCount = 6;
+        uint32_t pagesPerLevel = 16;     // window is pagesPerLevel² pages per level
+        uint32_t pageTexels = 128;       // resolution of one page (atlas layer)
+        uint32_t physicalPages = 256;    // atlas layers
+        float pageWorldSize = 4.0f;      // world units covered by one level-0 page
+        float depthRange = 2048.0f;      // light-space depth kept on each side of the camera
+        float maxLightAngleDeg = 0.05f;  // light turns beyond this drop every page
+    };
+
+    // Window origins a mark pass wrote its requests against. Requests are
+    // indexed toroidally (absolute page mod pagesPerLevel), so the origins are
+    // needed to turn them back into absolute pages a few frames later.
+    struct RequestFrame {
+        uint64_t generation = 0;
+        int32_t origin[MAX_LEVELS][2] = {};
+    };
+
+    struct PageRender {
+        uint32_t physical = 0;
+        uint32_t level = 0;
+        int32_t px = 0;
+        int32_t py = 0;
+        glm::mat4 lightSpaceMatrix;      // page ortho * lightView
+        glm::vec2 lsMin;                 // light-space XY rectangle of the page
+        glm::vec2 lsMax;
+    };
+
+    // Mirrors VirtualShadowHeader in shaders/includes/virtual_shadows.glsl (std430).
+    struct GpuHeader {
+        glm::mat4 lightView;
+        glm::vec4 params;                // x = levelCount, y = pagesPerLevel, z = pageWorldSize, w = enabled
+        glm::vec4 depth;                 // x = near, y = far (light-space distances of the ortho range)
+        glm::ivec4 origin[MAX_LEVELS];   // xy = window origin in pages
+    };
+
+    struct Stats {
+        uint32_t requestedPages = 0;     // distinct pages in the last submitted request set
+        uint32_t residentPages = 0;      // physical pages holding a rendered page
+        uint32_t queuedPages = 0;        // allocated or dirty pages waiting to render
+        uint32_t renderedPages = 0;      // pages taken by the last takeRenderBatch()
+        uint32_t evictions = 0;          // pages evicted by the last submitRequests()
+        uint32_t droppedRequests = 0;    // requests no physical page could be found for
+        uint32_t invalidations = 0;      // full drops since start (light / depth window moves)
+    };
+
+    VirtualShadowMap() { configure(Config{}); }
+    explicit VirtualShadowMap(const Config& config) { configure(config); }
+
+    // Reset with new parameters (drops every page).
+    void configure(const Config& config);
+    const Config& config() const { return config_; }
+
+    void update(const glm::vec3& camPos, const glm::vec3& lightDirection, float farPlane);
+    // Drop every page (scene reloaded, mode re-enabled after being off).
+    void invalidateAll();
+
+    RequestFrame requestFrame() const;
+    // `flags` holds levelCount * pagesPerLevel² words (non-zero = requested),
+    // laid out like the page table.
+    void submitRequests(const RequestFrame& frame, const uint32_t* flags, size_t count);
+    void markDirtyRegion(const glm::vec3& worldMin, const glm::vec3& worldMax);
+
+    void takeRenderBatch(uint32_t budget, std::vector<PageRender>& out);
+
+    // Header followed by levelCount * pagesPerLevel² entries (physical + 1,
+    // 0 = not resident). Only rendered pages are published.
+    size_t pageTableWords() const { return pageTableEntries() + sizeof(GpuHeader) / sizeof(uint32_t); }
+    size_t pageTableEntries() const { return static_cast<size_t>(config_.levelCount) * config_.pagesPerLevel * config_.pagesPerLevel; }
+    void buildPageTable(uint32_t* out, bool enabled) const;
+
+    const glm::mat4& lightView() const { return lightView_; }
+    // Light-space matrix covering an arbitrary light-space XY rectangle with
+    // the shared depth range (pages use it for their own rectangle).
+    glm::mat4 regionMatrix(const glm::vec2& lsMin, const glm::vec2& lsMax) const;
+    float levelPageSize(uint32_t level) const { return config_.pageWorldSize * static_cast<float>(1u << level); }
+    // Light-space texels per world unit of the given level.
+    float levelTexelDensity(uint32_t level) const { return static_cast<float>(config_.pageTexels) / levelPageSize(level); }
+    // Bytes of the physical pool: RG32F EVSM moments per page plus one shared page depth buffer.
+    size_t atlasBytes() const;
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct PhysicalPage {
+        uint64_t key = 0;
+        uint64_t lastRequested = 0;
+        bool used = false;
+        bool rendered = false;           // holds content (possibly stale while queued)
+        bool queued = false;
+    };
+
+    static uint64_t makeKey(uint32_t level, int32_t px, int32_t py);
+    static void decodeKey(uint64_t key, uint32_t& level, int32_t& px, int32_t& py);
+    bool insideWindow(uint32_t level, int32_t px, int32_t py) const;
+    uint32_t allocatePhysical(uint64_t requestFrame);
+    void releasePhysical(uint32_t index);
+    glm::mat4 pageMatrix(uint32_t level, int32_t px, int32_t py) const;
+
+    Config config_;
+    std::vector<PhysicalPage> physical_;
+    std::vector<uint32_t> freeList_;
+    std::vector<uint32_t> renderQueue_;  // physical indices, oldest first
+    std::unordered_map<uint64_t, uint32_t> resident_;
+
+    glm::mat4 lightView_ = glm::mat4(1.0f);
+    glm::vec3 lightDir_ = glm::vec3(0.0f);
+    float farPlane_ = 0.0f;
+    float depthCenter_ = 0.0f;           // light-space z the depth range is centred on
+    bool hasLight_ = false;
+    int32_t origin_[MAX_LEVELS][2] = {};
+    uint64_t generation_ = 1;
+    uint64_t frame_ = 0;
+
+    Stats stats_;
+};
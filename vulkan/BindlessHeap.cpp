@@ -0,0 +1,153 @@
+#include "BindlessHeap.hpp"
+#include "VulkanApp.hpp"
+#include "renderer/DescriptorAllocator.hpp"
+#include <algorithm>
+#include <iostream>
+
+void BindlessHeap::init(VulkanApp* vulkanApp) {
+    app = vulkanApp;
+    VkDevice device = app->getDevice();
+
+    // Stay inside the update-after-bind limits (lavapipe and older iGPUs
+    // report far less than desktop drivers).
+    VkPhysicalDeviceDescriptorIndexingProperties indexingProps{};
+    indexingProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+    VkPhysicalDeviceProperties2 props2{};
+    props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    props2.pNext = &indexingProps;
+    vkGetPhysicalDeviceProperties2(app->getPhysicalDevice(), &props2);
+    imageCapacity = std::min(MAX_IMAGES, indexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages);
+    bufferCapacity = std::min(MAX_BUFFERS, indexingProps.maxPerStageDescriptorUpdateAfterBindStorageBuffers);
+
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT;
+    VkDescriptorSetLayoutBinding bindings[2]{};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = imageCapacity;
+    bindings[0].stageFlags = stages;
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = bufferCapacity;
+    bindings[1].stageFlags = stages;
+
+    const VkDescriptorBindingFlags flags =
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    VkDescriptorBindingFlags bindingFlags[2] = { flags, flags };
+
+    DescriptorAllocator descAlloc{device, app};
+    layout = descAlloc.createLayout(bindings, 2,
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        bindingFlags,
+        "BindlessHeap: layout");
+
+    VkDescriptorPoolSize poolSizes[2] = {
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageCapacity },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferCapacity },
+    };
+    pool = descAlloc.createPool(poolSizes, 2, 1,
+        VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        "BindlessHeap: pool");
+    set = descAlloc.allocateSet(pool, layout, "BindlessHeap: set");
+
+    std::cerr << "[BindlessHeap] " << imageCapacity << " image slots, "
+              << bufferCapacity << " buffer slots" << std::endl;
+}
+
+void BindlessHeap::cleanup() {
+    // Layout, pool and set are owned by VulkanResourceManager
+    layout = VK_NULL_HANDLE;
+    pool = VK_NULL_HANDLE;
+    set = VK_NULL_HANDLE;
+    std::lock_guard<std::mutex> lock(mutex);
+    freeImages.clear();
+    freeBuffers.clear();
+    imageHighWater = 0;
+    bufferHighWater = 0;
+}
+
+uint32_t BindlessHeap::acquire(std::vector<uint32_t>& freeList, uint32_t& highWater, uint32_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeList.empty()) {
+        uint32_t index = freeList.back();
+        freeList.pop_back();
+        return index;
+    }
+    if (highWater >= capacity) return INVALID_INDEX;
+    return highWater++;
+}
+
+void BindlessHeap::release(std::vector<uint32_t>& freeList, uint32_t index) {
+    if (index == INVALID_INDEX || !app) return;
+    // A recorded frame may still index this slot: only reuse it (and thus
+    // rewrite the descriptor) once every pending frame has retired.
+    app->deferDestroyUntilAllPending([this, &freeList, index]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeList.push_back(index);
+    });
+}
+
+uint32_t BindlessHeap::registerImage(VkImageView view, VkSampler sampler, VkImageLayout imageLayout) {
+    if (set == VK_NULL_HANDLE || view == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE) return INVALID_INDEX;
+    uint32_t index = acquire(freeImages, imageHighWater, imageCapacity);
+    if (index == INVALID_INDEX) {
+        std::cerr << "[BindlessHeap] out of image slots (" << imageCapacity << ")" << std::endl;
+        return INVALID_INDEX;
+    }
+
+    VkDescriptorImageInfo info{ sampler, view, imageLayout };
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = 0;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &info;
+    // Host updates of one set must be serialized (the async back-face task
+    // registers its cull buffers off the frame thread).
+    std::lock_guard<std::mutex> lock(mutex);
+    vkUpdateDescriptorSets(app->getDevice(), 1, &write, 0, nullptr);
+    return index;
+}
+
+uint32_t BindlessHeap::registerBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+    if (set == VK_NULL_HANDLE || buffer == VK_NULL_HANDLE) return INVALID_INDEX;
+    uint32_t index = acquire(freeBuffers, bufferHighWater, bufferCapacity);
+    if (index == INVALID_INDEX) {
+        std::cerr << "[BindlessHeap] out of buffer slots (" << bufferCapacity << ")" << std::endl;
+        return INVALID_INDEX;
+    }
+
+    VkDescriptorBufferInfo info{ buffer, offset, range };
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = 1;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &info;
+    std::lock_guard<std::mutex> lock(mutex);
+    vkUpdateDescriptorSets(app->getDevice(), 1, &write, 0, nullptr);
+    return index;
+}
+
+void BindlessHeap::releaseImage(uint32_t index) {
+    release(freeImages, index);
+}
+
+void BindlessHeap::releaseBuffer(uint32_t index) {
+    release(freeBuffers, index);
+}
+
+uint32_t BindlessHeap::replaceImage(uint32_t slot, VkImageView view, VkSampler sampler, VkImageLayout imageLayout) {
+    releaseImage(slot);
+    return registerImage(view, sampler, imageLayout);
+}
+
+uint32_t BindlessHeap::replaceBuffer(uint32_t slot, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+    releaseBuffer(slot);
+    return registerBuffer(buffer, offset, range);
+}
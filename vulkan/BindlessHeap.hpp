@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class VulkanApp;
+
+// Global bindless descriptor heap (descriptor indexing).
+//
+// One UPDATE_AFTER_BIND + PARTIALLY_BOUND descriptor set, allocated once and
+// never reallocated, holding:
+//   binding 0: combined image samplers (sampler2D / sampler2DArray /
+//              samplerCube aliases)
+//   binding 1: storage buffers
+// It carries every texture array, render-target view and storage buffer the
+// scene passes read: the TextureArrayManager arrays, materials, water params,
+// shadow maps, brush and water scene targets, vegetation/impostor data and
+// the per-chunk cull buffers. Shaders address them by slot through the frame
+// UBO, push constants or per-draw data (shaders/includes/bindless.glsl).
+//
+// Every scene pipeline layout is {main set, heap} plus the shared scene
+// push-constant range (VulkanApp::getSceneSetLayouts), so the heap is bound
+// once per command buffer at set 1 and stays bound across pipeline changes.
+//
+// Slots are never rewritten while a frame may still read them: replacing a
+// resource registers a new slot and releases the old one, which only returns
+// to the free list once every pending frame has retired. Reallocating a
+// texture array or a buffer therefore invalidates no descriptor set.
+class BindlessHeap {
+public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    static constexpr uint32_t MAX_IMAGES = 4096;
+    static constexpr uint32_t MAX_BUFFERS = 1024;
+
+    void init(VulkanApp* app);
+    void cleanup();
+
+    VkDescriptorSetLayout getLayout() const { return layout; }
+    VkDescriptorSet getSet() const { return set; }
+
+    uint32_t registerImage(VkImageView view, VkSampler sampler,
+                           VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    uint32_t registerBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+    // Deferred until all pending frames complete; INVALID_INDEX is ignored.
+    void releaseImage(uint32_t index);
+    void releaseBuffer(uint32_t index);
+
+    // Release `slot` (if any) and register the new resource in its place.
+    uint32_t replaceImage(uint32_t slot, VkImageView view, VkSampler sampler,
+                          VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    uint32_t replaceBuffer(uint32_t slot, VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+    uint32_t getImageCount() const { return imageHighWater - static_cast<uint32_t>(freeImages.size()); }
+    uint32_t getBufferCount() const { return bufferHighWater - static_cast<uint32_t>(freeBuffers.size()); }
+
+private:
+    uint32_t acquire(std::vector<uint32_t>& freeList, uint32_t& highWater, uint32_t capacity);
+    void release(std::vector<uint32_t>& freeList, uint32_t index);
+
+    VulkanApp* app = nullptr;
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    uint32_t imageCapacity = 0;
+    uint32_t bufferCapacity = 0;
+
+    std::mutex mutex; // slot lists and set writes (callers span several threads)
+    std::vector<uint32_t> freeImages;
+    std::vector<uint32_t> freeBuffers;
+    uint32_t imageHighWater = 0;
+    uint32_t bufferHighWater = 0;
+};
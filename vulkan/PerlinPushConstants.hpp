@@ -17,5 +17,6 @@ struct PerlinPushConstants {
     uint32_t secondaryLayer;  // offset 40
     uint32_t targetLayer;     // offset 44
     uint32_t debugOutput;     // offset 48 - 1 = write noise to rgb when set
-    // Total: 52 bytes (padded to 4-byte boundary)
+    uint32_t workLayerMask;   // offset 52 - bit per map (0=albedo..4=ao): write layer 0 of its work image
+    // Total: 56 bytes (padded to 4-byte boundary)
 };
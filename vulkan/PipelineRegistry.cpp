@@ -0,0 +1,468 @@
+#include "PipelineRegistry.hpp"
+#include "../utils/TextureCooker.hpp"
+#include "../math/Math.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+std::string PipelineRegistry::cacheDirectory = "cache/pipelines";
+
+namespace {
+thread_local VkPipelineCache tlsWorkerCache = VK_NULL_HANDLE;
+
+constexpr char PIPELINE_BINARY_MAGIC[4] = { 'P', 'B', 'I', 'N' };
+constexpr uint32_t PIPELINE_BINARY_VERSION = 1;
+
+std::string toHex(const void* data, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    std::string out;
+    out.reserve(size * 2);
+    for (size_t i = 0; i < size; ++i) {
+        out.push_back(digits[bytes[i] >> 4]);
+        out.push_back(digits[bytes[i] & 0xF]);
+    }
+    return out;
+}
+
+bool readFile(const std::string& path, std::vector<char>& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Write to a temporary file and rename so a crash never leaves a truncated
+// entry (the temp name is per thread: compileBatch workers write concurrently).
+bool writeFileAtomic(const std::string& path, const void* data, size_t size) {
+    try {
+        const std::string tmp = path + ".tmp" +
+            std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        bool ok = false;
+        {
+            std::ofstream out(tmp, std::ios::binary);
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            ok = static_cast<bool>(out);
+        }
+        if (ok) std::filesystem::rename(tmp, path);
+        else std::filesystem::remove(tmp);
+        return ok;
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[PipelineRegistry] write %s: %s\n", path.c_str(), e.what());
+        return false;
+    }
+}
+
+// Hash of every SPIR-V module in the shader directory, in name order, so any
+// shader rebuild selects a different cache file.
+uint64_t hashShaderDirectory(const std::string& shaderDir) {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(shaderDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".spv") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    uint64_t h = TextureCooker::hashBytes(nullptr, 0);
+    std::vector<char> code;
+    for (const auto& file : files) {
+        const std::string name = file.filename().string();
+        h = TextureCooker::hashBytes(name.data(), name.size(), h);
+        if (readFile(file.string(), code)) h = TextureCooker::hashBytes(code.data(), code.size(), h);
+    }
+    return h;
+}
+
+std::vector<char> getCacheData(VkDevice device, VkPipelineCache cache) {
+    std::vector<char> data;
+    size_t size = 0;
+    if (cache == VK_NULL_HANDLE || vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS || size == 0)
+        return data;
+    data.resize(size);
+    if (vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS) data.clear();
+    else data.resize(size);
+    return data;
+}
+}
+
+VkPipelineCache PipelineRegistry::threadCache() {
+    return tlsWorkerCache;
+}
+
+// ---------- Persistent cache ----------
+
+VkPipelineCache PipelineRegistry::createCache(VkDevice device, VkPhysicalDevice physicalDevice,
+                                              const std::string& shaderDir) {
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+
+    const uint32_t ids[3] = { props.vendorID, props.deviceID, props.driverVersion };
+    uint64_t driverKey = TextureCooker::hashBytes(ids, sizeof(ids));
+    driverKey = TextureCooker::hashBytes(props.pipelineCacheUUID, VK_UUID_SIZE, driverKey);
+    const uint64_t shaderKey = hashShaderDirectory(shaderDir);
+
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-%016llx.bin",
+             static_cast<unsigned long long>(driverKey), static_cast<unsigned long long>(shaderKey));
+    cachePath = cacheDirectory + "/" + name;
+
+    // Drivers validate the header too, but a mismatched blob is still parsed
+    // by some; only hand over data whose header matches this device.
+    std::vector<char> cacheData;
+    if (readFile(cachePath, cacheData)) {
+        VkPipelineCacheHeaderVersionOne header{};
+        bool valid = cacheData.size() >= sizeof(header);
+        if (valid) {
+            std::memcpy(&header, cacheData.data(), sizeof(header));
+            valid = header.headerSize >= sizeof(header) &&
+                    header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                    header.vendorID == props.vendorID && header.deviceID == props.deviceID &&
+                    std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        }
+        if (!valid) {
+            fprintf(stderr, "[PipelineRegistry] Ignoring pipeline cache with mismatched header: %s\n", cachePath.c_str());
+            cacheData.clear();
+        }
+    }
+    warmCache = !cacheData.empty();
+
+    VkPipelineCacheCreateInfo ci{};
+    ci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    if (warmCache) {
+        ci.initialDataSize = cacheData.size();
+        ci.pInitialData = cacheData.data();
+    }
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    if (vkCreatePipelineCache(device, &ci, nullptr, &cache) != VK_SUCCESS) {
+        std::cerr << "[PipelineRegistry] Warning: Failed to create pipeline cache, proceeding without" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+    printf("[PipelineRegistry] Pipeline cache %s (%zu bytes loaded)\n", cachePath.c_str(), cacheData.size());
+    return cache;
+}
+
+void PipelineRegistry::saveCache(VkDevice device, VkPipelineCache cache) const {
+    if (cache == VK_NULL_HANDLE || cachePath.empty()) {
+        printf("[PipelineRegistry] Pipeline cache not available, skipping save\n");
+        return;
+    }
+    const std::vector<char> data = getCacheData(device, cache);
+    if (data.empty()) {
+        std::cerr << "[PipelineRegistry] Warning: Failed to read pipeline cache data" << std::endl;
+        return;
+    }
+    try {
+        ensureFolderExists(cacheDirectory);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[PipelineRegistry] %s: %s\n", cacheDirectory.c_str(), e.what());
+        return;
+    }
+    if (writeFileAtomic(cachePath, data.data(), data.size()))
+        printf("[PipelineRegistry] Saved pipeline cache (%zu bytes) to %s\n", data.size(), cachePath.c_str());
+}
+
+// ---------- Parallel startup compilation ----------
+
+void PipelineRegistry::beginBatch() {
+    batching = true;
+}
+
+void PipelineRegistry::declare(const std::string& name, Builder build) {
+    if (!build) return;
+    if (!batching) {
+        build();
+        return;
+    }
+    pending.push_back({ name, std::move(build) });
+}
+
+void PipelineRegistry::abortBatch() {
+    batching = false;
+    if (!pending.empty())
+        fprintf(stderr, "[PipelineRegistry] Dropped %zu pipeline groups of an aborted batch\n", pending.size());
+    pending.clear();
+}
+
+void PipelineRegistry::compileBatch(VkDevice device, VkPipelineCache mainCache, uint32_t threads) {
+    // Leave batch mode before anything can throw; a builder that declare()s
+    // from a worker runs inline instead of queueing into a drained batch.
+    batching = false;
+    std::vector<Pending> jobs;
+    jobs.swap(pending);
+    lastBatchCount = jobs.size();
+    lastBatchMs = 0.0;
+    if (jobs.empty()) return;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<uint32_t>(threads, static_cast<uint32_t>(jobs.size()));
+
+    // Seed each worker cache with the main cache contents so warm entries hit
+    // on every thread, then merge what the workers added back at the end.
+    const std::vector<char> seed = getCacheData(device, mainCache);
+    std::vector<VkPipelineCache> caches(threads, VK_NULL_HANDLE);
+    for (auto& cache : caches) {
+        VkPipelineCacheCreateInfo ci{};
+        ci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        ci.initialDataSize = seed.size();
+        ci.pInitialData = seed.empty() ? nullptr : seed.data();
+        if (vkCreatePipelineCache(device, &ci, nullptr, &cache) != VK_SUCCESS) cache = VK_NULL_HANDLE;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr firstError;
+    std::string failedName;
+    std::mutex errorMutex;
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (uint32_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                // Workers without a cache of their own fall back to the main one
+                tlsWorkerCache = caches[t] != VK_NULL_HANDLE ? caches[t] : mainCache;
+                for (size_t i = next++; i < jobs.size(); i = next++) {
+                    try {
+                        jobs[i].build();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(errorMutex);
+                        if (!firstError) {
+                            firstError = std::current_exception();
+                            failedName = jobs[i].name;
+                        }
+                    }
+                }
+                tlsWorkerCache = VK_NULL_HANDLE;
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    }
+
+    std::vector<VkPipelineCache> created;
+    for (VkPipelineCache cache : caches) if (cache != VK_NULL_HANDLE) created.push_back(cache);
+    if (mainCache != VK_NULL_HANDLE && !created.empty()) {
+        if (vkMergePipelineCaches(device, mainCache, static_cast<uint32_t>(created.size()), created.data()) != VK_SUCCESS)
+            std::cerr << "[PipelineRegistry] Warning: vkMergePipelineCaches failed" << std::endl;
+    }
+    for (VkPipelineCache cache : created) vkDestroyPipelineCache(device, cache, nullptr);
+
+    lastBatchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    printf("[PipelineRegistry] Compiled %zu pipeline groups on %u threads in %.1f ms (%s cache)\n",
+           jobs.size(), threads, lastBatchMs, warmCache ? "warm" : "cold");
+
+    if (firstError) {
+        fprintf(stderr, "[PipelineRegistry] Pipeline group '%s' failed\n", failedName.c_str());
+        std::rethrow_exception(firstError);
+    }
+}
+
+// ---------- VK_KHR_pipeline_binary ----------
+
+void PipelineRegistry::enableBinaries(VkDevice device) {
+    fnGetPipelineKey = reinterpret_cast<PFN_vkGetPipelineKeyKHR>(vkGetDeviceProcAddr(device, "vkGetPipelineKeyKHR"));
+    fnCreatePipelineBinaries = reinterpret_cast<PFN_vkCreatePipelineBinariesKHR>(vkGetDeviceProcAddr(device, "vkCreatePipelineBinariesKHR"));
+    fnDestroyPipelineBinary = reinterpret_cast<PFN_vkDestroyPipelineBinaryKHR>(vkGetDeviceProcAddr(device, "vkDestroyPipelineBinaryKHR"));
+    fnGetPipelineBinaryData = reinterpret_cast<PFN_vkGetPipelineBinaryDataKHR>(vkGetDeviceProcAddr(device, "vkGetPipelineBinaryDataKHR"));
+    fnReleaseCapturedPipelineData = reinterpret_cast<PFN_vkReleaseCapturedPipelineDataKHR>(vkGetDeviceProcAddr(device, "vkReleaseCapturedPipelineDataKHR"));
+    if (!fnGetPipelineKey || !fnCreatePipelineBinaries || !fnDestroyPipelineBinary ||
+        !fnGetPipelineBinaryData || !fnReleaseCapturedPipelineData) {
+        std::cerr << "[PipelineRegistry] VK_KHR_pipeline_binary entry points missing, using the pipeline cache only" << std::endl;
+        binaries = false;
+        return;
+    }
+
+    // The global key changes whenever the driver's binary compatibility does:
+    // it names the directory the per-pipeline binaries live in.
+    VkPipelineBinaryKeyKHR globalKey{};
+    globalKey.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_KEY_KHR;
+    if (fnGetPipelineKey(device, nullptr, &globalKey) != VK_SUCCESS) {
+        binaries = false;
+        return;
+    }
+    const uint64_t h = TextureCooker::hashBytes(globalKey.key, globalKey.keySize);
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+    binaryDirectory = cacheDirectory + "/binaries/" + hex;
+    binaries = true;
+    printf("[PipelineRegistry] Using pipeline binaries in %s\n", binaryDirectory.c_str());
+}
+
+std::string PipelineRegistry::binaryPath(const VkPipelineBinaryKeyKHR& key) const {
+    return binaryDirectory + "/" + toHex(key.key, std::min<uint32_t>(key.keySize, VK_MAX_PIPELINE_BINARY_KEY_SIZE_KHR)) + ".bin";
+}
+
+VkResult PipelineRegistry::createGraphicsPipeline(VkDevice device, VkPipelineCache cache,
+                                                  const VkGraphicsPipelineCreateInfo& info, VkPipeline* pipeline) {
+    if (!binaries) return vkCreateGraphicsPipelines(device, cache, 1, &info, nullptr, pipeline);
+
+    VkPipelineCreateInfoKHR keyInfo{};
+    keyInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATE_INFO_KHR;
+    keyInfo.pNext = &info;
+    VkPipelineBinaryKeyKHR key{};
+    key.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_KEY_KHR;
+    if (fnGetPipelineKey(device, &keyInfo, &key) != VK_SUCCESS)
+        return vkCreateGraphicsPipelines(device, cache, 1, &info, nullptr, pipeline);
+
+    const std::string path = binaryPath(key);
+    if (createFromBinaries(device, path, info, pipeline)) {
+        std::lock_guard<std::mutex> lock(binaryMutex);
+        ++binaryHits;
+        return VK_SUCCESS;
+    }
+
+    // Miss: compile with data capture, then store the binaries for next run.
+    // With a flags2 struct chained, VkGraphicsPipelineCreateInfo::flags is ignored.
+    VkPipelineCreateFlags2CreateInfoKHR flags2{};
+    flags2.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATE_FLAGS_2_CREATE_INFO_KHR;
+    flags2.pNext = info.pNext;
+    flags2.flags = static_cast<VkPipelineCreateFlags2KHR>(info.flags) | VK_PIPELINE_CREATE_2_CAPTURE_DATA_BIT_KHR;
+    VkGraphicsPipelineCreateInfo captureInfo = info;
+    captureInfo.pNext = &flags2;
+    const VkResult res = vkCreateGraphicsPipelines(device, cache, 1, &captureInfo, nullptr, pipeline);
+    if (res != VK_SUCCESS) return res;
+    storeBinaries(device, path, *pipeline);
+    return VK_SUCCESS;
+}
+
+bool PipelineRegistry::createFromBinaries(VkDevice device, const std::string& path,
+                                          const VkGraphicsPipelineCreateInfo& info, VkPipeline* pipeline) {
+    std::vector<char> file;
+    if (!readFile(path, file)) return false;
+
+    // File: magic, version, count, then per binary: key size, key bytes
+    // (VK_MAX_PIPELINE_BINARY_KEY_SIZE_KHR), data size (u64), data.
+    size_t off = 0;
+    auto take = [&](void* dst, size_t n) {
+        if (off + n > file.size()) return false;
+        std::memcpy(dst, file.data() + off, n);
+        off += n;
+        return true;
+    };
+    char magic[4];
+    uint32_t version = 0, count = 0;
+    if (!take(magic, sizeof(magic)) || std::memcmp(magic, PIPELINE_BINARY_MAGIC, sizeof(magic)) != 0 ||
+        !take(&version, sizeof(version)) || version != PIPELINE_BINARY_VERSION ||
+        !take(&count, sizeof(count)) || count == 0) {
+        return false;
+    }
+
+    std::vector<VkPipelineBinaryKeyKHR> keys(count);
+    std::vector<VkPipelineBinaryDataKHR> datas(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        keys[i].sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_KEY_KHR;
+        uint64_t size = 0;
+        if (!take(&keys[i].keySize, sizeof(keys[i].keySize)) || keys[i].keySize > VK_MAX_PIPELINE_BINARY_KEY_SIZE_KHR ||
+            !take(keys[i].key, VK_MAX_PIPELINE_BINARY_KEY_SIZE_KHR) || !take(&size, sizeof(size)) ||
+            off + size > file.size()) {
+            return false;
+        }
+        datas[i].dataSize = static_cast<size_t>(size);
+        datas[i].pData = file.data() + off;
+        off += static_cast<size_t>(size);
+    }
+
+    VkPipelineBinaryKeysAndDataKHR keysAndData{};
+    keysAndData.binaryCount = count;
+    keysAndData.pPipelineBinaryKeys = keys.data();
+    keysAndData.pPipelineBinaryData = datas.data();
+    VkPipelineBinaryCreateInfoKHR createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_CREATE_INFO_KHR;
+    createInfo.pKeysAndDataInfo = &keysAndData;
+
+    std::vector<VkPipelineBinaryKHR> handles(count, VK_NULL_HANDLE);
+    VkPipelineBinaryHandlesInfoKHR handlesInfo{};
+    handlesInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_HANDLES_INFO_KHR;
+    handlesInfo.pipelineBinaryCount = count;
+    handlesInfo.pPipelineBinaries = handles.data();
+
+    bool ok = fnCreatePipelineBinaries(device, &createInfo, nullptr, &handlesInfo) == VK_SUCCESS;
+    if (ok) {
+        VkPipelineBinaryInfoKHR binaryInfo{};
+        binaryInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_INFO_KHR;
+        binaryInfo.pNext = info.pNext;
+        binaryInfo.binaryCount = count;
+        binaryInfo.pPipelineBinaries = handles.data();
+        VkGraphicsPipelineCreateInfo binInfo = info;
+        binInfo.pNext = &binaryInfo;
+        // The pipeline cache is ignored when binaries are supplied
+        ok = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &binInfo, nullptr, pipeline) == VK_SUCCESS;
+    }
+    for (VkPipelineBinaryKHR handle : handles) {
+        if (handle != VK_NULL_HANDLE) fnDestroyPipelineBinary(device, handle, nullptr);
+    }
+    if (!ok) fprintf(stderr, "[PipelineRegistry] Stale pipeline binary %s, recompiling\n", path.c_str());
+    return ok;
+}
+
+void PipelineRegistry::storeBinaries(VkDevice device, const std::string& path, VkPipeline pipeline) {
+    VkPipelineBinaryCreateInfoKHR createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_CREATE_INFO_KHR;
+    createInfo.pipeline = pipeline;
+    VkPipelineBinaryHandlesInfoKHR handlesInfo{};
+    handlesInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_HANDLES_INFO_KHR;
+
+    std::vector<char> file;
+    auto put = [&](const void* src, size_t n) {
+        const char* p = static_cast<const char*>(src);
+        file.insert(file.end(), p, p + n);
+    };
+
+    std::vector<VkPipelineBinaryKHR> handles;
+    if (fnCreatePipelineBinaries(device, &createInfo, nullptr, &handlesInfo) == VK_SUCCESS &&
+        handlesInfo.pipelineBinaryCount > 0) {
+        handles.assign(handlesInfo.pipelineBinaryCount, VK_NULL_HANDLE);
+        handlesInfo.pPipelineBinaries = handles.data();
+        if (fnCreatePipelineBinaries(device, &createInfo, nullptr, &handlesInfo) != VK_SUCCESS) handles.clear();
+    }
+
+    bool ok = !handles.empty();
+    if (ok) {
+        const uint32_t count = static_cast<uint32_t>(handles.size());
+        put(PIPELINE_BINARY_MAGIC, sizeof(PIPELINE_BINARY_MAGIC));
+        put(&PIPELINE_BINARY_VERSION, sizeof(PIPELINE_BINARY_VERSION));
+        put(&count, sizeof(count));
+        std::vector<char> data;
+        for (VkPipelineBinaryKHR handle : handles) {
+            VkPipelineBinaryDataInfoKHR dataInfo{};
+            dataInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_DATA_INFO_KHR;
+            dataInfo.pipelineBinary = handle;
+            VkPipelineBinaryKeyKHR key{};
+            key.sType = VK_STRUCTURE_TYPE_PIPELINE_BINARY_KEY_KHR;
+            size_t size = 0;
+            if (fnGetPipelineBinaryData(device, &dataInfo, &key, &size, nullptr) != VK_SUCCESS) { ok = false; break; }
+            data.resize(size);
+            if (fnGetPipelineBinaryData(device, &dataInfo, &key, &size, data.data()) != VK_SUCCESS) { ok = false; break; }
+            const uint64_t size64 = size;
+            put(&key.keySize, sizeof(key.keySize));
+            put(key.key, VK_MAX_PIPELINE_BINARY_KEY_SIZE_KHR);
+            put(&size64, sizeof(size64));
+            put(data.data(), size);
+        }
+    }
+    for (VkPipelineBinaryKHR handle : handles) {
+        if (handle != VK_NULL_HANDLE) fnDestroyPipelineBinary(device, handle, nullptr);
+    }
+
+    // The capture data is only needed to create the binaries above
+    VkReleaseCapturedPipelineDataInfoKHR releaseInfo{};
+    releaseInfo.sType = VK_STRUCTURE_TYPE_RELEASE_CAPTURED_PIPELINE_DATA_INFO_KHR;
+    releaseInfo.pipeline = pipeline;
+    fnReleaseCapturedPipelineData(device, &releaseInfo, nullptr);
+
+    if (!ok) return;
+    std::lock_guard<std::mutex> lock(binaryMutex);
+    try {
+        ensureFolderExists(binaryDirectory);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[PipelineRegistry] %s: %s\n", binaryDirectory.c_str(), e.what());
+        return;
+    }
+    writeFileAtomic(path, file.data(), file.size());
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Startup pipeline compilation and persistent caching.
+//
+//  - Renderers declare pipeline builders between beginBatch() and
+//    compileBatch(); the batch runs them on worker threads, each with its own
+//    VkPipelineCache (seeded from the main cache), and merges the per-thread
+//    caches back with vkMergePipelineCaches. Outside a batch, declare() runs
+//    the builder immediately, so resize/recreate paths stay synchronous.
+//    Builders must only create pipelines (no descriptor allocation, no queue
+//    submission); VulkanApp::getPipelineCache() returns the worker's cache.
+//  - The VkPipelineCache is stored content-addressed under cache/pipelines/,
+//    keyed by the driver identity (vendor, device, driver version, cache
+//    UUID) and a hash of every SPIR-V module in shaders/, so a driver update
+//    or shader rebuild never feeds the driver a stale blob.
+//  - When VK_KHR_pipeline_binary is usable, createGraphicsPipeline() stores
+//    and reloads per-pipeline binaries keyed by vkGetPipelineKeyKHR.
+class PipelineRegistry {
+public:
+    using Builder = std::function<void()>;
+
+    static std::string cacheDirectory;
+
+    // --- Persistent cache ---
+    VkPipelineCache createCache(VkDevice device, VkPhysicalDevice physicalDevice,
+                                const std::string& shaderDir = "shaders");
+    void saveCache(VkDevice device, VkPipelineCache cache) const;
+    bool cacheWasWarm() const { return warmCache; }
+    const std::string& getCachePath() const { return cachePath; }
+
+    // --- Parallel startup compilation ---
+    void beginBatch();
+    void declare(const std::string& name, Builder build);
+    // Runs every declared builder; rethrows the first builder exception after
+    // all workers have joined. threads = 0 picks hardware_concurrency.
+    void compileBatch(VkDevice device, VkPipelineCache mainCache, uint32_t threads = 0);
+    // Drops the declared builders without running them and leaves batch mode.
+    void abortBatch();
+    bool isBatching() const { return batching; }
+
+    // Opens a batch for its lifetime. If the owner unwinds before calling
+    // compileBatch(), the batch is aborted so later declare() calls run
+    // immediately again instead of queueing behind a batch nobody compiles.
+    class BatchScope {
+    public:
+        explicit BatchScope(PipelineRegistry& registry) : registry(registry) { registry.beginBatch(); }
+        ~BatchScope() { if (registry.isBatching()) registry.abortBatch(); }
+        BatchScope(const BatchScope&) = delete;
+        BatchScope& operator=(const BatchScope&) = delete;
+    private:
+        PipelineRegistry& registry;
+    };
+
+    // Per-thread cache of the compileBatch worker running on this thread
+    // (VK_NULL_HANDLE on any other thread).
+    static VkPipelineCache threadCache();
+
+    // --- VK_KHR_pipeline_binary ---
+    // Loads the extension entry points; call once after device creation when
+    // the pipelineBinaries feature was enabled.
+    void enableBinaries(VkDevice device);
+    bool binariesEnabled() const { return binaries; }
+    // vkCreateGraphicsPipelines, going through stored pipeline binaries when
+    // they are enabled (capturing and storing them on a miss).
+    VkResult createGraphicsPipeline(VkDevice device, VkPipelineCache cache,
+                                    const VkGraphicsPipelineCreateInfo& info, VkPipeline* pipeline);
+
+    // Stats of the last compileBatch (startup timing)
+    double getLastBatchMs() const { return lastBatchMs; }
+    size_t getLastBatchCount() const { return lastBatchCount; }
+    uint32_t getBinaryHits() const { return binaryHits; }
+
+private:
+    struct Pending {
+        std::string name;
+        Builder build;
+    };
+
+    std::string binaryPath(const VkPipelineBinaryKeyKHR& key) const;
+    bool createFromBinaries(VkDevice device, const std::string& path,
+                            const VkGraphicsPipelineCreateInfo& info, VkPipeline* pipeline);
+    void storeBinaries(VkDevice device, const std::string& path, VkPipeline pipeline);
+
+    std::vector<Pending> pending;
+    bool batching = false;
+
+    std::string cachePath;
+    bool warmCache = false;
+    double lastBatchMs = 0.0;
+    size_t lastBatchCount = 0;
+
+    bool binaries = false;
+    std::string binaryDirectory;
+    uint32_t binaryHits = 0;
+    std::mutex binaryMutex; // guards binaryHits and file writes
+    PFN_vkGetPipelineKeyKHR fnGetPipelineKey = nullptr;
+    PFN_vkCreatePipelineBinariesKHR fnCreatePipelineBinaries = nullptr;
+    PFN_vkDestroyPipelineBinaryKHR fnDestroyPipelineBinary = nullptr;
+    PFN_vkGetPipelineBinaryDataKHR fnGetPipelineBinaryData = nullptr;
+    PFN_vkReleaseCapturedPipelineDataKHR fnReleaseCapturedPipelineData = nullptr;
+};
@@ -2,6 +2,7 @@
 #include "../widgets/SkySettings.hpp"
 #include "ubo/SkyUniform.hpp"
 #include <glm/glm.hpp>
+#include <cstring>
 
 SkySphere::SkySphere() {}
 
@@ -33,6 +34,8 @@ void SkySphere::init(VulkanApp* app, SkySettings& settings,
         data.nightParams = glm::vec4(skySettings->nightIntensity, skySettings->starIntensity, 0.0f, 0.0f);
     }
     memcpy(skyBuffer.mappedData, &data, static_cast<size_t>(sbSize));
+    lastData = data;
+    ++contentVersion;
 
     // bind into descriptor sets (binding 6)
     VkDescriptorBufferInfo skyBufInfo{ skyBuffer.buffer, 0, sbSize };
@@ -63,6 +66,11 @@ void SkySphere::update(VulkanApp* app) {
     } else {
         memset(&skyData, 0, sizeof(skyData));
     }
+    // Settings rarely change: skip the upload (and keep the version) when
+    // the data is identical to what the buffer already holds.
+    if (memcmp(&skyData, &lastData, sizeof(SkyUniform)) == 0) return;
+    lastData = skyData;
+    ++contentVersion;
     memcpy(skyBuffer.mappedData, &skyData, static_cast<size_t>(skyBufferSize));
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanApp.hpp"
+#include "ubo/SkyUniform.hpp"
 #include <vector>
 #include <memory>
 
@@ -24,6 +25,10 @@ public:
     // Access the sky uniform buffer for binding to descriptor sets
     Buffer getBuffer() const { return skyBuffer; }
 
+    // Bumped whenever update() uploads different sky data, so cached sky
+    // renders (e.g. the offscreen equirect) know when they are stale.
+    uint64_t getContentVersion() const { return contentVersion; }
+
     // Destroy GPU resources
     void cleanup();
 
@@ -31,5 +36,7 @@ private:
     Buffer skyBuffer{};
     VkDeviceSize skyBufferSize = 0;
     SkySettings* skySettings = nullptr;
+    SkyUniform lastData{};
+    uint64_t contentVersion = 0;
     // Note: no stored VulkanApp*; callers must pass VulkanApp* to init/update as needed
 };
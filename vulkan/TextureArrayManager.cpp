@@ -6,8 +6,26 @@
 #include <backends/imgui_impl_vulkan.h>
 #include "../vulkan/EditableTexture.hpp"
 #include <cmath>
-#include <stb/stb_image.h>
-// <tuple> no longer required (using TextureTriple)
+#include "../utils/TextureCooker.hpp"
+#include "../space/ThreadPool.hpp"
+#include <atomic>
+#include <algorithm>
+
+// Views of a block-compressed array only sample it: the storage usage the
+// array is created with belongs to its uint block views.
+static const VkImageViewUsageCreateInfo SAMPLED_VIEW_USAGE = { VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO, nullptr, VK_IMAGE_USAGE_SAMPLED_BIT };
+
+// Push constants for texture_encode.comp; must match the shader layout
+struct EncodePushConstants {
+	uint32_t mode;   // 0 = BC4, 1 = BC5, 2 = BC7
+	uint32_t srgb;
+	uint32_t level;
+};
+
+// Uint format whose texels are the blocks of a BC format
+static VkFormat blockViewFormat(VkFormat format) {
+	return format == VK_FORMAT_BC4_UNORM_BLOCK ? VK_FORMAT_R32G32_UINT : VK_FORMAT_R32G32B32A32_UINT;
+}
 
 // Convert in-place 8-bit RGBA sRGB values to linear (also 8-bit)
 void convertSRGB8ToLinearInPlace(unsigned char* data, size_t pixelCount) {
@@ -26,18 +44,19 @@ void convertSRGB8ToLinearInPlace(unsigned char* data, size_t pixelCount) {
 }
 
 
-void TextureArrayManager::notifyAllocationListeners() {
-	std::vector<std::function<void()>> listenersCopy;
-	listenersCopy.reserve(allocationListeners.size());
-	for (auto &l : allocationListeners) if (l) listenersCopy.push_back(l);
-	for (size_t i = 0; i < listenersCopy.size(); ++i) {
-		try {
-			listenersCopy[i]();
-		} catch (const std::exception &e) {
-			std::cerr << "[TextureArrayManager] allocation listener " << i << " threw std::exception: " << e.what() << std::endl;
-		} catch (...) {
-			std::cerr << "[TextureArrayManager] allocation listener " << i << " threw unknown exception" << std::endl;
-		}
+TextureArrayManager::~TextureArrayManager() = default;
+
+uint32_t TextureArrayManager::getHeapSlot(int map) const {
+	if (map < 0 || map >= 5) return BindlessHeap::INVALID_INDEX;
+	return heapSlots[map];
+}
+
+// Frames already recorded keep sampling the old slots; the heap only reuses
+// them once those frames have retired.
+void TextureArrayManager::releaseHeapSlots(VulkanApp* app) {
+	for (uint32_t &slot : heapSlots) {
+		if (app) app->getBindlessHeap().releaseImage(slot);
+		slot = BindlessHeap::INVALID_INDEX;
 	}
 }
 
@@ -85,6 +104,12 @@ static void cleanupSampler(VulkanApp* app, VkSampler &s) {
 
 void TextureArrayManager::destroy(VulkanApp* app) {
 	if (!app) return;
+	// Queued/in-flight layer writes reference the arrays being destroyed
+	uploadQueue.flush();
+	uploadQueue.destroy();
+	cookPool.reset();
+	releaseHeapSlots(app);
+	destroyEncodeResources(app);
 	cleanupTextureImage(app, albedoArray);
 	cleanupTextureImage(app, normalArray);
 	cleanupTextureImage(app, bumpArray);
@@ -177,8 +202,6 @@ void TextureArrayManager::destroy(VulkanApp* app) {
 	this->appPtr = nullptr;
 	// bump version to indicate array resources were destroyed
 	++this->version;
-	// notify listeners that arrays were destroyed
-	notifyAllocationListeners();
 }
 
 void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, VulkanApp* app) {
@@ -191,7 +214,13 @@ void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, Vulk
 	width = w;
 	height = h;
 
+	// Drain layer writes that target the previous arrays before replacing them
+	uploadQueue.flush();
+	uploadQueue.init(app);
+
 	// destroy previous resources if present
+	releaseHeapSlots(app);
+	destroyEncodeResources(app);
 	cleanupTextureImage(app, albedoArray);
 	cleanupTextureImage(app, normalArray);
 	cleanupTextureImage(app, bumpArray);
@@ -201,7 +230,23 @@ void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, Vulk
 	// Compute mip level count and create 2D array image
 	uint32_t mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
 
+	// Block-compressed storage when the device samples the BC format and can
+	// write its blocks through a uint view (texture_encode.comp); else RGBA8.
+	auto pickFormat = [&](int map) {
+		if (!app->blockCompressionSupported) return VK_FORMAT_R8G8B8A8_UNORM;
+		VkFormat format = static_cast<VkFormat>(TextureCooker::blockFormatFor(map == 0, map == 1));
+		VkFormatProperties props{}, viewProps{};
+		vkGetPhysicalDeviceFormatProperties(app->getPhysicalDevice(), format, &props);
+		vkGetPhysicalDeviceFormatProperties(app->getPhysicalDevice(), blockViewFormat(format), &viewProps);
+		const VkFormatFeatureFlags needed = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+		if ((props.optimalTilingFeatures & needed) != needed || !(viewProps.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT)) {
+			return VK_FORMAT_R8G8B8A8_UNORM;
+		}
+		return format;
+	};
+
 	auto createArray = [&](TextureImage &out, VkFormat format, bool srgb){
+		const bool compressed = format != VK_FORMAT_R8G8B8A8_UNORM;
 		VkImageCreateInfo imageInfo{};
 		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -216,6 +261,10 @@ void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, Vulk
 		imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
 		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		if (compressed) {
+			// Storage writes go through per-(layer, mip) uint views of the blocks
+			imageInfo.flags = VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_BLOCK_TEXEL_VIEW_COMPATIBLE_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT;
+		}
 
 		VkDevice device = app->getDevice();
 
@@ -226,6 +275,7 @@ void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, Vulk
 		// Create image view for 2D array
 		VkImageViewCreateInfo viewInfo{};
 		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.pNext = compressed ? &SAMPLED_VIEW_USAGE : nullptr;
 		viewInfo.image = out.image;
 		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
 		viewInfo.format = format;
@@ -251,13 +301,57 @@ void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, Vulk
 		app->transitionImageLayout(out.image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels, layerAmount);
 	};
 
-	// Albedo: use UNORM format (no automatic sRGB->linear conversion)
-	createArray(albedoArray, VK_FORMAT_R8G8B8A8_UNORM, true);
-	// Normal and bump maps use UNORM
-	createArray(normalArray, VK_FORMAT_R8G8B8A8_UNORM, false);
-	createArray(bumpArray, VK_FORMAT_R8G8B8A8_UNORM, false);
-	createArray(roughnessArray, VK_FORMAT_R8G8B8A8_UNORM, false);
-	createArray(aoArray, VK_FORMAT_R8G8B8A8_UNORM, false);
+	// Albedo: RGBA8 holds linear values (no automatic sRGB->linear conversion);
+	// BC7 stores sRGB and the sampler decodes it, so shaders see linear either way.
+	for (int m = 0; m < 5; ++m) mapFormats[m] = pickFormat(m);
+	createArray(albedoArray, mapFormats[0], true);
+	createArray(normalArray, mapFormats[1], false);
+	createArray(bumpArray, mapFormats[2], false);
+	createArray(roughnessArray, mapFormats[3], false);
+	createArray(aoArray, mapFormats[4], false);
+
+	// One RGBA8 work image per compressed map for GPU-written layers
+	bool anyCompressed = false;
+	for (int m = 0; m < 5; ++m) {
+		if (!isMapCompressed(m)) continue;
+		anyCompressed = true;
+		TextureImage &work = workImages[m];
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.extent = { width, height, 1 };
+		imageInfo.mipLevels = mipLevels;
+		imageInfo.arrayLayers = 1;
+		imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		app->createImageWithVma(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, work.image, work.allocation, work.memory, "TextureArrayManager: workImage");
+
+		// Arrayed so they bind where the mixer (image2DArray) and the encoder
+		// (sampler2DArray) expect an array
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = work.image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+		viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		if (vkCreateImageView(app->getDevice(), &viewInfo, nullptr, &work.view) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create texture work image view");
+		}
+		app->resources.addImageView(work.view, "TextureArrayManager: workImage view");
+		viewInfo.subresourceRange.levelCount = mipLevels;
+		if (vkCreateImageView(app->getDevice(), &viewInfo, nullptr, &workSampleViews[m]) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create texture work image view");
+		}
+		app->resources.addImageView(workSampleViews[m], "TextureArrayManager: workImage sample view");
+		work.mipLevels = mipLevels;
+		// Layout is set per job by recordPrepareWorkImage()
+		blockViews[m].assign(static_cast<size_t>(layerAmount) * mipLevels, VK_NULL_HANDLE);
+		encodeSets[m].assign(static_cast<size_t>(layerAmount) * mipLevels, VK_NULL_HANDLE);
+	}
 
 	// cleanup existing samplers and create new ones
 	cleanupSampler(app, albedoSampler);
@@ -271,6 +365,14 @@ void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, Vulk
 	bumpSampler = app->createTextureSampler(mipLevels);
 	roughnessSampler = app->createTextureSampler(mipLevels);
 	aoSampler = app->createTextureSampler(mipLevels);
+	if (anyCompressed) createEncodePipeline(app);
+
+	BindlessHeap &heap = app->getBindlessHeap();
+	heapSlots[0] = heap.registerImage(albedoArray.view, albedoSampler);
+	heapSlots[1] = heap.registerImage(normalArray.view, normalSampler);
+	heapSlots[2] = heap.registerImage(bumpArray.view, bumpSampler);
+	heapSlots[3] = heap.registerImage(roughnessArray.view, roughnessSampler);
+	heapSlots[4] = heap.registerImage(aoArray.view, aoSampler);
 	// Do NOT store `app` in this manager; callers pass `app` explicitly to GPU operations
 	(void)app; // keep parameter used, but don't retain pointer
 	// initialize layer initialized flags
@@ -295,123 +397,155 @@ void TextureArrayManager::allocate(uint32_t layers, uint32_t w, uint32_t h, Vulk
 
 	// bump version so users can detect reallocation of GPU resources
 	++this->version;
-	// notify listeners that arrays changed
-	notifyAllocationListeners();
 }
 
-// Nearest-neighbor resize (RGBA8)
-static unsigned char* resizeNearest(const unsigned char* src, int srcW, int srcH, int dstW, int dstH) {
-	unsigned char* dst = new unsigned char[static_cast<size_t>(dstW) * dstH * 4];
-	for (int y = 0; y < dstH; ++y) {
-		int sy = (y * srcH) / dstH;
-		for (int x = 0; x < dstW; ++x) {
-			int sx = (x * srcW) / dstW;
-			const unsigned char* s = &src[(sy * srcW + sx) * 4];
-			unsigned char* d = &dst[(y * dstW + x) * 4];
-			d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = s[3];
-		}
-	}
-	return dst;
-}
+// Staging budget for one batched upload in loadTriples(). A 1024^2 layer with
+// a full mip chain is ~28 MB across the five maps in RGBA8 (~5 MB block
+// compressed), so this covers ~9 (~54) layers per submit while keeping peak
+// host-visible memory bounded.
+static constexpr VkDeviceSize COOKED_UPLOAD_BATCH_BYTES = 256ull * 1024ull * 1024ull;
 
-uint TextureArrayManager::load(VulkanApp* a, const char* albedoFile, const char* normalFile, const char* bumpFile, const char* roughnessFile, const char* aoFile) {
-	if (!a) throw std::runtime_error("TextureArrayManager::load: app is null");
-	if (layerAmount == 0) throw std::runtime_error("TextureArrayManager::load: layerAmount == 0");
-	if (currentLayer >= layerAmount) throw std::runtime_error("TextureArrayManager::load: currentLayer >= layerAmount");
+// Staging slot of one map of one triple: block-aligned so every mip offset is
+// a valid BC copy offset.
+static VkDeviceSize cookedMapBytes(uint32_t w, uint32_t h, uint32_t mipLevels, VkFormat format) {
+	return (TextureCooker::mipChainSize(w, h, mipLevels, static_cast<uint32_t>(format)) + 15) & ~VkDeviceSize(15);
+}
 
-	struct Img { const char* path; TextureImage* dstImage; VkFormat format; bool srgb; unsigned char defaultVal[4]; } imgs[5] = {
-		{ albedoFile, &albedoArray, VK_FORMAT_R8G8B8A8_UNORM, true, {0,0,0,255} },
-		{ normalFile, &normalArray, VK_FORMAT_R8G8B8A8_UNORM, false, {128,128,255,255} },
-		{ bumpFile,   &bumpArray,   VK_FORMAT_R8G8B8A8_UNORM, false, {128,128,128,255} },
-		{ roughnessFile, &roughnessArray, VK_FORMAT_R8G8B8A8_UNORM, false, {128,128,128,255} },
-		{ aoFile,     &aoArray,     VK_FORMAT_R8G8B8A8_UNORM, false, {255,255,255,255} }
+size_t TextureArrayManager::uploadCookedBatch(VulkanApp* a, const TextureTriple* triples, size_t count) {
+	if (count == 0) return 0;
+	TextureImage* arrays[5] = { &albedoArray, &normalArray, &bumpArray, &roughnessArray, &aoArray };
+	static const unsigned char defaults[5][4] = {
+		{0,0,0,255}, {128,128,255,255}, {128,128,128,255}, {128,128,128,255}, {255,255,255,255}
 	};
 
-	auto uploadLayer = [&](int idx, unsigned char* pixelData, VkDeviceSize imageSize) {
-		Buffer staging = a->createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-		memcpy(staging.mappedData, pixelData, static_cast<size_t>(imageSize));
-
-		a->runSingleTimeCommandsOnTransfer([&](VkCommandBuffer cmd) {
-			a->recordTransitionImageLayoutLayer(cmd, imgs[idx].dstImage->image, imgs[idx].format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, imgs[idx].dstImage->mipLevels, currentLayer, 1);
-			VkBufferImageCopy region{};
-			region.bufferOffset = 0;
-			region.bufferRowLength = 0;
-			region.bufferImageHeight = 0;
-			region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			region.imageSubresource.mipLevel = 0;
-			region.imageSubresource.baseArrayLayer = currentLayer;
-			region.imageSubresource.layerCount = 1;
-			region.imageOffset = {0,0,0};
-			region.imageExtent = { width, height, 1 };
-			vkCmdCopyBufferToImage(cmd, staging.buffer, imgs[idx].dstImage->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-		});
-
-		if (imgs[idx].dstImage->mipLevels > 1) {
-			a->generateMipmaps(imgs[idx].dstImage->image, imgs[idx].format, static_cast<int32_t>(width), static_cast<int32_t>(height), imgs[idx].dstImage->mipLevels, 1, currentLayer);
-			setLayerLayout(idx, currentLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		} else {
-			a->runSingleTimeCommandsOnTransfer([&](VkCommandBuffer cmd2) {
-				a->recordTransitionImageLayoutLayer(cmd2, imgs[idx].dstImage->image, imgs[idx].format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, imgs[idx].dstImage->mipLevels, currentLayer, 1);
-			});
-			setLayerLayout(idx, currentLayer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		}
-		a->destroyBuffer(staging);
-	};
+	const uint32_t mipLevels = albedoArray.mipLevels;
+	VkDeviceSize mapOffsets[5];
+	VkDeviceSize tripleBytes = 0;
+	for (int m = 0; m < 5; ++m) {
+		mapOffsets[m] = tripleBytes;
+		tripleBytes += cookedMapBytes(width, height, mipLevels, mapFormats[m]);
+	}
 
-	for (int i = 0; i < 5; ++i) {
-		if (!imgs[i].path) {
-			VkDeviceSize imageSize = static_cast<VkDeviceSize>(width) * height * 4;
-			unsigned char* defaultData = new unsigned char[static_cast<size_t>(imageSize)];
-			for (size_t p = 0; p < static_cast<size_t>(width) * height; ++p) {
-				memcpy(defaultData + p * 4, imgs[i].defaultVal, 4);
+	// Every (triple, map) pair owns a fixed slot in the staging buffer so the
+	// workers can write straight into mapped memory without coordination.
+	Buffer staging = a->createBuffer(tripleBytes * count, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false);
+	unsigned char* mapped = static_cast<unsigned char*>(staging.mappedData);
+
+	std::vector<char> mapOk(count * 5, 1);
+	std::atomic<uint32_t> cacheHits{0};
+	{
+		if (!cookPool) cookPool = std::make_unique<ThreadPool>(std::max(1u, std::thread::hardware_concurrency()));
+		ThreadPool &pool = *cookPool;
+		std::vector<std::future<void>> futures;
+		futures.reserve(count * 5);
+		for (size_t t = 0; t < count; ++t) {
+			const char* paths[5] = { triples[t].albedo, triples[t].normal, triples[t].bump, triples[t].roughness, triples[t].ao };
+			for (int m = 0; m < 5; ++m) {
+				futures.push_back(pool.enqueue([&, t, m, path = paths[m]]() {
+					TextureCookParams params;
+					params.width = width;
+					params.height = height;
+					params.mipLevels = mipLevels;
+					params.srgb = (m == 0);
+					params.normalMap = (m == 1);
+					params.format = static_cast<uint32_t>(mapFormats[m]);
+					memcpy(params.defaultVal, defaults[m], 4);
+					CookedTexture cooked;
+					bool hit = false;
+					if (!TextureCooker::cook(path, params, cooked, &hit)) {
+						std::cerr << "[TextureArrayManager] Failed to load texture: " << path << std::endl;
+						mapOk[t * 5 + m] = 0;
+						return;
+					}
+					if (hit) cacheHits.fetch_add(1, std::memory_order_relaxed);
+					memcpy(mapped + t * tripleBytes + mapOffsets[m], cooked.data.data(), cooked.data.size());
+				}));
 			}
-			uploadLayer(i, defaultData, imageSize);
-			delete[] defaultData;
-			continue;
-		}
-		int texW=0, texH=0, texC=0;
-		unsigned char* pixels = stbi_load(imgs[i].path, &texW, &texH, &texC, 4);
-		if (!pixels) {
-			throw std::runtime_error(std::string("failed to load texture: ") + imgs[i].path);
 		}
+		for (auto &f : futures) f.get();
+	}
 
-		unsigned char* uploadData = pixels;
-		bool resized = false;
-		if (texW != static_cast<int>(width) || texH != static_cast<int>(height)) {
-			unsigned char* r = resizeNearest(pixels, texW, texH, static_cast<int>(width), static_cast<int>(height));
-			uploadData = r;
-			resized = true;
+	// Compact successful triples onto consecutive layers; failed slots are
+	// simply never referenced by a copy region.
+	const uint32_t firstLayer = currentLayer;
+	std::vector<std::pair<size_t, uint32_t>> placed;
+	for (size_t t = 0; t < count; ++t) {
+		bool ok = true;
+		for (int m = 0; m < 5; ++m) ok = ok && mapOk[t * 5 + m];
+		if (ok) placed.push_back({ t, firstLayer + static_cast<uint32_t>(placed.size()) });
+	}
+	if (placed.empty()) {
+		a->destroyBuffer(staging);
+		return 0;
+	}
+	const uint32_t layerCount = static_cast<uint32_t>(placed.size());
+
+	a->runSingleTimeCommandsOnTransfer([&](VkCommandBuffer cmd) {
+		std::vector<VkBufferImageCopy> regions;
+		regions.reserve(static_cast<size_t>(layerCount) * mipLevels);
+		for (int m = 0; m < 5; ++m) {
+			TextureImage* dst = arrays[m];
+			a->recordTransitionImageLayoutLayer(cmd, dst->image, mapFormats[m], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, firstLayer, layerCount);
+			regions.clear();
+			for (const auto &[t, layer] : placed) {
+				VkDeviceSize levelOffset = 0;
+				for (uint32_t l = 0; l < mipLevels; ++l) {
+					uint32_t lw = std::max(1u, width >> l);
+					uint32_t lh = std::max(1u, height >> l);
+					VkBufferImageCopy region{};
+					region.bufferOffset = t * tripleBytes + mapOffsets[m] + levelOffset;
+					region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+					region.imageSubresource.mipLevel = l;
+					region.imageSubresource.baseArrayLayer = layer;
+					region.imageSubresource.layerCount = 1;
+					region.imageExtent = { lw, lh, 1 };
+					regions.push_back(region);
+					levelOffset += TextureCooker::levelSize(lw, lh, static_cast<uint32_t>(mapFormats[m]));
+				}
+			}
+			vkCmdCopyBufferToImage(cmd, staging.buffer, dst->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+			a->recordTransitionImageLayoutLayer(cmd, dst->image, mapFormats[m], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels, firstLayer, layerCount);
 		}
+	});
+	a->destroyBuffer(staging);
 
-		if (imgs[i].srgb) {
-			convertSRGB8ToLinearInPlace(uploadData, static_cast<size_t>(width) * static_cast<size_t>(height));
-		}
+	for (const auto &entry : placed) {
+		for (int m = 0; m < 5; ++m) setLayerLayout(m, entry.second, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		setLayerInitialized(entry.second, true);
+	}
+	currentLayer += layerCount;
+	std::cerr << "[TextureArrayManager] Uploaded " << layerCount << " layers (" << cacheHits.load() << "/" << count * 5 << " maps from cook cache)" << std::endl;
+	return layerCount;
+}
 
-		uploadLayer(i, uploadData, static_cast<VkDeviceSize>(width) * height * 4);
+uint TextureArrayManager::load(VulkanApp* a, const char* albedoFile, const char* normalFile, const char* bumpFile, const char* roughnessFile, const char* aoFile) {
+	if (!a) throw std::runtime_error("TextureArrayManager::load: app is null");
+	if (layerAmount == 0) throw std::runtime_error("TextureArrayManager::load: layerAmount == 0");
+	if (currentLayer >= layerAmount) throw std::runtime_error("TextureArrayManager::load: currentLayer >= layerAmount");
 
-		if (resized) delete[] uploadData;
-		stbi_image_free(pixels);
+	TextureTriple triple{ albedoFile, normalFile, bumpFile, roughnessFile, aoFile };
+	uint32_t layer = currentLayer;
+	if (uploadCookedBatch(a, &triple, 1) == 0) {
+		throw std::runtime_error(std::string("failed to load texture: ") + (albedoFile ? albedoFile : "(null)"));
 	}
-
-	setLayerInitialized(currentLayer, true);
-	return currentLayer++;
+	return layer;
 }
 
 size_t TextureArrayManager::loadTriples(VulkanApp* a, const std::vector<TextureTriple> &triples) {
 	if (!a) throw std::runtime_error("TextureArrayManager::loadTriples: app is null");
 	if (layerAmount == 0) throw std::runtime_error("TextureArrayManager::loadTriples: layerAmount == 0");
+	size_t count = triples.size();
+	if (currentLayer + count > layerAmount) {
+		std::cerr << "[TextureArrayManager] Reached texture array capacity (" << layerAmount << " layers)" << std::endl;
+		count = layerAmount - currentLayer;
+	}
+
+	VkDeviceSize tripleBytes = 0;
+	for (int m = 0; m < 5; ++m) tripleBytes += cookedMapBytes(width, height, albedoArray.mipLevels, mapFormats[m]);
+	size_t perBatch = std::max<size_t>(1, static_cast<size_t>(COOKED_UPLOAD_BATCH_BYTES / std::max<VkDeviceSize>(1, tripleBytes)));
 	size_t loaded = 0;
-	for (const auto &t : triples) {
-		if (currentLayer >= layerAmount) {
-			std::cerr << "[TextureArrayManager] Reached texture array capacity (" << layerAmount << " layers)" << std::endl;
-			break;
-		}
-		try {
-			load(a, t.albedo, t.normal, t.bump, t.roughness, t.ao);
-			++loaded;
-		} catch (const std::exception &e) {
-			std::cerr << "[TextureArrayManager] Failed to load " << (t.albedo ? t.albedo : "(null)") << ": " << e.what() << std::endl;
-		}
+	for (size_t first = 0; first < count; first += perBatch) {
+		loaded += uploadCookedBatch(a, triples.data() + first, std::min(perBatch, count - first));
 	}
 	return loaded;
 }
@@ -441,23 +575,6 @@ void TextureArrayManager::setLayerLayout(int map, uint32_t layer, VkImageLayout
 	}
 }
 
-int TextureArrayManager::addAllocationListener(std::function<void()> cb) {	// find an empty slot or push
-	for (size_t i = 0; i < allocationListeners.size(); ++i) {
-		if (!allocationListeners[i]) {
-			allocationListeners[i] = cb;
-			return static_cast<int>(i);
-		}
-	}
-	allocationListeners.push_back(cb);
-	return static_cast<int>(allocationListeners.size() - 1);
-}
-
-void TextureArrayManager::removeAllocationListener(int listenerId) {
-	if (listenerId < 0) return;
-	auto idx = static_cast<size_t>(listenerId);
-	if (idx < allocationListeners.size()) allocationListeners[idx] = {};
-}
-
 uint TextureArrayManager::create(VulkanApp* a) {
 	if (!a) throw std::runtime_error("TextureArrayManager::create: app is null");
 	if (layerAmount == 0) throw std::runtime_error("TextureArrayManager::create: layerAmount == 0");
@@ -465,7 +582,7 @@ uint TextureArrayManager::create(VulkanApp* a) {
 
 	VkDeviceSize imageSize = static_cast<VkDeviceSize>(width) * height * 4;
 
-	// create a zeroed staging buffer
+	// create a zeroed staging buffer (also covers any block-compressed level)
 	Buffer staging = a->createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 	memset(staging.mappedData, 0, static_cast<size_t>(imageSize));
 
@@ -475,6 +592,26 @@ uint TextureArrayManager::create(VulkanApp* a) {
 		TextureImage* dst = imgs[i];
 		if (!dst || dst->image == VK_NULL_HANDLE) continue;
 
+		if (isMapCompressed(i)) {
+			// Block-compressed arrays cannot blit their own mips: zero every level
+			a->runSingleTimeCommands([&](VkCommandBuffer cmd) {
+				a->recordTransitionImageLayoutLayer(cmd, dst->image, mapFormats[i], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dst->mipLevels, currentLayer, 1);
+				std::vector<VkBufferImageCopy> regions;
+				for (uint32_t l = 0; l < dst->mipLevels; ++l) {
+					VkBufferImageCopy region{};
+					region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+					region.imageSubresource.mipLevel = l;
+					region.imageSubresource.baseArrayLayer = currentLayer;
+					region.imageSubresource.layerCount = 1;
+					region.imageExtent = { std::max(1u, width >> l), std::max(1u, height >> l), 1 };
+					regions.push_back(region);
+				}
+				vkCmdCopyBufferToImage(cmd, staging.buffer, dst->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+				a->recordTransitionImageLayoutLayer(cmd, dst->image, mapFormats[i], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, dst->mipLevels, currentLayer, 1);
+			});
+			continue;
+		}
+
 		a->runSingleTimeCommands([&](VkCommandBuffer cmd) {
 
 		// transition layer to TRANSFER_DST_OPTIMAL using centralized app helper
@@ -514,23 +651,14 @@ uint TextureArrayManager::create(VulkanApp* a) {
 	return currentLayer++;
 }
 
-void TextureArrayManager::updateLayerFromEditable(VulkanApp* app, uint32_t layer, const EditableTexture& tex) {
-	updateLayerFromEditableMap(app, layer, tex, 0);
+uint64_t TextureArrayManager::updateLayerFromEditable(VulkanApp* app, uint32_t layer, const EditableTexture& tex) {
+	return updateLayerFromEditableMap(app, layer, tex, 0);
 }
 
-#include "../services/TextureMixer.hpp"
-
-void TextureArrayManager::updateLayerFromEditableMap(VulkanApp* a, uint32_t layer, const EditableTexture& tex, int map) {
+uint64_t TextureArrayManager::updateLayerFromEditableMap(VulkanApp* a, uint32_t layer, const EditableTexture& tex, int map) {
 	if (!a) throw std::runtime_error("TextureArrayManager::updateLayerFromEditableMap: no VulkanApp");
 	if (layer >= layerAmount) throw std::runtime_error("TextureArrayManager::updateLayerFromEditableMap: layer out of range");
 
-	// If a per-layer generation is in-flight for this layer, wait for it to finish to avoid layout races
-	TextureMixer* gm = TextureMixer::getGlobalInstance();
-	if (gm && gm->isLayerGenerationPending(layer)) {
-		std::cerr << "[TextureArrayManager] Waiting for pending generation on layer " << layer << " before copying" << std::endl;
-		gm->waitForLayerGeneration(a, layer);
-	}
-
 	VkDevice device = a->getDevice();
 	uint32_t mipLevels = 1;
 	switch (map) {
@@ -550,66 +678,58 @@ void TextureArrayManager::updateLayerFromEditableMap(VulkanApp* a, uint32_t laye
 	else if (map == 4) dstImage = aoArray.image;
 	else throw std::runtime_error("TextureArrayManager::updateLayerFromEditableMap: invalid map");
 
-	// Transition dst layer to TRANSFER_DST_OPTIMAL for the selected array image and src to TRANSFER_SRC_OPTIMAL
-	a->runSingleTimeCommands([&](VkCommandBuffer cmd) {
-
-	auto doBarrier = [&](VkImage dst, VkImageLayout /*oldDst*/, VkImageLayout newDst, uint32_t dstBaseLayer) {
-		// Use app helper to record per-layer transition into the current cmd.
+	// Queue the copy instead of submitting it synchronously. The upload queue
+	// keeps one job per layer in flight, so this is ordered after any pending
+	// TextureMixer generation for the same layer without a CPU-side fence wait.
+	// Compressed maps take the copy in their RGBA8 work image and encode it
+	const bool compressed = isMapCompressed(map);
+	const VkImage workImage = workImages[map].image;
+
+	streaming::TextureLayerJob job;
+	job.layer = layer;
+	job.map = map;
+	const uint32_t w = width, h = height;
+	job.record = [this, a, srcImage, dstImage, workImage, compressed, map, layer, mipLevels, w, h](VkCommandBuffer cmd) {
 		// Pass VK_IMAGE_LAYOUT_UNDEFINED so VulkanApp resolves the authoritative
 		// effective old layout and avoids mismatches with pending tracked state.
-		a->recordTransitionImageLayoutLayer(cmd, dst, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, newDst, 1, dstBaseLayer, 1);
-	};
-
-	// source barrier: shader read -> transfer src (record via app helper)
-	// Pass VK_IMAGE_LAYOUT_UNDEFINED so the app resolves the authoritative
-	// old layout for this command buffer.
-	a->recordTransitionImageLayoutLayer(cmd, srcImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 1, 0, 1);
-
-	// Copy into selected array layer (ensure we log what we're doing)
-	doBarrier(dstImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, layer);
-	VkImageCopy copyRegion{};
-	copyRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	copyRegion.srcSubresource.mipLevel = 0;
-	copyRegion.srcSubresource.baseArrayLayer = 0;
-	copyRegion.srcSubresource.layerCount = 1;
-	copyRegion.srcOffset = {0,0,0};
-	copyRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	copyRegion.dstSubresource.mipLevel = 0;
-	copyRegion.dstSubresource.baseArrayLayer = layer;
-	copyRegion.dstSubresource.layerCount = 1;
-	copyRegion.dstOffset = {0,0,0};
-	copyRegion.extent = { width, height, 1 };
-	vkCmdCopyImage(cmd, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
-
-	// For mipmapped arrays, keep destination in TRANSFER_DST so generateMipmaps
-	// can transition subresources correctly. Single-mip images transition now.
-	if (mipLevels <= 1) {
-		a->recordTransitionImageLayoutLayer(cmd, dstImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, layer, 1);
-	}
-
-	// Transition src back to SHADER_READ_ONLY_OPTIMAL
-	a->recordTransitionImageLayoutLayer(cmd, srcImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 0, 1);
-	});
+		a->recordTransitionImageLayoutLayer(cmd, srcImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 1, 0, 1);
+		if (compressed) {
+			recordPrepareWorkImage(cmd, map, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		} else {
+			a->recordTransitionImageLayoutLayer(cmd, dstImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, layer, 1);
+		}
 
-		// Generate mipmaps for the updated layer if needed
-		if (mipLevels > 1) {
-			a->generateMipmaps(dstImage, VK_FORMAT_R8G8B8A8_UNORM, static_cast<int32_t>(width), static_cast<int32_t>(height), mipLevels, 1, layer);
+		VkImageCopy copyRegion{};
+		copyRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.srcSubresource.mipLevel = 0;
+		copyRegion.srcSubresource.baseArrayLayer = 0;
+		copyRegion.srcSubresource.layerCount = 1;
+		copyRegion.srcOffset = {0,0,0};
+		copyRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.dstSubresource.mipLevel = 0;
+		copyRegion.dstSubresource.baseArrayLayer = compressed ? 0 : layer;
+		copyRegion.dstSubresource.layerCount = 1;
+		copyRegion.dstOffset = {0,0,0};
+		copyRegion.extent = { w, h, 1 };
+		vkCmdCopyImage(cmd, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, compressed ? workImage : dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+		// Mip generation leaves every level in SHADER_READ_ONLY_OPTIMAL;
+		// single-mip arrays transition the base level directly.
+		if (compressed) {
+			recordEncodeLayer(a, cmd, map, layer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		} else if (mipLevels > 1) {
+			a->recordGenerateMipmaps(cmd, dstImage, VK_FORMAT_R8G8B8A8_UNORM, static_cast<int32_t>(w), static_cast<int32_t>(h), mipLevels, 1, layer);
+		} else {
+			a->recordTransitionImageLayoutLayer(cmd, dstImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, layer, 1);
 		}
 
-		// Safety: ensure the destination layer is explicitly returned to shader-read
-		// across all mip levels, regardless of mipmap generation path internals.
-		a->runSingleTimeCommands([&](VkCommandBuffer cmd) {
-			a->recordTransitionImageLayoutLayer(
-				cmd,
-				dstImage,
-				VK_FORMAT_R8G8B8A8_UNORM,
-				VK_IMAGE_LAYOUT_UNDEFINED,
-				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-				mipLevels,
-				layer,
-				1
-			);
-		});
+		a->recordTransitionImageLayoutLayer(cmd, srcImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 0, 1);
+	};
+	job.onResident = [this, layer]() { setLayerInitialized(layer, true); };
+	uint64_t queuedVersion = uploadQueue.enqueue(std::move(job));
+
+		// Tracked layouts describe the state at the end of the queue: every job
+		// leaves the layer in SHADER_READ_ONLY_OPTIMAL.
 		setLayerLayout(map, layer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 		std::vector<ImTextureID>* texVec = nullptr;
 		auto viewVec = &albedoLayerViews;
@@ -647,14 +767,14 @@ void TextureArrayManager::updateLayerFromEditableMap(VulkanApp* a, uint32_t laye
 				if (arrImg && arrImg->image != VK_NULL_HANDLE) {
 					VkImageViewCreateInfo viewInfo{};
 					viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+					viewInfo.pNext = isMapCompressed(map) ? &SAMPLED_VIEW_USAGE : nullptr;
 					viewInfo.image = arrImg->image;
 					// Create a per-layer 2D view (layerCount = 1) for ImGui previews.  The
 					// ImGui fragment shader uses a plain sampler2D (see glsl_shader.frag),
 					// so the view must not be arrayed.  A non-array view is sufficient
 					// since we only sample a single layer at a time.
 					viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-				if (map == 0) viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-					else viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+					viewInfo.format = mapFormats[map];
 					viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 					viewInfo.subresourceRange.baseMipLevel = 0;
 					viewInfo.subresourceRange.levelCount = arrImg->mipLevels;
@@ -675,6 +795,7 @@ void TextureArrayManager::updateLayerFromEditableMap(VulkanApp* a, uint32_t laye
 				(*texVec)[layer] = (ImTextureID)ImGui_ImplVulkan_AddTexture(sampler, (*viewVec)[layer], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 			}
 		}
+		return queuedVersion;
 	}
 
 void TextureArrayManager::invalidateImGuiDescriptors() {
@@ -726,19 +847,18 @@ ImTextureID TextureArrayManager::getImTexture(size_t layer, int map) {
 		if (!(*viewVec)[layer]) {
 		VkImageViewCreateInfo viewInfo{};
 		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.pNext = isMapCompressed(map) ? &SAMPLED_VIEW_USAGE : nullptr;
 		viewInfo.image = src->image;
 			// Create a simple 2D view for this layer. ImGui shaders sample via
 			// sampler2D, so the view must not be arrayed.
 			viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
 		// choose format consistent with array creation
-			viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+			viewInfo.format = mapFormats[map];
 		viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 		viewInfo.subresourceRange.baseMipLevel = 0;
 		viewInfo.subresourceRange.levelCount = src->mipLevels;
 		viewInfo.subresourceRange.baseArrayLayer = static_cast<uint32_t>(layer);
 		viewInfo.subresourceRange.layerCount = 1;
-		// Use the source image's format where possible
-		// Attempt to read format from src - not stored publicly here; assume appropriate format
 		if (vkCreateImageView(device, &viewInfo, nullptr, &(*viewVec)[layer]) != VK_SUCCESS) {
 			return 0;
 		}
@@ -784,9 +904,10 @@ ImTextureID TextureArrayManager::getImTextureAlpha(size_t layer, int map) {
     if (!(*viewVec)[layer]) {
         VkImageViewCreateInfo viewInfo{};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext = isMapCompressed(map) ? &SAMPLED_VIEW_USAGE : nullptr;
         viewInfo.image = src->image;
         viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-        viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+        viewInfo.format = mapFormats[map];
         viewInfo.components.r = VK_COMPONENT_SWIZZLE_A;
         viewInfo.components.g = VK_COMPONENT_SWIZZLE_A;
         viewInfo.components.b = VK_COMPONENT_SWIZZLE_A;
@@ -805,3 +926,264 @@ ImTextureID TextureArrayManager::getImTextureAlpha(size_t layer, int map) {
     (*texVec)[layer] = (ImTextureID)ImGui_ImplVulkan_AddTexture(sampler, (*viewVec)[layer], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
     return (*texVec)[layer];
 }
+
+// -----------------------------------------------------------------------------
+// block-compressed layer writes
+// -----------------------------------------------------------------------------
+
+TextureImage* TextureArrayManager::mapArray(int map) {
+	switch (map) {
+		case 0: return &albedoArray;
+		case 1: return &normalArray;
+		case 2: return &bumpArray;
+		case 3: return &roughnessArray;
+		case 4: return &aoArray;
+		default: return nullptr;
+	}
+}
+
+bool TextureArrayManager::isMapCompressed(int map) const {
+	return map >= 0 && map < 5 && mapFormats[map] != VK_FORMAT_R8G8B8A8_UNORM;
+}
+
+VkImageView TextureArrayManager::storageView(int map) const {
+	if (isMapCompressed(map)) return workImages[map].view;
+	switch (map) {
+		case 0: return albedoArray.view;
+		case 1: return normalArray.view;
+		case 2: return bumpArray.view;
+		case 3: return roughnessArray.view;
+		case 4: return aoArray.view;
+		default: return VK_NULL_HANDLE;
+	}
+}
+
+void TextureArrayManager::createEncodePipeline(VulkanApp* app) {
+	VkDevice device = app->getDevice();
+	if (encodePipeline == VK_NULL_HANDLE) {
+		// binding 0: work image (sampler2DArray), binding 1: uint block view (uimage2D)
+		VkDescriptorSetLayoutBinding bindings[2] = {};
+		bindings[0].binding = 0;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		bindings[0].descriptorCount = 1;
+		bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		bindings[1].binding = 1;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		bindings[1].descriptorCount = 1;
+		bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+		VkDescriptorSetLayoutCreateInfo layoutInfo{};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutInfo.bindingCount = 2;
+		layoutInfo.pBindings = bindings;
+		if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &encodeSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create texture encode descriptor set layout");
+		}
+		app->resources.addDescriptorSetLayout(encodeSetLayout, "TextureArrayManager: encodeSetLayout");
+
+		VkPushConstantRange pushRange{};
+		pushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushRange.size = sizeof(EncodePushConstants);
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 1;
+		pipelineLayoutInfo.pSetLayouts = &encodeSetLayout;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &encodePipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create texture encode pipeline layout");
+		}
+		app->resources.addPipelineLayout(encodePipelineLayout, "TextureArrayManager: encodePipelineLayout");
+
+		VkComputePipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		pipelineInfo.stage.module = app->getOrCreateShaderModule("shaders/texture_encode.comp.spv");
+		pipelineInfo.stage.pName = "main";
+		pipelineInfo.layout = encodePipelineLayout;
+		if (vkCreateComputePipelines(device, app->getPipelineCache(), 1, &pipelineInfo, nullptr, &encodePipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create texture encode pipeline");
+		}
+		app->resources.addPipeline(encodePipeline, "TextureArrayManager: encodePipeline");
+	}
+
+	// One set per (compressed map, layer, mip), allocated on first encode
+	uint32_t sets = 0;
+	for (int m = 0; m < 5; ++m) sets += static_cast<uint32_t>(encodeSets[m].size());
+	VkDescriptorPoolSize poolSizes[2] = {};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSizes[0].descriptorCount = sets;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	poolSizes[1].descriptorCount = sets;
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.maxSets = sets;
+	poolInfo.poolSizeCount = 2;
+	poolInfo.pPoolSizes = poolSizes;
+	if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &encodePool) != VK_SUCCESS) {
+		throw std::runtime_error("failed to create texture encode descriptor pool");
+	}
+	app->resources.addDescriptorPool(encodePool, "TextureArrayManager: encodePool");
+}
+
+void TextureArrayManager::destroyEncodeResources(VulkanApp* app) {
+	VkDevice device = app->getDevice();
+	// The pipeline and its layouts are kept across reallocations (and released
+	// by the resource manager at shutdown); everything tied to the arrays goes.
+	if (encodePool != VK_NULL_HANDLE) {
+		VkDescriptorPool pool = encodePool;
+		app->deferDestroyUntilAllPending([device, pool, app](){ if (app->resources.removeDescriptorPool(pool)) vkDestroyDescriptorPool(device, pool, nullptr); });
+		encodePool = VK_NULL_HANDLE;
+	}
+	for (int m = 0; m < 5; ++m) {
+		for (auto &v : blockViews[m]) {
+			if (v == VK_NULL_HANDLE) continue;
+			VkImageView iv = v;
+			app->deferDestroyUntilAllPending([device, iv, app](){ if (app->resources.removeImageView(iv)) vkDestroyImageView(device, iv, nullptr); });
+		}
+		blockViews[m].clear();
+		encodeSets[m].clear();
+		if (workSampleViews[m] != VK_NULL_HANDLE) {
+			VkImageView iv = workSampleViews[m];
+			app->deferDestroyUntilAllPending([device, iv, app](){ if (app->resources.removeImageView(iv)) vkDestroyImageView(device, iv, nullptr); });
+			workSampleViews[m] = VK_NULL_HANDLE;
+		}
+		cleanupTextureImage(app, workImages[m]);
+		mapFormats[m] = VK_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+
+VkDescriptorSet TextureArrayManager::encodeDescriptorSet(VulkanApp* app, int map, uint32_t layer, uint32_t mip) {
+	const size_t slot = static_cast<size_t>(layer) * workImages[map].mipLevels + mip;
+	if (encodeSets[map][slot] != VK_NULL_HANDLE) return encodeSets[map][slot];
+	VkDevice device = app->getDevice();
+
+	// One texel per 4x4 block of this (layer, mip)
+	VkImageViewUsageCreateInfo usage{ VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO, nullptr, VK_IMAGE_USAGE_STORAGE_BIT };
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.pNext = &usage;
+	viewInfo.image = mapArray(map)->image;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = blockViewFormat(mapFormats[map]);
+	viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, mip, 1, layer, 1 };
+	if (vkCreateImageView(device, &viewInfo, nullptr, &blockViews[map][slot]) != VK_SUCCESS) {
+		throw std::runtime_error("failed to create texture block view");
+	}
+	app->resources.addImageView(blockViews[map][slot], "TextureArrayManager: blockView");
+
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool = encodePool;
+	allocInfo.descriptorSetCount = 1;
+	allocInfo.pSetLayouts = &encodeSetLayout;
+	VkDescriptorSet set = VK_NULL_HANDLE;
+	if (app->allocateDescriptorSetsThreadSafe(&allocInfo, &set) != VK_SUCCESS) {
+		throw std::runtime_error("failed to allocate texture encode descriptor set");
+	}
+
+	VkDescriptorImageInfo source{};
+	source.sampler = albedoSampler;   // texelFetch only: any sampler will do
+	source.imageView = workSampleViews[map];
+	source.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	VkDescriptorImageInfo blocks{};
+	blocks.imageView = blockViews[map][slot];
+	blocks.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+	VkWriteDescriptorSet writes[2] = {};
+	writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writes[0].dstSet = set;
+	writes[0].dstBinding = 0;
+	writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	writes[0].descriptorCount = 1;
+	writes[0].pImageInfo = &source;
+	writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writes[1].dstSet = set;
+	writes[1].dstBinding = 1;
+	writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	writes[1].descriptorCount = 1;
+	writes[1].pImageInfo = &blocks;
+	vkUpdateDescriptorSets(device, 2, writes, 0, nullptr);
+	encodeSets[map][slot] = set;
+	return set;
+}
+
+// The work images are private to this class and reset by every job, so their
+// barriers are recorded directly instead of through VulkanApp's layout tracking.
+static void recordWorkBarrier(VkCommandBuffer cmd, VkImage image, uint32_t baseMip, uint32_t levels,
+							  VkImageLayout oldLayout, VkImageLayout newLayout,
+							  VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+							  VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) {
+	VkImageMemoryBarrier2 barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+	barrier.srcStageMask = srcStage;
+	barrier.srcAccessMask = srcAccess;
+	barrier.dstStageMask = dstStage;
+	barrier.dstAccessMask = dstAccess;
+	barrier.oldLayout = oldLayout;
+	barrier.newLayout = newLayout;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = image;
+	barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, baseMip, levels, 0, 1 };
+	VkDependencyInfo depInfo{};
+	depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+	depInfo.imageMemoryBarrierCount = 1;
+	depInfo.pImageMemoryBarriers = &barrier;
+	vkCmdPipelineBarrier2(cmd, &depInfo);
+}
+
+void TextureArrayManager::recordPrepareWorkImage(VkCommandBuffer cmd, int map, VkImageLayout layout) {
+	if (!isMapCompressed(map)) return;
+	// Waits for the previous job's encode reads before the content is replaced
+	const VkAccessFlags2 dstAccess = layout == VK_IMAGE_LAYOUT_GENERAL ? (VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT) : VK_ACCESS_2_TRANSFER_WRITE_BIT;
+	recordWorkBarrier(cmd, workImages[map].image, 0, workImages[map].mipLevels,
+					  VK_IMAGE_LAYOUT_UNDEFINED, layout,
+					  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT, 0,
+					  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT, dstAccess);
+}
+
+void TextureArrayManager::recordEncodeLayer(VulkanApp* app, VkCommandBuffer cmd, int map, uint32_t layer, VkImageLayout workLayout) {
+	if (!isMapCompressed(map) || encodePipeline == VK_NULL_HANDLE) return;
+	TextureImage &work = workImages[map];
+	TextureImage* dst = mapArray(map);
+	const uint32_t mipLevels = work.mipLevels;
+
+	// Mip chain of the work image, RGBA8 blits with linear filtering
+	recordWorkBarrier(cmd, work.image, 0, 1, workLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT,
+					  VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+	if (mipLevels > 1) {
+		recordWorkBarrier(cmd, work.image, 1, mipLevels - 1, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+						  VK_PIPELINE_STAGE_2_NONE, 0, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+	}
+	for (uint32_t l = 1; l < mipLevels; ++l) {
+		VkImageBlit blit{};
+		blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, l - 1, 0, 1 };
+		blit.srcOffsets[1] = { std::max(1, static_cast<int32_t>(width >> (l - 1))), std::max(1, static_cast<int32_t>(height >> (l - 1))), 1 };
+		blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, l, 0, 1 };
+		blit.dstOffsets[1] = { std::max(1, static_cast<int32_t>(width >> l)), std::max(1, static_cast<int32_t>(height >> l)), 1 };
+		vkCmdBlitImage(cmd, work.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, work.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+		recordWorkBarrier(cmd, work.image, l, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+						  VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+	}
+	recordWorkBarrier(cmd, work.image, 0, mipLevels, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+					  VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+
+	// Encode every level into the array layer
+	app->recordTransitionImageLayoutLayer(cmd, dst->image, mapFormats[map], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, mipLevels, layer, 1);
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, encodePipeline);
+	EncodePushConstants push{};
+	push.mode = mapFormats[map] == VK_FORMAT_BC4_UNORM_BLOCK ? 0u : (mapFormats[map] == VK_FORMAT_BC5_UNORM_BLOCK ? 1u : 2u);
+	push.srgb = mapFormats[map] == VK_FORMAT_BC7_SRGB_BLOCK ? 1u : 0u;
+	for (uint32_t l = 0; l < mipLevels; ++l) {
+		VkDescriptorSet set = encodeDescriptorSet(app, map, layer, l);
+		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, encodePipelineLayout, 0, 1, &set, 0, nullptr);
+		push.level = l;
+		vkCmdPushConstants(cmd, encodePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+		const uint32_t blocksX = (std::max(1u, width >> l) + 3) / 4;
+		const uint32_t blocksY = (std::max(1u, height >> l) + 3) / 4;
+		vkCmdDispatch(cmd, (blocksX + 7) / 8, (blocksY + 7) / 8, 1);
+	}
+	app->recordTransitionImageLayoutLayer(cmd, dst->image, mapFormats[map], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels, layer, 1);
+}
@@ -17,9 +17,13 @@ void convertSRGB8ToLinearInPlace(unsigned char* data, size_t pixelCount);
 
 #include <cstdint>
 #include "TextureImage.hpp"
+#include "streaming/TextureUploadQueue.hpp"
 #include <vector>
+#include <memory>
 #include <backends/imgui_impl_vulkan.h>
 
+class ThreadPool;
+
 struct TextureTriple { const char* albedo; const char* normal; const char* bump; const char* roughness = nullptr; const char* ao = nullptr; };
 
 class TextureArrayManager {
@@ -31,6 +35,8 @@ public:
     uint32_t height = 0;
 
     // Texture arrays used by shaders (sampler2DArray)
+    // Each array is BC7 sRGB (albedo), BC5 (normal) or BC4 (the rest) when the
+    // device supports block compression, RGBA8 UNORM otherwise; see mapFormats.
     TextureImage albedoArray;
     TextureImage normalArray;
     TextureImage bumpArray;
@@ -68,16 +74,25 @@ public:
     std::vector<VkImageLayout> roughnessLayerLayouts;
     std::vector<VkImageLayout> aoLayerLayouts;
 
+    // Asynchronous per-layer GPU writes (TextureMixer generation, editable copies).
+    // Pump once per frame with uploadQueue.processUploads(); see TextureUploadQueue.
+    streaming::TextureUploadQueue uploadQueue;
+
+    // Storage format of each map's array (0=albedo,1=normal,2=bump,3=roughness,4=ao)
+    VkFormat mapFormats[5] = { VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM };
+
     TextureArrayManager() = default;
+    ~TextureArrayManager();
 
     // Simple version counter incremented whenever GPU resources are (re)allocated
     uint32_t version = 0;
     uint32_t getVersion() const { return version; }
 
-    // Register a callback invoked when GPU arrays are (re)allocated or destroyed.
-    // Returns a listener id (>=0) that can be used to remove the listener.
-    int addAllocationListener(std::function<void()> cb);
-    void removeAllocationListener(int listenerId);
+    // BindlessHeap slot of each map's array (0=albedo,1=normal,2=bump,
+    // 3=roughness,4=ao), registered by allocate() and released by destroy().
+    // Shaders read them from the frame UBO (UniformObject::textureSlots), so
+    // a reallocation only changes the slots written into the next frame.
+    uint32_t getHeapSlot(int map) const;
 
     // Destroy GPU resources (images, views, memory, samplers)
     void destroy(class VulkanApp* app);
@@ -86,8 +101,11 @@ public:
     uint load(class VulkanApp* app, const char* albedoFile, const char* normalFile, const char* bumpFile, const char* roughnessFile = nullptr, const char* aoFile = nullptr);
     size_t loadTriples(class VulkanApp* app, const std::vector<TextureTriple> &triples);
     uint create(class VulkanApp* app);
-    void updateLayerFromEditable(class VulkanApp* app, uint32_t layer, const class EditableTexture& tex);
-    void updateLayerFromEditableMap(class VulkanApp* app, uint32_t layer, const class EditableTexture& tex, int map);
+    // Copy an EditableTexture into an array layer. The copy is queued on uploadQueue
+    // and runs asynchronously: `tex` must stay alive until the layer's resident
+    // version catches up with the returned version.
+    uint64_t updateLayerFromEditable(class VulkanApp* app, uint32_t layer, const class EditableTexture& tex);
+    uint64_t updateLayerFromEditableMap(class VulkanApp* app, uint32_t layer, const class EditableTexture& tex, int map);
 
     // Invalidate all cached ImGui texture descriptors (e.g. after swapchain recreation
     // when the descriptor pool is destroyed). Next getImTexture() call re-creates them.
@@ -119,11 +137,49 @@ public:
     VkImageLayout getLayerLayout(int map, uint32_t layer) const;
     void setLayerLayout(int map, uint32_t layer, VkImageLayout layout);
 
-private:
-    // Listeners called when allocate()/destroy() change GPU resources
-    std::vector<std::function<void()>> allocationListeners;
-
-    // Notify registered listeners safely (copies callbacks and catches exceptions)
-    void notifyAllocationListeners();
+    // GPU writes into block-compressed maps. Shaders cannot store into a BC
+    // array, so layer writers (TextureMixer, editable copies) target a
+    // one-layer RGBA8 work image instead, then recordEncodeLayer() builds its
+    // mips and compresses them into the array layer (texture_encode.comp).
+    bool isMapCompressed(int map) const;
+    // View to bind for storage writes into `map`: the work image (layer 0)
+    // when the map is compressed, the whole array otherwise.
+    VkImageView storageView(int map) const;
+    // Moves a compressed map's work image to `layout` (GENERAL for storage
+    // writes, TRANSFER_DST_OPTIMAL for copies); its old contents are discarded.
+    void recordPrepareWorkImage(VkCommandBuffer cmd, int map, VkImageLayout layout);
+    // Mips level 0 of the work image (currently in `workLayout`) down and
+    // encodes every level into `layer` of the array, leaving the layer in
+    // SHADER_READ_ONLY_OPTIMAL.
+    void recordEncodeLayer(class VulkanApp* app, VkCommandBuffer cmd, int map, uint32_t layer, VkImageLayout workLayout);
 
+private:
+    uint32_t heapSlots[5] = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+    void releaseHeapSlots(class VulkanApp* app);
+
+    // Cook `count` triples on a worker pool (TextureCooker, KTX2 cache) and upload
+    // all their maps and prebuilt mips in a single transfer submission starting at
+    // currentLayer. Triples that fail to load are skipped. Returns layers uploaded.
+    size_t uploadCookedBatch(class VulkanApp* app, const TextureTriple* triples, size_t count);
+    // Cook workers, created on the first batch and kept across batches
+    std::unique_ptr<ThreadPool> cookPool;
+
+    TextureImage* mapArray(int map);
+    void createEncodePipeline(class VulkanApp* app);
+    void destroyEncodeResources(class VulkanApp* app);
+    // Uint view of one (layer, mip) of a compressed array, one texel per block,
+    // and the encode descriptor set that writes through it; both created on
+    // first use and indexed by layer * mipLevels + mip.
+    VkDescriptorSet encodeDescriptorSet(class VulkanApp* app, int map, uint32_t layer, uint32_t mip);
+
+    // RGBA8 staging image per compressed map (1 layer, full mip chain). Its
+    // `view` covers level 0 for storage writes, workSampleViews every level.
+    TextureImage workImages[5];
+    VkImageView workSampleViews[5] = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
+    std::vector<VkImageView> blockViews[5];
+    std::vector<VkDescriptorSet> encodeSets[5];
+    VkDescriptorSetLayout encodeSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout encodePipelineLayout = VK_NULL_HANDLE;
+    VkPipeline encodePipeline = VK_NULL_HANDLE;
+    VkDescriptorPool encodePool = VK_NULL_HANDLE;
 };
@@ -205,6 +205,8 @@ void VulkanApp::initVulkan() {
     createSwapchain();
     createImageViews();
     createDescriptorSetLayout();
+    bindlessHeap.init(this);
+    createScenePipelineLayout();
     createCommandPool();
     createAsyncCmdPoolRing();
     createSingleTimeCmdRing();
@@ -216,61 +218,15 @@ void VulkanApp::initVulkan() {
 
 
 void VulkanApp::createPipelineCache() {
-    // Try to load existing cache data from disk
-    std::vector<char> cacheData;
-    std::ifstream file("pipeline_cache.bin", std::ios::binary | std::ios::ate);
-    if (file.is_open()) {
-        size_t size = static_cast<size_t>(file.tellg());
-        file.seekg(0);
-        cacheData.resize(size);
-        file.read(cacheData.data(), static_cast<std::streamsize>(size));
-        file.close();
-    }
-
-    VkPipelineCacheCreateInfo ci{};
-    ci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-    if (!cacheData.empty()) {
-        ci.initialDataSize = cacheData.size();
-        ci.pInitialData = cacheData.data();
-    }
-
-    if (vkCreatePipelineCache(device, &ci, nullptr, &pipelineCache) != VK_SUCCESS) {
-        std::cerr << "[VulkanApp] Warning: Failed to create pipeline cache, proceeding without" << std::endl;
-        pipelineCache = VK_NULL_HANDLE;
-    } else {
-        printf("[VulkanApp] Created pipeline cache (%zu bytes loaded from disk)%s\n",
-            cacheData.size(), pipelineBinarySupported ? " [VK_KHR_pipeline_binary available]" : "");
+    pipelineCache = pipelineRegistry.createCache(device, physicalDevice);
+    if (pipelineCache != VK_NULL_HANDLE && pipelineBinarySupported) {
+        printf("[VulkanApp] VK_KHR_pipeline_binary %s\n",
+            pipelineRegistry.binariesEnabled() ? "in use for graphics pipelines" : "available but not in use");
     }
 }
 
 void VulkanApp::savePipelineCache() {
-    if (pipelineCache == VK_NULL_HANDLE) {
-        printf("[VulkanApp] Pipeline cache not available, skipping save\n");
-        return;
-    }
-
-    size_t dataSize = 0;
-    VkResult res = vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr);
-    if (res != VK_SUCCESS || dataSize == 0) {
-        std::cerr << "[VulkanApp] Warning: Failed to get pipeline cache size" << std::endl;
-        return;
-    }
-
-    std::vector<char> cacheData(dataSize);
-    res = vkGetPipelineCacheData(device, pipelineCache, &dataSize, cacheData.data());
-    if (res != VK_SUCCESS) {
-        std::cerr << "[VulkanApp] Warning: Failed to read pipeline cache data" << std::endl;
-        return;
-    }
-
-    std::ofstream file("pipeline_cache.bin", std::ios::binary);
-    if (file.is_open()) {
-        file.write(cacheData.data(), static_cast<std::streamsize>(cacheData.size()));
-        file.close();
-        printf("[VulkanApp] Saved pipeline cache (%zu bytes)\n", cacheData.size());
-    } else {
-        std::cerr << "[VulkanApp] Warning: Failed to save pipeline cache to disk" << std::endl;
-    }
+    pipelineRegistry.saveCache(device, pipelineCache);
 }
 
 void VulkanApp::requestClose() {
@@ -395,12 +351,26 @@ void VulkanApp::toggleFullscreen() {
 }
 
 void VulkanApp::mainLoop() {
+    bool firstFrame = true;
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
         drawFrame();
+        if (firstFrame) {
+            firstFrame = false;
+            reportStartup();
+        }
     }
 }
 
+void VulkanApp::reportStartup() {
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count();
+    printf("[Startup] first frame after %.1f ms (pipeline batch: %zu groups in %.1f ms, %s cache, %u pipeline binary hits)\n",
+        ms, pipelineRegistry.getLastBatchCount(), pipelineRegistry.getLastBatchMs(),
+        pipelineRegistry.cacheWasWarm() ? "warm" : "cold", pipelineRegistry.getBinaryHits());
+    const char* benchEnv = std::getenv("VULKAN_STARTUP_BENCH");
+    if (benchEnv && benchEnv[0] != '\0' && benchEnv[0] != '0') requestClose();
+}
+
 void VulkanApp::cleanup() {
     printf("[VulkanApp] cleanup start - device=%p\n", (void*)device);
     bool isDeviceLost = false;
@@ -581,6 +551,7 @@ void VulkanApp::cleanup() {
         m_deferredDestroys.clear();
     }
     printf("[VulkanApp] about to vkDestroyDevice(device=%p)\n", (void*)device);
+        bindlessHeap.cleanup();
         resources.cleanup(device);
         vma.destroy();
         savePipelineCache();
@@ -3477,38 +3448,6 @@ void VulkanApp::createDescriptorSetLayout() {
     // UBO is referenced by vertex, fragment, tessellation, and geometry stages
     uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT | VK_SHADER_STAGE_GEOMETRY_BIT;
 
-    // bindings 1..3: arrays of combined image samplers (albedo / normal / height)
-    // bindings 1..3: one combined image sampler each (we use a texture2D array as the image view)
-    VkDescriptorSetLayoutBinding samplerLayoutBinding{};
-    samplerLayoutBinding.binding = 1;
-    samplerLayoutBinding.descriptorCount = 1;
-    samplerLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    samplerLayoutBinding.pImmutableSamplers = nullptr;
-    samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-
-    VkDescriptorSetLayoutBinding normalSamplerBinding{};
-    normalSamplerBinding.binding = 2;
-    normalSamplerBinding.descriptorCount = 1;
-    normalSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    normalSamplerBinding.pImmutableSamplers = nullptr;
-    normalSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    VkDescriptorSetLayoutBinding heightSamplerBinding{};
-    heightSamplerBinding.binding = 3;
-    heightSamplerBinding.descriptorCount = 1;
-    heightSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    heightSamplerBinding.pImmutableSamplers = nullptr;
-    // Height sampler is used by fragment shader and tessellation evaluation shader (for displacement)
-    heightSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-
-    // binding 4: shadow map sampler
-    VkDescriptorSetLayoutBinding shadowSamplerBinding{};
-    shadowSamplerBinding.binding = 4;
-    shadowSamplerBinding.descriptorCount = 1;
-    shadowSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    shadowSamplerBinding.pImmutableSamplers = nullptr;
-    shadowSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
     // binding 6: Sky UBO
     VkDescriptorSetLayoutBinding skyBinding{};
     skyBinding.binding = 6;
@@ -3516,35 +3455,6 @@ void VulkanApp::createDescriptorSetLayout() {
     skyBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     skyBinding.pImmutableSamplers = nullptr;
     skyBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-    
-    // binding 7: Water params SSBO (for water shader) - use storage buffer like Materials
-    VkDescriptorSetLayoutBinding waterParamsBinding{};
-    waterParamsBinding.binding = 7;
-    waterParamsBinding.descriptorCount = 1;
-    waterParamsBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    waterParamsBinding.pImmutableSamplers = nullptr;
-    // Make the water params visible to fragment, tessellation evaluation, and tessellation control shaders
-    waterParamsBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
-
-    // Per-instance / per-draw descriptor set uses bindings: 0 (UBO), 1..3 (samplers), 4 (shadow cascade 0),
-    // 5 (Materials SSBO), 6 (Sky UBO), 7 (water params), 8 (shadow cascade 1), 9 (shadow cascade 2)
-    // Note: Materials (binding 5) is declared in shaders as set=0 binding=5, so include it in the main layout.
-
-    // binding 8: shadow map cascade 1
-    VkDescriptorSetLayoutBinding shadowCascade1Binding{};
-    shadowCascade1Binding.binding = 8;
-    shadowCascade1Binding.descriptorCount = 1;
-    shadowCascade1Binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    shadowCascade1Binding.pImmutableSamplers = nullptr;
-    shadowCascade1Binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    // binding 9: shadow map cascade 2
-    VkDescriptorSetLayoutBinding shadowCascade2Binding{};
-    shadowCascade2Binding.binding = 9;
-    shadowCascade2Binding.descriptorCount = 1;
-    shadowCascade2Binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    shadowCascade2Binding.pImmutableSamplers = nullptr;
-    shadowCascade2Binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
     // binding 10: Water render UBO (time parameter for water shaders)
     VkDescriptorSetLayoutBinding waterRenderUBOBinding{};
@@ -3554,60 +3464,16 @@ void VulkanApp::createDescriptorSetLayout() {
     waterRenderUBOBinding.pImmutableSamplers = nullptr;
     waterRenderUBOBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
 
-    // binding 11: 360° environment cubemap sampler for solid-shader reflections
-    VkDescriptorSetLayoutBinding envMapBinding{};
-    envMapBinding.binding = 11;
-    envMapBinding.descriptorCount = 1;
-    envMapBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    envMapBinding.pImmutableSamplers = nullptr;
-    envMapBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    // binding 12: roughness map array
-    VkDescriptorSetLayoutBinding roughnessSamplerBinding{};
-    roughnessSamplerBinding.binding = 12;
-    roughnessSamplerBinding.descriptorCount = 1;
-    roughnessSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    roughnessSamplerBinding.pImmutableSamplers = nullptr;
-    roughnessSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    // binding 13: ambient occlusion map array
-    VkDescriptorSetLayoutBinding aoSamplerBinding{};
-    aoSamplerBinding.binding = 13;
-    aoSamplerBinding.descriptorCount = 1;
-    aoSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    aoSamplerBinding.pImmutableSamplers = nullptr;
-    aoSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    std::array<VkDescriptorSetLayoutBinding, 14> bindings = {
-        uboLayoutBinding, samplerLayoutBinding, normalSamplerBinding, heightSamplerBinding,
-        shadowSamplerBinding, /* material */ VkDescriptorSetLayoutBinding{}, skyBinding,
-        waterParamsBinding, shadowCascade1Binding, shadowCascade2Binding, waterRenderUBOBinding,
-        envMapBinding, roughnessSamplerBinding, aoSamplerBinding
+    // Textures, shadow maps, the environment cubemap and the materials /
+    // water params / virtual shadow table buffers live in the bindless heap
+    // (set 1); the frame UBO carries their slots (UniformObject::*Slots).
+    // The binding numbers are kept so the shaders' UBO declarations stay put.
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings = {
+        uboLayoutBinding, skyBinding, waterRenderUBOBinding
     };
-    // Fill the material binding at position 5
-    bindings[5].binding = 5;
-    bindings[5].descriptorCount = 1;
-    bindings[5].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    bindings[5].pImmutableSamplers = nullptr;
-    bindings[5].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-
-    // Binding flags — enable update-after-bind for binding 11 (cubemap environment map)
-    // so that vkUpdateDescriptorSets can write binding 11 while a command buffer
-    // referencing this descriptor set is still pending (the cubemap render path
-    // swaps between a dummy cubemap and the real one every frame).
-    std::array<VkDescriptorBindingFlags, 14> bindingFlags{};
-    bindingFlags.fill(0);
-    bindingFlags[11] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
-
-    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
-    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
-    bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
-    bindingFlagsInfo.pBindingFlags = bindingFlags.data();
 
     VkDescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.pNext = &bindingFlagsInfo;
-    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
     layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
     layoutInfo.pBindings = bindings.data();
 
@@ -3618,7 +3484,7 @@ void VulkanApp::createDescriptorSetLayout() {
     // Register the main descriptor set layout for inspection/cleanup
     resources.addDescriptorSetLayout(descriptorSetLayout, "VulkanApp: descriptorSetLayout");
 
-    // Allocate the main UBO/sampler/materials descriptor sets (one per frame)
+    // Allocate the main UBO descriptor sets (one per frame)
     const uint32_t MAIN_DESC_SETS = MAX_FRAMES_IN_FLIGHT;
     mainDescriptorSets.clear();
     mainDescriptorSets.resize(MAIN_DESC_SETS);
@@ -3626,57 +3492,38 @@ void VulkanApp::createDescriptorSetLayout() {
         mainDescriptorSets[i] = createDescriptorSet(descriptorSetLayout);
     }
 
-    // Allocate one static descriptor set for bindings 1-13 (textures, materials, sky,
-    // water params, cubemap). Written once in SceneRenderer::init() and then copied
-    // into per-frame descriptor sets so per-frame updates only touch binding 0 (UBO).
+    // Allocate one static descriptor set for the shared UBOs (sky, water
+    // render). Written once in SceneRenderer::init() and then copied into
+    // per-frame descriptor sets so per-frame updates only touch binding 0.
     staticDescriptorSet = createDescriptorSet(descriptorSetLayout);
+}
 
-    // Create a separate material descriptor layout used for materials only
-    std::array<VkDescriptorSetLayoutBinding, 1> materialBindings = { bindings[5] };
-    VkDescriptorSetLayoutCreateInfo materialLayoutInfo{};
-    materialLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    materialLayoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
-    materialLayoutInfo.bindingCount = static_cast<uint32_t>(materialBindings.size());
-    materialLayoutInfo.pBindings = materialBindings.data();
-
-    if (vkCreateDescriptorSetLayout(device, &materialLayoutInfo, nullptr, &materialDescriptorSetLayout) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create material descriptor set layout!");
-    }
-
-    // Register material descriptor set layout
-    resources.addDescriptorSetLayout(materialDescriptorSetLayout, "VulkanApp::createDescriptorSetLayout materialDescriptorSetLayout");
-
-    // ── Brush depth descriptor set layout (set=1, binding 0/1) ──
-    // Separate from the main set so the shadow pass (which uses set=0 only)
-    // doesn't need to reference these bindings. Only pipelines using main.frag
-    // (graphicsPipeline, depthPrePassPipeline, deferredColorPipeline) include
-    // this layout.
-    std::array<VkDescriptorSetLayoutBinding, 2> brushDepthBindings{};
-    brushDepthBindings[0].binding = 0;
-    brushDepthBindings[0].descriptorCount = 1;
-    brushDepthBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    brushDepthBindings[0].pImmutableSamplers = nullptr;
-    brushDepthBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    brushDepthBindings[1].binding = 1;
-    brushDepthBindings[1].descriptorCount = 1;
-    brushDepthBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    brushDepthBindings[1].pImmutableSamplers = nullptr;
-    brushDepthBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    VkDescriptorSetLayoutCreateInfo brushDepthLayoutInfo{};
-    brushDepthLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    brushDepthLayoutInfo.bindingCount = static_cast<uint32_t>(brushDepthBindings.size());
-    brushDepthLayoutInfo.pBindings = brushDepthBindings.data();
-
-    if (vkCreateDescriptorSetLayout(device, &brushDepthLayoutInfo, nullptr, &brushDepthDescriptorSetLayout) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create brush depth descriptor set layout!");
-    }
-    resources.addDescriptorSetLayout(brushDepthDescriptorSetLayout, "VulkanApp::createDescriptorSetLayout brushDepthDescriptorSetLayout");
-
-    // If we later add a normal map sampler (binding 2), extend bindings dynamically when required by the app.
+void VulkanApp::createScenePipelineLayout() {
+    // One range for every scene pipeline: layouts only stay compatible (and
+    // the heap bound) when their push-constant ranges match exactly.
+    scenePushConstantRange.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+    scenePushConstantRange.offset = 0;
+    scenePushConstantRange.size = SCENE_PUSH_CONSTANT_SIZE;
+
+    std::vector<VkDescriptorSetLayout> setLayouts = getSceneSetLayouts();
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+    layoutInfo.pSetLayouts = setLayouts.data();
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &scenePushConstantRange;
+    if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &scenePipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create scene pipeline layout!");
+    }
+    resources.addPipelineLayout(scenePipelineLayout, "VulkanApp: scenePipelineLayout");
 }
 
+void VulkanApp::bindBindlessHeap(VkCommandBuffer cmd) const {
+    VkDescriptorSet heapSet = bindlessHeap.getSet();
+    if (cmd == VK_NULL_HANDLE || heapSet == VK_NULL_HANDLE || scenePipelineLayout == VK_NULL_HANDLE) return;
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, scenePipelineLayout,
+                            1, 1, &heapSet, 0, nullptr);
+}
 void VulkanApp::createDepthResources() {
     // simple depth resources using a 32-bit float depth format
     VkFormat depthFormat = VK_FORMAT_D32_SFLOAT;
@@ -3914,6 +3761,7 @@ VkShaderModule VulkanApp::createShaderModule(const std::vector<char>& code) {
 }
 
 VkShaderModule VulkanApp::getOrCreateShaderModule(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_shaderModuleMutex);
     auto it = m_shaderModuleCache.find(path);
     if (it != m_shaderModuleCache.end())
         return it->second;
@@ -4104,13 +3952,16 @@ std::pair<VkPipeline, VkPipelineLayout> VulkanApp::createGraphicsPipeline(
     pipelineInfo.pNext = &pipelineRenderingInfo;
     pipelineInfo.renderPass = VK_NULL_HANDLE;
     VkPipeline graphicsPipeline;
-    if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+    if (pipelineRegistry.createGraphicsPipeline(device, getPipelineCache(), pipelineInfo, &graphicsPipeline) != VK_SUCCESS) {
         throw std::runtime_error("failed to create graphics pipeline!");
     }
     // Track pipeline for cleanup
     resources.addPipeline(graphicsPipeline, "VulkanApp: graphicsPipeline");
     std::cout << "graphics pipeline created\n";
-    registeredPipelines.push_back(graphicsPipeline);
+    {
+        std::lock_guard<std::mutex> lock(registeredPipelinesMutex);
+        registeredPipelines.push_back(graphicsPipeline);
+    }
     return {graphicsPipeline, pl};
 }
 
@@ -5478,6 +5329,10 @@ void VulkanApp::createLogicalDevice() {
     }
     deviceFeatures.tessellationShader = VK_TRUE;
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+    // Bindless heap slots come from the UBO / push constants (dynamically
+    // uniform indices into the heap arrays)
+    deviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+    deviceFeatures.shaderStorageBufferArrayDynamicIndexing = VK_TRUE;
     // Robust buffer access: out-of-bounds reads return 0 instead of undefined behavior
     deviceFeatures.robustBufferAccess = VK_TRUE;
     // Enable depth clamp so tessellation-displaced vertices beyond the far plane
@@ -5490,6 +5345,13 @@ void VulkanApp::createLogicalDevice() {
         deviceFeatures.multiDrawIndirect = VK_TRUE;
         deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
     }
+    // Block-compressed texture arrays; the GPU encoder writes them through
+    // uint views, which need unformatted storage writes
+    blockCompressionSupported = supportedFeatures.textureCompressionBC && supportedFeatures.shaderStorageImageWriteWithoutFormat;
+    if (blockCompressionSupported) {
+        deviceFeatures.textureCompressionBC = VK_TRUE;
+        deviceFeatures.shaderStorageImageWriteWithoutFormat = VK_TRUE;
+    }
 
     // Enable Vulkan 1.1 shaderDrawParameters for gl_BaseInstanceARB in shaders
     VkPhysicalDeviceVulkan11Features vulkan11Features{};
@@ -5523,6 +5385,9 @@ void VulkanApp::createLogicalDevice() {
     vulkan12Features.pNext = &vulkan11Features;
     vulkan12Features.drawIndirectCount = VK_TRUE;
     vulkan12Features.descriptorIndexing = VK_TRUE;
+    // Bindless heap (BindlessHeap): runtime-sized, partially bound arrays
+    vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+    vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
     vulkan12Features.timelineSemaphore = VK_TRUE;
     // GPU-assisted validation (VULKAN_GPU_ASSISTED=1) instruments shaders and needs
     // bufferDeviceAddress. Modern GPUs (Radeon 680M / RDNA2) support it; only older
@@ -5576,9 +5441,47 @@ void VulkanApp::createLogicalDevice() {
     if (maintenance5Supported) {
         extensions.push_back(VK_KHR_MAINTENANCE5_EXTENSION_NAME);
     }
+    // Pipeline binaries need the extension's feature plus maintenance5 (for
+    // the CAPTURE_DATA create flag). Drivers that prefer their internal cache
+    // keep using the VkPipelineCache path instead.
+    VkPhysicalDeviceMaintenance5FeaturesKHR maintenance5Features{};
+    maintenance5Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_5_FEATURES_KHR;
+    VkPhysicalDevicePipelineBinaryFeaturesKHR pipelineBinaryFeatures{};
+    pipelineBinaryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_BINARY_FEATURES_KHR;
+    bool usePipelineBinaries = false;
     if (pipelineBinarySupported) {
         extensions.push_back(VK_KHR_PIPELINE_BINARY_EXTENSION_NAME);
         printf("[VulkanApp] VK_KHR_pipeline_binary supported — enabling for granular pipeline cache invalidation\n");
+
+        pipelineBinaryFeatures.pNext = &maintenance5Features;
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &pipelineBinaryFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+        VkPhysicalDevicePipelineBinaryPropertiesKHR binaryProps{};
+        binaryProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_BINARY_PROPERTIES_KHR;
+        VkPhysicalDeviceProperties2 props2{};
+        props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        props2.pNext = &binaryProps;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &props2);
+
+        usePipelineBinaries = maintenance5Supported && maintenance5Features.maintenance5 &&
+                              pipelineBinaryFeatures.pipelineBinaries &&
+                              !binaryProps.pipelineBinaryPrefersInternalCache;
+        if (usePipelineBinaries) {
+            pipelineBinaryFeatures = {};
+            pipelineBinaryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_BINARY_FEATURES_KHR;
+            pipelineBinaryFeatures.pipelineBinaries = VK_TRUE;
+            maintenance5Features = {};
+            maintenance5Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_5_FEATURES_KHR;
+            maintenance5Features.maintenance5 = VK_TRUE;
+            pipelineBinaryFeatures.pNext = &maintenance5Features;
+            maintenance5Features.pNext = const_cast<void*>(createInfo.pNext);
+            createInfo.pNext = &pipelineBinaryFeatures;
+        } else if (binaryProps.pipelineBinaryPrefersInternalCache) {
+            printf("[VulkanApp] Driver prefers its internal pipeline cache; not using pipeline binaries\n");
+        }
     }
 
     createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
@@ -5593,10 +5496,11 @@ void VulkanApp::createLogicalDevice() {
     if (vkCreateDevice(physicalDevice, &createInfo, nullptr, &device) != VK_SUCCESS) {
         throw std::runtime_error("failed to create logical device!");
     }
+    if (usePipelineBinaries) pipelineRegistry.enableBinaries(device);
 
     // Create main descriptor pool immediately after device creation
     // (choose reasonable default counts for UBOs and samplers)
-    createDescriptorPool(32, 128);
+    createDescriptorPool(32, 160);
 
     // retrieve queue handles. If we requested multiple queues from the
     // graphics family, obtain them; otherwise fall back to the main
@@ -5654,6 +5558,7 @@ void VulkanApp::run() {
     // resources). cleanup() must still run so the partially created device and
     // instance are torn down instead of leaking. The mainLoop catch blocks are
     // kept as before; any exception escaping them is caught by the outer try.
+    startupBegin = std::chrono::steady_clock::now();
     try {
         initWindow();
         initVulkan();
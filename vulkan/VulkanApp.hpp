@@ -24,6 +24,8 @@
 #include "vulkan.hpp"
 #include "VulkanResourceManager.hpp"
 #include "VmaContext.hpp"
+#include "PipelineRegistry.hpp"
+#include "BindlessHeap.hpp"
 
 struct GraphicsPipelineConfig {
     VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
@@ -67,11 +69,20 @@ class VulkanApp {
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
     VkDevice device = VK_NULL_HANDLE;
     // Pipeline cache for reducing shader compilation time across runs.
-    // Created after device creation, serialized to disk on shutdown.
+    // Created after device creation, serialized to disk on shutdown; the file
+    // is content-addressed by driver identity and SPIR-V hash (PipelineRegistry).
     VkPipelineCache pipelineCache = VK_NULL_HANDLE;
     // Whether VK_KHR_pipeline_binary (Vulkan 1.4) is supported by the physical device.
     // When true, per-pipeline binary keys can be used for granular cache invalidation.
     bool pipelineBinarySupported = false;
+    // Whether BC textures can be sampled and written through unformatted
+    // storage views (textureCompressionBC + shaderStorageImageWriteWithoutFormat).
+    // TextureArrayManager falls back to RGBA8 arrays when false.
+    bool blockCompressionSupported = false;
+    // Parallel startup pipeline compilation + cache/binary persistence
+    PipelineRegistry pipelineRegistry;
+    // Global descriptor-indexing heap (texture arrays + storage buffers)
+    BindlessHeap bindlessHeap;
     VkQueue graphicsQueue = VK_NULL_HANDLE;
     VkQueue presentQueue = VK_NULL_HANDLE;
     // Dedicated queues for async subsystems
@@ -146,18 +157,20 @@ private:
     // texture and descriptor
 
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
-    // Static descriptor set layout (bindings 1-13: textures, materials, sky, water params, cubemap)
-    // These resources are written once and reused across all per-frame descriptor sets.
+    // Static descriptor set (bindings 6 and 10: sky and water render UBOs)
+    // written once and copied into every per-frame descriptor set.
     VkDescriptorSet staticDescriptorSet = VK_NULL_HANDLE;
-    // Dedicated descriptor set layout for global materials (binding 5)
-    VkDescriptorSetLayout materialDescriptorSetLayout = VK_NULL_HANDLE;
-    // Descriptor set layout for brush depth textures (set=1, binding 0/1)
-    VkDescriptorSetLayout brushDepthDescriptorSetLayout = VK_NULL_HANDLE;
+    // Scene pipelines: {main set, bindless heap} + one push-constant range
+    // (see getSceneSetLayouts). scenePipelineLayout only binds the heap.
+    VkPushConstantRange scenePushConstantRange{};
+    VkPipelineLayout scenePipelineLayout = VK_NULL_HANDLE;
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
     // Registered descriptor sets for runtime inspection (widgets can read these)
     std::vector<VkDescriptorSet> registeredDescriptorSets;
-    // Registered graphics pipelines for runtime inspection
+    // Registered graphics pipelines for runtime inspection (appended from
+    // PipelineRegistry workers during startup, hence the mutex)
     std::vector<VkPipeline> registeredPipelines;
+    std::mutex registeredPipelinesMutex;
     // depth resources
     VkImage depthImage = VK_NULL_HANDLE;
     VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
@@ -210,6 +223,8 @@ protected:
 
     // True between initVulkan() and the end of setup() — used to show loading screen
     bool isLoading = false;
+    // Start of run(); the first frame after setup() reports time-to-first-frame
+    std::chrono::steady_clock::time_point startupBegin;
 
     // Set when a device-lost is detected to allow graceful shutdown handling
     std::atomic<bool> deviceLost{false};
@@ -327,6 +342,7 @@ public:
         // Add a semaphore that the next frame submission must wait on (for async uploads)
         void addExtraWaitSemaphore(VkSemaphore sem, VkPipelineStageFlags2 stage);
         void createDescriptorSetLayout();
+        void createScenePipelineLayout();
 
     // ImGui integration glue: backend can call these to route submits through the
     // application's synchronized submission helpers. `g_imguiVulkanApp` is defined
@@ -363,6 +379,9 @@ public:
     void initImGui();
     void cleanupImGui();
         void mainLoop();
+        // Logs time to first frame with the pipeline compile/cache stats; with
+        // VULKAN_STARTUP_BENCH=1 the app closes right after (startup benchmark).
+        void reportStartup();
         void cleanup();
 
 
@@ -388,10 +407,22 @@ public:
         void updateDescriptorSet(const std::vector<VkWriteDescriptorSet> &descriptors);
         void registerDescriptorSet(VkDescriptorSet ds) { if (ds != VK_NULL_HANDLE) registeredDescriptorSets.push_back(ds); }
         const std::vector<VkDescriptorSet>& getRegisteredDescriptorSets() const { return registeredDescriptorSets; }
-        VkDescriptorSetLayout getMaterialDescriptorSetLayout() const { return materialDescriptorSetLayout; }
         VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout; }
         VkDescriptorSet getStaticDescriptorSet() const { return staticDescriptorSet; }
-        VkDescriptorSetLayout getBrushDepthDescriptorSetLayout() const { return brushDepthDescriptorSetLayout; }
+
+        // Scene pipeline layouts are set 0 = main set, set 1 = bindless heap,
+        // with the shared scene push-constant range. Every scene pipeline is
+        // built from these, so all of them are compatible for sets 0-1: the
+        // heap bound once per command buffer (bindBindlessHeap) stays bound
+        // across pipeline changes and set-0 rebinds. Push constants must be
+        // pushed with VK_SHADER_STAGE_ALL_GRAPHICS.
+        static constexpr uint32_t SCENE_PUSH_CONSTANT_SIZE = 128;
+        std::vector<VkDescriptorSetLayout> getSceneSetLayouts() const { return { descriptorSetLayout, bindlessHeap.getLayout() }; }
+        const VkPushConstantRange* getScenePushConstantRange() const { return &scenePushConstantRange; }
+        VkPipelineLayout getScenePipelineLayout() const { return scenePipelineLayout; }
+        // Binds the heap at set 1 (graphics). Once per command buffer, and
+        // again only after a non-scene pipeline layout rebinds set 0.
+        void bindBindlessHeap(VkCommandBuffer cmd) const;
 
         const std::vector<VkPipeline>& getRegisteredPipelines() const { return registeredPipelines; }
 
@@ -486,7 +517,13 @@ public:
         std::vector<VkCommandBuffer> createCommandBuffers();
 
         VkDevice getDevice() const;
-        VkPipelineCache getPipelineCache() const { return pipelineCache; }
+        // Inside a PipelineRegistry batch worker this is the worker's own cache
+        VkPipelineCache getPipelineCache() const {
+            VkPipelineCache workerCache = PipelineRegistry::threadCache();
+            return workerCache != VK_NULL_HANDLE ? workerCache : pipelineCache;
+        }
+        PipelineRegistry& getPipelineRegistry() { return pipelineRegistry; }
+        BindlessHeap& getBindlessHeap() { return bindlessHeap; }
         VkPipelineLayout getPipelineLayout() const;
 
         // Public getters for runtime inspection (used by widgets)
@@ -610,6 +647,7 @@ public:
         // Destruction is handled by VulkanResourceManager at shutdown (createShaderModule registers
         // each module with resources).
         std::unordered_map<std::string, VkShaderModule> m_shaderModuleCache;
+        std::mutex m_shaderModuleMutex; // PipelineRegistry workers load modules concurrently
 
         // Single mutex guarding all submission/tracking state below.
         // Replaces per-object mutexes to eliminate lock-ordering deadlocks.
@@ -11,6 +11,7 @@ static constexpr uint32_t ATTR_NORMAL = 3u;
 static constexpr uint32_t ATTR_BRUSH_INDEX = 4u;
 static constexpr uint32_t ATTR_HSV = 6u;
 static constexpr uint32_t ATTR_INSTANCE = 5u;
+static constexpr uint32_t ATTR_MORPH = 7u;
 
 // Fragment output locations (match render pass attachments)
 static constexpr uint32_t FRAG_OUT_COLOR = 0u;
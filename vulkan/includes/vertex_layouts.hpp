@@ -28,7 +28,8 @@ inline std::vector<VkVertexInputAttributeDescription> defaultAttributes() {
         VkVertexInputAttributeDescription{ ATTR_UV, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, texCoord) },
         VkVertexInputAttributeDescription{ ATTR_NORMAL, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal) },
         VkVertexInputAttributeDescription{ ATTR_BRUSH_INDEX, 0, VK_FORMAT_R32_SINT, offsetof(Vertex, brushIndex) },
-        VkVertexInputAttributeDescription{ ATTR_HSV, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, hsv) }
+        VkVertexInputAttributeDescription{ ATTR_HSV, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, hsv) },
+        VkVertexInputAttributeDescription{ ATTR_MORPH, 0, VK_FORMAT_R32_UINT, offsetof(Vertex, morph) }
     };
 }
 
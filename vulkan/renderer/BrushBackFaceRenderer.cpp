@@ -43,10 +43,8 @@ void BrushBackFaceRenderer::createPipelines(VulkanApp* app) {
         VK_SHADER_STAGE_FRAGMENT_BIT
     );
 
-    // Descriptor set layouts: only set 0 (main UBO/textures)
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    if (app->getDescriptorSetLayout() != VK_NULL_HANDLE)
-        setLayouts.push_back(app->getDescriptorSetLayout());
+    // Scene layouts: main UBO (set 0), bindless heap (set 1, height array)
+    const std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
 
     GraphicsPipelineConfig cfg{};
     cfg.cullMode = VK_CULL_MODE_FRONT_BIT;
@@ -59,7 +57,7 @@ void BrushBackFaceRenderer::createPipelines(VulkanApp* app) {
         std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
         vk_layouts::defaultAttributes(),
         setLayouts,
-        nullptr,
+        app->getScenePushConstantRange(),
         cfg
     );
     backFacePipeline = pipeline;
@@ -173,7 +171,7 @@ void BrushBackFaceRenderer::renderBackFacePass(VulkanApp* app, VkCommandBuffer c
     if (cmdState) cmdState->bindGraphicsPipeline(cmd, backFacePipeline);
     else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, backFacePipeline);
 
-    // Bind descriptor set 0: main UBO/textures
+    // Bind descriptor set 0: main UBO (the heap stays bound at set 1)
     if (mainDs != VK_NULL_HANDLE) {
         if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, pipelineLayout, 0, 1, &mainDs, 0, nullptr);
         else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &mainDs, 0, nullptr);
@@ -1,7 +1,6 @@
 #include "BrushRenderer.hpp"
 #include "SolidRenderer.hpp"
 #include "RendererUtils.hpp"
-#include "DescriptorWriter.hpp"
 #include <stdexcept>
 #include <iostream>
 
@@ -25,17 +24,13 @@ void BrushRenderer::init(VulkanApp* app, uint32_t width, uint32_t height) {
     backFaceRenderer = std::make_unique<BrushBackFaceRenderer>();
     if (backFaceRenderer) {
         backFaceRenderer->init(app);
-        backFaceRenderer->createPipelines(app);
+        app->getPipelineRegistry().declare("BrushBackFaceRenderer", [this, app]() {
+            backFaceRenderer->createPipelines(app);
+        });
         backFaceRenderer->createRenderTargets(app, width, height);
     }
 
-    // Allocate (once) and write per-frame brush depth descriptor sets (set=1)
-    for (size_t fi = 0; fi < depthDescriptorSets.size(); ++fi) {
-        if (depthDescriptorSets[fi] == VK_NULL_HANDLE) {
-            depthDescriptorSets[fi] = app->createDescriptorSet(app->getBrushDepthDescriptorSetLayout());
-        }
-    }
-    writeDepthDescriptors(app);
+    registerDepthSlots(app);
 }
 
 void BrushRenderer::cleanup(VulkanApp* app) {
@@ -43,6 +38,14 @@ void BrushRenderer::cleanup(VulkanApp* app) {
         backFaceRenderer->cleanup(app);
     }
     backFaceRenderer.reset();
+    if (app) {
+        for (uint32_t i = 0; i < BRUSH_FRAMES; ++i) {
+            app->getBindlessHeap().releaseImage(depthSlots[i]);
+            app->getBindlessHeap().releaseImage(backFaceDepthSlots[i]);
+        }
+    }
+    depthSlots = filledSlots();
+    backFaceDepthSlots = filledSlots();
     destroyRenderTargets(app);
     solidIndirectRenderer.cleanup(app);
     liquidIndirectRenderer.cleanup(app);
@@ -110,38 +113,21 @@ void BrushRenderer::onSwapchainResized(VulkanApp* app, uint32_t width, uint32_t
     // the first barrier after resize uses VK_IMAGE_LAYOUT_UNDEFINED as oldLayout.
     colorLayouts.fill(VK_IMAGE_LAYOUT_UNDEFINED);
     depthLayouts.fill(VK_IMAGE_LAYOUT_UNDEFINED);
-    // Rewrite brush depth descriptors after recreating brush targets.
-    writeDepthDescriptors(app);
+    // Re-register the brush depth slots after recreating brush targets.
+    registerDepthSlots(app);
 }
 
-void BrushRenderer::writeDepthDescriptors(VulkanApp* app) {
+void BrushRenderer::registerDepthSlots(VulkanApp* app) {
     VkSampler brushDepthSampler = depthLinearSampler;
     if (brushDepthSampler == VK_NULL_HANDLE) {
         brushDepthSampler = depthShadowSampler;
     }
 
-    for (size_t fi = 0; fi < depthDescriptorSets.size(); ++fi) {
-        VkDescriptorSet dstSet = depthDescriptorSets[fi];
-        if (dstSet == VK_NULL_HANDLE) continue;
-        VkImageView brushFrontView = getDepthView(static_cast<uint32_t>(fi));
-        VkImageView brushBackView = VK_NULL_HANDLE;
-        if (backFaceRenderer) {
-            brushBackView = backFaceRenderer->getBackFaceDepthView(static_cast<uint32_t>(fi));
-        }
-        if (brushDepthSampler == VK_NULL_HANDLE) continue;
-
-        DescriptorWriter writer(app->getDevice());
-        if (brushFrontView != VK_NULL_HANDLE) {
-            writer.writeImage(dstSet, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                              brushDepthSampler, brushFrontView,
-                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
-        if (brushBackView != VK_NULL_HANDLE) {
-            writer.writeImage(dstSet, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                              brushDepthSampler, brushBackView,
-                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
-        writer.flush();
+    BindlessHeap& heap = app->getBindlessHeap();
+    for (uint32_t fi = 0; fi < BRUSH_FRAMES; ++fi) {
+        VkImageView brushBackView = backFaceRenderer ? backFaceRenderer->getBackFaceDepthView(fi) : VK_NULL_HANDLE;
+        depthSlots[fi] = heap.replaceImage(depthSlots[fi], getDepthView(fi), brushDepthSampler);
+        backFaceDepthSlots[fi] = heap.replaceImage(backFaceDepthSlots[fi], brushBackView, brushDepthSampler);
     }
 }
 
@@ -17,8 +17,8 @@ class SolidRenderer;
 // SolidRenderer / WaterRenderer encapsulate their offscreen targets, pipelines
 // and IndirectRenderers:
 //   - brush offscreen color + front depth targets (one per frame-in-flight)
-//   - per-frame brush depth descriptor sets (set=1, bindings 0/1) used by the
-//     solid/water shaders to depth-test against the brush volume
+//   - per-frame bindless heap slots of the brush front and back-face depth,
+//     which the solid/water shaders depth-test against (ubo.sceneSlots.xy)
 //   - the back-face depth pass (BrushBackFaceRenderer) for PAINT mode
 //   - the two dedicated brush IndirectRenderers (solid + liquid), so the brush
 //     geometry never shares the main scene slot pools
@@ -32,9 +32,9 @@ public:
     ~BrushRenderer();
 
     // Create everything brush-related (offscreen targets, back-face renderer,
-    // descriptor sets, IndirectRenderers). Samplers for the brush depth
-    // descriptor writes must be provided via setDepthSamplers() first (they
-    // are queried lazily by writeDepthDescriptors()).
+    // heap slots, IndirectRenderers). Samplers for the brush depth slots must
+    // be provided via setDepthSamplers() first (they are queried lazily by
+    // registerDepthSlots()).
     void init(VulkanApp* app, uint32_t width, uint32_t height);
     void cleanup(VulkanApp* app) override;
 
@@ -52,23 +52,20 @@ public:
         return backFaceRenderer ? backFaceRenderer->getBackFaceDepthView(i) : VK_NULL_HANDLE;
     }
 
-    // Per-frame descriptor sets for brush depth textures (set=1, binding 0/1:
-    // front depth, back-face depth).
-    VkDescriptorSet getDepthDescriptorSet(uint32_t frameIndex) const {
-        return depthDescriptorSets[frameIndex % BRUSH_FRAMES];
-    }
+    // Per-frame heap slots of the brush front depth and back-face depth.
+    uint32_t getDepthSlot(uint32_t frameIndex) const { return depthSlots[frameIndex % BRUSH_FRAMES]; }
+    uint32_t getBackFaceDepthSlot(uint32_t frameIndex) const { return backFaceDepthSlots[frameIndex % BRUSH_FRAMES]; }
 
-    // Samplers used for the brush depth descriptor writes (queried each time
-    // writeDepthDescriptors() runs, so they may be (re)created later).
+    // Samplers used for the brush depth slots (queried each time
+    // registerDepthSlots() runs, so they may be (re)created later).
     void setDepthSamplers(VkSampler linear, VkSampler shadow) {
         depthLinearSampler = linear;
         depthShadowSampler = shadow;
     }
 
-    // Rewrite brush depth texture descriptors (bindings 0, 1) for all per-frame
-    // brush descriptor sets. Must be called after brush render targets are
-    // recreated (on resize or after init).
-    void writeDepthDescriptors(VulkanApp* app);
+    // Re-register the brush depth slots of every frame. Must be called after
+    // brush render targets are recreated (on resize or after init).
+    void registerDepthSlots(VulkanApp* app);
 
     // Dedicated IndirectRenderers for the brush solid and liquid meshes (own
     // slot pools; never shared with the main scene IRs).
@@ -140,8 +137,14 @@ private:
     std::array<VkImageView, BRUSH_FRAMES> depthImageViews = {};
     std::array<VkImageLayout, BRUSH_FRAMES> depthLayouts = {};
 
-    // Per-frame descriptor sets for brush depth textures (set=1)
-    std::array<VkDescriptorSet, BRUSH_FRAMES> depthDescriptorSets = {};
+    // Per-frame heap slots for the brush depth textures
+    std::array<uint32_t, BRUSH_FRAMES> depthSlots = filledSlots();
+    std::array<uint32_t, BRUSH_FRAMES> backFaceDepthSlots = filledSlots();
+    static std::array<uint32_t, BRUSH_FRAMES> filledSlots() {
+        std::array<uint32_t, BRUSH_FRAMES> slots;
+        slots.fill(UINT32_MAX);
+        return slots;
+    }
 
     IndirectRenderer solidIndirectRenderer;
     IndirectRenderer liquidIndirectRenderer;
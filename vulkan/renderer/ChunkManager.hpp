@@ -2,6 +2,7 @@
 
 #include "ChunkState.hpp"
 #include "../../space/ThreadPool.hpp"
+#include <algorithm>
 #include <cstdint>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +31,12 @@ public:
     // Unique identifier for a chunk (typically the NodeID cast to uint64).
     using ChunkId = uint64_t;
 
+    // World-space AABB of a chunk's live mesh.
+    struct ChunkBounds {
+        float min[3] = {0.0f, 0.0f, 0.0f};
+        float max[3] = {0.0f, 0.0f, 0.0f};
+    };
+
     // Per-chunk tracking data.
     struct ChunkEntry {
         ChunkState state = ChunkState::Clean;
@@ -39,6 +46,8 @@ public:
         uint32_t version = 0;       // octree version at last rebuild
         uint32_t rebuildCount = 0;  // monotonically increasing
         bool queuedForRebuild = false; // in dirty queue (prevents duplicates)
+        ChunkBounds bounds;             // set at publish (setChunkBounds)
+        bool hasBounds = false;
     };
 
     ChunkManager() = default;
@@ -80,6 +89,16 @@ public:
     // Get the stored slot index (UINT32_MAX if not yet assigned).
     uint32_t getSlotIndex(ChunkId id) const;
 
+    // Store the world-space bounds of the chunk's mesh (called at publish,
+    // next to setSlotIndex). Used to report changed regions.
+    void setChunkBounds(ChunkId id, const ChunkBounds& bounds);
+
+    // Drain the regions whose live geometry changed since the last call:
+    // chunks swapped to a new mesh version, and removed chunks. Consumers that
+    // cache rendered results (e.g. shadow cascades) invalidate against these.
+    // Call once per frame from the main thread.
+    void takeChangedRegions(std::vector<ChunkBounds>& out);
+
     // ── Worker thread API ────────────────────────────────────────────────────
 
     // Transition a chunk from Queued → BuildingCPU.
@@ -106,6 +125,11 @@ private:
     // Set chunk state with optional version update.
     void setState(ChunkId id, ChunkState newState);
 
+    // Append a changed region (mapMutex_ held). When nobody drains the list
+    // it collapses into a single union box instead of growing without bound.
+    void noteChangedLocked(const ChunkEntry& entry);
+    static constexpr size_t MAX_CHANGED_REGIONS = 4096;
+
     mutable std::mutex mapMutex_;
 
     // Per-chunk state (protected by mapMutex_)
@@ -120,6 +144,9 @@ private:
     // Protected by a separate mutex to avoid contention on the rendering path.
     mutable std::mutex swapMutex_;
     std::deque<ChunkId> swapQueue_;
+
+    // Changed regions not yet drained (protected by mapMutex_)
+    std::vector<ChunkBounds> changedRegions_;
 };
 
 
@@ -157,11 +184,15 @@ inline bool ChunkManager::isChunkBusy(ChunkId id) const {
 
 inline void ChunkManager::removeChunk(ChunkId id) {
     std::lock_guard<std::mutex> lock(mapMutex_);
-    stateMap_.erase(id);
+    auto it = stateMap_.find(id);
+    if (it == stateMap_.end()) return;
+    noteChangedLocked(it->second);
+    stateMap_.erase(it);
 }
 
 inline void ChunkManager::removeAll() {
     std::lock_guard<std::mutex> lock(mapMutex_);
+    for (const auto& [id, entry] : stateMap_) noteChangedLocked(entry);
     stateMap_.clear();
     dirtyQueue_.clear();
     std::lock_guard<std::mutex> slock(swapMutex_);
@@ -228,6 +259,7 @@ inline void ChunkManager::processSwapQueue() {
         entry.state = ChunkState::Clean;
         entry.queuedForRebuild = false;
         entry.rebuildCount++;
+        noteChangedLocked(entry);
 
         // Check if chunk was dirtied again during the build
         if (entry.version > entry.currentVersion) {
@@ -262,3 +294,38 @@ inline size_t ChunkManager::activeChunkCount() const {
     std::lock_guard<std::mutex> lock(mapMutex_);
     return stateMap_.size();
 }
+
+inline void ChunkManager::setChunkBounds(ChunkId id, const ChunkBounds& bounds) {
+    std::lock_guard<std::mutex> lock(mapMutex_);
+    auto it = stateMap_.find(id);
+    if (it != stateMap_.end()) {
+        it->second.bounds = bounds;
+        it->second.hasBounds = true;
+    }
+}
+
+inline void ChunkManager::noteChangedLocked(const ChunkEntry& entry) {
+    if (!entry.hasBounds) return;
+    if (changedRegions_.size() < MAX_CHANGED_REGIONS) {
+        changedRegions_.push_back(entry.bounds);
+        return;
+    }
+    ChunkBounds merged = changedRegions_.front();
+    for (const auto& r : changedRegions_) {
+        for (int a = 0; a < 3; ++a) {
+            merged.min[a] = std::min(merged.min[a], r.min[a]);
+            merged.max[a] = std::max(merged.max[a], r.max[a]);
+        }
+    }
+    for (int a = 0; a < 3; ++a) {
+        merged.min[a] = std::min(merged.min[a], entry.bounds.min[a]);
+        merged.max[a] = std::max(merged.max[a], entry.bounds.max[a]);
+    }
+    changedRegions_.assign(1, merged);
+}
+
+inline void ChunkManager::takeChangedRegions(std::vector<ChunkBounds>& out) {
+    std::lock_guard<std::mutex> lock(mapMutex_);
+    out.insert(out.end(), changedRegions_.begin(), changedRegions_.end());
+    changedRegions_.clear();
+}
@@ -1,6 +1,4 @@
 #include "DebugCubeRenderer.hpp"
-#include "DescriptorAllocator.hpp"
-#include "DescriptorWriter.hpp"
 #include "../VertexBufferObjectBuilder.hpp"
 #include "../ShaderStage.hpp"
 #include "../../utils/FileReader.hpp"
@@ -21,9 +19,11 @@ void DebugCubeRenderer::init(VulkanApp* app) {
     // Load grid texture
     loadGridTexture(app);
     
-    // Create descriptor set for grid texture
-    createGridDescriptorSet(app);
-    
+    // Heap slots for the grid texture and the instance buffer
+    createHeapSlots(app);
+}
+
+void DebugCubeRenderer::createPipeline(VulkanApp* app) {
     // Create shader modules
     vertModule = app->getOrCreateShaderModule("shaders/debug_cube.vert.spv");
     fragModule = app->getOrCreateShaderModule("shaders/debug_cube.frag.spv");
@@ -31,11 +31,9 @@ void DebugCubeRenderer::init(VulkanApp* app) {
     ShaderStage vertStage(vertModule, VK_SHADER_STAGE_VERTEX_BIT);
     ShaderStage fragStage(fragModule, VK_SHADER_STAGE_FRAGMENT_BIT);
     
-    // Setup descriptor set layouts: set 0 = UBO, set 1 = grid texture + instance buffer
-    std::vector<VkDescriptorSetLayout> setLayouts = {
-        app->getDescriptorSetLayout(),  // set 0: UBO
-        gridDescriptorSetLayout          // set 1: grid texture + instance buffer
-    };
+    // Scene layouts: set 0 = UBO, set 1 = bindless heap (grid texture and
+    // instance buffer slots come through push constants)
+    const std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
     
     // Create pipeline with alpha blending enabled for transparency
     GraphicsPipelineConfig cfg{};
@@ -56,7 +54,7 @@ void DebugCubeRenderer::init(VulkanApp* app) {
             VkVertexInputAttributeDescription{ ATTR_UV, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, texCoord) },
         },
         setLayouts,
-        nullptr,
+        app->getScenePushConstantRange(),
         cfg
     );
     
@@ -171,48 +169,10 @@ void DebugCubeRenderer::loadGridTexture(VulkanApp* app) {
     std::cout << "[DebugCubeRenderer] Loaded grid texture: " << texWidth << "x" << texHeight << std::endl;
 }
 
-void DebugCubeRenderer::createGridDescriptorSet(VulkanApp* app) {
-    DescriptorAllocator descAlloc{app->getDevice(), app};
-
-    VkDescriptorSetLayoutBinding samplerLayoutBinding{};
-    samplerLayoutBinding.binding = 1;
-    samplerLayoutBinding.descriptorCount = 1;
-    samplerLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    samplerLayoutBinding.pImmutableSamplers = nullptr;
-    samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    VkDescriptorSetLayoutBinding instanceBufferBinding{};
-    instanceBufferBinding.binding = 2;
-    instanceBufferBinding.descriptorCount = 1;
-    instanceBufferBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    instanceBufferBinding.pImmutableSamplers = nullptr;
-    instanceBufferBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-    VkDescriptorSetLayoutBinding bindings[] = { samplerLayoutBinding, instanceBufferBinding };
-
-    gridDescriptorSetLayout = descAlloc.createLayout(
-        bindings, 2,
-        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-        nullptr,
-        "DebugCubeRenderer: gridDescriptorSetLayout");
+void DebugCubeRenderer::createHeapSlots(VulkanApp* app) {
+    BindlessHeap& heap = app->getBindlessHeap();
+    gridTextureSlot = heap.registerImage(gridTextureView, gridTextureSampler);
 
-    VkDescriptorPoolSize poolSizes[] = {
-        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1}
-    };
-    gridDescriptorPool = descAlloc.createPool(
-        poolSizes, 2, 1,
-        VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-        "DebugCubeRenderer: gridDescriptorPool");
-
-    gridDescriptorSet = descAlloc.allocateSet(gridDescriptorPool, gridDescriptorSetLayout, "DebugCubeRenderer: gridDescriptorSet");
-    
-    DescriptorWriter(app->getDevice())
-        .writeImage(gridDescriptorSet, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                    gridTextureSampler, gridTextureView,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-        .flush();
-    
     // Create initial instance buffer (will be resized as needed)
     instanceBufferCapacity = 128;
     instanceBuffer = app->createBuffer(
@@ -220,11 +180,7 @@ void DebugCubeRenderer::createGridDescriptorSet(VulkanApp* app) {
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
     );
-    
-    DescriptorWriter(app->getDevice())
-        .writeBuffer(gridDescriptorSet, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                     instanceBuffer.buffer, 0, VK_WHOLE_SIZE)
-        .flush();
+    instanceBufferSlot = heap.registerBuffer(instanceBuffer.buffer);
 }
 
 void DebugCubeRenderer::updateInstanceBuffer(VulkanApp* app) {
@@ -243,11 +199,8 @@ void DebugCubeRenderer::updateInstanceBuffer(VulkanApp* app) {
             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
         );
-        
-        DescriptorWriter(app->getDevice())
-            .writeBuffer(gridDescriptorSet, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         instanceBuffer.buffer, 0, VK_WHOLE_SIZE)
-            .flush();
+        // The old slot stays valid for the frames still drawing with it.
+        instanceBufferSlot = app->getBindlessHeap().replaceBuffer(instanceBufferSlot, instanceBuffer.buffer);
     }
     
     // Upload instance data
@@ -290,11 +243,12 @@ void DebugCubeRenderer::render(VulkanApp* app, VkCommandBuffer& cmd, VkDescripto
     if (cmdState) cmdState->bindGraphicsPipeline(cmd, pipeline);
     else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
     
-    // Bind descriptor sets: set 0 = UBO, set 1 = grid texture + instance buffer
-    VkDescriptorSet descriptorSets[] = { descriptorSet, gridDescriptorSet };
-    if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, pipelineLayout, 0, 2, descriptorSets, 0, nullptr);
-    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 
-        0, 2, descriptorSets, 0, nullptr);
+    // Set 0 = UBO; the heap stays bound at set 1
+    if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+        0, 1, &descriptorSet, 0, nullptr);
+    const uint32_t slots[2] = { instanceBufferSlot, gridTextureSlot };
+    vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_ALL_GRAPHICS, 0, sizeof(slots), slots);
     
     // Bind cube VBO
     const VkBuffer vertexBuffers[] = { cubeVBO.vertexBuffer.buffer };
@@ -310,7 +264,12 @@ void DebugCubeRenderer::render(VulkanApp* app, VkCommandBuffer& cmd, VkDescripto
 }
 
 void DebugCubeRenderer::cleanup(VulkanApp* app) {
-    (void)app;
+    if (app) {
+        app->getBindlessHeap().releaseImage(gridTextureSlot);
+        app->getBindlessHeap().releaseBuffer(instanceBufferSlot);
+    }
+    gridTextureSlot = BindlessHeap::INVALID_INDEX;
+    instanceBufferSlot = BindlessHeap::INVALID_INDEX;
     cubeVBO.vertexBuffer.buffer = VK_NULL_HANDLE;
     cubeVBO.vertexBuffer.memory = VK_NULL_HANDLE;
     cubeVBO.indexBuffer.buffer = VK_NULL_HANDLE;
@@ -23,8 +23,10 @@ public:
     explicit DebugCubeRenderer();
     ~DebugCubeRenderer();
 
-    // Initialize pipeline and load grid texture
+    // Create the cube VBO, load the grid texture and register its heap slots
     void init(VulkanApp* app);
+    // Line pipeline (scene layouts)
+    void createPipeline(VulkanApp* app);
 
     // Set which cubes to render this frame
     void setCubes(const std::vector<CubeWithColor>& cubes);
@@ -62,19 +64,18 @@ private:
     VkDeviceMemory gridTextureMemory = VK_NULL_HANDLE;
     VkImageView gridTextureView = VK_NULL_HANDLE;
     TrackedHandle<VkSampler> gridTextureSampler;
-    TrackedHandle<VkDescriptorSet> gridDescriptorSet;
-    TrackedHandle<VkDescriptorSetLayout> gridDescriptorSetLayout;
-    TrackedHandle<VkDescriptorPool> gridDescriptorPool;
+    uint32_t gridTextureSlot = BindlessHeap::INVALID_INDEX;
     
     // Instance data buffer (model matrix + color per cube)
     Buffer instanceBuffer;
     uint32_t instanceBufferCapacity = 0;
+    uint32_t instanceBufferSlot = BindlessHeap::INVALID_INDEX;
     
     // Cubes to render this frame
     std::vector<CubeWithColor> activeCubes;
 private:
     void createCubeVBO(VulkanApp* app);
     void loadGridTexture(VulkanApp* app);
-    void createGridDescriptorSet(VulkanApp* app);
+    void createHeapSlots(VulkanApp* app);
     void updateInstanceBuffer(VulkanApp* app);
 };
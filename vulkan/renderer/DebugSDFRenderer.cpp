@@ -1,6 +1,4 @@
 #include "DebugSDFRenderer.hpp"
-#include "DescriptorAllocator.hpp"
-#include "DescriptorWriter.hpp"
 #include "../ShaderStage.hpp"
 #include "../../utils/FileReader.hpp"
 #include <glm/gtc/matrix_transform.hpp>
@@ -16,18 +14,18 @@ DebugSDFRenderer::~DebugSDFRenderer() { cleanup(nullptr); }
 
 void DebugSDFRenderer::init(VulkanApp* app) {
     createCubeBuffers(app);
-    createDescriptorSet(app);
+    createInstanceBuffer(app);
+}
 
+void DebugSDFRenderer::createPipeline(VulkanApp* app) {
     vertModule = app->getOrCreateShaderModule("shaders/debug_sdf.vert.spv");
     fragModule = app->getOrCreateShaderModule("shaders/debug_sdf.frag.spv");
 
     ShaderStage vertStage(vertModule, VK_SHADER_STAGE_VERTEX_BIT);
     ShaderStage fragStage(fragModule, VK_SHADER_STAGE_FRAGMENT_BIT);
 
-    std::vector<VkDescriptorSetLayout> setLayouts = {
-        app->getDescriptorSetLayout(),
-        descriptorSetLayout
-    };
+    // Scene layouts; the instance buffer slot comes through push constants
+    const std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
 
     GraphicsPipelineConfig cfg{};
     cfg.cullMode = VK_CULL_MODE_NONE;
@@ -42,7 +40,7 @@ void DebugSDFRenderer::init(VulkanApp* app) {
             VkVertexInputAttributeDescription{ATTR_COLOR, 0, VK_FORMAT_R32_UINT, offsetof(CubeVertex, cornerIndex)}
         },
         setLayouts,
-        nullptr,
+        app->getScenePushConstantRange(),
         cfg
     );
 
@@ -86,41 +84,14 @@ void DebugSDFRenderer::createCubeBuffers(VulkanApp* app) {
     indexCount = static_cast<uint32_t>(indices.size());
 }
 
-void DebugSDFRenderer::createDescriptorSet(VulkanApp* app) {
-    DescriptorAllocator descAlloc{app->getDevice(), app};
-
-    VkDescriptorSetLayoutBinding instanceBinding{};
-    instanceBinding.binding = 0;
-    instanceBinding.descriptorCount = 1;
-    instanceBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    instanceBinding.pImmutableSamplers = nullptr;
-    instanceBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-    descriptorSetLayout = descAlloc.createLayout(
-        &instanceBinding, 1,
-        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-        nullptr,
-        "DebugSDFRenderer: descriptorSetLayout");
-
-    VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1};
-    descriptorPool = descAlloc.createPool(
-        &poolSize, 1, 1,
-        VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-        "DebugSDFRenderer: descriptorPool");
-
-    descriptorSet = descAlloc.allocateSet(descriptorPool, descriptorSetLayout, "DebugSDFRenderer: descriptorSet");
-
+void DebugSDFRenderer::createInstanceBuffer(VulkanApp* app) {
     instanceBufferCapacity = 128;
     instanceBuffer = app->createBuffer(
         instanceBufferCapacity * (sizeof(glm::mat4) + sizeof(glm::vec4) * 3),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
     );
-
-    DescriptorWriter(app->getDevice())
-        .writeBuffer(descriptorSet, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                     instanceBuffer.buffer, 0, VK_WHOLE_SIZE)
-        .flush();
+    instanceBufferSlot = app->getBindlessHeap().registerBuffer(instanceBuffer.buffer);
 }
 
 void DebugSDFRenderer::updateInstanceBuffer(VulkanApp* app) {
@@ -141,11 +112,7 @@ void DebugSDFRenderer::updateInstanceBuffer(VulkanApp* app) {
             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
         );
-
-        DescriptorWriter(app->getDevice())
-            .writeBuffer(descriptorSet, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         instanceBuffer.buffer, 0, VK_WHOLE_SIZE)
-            .flush();
+        instanceBufferSlot = app->getBindlessHeap().replaceBuffer(instanceBufferSlot, instanceBuffer.buffer);
     }
 
     std::vector<InstanceData> instanceData;
@@ -193,10 +160,11 @@ void DebugSDFRenderer::render(VulkanApp* app, VkCommandBuffer& cmd, VkDescriptor
     if (cmdState) cmdState->bindGraphicsPipeline(cmd, pipeline);
     else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
-    VkDescriptorSet descriptorSets[] = {mainDescriptorSet, descriptorSet};
-    if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, pipelineLayout, 0, 2, descriptorSets, 0, nullptr);
+    if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, pipelineLayout, 0, 1, &mainDescriptorSet, 0, nullptr);
     else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
-        0, 2, descriptorSets, 0, nullptr);
+        0, 1, &mainDescriptorSet, 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_ALL_GRAPHICS, 0,
+                       sizeof(instanceBufferSlot), &instanceBufferSlot);
 
     const VkBuffer vertexBuffers[] = {vertexBuffer.buffer};
     const VkDeviceSize offsets[] = {0};
@@ -206,7 +174,8 @@ void DebugSDFRenderer::render(VulkanApp* app, VkCommandBuffer& cmd, VkDescriptor
 }
 
 void DebugSDFRenderer::cleanup(VulkanApp* app) {
-    (void)app;
+    if (app) app->getBindlessHeap().releaseBuffer(instanceBufferSlot);
+    instanceBufferSlot = BindlessHeap::INVALID_INDEX;
     vertexBuffer = {};
     indexBuffer = {};
     instanceBuffer = {};
@@ -258,10 +227,12 @@ void collectLeafSDFCubes(OctreeNode* node, const BoundingCube& cube, OctreeAlloc
     if (node->isLeaf()) {
         DebugSDFRenderer::CubeSDF debugCube{};
         debugCube.cube = cube;
+        float sdf[8];
+        node->getSDF(sdf);
         for (size_t i = 0; i < debugCube.sdf.size(); ++i) {
-            debugCube.sdf[i] = node->sdf[i];
+            debugCube.sdf[i] = sdf[i];
         }
-        debugCube.brushIndex = node->vertex.brushIndex;
+        debugCube.brushIndex = node->getBrush();
         if (hasDrawableSDFFace(debugCube.sdf)) {
             out.push_back(debugCube);
             return;  // Parent covers this subtree — children are redundant
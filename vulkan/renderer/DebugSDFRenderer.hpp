@@ -28,6 +28,8 @@ public:
     ~DebugSDFRenderer();
 
     void init(VulkanApp* app);
+    // Scene layouts; the instance buffer is a heap slot
+    void createPipeline(VulkanApp* app);
     void setCubes(const std::vector<CubeSDF>& cubes);
     void render(VulkanApp* app, VkCommandBuffer& cmd, VkDescriptorSet descriptorSet);
     void cleanup(VulkanApp* app) override;
@@ -59,15 +61,13 @@ private:
     Buffer indexBuffer;
     uint32_t indexCount = 0;
 
-    TrackedHandle<VkDescriptorSetLayout> descriptorSetLayout;
-    TrackedHandle<VkDescriptorPool> descriptorPool;
-    TrackedHandle<VkDescriptorSet> descriptorSet;
     Buffer instanceBuffer;
     uint32_t instanceBufferCapacity = 0;
+    uint32_t instanceBufferSlot = BindlessHeap::INVALID_INDEX;
 
     std::vector<CubeSDF> activeCubes;
 private:
     void createCubeBuffers(VulkanApp* app);
-    void createDescriptorSet(VulkanApp* app);
+    void createInstanceBuffer(VulkanApp* app);
     void updateInstanceBuffer(VulkanApp* app);
 };
@@ -5,6 +5,8 @@
 #include "../VulkanApp.hpp"
 #include "../../math/Vertex.hpp"
 #include "../../utils/FileReader.hpp"
+#include "../../utils/TextureCooker.hpp"
+#include "../../math/Math.hpp"
 #include <backends/imgui_impl_vulkan.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
@@ -12,41 +14,154 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cstdio>
+#include <fstream>
+#include <filesystem>
 #include "../includes/locations.hpp"
 #include "../includes/vertex_layouts.hpp"
 
-// ─────────────────────────────────────────── Fibonacci sphere ───────────────
+std::string ImpostorCapture::cacheDirectory = "cache/impostors";
+
+namespace {
+constexpr char     IMPOSTOR_CACHE_MAGIC[4] = { 'I', 'M', 'P', 'C' };
+constexpr uint32_t IMPOSTOR_CACHE_VERSION  = 1;
+
+struct ImpostorCacheHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t layout;
+    uint32_t viewCount;
+    uint32_t frameSize;
+    float    billboardScale;
+    uint64_t contentKey;
+};
+}
+
+// ─────────────────────────────────────────── View directions ────────────────
+
+glm::vec2 ImpostorCapture::octahedralEncode(const glm::vec3& dir) {
+    const glm::vec3 n = dir / (std::abs(dir.x) + std::abs(dir.y) + std::abs(dir.z));
+    glm::vec2 p(n.x, n.z);
+    if (n.y < 0.0f) {
+        // Fold the lower hemisphere over the diagonals
+        p = glm::vec2((1.0f - std::abs(n.z)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                      (1.0f - std::abs(n.x)) * (n.z >= 0.0f ? 1.0f : -1.0f));
+    }
+    return p * 0.5f + 0.5f;
+}
+
+glm::vec3 ImpostorCapture::octahedralDecode(const glm::vec2& uv) {
+    const glm::vec2 f = uv * 2.0f - 1.0f;
+    glm::vec3 n(f.x, 1.0f - std::abs(f.x) - std::abs(f.y), f.y);
+    const float t = std::max(-n.y, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.z += n.z >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
 
-void ImpostorCapture::generateFibonacciDirs() {
+void ImpostorCapture::generateViewDirs() {
+    viewDirs.assign(viewCount_, glm::vec3(0.0f, 1.0f, 0.0f));
+    if (layout_ == ViewLayout::Octahedral) {
+        // One frame per grid vertex so the shader can interpolate between
+        // the corners of the grid triangle that contains the view direction.
+        const float inv = 1.0f / float(grid_ - 1);
+        for (uint32_t y = 0; y < grid_; ++y)
+            for (uint32_t x = 0; x < grid_; ++x)
+                viewDirs[y * grid_ + x] = octahedralDecode(glm::vec2(float(x), float(y)) * inv);
+        return;
+    }
     // Golden angle in radians: π*(3 − √5)
     const float goldenAngle = glm::pi<float>() * (3.0f - std::sqrt(5.0f));
-    for (uint32_t i = 0; i < NUM_VIEWS; ++i) {
+    for (uint32_t i = 0; i < viewCount_; ++i) {
         // y sweeps from ~+1 (top) to ~−1 (bottom), offset by 0.5 for interior points
-        const float y     = 1.0f - (float(i) + 0.5f) / float(NUM_VIEWS) * 2.0f;
+        const float y     = 1.0f - (float(i) + 0.5f) / float(viewCount_) * 2.0f;
         const float r     = std::sqrt(std::max(0.0f, 1.0f - y * y));
         const float theta = goldenAngle * float(i);
         viewDirs[i] = glm::normalize(glm::vec3(std::cos(theta) * r, y, std::sin(theta) * r));
     }
 }
 
+void ImpostorCapture::writeViewMatrices(float billboardScale, uint32_t layerBase) {
+    const glm::vec3 center(0.0f, billboardScale * 0.5f, 0.0f);
+    const float captureDist = billboardScale * 2.5f;
+    const float nearP       = 0.5f;
+    const float farP        = captureDist * 2.0f + billboardScale;
+    const glm::vec4 lightDir   = glm::vec4(glm::normalize(glm::vec3(0.6f, -1.0f, 0.5f)), 0.0f);
+    const glm::vec4 lightColor = glm::vec4(1.0f, 0.97f, 0.88f, 1.0f);
+
+    for (uint32_t i = 0; i < viewCount_; ++i) {
+        const glm::vec3 dir = viewDirs[i];
+        const glm::vec3 eye = center + dir * captureDist;
+        glm::vec3 worldUp   = glm::vec3(0.0f, 1.0f, 0.0f);
+        if (std::abs(glm::dot(dir, worldUp)) > 0.99f)
+            worldUp = glm::vec3(0.0f, 0.0f, 1.0f);
+
+        const glm::mat4 view = glm::lookAt(eye, center, worldUp);
+        glm::mat4 proj = glm::perspective(glm::radians(60.0f), 1.0f, nearP, farP);
+        proj[1][1] *= -1.0f;
+
+        CaptureUBO ubo{};
+        ubo.viewProjection = proj * view;
+        ubo.viewPos        = glm::vec4(eye, 1.0f);
+        ubo.lightDir       = lightDir;
+        ubo.lightColor     = lightColor;
+        std::memcpy(static_cast<uint8_t*>(uboMapped) + i * uboStride, &ubo, sizeof(CaptureUBO));
+
+        // Store inverse VP for depth reprojection in the shadow pass.
+        captureInvVP[layerBase + i] = glm::inverse(proj * view);
+    }
+
+    // Upload updated inv VP data to the GPU buffer (persistently mapped).
+    std::memcpy(captureInvVPMapped, captureInvVP.data(), totalLayers() * sizeof(glm::mat4));
+}
+
 // ─────────────────────────────────────────── Public API ─────────────────────
 
-void ImpostorCapture::init(VulkanApp* app, VegetationRenderer* vegRenderer) {
+void ImpostorCapture::init(VulkanApp* app, VegetationRenderer* vegRenderer,
+                           ViewLayout layout, uint32_t octahedralGrid) {
     if (!app || initDone) return;
     if (!vegRenderer ||
-        vegRenderer->getWindParamsDescSetLayout() == VK_NULL_HANDLE ||
-        vegRenderer->getWindParamsDescSet() == VK_NULL_HANDLE) {
+        vegRenderer->getWindParamsSlot() == BindlessHeap::INVALID_INDEX) {
         fprintf(stderr, "[ImpostorCapture] init: vegetation renderer wind params not ready, capture disabled\n");
         return;
     }
     sharedVegRenderer = vegRenderer;
 
-    generateFibonacciDirs();
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(app->getPhysicalDevice(), &props);
+
+    layout_ = layout;
+    if (layout_ == ViewLayout::Octahedral) {
+        grid_ = std::clamp(octahedralGrid, MIN_OCTAHEDRAL_GRID, MAX_OCTAHEDRAL_GRID);
+        // Every type's grid² frames live in the same arrays: shrink the grid
+        // until they fit the device's layer limit (256 guaranteed, so 9).
+        while (grid_ > MIN_OCTAHEDRAL_GRID &&
+               NUM_BILLBOARD_TYPES * grid_ * grid_ > props.limits.maxImageArrayLayers) {
+            --grid_;
+        }
+        if (grid_ != std::clamp(octahedralGrid, MIN_OCTAHEDRAL_GRID, MAX_OCTAHEDRAL_GRID)) {
+            fprintf(stderr, "[ImpostorCapture] init: octahedral grid %u exceeds maxImageArrayLayers %u, using %u\n",
+                    octahedralGrid, props.limits.maxImageArrayLayers, grid_);
+        }
+        viewCount_ = grid_ * grid_;
+        frameSize_ = OCTAHEDRAL_ATLAS_SIZE / grid_;
+    } else {
+        grid_      = 0;
+        viewCount_ = NUM_VIEWS;
+        frameSize_ = TEX_SIZE;
+    }
+    const uint32_t layers = totalLayers();
+    captureLayerViews.assign(layers, VK_NULL_HANDLE);
+    captureNormalLayerViews.assign(layers, VK_NULL_HANDLE);
+    captureDepthLayerViews.assign(layers, VK_NULL_HANDLE);
+    imguiDescSets.assign(layers, VK_NULL_HANDLE);
+    imguiNormalDescSets.assign(layers, VK_NULL_HANDLE);
+    imguiDepthDescSets.assign(layers, VK_NULL_HANDLE);
+    captureInvVP.assign(layers, glm::mat4(1.0f));
+
+    generateViewDirs();
 
     // Determine per-view UBO stride aligned to hardware requirement.
     {
-        VkPhysicalDeviceProperties props{};
-        vkGetPhysicalDeviceProperties(app->getPhysicalDevice(), &props);
         const VkDeviceSize align = props.limits.minUniformBufferOffsetAlignment;
         uboStride = (sizeof(CaptureUBO) + align - 1) / align * align;
     }
@@ -60,26 +175,34 @@ void ImpostorCapture::init(VulkanApp* app, VegetationRenderer* vegRenderer) {
     createCaptureInvVPBuffer(app);
     createSceneSampler(app);
     allocateDescSets(app);
-    imguiDescSets.fill(VK_NULL_HANDLE);
     capturedTypes = 0;
 
-    // Pre-transition all 60 layers UNDEFINED → COLOR_ATTACHMENT_OPTIMAL
-    // so the render pass sees a writable layout before the first capture.
+    // Clear every layer (transparent albedo, far depth) and leave it shader
+    // readable: types are captured or restored one at a time, and the scene
+    // samples the whole array from the first frame.
     app->runSingleTimeCommands([&](VkCommandBuffer cb) {
-        app->recordTransitionImageLayoutLayer(cb, captureImage, VK_FORMAT_R8G8B8A8_UNORM,
-            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-            1, 0, TOTAL_LAYERS);
-        app->recordTransitionImageLayoutLayer(cb, captureNormalImage, VK_FORMAT_R8G8B8A8_UNORM,
-            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-            1, 0, TOTAL_LAYERS);
-        app->recordTransitionImageLayoutLayer(cb, captureDepthImage, VK_FORMAT_R32_SFLOAT,
-            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-            1, 0, TOTAL_LAYERS);
+        const VkImageSubresourceRange range{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, layers };
+        const VkClearColorValue transparent = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+        const VkClearColorValue flatNormal  = { { 0.5f, 0.5f, 1.0f, 0.0f } };
+        const VkClearColorValue farDepth    = { { 1.0f, 0.0f, 0.0f, 0.0f } };
+        const struct { VkImage image; VkFormat fmt; const VkClearColorValue* clear; } targets[3] = {
+            { captureImage,       VK_FORMAT_R8G8B8A8_UNORM, &transparent },
+            { captureNormalImage, VK_FORMAT_R8G8B8A8_UNORM, &flatNormal  },
+            { captureDepthImage,  VK_FORMAT_R32_SFLOAT,     &farDepth    },
+        };
+        for (const auto& t : targets) {
+            app->recordTransitionImageLayoutLayer(cb, t.image, t.fmt,
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, 0, layers);
+            vkCmdClearColorImage(cb, t.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, t.clear, 1, &range);
+            app->recordTransitionImageLayoutLayer(cb, t.image, t.fmt,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 0, layers);
+        }
     });
 
     initDone = true;
-    fprintf(stderr, "[ImpostorCapture] init complete: %u billboard types × %u views = %u layers @ %ux%u\n",
-            NUM_BILLBOARD_TYPES, NUM_VIEWS, TOTAL_LAYERS, TEX_SIZE, TEX_SIZE);
+    fprintf(stderr, "[ImpostorCapture] init complete (%s): %u billboard types × %u views = %u layers @ %ux%u\n",
+            layout_ == ViewLayout::Octahedral ? "octahedral" : "fibonacci",
+            NUM_BILLBOARD_TYPES, viewCount_, layers, frameSize_, frameSize_);
 }
 
 void ImpostorCapture::cleanup(VulkanApp* app) {
@@ -91,71 +214,85 @@ void ImpostorCapture::cleanup(VulkanApp* app) {
     if (imguiSampler != VK_NULL_HANDLE) {
         app->resources.removeSampler(imguiSampler);
         vkDestroySampler(device, imguiSampler, nullptr);
+        imguiSampler = VK_NULL_HANDLE;
     }
 
     if (descriptorPool != VK_NULL_HANDLE) {
         app->resources.removeDescriptorPool(descriptorPool);
         vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+        descriptorPool = VK_NULL_HANDLE;
+        uboDescSet = VK_NULL_HANDLE;
     }
 
+    // Buffers are sized by the view layout, so they go with it (init() may
+    // run again with a different layout).
     uboMapped = nullptr;
-
     captureInstMapped = nullptr;
+    captureInvVPMapped = nullptr;
+    app->destroyBuffer(uboBuffer);
+    app->destroyBuffer(captureVertBuf);
+    app->destroyBuffer(captureInstBuf);
+    app->destroyBuffer(captureIdxBuf);
+    app->destroyBuffer(captureInvVPBuffer);
 
     if (capturePipeline != VK_NULL_HANDLE) {
         app->resources.removePipeline(capturePipeline);
         vkDestroyPipeline(device, capturePipeline, nullptr);
+        capturePipeline = VK_NULL_HANDLE;
     }
     if (capturePipelineLayout != VK_NULL_HANDLE) {
         app->resources.removePipelineLayout(capturePipelineLayout);
         vkDestroyPipelineLayout(device, capturePipelineLayout, nullptr);
+        capturePipelineLayout = VK_NULL_HANDLE;
     }
 
     if (uboDescSetLayout != VK_NULL_HANDLE) {
         app->resources.removeDescriptorSetLayout(uboDescSetLayout);
         vkDestroyDescriptorSetLayout(device, uboDescSetLayout, nullptr);
-    }
-    if (texDescSetLayout != VK_NULL_HANDLE) {
-        app->resources.removeDescriptorSetLayout(texDescSetLayout);
-        vkDestroyDescriptorSetLayout(device, texDescSetLayout, nullptr);
+        uboDescSetLayout = VK_NULL_HANDLE;
     }
 
-    if (depthView   != VK_NULL_HANDLE) { app->resources.removeImageView(depthView);   vkDestroyImageView(device, depthView, nullptr); }
-    if (depthImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(depthImage, depthAllocation, depthMemory); }
+    if (depthView   != VK_NULL_HANDLE) { app->resources.removeImageView(depthView);   vkDestroyImageView(device, depthView, nullptr); depthView = VK_NULL_HANDLE; }
+    if (depthImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(depthImage, depthAllocation, depthMemory); depthImage = VK_NULL_HANDLE; }
 
     if (sceneSampler != VK_NULL_HANDLE) {
         app->resources.removeSampler(sceneSampler);
         vkDestroySampler(device, sceneSampler, nullptr);
+        sceneSampler = VK_NULL_HANDLE;
     }
 
     for (auto& v : captureLayerViews) {
         if (v != VK_NULL_HANDLE) { app->resources.removeImageView(v); vkDestroyImageView(device, v, nullptr); }
     }
+    captureLayerViews.clear();
     if (captureArrayView != VK_NULL_HANDLE) {
         app->resources.removeImageView(captureArrayView);
         vkDestroyImageView(device, captureArrayView, nullptr);
+        captureArrayView = VK_NULL_HANDLE;
     }
-    if (captureImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(captureImage, captureAllocation, captureMemory); }
+    if (captureImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(captureImage, captureAllocation, captureMemory); captureImage = VK_NULL_HANDLE; }
 
     for (auto& v : captureNormalLayerViews) {
         if (v != VK_NULL_HANDLE) { app->resources.removeImageView(v); vkDestroyImageView(device, v, nullptr); }
     }
+    captureNormalLayerViews.clear();
     if (captureNormalArrayView != VK_NULL_HANDLE) {
         app->resources.removeImageView(captureNormalArrayView);
         vkDestroyImageView(device, captureNormalArrayView, nullptr);
+        captureNormalArrayView = VK_NULL_HANDLE;
     }
-    if (captureNormalImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(captureNormalImage, captureNormalAllocation, captureNormalMemory); }
+    if (captureNormalImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(captureNormalImage, captureNormalAllocation, captureNormalMemory); captureNormalImage = VK_NULL_HANDLE; }
 
     for (auto& v : captureDepthLayerViews) {
         if (v != VK_NULL_HANDLE) { app->resources.removeImageView(v); vkDestroyImageView(device, v, nullptr); }
     }
+    captureDepthLayerViews.clear();
     if (captureDepthArrayView != VK_NULL_HANDLE) {
         app->resources.removeImageView(captureDepthArrayView);
         vkDestroyImageView(device, captureDepthArrayView, nullptr);
+        captureDepthArrayView = VK_NULL_HANDLE;
     }
-    if (captureDepthImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(captureDepthImage, captureDepthAllocation, captureDepthMemory); }
-
-    captureInvVPMapped = nullptr;
+    if (captureDepthImage  != VK_NULL_HANDLE) { app->destroyImageWithVma(captureDepthImage, captureDepthAllocation, captureDepthMemory); captureDepthImage = VK_NULL_HANDLE; }
 
     capturedTypes = 0;
     initDone = false;
@@ -177,58 +314,34 @@ void ImpostorCapture::capture(VulkanApp* app,
     }
 
     // Layer range for this billboard type.
-    const uint32_t layerBase = billboardType * NUM_VIEWS;
+    const uint32_t layerBase = billboardType * viewCount_;
 
     // Remove old descriptor sets for this type before overwriting images.
-    for (uint32_t v = 0; v < NUM_VIEWS; ++v) {
-        VkDescriptorSet ds = imguiDescSets[layerBase + v];
-        if (ds != VK_NULL_HANDLE) { ImGui_ImplVulkan_RemoveTexture(ds); imguiDescSets[layerBase + v] = VK_NULL_HANDLE; }
-        VkDescriptorSet dsN = imguiNormalDescSets[layerBase + v];
-        if (dsN != VK_NULL_HANDLE) { ImGui_ImplVulkan_RemoveTexture(dsN); imguiNormalDescSets[layerBase + v] = VK_NULL_HANDLE; }
+    removeImGuiDescSetsForType(billboardType);
+
+    // Billboard arrays go into the bindless heap for the duration of the
+    // capture (released below, once the single-time submit has completed).
+    BindlessHeap& heap = app->getBindlessHeap();
+    const uint32_t albedoSlot  = heap.registerImage(albedoView, sampler);
+    const uint32_t normalSlot  = heap.registerImage(normalView, sampler);
+    const uint32_t opacitySlot = heap.registerImage(opacityView, sampler);
+    if (albedoSlot == BindlessHeap::INVALID_INDEX || normalSlot == BindlessHeap::INVALID_INDEX ||
+        opacitySlot == BindlessHeap::INVALID_INDEX) {
+        fprintf(stderr, "[ImpostorCapture] capture: no bindless heap slots for billboard arrays\n");
+        heap.releaseImage(albedoSlot);
+        heap.releaseImage(normalSlot);
+        heap.releaseImage(opacitySlot);
+        return;
     }
 
-    // Update the texture descriptor set with current billboard arrays.
-    updateTexDescSet(app->getDevice(), albedoView, normalView, opacityView, sampler);
-
     // Single centred instance at the origin with the correct billboard type.
     {
         const glm::vec4 inst(0.0f, 0.0f, 0.0f, float(billboardType));
         std::memcpy(captureInstMapped, &inst, sizeof(inst));
     }
 
-    // Pre-compute all 20 UBOs.
-    const glm::vec3 center(0.0f, billboardScale * 0.5f, 0.0f);
-    const float captureDist = billboardScale * 2.5f;
-    const float nearP       = 0.5f;
-    const float farP        = captureDist * 2.0f + billboardScale;
-    const glm::vec4 lightDir   = glm::vec4(glm::normalize(glm::vec3(0.6f, -1.0f, 0.5f)), 0.0f);
-    const glm::vec4 lightColor = glm::vec4(1.0f, 0.97f, 0.88f, 1.0f);
-
-    for (uint32_t i = 0; i < NUM_VIEWS; ++i) {
-        const glm::vec3 dir = viewDirs[i];
-        const glm::vec3 eye = center + dir * captureDist;
-        glm::vec3 worldUp   = glm::vec3(0.0f, 1.0f, 0.0f);
-        if (std::abs(glm::dot(dir, worldUp)) > 0.99f)
-            worldUp = glm::vec3(0.0f, 0.0f, 1.0f);
-
-        const glm::mat4 view = glm::lookAt(eye, center, worldUp);
-        glm::mat4 proj = glm::perspective(glm::radians(60.0f), 1.0f, nearP, farP);
-        proj[1][1] *= -1.0f;
-
-        CaptureUBO ubo{};
-        ubo.viewProjection = proj * view;
-        ubo.viewPos        = glm::vec4(eye, 1.0f);
-        ubo.lightDir       = lightDir;
-        ubo.lightColor     = lightColor;
-        std::memcpy(static_cast<uint8_t*>(uboMapped) + i * uboStride, &ubo, sizeof(CaptureUBO));
-
-        // Store inverse VP for depth reprojection in the shadow pass.
-        const uint32_t layerIdx = layerBase + i;
-        captureInvVP[layerIdx] = glm::inverse(proj * view);
-    }
-
-    // Upload updated inv VP data to the GPU buffer (persistently mapped).
-    std::memcpy(captureInvVPMapped, captureInvVP.data(), TOTAL_LAYERS * sizeof(glm::mat4));
+    // Pre-compute the per-view UBOs and inverse VP matrices.
+    writeViewMatrices(billboardScale, layerBase);
 
     // Push constant: no wind, density culling disabled, impostorDistance=0.
     CapturePC pc{};
@@ -236,12 +349,16 @@ void ImpostorCapture::capture(VulkanApp* app,
     pc.windEnabled        = 0.0f;
     pc.windTime           = 0.0f;
     pc.impostorDistance   = 0.0f;
+    pc.windParamsBuffer   = sharedVegRenderer->getWindParamsSlot();
+    pc.albedoTexture      = albedoSlot;
+    pc.normalTexture      = normalSlot;
+    pc.opacityTexture     = opacitySlot;
 
     app->runSingleTimeCommands([&](VkCommandBuffer cb) {
-        VkBuffer     vbs[2]     = { captureVertBuf, captureInstBuf };
+        VkBuffer     vbs[2]     = { captureVertBuf.buffer, captureInstBuf.buffer };
         VkDeviceSize offsets[2] = { 0, 0 };
 
-        for (uint32_t viewIdx = 0; viewIdx < NUM_VIEWS; ++viewIdx) {
+        for (uint32_t viewIdx = 0; viewIdx < viewCount_; ++viewIdx) {
             const uint32_t layerIdx = layerBase + viewIdx;
 
             // Transition color layers to COLOR_ATTACHMENT_OPTIMAL
@@ -286,22 +403,22 @@ void ImpostorCapture::capture(VulkanApp* app,
             VkRenderingInfo renderingInfo{};
             renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
             renderingInfo.renderArea.offset = {0, 0};
-            renderingInfo.renderArea.extent = {TEX_SIZE, TEX_SIZE};
+            renderingInfo.renderArea.extent = {frameSize_, frameSize_};
             renderingInfo.layerCount = 1;
             renderingInfo.colorAttachmentCount = 3;
             renderingInfo.pColorAttachments = colorAtts;
             renderingInfo.pDepthAttachment = &depthAtt;
 
             // Defensive: ensure descriptor sets are allocated before starting render
-            if (uboDescSet == VK_NULL_HANDLE || texDescSet == VK_NULL_HANDLE) {
+            if (uboDescSet == VK_NULL_HANDLE) {
                 std::cerr << "[ImpostorCapture] descriptor sets not ready, skipping capture for this view." << std::endl;
                 continue;
             }
 
             vkCmdBeginRendering(cb, &renderingInfo);
 
-            VkViewport vp{ 0.0f, 0.0f, float(TEX_SIZE), float(TEX_SIZE), 0.0f, 1.0f };
-            VkRect2D   sci{ { 0, 0 }, { TEX_SIZE, TEX_SIZE } };
+            VkViewport vp{ 0.0f, 0.0f, float(frameSize_), float(frameSize_), 0.0f, 1.0f };
+            VkRect2D   sci{ { 0, 0 }, { frameSize_, frameSize_ } };
             vkCmdSetViewport(cb, 0, 1, &vp);
             vkCmdSetScissor(cb, 0, 1, &sci);
 
@@ -309,18 +426,18 @@ void ImpostorCapture::capture(VulkanApp* app,
             else vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, capturePipeline);
 
             const uint32_t dynOffset = static_cast<uint32_t>(viewIdx * uboStride);
-            VkDescriptorSet sets[3] = { uboDescSet, texDescSet, sharedVegRenderer->getWindParamsDescSet() };
+            VkDescriptorSet sets[2] = { uboDescSet, heap.getSet() };
             if (cmdState) cmdState->bindGraphicsDescriptorSets(cb,
-                                    capturePipelineLayout, 0, 3, sets, 1, &dynOffset);
+                                    capturePipelineLayout, 0, 2, sets, 1, &dynOffset);
             else vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                    capturePipelineLayout, 0, 3, sets, 1, &dynOffset);
+                                    capturePipelineLayout, 0, 2, sets, 1, &dynOffset);
 
             vkCmdPushConstants(cb, capturePipelineLayout,
                                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
                                0, sizeof(CapturePC), &pc);
 
             vkCmdBindVertexBuffers(cb, 0, 2, vbs, offsets);
-            vkCmdBindIndexBuffer(cb, captureIdxBuf, 0, VK_INDEX_TYPE_UINT32);
+            vkCmdBindIndexBuffer(cb, captureIdxBuf.buffer, 0, VK_INDEX_TYPE_UINT32);
             vkCmdDrawIndexed(cb, captureIdxCount, NUM_INSTANCES, 0, 0, 0);
 
             vkCmdEndRendering(cb);
@@ -334,12 +451,15 @@ void ImpostorCapture::capture(VulkanApp* app,
                 VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, layerIdx, 1);
         }
     });
+    heap.releaseImage(albedoSlot);
+    heap.releaseImage(normalSlot);
+    heap.releaseImage(opacitySlot);
 
     createImGuiDescSetsForType(app, billboardType);
     capturedTypes |= (1u << billboardType);
     fprintf(stderr,
             "[ImpostorCapture] Captured billboard type %u | %u views | scale=%.1f | layers %u-%u\n",
-            billboardType, NUM_VIEWS, billboardScale, layerBase, layerBase + NUM_VIEWS - 1);
+            billboardType, viewCount_, billboardScale, layerBase, layerBase + viewCount_ - 1);
 }
 
 void ImpostorCapture::captureAll(VulkanApp* app,
@@ -350,34 +470,161 @@ void ImpostorCapture::captureAll(VulkanApp* app,
         capture(app, albedoView, normalView, opacityView, sampler, billboardScale, t);
     }
     fprintf(stderr, "[ImpostorCapture] captureAll complete: %u types × %u views = %u layers\n",
-            NUM_BILLBOARD_TYPES, NUM_VIEWS, TOTAL_LAYERS);
+            NUM_BILLBOARD_TYPES, viewCount_, totalLayers());
 }
 
 VkDescriptorSet ImpostorCapture::getImGuiDescSet(uint32_t billboardType, uint32_t viewIdx) const {
-    if (billboardType >= NUM_BILLBOARD_TYPES || viewIdx >= NUM_VIEWS) return VK_NULL_HANDLE;
-    return imguiDescSets[billboardType * NUM_VIEWS + viewIdx];
+    if (billboardType >= NUM_BILLBOARD_TYPES || viewIdx >= viewCount_) return VK_NULL_HANDLE;
+    return imguiDescSets[billboardType * viewCount_ + viewIdx];
 }
 
 VkDescriptorSet ImpostorCapture::getImGuiNormalDescSet(uint32_t billboardType, uint32_t viewIdx) const {
-    if (billboardType >= NUM_BILLBOARD_TYPES || viewIdx >= NUM_VIEWS) return VK_NULL_HANDLE;
-    return imguiNormalDescSets[billboardType * NUM_VIEWS + viewIdx];
+    if (billboardType >= NUM_BILLBOARD_TYPES || viewIdx >= viewCount_) return VK_NULL_HANDLE;
+    return imguiNormalDescSets[billboardType * viewCount_ + viewIdx];
 }
 
 VkDescriptorSet ImpostorCapture::getImGuiDepthDescSet(uint32_t billboardType, uint32_t viewIdx) const {
-    if (billboardType >= NUM_BILLBOARD_TYPES || viewIdx >= NUM_VIEWS) return VK_NULL_HANDLE;
-    return imguiDepthDescSets[billboardType * NUM_VIEWS + viewIdx];
+    if (billboardType >= NUM_BILLBOARD_TYPES || viewIdx >= viewCount_) return VK_NULL_HANDLE;
+    return imguiDepthDescSets[billboardType * viewCount_ + viewIdx];
 }
 
 uint32_t ImpostorCapture::closestView(const glm::vec3& dir) const {
     float    best = -2.0f;
     uint32_t idx  = 0;
-    for (uint32_t i = 0; i < NUM_VIEWS; ++i) {
+    for (uint32_t i = 0; i < viewCount_; ++i) {
         const float d = glm::dot(dir, viewDirs[i]);
         if (d > best) { best = d; idx = i; }
     }
     return idx;
 }
 
+// ─────────────────────────────────────────── Disk cache ─────────────────────
+
+std::string ImpostorCapture::cachePath(uint64_t contentKey, float billboardScale) const {
+    const uint32_t key[4] = {
+        static_cast<uint32_t>(layout_), viewCount_, frameSize_, IMPOSTOR_CACHE_VERSION
+    };
+    uint64_t h = TextureCooker::hashBytes(key, sizeof(key), contentKey);
+    h = TextureCooker::hashBytes(&billboardScale, sizeof(billboardScale), h);
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+    return cacheDirectory + "/" + hex + ".imp";
+}
+
+bool ImpostorCapture::storeCached(VulkanApp* app, uint32_t billboardType, uint64_t contentKey, float billboardScale) {
+    if (!initDone || !app || billboardType >= NUM_BILLBOARD_TYPES || !isCaptured(billboardType)) return false;
+
+    const uint32_t layerBase = billboardType * viewCount_;
+    const VkDeviceSize planeBytes = VkDeviceSize(frameSize_) * frameSize_ * 4 * viewCount_;
+    Buffer readback = app->createBuffer(planeBytes * 3, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false);
+
+    // Layout in the buffer (and the file): all albedo views, all normal
+    // views, all depth views — one tightly packed layer after another.
+    app->runSingleTimeCommands([&](VkCommandBuffer cb) {
+        const struct { VkImage image; VkFormat fmt; } planes[3] = {
+            { captureImage, VK_FORMAT_R8G8B8A8_UNORM },
+            { captureNormalImage, VK_FORMAT_R8G8B8A8_UNORM },
+            { captureDepthImage, VK_FORMAT_R32_SFLOAT },
+        };
+        for (uint32_t p = 0; p < 3; ++p) {
+            app->recordTransitionImageLayoutLayer(cb, planes[p].image, planes[p].fmt,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 1, layerBase, viewCount_);
+            VkBufferImageCopy region{};
+            region.bufferOffset = planeBytes * p;
+            region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, layerBase, viewCount_ };
+            region.imageExtent = { frameSize_, frameSize_, 1 };
+            vkCmdCopyImageToBuffer(cb, planes[p].image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback.buffer, 1, &region);
+            app->recordTransitionImageLayoutLayer(cb, planes[p].image, planes[p].fmt,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, layerBase, viewCount_);
+        }
+    });
+
+    ImpostorCacheHeader header{};
+    std::memcpy(header.magic, IMPOSTOR_CACHE_MAGIC, sizeof(header.magic));
+    header.version        = IMPOSTOR_CACHE_VERSION;
+    header.layout         = static_cast<uint32_t>(layout_);
+    header.viewCount      = viewCount_;
+    header.frameSize      = frameSize_;
+    header.billboardScale = billboardScale;
+    header.contentKey     = contentKey;
+
+    bool ok = false;
+    try {
+        ensureFolderExists(cacheDirectory);
+        // Write to a temporary file and rename so a crash never leaves a truncated entry
+        const std::string path = cachePath(contentKey, billboardScale);
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(static_cast<const char*>(readback.map()), static_cast<std::streamsize>(planeBytes * 3));
+            ok = static_cast<bool>(out);
+        }
+        if (ok) std::filesystem::rename(tmp, path);
+        else std::filesystem::remove(tmp);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[ImpostorCapture] storeCached: %s\n", e.what());
+        ok = false;
+    }
+    app->destroyBuffer(readback);
+    return ok;
+}
+
+bool ImpostorCapture::loadCached(VulkanApp* app, uint32_t billboardType, uint64_t contentKey, float billboardScale) {
+    if (!initDone || !app || billboardType >= NUM_BILLBOARD_TYPES) return false;
+
+    std::ifstream in(cachePath(contentKey, billboardScale), std::ios::binary);
+    if (!in) return false;
+    ImpostorCacheHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, IMPOSTOR_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != IMPOSTOR_CACHE_VERSION || header.layout != static_cast<uint32_t>(layout_) ||
+        header.viewCount != viewCount_ || header.frameSize != frameSize_ ||
+        header.billboardScale != billboardScale || header.contentKey != contentKey) {
+        return false;
+    }
+
+    const uint32_t layerBase = billboardType * viewCount_;
+    const VkDeviceSize planeBytes = VkDeviceSize(frameSize_) * frameSize_ * 4 * viewCount_;
+    Buffer staging = app->createBuffer(planeBytes * 3, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false);
+    in.read(static_cast<char*>(staging.map()), static_cast<std::streamsize>(planeBytes * 3));
+    if (!in) {
+        app->destroyBuffer(staging);
+        return false;
+    }
+
+    removeImGuiDescSetsForType(billboardType);
+    app->runSingleTimeCommands([&](VkCommandBuffer cb) {
+        const struct { VkImage image; VkFormat fmt; } planes[3] = {
+            { captureImage, VK_FORMAT_R8G8B8A8_UNORM },
+            { captureNormalImage, VK_FORMAT_R8G8B8A8_UNORM },
+            { captureDepthImage, VK_FORMAT_R32_SFLOAT },
+        };
+        for (uint32_t p = 0; p < 3; ++p) {
+            app->recordTransitionImageLayoutLayer(cb, planes[p].image, planes[p].fmt,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, layerBase, viewCount_);
+            VkBufferImageCopy region{};
+            region.bufferOffset = planeBytes * p;
+            region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, layerBase, viewCount_ };
+            region.imageExtent = { frameSize_, frameSize_, 1 };
+            vkCmdCopyBufferToImage(cb, staging.buffer, planes[p].image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+            app->recordTransitionImageLayoutLayer(cb, planes[p].image, planes[p].fmt,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, layerBase, viewCount_);
+        }
+    });
+    app->destroyBuffer(staging);
+
+    // The shadow pass reprojects with the capture matrices, so restore them too
+    writeViewMatrices(billboardScale, layerBase);
+    createImGuiDescSetsForType(app, billboardType);
+    capturedTypes |= (1u << billboardType);
+    fprintf(stderr, "[ImpostorCapture] Restored billboard type %u from cache | %u views @ %ux%u\n",
+            billboardType, viewCount_, frameSize_, frameSize_);
+    return true;
+}
+
 // ─────────────────────────────────────────── Private helpers ────────────────
 
 void ImpostorCapture::createCaptureImages(VulkanApp* app) {
@@ -390,12 +637,14 @@ void ImpostorCapture::createCaptureImages(VulkanApp* app) {
         imgInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imgInfo.imageType     = VK_IMAGE_TYPE_2D;
         imgInfo.format        = fmt;
-        imgInfo.extent        = { TEX_SIZE, TEX_SIZE, 1 };
+        imgInfo.extent        = { frameSize_, frameSize_, 1 };
         imgInfo.mipLevels     = 1;
-        imgInfo.arrayLayers   = TOTAL_LAYERS;
+        imgInfo.arrayLayers   = totalLayers();
         imgInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
         imgInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
-        imgInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        // Transfer usage: init() clears the layers, the disk cache copies them
+        imgInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+                              | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         app->createImageWithVma(imgInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, captureImage, captureAllocation, captureMemory, "ImpostorCapture: captureImage");
     }
@@ -407,14 +656,14 @@ void ImpostorCapture::createCaptureImages(VulkanApp* app) {
         v.image            = captureImage;
         v.viewType         = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
         v.format           = fmt;
-        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, TOTAL_LAYERS };
+        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, totalLayers() };
         if (vkCreateImageView(device, &v, nullptr, &captureArrayView) != VK_SUCCESS)
             throw std::runtime_error("ImpostorCapture: captureArrayView failed");
         app->resources.addImageView(captureArrayView, "ImpostorCapture: captureArrayView");
     }
 
     // Per-layer views (VK_IMAGE_VIEW_TYPE_2D, used as framebuffer attachments).
-    for (uint32_t i = 0; i < TOTAL_LAYERS; ++i) {
+    for (uint32_t i = 0; i < totalLayers(); ++i) {
         VkImageViewCreateInfo v{};
         v.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         v.image            = captureImage;
@@ -432,12 +681,14 @@ void ImpostorCapture::createCaptureImages(VulkanApp* app) {
         imgInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imgInfo.imageType     = VK_IMAGE_TYPE_2D;
         imgInfo.format        = fmt;
-        imgInfo.extent        = { TEX_SIZE, TEX_SIZE, 1 };
+        imgInfo.extent        = { frameSize_, frameSize_, 1 };
         imgInfo.mipLevels     = 1;
-        imgInfo.arrayLayers   = TOTAL_LAYERS;
+        imgInfo.arrayLayers   = totalLayers();
         imgInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
         imgInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
-        imgInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        // Transfer usage: init() clears the layers, the disk cache copies them
+        imgInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+                              | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         app->createImageWithVma(imgInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, captureNormalImage, captureNormalAllocation, captureNormalMemory, "ImpostorCapture: captureNormalImage");
     }
@@ -449,14 +700,14 @@ void ImpostorCapture::createCaptureImages(VulkanApp* app) {
         v.image            = captureNormalImage;
         v.viewType         = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
         v.format           = fmt;
-        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, TOTAL_LAYERS };
+        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, totalLayers() };
         if (vkCreateImageView(device, &v, nullptr, &captureNormalArrayView) != VK_SUCCESS)
             throw std::runtime_error("ImpostorCapture: captureNormalArrayView failed");
         app->resources.addImageView(captureNormalArrayView, "ImpostorCapture: captureNormalArrayView");
     }
 
     // Per-layer normal views.
-    for (uint32_t i = 0; i < TOTAL_LAYERS; ++i) {
+    for (uint32_t i = 0; i < totalLayers(); ++i) {
         VkImageViewCreateInfo v{};
         v.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         v.image            = captureNormalImage;
@@ -468,19 +719,21 @@ void ImpostorCapture::createCaptureImages(VulkanApp* app) {
         app->resources.addImageView(captureNormalLayerViews[i], "ImpostorCapture: captureNormalLayerView");
     }
 
-    // ── Depth capture image (device Z, R32_SFLOAT, 60 layers) ──
+    // ── Depth capture image (device Z, R32_SFLOAT, one layer per view) ──
     {
         const VkFormat depthFmt = VK_FORMAT_R32_SFLOAT;
         VkImageCreateInfo imgInfo{};
         imgInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imgInfo.imageType     = VK_IMAGE_TYPE_2D;
         imgInfo.format        = depthFmt;
-        imgInfo.extent        = { TEX_SIZE, TEX_SIZE, 1 };
+        imgInfo.extent        = { frameSize_, frameSize_, 1 };
         imgInfo.mipLevels     = 1;
-        imgInfo.arrayLayers   = TOTAL_LAYERS;
+        imgInfo.arrayLayers   = totalLayers();
         imgInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
         imgInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
-        imgInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        // Transfer usage: init() clears the layers, the disk cache copies them
+        imgInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+                              | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         app->createImageWithVma(imgInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, captureDepthImage, captureDepthAllocation, captureDepthMemory, "ImpostorCapture: captureDepthImage");
     }
@@ -492,14 +745,14 @@ void ImpostorCapture::createCaptureImages(VulkanApp* app) {
         v.image            = captureDepthImage;
         v.viewType         = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
         v.format           = VK_FORMAT_R32_SFLOAT;
-        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, TOTAL_LAYERS };
+        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, totalLayers() };
         if (vkCreateImageView(device, &v, nullptr, &captureDepthArrayView) != VK_SUCCESS)
             throw std::runtime_error("ImpostorCapture: captureDepthArrayView failed");
         app->resources.addImageView(captureDepthArrayView, "ImpostorCapture: captureDepthArrayView");
     }
 
     // Per-layer depth views (VK_IMAGE_VIEW_TYPE_2D).
-    for (uint32_t i = 0; i < TOTAL_LAYERS; ++i) {
+    for (uint32_t i = 0; i < totalLayers(); ++i) {
         VkImageViewCreateInfo v{};
         v.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         v.image            = captureDepthImage;
@@ -520,7 +773,7 @@ void ImpostorCapture::createDepth(VulkanApp* app) {
     imgInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imgInfo.imageType     = VK_IMAGE_TYPE_2D;
     imgInfo.format        = fmt;
-    imgInfo.extent        = { TEX_SIZE, TEX_SIZE, 1 };
+    imgInfo.extent        = { frameSize_, frameSize_, 1 };
     imgInfo.mipLevels     = 1;
     imgInfo.arrayLayers   = 1;
     imgInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
@@ -559,22 +812,7 @@ void ImpostorCapture::createDescSetLayouts(VulkanApp* app) {
             nullptr,
             "ImpostorCapture: uboDescSetLayout");
     }
-
-    // Set 1: three combined image samplers (albedo, normal, opacity arrays).
-    {
-        VkDescriptorSetLayoutBinding bindings[3]{};
-        for (uint32_t i = 0; i < 3; ++i) {
-            bindings[i].binding         = i;
-            bindings[i].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            bindings[i].descriptorCount = 1;
-            bindings[i].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-        }
-        texDescSetLayout = descAlloc.createLayout(
-            bindings, 3,
-            VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-            nullptr,
-            "ImpostorCapture: texDescSetLayout");
-    }
+    // Set 1 is the bindless heap (billboard arrays, wind params).
 }
 
 void ImpostorCapture::createPipeline(VulkanApp* app) {
@@ -662,10 +900,10 @@ void ImpostorCapture::createPipeline(VulkanApp* app) {
     pcRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
     pcRange.size       = sizeof(CapturePC);
 
-    VkDescriptorSetLayout layouts[3] = { uboDescSetLayout, texDescSetLayout, sharedVegRenderer->getWindParamsDescSetLayout() };
+    VkDescriptorSetLayout layouts[2] = { uboDescSetLayout, app->getBindlessHeap().getLayout() };
     VkPipelineLayoutCreateInfo layoutInfo{};
     layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    layoutInfo.setLayoutCount         = 3;
+    layoutInfo.setLayoutCount         = 2;
     layoutInfo.pSetLayouts            = layouts;
     layoutInfo.pushConstantRangeCount = 1;
     layoutInfo.pPushConstantRanges    = &pcRange;
@@ -706,14 +944,12 @@ void ImpostorCapture::createPipeline(VulkanApp* app) {
 }
 
 void ImpostorCapture::createUBO(VulkanApp* app) {
-    const VkDeviceSize totalSize = NUM_VIEWS * uboStride;
+    const VkDeviceSize totalSize = viewCount_ * uboStride;
     // createBuffer registers buffer and memory in resources internally.
-    Buffer buf = app->createBuffer(totalSize,
+    uboBuffer = app->createBuffer(totalSize,
         VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    uboBuffer = buf.buffer;
-    uboMapped = buf.mappedData;
-    uboMemory = buf.memory;
+    uboMapped = uboBuffer.mappedData;
 }
 
 void ImpostorCapture::createCaptureBuffers(VulkanApp* app) {
@@ -744,10 +980,8 @@ void ImpostorCapture::createCaptureBuffers(VulkanApp* app) {
         corner(2, -tangent * hs + worldUp * h + outward * tilt, glm::vec2(0,0));
         corner(3,  tangent * hs + worldUp * h + outward * tilt, glm::vec2(1,0));
     }
-    Buffer vb = app->createDeviceLocalBuffer(verts.data(), verts.size() * sizeof(Vertex),
-                                              VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-    captureVertBuf = vb.buffer;
-    captureVertMem = vb.memory;
+    captureVertBuf = app->createDeviceLocalBuffer(verts.data(), verts.size() * sizeof(Vertex),
+                                                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
 
     // 36-index triangle list.
     std::vector<uint32_t> idx(36);
@@ -757,30 +991,24 @@ void ImpostorCapture::createCaptureBuffers(VulkanApp* app) {
         idx[ib + 0] = b + 0; idx[ib + 1] = b + 1; idx[ib + 2] = b + 2;
         idx[ib + 3] = b + 1; idx[ib + 4] = b + 3; idx[ib + 5] = b + 2;
     }
-    Buffer idxBuf = app->createDeviceLocalBuffer(idx.data(), idx.size() * sizeof(uint32_t),
-                                                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
-    captureIdxBuf = idxBuf.buffer;
-    captureIdxMem = idxBuf.memory;
+    captureIdxBuf = app->createDeviceLocalBuffer(idx.data(), idx.size() * sizeof(uint32_t),
+                                                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
     captureIdxCount = 36;
 
     // Instance buffer: 1 vec4 (xyz=world pos, w=billboardIndex), host-visible.
     // Needs VERTEX_BUFFER_BIT because it's bound as vertex buffer binding 1.
-    Buffer ib = app->createBuffer(NUM_INSTANCES * sizeof(glm::vec4),
+    captureInstBuf = app->createBuffer(NUM_INSTANCES * sizeof(glm::vec4),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    captureInstBuf = ib.buffer;
-    captureInstMapped = ib.mappedData;
-    captureInstMem = ib.memory;
+    captureInstMapped = captureInstBuf.mappedData;
 }
 
 void ImpostorCapture::createCaptureInvVPBuffer(VulkanApp* app) {
-    const VkDeviceSize totalSize = TOTAL_LAYERS * sizeof(glm::mat4);
-    Buffer buf = app->createBuffer(totalSize,
+    const VkDeviceSize totalSize = totalLayers() * sizeof(glm::mat4);
+    captureInvVPBuffer = app->createBuffer(totalSize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    captureInvVPBuffer = buf.buffer;
-    captureInvVPMapped = buf.mappedData;
-    captureInvVPMemory = buf.memory;
+    captureInvVPMapped = captureInvVPBuffer.mappedData;
 }
 
 void ImpostorCapture::createSceneSampler(VulkanApp* app) {
@@ -791,40 +1019,21 @@ void ImpostorCapture::allocateDescSets(VulkanApp* app) {
     DescriptorAllocator descAlloc{app->getDevice(), app};
 
     VkDescriptorPoolSize poolSizesIC[] = {
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
-        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 3}
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1}
     };
     descriptorPool = descAlloc.createPool(
-        poolSizesIC, 2, 2,
+        poolSizesIC, 1, 1,
         VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
         "ImpostorCapture: descriptorPool");
 
-    VkDescriptorSetLayout layouts[2] = { uboDescSetLayout, texDescSetLayout };
-    VkDescriptorSet sets[2];
-    descAlloc.allocateSets(descriptorPool, 2, layouts, sets);
-    uboDescSet = sets[0];
-    texDescSet = sets[1];
+    uboDescSet = descAlloc.allocateSet(descriptorPool, uboDescSetLayout, "ImpostorCapture: uboDescSet");
 
     // Write UBO descriptor (DYNAMIC: range = one slot, offset supplied per-draw).
     DescriptorWriter(app->getDevice())
         .writeBuffer(uboDescSet, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
-                     uboBuffer, 0, sizeof(CaptureUBO))
+                     uboBuffer.buffer, 0, sizeof(CaptureUBO))
         .flush();
-    // Texture descriptor is written in updateTexDescSet() at capture time.
-    // Set=2 wind params descriptor is shared with the VegetationRenderer.
-}
-
-void ImpostorCapture::updateTexDescSet(VkDevice device,
-                                       VkImageView albedo, VkImageView normal,
-                                       VkImageView opacity, VkSampler sampler) {
-    DescriptorWriter writer(device);
-    writer.writeImage(texDescSet, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                      sampler, albedo, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    writer.writeImage(texDescSet, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                      sampler, normal, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    writer.writeImage(texDescSet, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                      sampler, opacity, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    writer.flush();
+    // Billboard arrays and wind params are read from the bindless heap.
 }
 
 void ImpostorCapture::createImGuiDescSetsForType(VulkanApp* app, uint32_t billboardType) {
@@ -843,8 +1052,8 @@ void ImpostorCapture::createImGuiDescSetsForType(VulkanApp* app, uint32_t billbo
         si.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
         imguiSampler = app->createSampler(si, "ImpostorCapture: imguiSampler");
     }
-    const uint32_t layerBase = billboardType * NUM_VIEWS;
-    for (uint32_t v = 0; v < NUM_VIEWS; ++v) {
+    const uint32_t layerBase = billboardType * viewCount_;
+    for (uint32_t v = 0; v < viewCount_; ++v) {
         const uint32_t layerIdx = layerBase + v;
         imguiDescSets[layerIdx] = (VkDescriptorSet)ImGui_ImplVulkan_AddTexture(
             imguiSampler, captureLayerViews[layerIdx], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
@@ -860,7 +1069,17 @@ void ImpostorCapture::createImGuiDescSetsForType(VulkanApp* app, uint32_t billbo
 void ImpostorCapture::recreateAllImGuiDescSets(VulkanApp* app) {
     destroyImGuiDescSets();
     for (uint32_t bt = 0; bt < NUM_BILLBOARD_TYPES; ++bt) {
-        createImGuiDescSetsForType(app, bt);
+        if (isCaptured(bt)) createImGuiDescSetsForType(app, bt);
+    }
+}
+
+void ImpostorCapture::removeImGuiDescSetsForType(uint32_t billboardType) {
+    const uint32_t layerBase = billboardType * viewCount_;
+    for (uint32_t v = 0; v < viewCount_; ++v) {
+        for (auto* sets : { &imguiDescSets, &imguiNormalDescSets, &imguiDepthDescSets }) {
+            auto& ds = (*sets)[layerBase + v];
+            if (ds != VK_NULL_HANDLE) { ImGui_ImplVulkan_RemoveTexture(ds); ds = VK_NULL_HANDLE; }
+        }
     }
 }
 
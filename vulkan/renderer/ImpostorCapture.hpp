@@ -4,35 +4,61 @@
 #include "../VmaContext.hpp"
 #include "../TrackedHandle.hpp"
 #include "../Buffer.hpp"
+#include "../BindlessHeap.hpp"
 #include <glm/glm.hpp>
 #include <array>
+#include <string>
+#include <vector>
 #include "CommandBufferState.hpp"
 
 class VulkanApp;
 class VegetationRenderer;
 
-// Captures vegetation billboard impostor views from a Fibonacci sphere grid.
-// 20 evenly-distributed camera positions orbit the billboard at capture time
-// for each of 3 billboard types, giving 60 layers total.
+// Captures vegetation billboard impostor views, one array layer per view,
+// for each of 3 billboard types (layer = type * viewCount() + view).
+//
+// Two view layouts:
+//  - Fibonacci: 20 evenly-distributed directions at 256². The shaders pick
+//    the single closest view, so the image pops as the camera moves.
+//  - Octahedral: grid² directions at the vertices of an octahedral map of the
+//    sphere (OCTAHEDRAL_ATLAS_SIZE / grid texels each, i.e. a fixed-size
+//    atlas per type). The shaders blend the 3 frames of the grid triangle
+//    containing the view direction with barycentric weights.
+//
+// Captured types can be stored in and restored from a disk cache keyed by a
+// hash of the billboard's content (its layers and source textures), the
+// layout and the capture scale, so startup only renders types that changed.
 class ImpostorCapture : public Renderer {
 public:
-    static constexpr uint32_t NUM_VIEWS          = 20;
+    enum class ViewLayout : uint32_t { Fibonacci = 0, Octahedral = 1 };
+
+    static constexpr uint32_t NUM_VIEWS          = 20;  // Fibonacci layout
     static constexpr uint32_t NUM_BILLBOARD_TYPES = 3;
-    static constexpr uint32_t TOTAL_LAYERS       = NUM_BILLBOARD_TYPES * NUM_VIEWS; // 60
-    static constexpr uint32_t TEX_SIZE           = 256;
+    static constexpr uint32_t TEX_SIZE           = 256; // Fibonacci frame size
+    static constexpr uint32_t OCTAHEDRAL_ATLAS_SIZE = 1024; // per type, split into grid² frames
+    static constexpr uint32_t MIN_OCTAHEDRAL_GRID = 2;
+    static constexpr uint32_t MAX_OCTAHEDRAL_GRID = 16;
     static constexpr uint32_t NUM_INSTANCES      = 1; // single centred instance
 
+    // Directory for cached captures (relative to the working directory)
+    static std::string cacheDirectory;
+
     // Allocate all GPU resources (call once after VulkanApp is ready).
     // The vegetation renderer supplies the shared set=2 wind params descriptor
     // set/layout used by the capture pipeline (see finding: duplicate wind
     // params descriptor trio was created here before).
-    void init(VulkanApp* app, VegetationRenderer* vegRenderer = nullptr);
+    // `octahedralGrid` is clamped to [MIN_OCTAHEDRAL_GRID, MAX_OCTAHEDRAL_GRID],
+    // then lowered until totalLayers() fits maxImageArrayLayers; read the grid
+    // actually used back with getOctahedralGrid().
+    // All layers start cleared (fully transparent) and shader-readable.
+    void init(VulkanApp* app, VegetationRenderer* vegRenderer = nullptr,
+              ViewLayout layout = ViewLayout::Fibonacci, uint32_t octahedralGrid = 8);
 
     // Destroy all GPU resources.
     void cleanup(VulkanApp* app) override;
 
-    // Capture NUM_VIEWS impostor frames for ONE billboard type into layers
-    // [billboardIndex*NUM_VIEWS .. billboardIndex*NUM_VIEWS+NUM_VIEWS-1].
+    // Capture viewCount() impostor frames for ONE billboard type into layers
+    // [billboardIndex*viewCount() .. billboardIndex*viewCount()+viewCount()-1].
     void capture(VulkanApp* app,
                  VkImageView albedoView, VkImageView normalView,
                  VkImageView opacityView, VkSampler  sampler,
@@ -44,7 +70,24 @@ public:
                     VkImageView opacityView, VkSampler  sampler,
                     float billboardScale);
 
+    // Restore one billboard type from the disk cache. Returns false (layers
+    // untouched) when there is no valid entry for `contentKey`.
+    bool loadCached(VulkanApp* app, uint32_t billboardType, uint64_t contentKey, float billboardScale);
+    // Read one captured type back and write it to the disk cache.
+    bool storeCached(VulkanApp* app, uint32_t billboardType, uint64_t contentKey, float billboardScale);
+
     bool isReady() const { return capturedTypes > 0; }
+    bool isCaptured(uint32_t billboardType) const { return (capturedTypes >> billboardType) & 1u; }
+
+    ViewLayout getLayout() const { return layout_; }
+    uint32_t getOctahedralGrid() const { return grid_; }
+    uint32_t viewCount() const { return viewCount_; }
+    uint32_t frameSize() const { return frameSize_; }
+    uint32_t totalLayers() const { return NUM_BILLBOARD_TYPES * viewCount_; }
+
+    // Octahedral map of the unit sphere (y up) to [0,1]², and its inverse.
+    static glm::vec2 octahedralEncode(const glm::vec3& dir);
+    static glm::vec3 octahedralDecode(const glm::vec2& uv);
 
     // ImGui-compatible descriptor set for view (billboardType, viewIdx).
     VkDescriptorSet getImGuiDescSet(uint32_t billboardType, uint32_t viewIdx) const;
@@ -55,14 +98,14 @@ public:
     // Return the view index whose direction has the greatest dot-product with dir.
     uint32_t closestView(const glm::vec3& dir) const;
 
-    // Full 60-layer array views – usable as sampler2DArray in scene shaders.
+    // Full array views (totalLayers() layers) – usable as sampler2DArray in scene shaders.
     VkImageView getCaptureArrayView()          const { return captureArrayView; }
     VkImageView getCaptureNormalArrayView()    const { return captureNormalArrayView; }
     VkImageView getCaptureDepthArrayView()     const { return captureDepthArrayView; }
 
     // Per-layer capture inverse VP matrices for depth reprojection in the shadow pass.
     const glm::mat4* getCaptureInvVP()      const { return captureInvVP.data(); }
-    VkBuffer         getCaptureInvVPBuffer() const { return captureInvVPBuffer; }
+    VkBuffer         getCaptureInvVPBuffer() const { return captureInvVPBuffer.buffer; }
 
     // Sampler suitable for scene use (created at init).
     VkSampler   getCaptureArraySampler() const { return sceneSampler; }
@@ -74,29 +117,34 @@ public:
     VkDescriptorSet getImGuiDepthDescSet(uint32_t billboardType, uint32_t viewIdx) const;
 
 private:
-    // Fibonacci sphere directions (unit vectors pointing FROM camera TO center).
-    std::array<glm::vec3, NUM_VIEWS> viewDirs{};
+    ViewLayout layout_ = ViewLayout::Fibonacci;
+    uint32_t grid_ = 0;           // octahedral grid size (0 for Fibonacci)
+    uint32_t viewCount_ = NUM_VIEWS;
+    uint32_t frameSize_ = TEX_SIZE;
+
+    // View directions (unit vectors pointing FROM center TO camera).
+    std::vector<glm::vec3> viewDirs;
 
-    // Albedo capture texture array (TOTAL_LAYERS=60 layers, VK_FORMAT_R8G8B8A8_UNORM).
+    // Albedo capture texture array (totalLayers() layers, VK_FORMAT_R8G8B8A8_UNORM).
     VkImage        captureImage      = VK_NULL_HANDLE;
     VmaAllocation  captureAllocation = VK_NULL_HANDLE;
     VkDeviceMemory captureMemory     = VK_NULL_HANDLE;
     VkImageView    captureArrayView  = VK_NULL_HANDLE;
-    std::array<VkImageView, TOTAL_LAYERS> captureLayerViews{};
+    std::vector<VkImageView> captureLayerViews;
 
     // Normal capture texture array (world-space normals encoded in [0,1]).
     VkImage        captureNormalImage      = VK_NULL_HANDLE;
     VmaAllocation  captureNormalAllocation = VK_NULL_HANDLE;
     VkDeviceMemory captureNormalMemory     = VK_NULL_HANDLE;
     VkImageView    captureNormalArrayView  = VK_NULL_HANDLE;
-    std::array<VkImageView, TOTAL_LAYERS> captureNormalLayerViews{};
+    std::vector<VkImageView> captureNormalLayerViews;
 
     // Depth capture texture array (device Z for shadow-map reprojection).
     VkImage        captureDepthImage      = VK_NULL_HANDLE;
     VmaAllocation  captureDepthAllocation = VK_NULL_HANDLE;
     VkDeviceMemory captureDepthMemory     = VK_NULL_HANDLE;
     VkImageView    captureDepthArrayView  = VK_NULL_HANDLE;
-    std::array<VkImageView, TOTAL_LAYERS> captureDepthLayerViews{};
+    std::vector<VkImageView> captureDepthLayerViews;
 
     // Depth image (single non-array, reused across all views in one submit).
     VkImage        depthImage  = VK_NULL_HANDLE;
@@ -104,73 +152,76 @@ private:
     VkDeviceMemory depthMemory = VK_NULL_HANDLE;
     VkImageView    depthView   = VK_NULL_HANDLE;
 
-    // Pipeline (vegetation vert/geom/frag with simple 2-set layout).
+    // Pipeline (vegetation vert + capture frag): set 0 = per-view UBO,
+    // set 1 = bindless heap.
     TrackedHandle<VkPipeline> capturePipeline;
     TrackedHandle<VkPipelineLayout> capturePipelineLayout;
     TrackedHandle<VkDescriptorSetLayout> uboDescSetLayout;
-    TrackedHandle<VkDescriptorSetLayout> texDescSetLayout;
 
-    // Per-view camera UBO (dynamic-offset uniform buffer, NUM_VIEWS slots).
+    // Per-view camera UBO (dynamic-offset uniform buffer, viewCount() slots).
     struct alignas(16) CaptureUBO {
         glm::mat4 viewProjection;
         glm::vec4 viewPos;
         glm::vec4 lightDir;
         glm::vec4 lightColor;
     };
-    VkBuffer       uboBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory uboMemory = VK_NULL_HANDLE;
+    Buffer         uboBuffer;
     void*          uboMapped = nullptr;
     VkDeviceSize   uboStride = 256;  // aligned to minUniformBufferOffsetAlignment
 
-    // Shared set=2 wind params descriptor set + layout, owned by the
-    // VegetationRenderer (wind is disabled during capture, so the set is only
-    // bound for pipeline compatibility — its content is never read).
+    // Owner of the wind params buffer (heap slot pushed with the capture
+    // constants; wind is disabled during capture, so it is never read).
     VegetationRenderer* sharedVegRenderer = nullptr;
 
     // Minimal vertex + instance buffers (single base vertex, one instance).
-    VkBuffer       captureVertBuf = VK_NULL_HANDLE;
-    VkDeviceMemory captureVertMem = VK_NULL_HANDLE;
-    VkBuffer       captureInstBuf = VK_NULL_HANDLE;
+    Buffer         captureVertBuf;
+    Buffer         captureInstBuf;
     void*          captureInstMapped = nullptr;
-    VkDeviceMemory captureInstMem = VK_NULL_HANDLE;
-    VkBuffer       captureIdxBuf = VK_NULL_HANDLE;
-    VkDeviceMemory captureIdxMem = VK_NULL_HANDLE;
+    Buffer         captureIdxBuf;
     uint32_t       captureIdxCount = 0;
 
-    // Descriptor pool + two descriptor sets (UBO dynamic + texture samplers).
+    // Descriptor pool + the per-view UBO descriptor set (dynamic offset).
     TrackedHandle<VkDescriptorPool> descriptorPool;
     TrackedHandle<VkDescriptorSet> uboDescSet;
-    TrackedHandle<VkDescriptorSet> texDescSet;
 
-    // Push constants (16 bytes) — matches the vegetation shader layout.
-    // Wind parameters are in the WindParamsUBO at set=2.
+    // Push constants (48 bytes) — matches includes/vegetation_params.glsl.
     struct CapturePC {
         float     billboardScale;
         float     windEnabled;      // 0 = disabled during capture
         float     windTime;
         float     impostorDistance; // always 0 during capture
+        uint32_t  windParamsBuffer; // bindless heap slots
+        uint32_t  albedoTexture;
+        uint32_t  normalTexture;
+        uint32_t  opacityTexture;
+        uint32_t  impostorTexture       = BindlessHeap::INVALID_INDEX;  // unused by the capture shaders
+        uint32_t  impostorNormalTexture = BindlessHeap::INVALID_INDEX;
+        uint32_t  impostorDepthTexture  = BindlessHeap::INVALID_INDEX;
+        uint32_t  captureInvVPBuffer    = BindlessHeap::INVALID_INDEX;
     };
 
-    // ImGui display resources (TOTAL_LAYERS descriptor sets each for albedo and normals).
+    // ImGui display resources (totalLayers() descriptor sets each for albedo and normals).
     TrackedHandle<VkSampler> imguiSampler;
     TrackedHandle<VkSampler> sceneSampler;
-    std::array<TrackedHandle<VkDescriptorSet>, TOTAL_LAYERS> imguiDescSets;
-    std::array<TrackedHandle<VkDescriptorSet>, TOTAL_LAYERS> imguiNormalDescSets;
-    std::array<TrackedHandle<VkDescriptorSet>, TOTAL_LAYERS> imguiDepthDescSets;
+    std::vector<TrackedHandle<VkDescriptorSet>> imguiDescSets;
+    std::vector<TrackedHandle<VkDescriptorSet>> imguiNormalDescSets;
+    std::vector<TrackedHandle<VkDescriptorSet>> imguiDepthDescSets;
 
     // Per-layer capture inverse VP matrices for depth reprojection.
-    std::array<glm::mat4, TOTAL_LAYERS> captureInvVP{};
+    std::vector<glm::mat4> captureInvVP;
 
     // Buffer containing captureInvVP data for GPU access in depth pass.
-    VkBuffer       captureInvVPBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory captureInvVPMemory = VK_NULL_HANDLE;
+    Buffer         captureInvVPBuffer;
     void*          captureInvVPMapped = nullptr;
 
     // Bitmask of which billboard types have been captured.
     uint32_t capturedTypes = 0;
     bool initDone = false;
 
-    void generateFibonacciDirs();
+    void generateViewDirs();
+    // Fill the per-view UBO slots and the type's inverse VP matrices.
+    void writeViewMatrices(float billboardScale, uint32_t layerBase);
+    std::string cachePath(uint64_t contentKey, float billboardScale) const;
     void createCaptureImages(VulkanApp* app);
     void createDepth(VulkanApp* app);
     void createDescSetLayouts(VulkanApp* app);
@@ -180,10 +231,8 @@ private:
     void createCaptureInvVPBuffer(VulkanApp* app);
     void createSceneSampler(VulkanApp* app);
     void allocateDescSets(VulkanApp* app);
-    void updateTexDescSet(VkDevice device,
-                          VkImageView albedo, VkImageView normal,
-                          VkImageView opacity, VkSampler sampler);
     void createImGuiDescSetsForType(VulkanApp* app, uint32_t billboardType);
+    void removeImGuiDescSetsForType(uint32_t billboardType);
 public:
     void destroyImGuiDescSets();
     void invalidateImGuiDescriptors() { destroyImGuiDescSets(); }
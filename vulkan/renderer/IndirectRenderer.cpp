@@ -11,6 +11,7 @@
 #include <cmath>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 #include <chrono>
 
 // Last time a "no free slot" line was logged (throttled to 1/sec so a full
@@ -27,7 +28,13 @@ struct CullPushConstants {
     float pad0[2];        // offset 72
     glm::vec3 camPos;     // offset 80
     float lodBias;        // offset 92
-}; // 96 bytes
+    // Bindless heap slots of the cull buffers (read by indirect.comp only)
+    uint32_t inCmdsSlot;       // offset 96
+    uint32_t outCmdsSlot;      // offset 100
+    uint32_t boundsSlot;       // offset 104
+    uint32_t visibleCountSlot; // offset 108
+    uint32_t visibleLodsSlot;  // offset 112
+}; // 116 bytes
 
 struct CascadeCullPushConstants {
     uint32_t numChunks;   // offset 0
@@ -106,6 +113,7 @@ void IndirectRenderer::publishPendingTransfer(VulkanApp* app) {
 }
 
 void IndirectRenderer::pollPendingTransfers(VulkanApp* app) {
+    retireSurfaceNets();
     if (pendingTransfer.fence == VK_NULL_HANDLE) return;
     VkDevice dev = app->getDevice();
     // If processPendingCommandBuffers already cleaned up the fence, the
@@ -210,7 +218,7 @@ void IndirectRenderer::init() {
 }
 
 void IndirectRenderer::cleanup(VulkanApp* app) {
-    (void)app;
+    if (app) releaseCullSlots(app);
     meshes.clear();
     activeMeshCountDirty_ = true;
     vertexBuffer = {};
@@ -233,6 +241,8 @@ void IndirectRenderer::cleanup(VulkanApp* app) {
         }
         visibleCountBuffers[f] = {};
     }
+    destroyClusterCull();
+    destroySurfaceNets();
 }
 
 uint32_t IndirectRenderer::addMesh(const Geometry& mesh) {
@@ -1285,7 +1295,7 @@ void IndirectRenderer::rebuild(VulkanApp* app) {
         }
     }
     if (visibleLodsScratch.buffer == VK_NULL_HANDLE && lodBufSize > 0) {
-        // TRANSFER_DST required: prepareCullWithDescriptor clears it with
+        // TRANSFER_DST required: prepareCullWithSlots clears it with
         // vkCmdFillBuffer each cull.
         visibleLodsScratch = app->createBuffer(lodBufSize,
             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
@@ -1324,52 +1334,19 @@ void IndirectRenderer::rebuild(VulkanApp* app) {
 
     // Create compute pipeline + descriptor sets for GPU culling if not present
     if (computePipeline == VK_NULL_HANDLE) {
-        VkDescriptorSetLayoutBinding bindings[5] = {};
-        bindings[0].binding = 0;
-        bindings[0].descriptorCount = 1;
-        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[1].binding = 1;
-        bindings[1].descriptorCount = 1;
-        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[2].binding = 2;
-        bindings[2].descriptorCount = 1;
-        bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[3].binding = 3;
-        bindings[3].descriptorCount = 1;
-        bindings[3].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[4].binding = 4;
-        bindings[4].descriptorCount = 1;
-        bindings[4].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-
-        VkDescriptorBindingFlags bindingFlags[5] = {
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
-        };
-
-        DescriptorAllocator descAlloc{app->getDevice(), app};
-        computeDescriptorSetLayout = descAlloc.createLayout(
-            bindings, 5,
-            VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-            bindingFlags,
-            "IndirectRenderer: computeDescriptorSetLayout");
+        // The cull buffers are read through the bindless heap (set 0 here),
+        // addressed by the slots in the push constants.
+        VkDescriptorSetLayout heapLayout = app->getBindlessHeap().getLayout();
 
         VkPushConstantRange pc{};
         pc.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
         pc.offset = 0;
-        pc.size = sizeof(CullPushConstants); // 96 bytes: mat4 + 2*uint + pad + vec3 + float
+        pc.size = sizeof(CullPushConstants); // 116 bytes: mat4 + 2*uint + pad + vec3 + float + 5 slots
 
         VkPipelineLayoutCreateInfo plinfo{};
         plinfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         plinfo.setLayoutCount = 1;
-        plinfo.pSetLayouts = &computeDescriptorSetLayout;
+        plinfo.pSetLayouts = &heapLayout;
         plinfo.pushConstantRangeCount = 1;
         plinfo.pPushConstantRanges = &pc;
 
@@ -1398,66 +1375,11 @@ void IndirectRenderer::rebuild(VulkanApp* app) {
         }
         // track compute pipeline
         app->resources.addPipeline(computePipeline, "IndirectRenderer: computePipeline");
-
-        VkDescriptorPoolSize irPoolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 256};
-        computeDescriptorPool = descAlloc.createPool(
-            &irPoolSize, 1, 64,
-            VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-            "IndirectRenderer: computeDescriptorPool");
-
-        descAlloc.allocateSets(computeDescriptorPool, computeDescriptorSetLayout,
-                               MAX_CULL_FRAMES, reinterpret_cast<VkDescriptorSet*>(computeDescriptorSets.data()),
-                               "IndirectRenderer: computeDescriptorSet");
     }
 
-    // Update per-frame compute descriptor sets with buffer infos
-    VkDescriptorBufferInfo inBuf{};
-    inBuf.buffer = indirectBuffer.buffer;
-    inBuf.offset = 0;
-    inBuf.range = VK_WHOLE_SIZE;
-    VkDescriptorBufferInfo boundsBufInfo{};
-    boundsBufInfo.buffer = boundsBuffer.buffer;
-    boundsBufInfo.offset = 0;
-    boundsBufInfo.range = VK_WHOLE_SIZE;
-
-    bool anyNull = (indirectBuffer.buffer == VK_NULL_HANDLE || boundsBuffer.buffer == VK_NULL_HANDLE);
-    for (uint32_t f = 0; f < MAX_CULL_FRAMES && !anyNull; f++) {
-        if (compactIndirectBuffers[f].buffer == VK_NULL_HANDLE || visibleCountBuffers[f].buffer == VK_NULL_HANDLE) {
-            anyNull = true;
-        }
-    }
-    if (anyNull) {
-        std::cerr << "[IndirectRenderer] Skipping compute descriptor set update: one or more buffers are VK_NULL_HANDLE" << std::endl;
-    } else {
-        for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
-            VkDescriptorBufferInfo outBuf{};
-            outBuf.buffer = compactIndirectBuffers[f].buffer;
-            outBuf.offset = 0;
-            outBuf.range = VK_WHOLE_SIZE;
-            VkDescriptorBufferInfo countBuf{};
-            countBuf.buffer = visibleCountBuffers[f].buffer;
-            countBuf.offset = 0;
-            countBuf.range = VK_WHOLE_SIZE;
-            VkDescriptorBufferInfo lodBuf{};
-            lodBuf.buffer = visibleLodBuffers[f].buffer;
-            lodBuf.offset = 0;
-            lodBuf.range = VK_WHOLE_SIZE;
-
-            VkDescriptorSet computeDs = computeDescriptorSets[f];
-            DescriptorWriter(app->getDevice())
-                .writeBuffer(computeDs, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                             inBuf.buffer, inBuf.offset, inBuf.range)
-                .writeBuffer(computeDs, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                             outBuf.buffer, outBuf.offset, outBuf.range)
-                .writeBuffer(computeDs, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                             boundsBufInfo.buffer, boundsBufInfo.offset, boundsBufInfo.range)
-                .writeBuffer(computeDs, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                             countBuf.buffer, countBuf.offset, countBuf.range)
-                .writeBuffer(computeDs, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                             lodBuf.buffer, lodBuf.offset, lodBuf.range)
-                .flush();
-        }
-    }
+    // The cull buffers may have been (re)allocated above: point the heap
+    // slots at the current ones.
+    registerCullSlots(app);
 
     // Try to load device function for indirect-count draws; require it.
     cmdDrawIndexedIndirectCount = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(app->getDevice(), "vkCmdDrawIndexedIndirectCountKHR");
@@ -1482,8 +1404,41 @@ void IndirectRenderer::rebuild(VulkanApp* app) {
     metaBuffersWrittenCount = indirectCommands.size();
 }
 
+void IndirectRenderer::registerCullSlots(VulkanApp* app) {
+    // replaceBuffer releases the previous slots only once the frames that may
+    // still read them have retired; null buffers leave the slot invalid.
+    BindlessHeap& heap = app->getBindlessHeap();
+    indirectSlot = heap.replaceBuffer(indirectSlot, indirectBuffer.buffer);
+    boundsSlot = heap.replaceBuffer(boundsSlot, boundsBuffer.buffer);
+    visibleLodsScratchSlot = heap.replaceBuffer(visibleLodsScratchSlot, visibleLodsScratch.buffer);
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        compactSlots[f] = heap.replaceBuffer(compactSlots[f], compactIndirectBuffers[f].buffer);
+        visibleCountSlots[f] = heap.replaceBuffer(visibleCountSlots[f], visibleCountBuffers[f].buffer);
+        visibleLodSlots[f] = heap.replaceBuffer(visibleLodSlots[f], visibleLodBuffers[f].buffer);
+    }
+}
+
+void IndirectRenderer::releaseCullSlots(VulkanApp* app) {
+    BindlessHeap& heap = app->getBindlessHeap();
+    heap.releaseBuffer(indirectSlot);
+    heap.releaseBuffer(boundsSlot);
+    heap.releaseBuffer(visibleLodsScratchSlot);
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        heap.releaseBuffer(compactSlots[f]);
+        heap.releaseBuffer(visibleCountSlots[f]);
+        heap.releaseBuffer(visibleLodSlots[f]);
+    }
+    indirectSlot = BindlessHeap::INVALID_INDEX;
+    boundsSlot = BindlessHeap::INVALID_INDEX;
+    visibleLodsScratchSlot = BindlessHeap::INVALID_INDEX;
+    compactSlots = filledCullSlots();
+    visibleCountSlots = filledCullSlots();
+    visibleLodSlots = filledCullSlots();
+}
+
 void IndirectRenderer::setCullFrame(uint32_t frame) {
     currentCullFrame = frame % MAX_CULL_FRAMES;
+    ++cullFrameSerial_;
 }
 
 void IndirectRenderer::prepareCull(VkCommandBuffer cmd, const glm::mat4& viewProj,
@@ -1497,10 +1452,13 @@ void IndirectRenderer::prepareCull(VkCommandBuffer cmd, const glm::mat4& viewPro
     // after every in-flight frame's reads of the same entries.
     flushStagedMetaWrites(cmd, currentCullFrame);
 
+    // GPU-meshed chunks: written after the staged meta copies (a recycled
+    // entry's zeroing lands first) and before the cull reads their entries.
+    dispatchSurfaceNets(cmd);
+
     Buffer& compactBuf = compactIndirectBuffers[currentCullFrame];
     Buffer& visibleCount = visibleCountBuffers[currentCullFrame];
     Buffer& visibleLods = visibleLodBuffers[currentCullFrame];
-    VkDescriptorSet descSet = computeDescriptorSets[currentCullFrame];
 
     if (computePipeline == VK_NULL_HANDLE || compactBuf.buffer == VK_NULL_HANDLE) {
         // No meshes loaded yet (e.g. during parallel background loading). Nothing to cull.
@@ -1608,10 +1566,11 @@ void IndirectRenderer::prepareCull(VkCommandBuffer cmd, const glm::mat4& viewPro
     }
 
     // Bind and dispatch compute cull
+    VkDescriptorSet heapSet = app_->getBindlessHeap().getSet();
     if (cmdState) cmdState->bindComputePipeline(cmd, computePipeline);
     else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
-    if (cmdState) cmdState->bindComputeDescriptorSets(cmd, computePipelineLayout, 0, 1, &descSet, 0, nullptr);
-    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 1, &descSet, 0, nullptr);
+    if (cmdState) cmdState->bindComputeDescriptorSets(cmd, computePipelineLayout, 0, 1, &heapSet, 0, nullptr);
+    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 1, &heapSet, 0, nullptr);
     uint32_t numCmds = 0;
     {
         std::lock_guard<std::recursive_mutex> lock(mutex);
@@ -1655,6 +1614,11 @@ void IndirectRenderer::prepareCull(VkCommandBuffer cmd, const glm::mat4& viewPro
     pc.numCmds      = numCmds;
     pc.camPos       = camPos;
     pc.lodBias      = lodBias;
+    pc.inCmdsSlot       = indirectSlot;
+    pc.outCmdsSlot      = compactSlots[currentCullFrame];
+    pc.boundsSlot       = boundsSlot;
+    pc.visibleCountSlot = visibleCountSlots[currentCullFrame];
+    pc.visibleLodsSlot  = visibleLodSlots[currentCullFrame];
     vkCmdPushConstants(cmd, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pc);
 
     uint32_t groupSize = 64;
@@ -1695,19 +1659,25 @@ void IndirectRenderer::prepareCull(VkCommandBuffer cmd, const glm::mat4& viewPro
     depInfo.bufferMemoryBarrierCount = 3;
     depInfo.pBufferMemoryBarriers = barriers;
     vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    if (clusterCullPipeline != VK_NULL_HANDLE) {
+        dispatchClusterCull(cmd, viewProj, camPos, lodBias);
+    }
 }
 
 
 
-void IndirectRenderer::prepareCullWithDescriptor(VkCommandBuffer cmd, const glm::mat4& viewProj, VkDescriptorSet computeDesc,
-                                                VkBuffer outCompactBuffer, VkBuffer outVisibleCountBuffer,
-                                                glm::vec3 camPos, float lodBias) {
+void IndirectRenderer::prepareCullWithSlots(VkCommandBuffer cmd, const glm::mat4& viewProj,
+                                           VkBuffer outCompactBuffer, uint32_t outCompactSlot,
+                                           VkBuffer outVisibleCountBuffer, uint32_t outVisibleCountSlot,
+                                           glm::vec3 camPos, float lodBias) {
     if (computePipeline == VK_NULL_HANDLE) {
         // No meshes loaded yet (e.g. during parallel background loading). Nothing to cull.
         return;
     }
-    if (outCompactBuffer == VK_NULL_HANDLE || computeDesc == VK_NULL_HANDLE) {
-        throw std::runtime_error("IndirectRenderer::prepareCullWithDescriptor requires valid outCompactBuffer and computeDesc");
+    if (outCompactBuffer == VK_NULL_HANDLE || outCompactSlot == BindlessHeap::INVALID_INDEX ||
+        outVisibleCountSlot == BindlessHeap::INVALID_INDEX) {
+        throw std::runtime_error("IndirectRenderer::prepareCullWithSlots requires valid outCompactBuffer and output slots");
     }
 
     // Acquire uploaded geometry/meta buffers (async vkCmdCopyBuffer / host staging)
@@ -1743,9 +1713,9 @@ void IndirectRenderer::prepareCullWithDescriptor(VkCommandBuffer cmd, const glm:
         preFill[0].offset = 0;
         preFill[0].size = VK_WHOLE_SIZE;
 
-        // The caller's descriptor set may bind this instance's shared
-        // visibleLodsScratch as the chosen-LoD output (e.g. the solid-360
-        // cubemap DS). That buffer is written by every face's dispatch, so a
+        // This path writes the chosen LoDs into this instance's shared
+        // visibleLodsScratch. That buffer is written by every face's dispatch
+        // (solid-360 cubemap), so a
         // prior dispatch's writes must complete before our fill overwrites
         // them — same WRITE_AFTER_WRITE reasoning as the count buffer.
         // (Skipped when the scratch hasn't been allocated yet — VK_NULL_HANDLE
@@ -1801,8 +1771,8 @@ void IndirectRenderer::prepareCullWithDescriptor(VkCommandBuffer cmd, const glm:
     // prior vkCmdFillBuffer (e.g. main pass) or written by a previous face's
     // compute dispatch. Ensure that write is visible before this dispatch
     // writes to it again (TRANSFER_WRITE/SHADER_WRITE → COMPUTE hazard).
-    // The shared visibleLodsScratch (written by this dispatch via the caller's
-    // descriptor set) needs the same fill→compute ordering.
+    // The shared visibleLodsScratch (written by this dispatch) needs the same
+    // fill→compute ordering.
     {
         VkBufferMemoryBarrier2 compactBarriers[2] = {};
         compactBarriers[0].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
@@ -1833,11 +1803,12 @@ void IndirectRenderer::prepareCullWithDescriptor(VkCommandBuffer cmd, const glm:
         vkCmdPipelineBarrier2(cmd, &depInfo);
     }
 
-    // Bind and dispatch compute cull using caller-provided descriptor set
+    // Bind and dispatch compute cull into the caller-provided buffers
+    VkDescriptorSet heapSet = app_->getBindlessHeap().getSet();
     if (cmdState) cmdState->bindComputePipeline(cmd, computePipeline);
     else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
-    if (cmdState) cmdState->bindComputeDescriptorSets(cmd, computePipelineLayout, 0, 1, &computeDesc, 0, nullptr);
-    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 1, &computeDesc, 0, nullptr);
+    if (cmdState) cmdState->bindComputeDescriptorSets(cmd, computePipelineLayout, 0, 1, &heapSet, 0, nullptr);
+    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 1, &heapSet, 0, nullptr);
 
     uint32_t numCmds = 0;
     {
@@ -1853,6 +1824,11 @@ void IndirectRenderer::prepareCullWithDescriptor(VkCommandBuffer cmd, const glm:
     pc2.numCmds      = numCmds;
     pc2.camPos       = camPos;
     pc2.lodBias      = lodBias;
+    pc2.inCmdsSlot       = indirectSlot;
+    pc2.outCmdsSlot      = outCompactSlot;
+    pc2.boundsSlot       = boundsSlot;
+    pc2.visibleCountSlot = outVisibleCountSlot;
+    pc2.visibleLodsSlot  = visibleLodsScratchSlot;
     vkCmdPushConstants(cmd, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pc2);
 
     uint32_t groupSize = 64;
@@ -1941,6 +1917,13 @@ void IndirectRenderer::drawPrepared(VkCommandBuffer cmd, uint32_t maxDraws) {
     if (!cmdDrawIndexedIndirectCount) {
         throw std::runtime_error("vkCmdDrawIndexedIndirectCountKHR not available (draw-indirect-count required)");
     }
+    if (clusterCullPipeline != VK_NULL_HANDLE) {
+        // Cluster draws: `maxDraws` counts chunks, so the record pool bounds it instead.
+        cmdDrawIndexedIndirectCount(cmd, clusterCompactBuffers[currentCullFrame].buffer, 0,
+                                    clusterCounterBuffers[currentCullFrame].buffer, 0,
+                                    clusterCapacity, sizeof(VkDrawIndexedIndirectCommand));
+        return;
+    }
     // Use indirect-count variant to let the GPU supply the visible count from compute shader
     cmdDrawIndexedIndirectCount(cmd, compactIndirectBuffers[currentCullFrame].buffer, 0, visibleCountBuffers[currentCullFrame].buffer, 0, maxCount, sizeof(VkDrawIndexedIndirectCommand));
 }
@@ -1980,6 +1963,12 @@ void IndirectRenderer::drawIndirectOnly(VkCommandBuffer cmd, VkPipelineLayout pi
     if (!cmdDrawIndexedIndirectCount) {
         throw std::runtime_error("vkCmdDrawIndexedIndirectCountKHR not available (draw-indirect-count required)");
     }
+    if (clusterCullPipeline != VK_NULL_HANDLE) {
+        cmdDrawIndexedIndirectCount(cmd, clusterCompactBuffers[currentCullFrame].buffer, 0,
+                                    clusterCounterBuffers[currentCullFrame].buffer, 0,
+                                    clusterCapacity, sizeof(VkDrawIndexedIndirectCommand));
+        return;
+    }
     cmdDrawIndexedIndirectCount(cmd, compactBuf.buffer, 0, visibleCount.buffer, 0, maxCount, sizeof(VkDrawIndexedIndirectCommand));
 }
 
@@ -2000,6 +1989,19 @@ uint32_t IndirectRenderer::readVisibleCount(VulkanApp* app) const {
     return 0;
 }
 
+IndirectRenderer::ClusterCullStats IndirectRenderer::readClusterCullStats() const {
+    // Same lock-free read as readVisibleCount: the slot's last write is from
+    // an already completed frame.
+    ClusterCullStats stats{};
+    const uint32_t* counters = clusterCounterMapped[currentCullFrame];
+    if (counters) {
+        stats.visibleClusters    = counters[0];
+        stats.submittedTriangles = counters[1];
+        stats.visibleTriangles   = counters[2];
+    }
+    return stats;
+}
+
 
 
 IndirectRenderer::MeshInfo IndirectRenderer::getMeshInfo(uint32_t meshId) const {
@@ -2085,6 +2087,16 @@ void IndirectRenderer::initSlots(VulkanApp* app,
     spaceAlloc.reserve(static_cast<uint32_t>(vertexCapacity),
                        static_cast<uint32_t>(indexCapacity));
 
+    // Cluster-record pool: one record per TRIANGLES_PER_CLUSTER triangles of
+    // the index pool, plus two partial clusters per chunk (rounding and
+    // best-fit fragmentation headroom).
+    if (clusterCullingRequested) {
+        clusterCapacity = static_cast<uint32_t>(indexCapacity / (3 * MeshClusters::TRIANGLES_PER_CLUSTER)
+                                                + 2 * meshCapacity);
+        spaceAlloc.reserveClusters(clusterCapacity);
+        clusterRecords.assign(clusterCapacity, ClusterRecord{});
+    }
+
     // Pre-size the CPU-side merged buffers (one element per pool, fixed at
     // init). The chunk's span is written into its allocated sub-range.
     mergedVertices.resize(vertexCapacity);
@@ -2099,16 +2111,18 @@ void IndirectRenderer::initSlots(VulkanApp* app,
     // These are created ONCE and never rebuilt. Individual slots are updated
     // in-place without touching other slots or the buffer layout.
 
-    // Vertex buffer (device-local)
+    // Vertex buffer (device-local). STORAGE: surface_nets.comp writes the
+    // GPU-meshed chunks' spans directly.
+    const VkBufferUsageFlags meshingUsage = gpuMeshingRequested ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT : 0;
     VkDeviceSize vertexBufferSize = vertexCapacity * sizeof(Vertex);
     vertexBuffer = app->createBuffer(vertexBufferSize,
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | meshingUsage,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
     // Index buffer (device-local)
     VkDeviceSize indexBufferSize = indexCapacity * sizeof(uint32_t);
     indexBuffer = app->createBuffer(indexBufferSize,
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | meshingUsage,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
     // Indirect buffer (host-visible, persistently mapped for per-slot writes).
@@ -2202,52 +2216,19 @@ void IndirectRenderer::initSlots(VulkanApp* app,
         // Five bindings (0..4): input commands, count, bounds, output commands,
         // chosen-LoD output. Was sized 4 with an out-of-bounds write to
         // bindings[4] (stack smash) — must match the 5-entry createLayout.
-        VkDescriptorSetLayoutBinding bindings[5] = {};
-        bindings[0].binding = 0;
-        bindings[0].descriptorCount = 1;
-        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[1].binding = 1;
-        bindings[1].descriptorCount = 1;
-        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[2].binding = 2;
-        bindings[2].descriptorCount = 1;
-        bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[3].binding = 3;
-        bindings[3].descriptorCount = 1;
-        bindings[3].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        bindings[4].binding = 4;
-        bindings[4].descriptorCount = 1;
-        bindings[4].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-        bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-
-        VkDescriptorBindingFlags bindingFlags[5] = {
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
-            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
-        };
-
-        DescriptorAllocator descAlloc{app->getDevice(), app};
-        computeDescriptorSetLayout = descAlloc.createLayout(
-            bindings, 5,
-            VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-            bindingFlags,
-            "IndirectRenderer: computeDescriptorSetLayout");
+        // The cull buffers are read through the bindless heap (set 0 here),
+        // addressed by the slots in the push constants.
+        VkDescriptorSetLayout heapLayout = app->getBindlessHeap().getLayout();
 
         VkPushConstantRange pc{};
         pc.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
         pc.offset = 0;
-        pc.size = sizeof(CullPushConstants); // 96 bytes: mat4 + 2*uint + pad + vec3 + float
+        pc.size = sizeof(CullPushConstants); // 116 bytes: mat4 + 2*uint + pad + vec3 + float + 5 slots
 
         VkPipelineLayoutCreateInfo plinfo{};
         plinfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         plinfo.setLayoutCount = 1;
-        plinfo.pSetLayouts = &computeDescriptorSetLayout;
+        plinfo.pSetLayouts = &heapLayout;
         plinfo.pushConstantRangeCount = 1;
         plinfo.pPushConstantRanges = &pc;
 
@@ -2273,56 +2254,9 @@ void IndirectRenderer::initSlots(VulkanApp* app,
             throw std::runtime_error("failed to create compute pipeline!");
         }
         app->resources.addPipeline(computePipeline, "IndirectRenderer: computePipeline");
-
-        VkDescriptorPoolSize irPoolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 256};
-        computeDescriptorPool = descAlloc.createPool(
-            &irPoolSize, 1, 64,
-            VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-            "IndirectRenderer: computeDescriptorPool");
-
-        descAlloc.allocateSets(computeDescriptorPool, computeDescriptorSetLayout,
-                               MAX_CULL_FRAMES, reinterpret_cast<VkDescriptorSet*>(computeDescriptorSets.data()),
-                               "IndirectRenderer: computeDescriptorSet");
     }
 
-    // Update per-frame compute descriptor sets with buffer info
-    VkDescriptorBufferInfo inBuf{};
-    inBuf.buffer = indirectBuffer.buffer;
-    inBuf.offset = 0;
-    inBuf.range = VK_WHOLE_SIZE;
-    VkDescriptorBufferInfo boundsBufInfo{};
-    boundsBufInfo.buffer = boundsBuffer.buffer;
-    boundsBufInfo.offset = 0;
-    boundsBufInfo.range = VK_WHOLE_SIZE;
-
-    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
-        VkDescriptorBufferInfo outBuf{};
-        outBuf.buffer = compactIndirectBuffers[f].buffer;
-        outBuf.offset = 0;
-        outBuf.range = VK_WHOLE_SIZE;
-        VkDescriptorBufferInfo countBuf{};
-        countBuf.buffer = visibleCountBuffers[f].buffer;
-        countBuf.offset = 0;
-        countBuf.range = VK_WHOLE_SIZE;
-        VkDescriptorBufferInfo lodBuf{};
-        lodBuf.buffer = visibleLodBuffers[f].buffer;
-        lodBuf.offset = 0;
-        lodBuf.range = VK_WHOLE_SIZE;
-
-        VkDescriptorSet computeDs = computeDescriptorSets[f];
-        DescriptorWriter(app->getDevice())
-            .writeBuffer(computeDs, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         inBuf.buffer, inBuf.offset, inBuf.range)
-            .writeBuffer(computeDs, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         outBuf.buffer, outBuf.offset, outBuf.range)
-            .writeBuffer(computeDs, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         boundsBufInfo.buffer, boundsBufInfo.offset, boundsBufInfo.range)
-            .writeBuffer(computeDs, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         countBuf.buffer, countBuf.offset, countBuf.range)
-            .writeBuffer(computeDs, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         lodBuf.buffer, lodBuf.offset, lodBuf.range)
-            .flush();
-    }
+    registerCullSlots(app);
 
     // Load indirect-count draw function
     cmdDrawIndexedIndirectCount = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(app->getDevice(), "vkCmdDrawIndexedIndirectCountKHR");
@@ -2339,6 +2273,8 @@ void IndirectRenderer::initSlots(VulkanApp* app,
 
     // Initialize cascade-aware culling resources
     initCascadeCull(app);
+    if (clusterCapacity > 0) initClusterCull(app);
+    if (gpuMeshingRequested) initSurfaceNets(app);
 
     std::cerr << "[IndirectRenderer::initSlots] maxActiveChunks=" << maxActiveChunks
               << " meshCapacity=" << meshCapacity
@@ -2411,6 +2347,7 @@ uint32_t IndirectRenderer::addMeshSlotted(const Geometry& mesh, uint32_t chunkId
         return UINT32_MAX;
     }
     const uint32_t entryIndex = slotIdx; // draw entry == slot (one entry per chunk)
+    if (!isNewChunk) cancelPendingBricks(entryIndex, existing->second.level_);
 
     // Pack this chunk's geometry into its own span of the shared element
     // pools (first-fit/best-fit free-space allocator). The old span — if any —
@@ -2454,10 +2391,15 @@ uint32_t IndirectRenderer::addMeshSlotted(const Geometry& mesh, uint32_t chunkId
                     spaceAlloc.freeVertex(prev.oldVertexBase, prev.oldVertexCount);
                     spaceAlloc.freeIndex(prev.oldIndexBase, prev.oldIndexCount);
                 }
+                releaseClusterSpan(prev.oldClusterBase, prev.oldClusterCount);
                 prev.oldVertexBase = prev.baseVertex;
                 prev.oldVertexCount = prev.vertexCount;
                 prev.oldIndexBase  = prev.firstIndex;
                 prev.oldIndexCount = prev.indexCount;
+                prev.oldClusterBase  = prev.firstCluster;
+                prev.oldClusterCount = prev.clusterCount;
+                prev.firstCluster = UINT32_MAX;
+                prev.clusterCount = 0;
             }
         }
 
@@ -2482,6 +2424,7 @@ uint32_t IndirectRenderer::addMeshSlotted(const Geometry& mesh, uint32_t chunkId
         if (cubeMin && cubeMax) {
             ld.boundsMin = glm::vec4(*cubeMin, 0.0f);
             ld.boundsMax = glm::vec4(*cubeMax, 0.0f);
+            if (level >= 0) frontierCellSize.store(std::ldexp(cubeMax->x - cubeMin->x, -level), std::memory_order_relaxed);
         } else if (mesh.vertices.empty()) {
             ld.boundsMin = glm::vec4(0.0f);
             ld.boundsMax = glm::vec4(0.0f);
@@ -2496,6 +2439,7 @@ uint32_t IndirectRenderer::addMeshSlotted(const Geometry& mesh, uint32_t chunkId
         }
         // Copy geometry data into the chunk's packed span (absolute positions).
         copyGeometryToLevel(mesh, ld);
+        if (clusterCapacity > 0) buildChunkClusters(mesh, entryIndex, ld);
 
         // Publish the CPU-side indirect command for this entry (the GPU
         // buffers stay zeroed until the deferred writeSlotMeta after upload).
@@ -2523,6 +2467,8 @@ uint32_t IndirectRenderer::addMeshSlotted(const Geometry& mesh, uint32_t chunkId
             if (prev.allocated) {
                 spaceAlloc.freeVertex(prev.baseVertex, prev.vertexCount);
                 spaceAlloc.freeIndex(prev.firstIndex, prev.indexCount);
+                releaseClusterSpan(prev.firstCluster, prev.clusterCount);
+                releaseClusterSpan(prev.oldClusterBase, prev.oldClusterCount);
                 prev = MeshInfo::LevelData{};
             }
         } else {
@@ -2583,6 +2529,7 @@ void IndirectRenderer::removeMeshSlotted(uint32_t slotIndex)
 
     if (info) {
         MeshInfo::LevelData& ld = info->level_;
+        cancelPendingBricks(slotIndex, ld);
         // A pending deferred old-span free can never fire anymore (no upload
         // of this chunk is in flight once the entry is zeroed below): release
         // it now.
@@ -2594,6 +2541,8 @@ void IndirectRenderer::removeMeshSlotted(uint32_t slotIndex)
             spaceAlloc.freeVertex(ld.baseVertex, ld.vertexCount);
             spaceAlloc.freeIndex(ld.firstIndex, ld.indexCount);
         }
+        releaseClusterSpan(ld.oldClusterBase, ld.oldClusterCount);
+        releaseClusterSpan(ld.firstCluster, ld.clusterCount);
         ld = MeshInfo::LevelData{};
     }
 
@@ -2657,12 +2606,18 @@ bool IndirectRenderer::uploadSlot(VulkanApp* app, uint32_t slotIndex, float prio
     uint32_t capOldVertexCount     = ld.oldVertexCount;
     uint32_t capOldIndexBase       = ld.oldIndexBase;
     uint32_t capOldIndexCount      = ld.oldIndexCount;
+    uint32_t capFirstCluster       = ld.firstCluster;
+    uint32_t capClusterCount       = ld.clusterCount;
+    uint32_t capOldClusterBase     = ld.oldClusterBase;
+    uint32_t capOldClusterCount    = ld.oldClusterCount;
     // Consume the pending old-span record: it is handed to the completion
     // callback below (freed once the replacement is resident on GPU). A second
     // republish before this upload completes would otherwise chain its old
     // span on top of this one.
     ld.oldVertexBase = UINT32_MAX;
     ld.oldIndexBase  = UINT32_MAX;
+    ld.oldClusterBase  = UINT32_MAX;
+    ld.oldClusterCount = 0;
 
     // Calculate vertex/index byte ranges for this chunk's packed span
     VkDeviceSize vertexBytes = static_cast<VkDeviceSize>(ld.vertexCount) * sizeof(Vertex);
@@ -2709,7 +2664,9 @@ bool IndirectRenderer::uploadSlot(VulkanApp* app, uint32_t slotIndex, float prio
     auto deferredWriteMeta = [this, capEntryIndex, capIndexCount, capFirstIndex,
                               capVertexOffset, capBoundsMin, capBoundsMax, capLevel,
                               capOldVertexBase, capOldVertexCount,
-                              capOldIndexBase, capOldIndexCount]()
+                              capOldIndexBase, capOldIndexCount,
+                              capFirstCluster, capClusterCount,
+                              capOldClusterBase, capOldClusterCount]()
     {
         std::lock_guard<std::recursive_mutex> lock(mutex);
         if (capEntryIndex >= indirectCommands.size()) return;
@@ -2739,18 +2696,29 @@ bool IndirectRenderer::uploadSlot(VulkanApp* app, uint32_t slotIndex, float prio
                 // level (stored chunkLod 5 → level 4), so the cascade cull
                 // applies the same keep rule as the main pass.
                 const float cellSize = capBoundsMax.x - capBoundsMin.x;
-                const glm::vec4 lodMeta = glm::vec4(cellSize, static_cast<float>(capLevel), 4.0f, 0.0f);
+                const glm::vec4 lodMeta = glm::vec4(cellSize, static_cast<float>(capLevel), static_cast<float>(MAX_LOD_LEVEL), 0.0f);
                 glm::vec4 bounds[3] = { capBoundsMin, capBoundsMax, lodMeta };
                 std::memcpy(bndData, bounds, sizeof(bounds));
                 boundsBuffer.unmap();
             }
         }
 
+        // Publish the chunk's cluster records from the CPU mirror — unless
+        // the span was released (and possibly reused by another chunk) by a
+        // removal or a newer publish that completed first.
+        if (capClusterCount > 0 && capFirstCluster + capClusterCount <= clusterRecords.size()) {
+            const ClusterRecord& head = clusterRecords[capFirstCluster];
+            if (head.entryIndex == capEntryIndex && head.firstIndex == capFirstIndex && head.indexCount != 0) {
+                writeClusterRecords(capFirstCluster, &head, capClusterCount);
+            }
+        }
+
         // Free the chunk's replaced span now that the replacement is resident.
         if (capOldVertexBase != UINT32_MAX) {
             spaceAlloc.freeVertex(capOldVertexBase, capOldVertexCount);
             spaceAlloc.freeIndex(capOldIndexBase, capOldIndexCount);
         }
+        releaseClusterSpan(capOldClusterBase, capOldClusterCount);
     };
 
     auto chained = [deferredWriteMeta = std::move(deferredWriteMeta),
@@ -3125,19 +3093,720 @@ void IndirectRenderer::prepareCullCascades(VkCommandBuffer cmd,
     }
 }
 
-void IndirectRenderer::drawCascadeOnly(VkCommandBuffer cmd, uint32_t cascadeIndex) {
-    if (cascadeIndex >= 3) return;
-    if (!cascadeCullInited) return;
+bool IndirectRenderer::drawCascadeOnly(VkCommandBuffer cmd, uint32_t cascadeIndex) {
+    if (cascadeIndex >= 3) return false;
+    if (!cascadeCullInited) return false;
     Buffer& compactBuf = cascadeCullFrames[currentCullFrame].compactBuffers[cascadeIndex];
     Buffer& countBuf = cascadeCullFrames[currentCullFrame].countBuffers[cascadeIndex];
 
-    if (compactBuf.buffer == VK_NULL_HANDLE || countBuf.buffer == VK_NULL_HANDLE) return;
-    if (vertexBuffer.buffer == VK_NULL_HANDLE || indexBuffer.buffer == VK_NULL_HANDLE) return;
-    if (!cmdDrawIndexedIndirectCount) return;
+    if (compactBuf.buffer == VK_NULL_HANDLE || countBuf.buffer == VK_NULL_HANDLE) return false;
+    if (vertexBuffer.buffer == VK_NULL_HANDLE || indexBuffer.buffer == VK_NULL_HANDLE) return false;
+    if (!cmdDrawIndexedIndirectCount) return false;
 
     uint32_t maxCount = static_cast<uint32_t>(meshCapacity);
     if (maxCount == 0) maxCount = 1024;
 
     // Cascade compact + cascade count (full cascade buffers)
     cmdDrawIndexedIndirectCount(cmd, compactBuf.buffer, 0, countBuf.buffer, 0, maxCount, sizeof(VkDrawIndexedIndirectCommand));
+    return true;
+}
+
+// ── Cluster culling ──────────────────────────────────────────────────────────
+
+void IndirectRenderer::buildChunkClusters(const Geometry& mesh, uint32_t entryIndex,
+                                          MeshInfo::LevelData& ld) {
+    ld.firstCluster = UINT32_MAX;
+    ld.clusterCount = 0;
+    const uint32_t count = MeshClusters::clusterCount(ld.indexCount);
+    if (count == 0) return;
+
+    const uint32_t base = spaceAlloc.allocateCluster(count);
+    if (base == UINT32_MAX) {
+        // The chunk keeps its draw entry but produces no cluster draws until
+        // it is republished; the pool is sized with per-chunk headroom, so
+        // this only happens under extreme fragmentation.
+        auto now = std::chrono::steady_clock::now();
+        if (now - g_lastNoSlotLog >= std::chrono::seconds(1)) {
+            g_lastNoSlotLog = now;
+            std::cerr << "[IndirectRenderer] addMeshSlotted: cluster pool exhausted (clusters=" << count
+                      << "; used=" << spaceAlloc.usedCluster()
+                      << "/" << spaceAlloc.totalCluster() << ")" << std::endl;
+        }
+        return;
+    }
+
+    // Reorders the chunk's index span in place: the upload that follows
+    // copies the clustered order, so every record addresses a contiguous run.
+    std::vector<ClusterRecord> built;
+    built.reserve(count);
+    MeshClusters::build(mesh.vertices.data(), static_cast<uint32_t>(mesh.vertices.size()),
+                        &mergedIndices[ld.firstIndex], ld.indexCount,
+                        ld.firstIndex, entryIndex, mesh.clusterOrdered, built);
+    std::copy(built.begin(), built.end(), clusterRecords.begin() + base);
+    ld.firstCluster = base;
+    ld.clusterCount = count;
+    noteClusterSpan(base, count);
+}
+
+void IndirectRenderer::noteClusterSpan(uint32_t base, uint32_t count) {
+    clusterSpans[base] = count;
+    ++clusterSpansVersion;
+}
+
+void IndirectRenderer::writeClusterRecords(uint32_t base, const ClusterRecord* records, uint32_t count) {
+    if (count == 0 || clusterBuffer.buffer == VK_NULL_HANDLE) return;
+    if (base >= clusterCapacity || count > clusterCapacity - base) return;
+    // Direct host write, like the deferred cmd/bounds publish: a cull that
+    // observes a half-written record is still bounded by the range check
+    // against its entry's draw command in cluster_cull.comp.
+    void* data = clusterBuffer.map(static_cast<VkDeviceSize>(base) * sizeof(ClusterRecord));
+    if (!data) return;
+    if (records) std::memcpy(data, records, count * sizeof(ClusterRecord));
+    else std::memset(data, 0, count * sizeof(ClusterRecord));
+    clusterBuffer.unmap();
+}
+
+void IndirectRenderer::releaseClusterSpan(uint32_t base, uint32_t count) {
+    if (base == UINT32_MAX || count == 0 || clusterCapacity == 0) return;
+    // Zero before freeing: a stale record whose entry slot is later reused by
+    // a chunk with an overlapping index range would pass the shader's range
+    // check and draw foreign triangles.
+    std::fill_n(clusterRecords.begin() + base, count, ClusterRecord{});
+    writeClusterRecords(base, nullptr, count);
+    spaceAlloc.freeCluster(base, count);
+    if (clusterSpans.erase(base) > 0) ++clusterSpansVersion;
+}
+
+void IndirectRenderer::initClusterCull(VulkanApp* app) {
+    if (clusterCullPipeline != VK_NULL_HANDLE || clusterCapacity == 0) return;
+    VkDevice device = app->getDevice();
+
+    // Record pool (host-visible: written by upload completions, zeroed up front
+    // so the shader skips never-published records on indexCount == 0).
+    VkDeviceSize recordBytes = sizeof(ClusterRecord) * clusterCapacity;
+    clusterBuffer = app->createBuffer(recordBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (void* data = clusterBuffer.map(0)) {
+        std::memset(data, 0, (size_t)recordBytes);
+        clusterBuffer.unmap();
+    }
+
+    VkDeviceSize compactSize = sizeof(VkDrawIndexedIndirectCommand) * clusterCapacity;
+    VkDeviceSize counterSize = sizeof(uint32_t) * 4;
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        clusterCompactBuffers[f] = app->createBuffer(compactSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        clusterCounterBuffers[f] = app->createBuffer(counterSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        clusterCounterMapped[f] = static_cast<uint32_t*>(clusterCounterBuffers[f].map(0));
+        if (clusterCounterMapped[f]) std::memset(clusterCounterMapped[f], 0, (size_t)counterSize);
+        clusterListBuffers[f] = app->createBuffer(sizeof(uint32_t) * clusterCapacity,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        clusterListCount[f] = 0;
+        clusterListVersion[f] = UINT64_MAX;
+    }
+
+    // 0: clusters, 1: inCmds, 2: bounds, 3: outCmds, 4: counters, 5: live list
+    std::array<VkDescriptorSetLayoutBinding, 6> bindings{};
+    VkDescriptorBindingFlags bindingFlags[6];
+    for (uint32_t i = 0; i < 6; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindingFlags[i] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+    }
+
+    DescriptorAllocator descAlloc{device, app};
+    clusterCullDescSetLayout = descAlloc.createLayout(
+        bindings.data(), 6,
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        bindingFlags,
+        "IndirectRenderer: clusterCullDescSetLayout");
+
+    VkPushConstantRange pc{};
+    pc.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pc.offset = 0;
+    pc.size = sizeof(CullPushConstants); // same block as indirect.comp (numCmds = live cluster count)
+
+    VkPipelineLayoutCreateInfo plinfo{};
+    plinfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    plinfo.setLayoutCount = 1;
+    plinfo.pSetLayouts = &clusterCullDescSetLayout;
+    plinfo.pushConstantRangeCount = 1;
+    plinfo.pPushConstantRanges = &pc;
+
+    if (vkCreatePipelineLayout(device, &plinfo, nullptr, &clusterCullPipelineLayout) != VK_SUCCESS)
+        throw std::runtime_error("failed to create cluster cull pipeline layout!");
+    app->resources.addPipelineLayout(clusterCullPipelineLayout, "IndirectRenderer: clusterCullPipelineLayout");
+
+    VkShaderModule compModule = app->getOrCreateShaderModule("shaders/cluster_cull.comp.spv");
+    VkPipelineShaderStageCreateInfo stage{};
+    stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    stage.module = compModule;
+    stage.pName = "main";
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = stage;
+    pipelineInfo.layout = clusterCullPipelineLayout;
+    if (vkCreateComputePipelines(device, app->getPipelineCache(), 1, &pipelineInfo, nullptr, &clusterCullPipeline) != VK_SUCCESS)
+        throw std::runtime_error("failed to create cluster cull compute pipeline!");
+    app->resources.addPipeline(clusterCullPipeline, "IndirectRenderer: clusterCullPipeline");
+
+    VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 6 * MAX_CULL_FRAMES};
+    clusterCullDescPool = descAlloc.createPool(
+        &poolSize, 1, MAX_CULL_FRAMES,
+        VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        "IndirectRenderer: clusterCullDescPool");
+    descAlloc.allocateSets(clusterCullDescPool, clusterCullDescSetLayout,
+                           MAX_CULL_FRAMES, reinterpret_cast<VkDescriptorSet*>(clusterCullDescSets.data()),
+                           "IndirectRenderer: clusterCullDescSet");
+
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        VkDescriptorSet ds = clusterCullDescSets[f];
+        DescriptorWriter(device)
+            .writeBuffer(ds, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         clusterBuffer.buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         indirectBuffer.buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         boundsBuffer.buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         clusterCompactBuffers[f].buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         clusterCounterBuffers[f].buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         clusterListBuffers[f].buffer, 0, VK_WHOLE_SIZE)
+            .flush();
+    }
+
+    std::cerr << "[IndirectRenderer::initClusterCull] clusterCapacity=" << clusterCapacity
+              << " (" << MeshClusters::TRIANGLES_PER_CLUSTER << " triangles/cluster)" << std::endl;
+}
+
+void IndirectRenderer::destroyClusterCull() {
+    // Buffers, pipeline objects and sets are owned by VulkanResourceManager.
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        if (clusterCounterMapped[f]) {
+            clusterCounterBuffers[f].unmap();
+            clusterCounterMapped[f] = nullptr;
+        }
+        clusterCounterBuffers[f] = {};
+        clusterCompactBuffers[f] = {};
+        clusterListBuffers[f] = {};
+        clusterListCount[f] = 0;
+        clusterListVersion[f] = UINT64_MAX;
+        clusterCullDescSets[f] = VK_NULL_HANDLE;
+    }
+    clusterBuffer = {};
+    clusterRecords.clear();
+    clusterCapacity = 0;
+    clusterSpans.clear();
+    ++clusterSpansVersion;
+    clusterCullPipeline = VK_NULL_HANDLE;
+    clusterCullPipelineLayout = VK_NULL_HANDLE;
+    clusterCullDescSetLayout = VK_NULL_HANDLE;
+    clusterCullDescPool = VK_NULL_HANDLE;
+}
+
+void IndirectRenderer::dispatchClusterCull(VkCommandBuffer cmd, const glm::mat4& viewProj,
+                                           glm::vec3 camPos, float lodBias) {
+    Buffer& compactBuf = clusterCompactBuffers[currentCullFrame];
+    Buffer& counterBuf = clusterCounterBuffers[currentCullFrame];
+    if (compactBuf.buffer == VK_NULL_HANDLE || counterBuf.buffer == VK_NULL_HANDLE) return;
+
+    // One invocation per live cluster. The list is rebuilt only when a span
+    // was allocated or released since this frame's last dispatch; the slot's
+    // previous dispatch has retired by the time the cull frame comes round.
+    uint32_t numClusters = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        const uint32_t f = currentCullFrame;
+        if (clusterListVersion[f] != clusterSpansVersion && clusterListBuffers[f].buffer != VK_NULL_HANDLE) {
+            uint32_t n = 0;
+            if (auto* ids = static_cast<uint32_t*>(clusterListBuffers[f].map(0))) {
+                for (const auto& [base, count] : clusterSpans) {
+                    for (uint32_t c = 0; c < count && n < clusterCapacity; ++c) ids[n++] = base + c;
+                }
+                clusterListBuffers[f].unmap();
+            }
+            clusterListCount[f] = n;
+            clusterListVersion[f] = clusterSpansVersion;
+        }
+        numClusters = clusterListCount[f];
+    }
+
+    // Same fill/barrier discipline as the chunk pass: order prior indirect
+    // reads and atomics before the fills, then the fills before the dispatch.
+    // The compact buffer is zeroed whole for the same reason as
+    // compactIndirectBuffers (no garbage indexCount may ever reach the GE).
+    VkBufferMemoryBarrier2 pre[2] = {};
+    pre[0].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    pre[0].srcStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT
+                        | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                        | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    pre[0].srcAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT
+                         | VK_ACCESS_2_SHADER_READ_BIT
+                         | VK_ACCESS_2_SHADER_WRITE_BIT
+                         | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    pre[0].dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    pre[0].dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    pre[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pre[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pre[0].buffer = compactBuf.buffer;
+    pre[0].offset = 0;
+    pre[0].size = VK_WHOLE_SIZE;
+    pre[1] = pre[0];
+    pre[1].buffer = counterBuf.buffer;
+
+    VkDependencyInfo depInfo{};
+    depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    depInfo.bufferMemoryBarrierCount = 2;
+    depInfo.pBufferMemoryBarriers = pre;
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    vkCmdFillBuffer(cmd, counterBuf.buffer, 0, VK_WHOLE_SIZE, 0);
+    vkCmdFillBuffer(cmd, compactBuf.buffer, 0, VK_WHOLE_SIZE, 0);
+
+    for (auto& b : pre) {
+        b.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        b.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        b.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        b.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+    }
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    if (numClusters > 0) {
+        VkDescriptorSet descSet = clusterCullDescSets[currentCullFrame];
+        if (cmdState) cmdState->bindComputePipeline(cmd, clusterCullPipeline);
+        else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, clusterCullPipeline);
+        if (cmdState) cmdState->bindComputeDescriptorSets(cmd, clusterCullPipelineLayout, 0, 1, &descSet, 0, nullptr);
+        else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, clusterCullPipelineLayout, 0, 1, &descSet, 0, nullptr);
+
+        CullPushConstants pc{};
+        pc.viewProj    = viewProj;
+        pc.targetLayer = 0;
+        pc.numCmds     = numClusters;
+        pc.camPos      = camPos;
+        pc.lodBias     = lodBias;
+        vkCmdPushConstants(cmd, clusterCullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pc);
+        vkCmdDispatch(cmd, (numClusters + 63) / 64, 1, 1);
+    }
+
+    // Publish the compacted clusters and the count to the indirect draws.
+    for (auto& b : pre) {
+        b.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        b.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        b.dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        b.dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT;
+    }
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+}
+
+// ── GPU meshing (Surface Nets) ───────────────────────────────────────────────
+
+uint32_t IndirectRenderer::addBrickSlotted(std::shared_ptr<const SurfaceNetsBrick> brick, uint32_t chunkId,
+                                           const glm::vec3& cubeMin, const glm::vec3& cubeMax, int level,
+                                           std::function<void()> onComplete)
+{
+    if (!slottedMode || !brick || surfaceNetsPipeline == VK_NULL_HANDLE) return UINT32_MAX;
+    if (brick->cells == 0 || brick->cells > SurfaceNets::MAX_CELLS) return UINT32_MAX;
+    const uint32_t neededVerts = brick->vertexCount;
+    const uint32_t neededIdxs  = brick->indexCount;
+    if (neededVerts == 0 || neededIdxs == 0) return UINT32_MAX;
+
+    std::lock_guard<std::recursive_mutex> guard(mutex);
+
+    auto existing = meshes.find(chunkId);
+    const bool isNewChunk = (existing == meshes.end() || !existing->second.active);
+    uint32_t slotIdx = isNewChunk ? UINT32_MAX : existing->second.slotIndex;
+    const bool newSlot = (slotIdx == UINT32_MAX);
+    if (newSlot) {
+        slotIdx = slotAlloc.allocate(1, 1);
+        if (slotIdx == UINT32_MAX) return UINT32_MAX;
+    }
+    if (slotIdx >= slotAlloc.capacity()) return UINT32_MAX;
+    const uint32_t entryIndex = slotIdx;
+
+    // Exact spans: surfaceNetsCount ran the kernel's counting pass on the CPU.
+    const uint32_t newVBase = spaceAlloc.allocateVertex(neededVerts);
+    const uint32_t newIBase = spaceAlloc.allocateIndex(neededIdxs);
+    if (newVBase == UINT32_MAX || newIBase == UINT32_MAX) {
+        if (newVBase != UINT32_MAX) spaceAlloc.freeVertex(newVBase, neededVerts);
+        if (newIBase != UINT32_MAX) spaceAlloc.freeIndex(newIBase, neededIdxs);
+        if (newSlot) slotAlloc.free(slotIdx);
+        auto now = std::chrono::steady_clock::now();
+        if (now - g_lastNoSlotLog >= std::chrono::seconds(1)) {
+            g_lastNoSlotLog = now;
+            std::cerr << "[IndirectRenderer] addBrickSlotted: element pool exhausted for chunk " << chunkId
+                      << " (verts=" << neededVerts << " idxs=" << neededIdxs << ")" << std::endl;
+        }
+        return UINT32_MAX;
+    }
+    if (!isNewChunk) cancelPendingBricks(entryIndex, existing->second.level_);
+
+    // Same deferred-free bookkeeping as addMeshSlotted + uploadSlot: the
+    // previous span stays resident until the replacement's frame retires.
+    PendingBrick pending;
+    MeshInfo* chunk = isNewChunk ? nullptr : &existing->second;
+    if (chunk) {
+        MeshInfo::LevelData& prev = chunk->level_;
+        if (prev.allocated) {
+            if (prev.oldVertexBase != UINT32_MAX) {
+                spaceAlloc.freeVertex(prev.oldVertexBase, prev.oldVertexCount);
+                spaceAlloc.freeIndex(prev.oldIndexBase, prev.oldIndexCount);
+            }
+            releaseClusterSpan(prev.oldClusterBase, prev.oldClusterCount);
+            pending.oldVertexBase = prev.baseVertex;
+            pending.oldVertexCount = prev.vertexCount;
+            pending.oldIndexBase = prev.firstIndex;
+            pending.oldIndexCount = prev.indexCount;
+            pending.oldClusterBase = prev.firstCluster;
+            pending.oldClusterCount = prev.clusterCount;
+        }
+    } else {
+        MeshInfo m{};
+        m.id        = chunkId;
+        m.slotIndex = slotIdx;
+        m.active    = true;
+        meshes[chunkId] = m;
+        chunk = &meshes[chunkId];
+    }
+
+    MeshInfo::LevelData& ld = chunk->level_;
+    ld = MeshInfo::LevelData{};
+    ld.allocated   = true;
+    ld.baseVertex  = newVBase;
+    ld.vertexCount = neededVerts;
+    ld.firstIndex  = newIBase;
+    ld.indexCount  = neededIdxs;
+    ld.level       = level;
+    ld.boundsMin   = glm::vec4(cubeMin, 0.0f);
+    ld.boundsMax   = glm::vec4(cubeMax, 0.0f);
+    if (level >= 0) frontierCellSize.store(std::ldexp(cubeMax.x - cubeMin.x, -level), std::memory_order_relaxed);
+
+    // Clusters in emission order (no reorder: the indices only exist on the
+    // GPU). Bounds are the chunk cube grown by one cell — apron vertices sit
+    // in the neighbouring cells — and no normal cone.
+    if (clusterCapacity > 0) {
+        const uint32_t count = MeshClusters::clusterCount(neededIdxs);
+        const uint32_t base = count > 0 ? spaceAlloc.allocateCluster(count) : UINT32_MAX;
+        if (base != UINT32_MAX) {
+            const uint32_t runIndices = 3 * MeshClusters::TRIANGLES_PER_CLUSTER;
+            const glm::vec3 pad(brick->cellSize);
+            for (uint32_t c = 0; c < count; ++c) {
+                ClusterRecord& r = clusterRecords[base + c];
+                r = ClusterRecord{};
+                r.firstIndex = newIBase + c * runIndices;
+                r.indexCount = std::min(runIndices, neededIdxs - c * runIndices);
+                r.entryIndex = entryIndex;
+                r.boundsMin = glm::vec4(cubeMin - pad, MeshClusters::NO_CONE_CUTOFF);
+                r.boundsMax = glm::vec4(cubeMax + pad, 0.0f);
+            }
+            ld.firstCluster = base;
+            ld.clusterCount = count;
+            noteClusterSpan(base, count);
+        }
+    }
+
+    indirectCommands[entryIndex].indexCount    = neededIdxs;
+    indirectCommands[entryIndex].instanceCount = 1;
+    indirectCommands[entryIndex].firstIndex    = newIBase;
+    indirectCommands[entryIndex].vertexOffset  = static_cast<int32_t>(newVBase);
+    indirectCommands[entryIndex].firstInstance = entryIndex;
+
+    chunk->baseVertex  = ld.baseVertex;
+    chunk->vertexCount = ld.vertexCount;
+    chunk->firstIndex  = ld.firstIndex;
+    chunk->indexCount  = ld.indexCount;
+    chunk->drawIndex   = entryIndex;
+    chunk->boundsMin   = ld.boundsMin;
+    chunk->boundsMax   = ld.boundsMax;
+    activeMeshCountDirty_ = true;
+
+    SurfaceNetsHeader& h = pending.header;
+    h.cells          = brick->cells;
+    h.baseVertex     = newVBase;
+    h.firstIndex     = newIBase;
+    h.entryIndex     = entryIndex;
+    h.vertexCapacity = neededVerts;
+    h.indexCapacity  = neededIdxs;
+    for (int k = 0; k < 3; ++k) {
+        h.base[k] = brick->base[k];
+        h.rootMin[k] = brick->rootMin[k];
+    }
+    h.cellSize    = brick->cellSize;
+    h.invCellSize = brick->invCellSize;
+    h.eps         = brick->eps;
+    // Same bounds triple as uploadSlot's deferred meta write.
+    const glm::vec4 lodMeta(cubeMax.x - cubeMin.x, static_cast<float>(level), static_cast<float>(MAX_LOD_LEVEL), 0.0f);
+    const glm::vec4 bounds[3] = { ld.boundsMin, ld.boundsMax, lodMeta };
+    std::memcpy(h.bounds, bounds, sizeof(bounds));
+
+    pending.brick = std::move(brick);
+    pending.firstCluster = ld.firstCluster;
+    pending.clusterCount = ld.clusterCount;
+    pending.onComplete = std::move(onComplete);
+    pendingBricks_.push_back(std::move(pending));
+    return slotIdx;
+}
+
+void IndirectRenderer::cancelPendingBricks(uint32_t entryIndex, MeshInfo::LevelData& ld) {
+    for (auto it = pendingBricks_.begin(); it != pendingBricks_.end(); ) {
+        if (it->header.entryIndex != entryIndex) {
+            ++it;
+            continue;
+        }
+        // Never dispatched: no frame drew the brick's spans, and its cluster
+        // records never reached the GPU, so they go back to the pools now.
+        spaceAlloc.freeVertex(it->header.baseVertex, it->header.vertexCapacity);
+        spaceAlloc.freeIndex(it->header.firstIndex, it->header.indexCapacity);
+        releaseClusterSpan(it->firstCluster, it->clusterCount);
+        // The draw entry still points at the spans the brick was replacing:
+        // they become the chunk's current spans again, so the publish that
+        // replaces the entry defers their free like any other.
+        ld.allocated    = it->oldVertexBase != UINT32_MAX;
+        ld.baseVertex   = ld.allocated ? it->oldVertexBase : 0;
+        ld.vertexCount  = ld.allocated ? it->oldVertexCount : 0;
+        ld.firstIndex   = ld.allocated ? it->oldIndexBase : 0;
+        ld.indexCount   = ld.allocated ? it->oldIndexCount : 0;
+        ld.firstCluster = it->oldClusterBase;
+        ld.clusterCount = it->oldClusterCount;
+        it = pendingBricks_.erase(it);
+    }
+}
+
+void IndirectRenderer::initSurfaceNets(VulkanApp* app) {
+    if (surfaceNetsPipeline != VK_NULL_HANDLE) return;
+    VkDevice device = app->getDevice();
+
+    // Input (host-visible, rewritten each frame like the meta stage buffers):
+    // SURFACE_NETS_BRICKS_PER_FRAME headers, then as many full grids.
+    const uint32_t gridCells = SurfaceNets::MAX_GRID * SurfaceNets::MAX_GRID * SurfaceNets::MAX_GRID;
+    const VkDeviceSize headerBytes = sizeof(SurfaceNetsHeader) * SURFACE_NETS_BRICKS_PER_FRAME;
+    const VkDeviceSize cellBytes = sizeof(SurfaceNetsCell) * gridCells * SURFACE_NETS_BRICKS_PER_FRAME;
+    const VkDeviceSize scratchBytes = sizeof(uint32_t) * gridCells * SURFACE_NETS_BRICKS_PER_FRAME;
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        surfaceNetsInput[f] = app->createBuffer(headerBytes + cellBytes,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        surfaceNetsScratch[f] = app->createBuffer(scratchBytes,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+
+    // 0: headers, 1: cells, 2: scratch, 3: vertices, 4: indices, 5: cmds, 6: bounds
+    constexpr uint32_t BINDINGS = 7;
+    std::array<VkDescriptorSetLayoutBinding, BINDINGS> bindings{};
+    VkDescriptorBindingFlags bindingFlags[BINDINGS];
+    for (uint32_t i = 0; i < BINDINGS; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindingFlags[i] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+    }
+
+    DescriptorAllocator descAlloc{device, app};
+    surfaceNetsDescSetLayout = descAlloc.createLayout(
+        bindings.data(), BINDINGS,
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        bindingFlags,
+        "IndirectRenderer: surfaceNetsDescSetLayout");
+
+    VkPipelineLayoutCreateInfo plinfo{};
+    plinfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    plinfo.setLayoutCount = 1;
+    plinfo.pSetLayouts = &surfaceNetsDescSetLayout;
+
+    if (vkCreatePipelineLayout(device, &plinfo, nullptr, &surfaceNetsPipelineLayout) != VK_SUCCESS)
+        throw std::runtime_error("failed to create surface nets pipeline layout!");
+    app->resources.addPipelineLayout(surfaceNetsPipelineLayout, "IndirectRenderer: surfaceNetsPipelineLayout");
+
+    VkShaderModule compModule = app->getOrCreateShaderModule("shaders/surface_nets.comp.spv");
+    VkPipelineShaderStageCreateInfo stage{};
+    stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    stage.module = compModule;
+    stage.pName = "main";
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = stage;
+    pipelineInfo.layout = surfaceNetsPipelineLayout;
+    if (vkCreateComputePipelines(device, app->getPipelineCache(), 1, &pipelineInfo, nullptr, &surfaceNetsPipeline) != VK_SUCCESS)
+        throw std::runtime_error("failed to create surface nets compute pipeline!");
+    app->resources.addPipeline(surfaceNetsPipeline, "IndirectRenderer: surfaceNetsPipeline");
+
+    VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, BINDINGS * MAX_CULL_FRAMES};
+    surfaceNetsDescPool = descAlloc.createPool(
+        &poolSize, 1, MAX_CULL_FRAMES,
+        VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        "IndirectRenderer: surfaceNetsDescPool");
+    descAlloc.allocateSets(surfaceNetsDescPool, surfaceNetsDescSetLayout,
+                           MAX_CULL_FRAMES, reinterpret_cast<VkDescriptorSet*>(surfaceNetsDescSets.data()),
+                           "IndirectRenderer: surfaceNetsDescSet");
+
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        VkDescriptorSet ds = surfaceNetsDescSets[f];
+        DescriptorWriter(device)
+            .writeBuffer(ds, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         surfaceNetsInput[f].buffer, 0, headerBytes)
+            .writeBuffer(ds, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         surfaceNetsInput[f].buffer, headerBytes, cellBytes)
+            .writeBuffer(ds, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         surfaceNetsScratch[f].buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         vertexBuffer.buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         indexBuffer.buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         indirectBuffer.buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(ds, 6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         boundsBuffer.buffer, 0, VK_WHOLE_SIZE)
+            .flush();
+    }
+
+    std::cerr << "[IndirectRenderer::initSurfaceNets] " << SURFACE_NETS_BRICKS_PER_FRAME
+              << " bricks/frame (" << (headerBytes + cellBytes) / 1024 << " KiB input per frame)" << std::endl;
+}
+
+void IndirectRenderer::destroySurfaceNets() {
+    // Buffers, pipeline objects and sets are owned by VulkanResourceManager.
+    // Queued completions are dropped with the meshes they would publish.
+    for (uint32_t f = 0; f < MAX_CULL_FRAMES; f++) {
+        surfaceNetsInput[f] = {};
+        surfaceNetsScratch[f] = {};
+        surfaceNetsDescSets[f] = VK_NULL_HANDLE;
+    }
+    pendingBricks_.clear();
+    retiringBricks_.clear();
+    surfaceNetsPipeline = VK_NULL_HANDLE;
+    surfaceNetsPipelineLayout = VK_NULL_HANDLE;
+    surfaceNetsDescSetLayout = VK_NULL_HANDLE;
+    surfaceNetsDescPool = VK_NULL_HANDLE;
+}
+
+void IndirectRenderer::dispatchSurfaceNets(VkCommandBuffer cmd) {
+    if (surfaceNetsPipeline == VK_NULL_HANDLE) return;
+    Buffer& input = surfaceNetsInput[currentCullFrame];
+    if (input.buffer == VK_NULL_HANDLE) return;
+
+    std::vector<PendingBrick> batch;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        if (pendingBricks_.empty()) return;
+        const size_t taken = std::min<size_t>(pendingBricks_.size(), SURFACE_NETS_BRICKS_PER_FRAME);
+        batch.assign(std::make_move_iterator(pendingBricks_.begin()),
+                     std::make_move_iterator(pendingBricks_.begin() + taken));
+        pendingBricks_.erase(pendingBricks_.begin(), pendingBricks_.begin() + taken);
+    }
+    if (batch.empty()) return;
+
+    // Headers then grids, each brick at a fixed MAX_GRID^3 stride.
+    const uint32_t gridCells = SurfaceNets::MAX_GRID * SurfaceNets::MAX_GRID * SurfaceNets::MAX_GRID;
+    const VkDeviceSize headerBytes = sizeof(SurfaceNetsHeader) * SURFACE_NETS_BRICKS_PER_FRAME;
+    auto* base = static_cast<uint8_t*>(input.map(0));
+    if (!base) return;
+    for (uint32_t i = 0; i < batch.size(); ++i) {
+        SurfaceNetsHeader& h = batch[i].header;
+        h.cellOffset = i * gridCells;
+        h.scratchOffset = i * gridCells;
+        std::memcpy(base + i * sizeof(SurfaceNetsHeader), &h, sizeof(h));
+        const std::vector<SurfaceNetsCell>& grid = batch[i].brick->grid;
+        std::memcpy(base + headerBytes + size_t(h.cellOffset) * sizeof(SurfaceNetsCell),
+                    grid.data(), grid.size() * sizeof(SurfaceNetsCell));
+    }
+    input.unmap();
+
+    // The kernel writes vertex/index spans and draw entries that earlier
+    // submissions read (other spans of the same buffers) and that this
+    // frame's staged meta copies just wrote (a recycled entry's zeroing).
+    VkMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT
+                         | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                         | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT
+                         | VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT
+                          | VK_ACCESS_2_SHADER_READ_BIT
+                          | VK_ACCESS_2_SHADER_WRITE_BIT
+                          | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT
+                          | VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT
+                          | VK_ACCESS_2_INDEX_READ_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+    VkDependencyInfo depInfo{};
+    depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    depInfo.memoryBarrierCount = 1;
+    depInfo.pMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    VkDescriptorSet descSet = surfaceNetsDescSets[currentCullFrame];
+    if (cmdState) cmdState->bindComputePipeline(cmd, surfaceNetsPipeline);
+    else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, surfaceNetsPipeline);
+    if (cmdState) cmdState->bindComputeDescriptorSets(cmd, surfaceNetsPipelineLayout, 0, 1, &descSet, 0, nullptr);
+    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, surfaceNetsPipelineLayout, 0, 1, &descSet, 0, nullptr);
+    vkCmdDispatch(cmd, static_cast<uint32_t>(batch.size()), 1, 1);
+
+    // Publish the meshes and patched entries to the culls and the draws.
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                         | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT
+                         | VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT
+                         | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT
+                          | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT
+                          | VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT
+                          | VK_ACCESS_2_INDEX_READ_BIT
+                          | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    for (auto& p : batch) {
+        // Cluster records go live with the entry they address (skipped when
+        // the span was released and reused meanwhile, as in uploadSlot).
+        if (p.clusterCount > 0 && p.firstCluster + p.clusterCount <= clusterRecords.size()) {
+            const ClusterRecord& head = clusterRecords[p.firstCluster];
+            if (head.entryIndex == p.header.entryIndex && head.firstIndex == p.header.firstIndex && head.indexCount != 0) {
+                writeClusterRecords(p.firstCluster, &head, p.clusterCount);
+            }
+        }
+        p.dispatchSerial = cullFrameSerial_;
+        p.brick.reset();
+        retiringBricks_.push_back(std::move(p));
+    }
+}
+
+void IndirectRenderer::retireSurfaceNets() {
+    std::vector<std::function<void()>> completions;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        if (retiringBricks_.empty()) return;
+        // Frame slots rotate every MAX_CULL_FRAMES setCullFrame calls; the
+        // slot's fence is waited before it is reused, so by then the frame
+        // that dispatched the brick has completed.
+        auto it = retiringBricks_.begin();
+        while (it != retiringBricks_.end()) {
+            if (cullFrameSerial_ < it->dispatchSerial + MAX_CULL_FRAMES) {
+                ++it;
+                continue;
+            }
+            if (it->oldVertexBase != UINT32_MAX) {
+                spaceAlloc.freeVertex(it->oldVertexBase, it->oldVertexCount);
+                spaceAlloc.freeIndex(it->oldIndexBase, it->oldIndexCount);
+            }
+            releaseClusterSpan(it->oldClusterBase, it->oldClusterCount);
+            if (it->onComplete) completions.push_back(std::move(it->onComplete));
+            it = retiringBricks_.erase(it);
+        }
+    }
+    for (auto& done : completions) done();
 }
@@ -9,7 +9,9 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include <unordered_map>
+#include <map>
 #include <mutex>
+#include <atomic>
 #include <cstdint>
 
 #include <array>
@@ -19,6 +21,9 @@
 #include "../includes/locations.hpp"
 #include "SlotAllocator.hpp"
 #include "PackedSpaceAllocator.hpp"
+#include "MeshClusters.hpp"
+#include "../../space/SurfaceNets.hpp"
+#include <memory>
 
 namespace streaming { class UploadManager; }
 
@@ -93,6 +98,12 @@ public:
             uint32_t oldVertexCount = 0;
             uint32_t oldIndexBase = UINT32_MAX;
             uint32_t oldIndexCount = 0;
+            // Cluster-record span (cluster culling only; count 0 otherwise),
+            // with the same deferred-free handling as the geometry span.
+            uint32_t firstCluster = UINT32_MAX;
+            uint32_t clusterCount = 0;
+            uint32_t oldClusterBase = UINT32_MAX;
+            uint32_t oldClusterCount = 0;
             glm::vec4 boundsMin = glm::vec4(0.0f);
             glm::vec4 boundsMax = glm::vec4(0.0f);
         };
@@ -214,10 +225,16 @@ public:
     // `camPos`/`lodBias` drive the per-chunk LoD band selection.
     void prepareCull(VkCommandBuffer cmd, const glm::mat4& viewProj,
                      glm::vec3 camPos = glm::vec3(0.0f), float lodBias = 8.0f);
-    // Run GPU culling into caller-provided output buffers using a provided compute descriptor set.
-    void prepareCullWithDescriptor(VkCommandBuffer cmd, const glm::mat4& viewProj, VkDescriptorSet computeDesc,
-                                   VkBuffer outCompactBuffer, VkBuffer outVisibleCountBuffer,
-                                   glm::vec3 camPos = glm::vec3(0.0f), float lodBias = 8.0f);
+    // Run GPU culling into caller-provided output buffers. `outCompactSlot` /
+    // `outVisibleCountSlot` are their bindless heap slots, registered once by
+    // the owner of the buffers (BindlessHeap::registerBuffer).
+    void prepareCullWithSlots(VkCommandBuffer cmd, const glm::mat4& viewProj,
+                              VkBuffer outCompactBuffer, uint32_t outCompactSlot,
+                              VkBuffer outVisibleCountBuffer, uint32_t outVisibleCountSlot,
+                              glm::vec3 camPos = glm::vec3(0.0f), float lodBias = 8.0f);
+    // False until the cull pipeline exists (no meshes yet): callers then draw
+    // the uncompacted commands instead of their own cull outputs.
+    bool isCullReady() const { return computePipeline != VK_NULL_HANDLE; }
     // Issue indirect draw using the compacted indirect buffer (call inside render pass).
     void drawPrepared(VkCommandBuffer cmd, uint32_t maxDraws = 0);
     void drawPreparedWithBuffers(VkCommandBuffer cmd, VkBuffer compactBuffer, VkBuffer visibleCountBuffer, uint32_t maxDraws = 0);
@@ -234,22 +251,63 @@ public:
                              const glm::mat4 cascadeMatrices[3],
                              glm::vec3 camPos = glm::vec3(0.0f), float lodBias = 8.0f);
     // Draw a specific cascade's compacted output (call inside render pass).
-    void drawCascadeOnly(VkCommandBuffer cmd, uint32_t cascadeIndex);
+    // Returns true if an indirect draw was recorded.
+    bool drawCascadeOnly(VkCommandBuffer cmd, uint32_t cascadeIndex);
+
+    // ── Cluster culling (main camera pass) ──
+    // Opt-in; call before initSlots(). Every published chunk mesh is split
+    // into ~128-triangle clusters (MeshClusters) stored in a third packed
+    // pool. prepareCull() then runs cluster_cull.comp after the chunk pass
+    // (frustum + normal-cone back-face test per cluster), and drawPrepared()/
+    // drawIndirectOnly() draw the compacted clusters instead of whole chunks.
+    // Cascade, cubemap and backface passes keep chunk granularity.
+    void setClusterCulling(bool enabled) { clusterCullingRequested = enabled; }
+    bool isClusterCullingActive() const { return clusterCullPipeline != VK_NULL_HANDLE; }
+    struct ClusterCullStats {
+        uint32_t visibleClusters = 0;
+        uint32_t submittedTriangles = 0; // triangles of chunks that passed the chunk cull
+        uint32_t visibleTriangles = 0;   // triangles left after cluster frustum + cone culling
+    };
+    // Non-blocking read of the current frame slot's counters (lags a few frames).
+    ClusterCullStats readClusterCullStats() const;
+
+    // ── GPU meshing (Surface Nets) ──
+    // Opt-in; call before initSlots(). addBrickSlotted() allocates the
+    // chunk's draw entry and exact vertex/index spans (brick->vertexCount/
+    // indexCount) like addMeshSlotted, but nothing is uploaded: the next
+    // prepareCull() runs surface_nets.comp over the queued bricks, which
+    // writes the mesh straight into the packed pools and patches the entry's
+    // draw command + bounds itself. `onComplete` and the replaced span's free
+    // run once that frame has retired (MAX_CULL_FRAMES later); a brick
+    // republished or removed before its dispatch is dropped with its
+    // completion, and the next publish takes over the span. Returns the
+    // slot index, or UINT32_MAX (inactive, pools exhausted) — the caller then
+    // keeps the CPU path.
+    void setGpuMeshing(bool enabled) { gpuMeshingRequested = enabled; }
+    bool isGpuMeshingActive() const { return surfaceNetsPipeline != VK_NULL_HANDLE; }
+    static constexpr uint32_t SURFACE_NETS_BRICKS_PER_FRAME = 8;
+    uint32_t addBrickSlotted(std::shared_ptr<const SurfaceNetsBrick> brick, uint32_t chunkId,
+                             const glm::vec3& cubeMin, const glm::vec3& cubeMax, int level,
+                             std::function<void()> onComplete = nullptr);
+
+    // ── LoD bands ──
+    // Coarsest ladder level (stored chunkLod 5 → level 4): written into every
+    // entry's LoD meta and mirrored by the geomorph vertex shader.
+    static constexpr int MAX_LOD_LEVEL = 4;
+    // Frontier cell size (chunk side / 2^level) of the published slotted
+    // chunks, 0 before the first publish: the unit of the LoD distance bands.
+    // Read from the render thread while generation threads publish.
+    float getFrontierCellSize() const { return frontierCellSize.load(std::memory_order_relaxed); }
 
     // Accessors
     const Buffer& getIndirectBuffer() const { return indirectBuffer; }
     const Buffer& getBoundsBuffer() const { return boundsBuffer; }
-    VkDescriptorSetLayout getComputeDescriptorSetLayout() const { return computeDescriptorSetLayout; }
 
     // Get the pre-allocated capacity (indirect command count / max slots)
     // In slotted mode this is the fixed slot pool size; in legacy mode it grows
     // with addMesh(). Used for sizing external compact buffers (e.g. cubemap).
     size_t getMeshCapacity() const { return meshCapacity; }
 
-    // Persistent scratch buffer bound to binding 4 of the cull compute layout
-    // by external descriptor-set owners (cubemap faces, async backface pass).
-    VkBuffer getVisibleLodsScratchBuffer() const { return visibleLodsScratch.buffer; }
-
     // Get count of active meshes (memoized: recomputed under the same mutex
     // only after a meshes mutation, so per-frame stats/sizing calls do not
     // scan the whole map).
@@ -358,12 +416,12 @@ private:
     // A temporary compact indirect buffer used to upload only visible commands — per-frame to avoid cross-frame races
     std::array<Buffer, MAX_CULL_FRAMES> compactIndirectBuffers;
     // Per-frame chosen-LoD output from the cull compute shader (uvec2 per kept
-    // entry: drawIndex, chosen level). Written by binding 4 of the cull
-    // pipeline; zeroed together with the compact buffer each prepareCull.
+    // entry: drawIndex, chosen level). Written by the cull pipeline
+    // (visibleLodsSlot); zeroed together with the compact buffer each prepareCull.
     std::array<Buffer, MAX_CULL_FRAMES> visibleLodBuffers;
-    // Dedicated visibleLods buffer for the caller-provided-descriptor paths
-    // (cubemap faces, async backface): those sets bind this scratch buffer so
-    // their dispatches never race the per-frame zero fills.
+    // Dedicated visibleLods buffer for the caller-provided-buffer paths
+    // (cubemap faces, async backface, prepareCullWithSlots): their dispatches
+    // write this scratch buffer so they never race the per-frame zero fills.
     Buffer visibleLodsScratch;
     // GPU-side culling resources
     Buffer boundsBuffer; // vec4 per draw entry: min, max, meta{cellSize, level, maxLevel, unused}
@@ -376,9 +434,21 @@ private:
     // Compute pipeline objects for GPU culling
     TrackedHandle<VkPipeline> computePipeline;
     TrackedHandle<VkPipelineLayout> computePipelineLayout;
-    TrackedHandle<VkDescriptorSetLayout> computeDescriptorSetLayout;
-    TrackedHandle<VkDescriptorPool> computeDescriptorPool;
-    std::array<TrackedHandle<VkDescriptorSet>, MAX_CULL_FRAMES> computeDescriptorSets;
+    // Bindless heap slots of the cull buffers; indirect.comp reads them from
+    // its push constants. Re-registered whenever the buffers are reallocated.
+    void registerCullSlots(VulkanApp* app);
+    void releaseCullSlots(VulkanApp* app);
+    static std::array<uint32_t, MAX_CULL_FRAMES> filledCullSlots() {
+        std::array<uint32_t, MAX_CULL_FRAMES> slots;
+        slots.fill(BindlessHeap::INVALID_INDEX);
+        return slots;
+    }
+    uint32_t indirectSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t boundsSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t visibleLodsScratchSlot = BindlessHeap::INVALID_INDEX;
+    std::array<uint32_t, MAX_CULL_FRAMES> compactSlots = filledCullSlots();
+    std::array<uint32_t, MAX_CULL_FRAMES> visibleCountSlots = filledCullSlots();
+    std::array<uint32_t, MAX_CULL_FRAMES> visibleLodSlots = filledCullSlots();
 
     // ── Cascade-aware culling (per-frame resources) ──
     struct CascadeCullFrame {
@@ -402,6 +472,87 @@ private:
     void updateCascadeDescriptor(VulkanApp* app, uint32_t frame);
     void refreshCascadeDescriptorsIfNeeded();
 
+    std::atomic<float> frontierCellSize{0.0f};
+
+    // ── Cluster culling (per-frame resources) ──
+    bool clusterCullingRequested = false;
+    uint32_t clusterCapacity = 0;
+    // Live record spans (base -> count); the cull dispatch covers only these,
+    // not the pool's high-water mark. Bumping clusterSpansVersion marks every
+    // frame's clusterListBuffers stale.
+    std::map<uint32_t, uint32_t> clusterSpans;
+    uint64_t clusterSpansVersion = 0;
+    void noteClusterSpan(uint32_t base, uint32_t count);
+    // CPU mirror of the cluster pool; copied into clusterBuffer on upload completion.
+    std::vector<ClusterRecord> clusterRecords;
+    Buffer clusterBuffer; // ClusterRecord per pool element (host-visible)
+    std::array<Buffer, MAX_CULL_FRAMES> clusterCompactBuffers;
+    // {count, submittedTriangles, visibleTriangles, pad} per cull frame
+    std::array<Buffer, MAX_CULL_FRAMES> clusterCounterBuffers;
+    mutable std::array<uint32_t*, MAX_CULL_FRAMES> clusterCounterMapped = {nullptr, nullptr, nullptr};
+    // Record index per live cluster, rebuilt from clusterSpans when stale
+    // (host-visible; one per cull frame so a rebuild never races a dispatch in flight)
+    std::array<Buffer, MAX_CULL_FRAMES> clusterListBuffers;
+    std::array<uint32_t, MAX_CULL_FRAMES> clusterListCount = {0, 0, 0};
+    std::array<uint64_t, MAX_CULL_FRAMES> clusterListVersion = {UINT64_MAX, UINT64_MAX, UINT64_MAX};
+    TrackedHandle<VkPipeline> clusterCullPipeline;
+    TrackedHandle<VkPipelineLayout> clusterCullPipelineLayout;
+    TrackedHandle<VkDescriptorSetLayout> clusterCullDescSetLayout;
+    TrackedHandle<VkDescriptorPool> clusterCullDescPool;
+    std::array<TrackedHandle<VkDescriptorSet>, MAX_CULL_FRAMES> clusterCullDescSets;
+    void initClusterCull(VulkanApp* app);
+    void destroyClusterCull();
+    // Main-thread dispatch recorded by prepareCull after the chunk pass.
+    void dispatchClusterCull(VkCommandBuffer cmd, const glm::mat4& viewProj,
+                             glm::vec3 camPos, float lodBias);
+    // Caller must hold `mutex`. Splits the chunk's index span into clusters
+    // (reordering it in mergedIndices) and allocates its record span.
+    void buildChunkClusters(const Geometry& mesh, uint32_t entryIndex, MeshInfo::LevelData& ld);
+    // Caller must hold `mutex`. Host write of `count` records starting at
+    // `base` into clusterBuffer (nullptr = zero them).
+    void writeClusterRecords(uint32_t base, const ClusterRecord* records, uint32_t count);
+    // Caller must hold `mutex`. Zero and release a record span.
+    void releaseClusterSpan(uint32_t base, uint32_t count);
+
+    // ── GPU meshing (per-frame resources) ──
+    bool gpuMeshingRequested = false;
+    struct PendingBrick {
+        std::shared_ptr<const SurfaceNetsBrick> brick;
+        SurfaceNetsHeader header;
+        uint32_t firstCluster = UINT32_MAX;
+        uint32_t clusterCount = 0;
+        uint64_t dispatchSerial = 0;
+        // The chunk's replaced spans, freed on retirement (as in uploadSlot).
+        uint32_t oldVertexBase = UINT32_MAX;
+        uint32_t oldVertexCount = 0;
+        uint32_t oldIndexBase = UINT32_MAX;
+        uint32_t oldIndexCount = 0;
+        uint32_t oldClusterBase = UINT32_MAX;
+        uint32_t oldClusterCount = 0;
+        std::function<void()> onComplete;
+    };
+    std::vector<PendingBrick> pendingBricks_;   // queued for the next dispatch
+    std::vector<PendingBrick> retiringBricks_;  // dispatched, frame still in flight
+    uint64_t cullFrameSerial_ = 0;              // setCullFrame calls
+    std::array<Buffer, MAX_CULL_FRAMES> surfaceNetsInput;    // headers, then cells
+    std::array<Buffer, MAX_CULL_FRAMES> surfaceNetsScratch;  // per-cell plane masks, then vertex bases
+    TrackedHandle<VkPipeline> surfaceNetsPipeline;
+    TrackedHandle<VkPipelineLayout> surfaceNetsPipelineLayout;
+    TrackedHandle<VkDescriptorSetLayout> surfaceNetsDescSetLayout;
+    TrackedHandle<VkDescriptorPool> surfaceNetsDescPool;
+    std::array<TrackedHandle<VkDescriptorSet>, MAX_CULL_FRAMES> surfaceNetsDescSets;
+    void initSurfaceNets(VulkanApp* app);
+    void destroySurfaceNets();
+    // Main-thread dispatch recorded by prepareCull before the chunk pass.
+    void dispatchSurfaceNets(VkCommandBuffer cmd);
+    // Runs completions of bricks whose frame has retired (pollPendingTransfers).
+    void retireSurfaceNets();
+    // Caller must hold `mutex`. Drops the queued brick targeting
+    // `entryIndex` (republished or removed before its dispatch) without its
+    // completion: its own spans are freed and `ld` points back at the spans
+    // the draw entry still shows, for the caller to replace or free.
+    void cancelPendingBricks(uint32_t entryIndex, MeshInfo::LevelData& ld);
+
     // Optional device function for indirect-count draw (KHR or core 1.2)
     PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCount = nullptr;
 
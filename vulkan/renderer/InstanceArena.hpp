@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+// Free-space allocator for a single pooled element buffer (e.g. the
+// vegetation instance arena). Same scheme as PackedSpaceAllocator, with one
+// pool instead of a vertex/index pair: every owner (chunk) gets a span of
+// consecutive elements sized to what it actually uploaded, and writes its
+// data straight into that span of the shared GPU buffer.
+//
+// Allocation is best-fit; freed spans merge with their neighbours. There is
+// NO compaction — spans are referenced by absolute firstInstance offsets, so
+// a span only moves when its owner re-uploads. When no span fits, the owner
+// grows the pool with grow() (the GPU buffer is reallocated and its contents
+// copied, so existing offsets stay valid).
+//
+// Thread safety: all public methods are thread-safe via internal mutex.
+class InstanceArena {
+public:
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t size   = 0;
+    };
+
+    // Extend the pool to `elements` in total (no-op when already larger).
+    // The new space is appended as one free span.
+    void grow(uint32_t elements) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (elements <= total_) return;
+        insertSpan(free_, total_, elements - total_);
+        total_ = elements;
+    }
+
+    // Allocate `n` consecutive elements. Returns the element offset or
+    // UINT32_MAX when no free span is large enough.
+    uint32_t allocate(uint32_t n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (n == 0) return 0; // zero-size allocation consumes nothing
+        size_t best = free_.size();
+        for (size_t i = 0; i < free_.size(); ++i) {
+            if (free_[i].size >= n &&
+                (best == free_.size() || free_[i].size < free_[best].size)) {
+                best = i;
+            }
+        }
+        if (best == free_.size()) return UINT32_MAX;
+
+        Span& s = free_[best];
+        uint32_t off = s.offset;
+        if (s.size == n) {
+            free_.erase(free_.begin() + static_cast<ptrdiff_t>(best));
+        } else {
+            s.offset += n;
+            s.size   -= n;
+        }
+        used_ += n;
+        return off;
+    }
+
+    void free(uint32_t offset, uint32_t n) {
+        if (n == 0 || offset == UINT32_MAX) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        insertSpan(free_, offset, n);
+        used_ -= n;
+    }
+
+    // Drop every span and the pool size (the GPU buffer is released by the owner).
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.clear();
+        total_ = 0;
+        used_ = 0;
+    }
+
+    uint32_t total() const { return total_; }
+    uint64_t used()  const { return used_; }
+    // Elements in the largest free span (fragmentation diagnostics).
+    uint32_t largestFree() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t best = 0;
+        for (const Span& s : free_) best = std::max(best, s.size);
+        return best;
+    }
+
+private:
+    // Insert a span and merge it with any adjacent free span.
+    static void insertSpan(std::vector<Span>& spans, uint32_t offset, uint32_t size) {
+        if (size == 0) return;
+        auto it = std::lower_bound(spans.begin(), spans.end(), offset,
+                                   [](const Span& s, uint32_t off) { return s.offset < off; });
+        it = spans.insert(it, Span{offset, size});
+        // Merge with the following span
+        auto next = it + 1;
+        if (next != spans.end() && it->offset + it->size == next->offset) {
+            it->size += next->size;
+            spans.erase(next);
+        }
+        // Merge with the preceding span
+        if (it != spans.begin()) {
+            auto prev = it - 1;
+            if (prev->offset + prev->size == it->offset) {
+                prev->size += it->size;
+                spans.erase(it);
+            }
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Span> free_;     // sorted by offset
+    uint32_t total_ = 0;
+    uint64_t used_  = 0;
+};
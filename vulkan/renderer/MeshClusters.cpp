@@ -0,0 +1,88 @@
+#include "MeshClusters.hpp"
+#include "../../space/MeshSimplifier.hpp"
+#include "../../space/MeshOptimizer.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace MeshClusters {
+
+void build(const Vertex* vertices, uint32_t vertexCount,
+           uint32_t* indices, uint32_t indexCount,
+           uint32_t firstIndex, uint32_t entryIndex, bool presorted,
+           std::vector<ClusterRecord>& out)
+{
+    const uint32_t triangles = indexCount / 3;
+    if (triangles == 0 || vertices == nullptr || indices == nullptr) return;
+
+    auto position = [&](uint32_t i) {
+        return i < vertexCount ? vertices[i].position : glm::vec3(0.0f);
+    };
+
+    // Sort triangles along a Morton curve over the centroid bounds so every
+    // fixed-size run is a compact patch (tight AABB, narrow normal cone) —
+    // unless the mesh optimizer already laid the runs out.
+    if (!presorted) sortTrianglesMorton(vertices, vertexCount, indices, indexCount);
+
+    std::vector<glm::vec3> faceNormals;
+    faceNormals.reserve(TRIANGLES_PER_CLUSTER);
+    for (uint32_t first = 0; first < triangles; first += TRIANGLES_PER_CLUSTER) {
+        const uint32_t count = std::min(TRIANGLES_PER_CLUSTER, triangles - first);
+
+        glm::vec3 bmin(FLT_MAX), bmax(-FLT_MAX);
+        glm::vec3 axisSum(0.0f);
+        faceNormals.clear();
+        for (uint32_t t = first; t < first + count; ++t) {
+            const uint32_t i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+            const glm::vec3 p0 = position(i0), p1 = position(i1), p2 = position(i2);
+            bmin = glm::min(bmin, glm::min(p0, glm::min(p1, p2)));
+            bmax = glm::max(bmax, glm::max(p0, glm::max(p1, p2)));
+            // The box must also hold the geomorphed positions the vertex
+            // shader may draw (the morph stays inside the coarse cell).
+            for (uint32_t vi : {i0, i1, i2}) {
+                if (vi >= vertexCount || vertices[vi].morph == 0u) continue;
+                const glm::vec3 target = vertices[vi].position + unpackMorphDelta(vertices[vi].morph);
+                bmin = glm::min(bmin, target);
+                bmax = glm::max(bmax, target);
+            }
+
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            const float len = glm::length(n);
+            if (len <= 1e-12f) continue; // degenerate: covers no pixels
+            n /= len;
+            // Orient by the shading normals rather than assuming a winding
+            // convention: the cone must bound the side the surface faces.
+            if (i0 < vertexCount && i1 < vertexCount && i2 < vertexCount) {
+                const glm::vec3 vn = vertices[i0].normal + vertices[i1].normal + vertices[i2].normal;
+                if (glm::dot(n, vn) < 0.0f) n = -n;
+            }
+            faceNormals.push_back(n);
+            axisSum += n;
+        }
+
+        // Normal cone: axis = mean face normal, cutoff = sin of the widest
+        // deviation. Clusters spanning more than ~84 degrees are never
+        // cone-culled (NO_CONE_CUTOFF).
+        float cutoff = NO_CONE_CUTOFF;
+        glm::vec3 axis(0.0f);
+        const float axisLen = glm::length(axisSum);
+        if (!faceNormals.empty() && axisLen > 1e-6f) {
+            axis = axisSum / axisLen;
+            float minDot = 1.0f;
+            for (const glm::vec3& n : faceNormals) minDot = std::min(minDot, glm::dot(axis, n));
+            if (minDot > 0.1f) cutoff = std::sqrt(std::max(0.0f, 1.0f - minDot * minDot));
+        }
+
+        ClusterRecord rec{};
+        rec.firstIndex = firstIndex + first * 3;
+        rec.indexCount = count * 3;
+        rec.entryIndex = entryIndex;
+        rec.boundsMin  = glm::vec4(bmin, cutoff);
+        rec.boundsMax  = glm::vec4(bmax, 0.0f);
+        rec.coneAxis   = glm::vec4(axis, 0.0f);
+        out.push_back(rec);
+    }
+}
+
+} // namespace MeshClusters
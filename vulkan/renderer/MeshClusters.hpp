@@ -0,0 +1,48 @@
+// MeshClusters.hpp
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "../../math/Vertex.hpp"
+
+// One GPU-culled cluster (meshlet) of a chunk mesh: a run of up to
+// MeshClusters::TRIANGLES_PER_CLUSTER triangles inside the chunk's packed index
+// span. Mirrors `struct Cluster` in shaders/cluster_cull.comp (std430).
+struct alignas(16) ClusterRecord {
+    uint32_t firstIndex = 0;   // absolute index offset (merged index pool)
+    uint32_t indexCount = 0;   // 0 = empty record (never drawn)
+    uint32_t entryIndex = 0;   // owning draw entry (chunk slot)
+    uint32_t pad = 0;
+    glm::vec4 boundsMin{0.0f}; // xyz = AABB min, w = normal-cone cutoff (> 1: no cone test)
+    glm::vec4 boundsMax{0.0f}; // xyz = AABB max
+    glm::vec4 coneAxis{0.0f};  // xyz = normal-cone axis (unit), w unused
+};
+static_assert(sizeof(ClusterRecord) == 64, "ClusterRecord must match the std430 shader struct");
+
+namespace MeshClusters {
+
+constexpr uint32_t TRIANGLES_PER_CLUSTER = 128;
+// Cone cutoff stored for clusters whose normals spread too wide to ever be
+// entirely back-facing: the shader test can never pass with a cutoff > 1.
+constexpr float NO_CONE_CUTOFF = 2.0f;
+
+inline uint32_t clusterCount(uint32_t indexCount) {
+    const uint32_t triangles = indexCount / 3;
+    return (triangles + TRIANGLES_PER_CLUSTER - 1) / TRIANGLES_PER_CLUSTER;
+}
+
+// Reorders the triangles of `indices` (chunk-local, `indexCount` entries) so
+// each consecutive run of TRIANGLES_PER_CLUSTER triangles is spatially compact
+// (Morton order of the triangle centroids), then appends one record per run
+// to `out`. The reorder is a pure permutation of whole triangles: winding and
+// the set of drawn triangles are unchanged. `firstIndex` is the absolute
+// offset of indices[0] in the merged index pool. With `presorted` the
+// triangles are kept in place: the runs were already laid out by
+// optimizeMeshForGpu (space/MeshOptimizer.hpp) with this cluster size.
+void build(const Vertex* vertices, uint32_t vertexCount,
+           uint32_t* indices, uint32_t indexCount,
+           uint32_t firstIndex, uint32_t entryIndex, bool presorted,
+           std::vector<ClusterRecord>& out);
+
+} // namespace MeshClusters
@@ -83,10 +83,36 @@ public:
         usedIndex_ -= n;
     }
 
+    // Cluster-record pool (IndirectRenderer cluster culling): same best-fit
+    // spans, one element per MeshClusters record.
+    void reserveClusters(uint32_t clusterElements) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (clusterElements > totalCluster_) {
+            insertSpan(freeCluster_, totalCluster_, clusterElements - totalCluster_);
+            totalCluster_ = clusterElements;
+        }
+    }
+
+    uint32_t allocateCluster(uint32_t n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t off = takeBestFit(freeCluster_, n);
+        if (off != UINT32_MAX) usedCluster_ += n;
+        return off;
+    }
+
+    void freeCluster(uint32_t offset, uint32_t n) {
+        if (n == 0 || offset == UINT32_MAX) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        insertSpan(freeCluster_, offset, n);
+        usedCluster_ -= n;
+    }
+
     uint32_t totalVertex() const { return totalVertex_; }
     uint32_t totalIndex()  const { return totalIndex_; }
     uint64_t usedVertex()  const { return usedVertex_; }
     uint64_t usedIndex()   const { return usedIndex_; }
+    uint32_t totalCluster() const { return totalCluster_; }
+    uint64_t usedCluster()  const { return usedCluster_; }
 
 private:
     // Remove the smallest free span that fits `n` (best fit), return its
@@ -142,8 +168,11 @@ private:
     mutable std::mutex mutex_;
     std::vector<Span> freeVertex_;
     std::vector<Span> freeIndex_;
+    std::vector<Span> freeCluster_;
     uint32_t totalVertex_ = 0;
     uint32_t totalIndex_  = 0;
+    uint32_t totalCluster_ = 0;
     uint64_t usedVertex_  = 0;
     uint64_t usedIndex_   = 0;
+    uint64_t usedCluster_ = 0;
 };
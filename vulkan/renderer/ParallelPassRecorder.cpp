@@ -0,0 +1,122 @@
+#include "ParallelPassRecorder.hpp"
+#include "../VulkanApp.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+void ParallelPassRecorder::init(VulkanApp* app, uint32_t frameCount, uint32_t passCount) {
+    cleanup();
+    if (!app || frameCount == 0 || passCount == 0) return;
+
+    VkDevice device = app->getDevice();
+    QueueFamilyIndices indices = app->findQueueFamilies(app->getPhysicalDevice());
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.queueFamilyIndex = indices.graphicsFamily.value();
+    // Reset as a whole every frame via vkResetCommandPool.
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+    pools_.assign(static_cast<size_t>(frameCount) * passCount, VK_NULL_HANDLE);
+    buffers_.assign(pools_.size(), VK_NULL_HANDLE);
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &pools_[i]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create parallel pass command pool!");
+        }
+        app->resources.addCommandPool(pools_[i], "ParallelPassRecorder: commandPool");
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = pools_[i];
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device, &allocInfo, &buffers_[i]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate parallel pass command buffer!");
+        }
+    }
+
+    app_ = app;
+    frameCount_ = frameCount;
+    passCount_ = passCount;
+    pending_.clear();
+    pending_.resize(passCount);
+    recordMs_.assign(passCount, 0.0f);
+}
+
+void ParallelPassRecorder::cleanup() {
+    // Drain outstanding recordings before dropping the buffers they write.
+    for (auto& f : pending_) {
+        if (f.valid()) {
+            try { workers_.getCooperative(f); } catch (...) {}
+        }
+    }
+    pending_.clear();
+    // Pools (and their buffers) are destroyed by VulkanResourceManager.
+    pools_.clear();
+    buffers_.clear();
+    recordMs_.clear();
+    app_ = nullptr;
+    frameCount_ = 0;
+    passCount_ = 0;
+}
+
+void ParallelPassRecorder::beginFrame(uint32_t frameIdx) {
+    if (!app_) return;
+    currentFrame_ = frameIdx % frameCount_;
+    VkDevice device = app_->getDevice();
+    for (uint32_t s = 0; s < passCount_; ++s) {
+        vkResetCommandPool(device, pools_[currentFrame_ * passCount_ + s], 0);
+        recordMs_[s] = 0.0f;
+    }
+}
+
+void ParallelPassRecorder::record(uint32_t slot, const SecondaryRenderingFormats& formats,
+                                  std::function<void(VkCommandBuffer)> fn) {
+    if (!app_ || slot >= passCount_) return;
+    VkCommandBuffer cmd = buffers_[currentFrame_ * passCount_ + slot];
+
+    pending_[slot] = workers_.enqueue([this, cmd, slot, formats, fn = std::move(fn)]() -> bool {
+        auto t0 = std::chrono::steady_clock::now();
+
+        VkCommandBufferInheritanceRenderingInfo renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+        renderingInfo.colorAttachmentCount = static_cast<uint32_t>(formats.colorFormats.size());
+        renderingInfo.pColorAttachmentFormats = formats.colorFormats.data();
+        renderingInfo.depthAttachmentFormat = formats.depthFormat;
+        renderingInfo.rasterizationSamples = formats.samples;
+
+        VkCommandBufferInheritanceInfo inheritance{};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.pNext = &renderingInfo;
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                          VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = &inheritance;
+
+        if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS) return false;
+        fn(cmd);
+        bool ok = vkEndCommandBuffer(cmd) == VK_SUCCESS;
+
+        recordMs_[slot] = std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+        return ok;
+    });
+}
+
+VkCommandBuffer ParallelPassRecorder::finish(uint32_t slot) {
+    if (!app_ || slot >= passCount_ || !pending_[slot].valid()) return VK_NULL_HANDLE;
+    bool ok = false;
+    try {
+        ok = workers_.getCooperative(pending_[slot]);
+    } catch (const std::exception& e) {
+        std::cerr << "[ParallelPassRecorder] pass " << slot << " recording threw: " << e.what() << std::endl;
+    }
+    if (!ok) {
+        std::cerr << "[ParallelPassRecorder] pass " << slot << " failed, recording inline" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+    return buffers_[currentFrame_ * passCount_ + slot];
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+#include "../../space/ThreadPool.hpp"
+
+class VulkanApp;
+
+// Attachment formats a secondary command buffer inherits from the dynamic
+// rendering scope it is executed in (VkCommandBufferInheritanceRenderingInfo).
+struct SecondaryRenderingFormats {
+    std::vector<VkFormat> colorFormats;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+};
+
+// Records independent passes into secondary command buffers on worker threads.
+//
+// Every (frame slot, pass slot) pair owns its own TRANSIENT command pool with a
+// single secondary buffer, so no pool is ever touched by two threads at once
+// (pools are externally synchronized). beginFrame() resets the frame slot's
+// pools; the caller guarantees the slot's previous primary has retired (the
+// same guarantee the per-frame staging buffers rely on).
+//
+// Submission order is deterministic: record() only starts the work, and the
+// caller executes the results with vkCmdExecuteCommands in slot order after
+// finish(), which waits cooperatively (the main thread helps run queued
+// recordings instead of idling).
+//
+// Thread-safety: record()/finish() are main-thread only. The record callback
+// runs on a worker and must not touch CommandBufferState or allocate
+// descriptors; do that on the main thread before calling record().
+class ParallelPassRecorder {
+public:
+    void init(VulkanApp* app, uint32_t frameCount, uint32_t passCount);
+    void cleanup();
+    bool isReady() const { return app_ != nullptr; }
+
+    // Reset the command pools of `frameIdx` and clear its timings.
+    void beginFrame(uint32_t frameIdx);
+
+    // Start recording pass `slot` of the current frame on a worker thread.
+    void record(uint32_t slot, const SecondaryRenderingFormats& formats,
+                std::function<void(VkCommandBuffer)> fn);
+
+    // Wait for pass `slot` and return its ended secondary buffer, or
+    // VK_NULL_HANDLE when recording failed (the caller records inline instead).
+    VkCommandBuffer finish(uint32_t slot);
+
+    // Wall-clock CPU time spent recording each pass slot in the last frame.
+    float getPassRecordMs(uint32_t slot) const { return slot < recordMs_.size() ? recordMs_[slot] : 0.0f; }
+    uint32_t getPassCount() const { return passCount_; }
+    size_t getWorkerCount() const { return workers_.threadCount(); }
+
+private:
+    VulkanApp* app_ = nullptr;
+    uint32_t frameCount_ = 0;
+    uint32_t passCount_ = 0;
+    uint32_t currentFrame_ = 0;
+
+    // [frame * passCount + slot]
+    std::vector<VkCommandPool> pools_;
+    std::vector<VkCommandBuffer> buffers_;
+
+    std::vector<std::future<bool>> pending_;
+    std::vector<float> recordMs_;
+
+    ThreadPool workers_{std::max(1u, std::min(3u, std::thread::hardware_concurrency() / 2))};
+};
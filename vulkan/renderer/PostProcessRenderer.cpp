@@ -17,7 +17,7 @@ PostProcessRenderer::~PostProcessRenderer() {}
 
 void PostProcessRenderer::init(VulkanApp* app) {
     createSampler(app);
-    createPipeline(app);
+    createLayouts(app);
     createDescriptorSets(app);
 
     // Create uniform buffer for post-process UBO
@@ -43,7 +43,7 @@ void PostProcessRenderer::createSampler(VulkanApp* app) {
 
 // ─── Pipeline ─────────────────────────────────────────────────────────────────
 
-void PostProcessRenderer::createPipeline(VulkanApp* app) {
+void PostProcessRenderer::createLayouts(VulkanApp* app) {
     VkDevice device = app->getDevice();
 
     // Descriptor set layout – 9 bindings (8 image samplers + 1 UBO)
@@ -93,6 +93,10 @@ void PostProcessRenderer::createPipeline(VulkanApp* app) {
         throw std::runtime_error("Failed to create post-process pipeline layout!");
     }
     app->resources.addPipelineLayout(pipelineLayout, "PostProcessRenderer: pipelineLayout");
+}
+
+void PostProcessRenderer::createPipeline(VulkanApp* app) {
+    VkDevice device = app->getDevice();
 
     // Load shaders (cached by VulkanApp)
     VkShaderModule vertModule = app->getOrCreateShaderModule("shaders/fullscreen.vert.spv");
@@ -17,6 +17,8 @@ public:
     ~PostProcessRenderer();
 
     void init(VulkanApp* app);
+    // Composite pipeline; needs the layouts created by init()
+    void createPipeline(VulkanApp* app);
     void cleanup(VulkanApp* app) override;
 
     /// Composite scene + water + brush into the swapchain framebuffer.
@@ -44,7 +46,7 @@ public:
 
 private:
     void createSampler(VulkanApp* app);
-    void createPipeline(VulkanApp* app);
+    void createLayouts(VulkanApp* app);
     void createDescriptorSets(VulkanApp* app);
 
     TrackedHandle<VkPipeline> pipeline;
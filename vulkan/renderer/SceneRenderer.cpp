@@ -94,6 +94,9 @@ void SceneRenderer::cleanup(VulkanApp* app) {
     if (shadowMapper && app) {
         shadowMapper->cleanup(app);
     }
+    if (virtualShadowRenderer && app) {
+        virtualShadowRenderer->cleanup(app);
+    }
     if (skyRenderer) {
         skyRenderer->cleanup(app);
     }
@@ -113,6 +116,14 @@ void SceneRenderer::cleanup(VulkanApp* app) {
         waterWireframe->cleanup(app);
     }
 
+    if (app) {
+        app->getBindlessHeap().releaseBuffer(materialsSlot);
+        app->getBindlessHeap().releaseBuffer(waterParamsSlot);
+    }
+    materialsSlot = BindlessHeap::INVALID_INDEX;
+    waterParamsSlot = BindlessHeap::INVALID_INDEX;
+    textureArrayManagerPtr = nullptr;
+
     // Clear local CPU-side handles; Vulkan objects are destroyed via VulkanResourceManager
     for (auto &b : mainUniformBuffers) {
         if (b.buffer != VK_NULL_HANDLE) b = {};
@@ -127,6 +138,7 @@ void SceneRenderer::cleanup(VulkanApp* app) {
 // cmdState=nullptr avoids a data race on frameCmdState.
 void SceneRenderer::setCmdState(CommandBufferState* state) {
     if (shadowMapper) shadowMapper->setCmdState(state);
+    if (virtualShadowRenderer) virtualShadowRenderer->setCmdState(state);
     if (mainSolidRenderer) mainSolidRenderer->setCmdState(state);
     if (skyRenderer) skyRenderer->setCmdState(state);
     if (vegetationRenderer) vegetationRenderer->setCmdState(state);
@@ -162,40 +174,12 @@ void SceneRenderer::onSwapchainResized(VulkanApp* app, uint32_t width, uint32_t
             solid360Renderer->destroySolid360Targets(app);
             solid360Renderer->createSolid360Targets(app, mainLiquidRenderer->getLinearSampler());
             solid360Renderer->createSolid360Pipelines(app);
-            // Rewrite binding 11 (cubemap) in all descriptor sets since the
-            // old VkImageView handles were destroyed and new ones created.
-            VkImageView cubeView = solid360Renderer->getSolid360View();
-            VkSampler cubeSampler = solid360Renderer->getSolid360Sampler();
-            if (cubeView != VK_NULL_HANDLE && cubeSampler != VK_NULL_HANDLE) {
-                VkDescriptorSet staticDs = app->getStaticDescriptorSet();
-                if (staticDs != VK_NULL_HANDLE) {
-                    DescriptorWriter(app->getDevice())
-                        .writeImage(staticDs, 11, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                    cubeSampler, cubeView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-                        .flush();
-                }
-                // Propagate to per-frame descriptor sets
-                for (size_t fi = 0; fi < app->getMainDescriptorSetCount(); ++fi) {
-                    VkDescriptorSet dstSet = app->getMainDescriptorSetForFrame(static_cast<uint32_t>(fi));
-                    if (dstSet == VK_NULL_HANDLE) continue;
-                    VkCopyDescriptorSet c{};
-                    c.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
-                    c.srcSet = staticDs; c.srcBinding = 11; c.srcArrayElement = 0;
-                    c.dstSet = dstSet; c.dstBinding = 11; c.dstArrayElement = 0;
-                    c.descriptorCount = 1;
-                    vkUpdateDescriptorSets(app->getDevice(), 0, nullptr, 1, &c);
-                }
-                // Propagate to shadow descriptor sets
-                for (size_t fi = 0; fi < shadowDescriptorSets.size(); ++fi) {
-                    VkDescriptorSet ds = shadowDescriptorSets[fi];
-                    if (ds == VK_NULL_HANDLE) continue;
-                    DescriptorWriter(app->getDevice())
-                        .writeImage(ds, 11, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                    cubeSampler, cubeView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-                        .flush();
-                }
-            }
+            // The cubemap re-registered its heap slot (getSolid360Slot);
+            // frame UBOs pick it up from the next frame on.
         }
+        // Views the water scene slots cached may come back with the same
+        // handles: drop them so the next frame registers the new targets.
+        mainLiquidRenderer->releaseSceneSlots(app);
     }
     if (postProcessRenderer) {
         postProcessRenderer->setRenderSize(width, height);
@@ -209,6 +193,7 @@ void SceneRenderer::onSwapchainResized(VulkanApp* app, uint32_t width, uint32_t
 SceneRenderer::SceneRenderer() :
     skyRenderer(std::make_unique<SkyRenderer>()),
     shadowMapper(std::make_unique<ShadowRenderer>(2048)),
+    virtualShadowRenderer(std::make_unique<VirtualShadowRenderer>()),
     postProcessRenderer(std::make_unique<PostProcessRenderer>()),
     mainSolidRenderer(std::make_unique<SolidRenderer>()),
     mainLiquidRenderer(std::make_unique<WaterRenderer>()),
@@ -235,6 +220,11 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
         return;
     }
 
+    // Pure pipeline builders declared below are compiled together on worker
+    // threads at the end of init (see PipelineRegistry).
+    PipelineRegistry& pipelines = app->getPipelineRegistry();
+    PipelineRegistry::BatchScope pipelineBatch(pipelines);
+
     // Initialize the async streaming orchestrator. It is now the real transfer
     // engine: solid/water incremental chunk uploads route through it (K
     // concurrent staging slots, no per-frame cap) instead of the single-slot
@@ -260,7 +250,6 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
     // Bind external texture arrays if provided; allocation/initialization should be done by the application
     if (vegetationRenderer) {
         if (textureArrayManager) {
-            vegetationRenderer->setTextureArrayManager(textureArrayManager, app);
             vegetationRenderer->init();
         } else {
             std::cerr << "[SceneRenderer::init] No TextureArrayManager provided — vegetation renderer initialization deferred" << std::endl;
@@ -270,26 +259,31 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
     mainSolidRenderer->init();
     mainSolidRenderer->destroyRenderTargets(app);
     mainSolidRenderer->createRenderTargets(app, app->getWidth(), app->getHeight());
-    mainSolidRenderer->createPipelines(app);
+    pipelines.declare("SolidRenderer", [this, app]() { mainSolidRenderer->createPipelines(app); });
 
     // Create pipelines for all renderers (solid renderer now has its render pass ready)
-    skyRenderer->init(app);
+    pipelines.declare("SkyRenderer", [this, app]() { skyRenderer->init(app); });
     // Create offscreen sky targets (destroy old first to prevent handle leak)
     skyRenderer->destroyOffscreenTargets(app);
     skyRenderer->createOffscreenTargets(app, app->getWidth(), app->getHeight());
     shadowMapper->init(app);
+    pipelines.declare("ShadowRenderer", [this, app]() { shadowMapper->createPipelines(app); });
     vegetationRenderer->init(app);
+    pipelines.declare("VegetationRenderer", [this, app]() { vegetationRenderer->createPipelines(app); });
 
     // Initialize debug cube renderer
     if (debugCubeRenderer) {
         debugCubeRenderer->init(app);
+        pipelines.declare("DebugCubeRenderer", [this, app]() { debugCubeRenderer->createPipeline(app); });
     }
     // Initialize bounding box renderer (reuses cube wireframe pipeline)
     if (boundingBoxRenderer) {
         boundingBoxRenderer->init(app);
+        pipelines.declare("BoundingBoxRenderer", [this, app]() { boundingBoxRenderer->createPipeline(app); });
     }
     if (debugSDFRenderer) {
         debugSDFRenderer->init(app);
+        pipelines.declare("DebugSDFRenderer", [this, app]() { debugSDFRenderer->createPipeline(app); });
     }
     
     // Create per-frame main uniform buffers (TRANSFER_DST for vkCmdCopyBuffer from staging)
@@ -304,6 +298,8 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
     // Per-frame staging buffers for shadow-pass UBO uploads are owned by
     // ShadowRenderer (see createStagingBuffers).
     shadowMapper->createStagingBuffers(app, dsCount);
+    shadowMapper->createParallelRecorder(app, dsCount);
+    virtualShadowRenderer->init(app, VirtualShadowMap::Config{}, dsCount);
 
     VkDescriptorSet mainDs = app->getMainDescriptorSetForFrame(0);
 
@@ -326,54 +322,13 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
         }
     }
 
-    // Bind texture arrays, shadow maps, materials, sky, water params (bindings 1-13)
-    // These static bindings are written once to the static descriptor set and then
-    // copied into per-frame descriptor sets. Only binding 0 (per-frame UBO) is
-    // written individually per frame.
-    std::vector<VkWriteDescriptorSet> writes;
-    std::vector<VkDescriptorImageInfo> writesImg;
-    std::vector<VkDescriptorBufferInfo> writesBuf;
-    writesImg.reserve(9);  // max image descriptors: 5 texture arrays + 3 shadow maps + 1 cubemap
-    writesBuf.reserve(3);  // materials SSBO + water params + water render UBO
-
-    // Helper to add image write if valid. dstSet is set to the static descriptor set
-    // so the accumulated writes serve as a template for the static set.
-    VkDescriptorSet staticDs = app->getStaticDescriptorSet();
-    auto addImageWrite = [&](uint32_t binding, VkSampler sampler, VkImageView view, VkImageLayout layout) {
-        if (view == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE) {
-            std::cerr << "[SceneRenderer::init] Skipping descriptor binding " << binding
-                      << ": imageView=" << (void*)view
-                      << " sampler=" << (void*)sampler << std::endl;
-            return;
-        }
-        VkDescriptorImageInfo& info = writesImg.emplace_back();
-        info.sampler = sampler;
-        info.imageView = view;
-        info.imageLayout = layout;
-        VkWriteDescriptorSet w{};
-        w.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        w.dstSet = staticDs;
-        w.dstBinding = binding;
-        w.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        w.descriptorCount = 1;
-        w.pImageInfo = &info;
-        writes.push_back(w);
-    };
-
-    if (textureArrayManager) {
-        addImageWrite(1, textureArrayManager->albedoSampler, textureArrayManager->albedoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImageWrite(2, textureArrayManager->normalSampler, textureArrayManager->normalArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImageWrite(3, textureArrayManager->bumpSampler, textureArrayManager->bumpArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImageWrite(12, textureArrayManager->roughnessSampler, textureArrayManager->roughnessArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImageWrite(13, textureArrayManager->aoSampler, textureArrayManager->aoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    } else {
-        std::cerr << "[SceneRenderer::init] No TextureArrayManager set — skipping texture array descriptor writes" << std::endl;
+    // Materials and water params are read through the bindless heap
+    // (UniformObject::bufferSlots, filled by writeFrameSlots). Texture arrays,
+    // shadow maps, the cubemap and the page atlas register their own slots.
+    textureArrayManagerPtr = textureArrayManager;
+    if (!textureArrayManager) {
+        std::cerr << "[SceneRenderer::init] No TextureArrayManager set — texture slots stay unbound" << std::endl;
     }
-    addImageWrite(4, shadowMapper->getShadowMapSampler(), shadowMapper->getShadowMapView(0), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    addImageWrite(8, shadowMapper->getShadowMapSampler(), shadowMapper->getShadowMapView(1), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    addImageWrite(9, shadowMapper->getShadowMapSampler(), shadowMapper->getShadowMapView(2), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-    // Create and bind Materials SSBO at binding 5. Require an external MaterialManager.
     materialManagerPtr = materialManager;
     if (!materialManager) {
         throw std::runtime_error("SceneRenderer::init requires a valid MaterialManager");
@@ -382,15 +337,7 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
     if (materialsBuffer.buffer == VK_NULL_HANDLE) {
         throw std::runtime_error("MaterialManager provided but materials buffer is not allocated");
     }
-    VkDescriptorBufferInfo& materialsInfo = writesBuf.emplace_back(materialsBuffer.buffer, 0, VK_WHOLE_SIZE);
-    VkWriteDescriptorSet materialsWrite{};
-    materialsWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    materialsWrite.dstSet = staticDs;
-    materialsWrite.dstBinding = 5;
-    materialsWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    materialsWrite.descriptorCount = 1;
-    materialsWrite.pBufferInfo = &materialsInfo;
-    writes.push_back(materialsWrite);
+    materialsSlot = app->getBindlessHeap().replaceBuffer(materialsSlot, materialsBuffer.buffer);
 
     // Initialize WaterRenderer early and allocate a params SSBO sized to texture layers.
     // Use the passed vector of WaterParams as the source of truth for layer count.
@@ -403,6 +350,7 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
     size_t paramsBufferSize = sizeof(WaterParamsGPU) * static_cast<size_t>(layerCount);
     waterParamsBuffer_ = app->createBuffer(paramsBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    waterParamsSlot = app->getBindlessHeap().replaceBuffer(waterParamsSlot, waterParamsBuffer_.buffer);
     // Create scene-owned water sub-renderers. Back-face renderpass must exist
     // before water pipelines are created, so create it first.
     backFaceRenderer = std::make_unique<WaterBackFaceRenderer>();
@@ -410,121 +358,71 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
 
     // Initialize WaterRenderer (creates its pipeline layout and initializes the param SSBO)
     mainLiquidRenderer->init(app, waterParamsBuffer_, waterParams, layerCount);
+    pipelines.declare("WaterRenderer", [this, app]() { mainLiquidRenderer->createPipelines(app); });
 
     // Now that WaterRenderer has created its pipeline layout, allow the
     // back-face renderer to create pipelines that depend on it.
-    if (backFaceRenderer) backFaceRenderer->createPipelines(app, mainLiquidRenderer->getWaterGeometryPipelineLayout());
+    if (backFaceRenderer) {
+        VkPipelineLayout waterLayout = mainLiquidRenderer->getWaterGeometryPipelineLayout();
+        pipelines.declare("WaterBackFaceRenderer", [this, app, waterLayout]() {
+            backFaceRenderer->createPipelines(app, waterLayout);
+        });
+    }
     // Create back-face render targets early so their image views are
     // available before the first frame's water pass attempts to bind them.
     if (backFaceRenderer) backFaceRenderer->createRenderTargets(app, app->getWidth(), app->getHeight());
     if (solid360Renderer) {
         solid360Renderer->init(app);
         solid360Renderer->setWaterRenderer(mainLiquidRenderer.get());
-        // Create cubemap targets now so the image view is available for
-        // the environment-map descriptor binding (binding 11) below.
+        // Create cubemap targets now so the environment-map slot exists
+        // before the first frame (writeFrameSlots).
         solid360Renderer->createSolid360Targets(app, mainLiquidRenderer->getLinearSampler());
-        solid360Renderer->createSolid360Pipelines(app);
-        // Binding 11: environment cubemap for solid-shader reflections
-        VkImageView cubeView = solid360Renderer->getSolid360View();
-        VkSampler cubeSampler = solid360Renderer->getSolid360Sampler();
-        if (cubeView != VK_NULL_HANDLE && cubeSampler != VK_NULL_HANDLE) {
-            addImageWrite(11, cubeSampler, cubeView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
+        pipelines.declare("Solid360Renderer", [this, app]() { solid360Renderer->createSolid360Pipelines(app); });
     }
 
-    // Bind water params SSBO to binding 7 of main descriptor set.
-    VkDescriptorBufferInfo& waterParamsInfo = writesBuf.emplace_back(waterParamsBuffer_.buffer, 0, VK_WHOLE_SIZE);
-    VkWriteDescriptorSet waterParamsWrite{};
-    waterParamsWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    waterParamsWrite.dstSet = staticDs;
-    waterParamsWrite.dstBinding = 7;
-    waterParamsWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    waterParamsWrite.descriptorCount = 1;
-    waterParamsWrite.pBufferInfo = &waterParamsInfo;
-    writes.push_back(waterParamsWrite);
-
-    // Bind water render UBO to binding 10 of main descriptor set (the buffer
-    // itself is created and updated by WaterRenderer).
-    VkDescriptorBufferInfo& waterRenderUBOInfo = writesBuf.emplace_back(mainLiquidRenderer->getWaterRenderUBO().buffer, 0, sizeof(WaterRenderUBO));
-    VkWriteDescriptorSet waterRenderUBOWrite{};
-    waterRenderUBOWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    waterRenderUBOWrite.dstSet = staticDs;
-    waterRenderUBOWrite.dstBinding = 10;
-    waterRenderUBOWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    waterRenderUBOWrite.descriptorCount = 1;
-    waterRenderUBOWrite.pBufferInfo = &waterRenderUBOInfo;
-    writes.push_back(waterRenderUBOWrite);
-
     // ── Static descriptor set ──
-    // Write bindings 1-13 to the static descriptor set once. These resources
-    // rarely change (texture arrays, materials, shadow maps, sky, water params).
-    // Per-frame descriptor sets will copy these via VkCopyDescriptorSet.
-    {
-        VkDescriptorSet staticSet = app->getStaticDescriptorSet();
-        if (staticSet != VK_NULL_HANDLE) {
-            DescriptorWriter staticWriter(app->getDevice());
-            // Replay accumulated image/buffer writes into the static set
-            for (auto &w : writes) {
-                if (w.dstBinding == 0) continue; // binding 0 is per-frame
-                if (w.pImageInfo) {
-                    staticWriter.writeImage(staticSet, w.dstBinding, w.descriptorType,
-                                            w.pImageInfo[0].sampler, w.pImageInfo[0].imageView,
-                                            w.pImageInfo[0].imageLayout, w.descriptorCount);
-                } else if (w.pBufferInfo) {
-                    staticWriter.writeBuffer(staticSet, w.dstBinding, w.descriptorType,
-                                             w.pBufferInfo[0].buffer, w.pBufferInfo[0].offset,
-                                             w.pBufferInfo[0].range, w.descriptorCount);
-                }
-            }
-            staticWriter.flush();
-        }
+    // The main set only carries uniform buffers: the frame UBO (binding 0,
+    // per frame), the Sky UBO (binding 6, written by skyRenderer->init) and
+    // the water render UBO (binding 10, created and updated by WaterRenderer).
+    VkDescriptorSet staticSet = app->getStaticDescriptorSet();
+    if (staticSet != VK_NULL_HANDLE) {
+        DescriptorWriter(app->getDevice())
+            .writeBuffer(staticSet, 10, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                         mainLiquidRenderer->getWaterRenderUBO().buffer, 0, sizeof(WaterRenderUBO))
+            .flush();
     }
 
     // ── Per-frame descriptor sets ──
-    // For each frame, copy bindings 1-13 from the static set and write binding 0
-    // (per-frame UBO) separately using DescriptorWriter.
-    {
-        VkDescriptorSet staticSet = app->getStaticDescriptorSet();
-        for (size_t fi = 0; fi < mainUniformBuffers.size(); ++fi) {
-            VkDescriptorSet dstSet = app->getMainDescriptorSetForFrame(static_cast<uint32_t>(fi));
-
-            // Collect all static bindings (1-13) for copy from staticDs.
-            // The writes template excludes binding 6 (Sky UBO was written by
-            // skyRenderer->init), so we enumerate the union explicitly.
-            std::vector<VkCopyDescriptorSet> copies;
-            auto addCopy = [&](uint32_t binding, uint32_t count = 1) {
-                VkCopyDescriptorSet c{};
-                c.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
-                c.srcSet = staticSet; c.srcBinding = binding; c.srcArrayElement = 0;
-                c.dstSet = dstSet; c.dstBinding = binding; c.dstArrayElement = 0;
-                c.descriptorCount = count;
-                copies.push_back(c);
-            };
-            for (auto &w : writes) {
-                if (w.dstBinding == 0) continue;
-                addCopy(w.dstBinding, w.descriptorCount);
-            }
-            addCopy(6); // Sky UBO — written to staticSet by skyRenderer->init
+    // For each frame, copy bindings 6 and 10 from the static set and write
+    // binding 0 (per-frame UBO) separately using DescriptorWriter.
+    for (size_t fi = 0; fi < mainUniformBuffers.size(); ++fi) {
+        VkDescriptorSet dstSet = app->getMainDescriptorSetForFrame(static_cast<uint32_t>(fi));
 
-            if (!copies.empty()) {
-                vkUpdateDescriptorSets(app->getDevice(), 0, nullptr,
-                                       static_cast<uint32_t>(copies.size()), copies.data());
+        if (staticSet != VK_NULL_HANDLE) {
+            VkCopyDescriptorSet copies[2]{};
+            const uint32_t bindings[2] = { 6, 10 };
+            for (uint32_t c = 0; c < 2; ++c) {
+                copies[c].sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+                copies[c].srcSet = staticSet; copies[c].srcBinding = bindings[c];
+                copies[c].dstSet = dstSet; copies[c].dstBinding = bindings[c];
+                copies[c].descriptorCount = 1;
             }
+            vkUpdateDescriptorSets(app->getDevice(), 0, nullptr, 2, copies);
+        }
 
-            // Write per-frame UBO (binding 0) using DescriptorWriter
-            DescriptorWriter writer(app->getDevice());
-            writer.writeBuffer(dstSet, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                               mainUniformBuffers[fi].buffer, 0, sizeof(UniformObject));
+        // Write per-frame UBO (binding 0) using DescriptorWriter
+        DescriptorWriter writer(app->getDevice());
+        writer.writeBuffer(dstSet, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                           mainUniformBuffers[fi].buffer, 0, sizeof(UniformObject));
 
-            writer.flush();
-        }
+        writer.flush();
     }
 
     // ── Initialize the brush renderer ──
     // Wire the samplers used by the brush depth descriptor writes (from the
     // water and shadow renderers, which are initialized above), then create
     // everything brush-related: offscreen targets, back-face renderer,
-    // per-frame brush depth descriptor sets (set=1) and the dedicated brush
+    // per-frame brush depth heap slots and the dedicated brush
     // IndirectRenderers.
     if (brushRenderer) {
         brushRenderer->setDepthSamplers(
@@ -547,64 +445,6 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
                                               waterWireframe.get());
     }
 
-    // ── Allocate (once) and write shadow-specific descriptor sets per-frame ──
-    shadowDescriptorSets.resize(mainUniformBuffers.size());
-    for (size_t fi = 0; fi < shadowDescriptorSets.size(); ++fi) {
-        VkDescriptorSet ds = shadowDescriptorSets[fi];
-        if (ds == VK_NULL_HANDLE) {
-            ds = app->createDescriptorSet(app->getDescriptorSetLayout());
-            shadowDescriptorSets[fi] = ds;
-        }
-
-        DescriptorWriter wr(app->getDevice());
-        wr.writeBuffer(ds, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                       mainUniformBuffers[fi].buffer, 0, sizeof(UniformObject));
-
-        auto addImg = [&](uint32_t binding, VkSampler sampler, VkImageView view, VkImageLayout layout) {
-            if (view == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE) return;
-            wr.writeImage(ds, binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                          sampler, view, layout);
-        };
-
-        if (textureArrayManager) {
-            addImg(1, textureArrayManager->albedoSampler, textureArrayManager->albedoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(2, textureArrayManager->normalSampler, textureArrayManager->normalArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(3, textureArrayManager->bumpSampler, textureArrayManager->bumpArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(12, textureArrayManager->roughnessSampler, textureArrayManager->roughnessArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(13, textureArrayManager->aoSampler, textureArrayManager->aoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
-        addImg(4, shadowMapper->getShadowMapSampler(), shadowMapper->getDummyDepthView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImg(8, shadowMapper->getShadowMapSampler(), shadowMapper->getDummyDepthView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImg(9, shadowMapper->getShadowMapSampler(), shadowMapper->getDummyDepthView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-        if (solid360Renderer) {
-            VkImageView cubeView = solid360Renderer->getSolid360View();
-            VkSampler cubeSampler = solid360Renderer->getSolid360Sampler();
-            if (cubeView != VK_NULL_HANDLE && cubeSampler != VK_NULL_HANDLE) {
-                addImg(11, cubeSampler, cubeView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            }
-        }
-
-        wr.writeBuffer(ds, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                       materialsBuffer.buffer, 0, VK_WHOLE_SIZE);
-        wr.writeBuffer(ds, 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                       waterParamsBuffer_.buffer, 0, VK_WHOLE_SIZE);
-        wr.writeBuffer(ds, 10, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                       mainLiquidRenderer->getWaterRenderUBO().buffer, 0, sizeof(WaterRenderUBO));
-        wr.flush();
-    }
-    // Shadow descriptor set handles are stable after init (subsequent writes
-    // only update them in place), so ShadowRenderer can cache them once.
-    if (shadowMapper) {
-        shadowMapper->setShadowDescriptorSets(shadowDescriptorSets);
-    }
-
-    // Register listener so we update the main descriptor set when texture arrays are allocated later
-    if (textureArrayManager) {
-        textureArrayManager->addAllocationListener([this, app, textureArrayManager]() {
-            this->updateTextureDescriptorSet(app, textureArrayManager);
-        });
-    }
     mainLiquidRenderer->createRenderTargets(app, app->getWidth(), app->getHeight());
 
     // Ensure back-face render targets are created as well so the
@@ -613,22 +453,21 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
 
     // Create the solid wireframe pipeline (owned by SolidRenderer) and the
     // water wireframe pipeline
-    mainSolidRenderer->createWireframe(app);
+    pipelines.declare("SolidRenderer wireframe", [this, app]() { mainSolidRenderer->createWireframe(app); });
     if (waterWireframe) {
-        std::vector<VkDescriptorSetLayout> waterSetLayouts = {
-            app->getDescriptorSetLayout(),
-            app->getMaterialDescriptorSetLayout(),
-            mainLiquidRenderer->getWaterDepthDescriptorSetLayout()
-        };
-        waterWireframe->createPipeline(app, {VK_FORMAT_R32G32B32A32_SFLOAT},
-            waterSetLayouts,
-            "shaders/water.vert.spv", "shaders/water_wireframe.frag.spv",
-            "shaders/water.tesc.spv", "shaders/water.tese.spv",
-            "water wireframe");
+        std::vector<VkDescriptorSetLayout> waterSetLayouts = app->getSceneSetLayouts();
+        pipelines.declare("Water wireframe", [this, app, waterSetLayouts]() {
+            waterWireframe->createPipeline(app, {VK_FORMAT_R32G32B32A32_SFLOAT},
+                waterSetLayouts,
+                "shaders/water.vert.spv", "shaders/water_wireframe.frag.spv",
+                "shaders/water.tesc.spv", "shaders/water.tese.spv",
+                "water wireframe");
+        });
     }
 
     // Initialize post-process renderer (composites scene + water into swapchain)
     postProcessRenderer->init(app);
+    pipelines.declare("PostProcessRenderer", [this, app]() { postProcessRenderer->createPipeline(app); });
     postProcessRenderer->setRenderSize(app->getWidth(), app->getHeight());
     
     // Activate the stable-slot indirect rendering pipeline (no global rebuilds).
@@ -656,121 +495,52 @@ void SceneRenderer::init(VulkanApp* app, TextureArrayManager* textureArrayManage
                                  kMaxBrushChunkSlots * (1u << 18),  // total vertex pool
                                  kMaxBrushChunkSlots * (1u << 16)); // total index pool
     }
+
+    pipelines.compileBatch(app->getDevice(), app->getPipelineCache());
 }
 
-// Update only the static bindings (textures, materials, water params) in the
-// static descriptor set, then propagate to all per-frame descriptor sets via
-// VkCopyDescriptorSet. This avoids re-writing identical descriptors per frame.
-void SceneRenderer::updateTextureDescriptorSet(VulkanApp* app, TextureArrayManager * textureArrayManager) {
+// Every slot a scene pass reads goes into the frame UBO, so resources that
+// were reallocated since the last frame (texture arrays, materials, render
+// targets) are picked up here without touching any descriptor set.
+void SceneRenderer::writeFrameSlots(VulkanApp* app, UniformObject& ubo, uint32_t frameIdx) {
     if (!app) return;
 
-    VkDescriptorSet staticDs = app->getStaticDescriptorSet();
-    if (staticDs == VK_NULL_HANDLE) return;
-
-    // 1. Write updated bindings to the static descriptor set
-    {
-        DescriptorWriter writer(app->getDevice());
-
-        auto addImg = [&](uint32_t binding, VkSampler sampler, VkImageView view, VkImageLayout layout) {
-            if (view == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE) return;
-            writer.writeImage(staticDs, binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                              sampler, view, layout);
-        };
-
-        addImg(1, textureArrayManager->albedoSampler, textureArrayManager->albedoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImg(2, textureArrayManager->normalSampler, textureArrayManager->normalArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImg(3, textureArrayManager->bumpSampler, textureArrayManager->bumpArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImg(12, textureArrayManager->roughnessSampler, textureArrayManager->roughnessArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        addImg(13, textureArrayManager->aoSampler, textureArrayManager->aoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-        // Shadow map samplers (bindings 4, 8, 9) for all cascades
-        if (shadowMapper) {
-            addImg(4, shadowMapper->getShadowMapSampler(), shadowMapper->getShadowMapView(0), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(8, shadowMapper->getShadowMapSampler(), shadowMapper->getShadowMapView(1), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(9, shadowMapper->getShadowMapSampler(), shadowMapper->getShadowMapView(2), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        }
-
-        // Materials SSBO (binding 5) — refresh from MaterialManager in case the buffer
-        // was allocated after SceneRenderer::init (setupTextures may run on a separate thread)
-        if (materialManagerPtr && materialManagerPtr->getBuffer().buffer != VK_NULL_HANDLE) {
-            materialsBuffer = materialManagerPtr->getBuffer();
-        }
-        if (materialsBuffer.buffer != VK_NULL_HANDLE)
-            writer.writeBuffer(staticDs, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                               materialsBuffer.buffer, 0, VK_WHOLE_SIZE);
-        else
-            std::cerr << "[SceneRenderer::updateTextureDescriptorSet] materials buffer not available — skipping binding 5\n";
-
-        if (waterParamsBuffer_.buffer != VK_NULL_HANDLE)
-            writer.writeBuffer(staticDs, 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                               waterParamsBuffer_.buffer, 0, VK_WHOLE_SIZE);
-
-        writer.flush();
+    for (int map = 0; map < 4; ++map) {
+        ubo.textureSlots[map] = textureArrayManagerPtr ? textureArrayManagerPtr->getHeapSlot(map) : BindlessHeap::INVALID_INDEX;
     }
+    ubo.textureSlots1.x = textureArrayManagerPtr ? textureArrayManagerPtr->getHeapSlot(4) : BindlessHeap::INVALID_INDEX;
 
-    // 2. Propagate static bindings (1-13) to all per-frame descriptor sets
-    const size_t setCount = app->getMainDescriptorSetCount();
-    for (size_t s = 0; s < setCount; ++s) {
-        VkDescriptorSet mainDs = app->getMainDescriptorSetForFrame(static_cast<uint32_t>(s));
-        if (mainDs == VK_NULL_HANDLE) continue;
-
-        // Build copy descriptors for all bindings 1-13
-        std::vector<VkCopyDescriptorSet> copies;
-        // Binding 1..4, 8, 9, 11 (textures)
-        for (uint32_t b : {1u, 2u, 3u, 4u, 8u, 9u, 11u, 12u, 13u}) {
-            VkCopyDescriptorSet c{};
-            c.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
-            c.srcSet = staticDs; c.srcBinding = b; c.srcArrayElement = 0;
-            c.dstSet = mainDs; c.dstBinding = b; c.dstArrayElement = 0;
-            c.descriptorCount = 1;
-            copies.push_back(c);
-        }
-        // Binding 5, 7 (storage buffers), 6 (Sky UBO), 10 (Water render UBO)
-        for (uint32_t b : {5u, 6u, 7u, 10u}) {
-            VkCopyDescriptorSet c{};
-            c.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
-            c.srcSet = staticDs; c.srcBinding = b; c.srcArrayElement = 0;
-            c.dstSet = mainDs; c.dstBinding = b; c.dstArrayElement = 0;
-            c.descriptorCount = 1;
-            copies.push_back(c);
-        }
-
-        if (!copies.empty()) {
-            vkUpdateDescriptorSets(app->getDevice(), 0, nullptr,
-                                   static_cast<uint32_t>(copies.size()), copies.data());
-        }
+    // Environment map: the 360° capture once it exists, the dummy cube before.
+    uint32_t envSlot = BindlessHeap::INVALID_INDEX;
+    if (solid360Renderer) {
+        envSlot = solid360Renderer->getSolid360Slot();
+        if (envSlot == BindlessHeap::INVALID_INDEX) envSlot = solid360Renderer->getDummyCubeSlot();
     }
+    ubo.textureSlots1.y = envSlot;
+    ubo.textureSlots1.z = virtualShadowRenderer ? virtualShadowRenderer->getAtlasSlot() : BindlessHeap::INVALID_INDEX;
 
-    // ── Also update shadow descriptor sets (bindings 1-3, 5, 7) with new textures/materials.
-    // Shadow sets use dummy depth views for bindings 4, 8, 9, 11 so they cannot simply copy
-    // from the static set; we write them individually.
-    if (!shadowDescriptorSets.empty() && textureArrayManager) {
-        for (size_t si = 0; si < shadowDescriptorSets.size(); ++si) {
-            VkDescriptorSet ds = shadowDescriptorSets[si];
-            DescriptorWriter sw(app->getDevice());
-            auto addImg = [&](uint32_t b, VkSampler sm, VkImageView vw, VkImageLayout ly) {
-                if (vw == VK_NULL_HANDLE || sm == VK_NULL_HANDLE) return;
-                sw.writeImage(ds, b, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, sm, vw, ly);
-            };
-            addImg(1, textureArrayManager->albedoSampler, textureArrayManager->albedoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(2, textureArrayManager->normalSampler, textureArrayManager->normalArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(3, textureArrayManager->bumpSampler, textureArrayManager->bumpArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(12, textureArrayManager->roughnessSampler, textureArrayManager->roughnessArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            addImg(13, textureArrayManager->aoSampler, textureArrayManager->aoArray.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            if (materialsBuffer.buffer != VK_NULL_HANDLE)
-                sw.writeBuffer(ds, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                               materialsBuffer.buffer, 0, VK_WHOLE_SIZE);
-            else
-                std::cerr << "[SceneRenderer::updateTextureDescriptorSet] shadow materials buffer not available — skipping shadow binding 5\n";
-            if (waterParamsBuffer_.buffer != VK_NULL_HANDLE)
-                sw.writeBuffer(ds, 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                               waterParamsBuffer_.buffer, 0, VK_WHOLE_SIZE);
-            sw.flush();
-        }
+    if (shadowMapper) {
+        ubo.shadowSlots = glm::uvec4(shadowMapper->getShadowMapSlot(0), shadowMapper->getShadowMapSlot(1),
+                                     shadowMapper->getShadowMapSlot(2), BindlessHeap::INVALID_INDEX);
+    }
+    if (brushRenderer) {
+        ubo.sceneSlots.x = brushRenderer->getDepthSlot(frameIdx);
+        ubo.sceneSlots.y = brushRenderer->getBackFaceDepthSlot(frameIdx);
+    }
+    if (mainLiquidRenderer) {
+        mainLiquidRenderer->writeSceneSlots(ubo, frameIdx);
     }
 
-    // Also rewrite brush depth descriptors for all per-frame main sets
-    if (brushRenderer) brushRenderer->writeDepthDescriptors(app);
+    // The materials buffer may be reallocated after init (setupTextures may
+    // run on a separate thread).
+    if (materialManagerPtr && materialManagerPtr->getBuffer().buffer != VK_NULL_HANDLE &&
+        materialManagerPtr->getBuffer().buffer != materialsBuffer.buffer) {
+        materialsBuffer = materialManagerPtr->getBuffer();
+        materialsSlot = app->getBindlessHeap().replaceBuffer(materialsSlot, materialsBuffer.buffer);
+    }
+    ubo.bufferSlots = glm::uvec4(materialsSlot, waterParamsSlot,
+                                 virtualShadowRenderer ? virtualShadowRenderer->getPageTableSlot() : BindlessHeap::INVALID_INDEX,
+                                 BindlessHeap::INVALID_INDEX);
 }
 
 
@@ -822,19 +592,35 @@ size_t SceneRenderer::publishPendingMeshes(
         // old geometry stays resident until the new upload completes.
         uint32_t oldSlot = takeOldSlot(layer, nid, isBrush);
 
-        if (lod.geom.vertices.empty() || lod.geom.indices.empty()) continue;
+        const bool gpuMeshed = (lod.brick != nullptr);
+        if (!gpuMeshed && (lod.geom.vertices.empty() || lod.geom.indices.empty())) continue;
 
         const glm::vec3 cubeMin = lod.boundsMin;
         const glm::vec3 cubeMax = lod.boundsMax;
+        const bool frontier = (lod.lod == 0);
+        const bool trackChunkManager = !isBrush && frontier;
+        auto onResident = [ir, oldSlot, this, base, trackChunkManager]() {
+            if (oldSlot != UINT32_MAX) ir->removeMeshSlotted(oldSlot);
+            if (trackChunkManager && this->world_)
+                this->world_->chunkManager().finishUpload(base);
+        };
 
         // Publish the mesh into its single draw entry slot. The slot index is
         // the chunk's stable slot (one draw entry per chunk); `lod.lod` is the
         // chunk's 0-based LoD level (0 = frontier), published in the bounds
-        // meta for the GPU's per-chunk distance band test.
-        const uint32_t slotIdx = ir->addMeshSlotted(lod.geom, static_cast<uint32_t>(base),
-                                                    &cubeMin,
-                                                    &cubeMax,
-                                                    lod.lod);
+        // meta for the GPU's per-chunk distance band test. Brick entries are
+        // meshed by the next frame's Surface Nets dispatch instead of an
+        // upload; the kernel publishes the draw entry itself.
+        uint32_t slotIdx = UINT32_MAX;
+        if (gpuMeshed) {
+            slotIdx = ir->addBrickSlotted(lod.brick, static_cast<uint32_t>(base),
+                                          cubeMin, cubeMax, lod.lod, onResident);
+        } else {
+            slotIdx = ir->addMeshSlotted(lod.geom, static_cast<uint32_t>(base),
+                                         &cubeMin,
+                                         &cubeMax,
+                                         lod.lod);
+        }
         if (slotIdx == UINT32_MAX) continue; // no free block / element pool exhausted
 
         // addMeshSlotted re-publishes the existing chunk slot in place when
@@ -846,24 +632,24 @@ size_t SceneRenderer::publishPendingMeshes(
         // upload starts; the deferred completion frees any replaced old slot
         // and promotes the chunk to ReadyToSwap once resident. Coarse
         // ancestor cells (level > 0) are not tracked by the ChunkManager.
-        const bool frontier = (lod.lod == 0);
-        if (!isBrush && world_ && frontier)
+        if (!isBrush && world_ && frontier) {
             world_->chunkManager().setSlotIndex(base, slotIdx);
+            ChunkManager::ChunkBounds bounds;
+            for (int a = 0; a < 3; ++a) {
+                bounds.min[a] = cubeMin[a];
+                bounds.max[a] = cubeMax[a];
+            }
+            world_->chunkManager().setChunkBounds(base, bounds);
+        }
 
-        const bool trackChunkManager = !isBrush && frontier;
-        ir->uploadSlot(app, slotIdx, 0.0f,
-            [ir, oldSlot, this, base, trackChunkManager]() {
-                if (oldSlot != UINT32_MAX) ir->removeMeshSlotted(oldSlot);
-                if (trackChunkManager && this->world_)
-                    this->world_->chunkManager().finishUpload(base);
-            });
+        if (!gpuMeshed) ir->uploadSlot(app, slotIdx, 0.0f, onResident);
 
         onChunkPublished(layer, nid, slotIdx, lod.version, isBrush);
 
         // Generate vegetation instances for grass chunks using the frontier
         // (finest) geometry only. Coarse ancestor cells (level > 0) never
-        // drive vegetation.
-        if (layer == LAYER_OPAQUE && vegetationRenderer && frontier &&
+        // drive vegetation (nor do brick entries — see processNodeBatch).
+        if (layer == LAYER_OPAQUE && vegetationRenderer && frontier && !gpuMeshed &&
             !lod.geom.vertices.empty()) {
             onFinestPublished(nid, lod.geom, isBrush);
         }
@@ -1055,6 +841,14 @@ void SceneRenderer::initSlottedMode(VulkanApp* app, uint32_t maxSolidChunks,
     const uint64_t waterVertBytes = static_cast<uint64_t>(maxWaterChunks) * vertexBytesPerChunk;
     const uint64_t waterIdxBytes  = static_cast<uint64_t>(maxWaterChunks) * indexBytesPerChunk;
 
+    // Opaque terrain is drawn per cluster in the main camera pass (water
+    // chunks are few and flat enough that chunk culling suffices).
+    mainSolidRenderer->getIndirectRenderer().setClusterCulling(true);
+    // The Surface Nets kernel writes straight into the solid pools (their
+    // usage flags are fixed at initSlots), so it is only built when
+    // Settings::gpuMeshing is on at startup; toggling it later only chooses
+    // whether chunks are routed to a kernel that exists.
+    mainSolidRenderer->getIndirectRenderer().setGpuMeshing(gpuMeshingEnabled());
     mainSolidRenderer->getIndirectRenderer().initSlots(app, maxSolidChunks,
                                                        static_cast<uint32_t>(solidVertBytes),
                                                        static_cast<uint32_t>(solidIdxBytes));
@@ -1088,7 +882,7 @@ bool SceneRenderer::processChunkSlotted(Layer layer, NodeID nid,
         // feeds the main scene.
         std::lock_guard<std::mutex> lock(pendingMeshMutex);
         Octree::LoDMesh lod = {geom, /*lod*/ 0, /*version*/ version, nd.cube.getLength().x,
-                               nd.cube.getMin(), nd.cube.getMax()};
+                               nd.cube.getMin(), nd.cube.getMax(), nd.key};
         pendingMeshQueue[nid] = {layer, nid, std::move(lod), nd, /*isBrush=*/false};
     }
 
@@ -1103,7 +897,7 @@ void SceneRenderer::processChunkSwapQueue(VulkanApp* app)
     if (world_) world_->chunkManager().processSwapQueue();
 }
 
-void SceneRenderer::processNodeLayer(Scene& scene, Layer layer, NodeID nid, OctreeNodeData& nodeData, GeometryHandler onGeometry, float minSize, ThreadPool* poolOverride) {
+void SceneRenderer::processNodeBatch(Scene& scene, Layer layer, std::vector<OctreeNodeData>& nodes, GeometryHandler onGeometry, float minSize, ThreadPool* poolOverride, bool allowGpuMeshing) {
 
     // Every cell with a chunkLod (stored 1..5, the +1-shifted uint8_t space)
     // publishes its mesh — each chunk carries its own level and the GPU cull
@@ -1111,15 +905,42 @@ void SceneRenderer::processNodeLayer(Scene& scene, Layer layer, NodeID nid, Octr
     // ancestor cells that come back empty (no zero crossing at that
     // resolution) simply never reach the publisher (LocalScene's walk and the
     // handler below filter empty geometry).
-    const uint8_t chunkLod = nodeData.node ? nodeData.node->getChunkLod() : 0;
-    if (chunkLod < 1) return;
-
-    // NOTE: the walk emits one callback per cell on the root path (each
-    // ancestor at its own level); the cube passed is the EMITTING cell's own
-    // cube — the band center and the meta cellSize must come from it, never
-    // from nodeData (the added node), or every ancestor would publish the
-    // frontier cell's size.
-    scene.requestModel3D(layer, nodeData, [&layer,&onGeometry](const Geometry& geo, uint8_t lod, uint version, uintptr_t emittingNodeId, const BoundingCube& cube) {
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [](const OctreeNodeData& nd) {
+        return nd.node == nullptr || nd.node->getChunkLod() < 1;
+    }), nodes.end());
+    if (nodes.empty()) return;
+
+    // NOTE: the batch emits one callback per unique cell on the root paths
+    // (each ancestor at its own level, shared ancestors once); the cube
+    // passed is the EMITTING cell's own cube — the band center and the meta
+    // cellSize must come from it, never from an added node, or every
+    // ancestor would publish the frontier cell's size.
+    //
+    // GPU meshing: uniformly refined opaque cells hand over a brick instead
+    // of geometry. The frontier level stays on the CPU while vegetation is
+    // on — it scatters from the finest CPU mesh.
+    SurfaceNetsRoute route;
+    const SurfaceNetsRoute* gpuRoute = nullptr;
+    if (allowGpuMeshing && layer == LAYER_OPAQUE && gpuMeshingEnabled() &&
+        mainSolidRenderer && mainSolidRenderer->getIndirectRenderer().isGpuMeshingActive()) {
+        route.minLevel = vegetationRenderer ? 1 : 0;
+        route.onBrick = [&layer,&onGeometry](std::shared_ptr<const SurfaceNetsBrick> brick, uint8_t lod, unsigned int version,
+                                            uintptr_t emittingNodeId, const BoundingCube& cube,
+                                            const OctreeCellKey& key) {
+            Octree::LoDMesh lm;
+            lm.brick = std::move(brick);
+            lm.lod = lod;
+            lm.version = version;
+            lm.cellSize = cube.getLength().x;
+            lm.boundsMin = cube.getMin();
+            lm.boundsMax = cube.getMax();
+            lm.key = key;
+            onGeometry(layer, reinterpret_cast<NodeID>(emittingNodeId), lm);
+        };
+        gpuRoute = &route;
+    }
+    scene.requestModel3DBatch(layer, nodes, [&layer,&onGeometry](const Geometry& geo, uint8_t lod, uint version, uintptr_t emittingNodeId,
+                                                                 const BoundingCube& cube, const OctreeCellKey& key) {
         Octree::LoDMesh lm;
         lm.geom = geo;
         lm.lod = lod;
@@ -1127,10 +948,9 @@ void SceneRenderer::processNodeLayer(Scene& scene, Layer layer, NodeID nid, Octr
         lm.cellSize = cube.getLength().x;
         lm.boundsMin = cube.getMin();
         lm.boundsMax = cube.getMax();
+        lm.key = key;
         onGeometry(layer, reinterpret_cast<NodeID>(emittingNodeId), lm);
-    }, poolOverride);
-
-
+    }, poolOverride, gpuRoute, &tessellationScheduler);
 }
 
 size_t SceneRenderer::getTransparentModelCount() {
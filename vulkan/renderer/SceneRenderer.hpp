@@ -18,16 +18,19 @@ class World;
 #include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <deque>
 #include <vector>
 #include "../../space/Model3DVersion.hpp"
 #include "../../space/ThreadPool.hpp"
+#include "../../space/TessellationPlanner.hpp"
 #include "SolidRenderer.hpp"
 #include "VegetationRenderer.hpp"
 #include "WaterRenderer.hpp"
 #include "PostProcessRenderer.hpp"
 #include "SkyRenderer.hpp"
 #include "ShadowRenderer.hpp"
+#include "VirtualShadowRenderer.hpp"
 #include "DebugCubeRenderer.hpp"
 #include "DebugSDFRenderer.hpp"
 #include "WireframeRenderer.hpp"
@@ -45,20 +48,19 @@ public:
     // Main uniform buffers (one per frame-in-flight)
     std::vector<Buffer> mainUniformBuffers;
 
-    // Materials SSBO
+    // Materials SSBO and its bindless heap slot (UniformObject::bufferSlots.x)
     Buffer materialsBuffer;
+    uint32_t materialsSlot = BindlessHeap::INVALID_INDEX;
     MaterialManager* materialManagerPtr = nullptr;
+    TextureArrayManager* textureArrayManagerPtr = nullptr;
 
-    // Water params UBO (binding 7) — stored for descriptor rebinding
+    // Water params SSBO and its heap slot (UniformObject::bufferSlots.y)
     Buffer waterParamsBuffer_;
-
-    // Shadow-specific descriptor sets (one per frame). Each mirrors the main
-    // descriptor set but binding 4 points to a dummy depth view to avoid
-    // layout-mismatch validation errors while writing the real shadow maps.
-    std::vector<VkDescriptorSet> shadowDescriptorSets;
+    uint32_t waterParamsSlot = BindlessHeap::INVALID_INDEX;
 
     std::unique_ptr<SkyRenderer> skyRenderer;
     std::unique_ptr<ShadowRenderer> shadowMapper;
+    std::unique_ptr<VirtualShadowRenderer> virtualShadowRenderer;
     std::unique_ptr<PostProcessRenderer> postProcessRenderer;
     std::unique_ptr<SolidRenderer> mainSolidRenderer;
     std::unique_ptr<WaterRenderer> mainLiquidRenderer;
@@ -146,8 +148,10 @@ public:
     }
 
     void init(VulkanApp* app_, TextureArrayManager* textureArrayManager, MaterialManager* materialManager, const std::vector<WaterParams>& waterParams);
-    // Re-update main descriptor set when texture arrays are (re)allocated
-    void updateTextureDescriptorSet(VulkanApp* app, TextureArrayManager * textureArrayManager);
+    // Fill the bindless heap slots of `ubo` (texture arrays, shadow maps,
+    // scene targets, materials, water params) for frame `frameIdx`. Called
+    // once per frame before the UBO is uploaded.
+    void writeFrameSlots(VulkanApp* app, UniformObject& ubo, uint32_t frameIdx);
     // cleanup declared above (accepts VulkanApp*)
 
     using GeometryHandler = const std::function<void(Layer, NodeID, const Octree::LoDMesh&)>&;
@@ -162,16 +166,18 @@ public:
         bool           isBrush = false; // brush-scene entry (own IR + slot bookkeeping)
     };
 
-    // Process nodes from a generic per-layer NodeID->OctreeNodeData map
-    // Process nodes for a single Layer (nodeMap maps NodeID->OctreeNodeData)
-    void processNodeLayer(
+    // Process one dispatch batch of added nodes for a single Layer: the
+    // ladder cells on their root paths are planned once and each is meshed
+    // at most once (Scene::requestModel3DBatch). Nodes without a chunkLod
+    // are dropped from `nodes`.
+    void processNodeBatch(
         Scene& scene, 
         Layer layer, 
-        NodeID nid, 
-        OctreeNodeData& nodeData, 
+        std::vector<OctreeNodeData>& nodes, 
         GeometryHandler onGeometry, 
         float minSize, 
-        ThreadPool* poolOverride = nullptr
+        ThreadPool* poolOverride = nullptr,
+        bool allowGpuMeshing = false  // main-scene solid only (see setGpuMeshing)
     );
 
     // ── Slotted-mode chunk processing ────────────────────────────────────────
@@ -196,6 +202,18 @@ public:
     // Call once per frame from processPendingMeshes.
     void processChunkSwapQueue(VulkanApp* app);
 
+    // GPU mesh reorder on the generation workers (optimizeMeshForGpu:
+    // vertex cache, overdraw and fetch order). Read by the worker callbacks,
+    // set from the UI thread; applies to meshes generated after the change.
+    void setMeshOptimization(bool enabled) { meshOptimization_.store(enabled, std::memory_order_relaxed); }
+    bool meshOptimizationEnabled() const { return meshOptimization_.load(std::memory_order_relaxed); }
+
+    // Surface Nets compute meshing of uniformly refined main solid chunks
+    // (IndirectRenderer::addBrickSlotted). Same threading as above; only
+    // effective when the solid IR built the kernel (initSlottedMode).
+    void setGpuMeshing(bool enabled) { gpuMeshing_.store(enabled, std::memory_order_relaxed); }
+    bool gpuMeshingEnabled() const { return gpuMeshing_.load(std::memory_order_relaxed); }
+
     // Runtime introspection helpers for UI/debug
     size_t getTransparentModelCount();
 
@@ -229,6 +247,9 @@ public:
     streaming::TerrainStreamer streamer;
 
 private:
+    std::atomic<bool> meshOptimization_{true};
+    std::atomic<bool> gpuMeshing_{false};
+
     // Single publish core for a pending mesh batch — every stream behaves
     // identically. Publishes each generated geometry chunk AS RECEIVED: every
     // PendingMeshData is ONE self-contained mesh (no ladder structures). Each
@@ -286,10 +307,15 @@ public:
     // Dedicated generation pools for solid and water so both layers tessellate
     // truly in parallel: neither waits for the other to finish, and neither
     // competes for the shared scene pool. Public so the app can hand them to
-    // processNodeLayer when building its own solid/water space-change lambdas.
+    // processNodeBatch when building its own solid/water space-change lambdas.
     ThreadPool mainSolidGenPool{std::max(2u, std::thread::hardware_concurrency() / 2)};
     ThreadPool mainWaterGenPool{std::max(2u, std::thread::hardware_concurrency() / 2)};
 
+    // Camera-priority order and cancellation for every processNodeBatch
+    // (all four streams). The app feeds it the camera each frame; its
+    // counters back the stats overlay.
+    TessellationScheduler tessellationScheduler;
+
     CommandBufferState frameCmdState;
 };
 
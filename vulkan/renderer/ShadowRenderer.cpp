@@ -6,15 +6,19 @@
 #include "WaterRenderer.hpp"
 #include "VegetationRenderer.hpp"
 #include "BrushRenderer.hpp"
+#include "VirtualShadowRenderer.hpp"
+#include "CommandBufferState.hpp"
 
 #include "../VulkanApp.hpp"
 #include "../ShaderStage.hpp"
 #include "../../utils/FileReader.hpp"
 #include "../../math/Vertex.hpp"
 #include <backends/imgui_impl_vulkan.h>
+#include <algorithm>
 #include <stdexcept>
 #include <fstream>
 #include <limits>
+#include <chrono>
 #include "../includes/locations.hpp"
 #include "../includes/vertex_layouts.hpp"
 
@@ -35,8 +39,9 @@ void ShadowRenderer::setSceneRenderers(SolidRenderer* solid, WaterRenderer* liqu
 
 void ShadowRenderer::createStagingBuffers(VulkanApp* app, size_t frameCount) {
     // Per-frame staging buffers for GPU-timeline UBO uploads: SHADOW_CASCADE_COUNT
-    // cascade slots + 1 restore slot for the main UBO.
-    const VkDeviceSize stagingSize = sizeof(UniformObject) * (SHADOW_CASCADE_COUNT + 1);
+    // cascade slots + 1 restore slot for the main UBO + one slot per virtual
+    // shadow map page rendered in a frame.
+    const VkDeviceSize stagingSize = sizeof(UniformObject) * (SHADOW_CASCADE_COUNT + 1 + MAX_VIRTUAL_PAGES_PER_FRAME);
     destroyStagingBuffers();
     uboStagingBuffers_.resize(frameCount);
     for (size_t i = 0; i < frameCount; ++i) {
@@ -45,6 +50,13 @@ void ShadowRenderer::createStagingBuffers(VulkanApp* app, size_t frameCount) {
     }
 }
 
+void ShadowRenderer::createParallelRecorder(VulkanApp* app, size_t frameCount) {
+    // render() indexes by the app's frame slot, so never size below the number
+    // of frames in flight or a slot's pools could be reset while still pending.
+    uint32_t frames = std::max<uint32_t>(static_cast<uint32_t>(frameCount), VulkanApp::MAX_FRAMES_IN_FLIGHT);
+    passRecorder_.init(app, frames, SHADOW_CASCADE_COUNT);
+}
+
 void ShadowRenderer::destroyStagingBuffers() {
     // Local CPU-side handles are cleared; Vulkan objects are destroyed via
     // VulkanResourceManager.
@@ -55,16 +67,28 @@ void ShadowRenderer::destroyStagingBuffers() {
 }
 
 void ShadowRenderer::init(VulkanApp* app) {
+    appPtr = app;
     createShadowMaps(app);
-    createShadowPipeline(app);
+    createDummyImages(app);
     createBlurResources(app);
 }
 
+void ShadowRenderer::createPipelines(VulkanApp* app) {
+    createShadowPipeline(app);
+    createBlurPipeline(app);
+}
+
 void ShadowRenderer::cleanup(VulkanApp* app) {
 
     destroyStagingBuffers();
+    passRecorder_.cleanup();
 
+    BindlessHeap& heap = app->getBindlessHeap();
+    heap.releaseImage(dummyColorSlot);
+    dummyColorSlot = BindlessHeap::INVALID_INDEX;
     for (int i = 0; i < SHADOW_CASCADE_COUNT; i++) {
+        heap.releaseImage(cascades[i].colorSlot);
+        cascades[i].colorSlot = BindlessHeap::INVALID_INDEX;
         if (cascades[i].imguiDescSet != VK_NULL_HANDLE) {
             VkDescriptorSet ds = cascades[i].imguiDescSet;
             app->deferDestroyUntilAllPending([ds](){ ImGui_ImplVulkan_RemoveTexture(ds); });
@@ -119,6 +143,8 @@ void ShadowRenderer::createShadowMaps(VulkanApp* app) {
 
         cascadeDepthLayouts[c] = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
 
+        cas.colorSlot = app->getBindlessHeap().registerImage(cas.colorView, shadowMapSampler);
+
         // ImGui descriptor for shadow map visualisation
         cas.imguiDescSet = (VkDescriptorSet)ImGui_ImplVulkan_AddTexture(
             shadowMapSampler, cas.colorView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
@@ -145,9 +171,7 @@ void ShadowRenderer::createShadowPipeline(VulkanApp* app) {
         app->getOrCreateShaderModule("shaders/shadow_evsm.frag.spv"),
         VK_SHADER_STAGE_FRAGMENT_BIT);
 
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    if (app->getDescriptorSetLayout() != VK_NULL_HANDLE)
-        setLayouts.push_back(app->getDescriptorSetLayout());
+    std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
 
     GraphicsPipelineConfig cfg{};
     cfg.cullMode = VK_CULL_MODE_FRONT_BIT;
@@ -161,7 +185,7 @@ void ShadowRenderer::createShadowPipeline(VulkanApp* app) {
         },
         vk_layouts::defaultAttributes(),
         setLayouts,
-        nullptr,
+        app->getScenePushConstantRange(),
         cfg
     );
     shadowPipeline = pipeline;
@@ -170,22 +194,23 @@ void ShadowRenderer::createShadowPipeline(VulkanApp* app) {
     tescShader.info.module     = VK_NULL_HANDLE;
     teseShader.info.module     = VK_NULL_HANDLE;
     evsmFragment.info.module   = VK_NULL_HANDLE;
+}
 
-    // ── Create a tiny 1×1 RGBA32F image + depth dummy kept in READ_ONLY layouts
-    //    so the main descriptor set can bind it at 4/8/9 without a layout
-    //    mismatch during the shadow pass (the real EVSM maps are being written).
-    {
-        VkDevice device = app->getDevice();
-        RendererUtils::createImage2DWithVma(device, app, 1, 1,
-            EVSM_FORMAT,
-            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            VK_IMAGE_ASPECT_COLOR_BIT,
-            "ShadowRenderer: dummyColor", dummyColorImage, dummyColorAllocation, dummyColorMemory, dummyColorView);
+void ShadowRenderer::createDummyImages(VulkanApp* app) {
+    // A tiny 1×1 RGBA32F image kept in READ_ONLY layout: the shadow pass UBO
+    // points the cascade slots at it, so no descriptor the pass can reach
+    // names an EVSM map while it is being written.
+    VkDevice device = app->getDevice();
+    RendererUtils::createImage2DWithVma(device, app, 1, 1,
+        EVSM_FORMAT,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_IMAGE_ASPECT_COLOR_BIT,
+        "ShadowRenderer: dummyColor", dummyColorImage, dummyColorAllocation, dummyColorMemory, dummyColorView);
 
-        app->transitionImageLayoutLayer(dummyColorImage, EVSM_FORMAT,
-            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 0, 1);
-        app->setImageLayoutTracked(dummyColorImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
-    }
+    app->transitionImageLayoutLayer(dummyColorImage, EVSM_FORMAT,
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 0, 1);
+    app->setImageLayoutTracked(dummyColorImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
+    dummyColorSlot = app->getBindlessHeap().registerImage(dummyColorView, shadowMapSampler);
 }
 
 void ShadowRenderer::createBlurResources(VulkanApp* app) {
@@ -203,41 +228,6 @@ void ShadowRenderer::createBlurResources(VulkanApp* app) {
         0, nullptr,
         "ShadowRenderer: blurDescSetLayout");
 
-    // Pipeline layout
-    VkPushConstantRange pcRange{};
-    pcRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    pcRange.offset = 0;
-    pcRange.size = sizeof(float); // direction: 0 = horizontal, 1 = vertical
-
-    VkPipelineLayoutCreateInfo plInfo{};
-    plInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    plInfo.setLayoutCount = 1;
-    plInfo.pSetLayouts = &blurDescSetLayout;
-    plInfo.pushConstantRangeCount = 1;
-    plInfo.pPushConstantRanges = &pcRange;
-    if (vkCreatePipelineLayout(device, &plInfo, nullptr, &blurPipelineLayout) != VK_SUCCESS)
-        throw std::runtime_error("ShadowRenderer: failed to create blur pipeline layout");
-    app->resources.addPipelineLayout(blurPipelineLayout, "ShadowRenderer: blurPipelineLayout");
-
-    // Fullscreen vertex + blur fragment shader
-    ShaderStage vertShader(
-        app->getOrCreateShaderModule("shaders/fullscreen.vert.spv"),
-        VK_SHADER_STAGE_VERTEX_BIT);
-    ShaderStage fragShader(
-        app->getOrCreateShaderModule("shaders/evsm_blur.frag.spv"),
-        VK_SHADER_STAGE_FRAGMENT_BIT);
-
-    RendererUtils::FullscreenPipelineOpts opts{};
-    opts.colorAttachmentCount = 1;
-    blurPipeline = RendererUtils::buildFullscreenPipeline(
-        device, app, EVSM_FORMAT, VK_FORMAT_UNDEFINED,
-        blurPipelineLayout,
-        { vertShader.info, fragShader.info },
-        opts, "ShadowRenderer: blurPipeline");
-
-    vertShader.info.module = VK_NULL_HANDLE;
-    fragShader.info.module = VK_NULL_HANDLE;
-
     VkDescriptorPoolSize srPoolSize = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4};
     blurDescPool = descAlloc.createPool(
         &srPoolSize, 1, 4, 0,
@@ -289,7 +279,47 @@ void ShadowRenderer::createBlurResources(VulkanApp* app) {
     }
 }
 
-void ShadowRenderer::beginShadowPass(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t cascadeIndex, const glm::mat4& lightSpaceMatrix) {
+void ShadowRenderer::createBlurPipeline(VulkanApp* app) {
+    VkDevice device = app->getDevice();
+
+    // Pipeline layout
+    VkPushConstantRange pcRange{};
+    pcRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    pcRange.offset = 0;
+    pcRange.size = sizeof(float); // direction: 0 = horizontal, 1 = vertical
+
+    VkPipelineLayoutCreateInfo plInfo{};
+    plInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    plInfo.setLayoutCount = 1;
+    plInfo.pSetLayouts = &blurDescSetLayout;
+    plInfo.pushConstantRangeCount = 1;
+    plInfo.pPushConstantRanges = &pcRange;
+    if (vkCreatePipelineLayout(device, &plInfo, nullptr, &blurPipelineLayout) != VK_SUCCESS)
+        throw std::runtime_error("ShadowRenderer: failed to create blur pipeline layout");
+    app->resources.addPipelineLayout(blurPipelineLayout, "ShadowRenderer: blurPipelineLayout");
+
+    // Fullscreen vertex + blur fragment shader
+    ShaderStage vertShader(
+        app->getOrCreateShaderModule("shaders/fullscreen.vert.spv"),
+        VK_SHADER_STAGE_VERTEX_BIT);
+    ShaderStage fragShader(
+        app->getOrCreateShaderModule("shaders/evsm_blur.frag.spv"),
+        VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    RendererUtils::FullscreenPipelineOpts opts{};
+    opts.colorAttachmentCount = 1;
+    blurPipeline = RendererUtils::buildFullscreenPipeline(
+        device, app, EVSM_FORMAT, VK_FORMAT_UNDEFINED,
+        blurPipelineLayout,
+        { vertShader.info, fragShader.info },
+        opts, "ShadowRenderer: blurPipeline");
+
+    vertShader.info.module = VK_NULL_HANDLE;
+    fragShader.info.module = VK_NULL_HANDLE;
+}
+
+void ShadowRenderer::beginShadowPass(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t cascadeIndex, const glm::mat4& lightSpaceMatrix,
+                                     VkRenderingFlags renderingFlags) {
     uint32_t size = shadowMapSizes[cascadeIndex];
     auto& cas = cascades[cascadeIndex];
 
@@ -363,8 +393,17 @@ void ShadowRenderer::beginShadowPass(VulkanApp* app, VkCommandBuffer commandBuff
     renderingInfo.colorAttachmentCount = 1;
     renderingInfo.pColorAttachments = &colorAttachment;
     renderingInfo.pDepthAttachment = &depthAttachment;
+    renderingInfo.flags = renderingFlags;
 
+    // Dynamic state and binds are recorded by recordCascadeDraws(), which may
+    // target a secondary buffer (dynamic state is not inherited).
     vkCmdBeginRendering(commandBuffer, &renderingInfo);
+}
+
+uint32_t ShadowRenderer::recordCascadeDraws(VkCommandBuffer commandBuffer, uint32_t cascadeIndex, uint32_t size,
+                                            VkDescriptorSet ds, bool renderSolid, bool vegetationEnabled,
+                                            CommandBufferState* state) {
+    uint32_t draws = 0;
 
     VkViewport shadowViewport{};
     shadowViewport.x = 0.0f;
@@ -382,10 +421,48 @@ void ShadowRenderer::beginShadowPass(VulkanApp* app, VkCommandBuffer commandBuff
 
     vkCmdSetDepthBias(commandBuffer, 1.5f, 0.0f, 2.5f);
 
-    if (shadowPipeline != VK_NULL_HANDLE) {
-        if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, shadowPipeline);
-        else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipeline);
+    // Main set and bindless heap together: a secondary starts with nothing
+    // bound, and inline the previous cascade's blur rebound set 0 with its
+    // own layout.
+    VkPipelineLayout layout = getShadowPipelineLayout();
+    if (layout != VK_NULL_HANDLE && ds != VK_NULL_HANDLE) {
+        VkDescriptorSet sets[2] = { ds, appPtr->getBindlessHeap().getSet() };
+        if (state) state->bindGraphicsDescriptorSets(commandBuffer, layout, 0, 2, sets, 0, nullptr);
+        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 2, sets, 0, nullptr);
+    }
+
+    // Bind the EVSM shadow pipeline (shared by the solid and water depth
+    // draws; both use the same Vertex format and indexed-indirect draws).
+    VkPipeline solidShadowPipeline = getShadowPipeline();
+    if (solidShadowPipeline != VK_NULL_HANDLE) {
+        if (state) state->bindGraphicsPipeline(commandBuffer, solidShadowPipeline);
+        else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, solidShadowPipeline);
+    }
+
+    // Draw solid geometry into shadow map (can be toggled off to isolate
+    // vegetation shadows for debugging).
+    if (renderSolid && solidRenderer_) {
+        auto& shadowIR = solidRenderer_->getIndirectRenderer();
+        shadowIR.bindBuffers(commandBuffer);
+        if (shadowIR.drawCascadeOnly(commandBuffer, cascadeIndex)) ++draws;
     }
+
+    // Draw water geometry into the shadow map so water casts shadows at the
+    // same LoD as the main pass (the water cascade cull read the shared
+    // visibleLods selection). Reuses the same EVSM shadow pipeline.
+    if (liquidRenderer_) {
+        auto& waterShadowIR = liquidRenderer_->getIndirectRenderer();
+        waterShadowIR.bindBuffers(commandBuffer);
+        if (waterShadowIR.drawCascadeOnly(commandBuffer, cascadeIndex)) ++draws;
+    }
+
+    // Vegetation shadow pass: drawn after solid so its 2-buffer vertex
+    // bindings don't leak into the solid draw. Uses cascade-aware culling
+    // (prepareCullCascades dispatched in render()).
+    if (vegetationEnabled && vegetationRenderer_) {
+        draws += vegetationRenderer_->recordShadowCascade(commandBuffer, ds, cascadeIndex, state);
+    }
+    return draws;
 }
 
 void ShadowRenderer::endShadowPass(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t cascadeIndex) {
@@ -582,7 +659,27 @@ void ShadowRenderer::render(VulkanApp* app, VkCommandBuffer commandBuffer, uint3
                                       bool shadowTessellationEnabled, float lodBias,
                                       const glm::vec3& cameraPos) {
     if (commandBuffer == VK_NULL_HANDLE) return;
-    if (!shadowsEnabled) return;
+    renderedCascadeMask_ = 0;
+    drawCallCount_ = 0;
+    renderedPageCount_ = 0;
+    if (!shadowsEnabled) {
+        // Cached cascades are stale once the scene changes unobserved.
+        cascadesValid_ = false;
+        return;
+    }
+    auto renderStart = std::chrono::steady_clock::now();
+
+    // Cascade caching: only the masked cascades are re-rendered. Anything that
+    // changes what every cascade contains overrides the mask.
+    uint32_t renderMask = cascadeRenderMask_;
+    if (!cascadesValid_ || renderSolid != lastRenderSolid_ || vegetationEnabled != lastVegetationEnabled_ ||
+        shadowTessellationEnabled != lastShadowTessellation_) {
+        renderMask = (1u << SHADOW_CASCADE_COUNT) - 1;
+    }
+    cascadesValid_ = true;
+    lastRenderSolid_ = renderSolid;
+    lastVegetationEnabled_ = vegetationEnabled;
+    lastShadowTessellation_ = shadowTessellationEnabled;
 
     // Render each cascade: upload light-space UBO, draw scene, restore UBO
     const glm::mat4 cascadeMatrices[SHADOW_CASCADE_COUNT] = {
@@ -608,140 +705,103 @@ void ShadowRenderer::render(VulkanApp* app, VkCommandBuffer commandBuffer, uint3
     }
 
     // Acquire vegetation instance/indirect buffers before dynamic rendering
+    bool drawVegetation = false;
     if (vegetationEnabled && vegetationRenderer_) {
         vegetationRenderer_->recordReadBarriers(commandBuffer);
         vegetationRenderer_->prepareCullCascades(commandBuffer, cascadeMatrices);
+        drawVegetation = vegetationRenderer_->prepareShadowCascades(app, glm::vec3(uboStatic.viewPos));
+    }
+
+    // The frame's main set: its UBO is the one uploadPassUniforms rewrites
+    // per cascade, with the cascade slots on the dummy image.
+    VkDescriptorSet ds = app->getMainDescriptorSetForFrame(frameIdx);
+
+    // Kick off the cascade draw recordings. Everything they read (cull
+    // buffers, descriptor sets, wind UBO) was prepared above on this thread;
+    // the workers only record. The results are executed below in cascade
+    // order, interleaved with the UBO copies and blurs of the primary.
+    const bool parallel = parallelRecording_ && passRecorder_.isReady();
+    if (parallel) {
+        passRecorder_.beginFrame(frameIdx);
+        SecondaryRenderingFormats formats;
+        formats.colorFormats = { EVSM_FORMAT };
+        formats.depthFormat = VK_FORMAT_D32_SFLOAT;
+        for (uint32_t c = 0; c < SHADOW_CASCADE_COUNT; c++) {
+            if (!(renderMask & (1u << c))) continue;
+            passRecorder_.record(c, formats, [this, c, ds, renderSolid, drawVegetation](VkCommandBuffer secondary) {
+                cascadeDraws_[c] = recordCascadeDraws(secondary, c, shadowMapSizes[c], ds, renderSolid, drawVegetation, nullptr);
+            });
+        }
     }
 
     for (int c = 0; c < SHADOW_CASCADE_COUNT; c++) {
+        if (!(renderMask & (1u << c))) {
+            // Cached: the image from the last render stays valid for the
+            // (unchanged) matrix the caller passes for this cascade.
+            cascadeRecordMs_[c] = 0.0f;
+            continue;
+        }
         glm::mat4 lsMatrix = cascadeMatrices[c];
 
         // Upload a shadow-specific UBO: viewProjection = cascade lightSpaceMatrix.
-        // passParams.x MUST be 0 so the TES computes fragPosWorld (needed by the EVSM
-        // fragment shader to produce correct moments).  With passParams.x=1 the TES
-        // outputs fragPosWorld = vec3(0) → EVSM gets garbage depth → no shadows.
-        UniformObject shadowUBO = uboStatic;
-        shadowUBO.viewProjection = lsMatrix;
-        shadowUBO.passParams.x = 0.0f;
-        shadowUBO.passParams.y = shadowTessellationEnabled ? 1.0f : 0.0f;
-
-        // Wait for previous cascade draws to finish reading the UBO
-        // before overwriting it via vkCmdCopyBuffer.
-        {
-            VkBufferMemoryBarrier2 preBarrier{};
-            preBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
-            preBarrier.srcStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
-            preBarrier.srcAccessMask = VK_ACCESS_2_UNIFORM_READ_BIT;
-            preBarrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-            preBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-            preBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            preBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            preBarrier.buffer = mainUniformBuffer.buffer;
-            preBarrier.offset = 0;
-            preBarrier.size = VK_WHOLE_SIZE;
-            VkDependencyInfo depInfo{};
-            depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-            depInfo.bufferMemoryBarrierCount = 1;
-            depInfo.pBufferMemoryBarriers = &preBarrier;
-            vkCmdPipelineBarrier2(commandBuffer, &depInfo);
-        }
+        UniformObject shadowUBO = passUniforms(uboStatic, lsMatrix, shadowTessellationEnabled);
 
-        // Upload shadow UBO via vkCmdCopyBuffer from persistently mapped staging
-        // buffer (avoids vkCmdUpdateBuffer's implicit FULL_QUEUE barrier).
-        VkDeviceSize stagingOff = static_cast<VkDeviceSize>(c) * sizeof(UniformObject);
-        if (frameIdx < uboStagingBuffers_.size()) {
-            memcpy(uboStagingBuffers_[frameIdx].map(stagingOff), &shadowUBO, sizeof(UniformObject));
-            VkBufferCopy copy{ stagingOff, 0, sizeof(UniformObject) };
-            vkCmdCopyBuffer(commandBuffer, uboStagingBuffers_[frameIdx].buffer, mainUniformBuffer.buffer, 1, &copy);
-        }
-        {
-            VkBufferMemoryBarrier2 memBarrier{};
-            memBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
-            memBarrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-            memBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-            memBarrier.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT | VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT | VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
-            memBarrier.dstAccessMask = VK_ACCESS_2_UNIFORM_READ_BIT;
-            memBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            memBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            memBarrier.buffer = mainUniformBuffer.buffer;
-            memBarrier.offset = 0;
-            memBarrier.size = VK_WHOLE_SIZE;
-            VkDependencyInfo depInfo{};
-            depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-            depInfo.bufferMemoryBarrierCount = 1;
-            depInfo.pBufferMemoryBarriers = &memBarrier;
-            vkCmdPipelineBarrier2(commandBuffer, &depInfo);
-        }
+        uploadPassUniforms(commandBuffer, frameIdx, static_cast<uint32_t>(c), mainUniformBuffer, shadowUBO);
 
         // Cascade-specific draw (no per-cascade cull — already handled above)
-        beginShadowPass(app, commandBuffer, c, lsMatrix);
-
-        // Bind shadow descriptor set (uses dummy depth at bindings 4,8,9)
-        VkPipelineLayout layout = getShadowPipelineLayout();
-        VkDescriptorSet ds = VK_NULL_HANDLE;
-        if (!shadowDescriptorSets_.empty()) {
-            uint32_t idx = frameIdx % static_cast<uint32_t>(shadowDescriptorSets_.size());
-            ds = shadowDescriptorSets_[idx];
-        }
-        if (layout != VK_NULL_HANDLE && ds != VK_NULL_HANDLE) {
-            if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, layout, 0, 1, &ds, 0, nullptr);
-            else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &ds, 0, nullptr);
-        }
-
-        // Bind the EVSM shadow pipeline (shared by the solid and water depth
-        // draws; both use the same Vertex format and indexed-indirect draws).
-        VkPipeline solidShadowPipeline = getShadowPipeline();
-        if (solidShadowPipeline != VK_NULL_HANDLE) {
-            if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, solidShadowPipeline);
-            else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, solidShadowPipeline);
-        }
-
-        // Draw solid geometry into shadow map (can be toggled off to isolate
-        // vegetation shadows for debugging).
-        if (renderSolid && solidRenderer_) {
-            auto& shadowIR = solidRenderer_->getIndirectRenderer();
-            shadowIR.bindBuffers(commandBuffer);
-            shadowIR.drawCascadeOnly(commandBuffer, c);
-        }
-
-        // Draw water geometry into the shadow map so water casts shadows at the
-        // same LoD as the main pass (the water cascade cull read the shared
-        // visibleLods selection). Reuses the same EVSM shadow pipeline.
-        if (liquidRenderer_) {
-            auto& waterShadowIR = liquidRenderer_->getIndirectRenderer();
-            waterShadowIR.bindBuffers(commandBuffer);
-            waterShadowIR.drawCascadeOnly(commandBuffer, c);
-        }
-
-        // Vegetation shadow pass: drawn after solid so its 2-buffer vertex
-        // bindings don't leak into the solid draw. Uses cascade-aware culling
-        // (prepareCullCascades dispatched above).
-        if (vegetationEnabled && vegetationRenderer_) {
-            const glm::vec3 camPos = glm::vec3(uboStatic.viewPos);
-            vegetationRenderer_->drawShadowCascade(app, commandBuffer, ds, camPos, c);
+        VkCommandBuffer secondary = parallel ? passRecorder_.finish(c) : VK_NULL_HANDLE;
+        if (secondary != VK_NULL_HANDLE) {
+            beginShadowPass(app, commandBuffer, c, lsMatrix, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT);
+            vkCmdExecuteCommands(commandBuffer, 1, &secondary);
+            // Bound state is undefined after executing secondaries.
+            if (cmdState) cmdState->reset();
+            cascadeRecordMs_[c] = passRecorder_.getPassRecordMs(c);
+        } else {
+            auto t0 = std::chrono::steady_clock::now();
+            beginShadowPass(app, commandBuffer, c, lsMatrix);
+            cascadeDraws_[c] = recordCascadeDraws(commandBuffer, c, shadowMapSizes[c], ds, renderSolid, drawVegetation, cmdState);
+            cascadeRecordMs_[c] = std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - t0).count();
         }
 
         endShadowPass(app, commandBuffer, c);
+        renderedCascadeMask_ |= 1u << c;
+        drawCallCount_ += cascadeDraws_[c];
 
         // Apply separable Gaussian blur (EVSM moment filtering) to reduce noise.
         // Skip the smallest cascade: at 512x512 the 3-tap blur is barely visible
         // and skipping it saves two fullscreen draws plus four layout transitions.
         if (c < SHADOW_CASCADE_COUNT - 1) {
             blurCascade(app, commandBuffer, c);
+            drawCallCount_ += 2;
         }
     }
 
-    // Restore GPU culling for the main camera frustum (was overwritten by
-    // per-cascade prepareCull calls above) so drawPrepared in the main pass
-    // uses the correct visible set.
-    if (solidRenderer_)
-        solidRenderer_->getIndirectRenderer().prepareCull(commandBuffer, uboStatic.viewProjection, cameraPos, lodBias);
-    if (brushRenderer_) {
-        brushRenderer_->getSolidIR().prepareCull(commandBuffer, uboStatic.viewProjection, cameraPos, lodBias);
-    }
+    restoreMainPass(commandBuffer, frameIdx, mainUniformBuffer, uboStatic, lodBias, cameraPos);
+    // The blurs bound set 0 with their own layout, which disturbed the heap.
+    app->bindBindlessHeap(commandBuffer);
 
-    // Restore the main UBO so subsequent passes see the original data.
-    // Wait for all shadow cascade draws to finish reading the UBO first.
+    recordWallMs_ = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - renderStart).count();
+}
+
+UniformObject ShadowRenderer::passUniforms(const UniformObject& uboStatic, const glm::mat4& viewProjection,
+                                           bool shadowTessellationEnabled) const {
+    // passParams.x MUST be 0 so the TES computes fragPosWorld (needed by the EVSM
+    // fragment shader to produce correct moments).  With passParams.x=1 the TES
+    // outputs fragPosWorld = vec3(0) → EVSM gets garbage depth → no shadows.
+    UniformObject ubo = uboStatic;
+    ubo.viewProjection = viewProjection;
+    ubo.passParams.x = 0.0f;
+    ubo.passParams.y = shadowTessellationEnabled ? 1.0f : 0.0f;
+    ubo.shadowSlots = glm::uvec4(dummyColorSlot, dummyColorSlot, dummyColorSlot, BindlessHeap::INVALID_INDEX);
+    return ubo;
+}
+
+void ShadowRenderer::uploadPassUniforms(VkCommandBuffer commandBuffer, uint32_t frameIdx, uint32_t slot,
+                                        Buffer& mainUniformBuffer, const UniformObject& ubo) {
+    // Wait for previous draws to finish reading the UBO before overwriting it
+    // via vkCmdCopyBuffer.
     {
         VkBufferMemoryBarrier2 preBarrier{};
         preBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
@@ -761,11 +821,13 @@ void ShadowRenderer::render(VulkanApp* app, VkCommandBuffer commandBuffer, uint3
         vkCmdPipelineBarrier2(commandBuffer, &depInfo);
     }
 
-    // Restore main UBO via vkCmdCopyBuffer from persistently mapped staging buffer.
-    VkDeviceSize restoreOff = static_cast<VkDeviceSize>(SHADOW_CASCADE_COUNT) * sizeof(UniformObject);
+    // Upload via vkCmdCopyBuffer from the persistently mapped staging buffer
+    // (avoids vkCmdUpdateBuffer's implicit FULL_QUEUE barrier). Every upload
+    // of a frame uses its own slot: the copies execute after recording ends.
+    VkDeviceSize stagingOff = static_cast<VkDeviceSize>(slot) * sizeof(UniformObject);
     if (frameIdx < uboStagingBuffers_.size()) {
-        memcpy(uboStagingBuffers_[frameIdx].map(restoreOff), &uboStatic, sizeof(UniformObject));
-        VkBufferCopy copy{ restoreOff, 0, sizeof(UniformObject) };
+        memcpy(uboStagingBuffers_[frameIdx].map(stagingOff), &ubo, sizeof(UniformObject));
+        VkBufferCopy copy{ stagingOff, 0, sizeof(UniformObject) };
         vkCmdCopyBuffer(commandBuffer, uboStagingBuffers_[frameIdx].buffer, mainUniformBuffer.buffer, 1, &copy);
     }
     {
@@ -787,3 +849,97 @@ void ShadowRenderer::render(VulkanApp* app, VkCommandBuffer commandBuffer, uint3
         vkCmdPipelineBarrier2(commandBuffer, &depInfo);
     }
 }
+
+void ShadowRenderer::restoreMainPass(VkCommandBuffer commandBuffer, uint32_t frameIdx, Buffer& mainUniformBuffer,
+                                     const UniformObject& uboStatic, float lodBias, const glm::vec3& cameraPos) {
+    // Restore GPU culling for the main camera frustum (was overwritten by
+    // the cascade culls) so drawPrepared in the main pass uses the correct
+    // visible set.
+    if (solidRenderer_)
+        solidRenderer_->getIndirectRenderer().prepareCull(commandBuffer, uboStatic.viewProjection, cameraPos, lodBias);
+    if (brushRenderer_) {
+        brushRenderer_->getSolidIR().prepareCull(commandBuffer, uboStatic.viewProjection, cameraPos, lodBias);
+    }
+
+    // Restore the main UBO so subsequent passes see the original data.
+    uploadPassUniforms(commandBuffer, frameIdx, SHADOW_CASCADE_COUNT, mainUniformBuffer, uboStatic);
+}
+
+void ShadowRenderer::renderVirtualPages(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t frameIdx,
+                                        Buffer& mainUniformBuffer, const UniformObject& uboStatic,
+                                        const VirtualShadowMap& vsm,
+                                        const std::vector<VirtualShadowMap::PageRender>& pages,
+                                        VirtualShadowRenderer& target,
+                                        bool renderSolid, bool vegetationEnabled,
+                                        bool shadowTessellationEnabled, float lodBias,
+                                        const glm::vec3& cameraPos) {
+    renderedCascadeMask_ = 0;
+    drawCallCount_ = 0;
+    renderedPageCount_ = 0;
+    // The cascades are not rendered in this mode; switching back must
+    // re-render all of them.
+    cascadesValid_ = false;
+    if (commandBuffer == VK_NULL_HANDLE || pages.empty()) {
+        recordWallMs_ = 0.0f;
+        return;
+    }
+    auto renderStart = std::chrono::steady_clock::now();
+    const size_t pageCount = std::min<size_t>(pages.size(), MAX_VIRTUAL_PAGES_PER_FRAME);
+
+    // The three cascade cull slots are reused as page groups (finest levels
+    // in slot 0), each culled once against the union of its pages: the cull
+    // buffers can only be prepared once per frame, and per-page draws clip
+    // the rest.
+    uint32_t maxLevel = 0;
+    for (size_t i = 0; i < pageCount; ++i) maxLevel = std::max(maxLevel, pages[i].level);
+    auto groupOf = [maxLevel](uint32_t level) {
+        return std::min<uint32_t>(SHADOW_CASCADE_COUNT - 1, level * SHADOW_CASCADE_COUNT / (maxLevel + 1));
+    };
+    glm::vec2 groupMin[SHADOW_CASCADE_COUNT], groupMax[SHADOW_CASCADE_COUNT];
+    bool groupUsed[SHADOW_CASCADE_COUNT] = {};
+    for (size_t i = 0; i < pageCount; ++i) {
+        uint32_t g = groupOf(pages[i].level);
+        groupMin[g] = groupUsed[g] ? glm::min(groupMin[g], pages[i].lsMin) : pages[i].lsMin;
+        groupMax[g] = groupUsed[g] ? glm::max(groupMax[g], pages[i].lsMax) : pages[i].lsMax;
+        groupUsed[g] = true;
+    }
+    glm::mat4 groupMatrices[SHADOW_CASCADE_COUNT];
+    glm::mat4 fallback = pages[0].lightSpaceMatrix;
+    for (int g = 0; g < SHADOW_CASCADE_COUNT; ++g)
+        groupMatrices[g] = groupUsed[g] ? vsm.regionMatrix(groupMin[g], groupMax[g]) : fallback;
+
+    if (solidRenderer_)
+        solidRenderer_->getIndirectRenderer().prepareCullCascades(commandBuffer, groupMatrices, cameraPos, lodBias);
+    if (liquidRenderer_)
+        liquidRenderer_->getIndirectRenderer().prepareCullCascades(commandBuffer, groupMatrices, cameraPos, lodBias);
+
+    bool drawVegetation = false;
+    if (vegetationEnabled && vegetationRenderer_) {
+        vegetationRenderer_->recordReadBarriers(commandBuffer);
+        vegetationRenderer_->prepareCullCascades(commandBuffer, groupMatrices);
+        drawVegetation = vegetationRenderer_->prepareShadowCascades(app, glm::vec3(uboStatic.viewPos));
+    }
+
+    VkDescriptorSet ds = app->getMainDescriptorSetForFrame(frameIdx);
+
+    for (size_t i = 0; i < pageCount; ++i) {
+        const auto& page = pages[i];
+        // Same UBO rules as the cascades; the atlas layers are the render
+        // targets here, so its slot goes to the dummy atlas too.
+        UniformObject shadowUBO = passUniforms(uboStatic, page.lightSpaceMatrix, shadowTessellationEnabled);
+        shadowUBO.textureSlots1.z = target.getDummyAtlasSlot();
+        uploadPassUniforms(commandBuffer, frameIdx, SHADOW_CASCADE_COUNT + 1 + static_cast<uint32_t>(i),
+                           mainUniformBuffer, shadowUBO);
+
+        target.beginPage(commandBuffer, page.physical);
+        drawCallCount_ += recordCascadeDraws(commandBuffer, groupOf(page.level), target.getPageTexels(),
+                                             ds, renderSolid, drawVegetation, cmdState);
+        target.endPage(commandBuffer, page.physical);
+        ++renderedPageCount_;
+    }
+
+    restoreMainPass(commandBuffer, frameIdx, mainUniformBuffer, uboStatic, lodBias, cameraPos);
+
+    recordWallMs_ = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - renderStart).count();
+}
@@ -8,17 +8,28 @@
 #include <vector>
 #include "../ubo/UniformObject.hpp"
 #include "CommandBufferState.hpp"
+#include "ParallelPassRecorder.hpp"
+#include "../../utils/VirtualShadowMap.hpp"
 
 class SolidRenderer;
 class WaterRenderer;
 class VegetationRenderer;
 class BrushRenderer;
+class VirtualShadowRenderer;
 
 class ShadowRenderer : public Renderer {
 public:
+    // Upper bound on virtual shadow map pages rendered per frame (one UBO
+    // staging slot each).
+    static constexpr uint32_t MAX_VIRTUAL_PAGES_PER_FRAME = 32;
+
     ShadowRenderer(uint32_t maxShadowMapSize = 2048);
     ~ShadowRenderer();
+    // Shadow maps, dummy images and blur descriptor sets.
     void init(VulkanApp* app);
+    // EVSM and blur pipelines; pure pipeline creation, safe to run as a
+    // PipelineRegistry builder once init() has created the blur set layout.
+    void createPipelines(VulkanApp* app);
     void cleanup(VulkanApp* app) override;
 
     // Inject the scene sub-renderers whose geometry is drawn into the shadow
@@ -33,12 +44,34 @@ public:
     void createStagingBuffers(VulkanApp* app, size_t frameCount);
     void destroyStagingBuffers();
 
-    // Shadow-specific descriptor sets (one per frame). Each mirrors the main
-    // descriptor set but bindings 4, 8, 9 point to a dummy depth view. The
-    // sets are allocated and maintained by SceneRenderer (which owns the
-    // static scene descriptor wiring); their handles are stable after init,
-    // so ShadowRenderer caches them once.
-    void setShadowDescriptorSets(const std::vector<VkDescriptorSet>& sets) { shadowDescriptorSets_ = sets; }
+    // Per-frame secondary command pools used to record the cascade draws in
+    // parallel (one pass slot per cascade). Same frame count as the staging
+    // buffers.
+    void createParallelRecorder(VulkanApp* app, size_t frameCount);
+
+    // When enabled (default), render() records each cascade's draws into a
+    // secondary command buffer on a worker thread and executes them in cascade
+    // order; barriers, UBO copies and blurs stay in the primary. When disabled,
+    // or if a secondary fails to record, the draws are recorded inline.
+    void setParallelRecording(bool enabled) { parallelRecording_ = enabled; }
+    bool isParallelRecording() const { return parallelRecording_; }
+    // CPU time spent recording each cascade's draws in the last render(), and
+    // the wall time of the whole render() call on the main thread.
+    float getCascadeRecordMs(uint32_t cascade) const { return cascade < SHADOW_CASCADE_COUNT ? cascadeRecordMs_[cascade] : 0.0f; }
+    float getRecordWallMs() const { return recordWallMs_; }
+    size_t getRecordWorkerCount() const { return passRecorder_.getWorkerCount(); }
+
+    // Cascades to re-render this frame (bit c = cascade c), normally
+    // ShadowParams::cascadeRenderMask(). Skipped cascades keep their EVSM
+    // image from the frame they were last rendered; the caller must keep
+    // sampling them with the matrix they were rendered with. Every cascade is
+    // re-rendered regardless after shadows were disabled or when the
+    // solid/vegetation/tessellation toggles change.
+    void setCascadeRenderMask(uint32_t mask) { cascadeRenderMask_ = mask; }
+    // Shadow pass statistics of the last render(): cascades actually rendered
+    // (bit mask) and draw commands recorded (cascade draws plus blur passes).
+    uint32_t getRenderedCascadeMask() const { return renderedCascadeMask_; }
+    uint32_t getDrawCallCount() const { return drawCallCount_; }
 
     // Full shadow pass orchestration: per-cascade UBO upload, culling of the
     // solid/water/vegetation scene against all cascade frustums, cascade
@@ -50,8 +83,27 @@ public:
                           bool shadowsEnabled, bool renderSolid, bool vegetationEnabled,
                           bool shadowTessellationEnabled, float lodBias,
                           const glm::vec3& cameraPos);
-    // Render shadow pass for a single cascade
-    void beginShadowPass(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t cascadeIndex, const glm::mat4& lightSpaceMatrix);
+    // Virtual shadow map path (replaces render() while that mode is selected):
+    // draws the pages VirtualShadowMap::takeRenderBatch() returned into
+    // `target`'s atlas layers, at most MAX_VIRTUAL_PAGES_PER_FRAME of them.
+    // The cascade cull slots are reused for three page groups, each culled
+    // once against the union of its pages. Pages are not blurred. Restores the
+    // main UBO and main-camera cull like render(), and marks the cascades
+    // stale so they are all re-rendered when switching back.
+    void renderVirtualPages(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t frameIdx,
+                            Buffer& mainUniformBuffer, const UniformObject& uboStatic,
+                            const VirtualShadowMap& vsm,
+                            const std::vector<VirtualShadowMap::PageRender>& pages,
+                            VirtualShadowRenderer& target,
+                            bool renderSolid, bool vegetationEnabled,
+                            bool shadowTessellationEnabled, float lodBias,
+                            const glm::vec3& cameraPos);
+    uint32_t getRenderedPageCount() const { return renderedPageCount_; }
+    // Render shadow pass for a single cascade. Pass
+    // VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT when the draws are
+    // provided by vkCmdExecuteCommands.
+    void beginShadowPass(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t cascadeIndex, const glm::mat4& lightSpaceMatrix,
+                         VkRenderingFlags renderingFlags = 0);
     void endShadowPass(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t cascadeIndex);
     // EVSM blur for a single cascade (horizontal + vertical passes)
     void blurCascade(VulkanApp* app, VkCommandBuffer commandBuffer, uint32_t cascadeIndex);
@@ -59,11 +111,14 @@ public:
     VkImageView getShadowMapView(uint32_t cascade = 0) const { return cascades[cascade].colorView; }
     VkImageView getShadowDepthView(uint32_t cascade = 0) const { return cascades[cascade].depthView; }
     VkSampler getShadowMapSampler() const { return shadowMapSampler; }
+    // Bindless heap slots of the EVSM cascades, and of the dummy image the
+    // shadow pass UBO points them at while the cascades are render targets.
+    uint32_t getShadowMapSlot(uint32_t cascade = 0) const { return cascades[cascade].colorSlot; }
+    uint32_t getDummyDepthSlot() const { return dummyColorSlot; }
     VkDescriptorSet getImGuiDescriptorSet(uint32_t cascade = 0) const { return cascades[cascade].imguiDescSet; }
     uint32_t getShadowMapSize(uint32_t cascade = 0) const { return shadowMapSizes[cascade]; }
     VkPipeline getShadowPipeline() const { return shadowPipeline; }
     VkPipelineLayout getShadowPipelineLayout() const { return shadowPipelineLayout; }
-    VkImageView getDummyDepthView() const { return dummyColorView; }
     VkImage getDepthImage(uint32_t cascade = 0) const;
     VkImageLayout getDepthLayout(uint32_t cascade = 0) const;
     void setDepthLayout(uint32_t cascade, VkImageLayout layout);
@@ -85,6 +140,7 @@ private:
         VmaAllocation depthAllocation = VK_NULL_HANDLE;
         VkDeviceMemory depthMemory = VK_NULL_HANDLE;
         VkImageView depthView = VK_NULL_HANDLE;
+        uint32_t colorSlot = UINT32_MAX;  // bindless heap slot of colorView
         TrackedHandle<VkDescriptorSet> imguiDescSet;
     };
     CascadeResources cascades[SHADOW_CASCADE_COUNT];
@@ -97,6 +153,7 @@ private:
     VmaAllocation dummyColorAllocation = VK_NULL_HANDLE;
     VkDeviceMemory dummyColorMemory = VK_NULL_HANDLE;
     VkImageView dummyColorView = VK_NULL_HANDLE;
+    uint32_t dummyColorSlot = UINT32_MAX;
 
     // Shadow pipeline (writes EVSM moments to color)
     TrackedHandle<VkPipeline> shadowPipeline;
@@ -119,14 +176,52 @@ private:
 
     void createShadowMaps(VulkanApp* app);
     void createShadowPipeline(VulkanApp* app);
+    void createDummyImages(VulkanApp* app);
     void createBlurResources(VulkanApp* app);
+    void createBlurPipeline(VulkanApp* app);
+    // Dynamic state, shadow pipeline/descriptor binds (the frame's main set and
+    // the bindless heap) and the solid, water and vegetation draws of one
+    // cascade. Records into either the primary (state =
+    // cmdState) or a worker-owned secondary (state = nullptr).
+    // Returns the number of draw commands recorded.
+    // `cascadeIndex` selects the cull slot drawn, `size` the square viewport.
+    uint32_t recordCascadeDraws(VkCommandBuffer commandBuffer, uint32_t cascadeIndex, uint32_t size,
+                                VkDescriptorSet ds, bool renderSolid, bool vegetationEnabled,
+                                CommandBufferState* state);
+    // Copy `ubo` into the main UBO through staging slot `slot` of the frame,
+    // with the read-before-write and write-before-read barriers.
+    // `uboStatic` with the shadow pass camera, and the cascade slots pointed
+    // at the dummy image (the cascades may be render targets).
+    UniformObject passUniforms(const UniformObject& uboStatic, const glm::mat4& viewProjection,
+                               bool shadowTessellationEnabled) const;
+    void uploadPassUniforms(VkCommandBuffer commandBuffer, uint32_t frameIdx, uint32_t slot,
+                            Buffer& mainUniformBuffer, const UniformObject& ubo);
+    // Main-camera cull and main UBO restore after a shadow pass.
+    void restoreMainPass(VkCommandBuffer commandBuffer, uint32_t frameIdx, Buffer& mainUniformBuffer,
+                         const UniformObject& uboStatic, float lodBias, const glm::vec3& cameraPos);
     std::array<VkImageLayout, SHADOW_CASCADE_COUNT> cascadeDepthLayouts = {};
 
     // Per-frame staging buffers for UBO uploads via vkCmdCopyBuffer
     std::vector<Buffer> uboStagingBuffers_;
 
-    // Per-frame shadow descriptor sets (cached handles, owned by SceneRenderer)
-    std::vector<VkDescriptorSet> shadowDescriptorSets_;
+    // Parallel cascade recording
+    ParallelPassRecorder passRecorder_;
+    bool parallelRecording_ = true;
+    float cascadeRecordMs_[SHADOW_CASCADE_COUNT] = {};
+    float recordWallMs_ = 0.0f;
+    uint32_t cascadeDraws_[SHADOW_CASCADE_COUNT] = {};
+
+    // Cascade caching
+    uint32_t cascadeRenderMask_ = (1u << SHADOW_CASCADE_COUNT) - 1;
+    uint32_t renderedCascadeMask_ = 0;
+    uint32_t drawCallCount_ = 0;
+    uint32_t renderedPageCount_ = 0;
+    bool cascadesValid_ = false;        // images hold content from an enabled frame
+    bool lastRenderSolid_ = false;
+    bool lastVegetationEnabled_ = false;
+    bool lastShadowTessellation_ = false;
+
+    VulkanApp* appPtr = nullptr;
 
     // Scene sub-renderers drawn into the shadow map (injected via setSceneRenderers)
     SolidRenderer* solidRenderer_ = nullptr;
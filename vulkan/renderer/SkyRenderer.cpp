@@ -16,9 +16,10 @@ SkyRenderer::SkyRenderer() {}
 SkyRenderer::~SkyRenderer() { cleanup(nullptr); }
 
 void SkyRenderer::init(VulkanApp* app) {
-    // Use the application's main descriptor set layout (set 0 contains the shared UBO)
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    setLayouts.push_back(app->getDescriptorSetLayout());
+    // Scene layouts (set 0 = shared UBO, set 1 = bindless heap) and the scene
+    // push range, so drawing the sky leaves the heap bound for the next pass.
+    const std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
+    const VkPushConstantRange* pushRange = app->getScenePushConstantRange();
 
     // --- Fullscreen sky pipelines (no vertex input, 3-vertex triangle) ---
     // These are used for on-screen rendering. The vertex shader reconstructs
@@ -40,8 +41,10 @@ void SkyRenderer::init(VulkanApp* app) {
     {
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        layoutInfo.setLayoutCount = 1;
+        layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
         layoutInfo.pSetLayouts = setLayouts.data();
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = pushRange;
         VkPipelineLayout fsLayout = VK_NULL_HANDLE;
         if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &fsLayout) != VK_SUCCESS)
             throw std::runtime_error("Failed to create sky fullscreen pipeline layout!");
@@ -63,8 +66,10 @@ void SkyRenderer::init(VulkanApp* app) {
     {
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        layoutInfo.setLayoutCount = 1;
+        layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
         layoutInfo.pSetLayouts = setLayouts.data();
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = pushRange;
         VkPipelineLayout fsGridLayout = VK_NULL_HANDLE;
         if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &fsGridLayout) != VK_SUCCESS)
             throw std::runtime_error("Failed to create sky fullscreen grid pipeline layout!");
@@ -100,7 +105,7 @@ void SkyRenderer::init(VulkanApp* app) {
             VkVertexInputAttributeDescription{ ATTR_NORMAL, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal) },
         },
         setLayouts,
-        nullptr,
+        pushRange,
         cfg
     );
     skyPipeline = pipeline;
@@ -126,7 +131,7 @@ void SkyRenderer::init(VulkanApp* app) {
             VkVertexInputAttributeDescription{ ATTR_NORMAL, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal) },
         },
         setLayouts,
-        nullptr,
+        pushRange,
         gridCfg
     );
     skyGridPipeline = gridPipeline;
@@ -252,19 +257,15 @@ void SkyRenderer::createOffscreenTargets(VulkanApp* app, uint32_t width, uint32_
             {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_FRAGMENT_BIT, skyEquirectFragModule, "main", nullptr},
         };
 
-        // Push constant for resolution (vec2)
-        VkPushConstantRange pushRange{};
-        pushRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-        pushRange.offset = 0;
-        pushRange.size = sizeof(float) * 2;
-
-        VkDescriptorSetLayout setLayout = app->getDescriptorSetLayout();
+        // Scene layouts: the resolution push (vec2) goes through the shared
+        // scene push range, which keeps the heap bound at set 1.
+        const std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        layoutInfo.setLayoutCount = 1;
-        layoutInfo.pSetLayouts = &setLayout;
+        layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        layoutInfo.pSetLayouts = setLayouts.data();
         layoutInfo.pushConstantRangeCount = 1;
-        layoutInfo.pPushConstantRanges = &pushRange;
+        layoutInfo.pPushConstantRanges = app->getScenePushConstantRange();
 
         if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &skyEquirectPipelineLayout) != VK_SUCCESS)
             throw std::runtime_error("Failed to create sky equirect pipeline layout!");
@@ -283,6 +284,7 @@ void SkyRenderer::createOffscreenTargets(VulkanApp* app, uint32_t width, uint32_
                     offscreenWidth, offscreenHeight,
                     skyColorImages[i], skyColorAllocations[i], skyColorMemories[i], skyColorImageViews[i]);
         skyColorLayouts[i] = VK_IMAGE_LAYOUT_UNDEFINED;
+        skyImageInputs[i] = {};
     }
 
     std::cerr << "[SkyRenderer] Created equirectangular sky targets " << offscreenWidth << "x" << offscreenHeight << std::endl;
@@ -302,6 +304,7 @@ void SkyRenderer::destroyOffscreenTargets(VulkanApp* app) {
         skyColorAllocations[i] = VK_NULL_HANDLE;
         skyColorMemories[i] = VK_NULL_HANDLE;
         skyColorLayouts[i] = VK_IMAGE_LAYOUT_UNDEFINED;
+        skyImageInputs[i] = {};
     }
     skyEquirectPipeline = VK_NULL_HANDLE;
     skyEquirectPipelineLayout = VK_NULL_HANDLE;
@@ -326,6 +329,19 @@ void SkyRenderer::renderOffscreen(VulkanApp* app, VkCommandBuffer cmd, uint32_t
     // Guard against invalid image handles (pre-existing RADV issue)
     if (skyColorImages[frameIndex] == VK_NULL_HANDLE) return;
 
+    // The equirect only depends on the sky UBO and the light direction:
+    // re-render this frame's image only when one of them changed since it
+    // was last drawn (each frame in flight owns its own image).
+    SkyImageInputs& inputs = skyImageInputs[frameIndex];
+    const uint64_t skyVersion = skySphere ? skySphere->getContentVersion() : 0;
+    if (inputs.valid && skyColorLayouts[frameIndex] == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL &&
+        inputs.skyVersion == skyVersion && inputs.lightDir == ubo.lightDir) {
+        return;
+    }
+    inputs.valid = true;
+    inputs.skyVersion = skyVersion;
+    inputs.lightDir = ubo.lightDir;
+
     // Transition color image: tracked layout → COLOR_ATTACHMENT_OPTIMAL
     {
         VkAccessFlags2 srcAccess;
@@ -375,7 +391,7 @@ void SkyRenderer::renderOffscreen(VulkanApp* app, VkCommandBuffer cmd, uint32_t
 
     // Push resolution constant
     float resolution[2] = { static_cast<float>(offscreenWidth), static_cast<float>(offscreenHeight) };
-    vkCmdPushConstants(cmd, skyEquirectPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(resolution), resolution);
+    vkCmdPushConstants(cmd, skyEquirectPipelineLayout, VK_SHADER_STAGE_ALL_GRAPHICS, 0, sizeof(resolution), resolution);
 
     VkViewport viewport{0.0f, 0.0f, (float)offscreenWidth, (float)offscreenHeight, 0.0f, 1.0f};
     vkCmdSetViewport(cmd, 0, 1, &viewport);
@@ -37,7 +37,9 @@ public:
     void createOffscreenTargets(VulkanApp* app, uint32_t width, uint32_t height);
     void destroyOffscreenTargets(VulkanApp* app);
 
-    // Render the sky to its own offscreen color attachment
+    // Render the sky to its own offscreen color attachment. The equirect is
+    // view-independent, so the draw is skipped when the frame's image already
+    // holds the current sky data and light direction (the UBO is still written).
     void renderOffscreen(VulkanApp* app, VkCommandBuffer cmd, uint32_t frameIndex,
                          VkDescriptorSet descriptorSet, Buffer &uniformBuffer,
                          const UniformObject &ubo, const glm::mat4 &viewProjection,
@@ -88,6 +90,14 @@ private:
     std::array<VkImageView, SKY_FRAMES> skyColorImageViews = {};
     std::array<VkImageLayout, SKY_FRAMES> skyColorLayouts = {};
 
+    // Inputs each equirect image was last rendered with
+    struct SkyImageInputs {
+        bool valid = false;
+        uint64_t skyVersion = 0;
+        glm::vec4 lightDir = glm::vec4(0.0f);
+    };
+    std::array<SkyImageInputs, SKY_FRAMES> skyImageInputs = {};
+
     // Equirect pipeline (fullscreen triangle, no vertex input, no depth)
     TrackedHandle<VkPipeline> skyEquirectPipeline;
     TrackedHandle<VkPipelineLayout> skyEquirectPipelineLayout;
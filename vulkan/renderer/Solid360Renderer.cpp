@@ -4,9 +4,37 @@
 #include "../ShaderStage.hpp"
 #include "../includes/vertex_layouts.hpp"
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <bit>
+#include <chrono>
 #include <stdexcept>
 #include <iostream>
 
+namespace {
+struct FaceInfo { glm::vec3 target; glm::vec3 up; };
+// Cubemap face order and orientation: +X, -X, +Y, -Y, +Z, -Z.
+// NOTE: face targets are intentionally inverted to match the convention
+// used by water.frag's reflect(refract(viewDir, ...)) which passes the
+// view direction directly (surface→eye) rather than negating it first.
+const FaceInfo CUBE_FACES[6] = {
+    { glm::vec3(-1, 0, 0), glm::vec3(0,-1, 0) }, // +X
+    { glm::vec3( 1, 0, 0), glm::vec3(0,-1, 0) }, // -X
+    { glm::vec3( 0,-1, 0), glm::vec3(0, 0, 1) },  // +Y
+    { glm::vec3( 0, 1, 0), glm::vec3(0, 0,-1) },  // -Y
+    { glm::vec3( 0, 0,-1), glm::vec3(0,-1, 0) }, // +Z
+    { glm::vec3( 0, 0, 1), glm::vec3(0,-1, 0) }, // -Z
+};
+
+constexpr uint32_t ALL_FACES_MASK = 0x3Fu;
+// Camera travel (as a fraction of the far plane) after which a face is
+// re-rendered regardless of the budget: a teleport would otherwise show a
+// mix of reflections from two places for several frames.
+constexpr float FULL_REFRESH_FAR_FRACTION = 0.05f;
+// Camera travel (as a fraction of the far plane) worth one frame of age
+// when ranking faces in CameraPriority mode.
+constexpr float MOTION_SCORE_FAR_FRACTION = 0.001f;
+}
+
 Solid360Renderer::Solid360Renderer() {}
 Solid360Renderer::~Solid360Renderer() {}
 
@@ -19,9 +47,13 @@ void Solid360Renderer::init(VulkanApp* app) {
         }
     }
     stagingFrameIndex = 0;
+    // Two pass slots per face (depth pre-pass, colour pass), one pool set per
+    // frame in flight: render() resets the slots of its frameIndex.
+    passRecorder_.init(app, VulkanApp::MAX_FRAMES_IN_FLIGHT, 12);
 }
 
 void Solid360Renderer::cleanup(VulkanApp* app) {
+    passRecorder_.cleanup();
     if (app) {
         VkDevice dev = app->getDevice();
         if (depthOnlyPipeline != VK_NULL_HANDLE) {
@@ -126,6 +158,7 @@ void Solid360Renderer::createSolid360Targets(VulkanApp* app, VkSampler linearSam
 
     // Keep the sampler used for solid 360 sampling, which must be clamp-to-edge.
     solid360Sampler = linearSampler;
+    cube360CubeSlot = app->getBindlessHeap().registerImage(cube360CubeView, linearSampler);
 
     // --- 2. Depth image with per-face layers (one layer per cubemap face) ---
     {
@@ -167,10 +200,12 @@ void Solid360Renderer::createSolid360Targets(VulkanApp* app, VkSampler linearSam
         cube360ColorLayouts[face] = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
         cube360DepthLayouts[face] = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     }
+    // The layers hold no rendered content yet: refresh all of them first
+    validFaceMask = 0;
 
-    // --- 3. Dummy 1x1x6 cubemap for binding #11 during cubemap rendering ---
-    // This is a SEPARATE image from cube360ColorImage, so that the sampler
-    // at binding #11 of cube360GfxDs does not reference the same image as the
+    // --- 3. Dummy 1x1x6 cubemap sampled during cubemap rendering ---
+    // This is a SEPARATE image from cube360ColorImage, so that the environment
+    // cube slot of the face UBO does not reference the same image as the
     // color attachment, eliminating the SYNC-HAZARD-READ-AFTER-WRITE.
     {
         VkImageCreateInfo imgInfo{};
@@ -198,6 +233,7 @@ void Solid360Renderer::createSolid360Targets(VulkanApp* app, VkSampler linearSam
     createView(cube360DummyColorImage, colorFormat, VK_IMAGE_ASPECT_COLOR_BIT,
                VK_IMAGE_VIEW_TYPE_CUBE, 0, 6,
                cube360DummyCubeView, "Solid360Renderer: dummy cube view");
+    cube360DummyCubeSlot = app->getBindlessHeap().registerImage(cube360DummyCubeView, linearSampler);
 
     // NOTE: equirectangular conversion removed. Use the cubemap directly as the
     // reflection target (sample with samplerCube in shaders).
@@ -207,6 +243,12 @@ void Solid360Renderer::destroySolid360Targets(VulkanApp* app) {
     if (app && cube360DepthImage != VK_NULL_HANDLE) {
         app->setImageLayoutTracked(cube360DepthImage, VK_IMAGE_LAYOUT_UNDEFINED, 0, 6);
     }
+    if (app) {
+        app->getBindlessHeap().releaseImage(cube360CubeSlot);
+        app->getBindlessHeap().releaseImage(cube360DummyCubeSlot);
+    }
+    cube360CubeSlot = UINT32_MAX;
+    cube360DummyCubeSlot = UINT32_MAX;
     cube360ColorImage = VK_NULL_HANDLE;
     cube360ColorAllocation = VK_NULL_HANDLE;
     cube360ColorMemory = VK_NULL_HANDLE;
@@ -227,6 +269,7 @@ void Solid360Renderer::destroySolid360Targets(VulkanApp* app) {
         cube360ColorLayouts[face] = VK_IMAGE_LAYOUT_UNDEFINED;
         cube360DepthLayouts[face] = VK_IMAGE_LAYOUT_UNDEFINED;
     }
+    validFaceMask = 0;
 }
 
 void Solid360Renderer::createSolid360Pipelines(VulkanApp* app) {
@@ -255,11 +298,7 @@ void Solid360Renderer::createSolid360Pipelines(VulkanApp* app) {
         VK_SHADER_STAGE_FRAGMENT_BIT
     );
 
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    if (app->getDescriptorSetLayout() != VK_NULL_HANDLE)
-        setLayouts.push_back(app->getDescriptorSetLayout());
-    if (app->getBrushDepthDescriptorSetLayout() != VK_NULL_HANDLE)
-        setLayouts.push_back(app->getBrushDepthDescriptorSetLayout());
+    const std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
 
     // Depth-only pipeline: lightweight fragment shader, no color attachment, depth write, LESS compare
     {
@@ -272,7 +311,7 @@ void Solid360Renderer::createSolid360Pipelines(VulkanApp* app) {
             std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
             vk_layouts::defaultAttributes(),
             setLayouts,
-            nullptr,
+            app->getScenePushConstantRange(),
             depthCfg
         );
         depthOnlyPipeline = pipeline;
@@ -290,7 +329,7 @@ void Solid360Renderer::createSolid360Pipelines(VulkanApp* app) {
             std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
             vk_layouts::defaultAttributes(),
             setLayouts,
-            nullptr,
+            app->getScenePushConstantRange(),
             colorCfg
         );
         equalComparePipeline = pipeline;
@@ -305,17 +344,167 @@ void Solid360Renderer::createSolid360Pipelines(VulkanApp* app) {
     vertexShader.info.module = VK_NULL_HANDLE;
 }
 
+void Solid360Renderer::setFaceBudget(uint32_t faces, FaceUpdateMode mode) {
+    facesPerFrame = std::clamp(faces, 1u, 6u);
+    faceUpdateMode = mode;
+}
+
+void Solid360Renderer::invalidateFaces() {
+    validFaceMask = 0;
+}
+
+void Solid360Renderer::invalidateRegion(const glm::vec3& boxMin, const glm::vec3& boxMax) {
+    for (uint32_t face = 0; face < 6; ++face) {
+        if (!(validFaceMask & (1u << face))) continue;
+        // Box relative to where the face was captured from; the face sees
+        // the 90° pyramid around its target axis.
+        const glm::vec3 lo = boxMin - faceCameraPos[face];
+        const glm::vec3 hi = boxMax - faceCameraPos[face];
+        const glm::vec3& dir = CUBE_FACES[face].target;
+        const int axis = dir.x != 0.0f ? 0 : (dir.y != 0.0f ? 1 : 2);
+        const float depth = dir[axis] > 0.0f ? hi[axis] : -lo[axis];
+        if (depth <= 0.0f) continue;
+        bool visible = true;
+        for (int b = 0; b < 3 && visible; ++b) {
+            if (b == axis) continue;
+            const float nearest = lo[b] > 0.0f ? lo[b] : (hi[b] < 0.0f ? -hi[b] : 0.0f);
+            visible = nearest <= depth;
+        }
+        if (visible) validFaceMask &= ~(1u << face);
+    }
+}
+
+uint32_t Solid360Renderer::selectFaces(const glm::vec3& camPos, float farPlane,
+                                       std::array<uint32_t, 6>& out) {
+    for (uint32_t& age : faceAge) ++age;
+
+    // Faces that must be refreshed regardless of the budget: never rendered
+    // (or invalidated) and faces captured from too far away.
+    const float refreshDistance = std::max(farPlane, 1.0f) * FULL_REFRESH_FAR_FRACTION;
+    uint32_t mask = ~validFaceMask & ALL_FACES_MASK;
+    for (uint32_t face = 0; face < 6; ++face) {
+        if (glm::distance(camPos, faceCameraPos[face]) > refreshDistance) mask |= 1u << face;
+    }
+
+    uint32_t count = static_cast<uint32_t>(std::popcount(mask));
+    if (faceUpdateMode == FaceUpdateMode::RoundRobin) {
+        for (uint32_t i = 0; i < 6 && count < facesPerFrame; ++i) {
+            const uint32_t face = (faceCursor + i) % 6;
+            if (mask & (1u << face)) continue;
+            mask |= 1u << face;
+            ++count;
+            faceCursor = (face + 1) % 6;
+        }
+    } else {
+        // Stalest first: age in frames plus the camera travel since the face
+        // was captured, weighted towards faces looking along the motion
+        // (their content changes fastest as the camera moves).
+        const float motionUnit = std::max(farPlane, 1.0f) * MOTION_SCORE_FAR_FRACTION;
+        while (count < facesPerFrame) {
+            int best = -1;
+            float bestScore = -1.0f;
+            for (uint32_t face = 0; face < 6; ++face) {
+                if (mask & (1u << face)) continue;
+                const glm::vec3 moved = camPos - faceCameraPos[face];
+                const float dist = glm::length(moved);
+                float facing = 0.0f;
+                if (dist > 0.0f) facing = std::max(glm::dot(moved / dist, CUBE_FACES[face].target), 0.0f);
+                const float score = static_cast<float>(faceAge[face]) + (dist / motionUnit) * (1.0f + facing);
+                if (score > bestScore) { bestScore = score; best = static_cast<int>(face); }
+            }
+            if (best < 0) break;
+            mask |= 1u << best;
+            ++count;
+        }
+    }
+
+    uint32_t n = 0;
+    for (uint32_t face = 0; face < 6; ++face) {
+        if (!(mask & (1u << face))) continue;
+        out[n++] = face;
+        faceAge[face] = 0;
+        faceCameraPos[face] = camPos;
+    }
+    validFaceMask |= mask;
+    return n;
+}
+
+void Solid360Renderer::recordDepthDraws(VkCommandBuffer cmd, SolidRenderer* solidRenderer,
+                                        VkDescriptorSet mainDescriptorSet, VkDescriptorSet heapSet, bool renderSolid,
+                                        VkBuffer compactIndirectBuffer, VkBuffer visibleCountBuffer,
+                                        CommandBufferState* state) {
+    VkViewport viewport{0.0f, 0.0f, (float)CUBE360_FACE_SIZE, (float)CUBE360_FACE_SIZE, 0.0f, 1.0f};
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    VkRect2D scissor{{0, 0}, {CUBE360_FACE_SIZE, CUBE360_FACE_SIZE}};
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+    if (renderSolid && solidRenderer && depthOnlyPipeline != VK_NULL_HANDLE) {
+        if (state) state->bindGraphicsPipeline(cmd, depthOnlyPipeline);
+        else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, depthOnlyPipeline);
+        VkDescriptorSet sets[2] = { mainDescriptorSet, heapSet };
+        if (state) state->bindGraphicsDescriptorSets(cmd, depthOnlyPipelineLayout, 0, 2, sets, 0, nullptr);
+        else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, depthOnlyPipelineLayout, 0, 2, sets, 0, nullptr);
+        if (compactIndirectBuffer != VK_NULL_HANDLE && visibleCountBuffer != VK_NULL_HANDLE) {
+            solidRenderer->getIndirectRenderer().drawPreparedWithBuffers(cmd, compactIndirectBuffer, visibleCountBuffer);
+        } else {
+            solidRenderer->getIndirectRenderer().drawPrepared(cmd, 0);
+        }
+    }
+}
+
+void Solid360Renderer::recordColorDraws(VkCommandBuffer cmd, SkyRenderer* skyRenderer, SkySettings::Mode skyMode,
+                                        SolidRenderer* solidRenderer, VkDescriptorSet mainDescriptorSet,
+                                        VkDescriptorSet heapSet, bool renderSolid,
+                                        VkBuffer compactIndirectBuffer, VkBuffer visibleCountBuffer,
+                                        CommandBufferState* state) {
+    VkViewport viewport{0.0f, 0.0f, (float)CUBE360_FACE_SIZE, (float)CUBE360_FACE_SIZE, 0.0f, 1.0f};
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    VkRect2D scissor{{0, 0}, {CUBE360_FACE_SIZE, CUBE360_FACE_SIZE}};
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+    // Sky first (background, no depth)
+    if (skyRenderer) {
+        VkPipeline skyPipe = (skyMode == SkySettings::Mode::Grid) ? skyRenderer->getSkyFullscreenGridPipeline() : skyRenderer->getSkyFullscreenPipeline();
+        VkPipelineLayout skyLayout = (skyMode == SkySettings::Mode::Grid) ? skyRenderer->getSkyFullscreenGridPipelineLayout() : skyRenderer->getSkyFullscreenPipelineLayout();
+        if (skyPipe != VK_NULL_HANDLE && skyLayout != VK_NULL_HANDLE) {
+            if (state) state->bindGraphicsPipeline(cmd, skyPipe);
+            else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, skyPipe);
+            VkDescriptorSet sets[2] = { mainDescriptorSet, heapSet };
+            if (state) state->bindGraphicsDescriptorSets(cmd, skyLayout, 0, 2, sets, 0, nullptr);
+            else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, skyLayout, 0, 2, sets, 0, nullptr);
+            vkCmdDraw(cmd, 3, 1, 0, 0);
+        }
+    }
+
+    // Solid geometry with LESS_OR_EQUAL, depth write (redundant but harmless)
+    if (renderSolid && solidRenderer) {
+        VkPipeline gfxPipe = solidRenderer->getGraphicsPipeline();
+        VkPipelineLayout gfxLayout = solidRenderer->getGraphicsPipelineLayout();
+        if (gfxPipe != VK_NULL_HANDLE && gfxLayout != VK_NULL_HANDLE) {
+            if (state) state->bindGraphicsPipeline(cmd, gfxPipe);
+            else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, gfxPipe);
+            VkDescriptorSet sets[2] = { mainDescriptorSet, heapSet };
+            if (state) state->bindGraphicsDescriptorSets(cmd, gfxLayout, 0, 2, sets, 0, nullptr);
+            else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, gfxLayout, 0, 2, sets, 0, nullptr);
+            if (compactIndirectBuffer != VK_NULL_HANDLE && visibleCountBuffer != VK_NULL_HANDLE) {
+                solidRenderer->getIndirectRenderer().drawPreparedWithBuffers(cmd, compactIndirectBuffer, visibleCountBuffer);
+            } else {
+                solidRenderer->getIndirectRenderer().drawPrepared(cmd, 0);
+            }
+        }
+    }
+}
+
 void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
                                      SkyRenderer* skyRenderer, SkySettings::Mode skyMode,
                                      SolidRenderer* solidRenderer,
                                      VkDescriptorSet mainDescriptorSet,
-                                     VkDescriptorSet brushDepthSet,
                                      Buffer& uniformBuffer, const UniformObject& ubo,
                                      bool renderSolid, bool renderWater,
-                                     VkDescriptorSet computeDs,
-                                     VkBuffer compactIndirectBuffer, VkBuffer visibleCountBuffer,
-                                     VkDescriptorSet waterComputeDs,
-                                     VkBuffer waterCompactIndirectBuffer, VkBuffer waterVisibleCountBuffer,
+                                     VkBuffer compactIndirectBuffer, uint32_t compactIndirectSlot,
+                                     VkBuffer visibleCountBuffer, uint32_t visibleCountSlot,
+                                     VkBuffer waterCompactIndirectBuffer, uint32_t waterCompactIndirectSlot,
+                                     VkBuffer waterVisibleCountBuffer, uint32_t waterVisibleCountSlot,
                                      uint32_t frameIndex) {
     if (!app || cmd == VK_NULL_HANDLE) return;
     if (cube360FaceViews[0] == VK_NULL_HANDLE) return;
@@ -325,19 +514,7 @@ void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
     Buffer& staging = stagingUBOs[stagingFrameIndex % STAGING_FRAMES];
 
     glm::vec3 camPos = glm::vec3(ubo.viewPos);
-    struct FaceInfo { glm::vec3 target; glm::vec3 up; };
-    // Cubemap face order and orientation: +X, -X, +Y, -Y, +Z, -Z.
-    // NOTE: face targets are intentionally inverted to match the convention
-    // used by water.frag's reflect(refract(viewDir, ...)) which passes the
-    // view direction directly (surface→eye) rather than negating it first.
-    const FaceInfo faces[6] = {
-        { glm::vec3(-1, 0, 0), glm::vec3(0,-1, 0) }, // +X
-        { glm::vec3( 1, 0, 0), glm::vec3(0,-1, 0) }, // -X
-        { glm::vec3( 0,-1, 0), glm::vec3(0, 0, 1) },  // +Y
-        { glm::vec3( 0, 1, 0), glm::vec3(0, 0,-1) },  // -Y
-        { glm::vec3( 0, 0,-1), glm::vec3(0,-1, 0) }, // +Z
-        { glm::vec3( 0, 0, 1), glm::vec3(0,-1, 0) }, // -Z
-    };
+    const auto& faces = CUBE_FACES;
 
     glm::mat4 faceProj = glm::perspective(glm::radians(90.0f), 1.0f, ubo.passParams.z, ubo.passParams.w);
     faceProj[1][1] *= -1;
@@ -352,7 +529,42 @@ void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
         waterRenderer->getIndirectRenderer().acquireBuffers(cmd);
     }
 
-    for (uint32_t face = 0; face < 6; ++face) {
+    std::array<uint32_t, 6> selectedFaces{};
+    const uint32_t selectedCount = selectFaces(camPos, ubo.passParams.w, selectedFaces);
+    facesRenderedLastFrame = selectedCount;
+    faceRecordMs_.fill(0.0f);
+
+    // Kick off the face draw recordings: the draws are the same for every
+    // face (the face UBO and cull results are written by the primary in
+    // between), so only read-only state is captured. The secondaries are
+    // executed below in face order, inside the primary's rendering scopes.
+    const VkDescriptorSet heapSet = app->getBindlessHeap().getSet();
+    const bool parallel = parallelRecording_ && passRecorder_.isReady();
+    if (parallel) {
+        passRecorder_.beginFrame(frameIndex);
+        SecondaryRenderingFormats depthFormats;
+        depthFormats.depthFormat = VK_FORMAT_D32_SFLOAT;
+        SecondaryRenderingFormats colorFormats;
+        colorFormats.colorFormats = { app->getSwapchainImageFormat() };
+        colorFormats.depthFormat = VK_FORMAT_D32_SFLOAT;
+        for (uint32_t s = 0; s < selectedCount; ++s) {
+            const uint32_t face = selectedFaces[s];
+            passRecorder_.record(face * 2, depthFormats,
+                [this, solidRenderer, mainDescriptorSet, heapSet, renderSolid, compactIndirectBuffer, visibleCountBuffer](VkCommandBuffer secondary) {
+                    recordDepthDraws(secondary, solidRenderer, mainDescriptorSet, heapSet, renderSolid,
+                                     compactIndirectBuffer, visibleCountBuffer, nullptr);
+                });
+            passRecorder_.record(face * 2 + 1, colorFormats,
+                [this, skyRenderer, skyMode, solidRenderer, mainDescriptorSet, heapSet, renderSolid,
+                 compactIndirectBuffer, visibleCountBuffer](VkCommandBuffer secondary) {
+                    recordColorDraws(secondary, skyRenderer, skyMode, solidRenderer, mainDescriptorSet, heapSet,
+                                     renderSolid, compactIndirectBuffer, visibleCountBuffer, nullptr);
+                });
+        }
+    }
+
+    for (uint32_t s = 0; s < selectedCount; ++s) {
+        const uint32_t face = selectedFaces[s];
         glm::mat4 faceView = glm::lookAt(camPos, camPos + faces[face].target, faces[face].up);
         glm::mat4 faceVP = faceProj * faceView;
 
@@ -360,6 +572,16 @@ void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
         faceUBO.viewProjection = faceVP;
         faceUBO.invViewProjection = glm::inverse(faceVP);
         faceUBO.materialFlags.x = 1.0f;
+        faceUBO.textureSlots1.y = cube360DummyCubeSlot;
+        if (waterRenderer) {
+            // Water in the cube faces samples no scene targets (and not the
+            // cube being rendered): point its scene slots at the dummies.
+            const uint32_t dummyDepth = waterRenderer->getCubemapDummyDepthSlot();
+            faceUBO.sceneSlots.z = dummyDepth;
+            faceUBO.sceneSlots.w = dummyDepth;
+            faceUBO.sceneSlots1.x = dummyDepth;
+            faceUBO.sceneSlots1.y = waterRenderer->getCubemapDummyCubeSlot();
+        }
 
         // Wait for previous face's draws to finish reading the UBO before overwriting it
         {
@@ -415,13 +637,19 @@ void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
         }
 
         // Per-face frustum cull — must run OUTSIDE dynamic rendering
-        if (renderSolid && computeDs != VK_NULL_HANDLE && compactIndirectBuffer != VK_NULL_HANDLE && visibleCountBuffer != VK_NULL_HANDLE) {
+        const bool solidCullReady = compactIndirectBuffer != VK_NULL_HANDLE && visibleCountBuffer != VK_NULL_HANDLE &&
+                                    compactIndirectSlot != BindlessHeap::INVALID_INDEX && visibleCountSlot != BindlessHeap::INVALID_INDEX;
+        if (renderSolid && solidCullReady) {
             auto &ind = solidRenderer->getIndirectRenderer();
-            ind.prepareCullWithDescriptor(cmd, faceVP, computeDs, compactIndirectBuffer, visibleCountBuffer, camPos);
+            ind.prepareCullWithSlots(cmd, faceVP, compactIndirectBuffer, compactIndirectSlot,
+                                     visibleCountBuffer, visibleCountSlot, camPos);
         }
         // Per-face water cull with dedicated buffers (no race with main pass)
-        if (renderWater && waterRenderer && waterComputeDs != VK_NULL_HANDLE && waterCompactIndirectBuffer != VK_NULL_HANDLE && waterVisibleCountBuffer != VK_NULL_HANDLE) {
-            waterRenderer->getIndirectRenderer().prepareCullWithDescriptor(cmd, faceVP, waterComputeDs, waterCompactIndirectBuffer, waterVisibleCountBuffer, camPos);
+        const bool waterCullReady = waterCompactIndirectBuffer != VK_NULL_HANDLE && waterVisibleCountBuffer != VK_NULL_HANDLE &&
+                                    waterCompactIndirectSlot != BindlessHeap::INVALID_INDEX && waterVisibleCountSlot != BindlessHeap::INVALID_INDEX;
+        if (renderWater && waterRenderer && waterCullReady) {
+            waterRenderer->getIndirectRenderer().prepareCullWithSlots(cmd, faceVP, waterCompactIndirectBuffer, waterCompactIndirectSlot,
+                                                                      waterVisibleCountBuffer, waterVisibleCountSlot, camPos);
         }
 
         // ── Instance 1: Depth pre-pass (no color, lightweight depth_only.frag) ──
@@ -446,23 +674,23 @@ void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
             ri.pColorAttachments = nullptr;
             ri.pDepthAttachment = &depthAtt;
 
-            vkCmdBeginRendering(cmd, &ri);
-
-            VkViewport viewport{0.0f, 0.0f, (float)CUBE360_FACE_SIZE, (float)CUBE360_FACE_SIZE, 0.0f, 1.0f};
-            vkCmdSetViewport(cmd, 0, 1, &viewport);
-            VkRect2D scissor{{0, 0}, {CUBE360_FACE_SIZE, CUBE360_FACE_SIZE}};
-            vkCmdSetScissor(cmd, 0, 1, &scissor);
-
-            if (renderSolid && solidRenderer && depthOnlyPipeline != VK_NULL_HANDLE) {
-                if (cmdState) cmdState->bindGraphicsPipeline(cmd, depthOnlyPipeline);
-                else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, depthOnlyPipeline);
-                if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, depthOnlyPipelineLayout, 0, 1, &mainDescriptorSet, 0, nullptr);
-                else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, depthOnlyPipelineLayout, 0, 1, &mainDescriptorSet, 0, nullptr);
-                if (compactIndirectBuffer != VK_NULL_HANDLE && visibleCountBuffer != VK_NULL_HANDLE) {
-                    solidRenderer->getIndirectRenderer().drawPreparedWithBuffers(cmd, compactIndirectBuffer, visibleCountBuffer);
-                } else {
-                    solidRenderer->getIndirectRenderer().drawPrepared(cmd, 0);
-                }
+            VkCommandBuffer secondary = parallel ? passRecorder_.finish(face * 2) : VK_NULL_HANDLE;
+            if (secondary != VK_NULL_HANDLE) {
+                ri.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+                vkCmdBeginRendering(cmd, &ri);
+                vkCmdExecuteCommands(cmd, 1, &secondary);
+                // Bound state is undefined after executing secondaries,
+                // the heap included.
+                if (cmdState) cmdState->reset();
+                app->bindBindlessHeap(cmd);
+                faceRecordMs_[face] += passRecorder_.getPassRecordMs(face * 2);
+            } else {
+                auto t0 = std::chrono::steady_clock::now();
+                vkCmdBeginRendering(cmd, &ri);
+                recordDepthDraws(cmd, solidRenderer, mainDescriptorSet, heapSet, renderSolid,
+                                 compactIndirectBuffer, visibleCountBuffer, cmdState);
+                faceRecordMs_[face] += std::chrono::duration<float, std::milli>(
+                    std::chrono::steady_clock::now() - t0).count();
             }
 
             vkCmdEndRendering(cmd);
@@ -498,44 +726,21 @@ void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
             ri.pColorAttachments = &colorAtt;
             ri.pDepthAttachment = &depthAtt;
 
-            vkCmdBeginRendering(cmd, &ri);
-
-            VkViewport viewport{0.0f, 0.0f, (float)CUBE360_FACE_SIZE, (float)CUBE360_FACE_SIZE, 0.0f, 1.0f};
-            vkCmdSetViewport(cmd, 0, 1, &viewport);
-            VkRect2D scissor{{0, 0}, {CUBE360_FACE_SIZE, CUBE360_FACE_SIZE}};
-            vkCmdSetScissor(cmd, 0, 1, &scissor);
-
-            // Sky first (background, no depth)
-            if (skyRenderer) {
-                VkPipeline skyPipe = (skyMode == SkySettings::Mode::Grid) ? skyRenderer->getSkyFullscreenGridPipeline() : skyRenderer->getSkyFullscreenPipeline();
-                VkPipelineLayout skyLayout = (skyMode == SkySettings::Mode::Grid) ? skyRenderer->getSkyFullscreenGridPipelineLayout() : skyRenderer->getSkyFullscreenPipelineLayout();
-                if (skyPipe != VK_NULL_HANDLE && skyLayout != VK_NULL_HANDLE) {
-                    if (cmdState) cmdState->bindGraphicsPipeline(cmd, skyPipe);
-                    else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, skyPipe);
-                    if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, skyLayout, 0, 1, &mainDescriptorSet, 0, nullptr);
-                    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, skyLayout, 0, 1, &mainDescriptorSet, 0, nullptr);
-                    vkCmdDraw(cmd, 3, 1, 0, 0);
-                }
-            }
-
-            // Solid geometry with LESS_OR_EQUAL, depth write (redundant but harmless)
-            if (renderSolid && solidRenderer) {
-                VkPipeline gfxPipe = solidRenderer->getGraphicsPipeline();
-                VkPipelineLayout gfxLayout = solidRenderer->getGraphicsPipelineLayout();
-                if (gfxPipe != VK_NULL_HANDLE && gfxLayout != VK_NULL_HANDLE) {
-                    if (cmdState) cmdState->bindGraphicsPipeline(cmd, gfxPipe);
-                    else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, gfxPipe);
-                    // gfxPipe uses main.frag which references brush depth at set=1
-                    VkDescriptorSet bindSets[2] = { mainDescriptorSet, brushDepthSet };
-                    uint32_t bindCount = (brushDepthSet != VK_NULL_HANDLE) ? 2 : 1;
-                    if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, gfxLayout, 0, bindCount, bindSets, 0, nullptr);
-                    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, gfxLayout, 0, bindCount, bindSets, 0, nullptr);
-                    if (compactIndirectBuffer != VK_NULL_HANDLE && visibleCountBuffer != VK_NULL_HANDLE) {
-                        solidRenderer->getIndirectRenderer().drawPreparedWithBuffers(cmd, compactIndirectBuffer, visibleCountBuffer);
-                    } else {
-                        solidRenderer->getIndirectRenderer().drawPrepared(cmd, 0);
-                    }
-                }
+            VkCommandBuffer secondary = parallel ? passRecorder_.finish(face * 2 + 1) : VK_NULL_HANDLE;
+            if (secondary != VK_NULL_HANDLE) {
+                ri.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+                vkCmdBeginRendering(cmd, &ri);
+                vkCmdExecuteCommands(cmd, 1, &secondary);
+                if (cmdState) cmdState->reset();
+                app->bindBindlessHeap(cmd);
+                faceRecordMs_[face] += passRecorder_.getPassRecordMs(face * 2 + 1);
+            } else {
+                auto t0 = std::chrono::steady_clock::now();
+                vkCmdBeginRendering(cmd, &ri);
+                recordColorDraws(cmd, skyRenderer, skyMode, solidRenderer, mainDescriptorSet, heapSet,
+                                 renderSolid, compactIndirectBuffer, visibleCountBuffer, cmdState);
+                faceRecordMs_[face] += std::chrono::duration<float, std::milli>(
+                    std::chrono::steady_clock::now() - t0).count();
             }
 
             vkCmdEndRendering(cmd);
@@ -547,7 +752,7 @@ void Solid360Renderer::render(VulkanApp* app, VkCommandBuffer cmd,
         // so no layout transition is needed. Only when water rendering is enabled (settings.waterEnabled);
         // otherwise the cubemap reflects solids only and the preview will not show stale water.
         if (renderWater && waterRenderer && waterRenderer->getCubemapWaterPipeline() != VK_NULL_HANDLE) {
-            waterRenderer->bindCubemapWaterPipeline(cmd, mainDescriptorSet, frameIndex);
+            waterRenderer->bindCubemapWaterPipeline(cmd, mainDescriptorSet);
             waterRenderer->renderWaterIntoCubemap(cmd,
                 cube360FaceViews[face], cube360DepthViews[face],
                 CUBE360_FACE_SIZE,
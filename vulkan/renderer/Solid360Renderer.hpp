@@ -8,6 +8,7 @@
 #include "../ubo/UniformObject.hpp"
 #include <array>
 #include "CommandBufferState.hpp"
+#include "ParallelPassRecorder.hpp"
 
 class Solid360Renderer : public Renderer {
 public:
@@ -28,21 +29,49 @@ public:
                         SkyRenderer* skyRenderer, SkySettings::Mode skyMode,
                         SolidRenderer* solidRenderer,
                         VkDescriptorSet mainDescriptorSet,
-                        VkDescriptorSet brushDepthSet,
                         Buffer& uniformBuffer, const UniformObject& ubo,
                         bool renderSolid, bool renderWater,
-                        VkDescriptorSet computeDs = VK_NULL_HANDLE,
                         VkBuffer compactIndirectBuffer = VK_NULL_HANDLE,
+                        uint32_t compactIndirectSlot = BindlessHeap::INVALID_INDEX,
                         VkBuffer visibleCountBuffer = VK_NULL_HANDLE,
-                        VkDescriptorSet waterComputeDs = VK_NULL_HANDLE,
+                        uint32_t visibleCountSlot = BindlessHeap::INVALID_INDEX,
                         VkBuffer waterCompactIndirectBuffer = VK_NULL_HANDLE,
+                        uint32_t waterCompactIndirectSlot = BindlessHeap::INVALID_INDEX,
                         VkBuffer waterVisibleCountBuffer = VK_NULL_HANDLE,
+                        uint32_t waterVisibleCountSlot = BindlessHeap::INVALID_INDEX,
                         uint32_t frameIndex = 0);
 
+    // Face scheduling: each render() refreshes at most `faces` cubemap faces
+    // (the per-frame GPU budget), chosen round-robin or by staleness under
+    // camera motion. Faces never rendered, invalidated, or captured from too
+    // far away are always refreshed, even over the budget.
+    enum class FaceUpdateMode : int { RoundRobin = 0, CameraPriority = 1 };
+    void setFaceBudget(uint32_t faces, FaceUpdateMode mode);
+    // Re-render every face on the next render() (e.g. after a sky change)
+    void invalidateFaces();
+    // Re-render the faces whose view (from where they were captured) overlaps
+    // the box, e.g. a chunk whose mesh changed.
+    void invalidateRegion(const glm::vec3& boxMin, const glm::vec3& boxMax);
+    uint32_t getFacesRenderedLastFrame() const { return facesRenderedLastFrame; }
+
+    // When enabled (default), render() records each face's depth pre-pass and
+    // colour pass draws into secondary command buffers on worker threads and
+    // executes them in face order; UBO copies, culls, transitions and the
+    // water pass stay in the primary. Failed recordings fall back to inline.
+    void setParallelRecording(bool enabled) { parallelRecording_ = enabled; }
+    bool isParallelRecording() const { return parallelRecording_; }
+    // CPU time spent recording each face's draws in the last render()
+    // (0 for faces that were not refreshed).
+    float getFaceRecordMs(uint32_t face) const { return face < 6 ? faceRecordMs_[face] : 0.0f; }
+
     // Return the cubemap view for reflection sampling
     VkImageView getSolid360View() const { return cube360CubeView; }
     VkSampler getSolid360Sampler() const { return solid360Sampler; }
     VkImageView getDummyCubeView() const { return cube360DummyCubeView; }
+    // Bindless heap slots of the cube view and of the dummy cube that the
+    // face passes sample instead (the cube is their colour attachment).
+    uint32_t getSolid360Slot() const { return cube360CubeSlot; }
+    uint32_t getDummyCubeSlot() const { return cube360DummyCubeSlot; }
     VkImageView getCube360FaceView(uint32_t face) const { return (face < 6) ? cube360FaceViews[face] : VK_NULL_HANDLE; }
     VkImageView getCube360DepthView(uint32_t face) const { return (face < 6) ? cube360DepthViews[face] : VK_NULL_HANDLE; }
     VkImage getCube360DepthImage() const { return cube360DepthImage; }
@@ -71,12 +100,14 @@ private:
     VkDeviceMemory cube360ColorMemory = VK_NULL_HANDLE;
     std::array<VkImageView, 6> cube360FaceViews = {};
     VkImageView cube360CubeView = VK_NULL_HANDLE;
+    uint32_t cube360CubeSlot = UINT32_MAX;
     TrackedHandle<VkSampler> solid360Sampler;
 
     VkImage cube360DummyColorImage = VK_NULL_HANDLE;
     VmaAllocation cube360DummyColorAllocation = VK_NULL_HANDLE;
     VkDeviceMemory cube360DummyColorMemory = VK_NULL_HANDLE;
     VkImageView cube360DummyCubeView = VK_NULL_HANDLE;
+    uint32_t cube360DummyCubeSlot = UINT32_MAX;
 
     VkImage cube360DepthImage = VK_NULL_HANDLE;
     VmaAllocation cube360DepthAllocation = VK_NULL_HANDLE;
@@ -87,6 +118,36 @@ private:
     std::array<VkImageLayout, 6> cube360ColorLayouts = {};
     std::array<VkImageLayout, 6> cube360DepthLayouts = {};
 
+    // Dynamic state, binds and draws of a face's depth pre-pass and colour
+    // pass. Record into the primary (state = cmdState) or a worker-owned
+    // secondary (state = nullptr). Both bind the main set and the bindless
+    // heap: a secondary starts with no sets bound.
+    void recordDepthDraws(VkCommandBuffer cmd, SolidRenderer* solidRenderer,
+                          VkDescriptorSet mainDescriptorSet, VkDescriptorSet heapSet, bool renderSolid,
+                          VkBuffer compactIndirectBuffer, VkBuffer visibleCountBuffer,
+                          CommandBufferState* state);
+    void recordColorDraws(VkCommandBuffer cmd, SkyRenderer* skyRenderer, SkySettings::Mode skyMode,
+                          SolidRenderer* solidRenderer, VkDescriptorSet mainDescriptorSet,
+                          VkDescriptorSet heapSet, bool renderSolid,
+                          VkBuffer compactIndirectBuffer, VkBuffer visibleCountBuffer,
+                          CommandBufferState* state);
+
+    // Parallel face recording: slot face * 2 is the depth pre-pass, face * 2 + 1
+    // the colour pass
+    ParallelPassRecorder passRecorder_;
+    bool parallelRecording_ = true;
+    std::array<float, 6> faceRecordMs_ = {};
+
+    // Face scheduler state (see setFaceBudget)
+    uint32_t selectFaces(const glm::vec3& camPos, float farPlane, std::array<uint32_t, 6>& out);
+    uint32_t facesPerFrame = 6;
+    FaceUpdateMode faceUpdateMode = FaceUpdateMode::RoundRobin;
+    uint32_t faceCursor = 0;
+    uint32_t validFaceMask = 0;
+    uint32_t facesRenderedLastFrame = 0;
+    std::array<uint32_t, 6> faceAge = {};
+    std::array<glm::vec3, 6> faceCameraPos = {};
+
     // Equirectangular conversion removed: use cubemap directly for sampling
 
     // Persistently mapped staging buffers for UBO uploads via vkCmdCopyBuffer
@@ -197,12 +197,9 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
         VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT
     );
 
-    // Descriptor set layouts: main textures (set 0) then brush depth (set 1)
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    if (app->getDescriptorSetLayout() != VK_NULL_HANDLE) setLayouts.push_back(app->getDescriptorSetLayout());
-    // main.frag references brush depth textures at set=1 (separate from the main
-    // set so the shadow pass — which uses set=0 only — doesn't require them).
-    if (app->getBrushDepthDescriptorSetLayout() != VK_NULL_HANDLE) setLayouts.push_back(app->getBrushDepthDescriptorSetLayout());
+    // Scene layouts (main set, bindless heap): main.frag finds the textures and
+    // the brush depth through the UBO slots.
+    const std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
 
     // No per-mesh model push-constants are used anymore (models are identity in shaders).
     GraphicsPipelineConfig cfg{};
@@ -217,7 +214,7 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
         std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription { 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
         vk_layouts::defaultAttributes(),
         setLayouts,
-        nullptr,
+        app->getScenePushConstantRange(),
         cfg
     );
     graphicsPipeline = pipeline;
@@ -236,7 +233,7 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
         std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription { 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
         vk_layouts::defaultAttributes(),
         setLayouts,
-        nullptr,
+        app->getScenePushConstantRange(),
         depthCfg
     );
     depthPrePassPipeline = depthPipeline;
@@ -257,7 +254,7 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
             { vertexShader.info, tescShader.info, teseShader.info, depthFrag.info },
             std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
             vk_layouts::defaultAttributes(),
-            setLayouts, nullptr,
+            setLayouts, app->getScenePushConstantRange(),
             ddCfg
         );
         deferredDepthPipeline = dp;
@@ -274,20 +271,16 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
             { vertexShader.info, tescShader.info, teseShader.info, fragmentShader.info },
             std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
             vk_layouts::defaultAttributes(),
-            setLayouts, nullptr,
+            setLayouts, app->getScenePushConstantRange(),
             dcCfg
         );
         deferredColorPipeline = cp;
         deferredColorPipelineLayout = cl;
     }
     {
-        // Brush pipeline does not need set=1 (brush depth textures)
-        std::vector<VkDescriptorSetLayout> brushSetLayouts;
-        if (app->getDescriptorSetLayout() != VK_NULL_HANDLE) brushSetLayouts.push_back(app->getDescriptorSetLayout());
-
         // Brush color: alpha blending enabled (CONSTANT_ALPHA), no depth write
         // Uses main.frag compiled with -DBRUSH_PASS (no PAINT mode, no shadows,
-        // no set=1 brush depth declarations) via main_brush.frag.spv.
+        // no brush depth reads) via main_brush.frag.spv.
         ShaderStage brushFrag = ShaderStage(
             app->getOrCreateShaderModule("shaders/main_brush.frag.spv"),
             VK_SHADER_STAGE_FRAGMENT_BIT
@@ -301,7 +294,7 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
             { vertexShader.info, tescShader.info, teseShader.info, brushFrag.info },
             std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
             vk_layouts::defaultAttributes(),
-            brushSetLayouts, nullptr,
+            setLayouts, app->getScenePushConstantRange(),
             brushCfg
         );
         brushDeferredColorPipeline = bp;
@@ -311,8 +304,6 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
         // Brush overlay pipeline: opaque, no blending, same main_brush.frag shader.
         // Used when rendering the brush into scene_color to prevent background
         // shadows from showing through CONSTANT_ALPHA blending.
-        std::vector<VkDescriptorSetLayout> brushSetLayouts2;
-        if (app->getDescriptorSetLayout() != VK_NULL_HANDLE) brushSetLayouts2.push_back(app->getDescriptorSetLayout());
         ShaderStage brushOpaqueFrag = ShaderStage(
             app->getOrCreateShaderModule("shaders/main_brush.frag.spv"),
             VK_SHADER_STAGE_FRAGMENT_BIT
@@ -326,7 +317,7 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
             { vertexShader.info, tescShader.info, teseShader.info, brushOpaqueFrag.info },
             std::vector<VkVertexInputBindingDescription>{ VkVertexInputBindingDescription{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX } },
             vk_layouts::defaultAttributes(),
-            brushSetLayouts2, nullptr,
+            setLayouts, app->getScenePushConstantRange(),
             brushOverlayCfg
         );
         brushOverlayPipeline = bp;
@@ -342,7 +333,7 @@ void SolidRenderer::createPipelines(VulkanApp* app) {
     vertexShader.info.module = VK_NULL_HANDLE;
 }
 
-void SolidRenderer::render(VkCommandBuffer &commandBuffer, VulkanApp* appArg, VkDescriptorSet perTextureDescriptorSet, VkDescriptorSet brushDepthSet) {
+void SolidRenderer::render(VkCommandBuffer &commandBuffer, VulkanApp* appArg, VkDescriptorSet perTextureDescriptorSet) {
     if (!appArg) {
         std::cerr << "[SolidRenderer::draw] appArg is nullptr, skipping." << std::endl;
         return;
@@ -356,17 +347,11 @@ void SolidRenderer::render(VkCommandBuffer &commandBuffer, VulkanApp* appArg, Vk
     if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, graphicsPipeline);
     else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
 
-    // Bind descriptor set 0: main UBO/samplers (perTextureDescriptorSet)
-    // and set 1: brush depth textures (brushDepthSet) for PAINT mode.
+    // Bind descriptor set 0: main UBO (perTextureDescriptorSet). The bindless
+    // heap stays bound at set 1.
     if (perTextureDescriptorSet != VK_NULL_HANDLE) {
-        VkDescriptorSet bindSets[2] = { perTextureDescriptorSet, VK_NULL_HANDLE };
-        uint32_t bindCount = 1;
-        if (brushDepthSet != VK_NULL_HANDLE) {
-            bindSets[1] = brushDepthSet;
-            bindCount = 2;
-        }
-        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, usedLayout, 0, bindCount, bindSets, 0, nullptr);
-        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, usedLayout, 0, bindCount, bindSets, 0, nullptr);
+        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, usedLayout, 0, 1, &perTextureDescriptorSet, 0, nullptr);
+        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, usedLayout, 0, 1, &perTextureDescriptorSet, 0, nullptr);
     } else {
         std::cerr << "[SolidRenderer::draw] ERROR: perTextureDescriptorSet is NULL!" << std::endl;
     }
@@ -375,7 +360,7 @@ void SolidRenderer::render(VkCommandBuffer &commandBuffer, VulkanApp* appArg, Vk
     indirectRenderer.drawPrepared(commandBuffer);
 }
 
-void SolidRenderer::renderDepthPrepass(VkCommandBuffer &commandBuffer, VulkanApp* appArg, VkDescriptorSet perTextureDescriptorSet, VkDescriptorSet brushDepthSet) {
+void SolidRenderer::renderDepthPrepass(VkCommandBuffer &commandBuffer, VulkanApp* appArg, VkDescriptorSet perTextureDescriptorSet) {
     if (!appArg) {
         std::cerr << "[SolidRenderer::renderDepthPrepass] appArg is nullptr, skipping." << std::endl;
         return;
@@ -388,12 +373,10 @@ void SolidRenderer::renderDepthPrepass(VkCommandBuffer &commandBuffer, VulkanApp
     if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, depthPrePassPipeline);
     else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, depthPrePassPipeline);
 
-    // Bind descriptor sets (set 0: main, set 1: brush depth)
+    // Bind descriptor set 0 (main); the heap stays bound at set 1
     if (perTextureDescriptorSet != VK_NULL_HANDLE) {
-        VkDescriptorSet bindSets[2] = { perTextureDescriptorSet, brushDepthSet };
-        uint32_t bindCount = (brushDepthSet != VK_NULL_HANDLE) ? 2 : 1;
-        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, depthPrePassPipelineLayout, 0, bindCount, bindSets, 0, nullptr);
-        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, depthPrePassPipelineLayout, 0, bindCount, bindSets, 0, nullptr);
+        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, depthPrePassPipelineLayout, 0, 1, &perTextureDescriptorSet, 0, nullptr);
+        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, depthPrePassPipelineLayout, 0, 1, &perTextureDescriptorSet, 0, nullptr);
     }
 
     // Draw all meshes using GPU-culled indirect commands (depth-only)
@@ -411,15 +394,13 @@ void SolidRenderer::drawDepth(VkCommandBuffer &commandBuffer, VulkanApp* appArg,
     indirectRenderer.drawPrepared(commandBuffer);
 }
 
-void SolidRenderer::drawColor(VkCommandBuffer &commandBuffer, VulkanApp* appArg, VkDescriptorSet descSet, VkDescriptorSet brushDepthSet) {
+void SolidRenderer::drawColor(VkCommandBuffer &commandBuffer, VulkanApp* appArg, VkDescriptorSet descSet) {
     if (!appArg || deferredColorPipeline == VK_NULL_HANDLE) return;
     if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, deferredColorPipeline);
     else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, deferredColorPipeline);
     if (descSet != VK_NULL_HANDLE) {
-        VkDescriptorSet bindSets[2] = { descSet, brushDepthSet };
-        uint32_t bindCount = (brushDepthSet != VK_NULL_HANDLE) ? 2 : 1;
-        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, deferredColorPipelineLayout, 0, bindCount, bindSets, 0, nullptr);
-        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, deferredColorPipelineLayout, 0, bindCount, bindSets, 0, nullptr);
+        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, deferredColorPipelineLayout, 0, 1, &descSet, 0, nullptr);
+        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, deferredColorPipelineLayout, 0, 1, &descSet, 0, nullptr);
     }
     indirectRenderer.drawPrepared(commandBuffer);
 }
@@ -435,15 +416,13 @@ void SolidRenderer::drawDepthExternal(VkCommandBuffer &cmd, VkDescriptorSet desc
     indirect.drawPrepared(cmd);
 }
 
-void SolidRenderer::drawColorExternal(VkCommandBuffer &cmd, VkDescriptorSet descSet, IndirectRenderer& indirect, VkDescriptorSet brushDepthSet) {
+void SolidRenderer::drawColorExternal(VkCommandBuffer &cmd, VkDescriptorSet descSet, IndirectRenderer& indirect) {
     if (deferredColorPipeline == VK_NULL_HANDLE) return;
     if (cmdState) cmdState->bindGraphicsPipeline(cmd, deferredColorPipeline);
     else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, deferredColorPipeline);
     if (descSet != VK_NULL_HANDLE) {
-        VkDescriptorSet bindSets[2] = { descSet, brushDepthSet };
-        uint32_t bindCount = (brushDepthSet != VK_NULL_HANDLE) ? 2 : 1;
-        if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, deferredColorPipelineLayout, 0, bindCount, bindSets, 0, nullptr);
-        else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, deferredColorPipelineLayout, 0, bindCount, bindSets, 0, nullptr);
+        if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd, deferredColorPipelineLayout, 0, 1, &descSet, 0, nullptr);
+        else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, deferredColorPipelineLayout, 0, 1, &descSet, 0, nullptr);
     }
     indirect.drawPrepared(cmd);
 }
@@ -498,9 +477,8 @@ void SolidRenderer::cleanup(VulkanApp* app) {
 }
 
 void SolidRenderer::createWireframe(VulkanApp* app) {
-    std::vector<VkDescriptorSetLayout> solidSetLayouts = { app->getDescriptorSetLayout() };
     wireframe.createPipeline(app, {app->getSwapchainImageFormat()},
-        solidSetLayouts,
+        app->getSceneSetLayouts(),
         "shaders/main.vert.spv", "shaders/wireframe.frag.spv",
         "shaders/main.tesc.spv", "shaders/main.tese.spv",
         "solid wireframe");
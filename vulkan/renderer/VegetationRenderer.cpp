@@ -13,7 +13,11 @@
 #include <numeric>
 #include <algorithm>
 #include <cmath>
-#include <random>
+#include <limits>
+#include <memory>
+#include <cstdlib>
+#include <iostream>
+#include "../../math/CounterRng.hpp"
 #include <utility>
 #include "../includes/locations.hpp"
 #include "../includes/vertex_layouts.hpp"
@@ -31,17 +35,13 @@ void VegetationRenderer::init() {
 
 void VegetationRenderer::cleanup(VulkanApp* app) {
     (void)app;
-    std::vector<NodeID> idsToDestroy;
-    idsToDestroy.reserve(chunkBuffers.size());
-    for (const auto& [id, _] : chunkBuffers) idsToDestroy.push_back(id);
-    for (NodeID id : idsToDestroy) destroyInstanceBuffer(id);
-    chunkBuffers.clear();
-    chunkInstanceCounts.clear();
-    vegDescriptorVersion = 0;
-    if (vegetationTextureArrayManager && vegTextureListenerId != -1) {
-        vegetationTextureArrayManager->removeAllocationListener(vegTextureListenerId);
-        vegTextureListenerId = -1;
-    }
+    chunkTable.clear();
+    chunkTableIds.clear();
+    chunkTableIndex.clear();
+    chunkUploadSerial.clear();
+    instanceTotal = 0;
+    releaseBillboardSlots(appPtr);
+    releaseImpostorSlots(appPtr);
     billboardVBO.vertexBuffer.buffer = VK_NULL_HANDLE;
     billboardVBO.vertexBuffer.memory = VK_NULL_HANDLE;
     billboardVBO.indexBuffer.buffer = VK_NULL_HANDLE;
@@ -53,6 +53,8 @@ void VegetationRenderer::cleanup(VulkanApp* app) {
     impostorVBO.indexBuffer.memory = VK_NULL_HANDLE;
     impostorVBO.indexCount = 0;
     if (appPtr && windParamsBuffer.buffer != VK_NULL_HANDLE) {
+        appPtr->getBindlessHeap().releaseBuffer(windParamsSlot);
+        windParamsSlot = BindlessHeap::INVALID_INDEX;
         appPtr->destroyBuffer(windParamsBuffer);
         windParamsBuffer = {};
         windParamsMapped = nullptr;
@@ -63,11 +65,11 @@ void VegetationRenderer::cleanup(VulkanApp* app) {
 
 void VegetationRenderer::destroyCulling() {
     if (!appPtr) return;
-    VkDevice device = appPtr->getDevice();
-    if (concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE) {
-        appPtr->destroyBuffer(concatenatedInstanceBuffer);
-        concatenatedInstanceBuffer = {};
+    if (instanceArenaBuffer.buffer != VK_NULL_HANDLE) {
+        appPtr->destroyBuffer(instanceArenaBuffer);
+        instanceArenaBuffer = {};
     }
+    instanceArena.reset();
     for (uint32_t f = 0; f < VEG_CULL_FRAMES; ++f) {
         if (compactedCmdBuffers[f].buffer != VK_NULL_HANDLE) {
             compactedCmdMapped[f] = nullptr;
@@ -80,57 +82,13 @@ void VegetationRenderer::destroyCulling() {
             visibleCountBuffers[f] = {};
         }
     }
-    if (consolidationFence != VK_NULL_HANDLE) {
-        VulkanApp::waitFence(device, consolidationFence);
-    }
-    consolidationPending = false;
     vegNumChunks = 0;
-    vegConsolidationDirty = true;
 }
 
-void VegetationRenderer::consolidateChunks(VulkanApp* app) {
-    if (chunkBuffers.empty()) return;
+void VegetationRenderer::ensureCullBuffers(VulkanApp* app) {
     if (!app) return;
     auto device = app->getDevice();
-
-    // ── Phase 1: Check if previous consolidation is still pending ──
-    //    The deferred callback clears consolidationPending when the fence signals.
-    if (consolidationPending) {
-        vegConsolidationDirty = true;
-        return;
-    }
-
-    // ── Phase 2: Start a new consolidation ──
-
-    size_t totalInstances = 0;
-    for (const auto& kv : chunkInstanceCounts)
-        totalInstances += kv.second;
-    if (totalInstances == 0) return;
-
-    uint32_t numChunks = static_cast<uint32_t>(chunkBuffers.size());
-
-    VkDeviceSize concatSize = totalInstances * sizeof(glm::vec4);
-    {
-        bool needsCreate = concatenatedInstanceBuffer.buffer == VK_NULL_HANDLE;
-        if (!needsCreate) {
-            VkMemoryRequirements reqs;
-            vkGetBufferMemoryRequirements(device, concatenatedInstanceBuffer.buffer, &reqs);
-            if (reqs.size < concatSize) needsCreate = true;
-        }
-        if (needsCreate) {
-            Buffer old = concatenatedInstanceBuffer;
-            concatenatedInstanceBuffer = {};
-            concatenatedInstanceBuffer = app->createBuffer(concatSize,
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-            if (old.buffer != VK_NULL_HANDLE) {
-                app->deferDestroyUntilAllPending([app, old]() {
-                    if (old.buffer != VK_NULL_HANDLE)
-                        app->resources.removeBufferVma(old.buffer, old.allocation);
-                });
-            }
-        }
-    }
+    uint32_t numChunks = static_cast<uint32_t>(chunkTable.size());
 
     VkDeviceSize compactedSize = std::max(256u, numChunks) * sizeof(VkDrawIndexedIndirectCommand);
     for (uint32_t f = 0; f < VEG_CULL_FRAMES; ++f) {
@@ -163,67 +121,15 @@ void VegetationRenderer::consolidateChunks(VulkanApp* app) {
             *visibleCountMapped[f] = 0;
         }
     }
-
-    // Count chunks with valid geometry (GPU metadata buffer removed — the CPU
-    // culling paths write draw commands directly).
-    uint32_t chunkIdx = 0;
-    for (const auto& [chunkId, buf] : chunkBuffers) {
-        (void)chunkId;
-        if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) continue;
-        chunkIdx++;
-    }
-    vegNumChunks = chunkIdx;
-
-    if (vegNumChunks == 0) return;
-
-    // Copy per-chunk instance data into the concatenated buffer (GPU→GPU)
-    if (concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
-        app->runSingleTimeCommands([&](VkCommandBuffer cmd) {
-            // WRITE-AFTER-READ/WRITE guard: the concatenated instance buffer is
-            // read as vertex attributes by the previous frame's vegetation
-            // draws, and its per-chunk sources were written by earlier transfer
-            // submits. ALL_COMMANDS srcStage covers the full draw-pipeline span
-            // sync validation attributes vertex-attribute reads to
-            // (SYNC-HAZARD-WRITE-AFTER-READ reported on GPU-assisted runs).
-            VkMemoryBarrier2 mb{ VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
-            mb.srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-            mb.srcAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT |
-                               VK_ACCESS_2_TRANSFER_READ_BIT |
-                               VK_ACCESS_2_TRANSFER_WRITE_BIT;
-            mb.dstStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
-            mb.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-            VkDependencyInfo dep{ VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-            dep.memoryBarrierCount = 1;
-            dep.pMemoryBarriers    = &mb;
-            vkCmdPipelineBarrier2(cmd, &dep);
-
-            uint32_t off = 0;
-            for (const auto& [cid, buf] : chunkBuffers) {
-                (void)cid;
-                if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) continue;
-                VkBufferCopy region{};
-                region.srcOffset = 0;
-                region.dstOffset = off * sizeof(glm::vec4);
-                region.size = buf.count * sizeof(glm::vec4);
-                vkCmdCopyBuffer(cmd, buf.buffer, concatenatedInstanceBuffer.buffer, 1, &region);
-                off += buf.count;
-            }
-        });
-    }
-
-    vegConsolidationDirty = false;
 }
 
 void VegetationRenderer::prepareCull(VkCommandBuffer cmd, const glm::mat4& viewProj) {
     vegCullCurrentSlot = vegCullFrameIndex % VEG_CULL_FRAMES;
     vegCullFrameIndex++;
     uint32_t f = vegCullCurrentSlot;
-    // Consolidate if chunks have changed since last consolidation
-    if (vegConsolidationDirty && !chunkBuffers.empty()) {
-        consolidateChunks(appPtr);
-        if (vegConsolidationDirty) return; // fence still in flight, skip cull
-    }
-    if (vegNumChunks == 0) return;
+    vegNumChunks = static_cast<uint32_t>(chunkTable.size());
+    if (vegNumChunks == 0 || !appPtr) return;
+    ensureCullBuffers(appPtr);
     if (compactedCmdBuffers[f].buffer == VK_NULL_HANDLE || visibleCountBuffers[f].buffer == VK_NULL_HANDLE) return;
 
     // Upload every chunk as a visible draw command directly into the
@@ -232,20 +138,18 @@ void VegetationRenderer::prepareCull(VkCommandBuffer cmd, const glm::mat4& viewP
     // Written in place, bounded by vegNumChunks (<= buffer capacity): a
     // previous fixed-size stack array overflowed once vegetation exceeded 256
     // chunks, corrupting the caller's stack frame (GPU hang on RADV / 680M).
+    // Each chunk's instances sit at its arena span, so the command is just
+    // the chunk table entry.
     uint32_t count = 0;
     {
         VkDrawIndexedIndirectCommand* dst =
             static_cast<VkDrawIndexedIndirectCommand*>(compactedCmdMapped[f]);
-        uint32_t instanceOff = 0;
-        for (auto& [cid, buf] : chunkBuffers) {
-            (void)cid;
-            if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) continue;
+        for (const ChunkInstances& c : chunkTable) {
             dst[count].indexCount    = 36;
-            dst[count].instanceCount = buf.count;
+            dst[count].instanceCount = c.count;
             dst[count].firstIndex    = 0;
             dst[count].vertexOffset  = 0;
-            dst[count].firstInstance = instanceOff;
-            instanceOff += buf.count;
+            dst[count].firstInstance = c.firstInstance;
             count++;
             if (count >= vegNumChunks) break;
         }
@@ -419,27 +323,19 @@ void VegetationRenderer::writeVegChunkInfo() {
     if (!vegChunkInfoMapped) return;
     glm::vec4* dst = static_cast<glm::vec4*>(vegChunkInfoMapped);
     uint32_t idx = 0;
-    for (const auto& [chunkId, buf] : chunkBuffers) {
-        (void)chunkId;
-        if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) continue;
+    for (const ChunkInstances& c : chunkTable) {
+        if (idx >= vegNumChunks) break;
         if (idx >= vegChunkInfoCapacity) {
             // Unreachable (prepareCullCascades grows the table first) — guard
             // against future call sites writing past the buffer.
             std::cerr << "[veg] FATAL: writeVegChunkInfo overflow cap=" << vegChunkInfoCapacity << "\n";
             break;
         }
-        dst[idx * 3 + 0] = glm::vec4(buf.aabbMin, 0.0f);
-        dst[idx * 3 + 1] = glm::vec4(buf.aabbMax, 0.0f);
-        dst[idx * 3 + 2] = glm::vec4(static_cast<float>(buf.count), 0.0f, 0.0f, 0.0f);
+        dst[idx * 3 + 0] = glm::vec4(c.aabbMin, 0.0f);
+        dst[idx * 3 + 1] = glm::vec4(c.aabbMax, 0.0f);
+        dst[idx * 3 + 2] = glm::vec4(static_cast<float>(c.count), static_cast<float>(c.firstInstance), 0.0f, 0.0f);
         ++idx;
     }
-    // firstInstance per chunk = cumulative instance count (matches the
-    // concatenated instance buffer order built in consolidateChunks).
-    uint32_t instOff = 0;
-    for (uint32_t i = 0; i < idx; ++i) {
-        dst[i * 3 + 2].y = static_cast<float>(instOff);
-        instOff += static_cast<uint32_t>(dst[i * 3 + 2].x);
-    }
 }
 
 void VegetationRenderer::prepareCullCascades(VkCommandBuffer cmd,
@@ -451,11 +347,7 @@ void VegetationRenderer::prepareCullCascades(VkCommandBuffer cmd,
     vegCullFrameIndex++;
     uint32_t f = vegCullCurrentSlot;
 
-    if (vegConsolidationDirty && !chunkBuffers.empty()) {
-        consolidateChunks(appPtr);
-        if (vegConsolidationDirty) return;
-    }
-
+    vegNumChunks = static_cast<uint32_t>(chunkTable.size());
     if (vegNumChunks == 0) return;
 
     if (vegNumChunks > vegCascadeCompactCapacity) {
@@ -679,36 +571,49 @@ void VegetationRenderer::drawShadowCascade(VulkanApp* app, VkCommandBuffer& comm
                                             VkDescriptorSet shadowDescriptorSet,
                                             const glm::vec3& cameraPos,
                                             uint32_t cascadeIndex) {
-    if (cascadeIndex >= 3) return;
-    if (!app || vegetationShadowPipeline == VK_NULL_HANDLE) return;
-    if (chunkBuffers.empty()) return;
-    if (!ensureVegDescriptorSet(app)) return;
-    if (shadowDescriptorSet == VK_NULL_HANDLE || vegDescriptorSet == VK_NULL_HANDLE) return;
+    if (!prepareShadowCascades(app, cameraPos)) return;
+    recordShadowCascade(commandBuffer, shadowDescriptorSet, cascadeIndex, cmdState);
+}
 
+bool VegetationRenderer::prepareShadowCascades(VulkanApp* app, const glm::vec3& cameraPos) {
+    if (!app || vegetationShadowPipeline == VK_NULL_HANDLE) return false;
+    if (chunkTable.empty()) return false;
+    if (!ensureBillboardSlots(app)) return false;
+    updateWindParamsUBO(cameraPos);
+    return true;
+}
+
+uint32_t VegetationRenderer::recordShadowCascade(VkCommandBuffer commandBuffer,
+                                             VkDescriptorSet shadowDescriptorSet,
+                                             uint32_t cascadeIndex,
+                                             CommandBufferState* state) {
+    if (cascadeIndex >= 3) return 0;
+    if (vegetationShadowPipeline == VK_NULL_HANDLE || chunkTable.empty()) return 0;
+    if (shadowDescriptorSet == VK_NULL_HANDLE || !appPtr || albedoSlot == BindlessHeap::INVALID_INDEX) return 0;
+    if (windParamsSlot == BindlessHeap::INVALID_INDEX) return 0;
+
+    uint32_t draws = 0;
     uint32_t f = vegCullCurrentSlot;
-    if (vegCascadeCullFrames[f].compactBuffers[cascadeIndex].buffer == VK_NULL_HANDLE) return;
+    if (vegCascadeCullFrames[f].compactBuffers[cascadeIndex].buffer == VK_NULL_HANDLE) return 0;
 
-    if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, vegetationShadowPipeline);
+    if (state) state->bindGraphicsPipeline(commandBuffer, vegetationShadowPipeline);
     else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vegetationShadowPipeline);
 
-    updateWindParamsUBO(cameraPos);
-    VkDescriptorSet sets[3] = { shadowDescriptorSet, vegDescriptorSet, windParamsDescSet };
-    if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, shadowPipelineLayout, 0, 3, sets, 0, nullptr);
-    else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipelineLayout, 0, 3, sets, 0, nullptr);
+    // The shadow pass keeps the bindless heap bound at set 1 (ShadowRenderer);
+    // only the cascade's UBO set is ours to bind.
+    if (state) state->bindGraphicsDescriptorSets(commandBuffer, shadowPipelineLayout, 0, 1, &shadowDescriptorSet, 0, nullptr);
+    else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipelineLayout, 0, 1, &shadowDescriptorSet, 0, nullptr);
 
-    WindPushConstants pc{};
-    pc.billboardScale = billboardScale;
+    WindPushConstants pc = buildWindPushConstants(glm::vec3(0.0f));
     pc.windEnabled = -1.0f;
-    pc.windTime = windTimeSeconds;
-    pc.impostorDistance = impostorDistance;
 
     vkCmdPushConstants(commandBuffer, shadowPipelineLayout,
-                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       VK_SHADER_STAGE_ALL_GRAPHICS,
                        0, sizeof(WindPushConstants), &pc);
 
     vkCmdBindIndexBuffer(commandBuffer, billboardVBO.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
-    if (!vegConsolidationDirty && concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
-        VkBuffer vbs[2] = { billboardVBO.vertexBuffer.buffer, concatenatedInstanceBuffer.buffer };
+    if (instanceArenaBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
+        VkBuffer vbs[2] = { billboardVBO.vertexBuffer.buffer, instanceArenaBuffer.buffer };
         VkDeviceSize offsets[2] = { 0, 0 };
         vkCmdBindVertexBuffers(commandBuffer, 0, 2, vbs, offsets);
         if (cmdDrawIndexedIndirectCount) {
@@ -717,6 +622,7 @@ void VegetationRenderer::drawShadowCascade(VulkanApp* app, VkCommandBuffer& comm
                 vegCascadeCullFrames[f].compactBuffers[cascadeIndex].buffer, 0,
                 vegCascadeCullFrames[f].countBuffers[cascadeIndex].buffer, 0,
                 vegMaxDraws, sizeof(VkDrawIndexedIndirectCommand));
+            ++draws;
         }
     }
 
@@ -728,25 +634,22 @@ void VegetationRenderer::drawShadowCascade(VulkanApp* app, VkCommandBuffer& comm
     VkPipelineLayout impostorShadowLayout = (impostorShadowPipelineLayout != VK_NULL_HANDLE)
                                           ? impostorShadowPipelineLayout : impostorDepthPipelineLayout;
     if (impostorShadowPipe != VK_NULL_HANDLE &&
-        impostorDepthDescSet != VK_NULL_HANDLE &&
+        impostorDepthSlot != BindlessHeap::INVALID_INDEX &&
         impostorDistance > 0.0f && impostorVBO.vertexBuffer.buffer != VK_NULL_HANDLE &&
-        !chunkBuffers.empty()) {
-        if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, impostorShadowPipe);
+        !chunkTable.empty()) {
+        // Same scene layout as the billboard pipeline: set 0 and the heap stay bound.
+        if (state) state->bindGraphicsPipeline(commandBuffer, impostorShadowPipe);
         else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorShadowPipe);
 
-        VkDescriptorSet depthSets[3] = { shadowDescriptorSet, impostorDepthDescSet, windParamsDescSet };
-        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, impostorShadowLayout, 0, 3, depthSets, 0, nullptr);
-        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorShadowLayout, 0, 3, depthSets, 0, nullptr);
-
         vkCmdPushConstants(commandBuffer, impostorShadowLayout,
-                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                           VK_SHADER_STAGE_ALL_GRAPHICS,
                            0, sizeof(WindPushConstants), &pc);
 
         vkCmdBindIndexBuffer(commandBuffer, impostorVBO.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
         VkBuffer impVbs[2] = { impostorVBO.vertexBuffer.buffer, VK_NULL_HANDLE };
         VkDeviceSize impOffsets[2] = { 0, 0 };
-        if (!vegConsolidationDirty && concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
-            impVbs[1] = concatenatedInstanceBuffer.buffer;
+        if (instanceArenaBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
+            impVbs[1] = instanceArenaBuffer.buffer;
             vkCmdBindVertexBuffers(commandBuffer, 0, 2, impVbs, impOffsets);
 
             // Impostor draw commands (indexCount=6) are written by the GPU
@@ -761,26 +664,12 @@ void VegetationRenderer::drawShadowCascade(VulkanApp* app, VkCommandBuffer& comm
                         impCompactBuf.buffer, 0,
                         impCountBuf.buffer, 0,
                         vegMaxImpostorDraws, sizeof(VkDrawIndexedIndirectCommand));
+                    ++draws;
                 }
             }
         }
     }
-}
-
-void VegetationRenderer::setTextureArrayManager(TextureArrayManager* mgr, VulkanApp* app) {
-    // Unregister old listener
-    if (vegetationTextureArrayManager && vegTextureListenerId != -1) {
-        vegetationTextureArrayManager->removeAllocationListener(vegTextureListenerId);
-        vegTextureListenerId = -1;
-    }
-    vegetationTextureArrayManager = mgr;
-    if (!vegetationTextureArrayManager) return;
-    // Try to allocate descriptor set immediately if possible
-    ensureVegDescriptorSet(app);
-    // Register listener to react to future reallocations
-    vegTextureListenerId = vegetationTextureArrayManager->addAllocationListener([this, app]() {
-        this->onTextureArraysReallocated(app);
-    });
+    return draws;
 }
 
 void VegetationRenderer::setBillboardArrayTextures(VkImageView albedoView, VkImageView normalView, VkImageView opacityView, VkSampler sampler, VulkanApp* app) {
@@ -789,84 +678,59 @@ void VegetationRenderer::setBillboardArrayTextures(VkImageView albedoView, VkIma
     billboardOpacityView  = opacityView;
     billboardArraySampler = sampler;
 
-    if (!app || descriptorSetLayout == VK_NULL_HANDLE) return;
-
-    if (vegDescriptorSet != VK_NULL_HANDLE) {
-        // Defer destruction of the old descriptor set. The current frame's
-        // command buffer may still reference it.  deferDestroyUntilAllPending
-        // waits for all in-flight rendering to complete before freeing.
-        VkDescriptorSet ds = vegDescriptorSet;
-        VkDevice dev = app->getDevice();
-        VkDescriptorPool pool = app->getDescriptorPool();
-        app->deferDestroyUntilAllPending([dev, pool, ds, app]() {
-            if (app->resources.removeDescriptorSet(ds))
-                vkFreeDescriptorSets(dev, pool, 1, &ds);
-        });
-        vegDescriptorSet = VK_NULL_HANDLE;
-        vegDescriptorVersion = 0;
-    }
-
-    ensureVegDescriptorSet(app);
-}
-
-void VegetationRenderer::onTextureArraysReallocated(VulkanApp* app) {
-    std::cerr << "[VEGETATION] onTextureArraysReallocated: invalidating vegDescriptorSet" << std::endl;
     if (!app) return;
-    if (vegDescriptorSet != VK_NULL_HANDLE) {
-        VkDescriptorSet ds = vegDescriptorSet;
-        VkDevice device = app->getDevice();
-        VkDescriptorPool pool = app->getDescriptorPool();
-        // Defer the free until all pending command buffers AND in-flight frame
-        // fences signal — the descriptor set may still be referenced by a
-        // previously-submitted frame command buffer. The remove happens inside
-        // the deferred lambda so that, if this handle value is recycled for a
-        // newer live set before the lambda runs, the second remove returns
-        // false and we avoid a double free of an already-freed set.
-        app->deferDestroyUntilAllPending([device, pool, ds, app]() {
-            if (app->resources.removeDescriptorSet(ds))
-                vkFreeDescriptorSets(device, pool, 1, &ds);
-        });
-        vegDescriptorSet = VK_NULL_HANDLE;
-        vegDescriptorVersion = 0;
-    }
-    if (ensureVegDescriptorSet(app)) {
-        std::cerr << "[VEGETATION] onTextureArraysReallocated: recreated vegDescriptorSet=" << (void*)vegDescriptorSet << std::endl;
-    } else {
-        std::cerr << "[VEGETATION] onTextureArraysReallocated: descriptor still not ready" << std::endl;
-    }
+
+    // New views get new heap slots; frames already recorded keep reading the
+    // old slots until they retire.
+    releaseBillboardSlots(app);
+    ensureBillboardSlots(app);
 }
 
-bool VegetationRenderer::ensureVegDescriptorSet(VulkanApp* app) {
+bool VegetationRenderer::ensureBillboardSlots(VulkanApp* app) {
     if (!app) return false;
-    if (descriptorSetLayout == VK_NULL_HANDLE) {
-        std::cerr << "[VEGETATION] ensureVegDescriptorSet: descriptorSetLayout not created yet, deferring allocation" << std::endl;
-        return false;
-    }
-
     if (billboardAlbedoView  == VK_NULL_HANDLE ||
         billboardNormalView  == VK_NULL_HANDLE ||
         billboardOpacityView == VK_NULL_HANDLE ||
         billboardArraySampler == VK_NULL_HANDLE) return false;
 
-    if (vegDescriptorSet == VK_NULL_HANDLE) {
-        vegDescriptorSet = app->createDescriptorSet(descriptorSetLayout);
-
-        DescriptorWriter writer(app->getDevice());
-        writer.writeImage(vegDescriptorSet, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                          billboardArraySampler, billboardAlbedoView,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        writer.writeImage(vegDescriptorSet, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                          billboardArraySampler, billboardNormalView,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        writer.writeImage(vegDescriptorSet, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                          billboardArraySampler, billboardOpacityView,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        writer.flush();
-        vegDescriptorVersion = 1;
-        app->registerDescriptorSet(vegDescriptorSet);
-        std::cerr << "[VEGETATION] Allocated vegDescriptorSet=" << (void*)vegDescriptorSet << " (3 sampler2DArray)" << std::endl;
-    }
-    return vegDescriptorSet != VK_NULL_HANDLE;
+    if (albedoSlot == BindlessHeap::INVALID_INDEX) {
+        BindlessHeap& heap = app->getBindlessHeap();
+        albedoSlot  = heap.registerImage(billboardAlbedoView, billboardArraySampler);
+        normalSlot  = heap.registerImage(billboardNormalView, billboardArraySampler);
+        opacitySlot = heap.registerImage(billboardOpacityView, billboardArraySampler);
+        if (albedoSlot == BindlessHeap::INVALID_INDEX || normalSlot == BindlessHeap::INVALID_INDEX ||
+            opacitySlot == BindlessHeap::INVALID_INDEX) {
+            releaseBillboardSlots(app);
+            return false;
+        }
+    }
+    return true;
+}
+
+void VegetationRenderer::releaseBillboardSlots(VulkanApp* app) {
+    if (app) {
+        BindlessHeap& heap = app->getBindlessHeap();
+        heap.releaseImage(albedoSlot);
+        heap.releaseImage(normalSlot);
+        heap.releaseImage(opacitySlot);
+    }
+    albedoSlot  = BindlessHeap::INVALID_INDEX;
+    normalSlot  = BindlessHeap::INVALID_INDEX;
+    opacitySlot = BindlessHeap::INVALID_INDEX;
+}
+
+void VegetationRenderer::releaseImpostorSlots(VulkanApp* app) {
+    if (app) {
+        BindlessHeap& heap = app->getBindlessHeap();
+        heap.releaseImage(impostorAlbedoSlot);
+        heap.releaseImage(impostorNormalSlot);
+        heap.releaseImage(impostorDepthSlot);
+        heap.releaseBuffer(captureInvVPSlot);
+    }
+    impostorAlbedoSlot = BindlessHeap::INVALID_INDEX;
+    impostorNormalSlot = BindlessHeap::INVALID_INDEX;
+    impostorDepthSlot  = BindlessHeap::INVALID_INDEX;
+    captureInvVPSlot   = BindlessHeap::INVALID_INDEX;
 }
 
 
@@ -875,71 +739,98 @@ void VegetationRenderer::init(VulkanApp* app) {
     this->appPtr = app;
     VkDevice device = app->getDevice();
 
-    DescriptorAllocator descAlloc{device, app};
-
-    VkDescriptorSetLayoutBinding texBindings[3]{};
-    for (uint32_t i = 0; i < 3; ++i) {
-        texBindings[i].binding         = i;
-        texBindings[i].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        texBindings[i].descriptorCount = 1;
-        texBindings[i].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-        texBindings[i].pImmutableSamplers = nullptr;
-    }
-    descriptorSetLayout = descAlloc.createLayout(
-        texBindings, 3,
-        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-        nullptr,
-        "VegetationRenderer: descriptorSetLayout");
+    // The vegetation pipelines read the billboard arrays, the wind params
+    // and the impostor data from the app's bindless heap, addressed by slot
+    // (WindPushConstants).
 
     // Load indexed indirect draw function pointer
     cmdDrawIndexedIndirectCount = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCountKHR");
     if (!cmdDrawIndexedIndirectCount)
         cmdDrawIndexedIndirectCount = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCount");
 
-    // ── Wind params UBO + descriptor set layout (set=2) ────────────────────
-    {
-        VkDescriptorSetLayoutBinding binding{};
-        binding.binding         = 0;
-        binding.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        binding.descriptorCount = 1;
-        binding.stageFlags      = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        windParamsDescSetLayout = descAlloc.createLayout(
-            &binding, 1,
-            VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-            nullptr,
-            "VegetationRenderer: windParamsDescSetLayout");
-    }
-
-
-    // Allocate wind params UBO (persistently mapped host-visible).
+    // Wind params buffer (persistently mapped host-visible), one heap slot.
     {
         windParamsBuffer = app->createBuffer(sizeof(WindParamsUBO),
-            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
         windParamsMapped = windParamsBuffer.map(0);
         // Initialize with defaults
         WindParamsUBO params{};
+        params.impostorParams = impostorParams;
         std::memcpy(windParamsMapped, &params, sizeof(params));
+        windParamsSlot = app->getBindlessHeap().registerBuffer(windParamsBuffer.buffer, 0, sizeof(WindParamsUBO));
+        if (windParamsSlot == BindlessHeap::INVALID_INDEX)
+            std::cerr << "[VEGETATION] no bindless heap slot for the wind params buffer" << std::endl;
     }
 
-    // Allocate wind params descriptor set and bind the UBO.
-    {
-        windParamsDescSet = app->createDescriptorSet(windParamsDescSetLayout);
-        DescriptorWriter(device)
-            .writeBuffer(windParamsDescSet, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                         windParamsBuffer.buffer, 0, VK_WHOLE_SIZE)
-            .flush();
-        app->registerDescriptorSet(windParamsDescSet);
-    }
-
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    setLayouts.push_back(app->getDescriptorSetLayout());
-    setLayouts.push_back(descriptorSetLayout);
-    setLayouts.push_back(windParamsDescSetLayout);
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-    pushConstantRange.offset = 0;
-    pushConstantRange.size = sizeof(WindPushConstants);
+    // Build billboard corner mesh: 24 vertices (6 planes × 4 corners) + 36 indices
+    // (12 triangles = 2 per plane) for TRIANGLE_LIST.
+    if (billboardVBO.vertexBuffer.buffer == VK_NULL_HANDLE) {
+        const glm::vec3 baseTangents[6] = {
+            {0,0,1}, {-1,0,0}, {0,0,-1}, {1,0,0}, {1,0,0}, {0,0,1}
+        };
+        const glm::vec3 outwardDirs[4] = {
+            {1,0,0}, {0,0,1}, {-1,0,0}, {0,0,-1}
+        };
+        const glm::vec3 worldUp(0,1,0);
+        constexpr float hs = 0.5f, h = 1.0f, tilt = 1.0f; // scaled in VS by billboardScale
+
+        std::vector<Vertex> verts(24);
+        for (int p = 0; p < 6; ++p) {
+            glm::vec3 tangent = baseTangents[p];
+            glm::vec3 outward = (p < 4) ? outwardDirs[p] : glm::vec3(0.0f);
+            int base = p * 4;
+            auto corner = [&](int ci, glm::vec3 off, glm::vec2 uv) {
+                verts[base + ci].position = off;
+                verts[base + ci].color = tangent;
+                verts[base + ci].texCoord = uv;
+                verts[base + ci].brushIndex = (p << 8) | ci;
+            };
+            corner(0, -tangent * hs,                    glm::vec2(0,1));  // BL
+            corner(1,  tangent * hs,                    glm::vec2(1,1));  // BR
+            corner(2, -tangent * hs + worldUp * h + outward * tilt, glm::vec2(0,0));  // TL
+            corner(3,  tangent * hs + worldUp * h + outward * tilt, glm::vec2(1,0));  // TR
+        }
+        billboardVBO.vertexBuffer = app->createVertexBuffer(verts);
+
+        // 36 indices = 6 planes × 2 triangles × 3 indices
+        std::vector<uint32_t> idx(36);
+        for (int p = 0; p < 6; ++p) {
+            int b = p * 4;
+            int ib = p * 6;
+            idx[ib + 0] = b + 0; idx[ib + 1] = b + 1; idx[ib + 2] = b + 2;
+            idx[ib + 3] = b + 1; idx[ib + 4] = b + 3; idx[ib + 5] = b + 2;
+        }
+        billboardVBO.indexBuffer = app->createIndexBuffer(idx);
+        billboardVBO.indexCount = 36;
+    }
+
+    // Build impostor quad mesh: 4 vertices forming a unit-square with UV corners.
+    // The vertex shader scales and orients these into camera-facing billboards.
+    if (impostorVBO.vertexBuffer.buffer == VK_NULL_HANDLE) {
+        std::vector<Vertex> impVerts(4);
+        impVerts[0] = Vertex(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(0.0f, 1.0f), 0); // BL
+        impVerts[1] = Vertex(glm::vec3( 1.0f, -1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(1.0f, 1.0f), 0); // BR
+        impVerts[2] = Vertex(glm::vec3(-1.0f,  1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(0.0f, 0.0f), 0); // TL
+        impVerts[3] = Vertex(glm::vec3( 1.0f,  1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(1.0f, 0.0f), 0); // TR
+        impostorVBO.vertexBuffer = app->createVertexBuffer(impVerts);
+
+        std::vector<uint32_t> impIdx = { 0, 1, 2, 1, 3, 2 };
+        impostorVBO.indexBuffer = app->createIndexBuffer(impIdx);
+        impostorVBO.indexCount = 6;
+    }
+
+    // Instances are generated exclusively via compute shader; no CPU uploads
+    // are performed here.
+}
+
+void VegetationRenderer::createPipelines(VulkanApp* app) {
+    // Scene layouts: {main, heap} + the shared push range, so the heap bound
+    // once per command buffer survives every vegetation pipeline switch.
+    std::vector<VkDescriptorSetLayout> setLayouts = app->getSceneSetLayouts();
+    const VkPushConstantRange& pushConstantRange = *app->getScenePushConstantRange();
+    static_assert(sizeof(WindPushConstants) <= VulkanApp::SCENE_PUSH_CONSTANT_SIZE,
+                  "WindPushConstants exceeds the scene push-constant range");
 
     // Load shaders — no geometry shader
     VkShaderModule vertShader = app->getOrCreateShaderModule("shaders/vegetation.vert.spv");
@@ -1085,94 +976,28 @@ void VegetationRenderer::init(VulkanApp* app) {
     // Clear local shader module references; destruction handled by VulkanResourceManager
     vertShader = VK_NULL_HANDLE;
     fragShader = VK_NULL_HANDLE;
-    // Build billboard corner mesh: 24 vertices (6 planes × 4 corners) + 36 indices
-    // (12 triangles = 2 per plane) for TRIANGLE_LIST.
-    if (billboardVBO.vertexBuffer.buffer == VK_NULL_HANDLE) {
-        const glm::vec3 baseTangents[6] = {
-            {0,0,1}, {-1,0,0}, {0,0,-1}, {1,0,0}, {1,0,0}, {0,0,1}
-        };
-        const glm::vec3 outwardDirs[4] = {
-            {1,0,0}, {0,0,1}, {-1,0,0}, {0,0,-1}
-        };
-        const glm::vec3 worldUp(0,1,0);
-        constexpr float hs = 0.5f, h = 1.0f, tilt = 1.0f; // scaled in VS by billboardScale
-
-        std::vector<Vertex> verts(24);
-        for (int p = 0; p < 6; ++p) {
-            glm::vec3 tangent = baseTangents[p];
-            glm::vec3 outward = (p < 4) ? outwardDirs[p] : glm::vec3(0.0f);
-            int base = p * 4;
-            auto corner = [&](int ci, glm::vec3 off, glm::vec2 uv) {
-                verts[base + ci].position = off;
-                verts[base + ci].color = tangent;
-                verts[base + ci].texCoord = uv;
-                verts[base + ci].brushIndex = (p << 8) | ci;
-            };
-            corner(0, -tangent * hs,                    glm::vec2(0,1));  // BL
-            corner(1,  tangent * hs,                    glm::vec2(1,1));  // BR
-            corner(2, -tangent * hs + worldUp * h + outward * tilt, glm::vec2(0,0));  // TL
-            corner(3,  tangent * hs + worldUp * h + outward * tilt, glm::vec2(1,0));  // TR
-        }
-        billboardVBO.vertexBuffer = app->createVertexBuffer(verts);
-
-        // 36 indices = 6 planes × 2 triangles × 3 indices
-        std::vector<uint32_t> idx(36);
-        for (int p = 0; p < 6; ++p) {
-            int b = p * 4;
-            int ib = p * 6;
-            idx[ib + 0] = b + 0; idx[ib + 1] = b + 1; idx[ib + 2] = b + 2;
-            idx[ib + 3] = b + 1; idx[ib + 4] = b + 3; idx[ib + 5] = b + 2;
-        }
-        billboardVBO.indexBuffer = app->createIndexBuffer(idx);
-        billboardVBO.indexCount = 36;
-    }
-
-    // Build impostor quad mesh: 4 vertices forming a unit-square with UV corners.
-    // The vertex shader scales and orients these into camera-facing billboards.
-    if (impostorVBO.vertexBuffer.buffer == VK_NULL_HANDLE) {
-        std::vector<Vertex> impVerts(4);
-        impVerts[0] = Vertex(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(0.0f, 1.0f), 0); // BL
-        impVerts[1] = Vertex(glm::vec3( 1.0f, -1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(1.0f, 1.0f), 0); // BR
-        impVerts[2] = Vertex(glm::vec3(-1.0f,  1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(0.0f, 0.0f), 0); // TL
-        impVerts[3] = Vertex(glm::vec3( 1.0f,  1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(1.0f, 0.0f), 0); // TR
-        impostorVBO.vertexBuffer = app->createVertexBuffer(impVerts);
-
-        std::vector<uint32_t> impIdx = { 0, 1, 2, 1, 3, 2 };
-        impostorVBO.indexBuffer = app->createIndexBuffer(impIdx);
-        impostorVBO.indexCount = 6;
-    }
-
-    // Instances are generated exclusively via compute shader; no CPU uploads
-    // are performed here.
 }
 
 // CPU injection removed: instances are generated by compute shader only.
 
 void VegetationRenderer::clearAllInstances() {
-    // Copy IDs first to avoid iterator invalidation from destroyInstanceBuffer erasing during iteration.
-    std::vector<NodeID> ids;
-    ids.reserve(chunkBuffers.size());
-    for (const auto& kv : chunkBuffers) ids.push_back(kv.first);
-    for (NodeID id : ids) destroyInstanceBuffer(id, appPtr);
-    // destroyInstanceBuffer already clears the map entries; these are safety no-ops.
-    chunkBuffers.clear();
-    chunkInstanceCounts.clear();
-    // Clear any pending CPU-generation chunks to prevent stale data
-    // from a previous scene from being processed after scene reset.
+    // Copy IDs first: releaseChunkInstances swap-removes from chunkTableIds.
+    std::vector<NodeID> ids = chunkTableIds;
+    for (NodeID id : ids) releaseChunkInstances(id, appPtr);
+    // Drop uploads still in flight for chunks that were never published.
+    for (auto& [id, serial] : chunkUploadSerial) serial = nextUploadSerial++;
+    // Clear scattered chunks waiting for upload to prevent stale data
+    // from a previous scene from being processed after scene reset (jobs
+    // still on the pool carry now-stale serials and are dropped on arrival).
     {
-        std::lock_guard<std::mutex> lk(pendingChunksMutex);
-        pendingChunks.clear();
+        std::lock_guard<std::mutex> lk(scatteredChunksMutex);
+        scatteredChunks.clear();
     }
-    vegConsolidationDirty = true;
     vegNumChunks = 0;
 }
 
 size_t VegetationRenderer::getInstanceTotal() const {
-    size_t total = 0;
-    for (const auto& kv : chunkInstanceCounts) {
-        total += kv.second;
-    }
-    return total;
+    return instanceTotal;
 }
 
 float VegetationRenderer::computeDensityFactor(float distanceToCamera) const {
@@ -1196,14 +1021,9 @@ float VegetationRenderer::computeDensityFactor(float distanceToCamera) const {
 
 std::vector<DebugCubeRenderer::CubeWithColor> VegetationRenderer::getDensityDebugCubes(const glm::vec3& cameraPos) const {
     std::vector<DebugCubeRenderer::CubeWithColor> cubes;
-    cubes.reserve(chunkBuffers.size());
-
-    for (const auto& [chunkId, buf] : chunkBuffers) {
-        (void)chunkId;
-        if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) {
-            continue;
-        }
+    cubes.reserve(chunkTable.size());
 
+    for (const ChunkInstances& buf : chunkTable) {
         const float densityFactor = computeDensityFactor(glm::distance(buf.center, cameraPos));
         const glm::vec3 color = glm::mix(glm::vec3(1.0f, 0.15f, 0.15f), glm::vec3(0.15f, 1.0f, 0.2f), densityFactor);
         const glm::vec3 minPoint = buf.aabbMin;
@@ -1215,17 +1035,13 @@ std::vector<DebugCubeRenderer::CubeWithColor> VegetationRenderer::getDensityDebu
 }
 
 float VegetationRenderer::getAverageDensityFactor(const glm::vec3& cameraPos) const {
-    if (chunkBuffers.empty()) {
+    if (chunkTable.empty()) {
         return 1.0f;
     }
 
     float factorSum = 0.0f;
     size_t factorCount = 0;
-    for (const auto& [chunkId, buf] : chunkBuffers) {
-        (void)chunkId;
-        if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) {
-            continue;
-        }
+    for (const ChunkInstances& buf : chunkTable) {
         factorSum += computeDensityFactor(glm::distance(buf.center, cameraPos));
         ++factorCount;
     }
@@ -1235,52 +1051,29 @@ float VegetationRenderer::getAverageDensityFactor(const glm::vec3& cameraPos) co
 
 void VegetationRenderer::recordReadBarriers(VkCommandBuffer& commandBuffer) {
     if (commandBuffer == VK_NULL_HANDLE) return;
-
-    // Reuse frame-thread scratch vector (clear + reserve) to avoid one heap
-    // allocation per call; called twice per frame from the main thread.
-    readBarrierScratch.clear();
-    readBarrierScratch.reserve(chunkBuffers.size() * 2);
-    std::vector<VkBufferMemoryBarrier2>& readBarriers = readBarrierScratch;
-    for (const auto& [chunkId, buf] : chunkBuffers) {
-        (void)chunkId;
-        if (buf.buffer == VK_NULL_HANDLE || buf.indirectBuffer == VK_NULL_HANDLE || buf.count == 0) continue;
-
-        // Instance buffers are filled by the CPU (processPendingChunks writes
-        // via mapped HOST_VISIBLE memory).  Without this barrier the GPU may
-        // read uninitialized billboardIndex values, producing out-of-bounds
-        // texture-array accesses that cause RADV GPUVM faults (TCP read).
-        VkBufferMemoryBarrier2 instanceBarrier{};
-        instanceBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
-        instanceBarrier.srcStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
-        instanceBarrier.srcAccessMask = VK_ACCESS_2_HOST_WRITE_BIT;
-        instanceBarrier.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
-        instanceBarrier.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
-        instanceBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        instanceBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        instanceBarrier.buffer = buf.buffer;
-        instanceBarrier.offset = 0;
-        instanceBarrier.size = VK_WHOLE_SIZE;
-        readBarriers.push_back(instanceBarrier);
-
-        VkBufferMemoryBarrier2 indirectBarrier{};
-        indirectBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
-        indirectBarrier.srcStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
-        indirectBarrier.srcAccessMask = VK_ACCESS_2_HOST_WRITE_BIT;
-        indirectBarrier.dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
-        indirectBarrier.dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
-        indirectBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        indirectBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        indirectBarrier.buffer = buf.indirectBuffer;
-        indirectBarrier.offset = 0;
-        indirectBarrier.size = VK_WHOLE_SIZE;
-        readBarriers.push_back(indirectBarrier);
-    }
-    if (readBarriers.empty()) return;
+    if (instanceArenaBuffer.buffer == VK_NULL_HANDLE || chunkTable.empty()) return;
+
+    // Chunk uploads (and arena growth) copy into the arena from earlier
+    // submissions on this queue. Without this barrier the GPU may read
+    // uninitialized billboardIndex values, producing out-of-bounds
+    // texture-array accesses that cause RADV GPUVM faults (TCP read).
+    // Draw commands live in host-coherent buffers written before submit.
+    VkBufferMemoryBarrier2 instanceBarrier{};
+    instanceBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    instanceBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    instanceBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    instanceBarrier.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+    instanceBarrier.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+    instanceBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    instanceBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    instanceBarrier.buffer = instanceArenaBuffer.buffer;
+    instanceBarrier.offset = 0;
+    instanceBarrier.size = VK_WHOLE_SIZE;
 
     VkDependencyInfo depInfo{};
     depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-    depInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(readBarriers.size());
-    depInfo.pBufferMemoryBarriers = readBarriers.data();
+    depInfo.bufferMemoryBarrierCount = 1;
+    depInfo.pBufferMemoryBarriers = &instanceBarrier;
     vkCmdPipelineBarrier2(commandBuffer, &depInfo);
 }
 
@@ -1295,55 +1088,50 @@ void VegetationRenderer::drawShadow(VulkanApp* app, VkCommandBuffer& commandBuff
 
     // Early-out when there are no chunks to draw: skip pipeline/descriptor
     // binding entirely. On RADV iGPUs, binding pipelines that reference
-    // large texture arrays (via vegDescriptorSet) can trigger GPUVM faults
+    // large texture arrays (via the bindless heap) can trigger GPUVM faults
     // even when zero draw calls are issued.
-    if (chunkBuffers.empty()) return;
+    if (chunkTable.empty()) return;
 
-    // Ensure vegetation descriptor set is present and up-to-date
-    if (!ensureVegDescriptorSet(app)) {
-        std::cerr << "[VEGETATION SHADOW DRAW ERROR] vegDescriptorSet not ready, skipping draw." << std::endl;
+    // Ensure the billboard arrays are registered in the bindless heap
+    if (!ensureBillboardSlots(app)) {
+        std::cerr << "[VEGETATION SHADOW DRAW ERROR] billboard heap slots not ready, skipping draw." << std::endl;
         return;
     }
 
-    // Defensive checks: ensure both descriptor sets are valid before binding
+    // Defensive checks: the shadow set and the wind params slot must be valid
     if (shadowDescriptorSet == VK_NULL_HANDLE) {
         std::cerr << "[VEGETATION SHADOW DRAW ERROR] shadowDescriptorSet is VK_NULL_HANDLE, skipping draw." << std::endl;
         return;
     }
-    if (vegDescriptorSet == VK_NULL_HANDLE) {
-        std::cerr << "[VEGETATION SHADOW DRAW ERROR] vegDescriptorSet is VK_NULL_HANDLE, skipping draw." << std::endl;
+    if (windParamsSlot == BindlessHeap::INVALID_INDEX) {
+        std::cerr << "[VEGETATION SHADOW DRAW ERROR] wind params heap slot missing, skipping draw." << std::endl;
         return;
     }
 
     if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, vegetationShadowPipeline);
     else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vegetationShadowPipeline);
 
-    // Bind the shadow descriptor set (set 0), vegetation descriptor set (set 1),
-    // and wind params UBO (set 2)
+    // Bind the shadow descriptor set (set 0); the bindless heap (set 1) is
+    // bound once for the pass by ShadowRenderer.
     updateWindParamsUBO(cameraPos);
-    VkDescriptorSet sets[3] = { shadowDescriptorSet, vegDescriptorSet, windParamsDescSet };
-    if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, shadowPipelineLayout, 0, 3, sets, 0, nullptr);
-    else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipelineLayout, 0, 3, sets, 0, nullptr);
+    if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, shadowPipelineLayout, 0, 1, &shadowDescriptorSet, 0, nullptr);
+    else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipelineLayout, 0, 1, &shadowDescriptorSet, 0, nullptr);
 
     // Push constants for shadow pass: same as regular draw but with wind disabled
-    // The UBO already contains the wind parameters; we only push the 16-byte header
-    WindPushConstants pc{};
-    pc.billboardScale = billboardScale;
+    WindPushConstants pc = buildWindPushConstants(cameraPos);
     pc.windEnabled = -1.0f;  // Negative means shadow pass: disable wind and tighten impostor cutoff.
-    pc.windTime = windTimeSeconds;
-    pc.impostorDistance = impostorDistance; // skip far instances in shadow pass
 
     vkCmdPushConstants(commandBuffer, shadowPipelineLayout,
-                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       VK_SHADER_STAGE_ALL_GRAPHICS,
                        0, sizeof(WindPushConstants), &pc);
 
-    // Draw consolidated via GPU culling only (no per-chunk fallback).
-    // New chunks appear gradually as they are uploaded and consolidated.
+    // Draw via GPU culling only (no per-chunk fallback). New chunks appear
+    // as their arena uploads complete.
     uint32_t sf = vegCullCurrentSlot;
     vkCmdBindIndexBuffer(commandBuffer, billboardVBO.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
-    if (!vegConsolidationDirty && concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0 &&
+    if (instanceArenaBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0 &&
         compactedCmdBuffers[sf].buffer != VK_NULL_HANDLE && visibleCountBuffers[sf].buffer != VK_NULL_HANDLE) {
-        VkBuffer vbs[2] = { billboardVBO.vertexBuffer.buffer, concatenatedInstanceBuffer.buffer };
+        VkBuffer vbs[2] = { billboardVBO.vertexBuffer.buffer, instanceArenaBuffer.buffer };
         VkDeviceSize offsets[2] = { 0, 0 };
         vkCmdBindVertexBuffers(commandBuffer, 0, 2, vbs, offsets);
         cmdDrawIndexedIndirectCount(commandBuffer, compactedCmdBuffers[sf].buffer, 0,
@@ -1356,36 +1144,26 @@ void VegetationRenderer::drawShadow(VulkanApp* app, VkCommandBuffer& commandBuff
     VkPipelineLayout impostorShadowLayout = (impostorShadowPipelineLayout != VK_NULL_HANDLE)
                                           ? impostorShadowPipelineLayout : impostorDepthPipelineLayout;
     if (impostorShadowPipe != VK_NULL_HANDLE &&
-        impostorDepthDescSet  != VK_NULL_HANDLE &&
+        impostorDepthSlot != BindlessHeap::INVALID_INDEX &&
         impostorDistance > 0.0f && impostorVBO.vertexBuffer.buffer != VK_NULL_HANDLE &&
-        !chunkBuffers.empty()) {
+        !chunkTable.empty()) {
 
+        // Same scene layout: the shadow set and the heap stay bound.
         if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, impostorShadowPipe);
         else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorShadowPipe);
 
-        VkDescriptorSet depthSets[3] = { shadowDescriptorSet, impostorDepthDescSet, windParamsDescSet };
-        if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer,
-                    impostorShadowLayout, 0, 3, depthSets, 0, nullptr);
-        else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                    impostorShadowLayout, 0, 3, depthSets, 0, nullptr);
-
         vkCmdPushConstants(commandBuffer, impostorShadowLayout,
-                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                           VK_SHADER_STAGE_ALL_GRAPHICS,
                            0, sizeof(WindPushConstants), &pc);
 
         vkCmdBindIndexBuffer(commandBuffer, impostorVBO.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
         VkBuffer impVbs[2] = { impostorVBO.vertexBuffer.buffer, VK_NULL_HANDLE };
         VkDeviceSize impOffsets[2] = { 0, 0 };
-        if (!vegConsolidationDirty && concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
-            impVbs[1] = concatenatedInstanceBuffer.buffer;
+        if (instanceArenaBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
+            impVbs[1] = instanceArenaBuffer.buffer;
             vkCmdBindVertexBuffers(commandBuffer, 0, 2, impVbs, impOffsets);
-            uint32_t instOff = 0;
-            for (auto& [chunkId, buf] : chunkBuffers) {
-                (void)chunkId;
-                if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) continue;
-                vkCmdDrawIndexed(commandBuffer, 6, static_cast<uint32_t>(buf.count), 0, 0, instOff);
-                instOff += buf.count;
-            }
+            for (const ChunkInstances& c : chunkTable)
+                vkCmdDrawIndexed(commandBuffer, 6, c.count, 0, 0, c.firstInstance);
         }
     }
 }
@@ -1397,128 +1175,43 @@ void VegetationRenderer::setImpostorData(VulkanApp* app,
                                           VkImageView depthArray60,
                                           VkBuffer captureInvVPBuf) {
     if (!app || albedoArray60 == VK_NULL_HANDLE || normalArray60 == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE) return;
-    // Wait for all in-flight graphics work to complete before recreating descriptor sets.
-    // This prevents handle-reuse collisions between pending command buffers and
-    // freshly-allocated descriptor set handles. Only waits on per-frame fences
-    // rather than draining the entire device.
+    // Wait for all in-flight graphics work to complete before replacing the
+    // impostor pipelines; the previous heap slots are released deferred.
     app->waitForFrameFences();
 
-    VkDevice device = app->getDevice();
-
     // Destroy any previous impostor resources (handles are tracked in the central manager).
     impostorPipeline            = VK_NULL_HANDLE;
     impostorPipelineLayout      = VK_NULL_HANDLE;
-    impostorDescSetLayout       = VK_NULL_HANDLE;
-    impostorDescPool            = VK_NULL_HANDLE;
-    impostorDescSet             = VK_NULL_HANDLE;
     impostorDepthPipeline       = VK_NULL_HANDLE;
     impostorDepthPipelineLayout = VK_NULL_HANDLE;
-    impostorDepthDescSetLayout  = VK_NULL_HANDLE;
-    impostorDepthDescPool       = VK_NULL_HANDLE;
-    impostorDepthDescSet        = VK_NULL_HANDLE;
     impostorShadowPipeline      = VK_NULL_HANDLE;
     impostorShadowPipelineLayout = VK_NULL_HANDLE;
+    releaseImpostorSlots(app);
 
     bool hasImpostorDepth = (depthArray60 != VK_NULL_HANDLE && captureInvVPBuf != VK_NULL_HANDLE);
 
-    // ── Set 1: impostor color pipeline (albedo, normal, depth + captureInvVP) ──
-    // Bindings 2-3 provide depth data so the fragment shader writes gl_FragDepth.
+    // ── Heap slots: albedo, normal, depth + captureInvVP ──
+    // The depth data lets the fragment shader write gl_FragDepth.
     // Single-pass rendering: depthWrite=true, LESS compare (no separate depth prepass).
-    {
-        uint32_t numBindings = hasImpostorDepth ? 4u : 2u;
-
-        VkDescriptorSetLayoutBinding bindings[4]{};
-        bindings[0].binding         = 0;
-        bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        bindings[0].descriptorCount = 1;
-        bindings[0].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-        bindings[1].binding         = 1;
-        bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        bindings[1].descriptorCount = 1;
-        bindings[1].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-        if (hasImpostorDepth) {
-            bindings[2].binding         = 2;
-            bindings[2].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            bindings[2].descriptorCount = 1;
-            bindings[2].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-            bindings[3].binding         = 3;
-            bindings[3].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            bindings[3].descriptorCount = 1;
-            bindings[3].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-        }
-        DescriptorAllocator descAlloc{device, app};
-        impostorDescSetLayout = descAlloc.createLayout(
-            bindings, numBindings,
-            VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-            nullptr,
-            "VegetationRenderer: impostorDescSetLayout");
-
-        {
-            std::vector<VkDescriptorPoolSize> poolSz;
-            poolSz.emplace_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, hasImpostorDepth ? 3u : 2u});
-            if (hasImpostorDepth)
-                poolSz.emplace_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u});
-            impostorDescPool = descAlloc.createPool(
-                poolSz.data(), static_cast<uint32_t>(poolSz.size()), 1,
-                VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-                "VegetationRenderer: impostorDescPool");
-        }
-
-        impostorDescSet = descAlloc.allocateSet(impostorDescPool, impostorDescSetLayout);
-
-        DescriptorWriter writer(device);
-        writer.writeImage(impostorDescSet, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                          sampler, albedoArray60,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        writer.writeImage(impostorDescSet, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                          sampler, normalArray60,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-        if (hasImpostorDepth) {
-            writer.writeImage(impostorDescSet, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                              sampler, depthArray60,
-                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            writer.writeBuffer(impostorDescSet, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                               captureInvVPBuf, 0, VK_WHOLE_SIZE);
-        }
-        writer.flush();
-    }
-
-    // ── Set 1 (depth variant): depth array + capture inv VP buffer ──────
+    BindlessHeap& heap = app->getBindlessHeap();
+    impostorAlbedoSlot = heap.registerImage(albedoArray60, sampler);
+    impostorNormalSlot = heap.registerImage(normalArray60, sampler);
     if (hasImpostorDepth) {
-        VkDescriptorSetLayoutBinding depthBindings[2]{};
-        depthBindings[0].binding         = 0;
-        depthBindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        depthBindings[0].descriptorCount = 1;
-        depthBindings[0].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-        depthBindings[1].binding         = 1;
-        depthBindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        depthBindings[1].descriptorCount = 1;
-        depthBindings[1].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
-        DescriptorAllocator depthDescAlloc{device, app};
-        impostorDepthDescSetLayout = depthDescAlloc.createLayout(
-            depthBindings, 2,
-            VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-            nullptr,
-            "VegetationRenderer: impostorDepthDescSetLayout");
-
-        VkDescriptorPoolSize depthPoolSizes[] = {
-            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1},
-            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1}
-        };
-        impostorDepthDescPool = depthDescAlloc.createPool(
-            depthPoolSizes, 2, 1,
-            VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-            "VegetationRenderer: impostorDepthDescPool");
-
-        impostorDepthDescSet = depthDescAlloc.allocateSet(impostorDepthDescPool, impostorDepthDescSetLayout);
+        impostorDepthSlot = heap.registerImage(depthArray60, sampler);
+        captureInvVPSlot  = heap.registerBuffer(captureInvVPBuf);
+        hasImpostorDepth = impostorDepthSlot != BindlessHeap::INVALID_INDEX &&
+                           captureInvVPSlot != BindlessHeap::INVALID_INDEX;
+    }
+    if (impostorAlbedoSlot == BindlessHeap::INVALID_INDEX || impostorNormalSlot == BindlessHeap::INVALID_INDEX) {
+        std::cerr << "[VegetationRenderer] WARNING: no bindless heap slots for the impostor arrays\n";
+        releaseImpostorSlots(app);
+        return;
+    }
 
-        DescriptorWriter(device)
-            .writeImage(impostorDepthDescSet, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                        sampler, depthArray60, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-            .writeBuffer(impostorDepthDescSet, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                         captureInvVPBuf, 0, VK_WHOLE_SIZE)
-            .flush();
+    std::vector<VkDescriptorSetLayout> sceneSetLayouts = app->getSceneSetLayouts();
+    const VkPushConstantRange* scenePCRange = app->getScenePushConstantRange();
 
+    if (hasImpostorDepth) {
         // ── Build impostor depth pipeline ────────────────────────────────
         VkShaderModule depthVertMod = app->getOrCreateShaderModule("shaders/impostors_depth.vert.spv");
         VkShaderModule depthFragMod = app->getOrCreateShaderModule("shaders/impostors_depth.frag.spv");
@@ -1537,16 +1230,6 @@ void VegetationRenderer::setImpostorData(VulkanApp* app,
         depthBindingDescs[0] = { 0, sizeof(Vertex),       VK_VERTEX_INPUT_RATE_VERTEX   };
         depthBindingDescs[1] = { 1, sizeof(float) * 4,    VK_VERTEX_INPUT_RATE_INSTANCE };
 
-        std::vector<VkDescriptorSetLayout> depthSetLayouts = {
-            app->getDescriptorSetLayout(),
-            impostorDepthDescSetLayout,
-            windParamsDescSetLayout
-        };
-        VkPushConstantRange depthPCRange{};
-        depthPCRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        depthPCRange.offset     = 0;
-        depthPCRange.size       = sizeof(WindPushConstants);
-
         GraphicsPipelineConfig impDepthCfg{};
         impDepthCfg.cullMode = VK_CULL_MODE_NONE;
         impDepthCfg.colorWrite = false;
@@ -1559,8 +1242,8 @@ void VegetationRenderer::setImpostorData(VulkanApp* app,
                 { ATTR_UV, 0, VK_FORMAT_R32G32_SFLOAT,       (uint32_t)offsetof(Vertex, texCoord) },
                 { ATTR_INSTANCE, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 0                              },
             },
-            depthSetLayouts,
-            &depthPCRange,
+            sceneSetLayouts,
+            scenePCRange,
             impDepthCfg
         );
         impostorDepthPipeline       = depthPipe;
@@ -1588,8 +1271,8 @@ void VegetationRenderer::setImpostorData(VulkanApp* app,
                 { ATTR_UV, 0, VK_FORMAT_R32G32_SFLOAT,       (uint32_t)offsetof(Vertex, texCoord) },
                 { ATTR_INSTANCE, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 0                              },
             },
-            depthSetLayouts,
-            &depthPCRange,
+            sceneSetLayouts,
+            scenePCRange,
             impShadowCfg
         );
         impostorShadowPipeline       = shadowPipe;
@@ -1623,16 +1306,6 @@ void VegetationRenderer::setImpostorData(VulkanApp* app,
     bindingDescs[0] = { 0, sizeof(Vertex),       VK_VERTEX_INPUT_RATE_VERTEX   };
     bindingDescs[1] = { 1, sizeof(float) * 4,    VK_VERTEX_INPUT_RATE_INSTANCE };
 
-    std::vector<VkDescriptorSetLayout> impSetLayouts = {
-        app->getDescriptorSetLayout(),
-        impostorDescSetLayout,
-        windParamsDescSetLayout
-    };
-    VkPushConstantRange pcRange{};
-    pcRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-    pcRange.offset     = 0;
-    pcRange.size       = sizeof(WindPushConstants);
-
     GraphicsPipelineConfig impCfg{};
     impCfg.cullMode = VK_CULL_MODE_NONE;
     impCfg.depthCompareOp = VK_COMPARE_OP_LESS;
@@ -1643,8 +1316,8 @@ void VegetationRenderer::setImpostorData(VulkanApp* app,
             { ATTR_UV, 0, VK_FORMAT_R32G32_SFLOAT,       (uint32_t)offsetof(Vertex, texCoord) },
             { ATTR_INSTANCE, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 0                              },
         },
-        impSetLayouts,
-        &pcRange,
+        sceneSetLayouts,
+        scenePCRange,
         impCfg
     );
 
@@ -1674,6 +1347,14 @@ VegetationRenderer::WindPushConstants VegetationRenderer::buildWindPushConstants
     pc.windEnabled        = windSettings.enabled ? 1.0f : 0.0f;
     pc.windTime           = windTimeSeconds;
     pc.impostorDistance   = impostorDistance;
+    pc.windParamsBuffer   = windParamsSlot;
+    pc.albedoTexture      = albedoSlot;
+    pc.normalTexture      = normalSlot;
+    pc.opacityTexture     = opacitySlot;
+    pc.impostorTexture        = impostorAlbedoSlot;
+    pc.impostorNormalTexture  = impostorNormalSlot;
+    pc.impostorDepthTexture   = impostorDepthSlot;
+    pc.captureInvVPBuffer     = captureInvVPSlot;
     return pc;
 }
 
@@ -1708,20 +1389,21 @@ void VegetationRenderer::updateWindParamsUBO(const glm::vec3& cameraPos) {
         ? (-std::log(safeMinFactor) / (farDistance - nearDistance)) : 0.0f;
     params.densityParams = glm::vec4(distanceDensitySettings.enabled ? 1.0f : 0.0f, nearDistance, farDistance, minFactor);
     params.cameraPosAndFalloff = glm::vec4(cameraPos, falloff);
+    params.impostorParams = impostorParams;
 
     std::memcpy(windParamsMapped, &params, sizeof(params));
 }
 
-void VegetationRenderer::issueVegetationDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, VkShaderStageFlags pushConstantStages, const WindPushConstants& pc) {
+void VegetationRenderer::issueVegetationDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, const WindPushConstants& pc) {
     uint32_t f = vegCullCurrentSlot;
-    vkCmdPushConstants(cmd, activeLayout, pushConstantStages, 0, sizeof(WindPushConstants), &pc);
+    vkCmdPushConstants(cmd, activeLayout, VK_SHADER_STAGE_ALL_GRAPHICS, 0, sizeof(WindPushConstants), &pc);
     if (billboardVBO.vertexBuffer.buffer == VK_NULL_HANDLE || billboardVBO.indexBuffer.buffer == VK_NULL_HANDLE) return;
     VkBuffer vbs[2] = { billboardVBO.vertexBuffer.buffer, VK_NULL_HANDLE };
     VkDeviceSize offsets[2] = { 0, 0 };
     vkCmdBindIndexBuffer(cmd, billboardVBO.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
-    if (!vegConsolidationDirty && concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0 &&
+    if (instanceArenaBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0 &&
         compactedCmdBuffers[f].buffer != VK_NULL_HANDLE && visibleCountBuffers[f].buffer != VK_NULL_HANDLE) {
-        vbs[1] = concatenatedInstanceBuffer.buffer;
+        vbs[1] = instanceArenaBuffer.buffer;
         vkCmdBindVertexBuffers(cmd, 0, 2, vbs, offsets);
         if (cmdDrawIndexedIndirectCount) {
             cmdDrawIndexedIndirectCount(cmd, compactedCmdBuffers[f].buffer, 0,
@@ -1730,47 +1412,41 @@ void VegetationRenderer::issueVegetationDraws(VkCommandBuffer cmd, VkPipelineLay
     }
 }
 
-void VegetationRenderer::issueImpostorDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, VkShaderStageFlags pushConstantStages, const WindPushConstants& pc) {
-    vkCmdPushConstants(cmd, activeLayout, pushConstantStages, 0, sizeof(WindPushConstants), &pc);
+void VegetationRenderer::issueImpostorDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, const WindPushConstants& pc) {
+    vkCmdPushConstants(cmd, activeLayout, VK_SHADER_STAGE_ALL_GRAPHICS, 0, sizeof(WindPushConstants), &pc);
     if (impostorVBO.vertexBuffer.buffer == VK_NULL_HANDLE || impostorVBO.indexBuffer.buffer == VK_NULL_HANDLE) return;
     VkBuffer vbs[2] = { impostorVBO.vertexBuffer.buffer, VK_NULL_HANDLE };
     VkDeviceSize offsets[2] = { 0, 0 };
     vkCmdBindIndexBuffer(cmd, impostorVBO.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
-    if (!vegConsolidationDirty && concatenatedInstanceBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
-        vbs[1] = concatenatedInstanceBuffer.buffer;
+    if (instanceArenaBuffer.buffer != VK_NULL_HANDLE && vegNumChunks > 0) {
+        vbs[1] = instanceArenaBuffer.buffer;
         vkCmdBindVertexBuffers(cmd, 0, 2, vbs, offsets);
-        uint32_t instOff = 0;
-        for (auto& [chunkId, buf] : chunkBuffers) {
-            (void)chunkId;
-            if (buf.buffer == VK_NULL_HANDLE || buf.count == 0) continue;
-            vkCmdDrawIndexed(cmd, 6, static_cast<uint32_t>(buf.count), 0, 0, instOff);
-            instOff += buf.count;
-        }
+        for (const ChunkInstances& c : chunkTable)
+            vkCmdDrawIndexed(cmd, 6, c.count, 0, 0, c.firstInstance);
     }
 }
 
 void VegetationRenderer::drawDepth(VulkanApp* app, VkCommandBuffer& commandBuffer, const glm::mat4& viewProj, const glm::vec3& cameraPos) {
     (void)viewProj;
     if (!app) return;
-    if (chunkBuffers.empty()) return;
+    if (chunkTable.empty()) return;
     if (billboardAlbedoView == VK_NULL_HANDLE || billboardNormalView == VK_NULL_HANDLE ||
         billboardOpacityView == VK_NULL_HANDLE || billboardArraySampler == VK_NULL_HANDLE) return;
-    if (!ensureVegDescriptorSet(app)) return;
+    if (!ensureBillboardSlots(app)) return;
     VkDescriptorSet globalSet = app->getMainDescriptorSet();
-    if (globalSet == VK_NULL_HANDLE || vegDescriptorSet == VK_NULL_HANDLE) return;
+    if (globalSet == VK_NULL_HANDLE || windParamsSlot == BindlessHeap::INVALID_INDEX) return;
     updateWindParamsUBO(cameraPos);
     WindPushConstants pc = buildWindPushConstants(cameraPos);
-    VkDescriptorSet sets[3] = { globalSet, vegDescriptorSet, windParamsDescSet };
 
     // Depth prepass
     if (vegetationDepthPipeline != VK_NULL_HANDLE) {
         if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, vegetationDepthPipeline);
         else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vegetationDepthPipeline);
         if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer,
-            vegetationDepthPipelineLayout, 0, 3, sets, 0, nullptr);
+            vegetationDepthPipelineLayout, 0, 1, &globalSet, 0, nullptr);
         else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            vegetationDepthPipelineLayout, 0, 3, sets, 0, nullptr);
-        issueVegetationDraws(commandBuffer, vegetationDepthPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, pc);
+            vegetationDepthPipelineLayout, 0, 1, &globalSet, 0, nullptr);
+        issueVegetationDraws(commandBuffer, vegetationDepthPipelineLayout, pc);
     }
 
 }
@@ -1778,61 +1454,47 @@ void VegetationRenderer::drawDepth(VulkanApp* app, VkCommandBuffer& commandBuffe
 void VegetationRenderer::drawColor(VulkanApp* app, VkCommandBuffer& commandBuffer, const glm::mat4& viewProj, const glm::vec3& cameraPos) {
     (void)viewProj;
     if (!app) return;
-    if (chunkBuffers.empty()) return;
+    if (chunkTable.empty()) return;
     if (billboardAlbedoView == VK_NULL_HANDLE || billboardNormalView == VK_NULL_HANDLE ||
         billboardOpacityView == VK_NULL_HANDLE || billboardArraySampler == VK_NULL_HANDLE) return;
-    if (!ensureVegDescriptorSet(app)) return;
+    if (!ensureBillboardSlots(app)) return;
     VkDescriptorSet globalSet = app->getMainDescriptorSet();
-    if (globalSet == VK_NULL_HANDLE || vegDescriptorSet == VK_NULL_HANDLE) return;
+    if (globalSet == VK_NULL_HANDLE || windParamsSlot == BindlessHeap::INVALID_INDEX) return;
     updateWindParamsUBO(cameraPos);
     WindPushConstants pc = buildWindPushConstants(cameraPos);
-    VkDescriptorSet sets[3] = { globalSet, vegDescriptorSet, windParamsDescSet };
 
     // Shading pass
     if (vegetationPipeline != VK_NULL_HANDLE) {
         if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, vegetationPipeline);
         else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vegetationPipeline);
         if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer,
-            pipelineLayout, 0, 3, sets, 0, nullptr);
+            pipelineLayout, 0, 1, &globalSet, 0, nullptr);
         else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            pipelineLayout, 0, 3, sets, 0, nullptr);
-        issueVegetationDraws(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, pc);
+            pipelineLayout, 0, 1, &globalSet, 0, nullptr);
+        issueVegetationDraws(commandBuffer, pipelineLayout, pc);
     }
-    // Impostor color pass
+    // Impostor color pass (same scene layout: set 0 and the heap stay bound)
     if (impostorPipeline != VK_NULL_HANDLE &&
-        impostorDescSet != VK_NULL_HANDLE && impostorDistance > 0.0f) {
+        impostorAlbedoSlot != BindlessHeap::INVALID_INDEX && impostorDistance > 0.0f) {
         if (cmdState) cmdState->bindGraphicsPipeline(commandBuffer, impostorPipeline);
         else vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorPipeline);
-        VkDescriptorSet impSets[3] = { globalSet, impostorDescSet, windParamsDescSet };
         if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer,
-                    impostorPipelineLayout, 0, 3, impSets, 0, nullptr);
+                    impostorPipelineLayout, 0, 1, &globalSet, 0, nullptr);
         else vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                    impostorPipelineLayout, 0, 3, impSets, 0, nullptr);
-        issueImpostorDraws(commandBuffer, impostorPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, pc);
+                    impostorPipelineLayout, 0, 1, &globalSet, 0, nullptr);
+        issueImpostorDraws(commandBuffer, impostorPipelineLayout, pc);
     }
 }
 
 
 // ── CPU-side instance generation ─────────────────────────────────────────────
-// Mirrors the previous GPU compute path (now removed) on the CPU.  Avoids GPUVM
-// faults on RADV iGPUs where TCP cannot read storage buffers from any
-// memory type (device-local, host-visible, or concurrent-shared).
+// Runs on scatterPool. Avoids GPUVM faults on RADV iGPUs where TCP cannot read
+// storage buffers from any memory type (device-local, host-visible, or
+// concurrent-shared), which ruled out a compute-shader path.
 
 namespace {
 
-// XorShift32 PRNG — matches compute shader behaviour.
-uint32_t xorshift32(uint32_t& state) {
-    state ^= state << 13;
-    state ^= state >> 17;
-    state ^= state << 5;
-    return state;
-}
-
-float randFloat(uint32_t& state) {
-    return float(xorshift32(state) & 0x00FFFFFFu) / float(0x01000000u);
-}
-
-// Position hash — matches posHash in the compute shader.
+// Position hash: quantised to 1/8 unit so keys survive re-meshing.
 uint32_t posHash(const glm::vec3& p) {
     glm::ivec3 qi = glm::ivec3(glm::round(p * 8.0f));
     uint32_t h = uint32_t(qi.x) * 1640531513u;
@@ -1841,7 +1503,7 @@ uint32_t posHash(const glm::vec3& p) {
     return h;
 }
 
-// 2D cell hash — matches cellHash in the compute shader.
+// 2D cell hash for the biome lattice.
 uint32_t cellHash(glm::ivec2 c) {
     uint32_t h = uint32_t(c.x) * 1640531513u ^ uint32_t(c.y) * 2246822519u;
     h ^= h >> 13;
@@ -1850,7 +1512,7 @@ uint32_t cellHash(glm::ivec2 c) {
     return h;
 }
 
-// Biome noise — matches biomeNoise in the compute shader.
+// Biome noise: smooth value noise over a 50-unit lattice.
 float biomeNoise(const glm::vec2& xz) {
     const float kBiomeScale = 50.0f;
     glm::vec2 p = xz / kBiomeScale;
@@ -1868,239 +1530,389 @@ float biomeNoise(const glm::vec2& xz) {
 
 } // anonymous namespace
 
-void VegetationRenderer::generateChunkInstancesCPU(NodeID chunkId,
-                                                   const std::vector<glm::vec3>& positions,
-                                                   const std::vector<uint32_t>& grassIndices,
-                                                   const glm::vec3& chunkCenter,
-                                                   uint32_t instancesPerTriangle, VulkanApp* app,
-                                                   uint32_t seed) {
-    (void)app; // used later in processPendingChunks
-    if (grassIndices.size() < 3 || instancesPerTriangle == 0 || positions.empty()) {
-        destroyInstanceBuffer(chunkId, app);
-        return;
-    }
-    // Enqueue for later processing — the render thread drains this queue.
-    PendingChunk pc;
-    pc.chunkId             = chunkId;
-    pc.positions           = positions;
-    pc.grassIndices        = grassIndices;
-    pc.chunkCenter         = chunkCenter;
-    pc.instancesPerTriangle = instancesPerTriangle;
-    pc.seed                = seed;
-    {
-        std::lock_guard<std::mutex> lk(pendingChunksMutex);
-        pendingChunks.push_back(std::move(pc));
+VegetationRenderer::ScatteredChunk VegetationRenderer::scatterChunk(const ScatterJob& job) {
+    constexpr int kGrassBrushIndex = 3; // See LandBrush::grass
+    // Instances per world-space unit² of triangle area.
+    constexpr float kVegetationDensity = 0.01f;
+
+    ScatteredChunk out{};
+    out.chunkId = job.chunkId;
+    out.serial = job.serial;
+    const std::vector<Vertex>& verts = job.vertices;
+    const std::vector<uint>& indices = job.indices;
+    if (verts.empty() || indices.size() < 3) return out;
+
+    // Centre and AABB from vertex positions (conservatively bounds all instance anchors)
+    glm::vec3 center(0.0f);
+    glm::vec3 aabbMin( std::numeric_limits<float>::max());
+    glm::vec3 aabbMax(-std::numeric_limits<float>::max());
+    for (const Vertex& v : verts) {
+        center += v.position;
+        aabbMin = glm::min(aabbMin, v.position);
+        aabbMax = glm::max(aabbMax, v.position);
+    }
+    const float maxBillboardRadius = job.billboardScale * 2.1f; // max heightScale (1.4) × max corner offset (1.5)
+    out.center = center / static_cast<float>(verts.size());
+    out.aabbMin = aabbMin - glm::vec3(maxBillboardRadius);
+    out.aabbMax = aabbMax + glm::vec3(maxBillboardRadius);
+
+    const uint32_t chunkSeed = static_cast<uint32_t>(job.chunkId ^ (job.chunkId >> 32)) ^ 0x9e3779b9u;
+    const uint32_t seed = static_cast<uint32_t>(job.chunkId & 0xffffffffull);
+
+    // Pass 1: grass triangles and their slot counts.
+    // count = floor(area * density) + Bernoulli(frac), drawn from the
+    // triangle's position key so the result does not depend on index order.
+    struct GrassTri {
+        glm::vec3 v0, e1, e2;
+        uint32_t key;
+        uint32_t slots;
+    };
+    std::vector<GrassTri> tris;
+    tris.reserve(indices.size() / 3);
+    uint32_t totalSlots = 0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const uint32_t i0 = indices[i + 0];
+        const uint32_t i1 = indices[i + 1];
+        const uint32_t i2 = indices[i + 2];
+        if (i0 >= verts.size() || i1 >= verts.size() || i2 >= verts.size()) continue;
+        const bool hasGrass =
+            verts[i0].brushIndex == kGrassBrushIndex ||
+            verts[i1].brushIndex == kGrassBrushIndex ||
+            verts[i2].brushIndex == kGrassBrushIndex;
+        if (!hasGrass) continue;
+        const glm::vec3& v0 = verts[i0].position;
+        const glm::vec3& v1 = verts[i1].position;
+        const glm::vec3& v2 = verts[i2].position;
+        // Skip steep / downward-facing triangles.
+        const glm::vec3 faceNormal = glm::cross(v1 - v0, v2 - v0);
+        if (glm::abs(faceNormal.y) <= 0.5f * glm::length(faceNormal)) continue;
+        const float expectedInstances = std::max(0.0f, 0.5f * glm::length(faceNormal) * kVegetationDensity);
+        const uint32_t tch = posHash((v0 + v1 + v2) / 3.0f);
+        uint32_t slotCount = static_cast<uint32_t>(std::floor(expectedInstances));
+        if (counterRandomFloat(chunkSeed, tch) < expectedInstances - static_cast<float>(slotCount)) ++slotCount;
+        if (slotCount == 0) continue;
+        tris.push_back({ v0, v1 - v0, v2 - v0, seed ^ tch, slotCount });
+        totalSlots += slotCount;
+    }
+    if (totalSlots == 0) return out;
+
+    // Pass 2: one (triangle, sub-slot) pair per instance, then all random
+    // draws in flat loops with no carried state (these vectorise).
+    std::vector<uint32_t> slotTri(totalSlots), slotKey(totalSlots), slotCounter(totalSlots);
+    for (uint32_t t = 0, s = 0; t < tris.size(); ++t) {
+        for (uint32_t k = 0; k < tris[t].slots; ++k, ++s) {
+            slotTri[s] = t;
+            slotKey[s] = tris[t].key;
+            slotCounter[s] = k * 3u;
+        }
     }
+    std::vector<float> bu(totalSlots), bv(totalSlots), br(totalSlots);
+    for (uint32_t s = 0; s < totalSlots; ++s) {
+        float u = counterRandomFloat(slotKey[s], slotCounter[s] + 0u);
+        float v = counterRandomFloat(slotKey[s], slotCounter[s] + 1u);
+        br[s]   = counterRandomFloat(slotKey[s], slotCounter[s] + 2u);
+        // Fold the unit square onto the triangle (branch-free select).
+        const bool fold = u + v > 1.0f;
+        bu[s] = fold ? 1.0f - u : u;
+        bv[s] = fold ? 1.0f - v : v;
+    }
+
+    // Pass 3: place, filter by biome and write straight into the arena layout.
+    const uint32_t billboardCnt = std::max(1u, job.billboardCount);
+    out.instances.reserve(totalSlots);
+    for (uint32_t s = 0; s < totalSlots; ++s) {
+        const GrassTri& t = tris[slotTri[s]];
+        const glm::vec3 pos = t.v0 + bu[s] * t.e1 + bv[s] * t.e2;
+        const float noise = biomeNoise(glm::vec2(pos.x, pos.z));
+        if (noise < 0.40f) continue; // empty biome — skip entirely
+        const float remapped = (noise - 0.40f) / 0.60f;
+        const uint32_t bi = std::min(uint32_t(remapped * float(billboardCnt)), billboardCnt - 1u);
+        out.instances.emplace_back(pos, float(bi) + br[s]);
+    }
+
+    // Shuffle so reducing the indirect instanceCount keeps a random spatial
+    // subset instead of always dropping the tail.
+    const uint32_t shuffleKey = chunkSeed ^ 0x85ebca6bu;
+    for (size_t i = out.instances.size(); i > 1; --i) {
+        const size_t j = counterRandom(shuffleKey, static_cast<uint32_t>(i)) % i;
+        std::swap(out.instances[i - 1], out.instances[j]);
+    }
+    return out;
+}
+
+void VegetationRenderer::requeueScatteredChunks(std::vector<ScatteredChunk>&& chunks) {
+    // At the back: chunks behind them (releases, smaller uploads) go first,
+    // and may free the space these need.
+    std::lock_guard<std::mutex> lk(scatteredChunksMutex);
+    for (ScatteredChunk& sc : chunks) scatteredChunks.push_back(std::move(sc));
 }
 
 size_t VegetationRenderer::pendingChunkCount() const {
-    std::lock_guard<std::mutex> lk(pendingChunksMutex);
-    return pendingChunks.size();
+    std::lock_guard<std::mutex> lk(scatteredChunksMutex);
+    return scatteredChunks.size() + scatterInFlight.load(std::memory_order_relaxed);
 }
 
-void VegetationRenderer::processPendingChunks(uint32_t maxChunks) {
+void VegetationRenderer::processPendingChunks(VkDeviceSize byteBudget) {
     if (!appPtr) return;
     VulkanApp* app = appPtr;
-    const uint32_t billboardCnt = (billboardCount > 0) ? billboardCount : 1u;
 
-    for (uint32_t n = 0; n < maxChunks; ++n) {
-        PendingChunk pc;
-        {
-            std::lock_guard<std::mutex> lk(pendingChunksMutex);
-            if (pendingChunks.empty()) break;
-            pc = std::move(pendingChunks.front());
-            pendingChunks.pop_front();
+    // Take finished chunks up to the byte budget (at least one per call).
+    uploadBatch.clear();
+    {
+        std::lock_guard<std::mutex> lk(scatteredChunksMutex);
+        VkDeviceSize bytes = 0;
+        while (!scatteredChunks.empty()) {
+            const VkDeviceSize chunkBytes = scatteredChunks.front().instances.size() * sizeof(glm::vec4);
+            if (!uploadBatch.empty() && bytes + chunkBytes > byteBudget) break;
+            bytes += chunkBytes;
+            uploadBatch.push_back(std::move(scatteredChunks.front()));
+            scatteredChunks.pop_front();
         }
-
-        const uint32_t triCount = static_cast<uint32_t>(pc.grassIndices.size()) / 3;
-        const uint32_t instanceCount = triCount * pc.instancesPerTriangle;
-
-        const float maxBillboardRadius = billboardScale * 2.1f; // max heightScale (1.4) × max corner offset (1.5)
-
-        // Compute AABB from vertex positions (conservatively bounds all instance anchors)
-        glm::vec3 aabbMin( std::numeric_limits<float>::max());
-        glm::vec3 aabbMax(-std::numeric_limits<float>::max());
-        for (const auto& pos : pc.positions) {
-            aabbMin = glm::min(aabbMin, pos);
-            aabbMax = glm::max(aabbMax, pos);
+    }
+    if (uploadBatch.empty()) return;
+
+    // All chunks of this call share one staging buffer and one submission;
+    // each records where its instances start.
+    pendingUploads.clear();
+    VkDeviceSize stagingSize = 0;
+    for (const ScatteredChunk& sc : uploadBatch) {
+        auto serialIt = chunkUploadSerial.find(sc.chunkId);
+        if (serialIt == chunkUploadSerial.end() || serialIt->second != sc.serial) continue; // superseded
+        if (sc.instances.empty()) {
+            // No grass left in this chunk; clear its previous vegetation.
+            if (!std::getenv("VULKAN_DISABLE_VEGETATION")) releaseChunkInstances(sc.chunkId, app);
+            continue;
+        }
+        PendingUpload up{};
+        up.chunkId = sc.chunkId;
+        up.serial = sc.serial;
+        up.source = static_cast<uint32_t>(&sc - uploadBatch.data());
+        up.entry.count = static_cast<uint32_t>(sc.instances.size());
+        up.entry.center = sc.center;
+        up.entry.aabbMin = sc.aabbMin;
+        up.entry.aabbMax = sc.aabbMax;
+        up.stagingOffset = stagingSize;
+        stagingSize += VkDeviceSize(up.entry.count) * sizeof(glm::vec4);
+        pendingUploads.push_back(up);
+    }
+    if (pendingUploads.empty()) return;
+
+    // Reserve each chunk's arena span up front. The chunk's current span
+    // stays live (in-flight frames still draw it) until the new one is
+    // published, so a re-upload always takes fresh space.
+    uint32_t batchInstances = 0;
+    for (const PendingUpload& up : pendingUploads) batchInstances += up.entry.count;
+    bool needsGrow = instanceArenaBuffer.buffer == VK_NULL_HANDLE;
+    if (!needsGrow) {
+        for (PendingUpload& up : pendingUploads) {
+            up.entry.firstInstance = instanceArena.allocate(up.entry.count);
+            if (up.entry.firstInstance == UINT32_MAX) { needsGrow = true; break; }
         }
-        aabbMin -= glm::vec3(maxBillboardRadius);
-        aabbMax += glm::vec3(maxBillboardRadius);
-
-        // Reuse frame-thread scratch (clear + reserve) instead of allocating
-        // a fresh vector per processed chunk.
-        instanceGenScratch.clear();
-        instanceGenScratch.reserve(instanceCount * 4);
-        std::vector<float>& validData = instanceGenScratch;
-
-        for (uint32_t tri = 0; tri < triCount; ++tri) {
-            const uint32_t tb = tri * 3;
-            const uint32_t i0 = pc.grassIndices[tb + 0];
-            const uint32_t i1 = pc.grassIndices[tb + 1];
-            const uint32_t i2 = pc.grassIndices[tb + 2];
-            if (i0 >= pc.positions.size() || i1 >= pc.positions.size() || i2 >= pc.positions.size()) continue;
-
-            const glm::vec3 v0 = pc.positions[i0];
-            const glm::vec3 v1 = pc.positions[i1];
-            const glm::vec3 v2 = pc.positions[i2];
-
-            const glm::vec3 fn = glm::cross(v1 - v0, v2 - v0);
-            if (glm::abs(fn.y) <= 0.5f * glm::length(fn)) continue;
-
-            const glm::vec3 tc = (v0 + v1 + v2) / 3.0f;
-            const uint32_t tch = posHash(tc);
-
-            for (uint32_t s = 0; s < pc.instancesPerTriangle; ++s) {
-                uint32_t rng = pc.seed ^ tch ^ (tri * 2654435761u) ^ (s * 19349663u);
-                float u = randFloat(rng);
-                float v = randFloat(rng);
-                if (u + v > 1.0f) { u = 1.0f - u; v = 1.0f - v; }
-                float w = 1.0f - u - v;
-                glm::vec3 pos = u * v0 + v * v1 + w * v2;
-
-                // Biome from spatially-coherent noise.
-                float noise = biomeNoise(glm::vec2(pos.x, pos.z));
-                if (noise < 0.40f) continue; // empty biome — skip entirely
-
-                float remapped = (noise - 0.40f) / 0.60f;
-                uint32_t bi = std::min(uint32_t(remapped * float(billboardCnt)), billboardCnt - 1u);
-
-                uint32_t rs = pc.seed ^ posHash(pos);
-                float rf = randFloat(rs);
-
-                validData.push_back(pos.x);
-                validData.push_back(pos.y);
-                validData.push_back(pos.z);
-                validData.push_back(float(bi) + rf);
+        if (needsGrow) {
+            for (PendingUpload& up : pendingUploads) {
+                if (up.entry.firstInstance == UINT32_MAX) break;
+                instanceArena.free(up.entry.firstInstance, up.entry.count);
+                up.entry.firstInstance = UINT32_MAX;
             }
         }
+    }
 
-        const uint32_t validCount = static_cast<uint32_t>(validData.size() / 4);
-        if (validCount == 0) {
-            destroyInstanceBuffer(pc.chunkId, app);
-            continue;
+    // Chunks kept until the arena has grown: when it cannot, they are
+    // queued again rather than dropped.
+    std::vector<ScatteredChunk> retry;
+    auto takeRetry = [&]() {
+        retry.reserve(pendingUploads.size());
+        for (const PendingUpload& up : pendingUploads) retry.push_back(std::move(uploadBatch[up.source]));
+        uploadBatch.clear();
+    };
+    // At the size cap the batch only fits once releases free spans, so skip
+    // the copy submission that could not land.
+    if (needsGrow && uint64_t(instanceArena.total()) + batchInstances > INSTANCE_ARENA_MAX) {
+        if (!arenaFullReported) {
+            std::cerr << "[veg] instance arena full, deferring " << pendingUploads.size() << " chunk uploads\n";
+            arenaFullReported = true;
         }
+        takeRetry();
+        requeueScatteredChunks(std::move(retry));
+        return;
+    }
 
-        const VkDeviceSize bufSize = validData.size() * sizeof(float);
+    // Staging buffer: host-visible, filled by CPU.
+    Buffer staging = app->createBuffer(stagingSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    void* mapped = staging.map(0);
+    if (!mapped) {
+        app->destroyBuffer(staging);
+        for (const PendingUpload& up : pendingUploads)
+            if (!needsGrow) instanceArena.free(up.entry.firstInstance, up.entry.count);
+        takeRetry();
+        requeueScatteredChunks(std::move(retry));
+        return;
+    }
+    for (const PendingUpload& up : pendingUploads) {
+        const std::vector<glm::vec4>& src = uploadBatch[up.source].instances;
+        std::memcpy(static_cast<char*>(mapped) + up.stagingOffset, src.data(), src.size() * sizeof(glm::vec4));
+    }
+    if (needsGrow) takeRetry();
+    uploadBatch.clear();
+    staging.unmap(); // VMA persistent mapping
 
-        // Staging buffer: host-visible, filled by CPU.
-        Buffer stagingInst = app->createBuffer(bufSize,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        void* mapped = nullptr;
-        mapped = stagingInst.map(0);
-        std::memcpy(mapped, validData.data(), size_t(bufSize));
-        stagingInst.unmap(); // VMA persistent mapping
-
-        // Device-local instance buffer: GPU reads via vertex input.
-        // On RADV iGPUs, vertex reads go through TCP (Texture Cache/Pipe),
-        // and host-visible pages lack TCP-read permission → GPUVM fault.
-        // zeroInit=false: fully overwritten by the staging copy before use.
-        Buffer instBuf = app->createBuffer(bufSize,
-            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false);
-
-        // Indirect buffer: device-local, avoids same TCP-read issue.
-        Buffer indirect = app->createBuffer(sizeof(VkDrawIndexedIndirectCommand),
-            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false);
-
-        // Staging for indirect draw command.
-        Buffer stagingIndirect = app->createBuffer(sizeof(VkDrawIndexedIndirectCommand),
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        VkDrawIndexedIndirectCommand drawCmd{};
-        drawCmd.indexCount    = 36;
-        drawCmd.instanceCount = validCount;
-        drawCmd.firstIndex    = 0;
-        drawCmd.vertexOffset  = 0;
-        drawCmd.firstInstance = 0;
-        void* idata = nullptr;
-        idata = stagingIndirect.map(0);
-        std::memcpy(idata, &drawCmd, sizeof(VkDrawIndexedIndirectCommand));
-        stagingIndirect.unmap(); // VMA persistent mapping
-
-        pendingBatch.push_back({ stagingInst, instBuf, stagingIndirect, indirect,
-                                 bufSize, pc.chunkId, validCount,
-                                 aabbMin, aabbMax, pc.chunkCenter });
-    }
-
-    // Flush all batched copies in a single async submission.
-    // The deferred callback publishes chunks when the GPU is done.
-    if (!pendingBatch.empty()) {
-        std::vector<PendingBatchCopy> batch = std::move(pendingBatch);
-        VkFence fence = app->runSingleTimeCommandsAsync([&](VkCommandBuffer cmd) {
-            for (auto& c : batch) {
-                VkBufferCopy cr{};
-                cr.size = c.bufSize;
-                vkCmdCopyBuffer(cmd, c.stagingInst.buffer, c.instBuf.buffer, 1, &cr);
-                VkBufferCopy icr{};
-                icr.size = sizeof(VkDrawIndexedIndirectCommand);
-                vkCmdCopyBuffer(cmd, c.stagingIndirect.buffer, c.indirect.buffer, 1, &icr);
-            }
-        });
-        app->deferDestroyUntilFence(fence, [this, app,
-                                             batch = std::move(batch)]() mutable {
-            for (auto& c : batch) {
-                app->destroyBuffer(c.stagingInst);
-                app->destroyBuffer(c.stagingIndirect);
-
-                destroyInstanceBuffer(c.chunkId, app);
-
-                InstanceBuffer ibuf;
-                ibuf.buffer         = c.instBuf.buffer;
-                ibuf.memory         = c.instBuf.memory;
-                ibuf.allocation     = c.instBuf.allocation;
-                ibuf.indirectBuffer = c.indirect.buffer;
-                ibuf.indirectMemory = c.indirect.memory;
-                ibuf.indirectAllocation = c.indirect.allocation;
-                ibuf.center         = c.center;
-                ibuf.aabbMin        = c.aabbMin;
-                ibuf.aabbMax        = c.aabbMax;
-                ibuf.count          = c.instanceCount;
-                chunkBuffers[c.chunkId] = ibuf;
-                chunkInstanceCounts[c.chunkId] = c.instanceCount;
-                vegConsolidationDirty = true;
+    std::vector<PendingUpload> batch = pendingUploads;
+    bool recorded = true;
+    VkFence fence = app->runSingleTimeCommandsAsync([&](VkCommandBuffer cmd) {
+        if (needsGrow) {
+            if (!growInstanceArena(app, cmd, batchInstances)) { recorded = false; return; }
+            for (PendingUpload& up : batch) up.entry.firstInstance = instanceArena.allocate(up.entry.count);
+        }
+        // WRITE-AFTER-READ guard: other spans of the arena are read as
+        // vertex attributes by in-flight frames. ALL_COMMANDS srcStage
+        // covers the full draw-pipeline span sync validation attributes
+        // vertex-attribute reads to. The written spans themselves are free.
+        VkMemoryBarrier2 mb{ VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+        mb.srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        mb.srcAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        mb.dstStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+        mb.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        VkDependencyInfo dep{ VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+        dep.memoryBarrierCount = 1;
+        dep.pMemoryBarriers    = &mb;
+        vkCmdPipelineBarrier2(cmd, &dep);
+
+        std::vector<VkBufferCopy> regions;
+        regions.reserve(batch.size());
+        for (const PendingUpload& up : batch) {
+            if (up.entry.firstInstance == UINT32_MAX) continue;
+            VkBufferCopy cr{};
+            cr.srcOffset = up.stagingOffset;
+            cr.dstOffset = VkDeviceSize(up.entry.firstInstance) * sizeof(glm::vec4);
+            cr.size = VkDeviceSize(up.entry.count) * sizeof(glm::vec4);
+            regions.push_back(cr);
+        }
+        if (!regions.empty())
+            vkCmdCopyBuffer(cmd, staging.buffer, instanceArenaBuffer.buffer,
+                            static_cast<uint32_t>(regions.size()), regions.data());
+    });
+    if (!recorded) {
+        std::cerr << "[veg] instance arena could not grow by " << batchInstances << " instances, retrying batch\n";
+        requeueScatteredChunks(std::move(retry));
+    } else {
+        arenaFullReported = false;
+    }
+
+    // Publish when the copy has completed: the chunk's table entry is
+    // replaced in place and its previous span freed once no frame reads it.
+    app->deferDestroyUntilFence(fence, [this, app, staging, recorded,
+                                         batch = std::move(batch)]() mutable {
+        Buffer tmp = staging;
+        app->destroyBuffer(tmp);
+        if (!recorded) return;
+        for (const PendingUpload& up : batch) {
+            if (up.entry.firstInstance == UINT32_MAX) continue;
+            auto it = chunkUploadSerial.find(up.chunkId);
+            if (it == chunkUploadSerial.end() || it->second != up.serial) {
+                // Superseded or released while the copy was in flight
+                instanceArena.free(up.entry.firstInstance, up.entry.count);
+                continue;
             }
+            publishChunkInstances(up.chunkId, up.entry, app);
+        }
+    });
+}
+
+bool VegetationRenderer::growInstanceArena(VulkanApp* app, VkCommandBuffer cmd, uint32_t needed) {
+    uint64_t target = std::max<uint64_t>(INSTANCE_ARENA_INITIAL, uint64_t(instanceArena.total()) * 2);
+    // The appended tail alone must hold the whole batch.
+    while (target < uint64_t(instanceArena.total()) + needed) target *= 2;
+    if (target > INSTANCE_ARENA_MAX) {
+        target = INSTANCE_ARENA_MAX;
+        if (uint64_t(instanceArena.total()) + needed > target) return false;
+    }
+
+    Buffer old = instanceArenaBuffer;
+    // zeroInit=false: only spans written by uploads are ever drawn.
+    Buffer grown = app->createBuffer(target * sizeof(glm::vec4),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false);
+    if (grown.buffer == VK_NULL_HANDLE) return false;
+
+    if (old.buffer != VK_NULL_HANDLE && instanceArena.total() > 0) {
+        // Earlier uploads into the old arena may still be executing.
+        VkMemoryBarrier2 mb{ VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+        mb.srcStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+        mb.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        mb.dstStageMask  = VK_PIPELINE_STAGE_2_COPY_BIT;
+        mb.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+        VkDependencyInfo dep{ VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+        dep.memoryBarrierCount = 1;
+        dep.pMemoryBarriers    = &mb;
+        vkCmdPipelineBarrier2(cmd, &dep);
+
+        VkBufferCopy region{};
+        region.size = VkDeviceSize(instanceArena.total()) * sizeof(glm::vec4);
+        vkCmdCopyBuffer(cmd, old.buffer, grown.buffer, 1, &region);
+        app->deferDestroyUntilAllPending([app, old]() {
+            Buffer tmp = old;
+            app->destroyBuffer(tmp);
         });
     }
+    instanceArenaBuffer = grown;
+    instanceArena.grow(static_cast<uint32_t>(target));
+    std::cerr << "[veg] instance arena grew to " << target << " instances ("
+              << (target * sizeof(glm::vec4)) / (1024 * 1024) << " MB)\n";
+    return true;
 }
 
-void VegetationRenderer::destroyInstanceBuffer(NodeID chunkId, VulkanApp* app, VkFence completionFence) {
-    auto it = chunkBuffers.find(chunkId);
-    if (it == chunkBuffers.end()) return;
-
-    // Snatch the old Vulkan handles before clearing the map entry.
-    InstanceBuffer old = it->second;
-    it->second.buffer = VK_NULL_HANDLE;
-    it->second.memory = VK_NULL_HANDLE;
-    it->second.indirectBuffer = VK_NULL_HANDLE;
-    it->second.indirectMemory = VK_NULL_HANDLE;
-    chunkBuffers.erase(it);
-    chunkInstanceCounts.erase(chunkId);
+void VegetationRenderer::publishChunkInstances(NodeID chunkId, const ChunkInstances& entry, VulkanApp* app) {
+    auto it = chunkTableIndex.find(chunkId);
+    if (it != chunkTableIndex.end()) {
+        ChunkInstances& slot = chunkTable[it->second];
+        freeInstanceSpan(slot.firstInstance, slot.count, app);
+        instanceTotal -= slot.count;
+        slot = entry;
+    } else {
+        chunkTableIndex[chunkId] = static_cast<uint32_t>(chunkTable.size());
+        chunkTable.push_back(entry);
+        chunkTableIds.push_back(chunkId);
+    }
+    instanceTotal += entry.count;
+}
 
-    if (!app) return;
+void VegetationRenderer::releaseChunkInstances(NodeID chunkId, VulkanApp* app) {
+    // Any upload of this chunk still in flight is now stale.
+    auto serialIt = chunkUploadSerial.find(chunkId);
+    if (serialIt != chunkUploadSerial.end()) serialIt->second = nextUploadSerial++;
+
+    auto it = chunkTableIndex.find(chunkId);
+    if (it == chunkTableIndex.end()) return;
+    const uint32_t index = it->second;
+    const ChunkInstances old = chunkTable[index];
+    chunkTableIndex.erase(it);
+
+    // Swap-remove keeps the table dense for the culls.
+    const uint32_t last = static_cast<uint32_t>(chunkTable.size() - 1);
+    if (index != last) {
+        chunkTable[index] = chunkTable[last];
+        chunkTableIds[index] = chunkTableIds[last];
+        chunkTableIndex[chunkTableIds[index]] = index;
+    }
+    chunkTable.pop_back();
+    chunkTableIds.pop_back();
+    instanceTotal -= old.count;
+
+    freeInstanceSpan(old.firstInstance, old.count, app);
+}
 
-    // Defer destruction until the provided fence signals (or until all
-    // pending work completes if VK_NULL_HANDLE). The old instance buffer
-    // may still be referenced by previously-submitted render command
-    // buffers on the graphics queue — waiting only on the compute/copy
-    // dispatch fence is insufficient.
-    app->deferDestroyUntilFence(completionFence, [app, old]() {
-        {
-            Buffer tmpBuf{};
-            tmpBuf.buffer = old.buffer;
-            tmpBuf.memory = old.memory;
-            tmpBuf.allocation = old.allocation;
-            app->destroyBuffer(tmpBuf);
-        }
-        {
-            Buffer tmpBuf{};
-            tmpBuf.buffer = old.indirectBuffer;
-            tmpBuf.memory = old.indirectMemory;
-            tmpBuf.allocation = old.indirectAllocation;
-            app->destroyBuffer(tmpBuf);
-        }
+void VegetationRenderer::freeInstanceSpan(uint32_t offset, uint32_t count, VulkanApp* app) {
+    if (!app) {
+        instanceArena.free(offset, count);
+        return;
+    }
+    // The span may still be referenced by previously-submitted render
+    // command buffers; reuse it only after they have all completed.
+    app->deferDestroyUntilAllPending([this, offset, count]() {
+        instanceArena.free(offset, count);
     });
 }
 
@@ -2108,100 +1920,35 @@ void VegetationRenderer::destroyInstanceBuffer(NodeID chunkId, VulkanApp* app, V
 // (cleanup() already clears handles; set appPtr to nullptr here)
 
 void VegetationRenderer::generateForChunk(VulkanApp* app, NodeID nid, const Geometry& geom) {
+    (void)app; // uploads go through appPtr in processPendingChunks
     if (geom.indices.size() < 3 || geom.vertices.empty()) return;
-    try {
-        constexpr int kGrassBrushIndex = 3; // See LandBrush::grass
-        // Instances per world-space unit² of triangle area.
-        constexpr float kVegetationDensity = 0.01f;
-
-        // Create tightly-packed position buffer (vec3[]) for the compute shader
-        std::vector<glm::vec3> positions;
-        positions.reserve(geom.vertices.size());
-        for (const auto &v : geom.vertices) positions.push_back(v.position);
-
-        // Build area-weighted virtual slots using unbiased stochastic rounding.
-        // expected = area * density (instances per world-space unit area)
-        // count = floor(expected) + Bernoulli(frac(expected))
-        // This preserves area-proportional density without bias.
-        std::vector<uint32_t> grassIndices;
-        grassIndices.reserve(geom.indices.size());
-        const uint32_t chunkSeed = static_cast<uint32_t>(nid ^ (nid >> 32)) ^ 0x9e3779b9u;
-        std::mt19937 samplingRng(chunkSeed);
-        std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
-        for (size_t i = 0; i + 2 < geom.indices.size(); i += 3) {
-            const uint32_t i0 = geom.indices[i + 0];
-            const uint32_t i1 = geom.indices[i + 1];
-            const uint32_t i2 = geom.indices[i + 2];
-            if (i0 >= geom.vertices.size() || i1 >= geom.vertices.size() || i2 >= geom.vertices.size()) continue;
-            const bool hasGrass =
-                geom.vertices[i0].brushIndex == kGrassBrushIndex ||
-                geom.vertices[i1].brushIndex == kGrassBrushIndex ||
-                geom.vertices[i2].brushIndex == kGrassBrushIndex;
-            if (!hasGrass) continue;
-            const glm::vec3& v0 = geom.vertices[i0].position;
-            const glm::vec3& v1 = geom.vertices[i1].position;
-            const glm::vec3& v2 = geom.vertices[i2].position;
-            // Skip steep / downward-facing triangles (same criterion as compute shader).
-            // This avoids allocating output slots that the compute shader would discard,
-            // preventing garbage uninitialized memory from reaching the draw call.
-            const glm::vec3 faceNormal = glm::cross(v1 - v0, v2 - v0);
-            if (glm::abs(faceNormal.y) <= 0.5f * glm::length(faceNormal)) continue;
-            const float area = 0.5f * glm::length(faceNormal);
-            const float expectedInstances = std::max(0.0f, area * kVegetationDensity);
-            uint32_t slotCount = static_cast<uint32_t>(std::floor(expectedInstances));
-            const float fractional = expectedInstances - static_cast<float>(slotCount);
-            if (unitDist(samplingRng) < fractional) {
-                ++slotCount;
-            }
-            for (uint32_t s = 0; s < slotCount; ++s) {
-                grassIndices.push_back(i0);
-                grassIndices.push_back(i1);
-                grassIndices.push_back(i2);
-            }
-        }
-
-        // Shuffle virtual triangle slots per chunk so reducing indirect instanceCount
-        // keeps a random spatial subset instead of always dropping the tail.
-        if (grassIndices.size() >= 6) {
-            std::mt19937 shuffleRng(chunkSeed ^ 0x85ebca6bu);
-            const size_t triangleCount = grassIndices.size() / 3;
-            for (size_t slot = triangleCount - 1; slot > 0; --slot) {
-                std::uniform_int_distribution<size_t> dist(0, slot);
-                const size_t other = dist(shuffleRng);
-                if (other == slot) continue;
-                for (size_t component = 0; component < 3; ++component) {
-                    std::swap(grassIndices[slot * 3 + component], grassIndices[other * 3 + component]);
-                }
-            }
-        }
-
-        // Each virtual triangle slot produces exactly 1 instance.
-        uint32_t instancesPerTriangle = 1u;
-        uint32_t seed = static_cast<uint32_t>(nid & 0xffffffffull);
-        glm::vec3 chunkCenter(0.0f);
-        for (const auto& position : positions) {
-            chunkCenter += position;
-        }
-        if (!positions.empty()) {
-            chunkCenter /= static_cast<float>(positions.size());
-        }
-        if (grassIndices.size() < 3) {
-            // No grass triangles in this chunk; ensure old chunk vegetation is cleared.
-            if (std::getenv("VULKAN_DISABLE_VEGETATION")) {
-                return;
-            }
-            // CPU path handles the empty case (clears any previous chunk data).
-            generateChunkInstancesCPU(nid, positions, grassIndices,
-                chunkCenter, instancesPerTriangle, app, seed);
+    // The serial is assigned here, in publish order, so a slower earlier job
+    // for the same chunk can never overwrite a newer one.
+    const uint64_t serial = nextUploadSerial++;
+    chunkUploadSerial[nid] = serial;
+
+    auto job = std::make_shared<ScatterJob>();
+    job->chunkId = nid;
+    job->serial = serial;
+    job->vertices = geom.vertices;
+    job->indices = geom.indices;
+    job->billboardCount = billboardCount;
+    job->billboardScale = billboardScale;
+    scatterInFlight.fetch_add(1, std::memory_order_relaxed);
+    scatterPool.enqueueDetached([this, job]() {
+        ScatteredChunk result;
+        try {
+            result = scatterChunk(*job);
+        } catch (const std::exception &e) {
+            std::cerr << "[VegetationRenderer] Vegetation generation failed for node " << (unsigned long long)job->chunkId
+                      << ": " << e.what() << std::endl;
+            scatterInFlight.fetch_sub(1, std::memory_order_relaxed);
             return;
         }
-
-        // CPU-side instance generation — avoids RADV GPUVM faults where
-        // the Texture Cache/Pipe cannot read storage buffers on iGPUs.
-        generateChunkInstancesCPU(nid, positions, grassIndices,
-            chunkCenter, instancesPerTriangle, app, seed);
-    } catch (const std::exception &e) {
-        std::cerr << "[VegetationRenderer] Vegetation generation failed for node " << (unsigned long long)nid
-                  << ": " << e.what() << std::endl;
-    }
+        {
+            std::lock_guard<std::mutex> lk(scatteredChunksMutex);
+            scatteredChunks.push_back(std::move(result));
+        }
+        scatterInFlight.fetch_sub(1, std::memory_order_relaxed);
+    });
 }
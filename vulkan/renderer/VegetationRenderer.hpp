@@ -16,11 +16,15 @@
 #include <unordered_map>
 #include <array>
 #include <mutex>
+#include <atomic>
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <glm/gtc/round.hpp>
 #include "CommandBufferState.hpp"
+#include "InstanceArena.hpp"
+#include "../../space/ThreadPool.hpp"
 
-// Per-chunk vegetation instance buffer and renderer
+// Vegetation renderer: per-chunk instances pooled in one instance arena
 class VegetationRenderer : public Renderer {
 public:
     struct WindSettings {
@@ -43,8 +47,17 @@ public:
         float windEnabled = 1.0f;
         float windTime = 0.0f;
         float impostorDistance = 0.0f;
+        // BindlessHeap slots, mirrored by shaders/includes/vegetation_params.glsl
+        uint32_t windParamsBuffer = BindlessHeap::INVALID_INDEX;
+        uint32_t albedoTexture = BindlessHeap::INVALID_INDEX;
+        uint32_t normalTexture = BindlessHeap::INVALID_INDEX;
+        uint32_t opacityTexture = BindlessHeap::INVALID_INDEX;
+        uint32_t impostorTexture = BindlessHeap::INVALID_INDEX;
+        uint32_t impostorNormalTexture = BindlessHeap::INVALID_INDEX;
+        uint32_t impostorDepthTexture = BindlessHeap::INVALID_INDEX;
+        uint32_t captureInvVPBuffer = BindlessHeap::INVALID_INDEX;
     };
-    static_assert(sizeof(WindPushConstants) == 16, "WindPushConstants expected 16 bytes");
+    static_assert(sizeof(WindPushConstants) == 48, "WindPushConstants expected 48 bytes");
 
     struct DistanceDensitySettings {
         bool enabled = true;
@@ -58,35 +71,29 @@ public:
     explicit VegetationRenderer();
     ~VegetationRenderer();
 
-    void setTextureArrayManager(TextureArrayManager* mgr, VulkanApp* app);
     void setBillboardArrayTextures(VkImageView albedoView, VkImageView normalView, VkImageView opacityView, VkSampler sampler, VulkanApp* app);
-    void onTextureArraysReallocated(VulkanApp* app);
     void init();
     void cleanup(VulkanApp* app) override;
     void init(VulkanApp* app);
-    // CPU-side instance generation — avoids GPUVM faults on RADV iGPUs where
-    // the Texture Cache/Pipe cannot read from device-local or host-visible
-    // storage buffers.  Enqueues the chunk and processes up to maxPerFrame
-    // chunks each frame via processPendingChunks().  With no grass triangles
-    // the chunk's previous instance data is cleared instead.
-    void generateChunkInstancesCPU(NodeID chunkId,
-                                   const std::vector<glm::vec3>& positions,
-                                   const std::vector<uint32_t>& grassIndices,
-                                   const glm::vec3& chunkCenter,
-                                   uint32_t instancesPerTriangle, VulkanApp* app,
-                                   uint32_t seed = 1337);
-    // CPU-side per-chunk vegetation generation (moved from SceneRenderer).
-    // Samples grass-flagged triangles from the chunk's tessellated geometry,
-    // builds area-weighted virtual triangle slots with unbiased stochastic
-    // rounding (area-proportional density without bias), shuffles the slots
-    // per chunk (so reducing the indirect instanceCount keeps a random spatial
-    // subset), then hands the result to generateChunkInstancesCPU. With no
-    // grass triangles the chunk's previous instance data is cleared instead.
+    // Shading, depth and EVSM shadow pipelines on the scene layouts;
+    // declared as a PipelineRegistry builder.
+    void createPipelines(VulkanApp* app);
+    // CPU-side per-chunk vegetation generation. Copies the chunk's finest
+    // geometry and hands it to the scatter worker pool; the render thread
+    // does no per-triangle work. The worker picks grass-flagged triangles,
+    // builds area-weighted slots with unbiased stochastic rounding, scatters
+    // one instance per slot and shuffles the result (so reducing the indirect
+    // instanceCount keeps a random spatial subset). All random draws come
+    // from a counter-based RNG keyed by the chunk seed and triangle position,
+    // so results are deterministic regardless of scheduling. With no grass
+    // triangles the chunk's previous instance data is cleared instead.
     void generateForChunk(VulkanApp* app, NodeID nid, const Geometry& geom);
-    // Drain up to maxChunks from the pending queue.  Call every frame from
-    // draw() so chunks trickle in at a controlled rate.
-    void processPendingChunks(uint32_t maxChunks);
-    // Number of chunks still waiting in the queue.
+    // Upload scattered chunks until `byteBudget` bytes of instance data have
+    // been staged (at least one chunk per call). Call every frame, outside
+    // rendering, before the frame's read barriers.
+    static constexpr VkDeviceSize UPLOAD_BYTES_PER_FRAME = 4ull << 20; // 256K instances
+    void processPendingChunks(VkDeviceSize byteBudget = UPLOAD_BYTES_PER_FRAME);
+    // Chunks being scattered or waiting for upload.
     size_t pendingChunkCount() const;
     void clearAllInstances();
 
@@ -112,7 +119,7 @@ public:
     PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCount = nullptr;
 
     // Stats helpers
-    size_t getChunkCount() const { return chunkInstanceCounts.size(); }
+    size_t getChunkCount() const { return chunkTable.size(); }
     size_t getInstanceTotal() const;
 
     WindSettings& getWindSettings() { return windSettings; }
@@ -125,9 +132,9 @@ public:
     float getAverageDensityFactor(const glm::vec3& cameraPos) const;
 
     // Impostor rendering.  Call after init() once impostor views have been captured.
-    // albedoArray60 and normalArray60 must be VkImageView covering 60 layers
-    // (3 billboard types × 20 Fibonacci views).
-    // depthArray60 is the captured device Z array (R32_SFLOAT, 60 layers) for depth reprojection.
+    // albedoArray60 and normalArray60 must be VkImageView covering every
+    // capture layer (3 billboard types × views per type, see setImpostorViewLayout).
+    // depthArray60 is the captured device Z array (R32_SFLOAT, same layers) for depth reprojection.
     // captureInvVPBuf is a storage buffer containing per-layer inverse VP matrices.
     void setImpostorData(VulkanApp* app,
                          VkImageView albedoArray60,
@@ -140,10 +147,11 @@ public:
     // Set to 0 (default) to disable impostor rendering entirely.
     void setImpostorDistance(float dist) { impostorDistance = dist; }
 
-    // Build the concatenated instance buffer and per-chunk metadata for GPU
-    // frustum culling. Must be called once after all chunks are generated.
-    // Uses a temporary command buffer (synchronous, one-time cost).
-    void consolidateChunks(VulkanApp* app);
+    // View layout of the impostor capture arrays (see ImpostorCapture):
+    // `octahedralGrid` = 0 selects the Fibonacci views.
+    void setImpostorViewLayout(uint32_t octahedralGrid, uint32_t viewsPerType) {
+        impostorParams = glm::vec4(float(octahedralGrid), float(viewsPerType), 0.0f, 0.0f);
+    }
 
     // GPU frustum culling: dispatch compute shader that culls chunks against
     // viewProj and compacts visible draw commands. Must be called OUTSIDE any
@@ -160,17 +168,26 @@ public:
                            VkDescriptorSet shadowDescriptorSet,
                            const glm::vec3& cameraPos,
                            uint32_t cascadeIndex);
+    // drawShadowCascade split in two for parallel cascade recording:
+    // prepareShadowCascades() runs once per frame on the main thread (may
+    // allocate the vegetation descriptor set and writes the wind UBO);
+    // recordShadowCascade() only records commands and is safe to call from a
+    // worker thread with state == nullptr. Returns the draw commands recorded.
+    bool prepareShadowCascades(VulkanApp* app, const glm::vec3& cameraPos);
+    uint32_t recordShadowCascade(VkCommandBuffer commandBuffer,
+                             VkDescriptorSet shadowDescriptorSet,
+                             uint32_t cascadeIndex,
+                             CommandBufferState* state);
 
     // Update the wind params UBO with current settings.
     // Must be called before any draw that uses wind.  Updates per-frame values
     // (camera position, falloff) so windParams on the GPU stays in sync.
     void updateWindParamsUBO(const glm::vec3& cameraPos);
 
-    // Shared set=2 wind params resources. Other consumers of the vegetation
-    // shader family (e.g. ImpostorCapture) bind the same layout + descriptor
-    // set instead of duplicating them.
-    VkDescriptorSetLayout getWindParamsDescSetLayout() const { return windParamsDescSetLayout; }
-    VkDescriptorSet getWindParamsDescSet() const { return windParamsDescSet; }
+    // BindlessHeap slot of the wind params buffer. Other consumers of the
+    // vegetation shader family (e.g. ImpostorCapture) pass the same slot in
+    // their push constants instead of duplicating the buffer.
+    uint32_t getWindParamsSlot() const { return windParamsSlot; }
 
 private:
     
@@ -180,48 +197,94 @@ private:
     TrackedHandle<VkPipelineLayout> pipelineLayout;
     TrackedHandle<VkPipeline> vegetationShadowPipeline;
     TrackedHandle<VkPipelineLayout> shadowPipelineLayout;
-    TrackedHandle<VkDescriptorSetLayout> descriptorSetLayout;
-    TextureArrayManager* vegetationTextureArrayManager = nullptr;
     VkImageView billboardAlbedoView   = VK_NULL_HANDLE;
     VkImageView billboardNormalView   = VK_NULL_HANDLE;
     VkImageView billboardOpacityView  = VK_NULL_HANDLE;
     TrackedHandle<VkSampler> billboardArraySampler;
 
-    // Descriptor set allocated from the app's descriptor pool and re-created when the texture arrays are (re)allocated
-    TrackedHandle<VkDescriptorSet> vegDescriptorSet;
-    uint32_t vegDescriptorVersion = 0;
-    bool ensureVegDescriptorSet(VulkanApp* app);
-    // Listener id returned from TextureArrayManager::addAllocationListener(), -1 if none
-    int vegTextureListenerId = -1;
-
-    struct InstanceBuffer {
-        VkBuffer buffer = VK_NULL_HANDLE;
-        VkDeviceMemory memory = VK_NULL_HANDLE;
-        VmaAllocation allocation = VK_NULL_HANDLE;
-        VkBuffer indirectBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory indirectMemory = VK_NULL_HANDLE;
-        VmaAllocation indirectAllocation = VK_NULL_HANDLE;
+    // Billboard arrays live in the app's BindlessHeap and are addressed
+    // through WindPushConstants. New views register fresh slots and release
+    // the old ones after in-flight frames, so no descriptor set is ever freed
+    // or rebuilt.
+    uint32_t albedoSlot  = BindlessHeap::INVALID_INDEX;
+    uint32_t normalSlot  = BindlessHeap::INVALID_INDEX;
+    uint32_t opacitySlot = BindlessHeap::INVALID_INDEX;
+    bool ensureBillboardSlots(VulkanApp* app);
+    void releaseBillboardSlots(VulkanApp* app);
+    void releaseImpostorSlots(VulkanApp* app);
+
+    // ── Instance arena ──
+    // All chunks' instances (one vec4 each) live in a single device-local
+    // buffer. InstanceArena hands every chunk a span sized to its instance
+    // count and uploads copy straight into that span, so there is no
+    // per-chunk VkBuffer and no consolidation pass. The arena grows by
+    // reallocation + GPU copy; offsets never change.
+    //
+    // chunkTable is the dense chunk list the culls read (draw command i /
+    // chunk-info entry i = chunkTable[i]). Entries are updated in place on
+    // re-upload and swap-removed on release.
+    struct ChunkInstances {
+        uint32_t firstInstance = 0;
+        uint32_t count = 0;
         glm::vec3 center = glm::vec3(0.0f);
         glm::vec3 aabbMin = glm::vec3(0.0f);
         glm::vec3 aabbMax = glm::vec3(0.0f);
-        size_t count = 0;
     };
-    std::unordered_map<NodeID, InstanceBuffer> chunkBuffers;
-    std::unordered_map<NodeID, size_t> chunkInstanceCounts;
-    void destroyInstanceBuffer(NodeID chunkId, VulkanApp* app = nullptr, VkFence completionFence = VK_NULL_HANDLE);
-
-    // Pending CPU-generation queue — chunks are enqueued by the scene loader
-    // and drained 10-per-frame by draw().
-    struct PendingChunk {
+    static constexpr uint32_t INSTANCE_ARENA_INITIAL = 1u << 18; // instances (4 MB)
+    // The GPU chunk table stores firstInstance as a float (exact to 2^24).
+    static constexpr uint64_t INSTANCE_ARENA_MAX = 1ull << 24;
+    Buffer instanceArenaBuffer;
+    InstanceArena instanceArena;
+    std::vector<ChunkInstances> chunkTable;
+    std::vector<NodeID> chunkTableIds;                   // parallel to chunkTable
+    std::unordered_map<NodeID, uint32_t> chunkTableIndex;
+    size_t instanceTotal = 0;
+    // Latest upload serial per chunk. An upload is published only if it is
+    // still the chunk's latest when its copy completes; releases bump the
+    // serial so an in-flight upload of a removed chunk is dropped.
+    std::unordered_map<NodeID, uint64_t> chunkUploadSerial;
+    uint64_t nextUploadSerial = 1;
+    // Remove a chunk from the table; its span is freed once in-flight frames
+    // no longer read it.
+    void releaseChunkInstances(NodeID chunkId, VulkanApp* app);
+    void freeInstanceSpan(uint32_t offset, uint32_t count, VulkanApp* app);
+    void publishChunkInstances(NodeID chunkId, const ChunkInstances& entry, VulkanApp* app);
+    // Grow the arena so `needed` more elements can be allocated. Records the
+    // copy of the old contents into `cmd` and defers the old buffer's
+    // destruction. Returns false when the buffer could not be created.
+    bool growInstanceArena(VulkanApp* app, VkCommandBuffer cmd, uint32_t needed);
+    // Size the per-frame compacted command buffers for the current chunk count.
+    void ensureCullBuffers(VulkanApp* app);
+
+    // Scatter pipeline: generateForChunk() queues a ScatterJob on
+    // scatterPool; the worker's ScatteredChunk (instances already in arena
+    // layout) waits in scatteredChunks until processPendingChunks() uploads
+    // it. The job carries the chunk's upload serial, so a result overtaken by
+    // a newer job, a release or a scene reset is dropped unread.
+    struct ScatterJob {
+        NodeID chunkId;
+        uint64_t serial;
+        std::vector<Vertex> vertices;
+        std::vector<uint> indices;
+        uint32_t billboardCount;
+        float billboardScale;
+    };
+    struct ScatteredChunk {
         NodeID chunkId;
-        std::vector<glm::vec3> positions;
-        std::vector<uint32_t> grassIndices;
-        glm::vec3 chunkCenter;
-        uint32_t instancesPerTriangle;
-        uint32_t seed;
+        uint64_t serial;
+        std::vector<glm::vec4> instances;
+        glm::vec3 center;
+        glm::vec3 aabbMin;
+        glm::vec3 aabbMax;
     };
-    std::deque<PendingChunk> pendingChunks;
-    mutable std::mutex pendingChunksMutex;
+    static ScatteredChunk scatterChunk(const ScatterJob& job);
+    std::deque<ScatteredChunk> scatteredChunks;
+    mutable std::mutex scatteredChunksMutex;
+    std::atomic<size_t> scatterInFlight{0};
+    // Queue chunks whose upload did not fit in the arena again; they keep
+    // their serial (and their current span stays drawn) until one succeeds.
+    void requeueScatteredChunks(std::vector<ScatteredChunk>&& chunks);
+    bool arenaFullReported = false;
     // If the renderer was initialized with an app, this will be set and
     // allows immediate compute-based generation calls to run against the
     // provided `VulkanApp` instance.
@@ -243,31 +306,29 @@ private:
     // Impostor pipeline resources (populated via setImpostorData).
     TrackedHandle<VkPipeline> impostorPipeline;
     TrackedHandle<VkPipelineLayout> impostorPipelineLayout;
-    TrackedHandle<VkDescriptorSetLayout> impostorDescSetLayout;
-    TrackedHandle<VkDescriptorPool> impostorDescPool;
-    TrackedHandle<VkDescriptorSet> impostorDescSet;
 
     // Impostor depth pipeline (shadow map depth-only pass).
     TrackedHandle<VkPipeline> impostorDepthPipeline;
     TrackedHandle<VkPipelineLayout> impostorDepthPipelineLayout;
-    TrackedHandle<VkDescriptorSetLayout> impostorDepthDescSetLayout;
-    TrackedHandle<VkDescriptorPool> impostorDepthDescPool;
-    TrackedHandle<VkDescriptorSet> impostorDepthDescSet;
+    // BindlessHeap slots of the captured impostor arrays and inverse VPs.
+    uint32_t impostorAlbedoSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t impostorNormalSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t impostorDepthSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t captureInvVPSlot = BindlessHeap::INVALID_INDEX;
     // Impostor EVSM shadow pipeline (color + depth write, uses impostors_shadow.frag)
     TrackedHandle<VkPipeline> impostorShadowPipeline;
     TrackedHandle<VkPipelineLayout> impostorShadowPipelineLayout;
 
     float                 impostorDistance       = 0.0f;
+    glm::vec4             impostorParams         = glm::vec4(0.0f, 20.0f, 0.0f, 0.0f); // WindParamsUBO::impostorParams
     VkRenderPass storedSolidRenderPass = VK_NULL_HANDLE;
 
-    // Wind params UBO (set=2, binding=0) — updated once per frame.
+    // Wind params storage buffer (BindlessHeap slot) — updated once per frame.
     Buffer                windParamsBuffer;
-    TrackedHandle<VkDescriptorSetLayout> windParamsDescSetLayout;
-    TrackedHandle<VkDescriptorSet> windParamsDescSet;
+    uint32_t              windParamsSlot         = BindlessHeap::INVALID_INDEX;
     void*                 windParamsMapped       = nullptr;
 
-    // ── CPU frustum culling (indirection via concatenated instance buffer) ────
-    Buffer concatenatedInstanceBuffer;  // all instances concatenated (vec4 per element)
+    // ── CPU frustum culling (draw commands index the instance arena) ────
     // Triple-buffered culling resources to prevent CPU/GPU race conditions
     // (same pattern as IndirectRenderer::MAX_CULL_FRAMES).
     static constexpr uint32_t VEG_CULL_FRAMES = 3;
@@ -292,9 +353,7 @@ private:
     void initCascadeCull(VulkanApp* app);
     void updateVegCascadeDescriptor(VulkanApp* app, uint32_t frame);
     // Writes the GPU chunk table (aabbMin/aabbMax/instanceCount/firstInstance
-    // triples) via memcpy into the host-visible chunk info buffer. Iteration
-    // order MUST match consolidateChunks' concatenated-instance copy order so
-    // firstInstance offsets point at the right instance ranges.
+    // triples) from chunkTable into the host-visible chunk info buffer.
     void writeVegChunkInfo();
 
     // Shared GPU-side chunk table + cascade matrices for the veg cascade cull.
@@ -306,36 +365,28 @@ private:
     TrackedHandle<VkDescriptorSetLayout> vegCascadeCullDescSetLayout;
     TrackedHandle<VkDescriptorPool> vegCascadeCullDescPool;
 
-    uint32_t vegNumChunks = 0;             // number of chunks in the consolidated metadata
+    uint32_t vegNumChunks = 0;             // chunkTable size at the last cull
     uint32_t vegChunkInfoCapacity = 0;     // current chunk-info table capacity (grows as needed)
     uint32_t vegCullFrameIndex = 0;        // auto-cycling frame index for triple buffering
     uint32_t vegCullCurrentSlot = 0;       // slot selected for current frame's cull + draws
-    bool vegConsolidationDirty = true;     // rebuild concatenated buffer + metadata
 
-    // Per-frame scratch for read-barrier recording (recordReadBarriers). Runs
-    // on the main frame thread only (SceneRenderer::shadowPass / preRenderPass)
-    // — plain members are safe; clear() + reserve() reuse capacity across frames.
-    std::vector<VkBufferMemoryBarrier2> readBarrierScratch;
-
-    // Pipelined consolidation: deferred callback handles fence lifecycle
-    TrackedHandle<VkFence> consolidationFence;
-    bool consolidationPending = false;
-
-    // Batched async chunk upload: one fence, deferred publish
-    struct PendingBatchCopy {
-        Buffer stagingInst, instBuf, stagingIndirect, indirect;
-        VkDeviceSize bufSize;
+    // Batched async chunk upload: one staging buffer and one copy submission
+    // per processPendingChunks() call, published when its fence signals.
+    struct PendingUpload {
         NodeID chunkId;
-        uint32_t instanceCount;
-        glm::vec3 aabbMin, aabbMax, center;
+        uint64_t serial;
+        ChunkInstances entry;
+        VkDeviceSize stagingOffset;
+        uint32_t source;           // index into uploadBatch
     };
-    std::vector<PendingBatchCopy> pendingBatch;
-    // Frame-thread scratch reused by processPendingChunks for per-chunk
-    // instance data (clear + reserve avoids reallocating per chunk).
-    std::vector<float> instanceGenScratch;
+    std::vector<PendingUpload> pendingUploads;
+    std::vector<ScatteredChunk> uploadBatch;
 
     void destroyCulling();
-    void issueVegetationDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, VkShaderStageFlags pushConstantStages, const WindPushConstants& pc);
-    void issueImpostorDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, VkShaderStageFlags pushConstantStages, const WindPushConstants& pc);
+    void issueVegetationDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, const WindPushConstants& pc);
+    void issueImpostorDraws(VkCommandBuffer cmd, VkPipelineLayout activeLayout, const WindPushConstants& pc);
     WindPushConstants buildWindPushConstants(const glm::vec3& cameraPos) const;
+
+    // Declared last: destroyed (and joined) before the queue its tasks fill.
+    ThreadPool scatterPool{std::max(1u, std::thread::hardware_concurrency() / 4)};
 };
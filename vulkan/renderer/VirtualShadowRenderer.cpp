@@ -0,0 +1,457 @@
+#include "VirtualShadowRenderer.hpp"
+#include "DescriptorAllocator.hpp"
+#include "DescriptorWriter.hpp"
+#include "RendererUtils.hpp"
+#include "CommandBufferState.hpp"
+
+#include "../VulkanApp.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+static constexpr VkFormat VSM_ATLAS_FORMAT = VK_FORMAT_R32G32_SFLOAT; // EVSM2 moments, same as the cascades
+static constexpr VkFormat VSM_DEPTH_FORMAT = VK_FORMAT_D32_SFLOAT;
+
+void VirtualShadowRenderer::init(VulkanApp* app, const VirtualShadowMap::Config& config, size_t frameCount) {
+    app_ = app;
+    config_ = VirtualShadowMap(config).config(); // clamped the same way the page manager does
+    uint32_t frames = std::max<uint32_t>(static_cast<uint32_t>(frameCount), VulkanApp::MAX_FRAMES_IN_FLIGHT);
+
+    createAtlas(app);
+
+    // Page table: header + levelCount * pagesPerLevel² entries.
+    VirtualShadowMap layout(config_);
+    pageTableBytes_ = layout.pageTableWords() * sizeof(uint32_t);
+    pageTable_ = app->createBuffer(pageTableBytes_,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    // All-zero table = disabled header, nothing resident.
+    app->runSingleTimeCommands([&](VkCommandBuffer cmd) {
+        vkCmdFillBuffer(cmd, pageTable_.buffer, 0, VK_WHOLE_SIZE, 0);
+    });
+    tableEnabled_ = false;
+    pageTableSlot = app->getBindlessHeap().registerBuffer(pageTable_.buffer);
+
+    tableStaging_.resize(frames);
+    requestBuffers_.resize(frames);
+    requestFrames_.assign(frames, VirtualShadowMap::RequestFrame{});
+    requestPending_.assign(frames, false);
+    const VkDeviceSize requestBytes = layout.pageTableEntries() * sizeof(uint32_t);
+    for (uint32_t i = 0; i < frames; ++i) {
+        tableStaging_[i] = app->createBuffer(pageTableBytes_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        requestBuffers_[i] = app->createBuffer(requestBytes,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+
+    createMarkPipeline(app, frames);
+}
+
+void VirtualShadowRenderer::cleanup(VulkanApp* app) {
+    if (app) {
+        BindlessHeap& heap = app->getBindlessHeap();
+        heap.releaseImage(atlasSlot);
+        heap.releaseImage(dummyArraySlot);
+        heap.releaseBuffer(pageTableSlot);
+    }
+    atlasSlot = dummyArraySlot = pageTableSlot = BindlessHeap::INVALID_INDEX;
+    // Vulkan objects are destroyed by VulkanResourceManager; drop the handles.
+    pageTable_ = {};
+    tableStaging_.clear();
+    requestBuffers_.clear();
+    requestFrames_.clear();
+    requestPending_.clear();
+    atlasLayerViews.clear();
+    markDescSets_.clear();
+    markDepthViews_.clear();
+    app_ = nullptr;
+}
+
+void VirtualShadowRenderer::createAtlas(VulkanApp* app) {
+    VkDevice device = app->getDevice();
+    const uint32_t layers = config_.physicalPages;
+    const uint32_t size = config_.pageTexels;
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    atlasSampler = app->createSampler(samplerInfo, "VirtualShadowRenderer: atlas sampler");
+
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    depthSampler = app->createSampler(samplerInfo, "VirtualShadowRenderer: depth sampler");
+
+    // Physical page atlas: one layer per page.
+    {
+        VkImageCreateInfo imgInfo{};
+        imgInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imgInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imgInfo.format        = VSM_ATLAS_FORMAT;
+        imgInfo.extent        = { size, size, 1 };
+        imgInfo.mipLevels     = 1;
+        imgInfo.arrayLayers   = layers;
+        imgInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imgInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imgInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        app->createImageWithVma(imgInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, atlasImage, atlasAllocation, atlasMemory, "VirtualShadowRenderer: atlas");
+    }
+    {
+        VkImageViewCreateInfo v{};
+        v.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        v.image            = atlasImage;
+        v.viewType         = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        v.format           = VSM_ATLAS_FORMAT;
+        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, layers };
+        if (vkCreateImageView(device, &v, nullptr, &atlasArrayView) != VK_SUCCESS)
+            throw std::runtime_error("VirtualShadowRenderer: atlasArrayView failed");
+        app->resources.addImageView(atlasArrayView, "VirtualShadowRenderer: atlasArrayView");
+    }
+    atlasLayerViews.assign(layers, VK_NULL_HANDLE);
+    for (uint32_t i = 0; i < layers; ++i) {
+        VkImageViewCreateInfo v{};
+        v.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        v.image            = atlasImage;
+        v.viewType         = VK_IMAGE_VIEW_TYPE_2D;
+        v.format           = VSM_ATLAS_FORMAT;
+        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, i, 1 };
+        if (vkCreateImageView(device, &v, nullptr, &atlasLayerViews[i]) != VK_SUCCESS)
+            throw std::runtime_error("VirtualShadowRenderer: atlasLayerView failed");
+        app->resources.addImageView(atlasLayerViews[i], "VirtualShadowRenderer: atlasLayerView");
+    }
+    app->transitionImageLayoutLayer(atlasImage, VSM_ATLAS_FORMAT,
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 0, layers);
+    app->setImageLayoutTracked(atlasImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, layers);
+
+    // Shared page depth buffer (contents never outlive one page).
+    RendererUtils::createImage2DWithVma(device, app, size, size,
+        VSM_DEPTH_FORMAT,
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+        VK_IMAGE_ASPECT_DEPTH_BIT,
+        "VirtualShadowRenderer: page depth", pageDepthImage, pageDepthAllocation, pageDepthMemory, pageDepthView);
+
+    // Dummy array for the page passes.
+    {
+        VkImageCreateInfo imgInfo{};
+        imgInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imgInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imgInfo.format        = VSM_ATLAS_FORMAT;
+        imgInfo.extent        = { 1, 1, 1 };
+        imgInfo.mipLevels     = 1;
+        imgInfo.arrayLayers   = 1;
+        imgInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imgInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imgInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT;
+        imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        app->createImageWithVma(imgInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, dummyArrayImage, dummyArrayAllocation, dummyArrayMemory, "VirtualShadowRenderer: dummyArray");
+
+        VkImageViewCreateInfo v{};
+        v.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        v.image            = dummyArrayImage;
+        v.viewType         = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        v.format           = VSM_ATLAS_FORMAT;
+        v.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        if (vkCreateImageView(device, &v, nullptr, &dummyArrayView) != VK_SUCCESS)
+            throw std::runtime_error("VirtualShadowRenderer: dummyArrayView failed");
+        app->resources.addImageView(dummyArrayView, "VirtualShadowRenderer: dummyArrayView");
+
+        app->transitionImageLayoutLayer(dummyArrayImage, VSM_ATLAS_FORMAT,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 0, 1);
+        app->setImageLayoutTracked(dummyArrayImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
+    }
+
+    BindlessHeap& heap = app->getBindlessHeap();
+    atlasSlot = heap.registerImage(atlasArrayView, atlasSampler);
+    dummyArraySlot = heap.registerImage(dummyArrayView, atlasSampler);
+}
+
+void VirtualShadowRenderer::createMarkPipeline(VulkanApp* app, size_t frameCount) {
+    VkDevice device = app->getDevice();
+
+    //  0: camera depth (combined sampler)
+    //  1: page table (read)
+    //  2: request flags (write)
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+    for (uint32_t i = 0; i < bindings.size(); ++i) {
+        bindings[i].binding = i;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+                                            : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    }
+
+    DescriptorAllocator descAlloc{device, app};
+    markDescSetLayout = descAlloc.createLayout(
+        bindings.data(), static_cast<uint32_t>(bindings.size()),
+        0, nullptr,
+        "VirtualShadowRenderer: markDescSetLayout");
+
+    VkPushConstantRange pc{};
+    pc.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pc.offset = 0;
+    pc.size = sizeof(glm::mat4) + sizeof(glm::vec4); // invViewProj + screen
+
+    VkPipelineLayoutCreateInfo plInfo{};
+    plInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    plInfo.setLayoutCount = 1;
+    plInfo.pSetLayouts = &markDescSetLayout;
+    plInfo.pushConstantRangeCount = 1;
+    plInfo.pPushConstantRanges = &pc;
+    if (vkCreatePipelineLayout(device, &plInfo, nullptr, &markPipelineLayout) != VK_SUCCESS)
+        throw std::runtime_error("VirtualShadowRenderer: failed to create mark pipeline layout");
+    app->resources.addPipelineLayout(markPipelineLayout, "VirtualShadowRenderer: markPipelineLayout");
+
+    // Compiled with the startup batch when SceneRenderer::init has one open
+    app->getPipelineRegistry().declare("VirtualShadowRenderer mark", [this, app]() {
+        VkPipelineShaderStageCreateInfo stage{};
+        stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        stage.module = app->getOrCreateShaderModule("shaders/vsm_mark_pages.comp.spv");
+        stage.pName = "main";
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage = stage;
+        pipelineInfo.layout = markPipelineLayout;
+        if (vkCreateComputePipelines(app->getDevice(), app->getPipelineCache(), 1, &pipelineInfo, nullptr, &markPipeline) != VK_SUCCESS)
+            throw std::runtime_error("VirtualShadowRenderer: failed to create mark compute pipeline");
+        app->resources.addPipeline(markPipeline, "VirtualShadowRenderer: markPipeline");
+    });
+
+    const uint32_t sets = static_cast<uint32_t>(frameCount);
+    std::array<VkDescriptorPoolSize, 2> poolSizes = {{
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, sets },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, sets * 2 }
+    }};
+    markDescPool = descAlloc.createPool(
+        poolSizes.data(), static_cast<uint32_t>(poolSizes.size()), sets, 0,
+        "VirtualShadowRenderer: markDescPool");
+
+    markDescSets_.assign(sets, VK_NULL_HANDLE);
+    markDepthViews_.assign(sets, VK_NULL_HANDLE);
+    descAlloc.allocateSets(markDescPool, markDescSetLayout, sets, markDescSets_.data(),
+                           "VirtualShadowRenderer: markDescSet");
+    for (uint32_t i = 0; i < sets; ++i) {
+        DescriptorWriter(device)
+            .writeBuffer(markDescSets_[i], 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         pageTable_.buffer, 0, VK_WHOLE_SIZE)
+            .writeBuffer(markDescSets_[i], 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         requestBuffers_[i].buffer, 0, VK_WHOLE_SIZE)
+            .flush();
+    }
+}
+
+void VirtualShadowRenderer::collectRequests(uint32_t frameIdx, VirtualShadowMap& vsm) {
+    if (frameIdx >= requestBuffers_.size() || !requestPending_[frameIdx]) return;
+    requestPending_[frameIdx] = false;
+    const uint32_t* flags = static_cast<const uint32_t*>(requestBuffers_[frameIdx].map(0));
+    if (!flags) return;
+    vsm.submitRequests(requestFrames_[frameIdx], flags, vsm.pageTableEntries());
+}
+
+void VirtualShadowRenderer::uploadPageTable(VkCommandBuffer cmd, uint32_t frameIdx,
+                                            const VirtualShadowMap& vsm, bool enabled) {
+    if (frameIdx >= tableStaging_.size()) return;
+    if (!enabled && !tableEnabled_) return; // disabled header already on the device
+    tableEnabled_ = enabled;
+
+    uint32_t* dst = static_cast<uint32_t*>(tableStaging_[frameIdx].map(0));
+    if (!dst) return;
+    vsm.buildPageTable(dst, enabled);
+
+    // Previous frames' lit shaders and mark pass may still read the table.
+    VkBufferMemoryBarrier2 pre{};
+    pre.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    pre.srcStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    pre.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    pre.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    pre.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    pre.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pre.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pre.buffer = pageTable_.buffer;
+    pre.offset = 0;
+    pre.size = VK_WHOLE_SIZE;
+    VkDependencyInfo preDep{};
+    preDep.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    preDep.bufferMemoryBarrierCount = 1;
+    preDep.pBufferMemoryBarriers = &pre;
+    vkCmdPipelineBarrier2(cmd, &preDep);
+
+    VkBufferCopy copy{ 0, 0, pageTableBytes_ };
+    vkCmdCopyBuffer(cmd, tableStaging_[frameIdx].buffer, pageTable_.buffer, 1, &copy);
+
+    VkBufferMemoryBarrier2 post = pre;
+    post.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    post.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    post.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    post.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    VkDependencyInfo postDep{};
+    postDep.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    postDep.bufferMemoryBarrierCount = 1;
+    postDep.pBufferMemoryBarriers = &post;
+    vkCmdPipelineBarrier2(cmd, &postDep);
+}
+
+void VirtualShadowRenderer::beginPage(VkCommandBuffer cmd, uint32_t physical, VkRenderingFlags renderingFlags) {
+    const uint32_t size = config_.pageTexels;
+
+    // Layer: sampled by earlier frames → colour attachment. Depth: previous
+    // page's contents are discarded (UNDEFINED), cleared below.
+    VkImageMemoryBarrier2 barriers[2]{};
+    barriers[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    barriers[0].srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+    barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    barriers[0].dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    barriers[0].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barriers[0].newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barriers[0].image = atlasImage;
+    barriers[0].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, physical, 1 };
+
+    barriers[1].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barriers[1].srcStageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+    barriers[1].srcAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    barriers[1].dstStageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+    barriers[1].dstAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barriers[1].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    barriers[1].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barriers[1].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barriers[1].image = pageDepthImage;
+    barriers[1].subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+
+    VkDependencyInfo dep{};
+    dep.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dep.imageMemoryBarrierCount = 2;
+    dep.pImageMemoryBarriers = barriers;
+    vkCmdPipelineBarrier2(cmd, &dep);
+
+    VkRenderingAttachmentInfo colorAttachment{};
+    colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+    colorAttachment.imageView = atlasLayerViews[physical];
+    colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.clearValue = {{{0.0f, 0.0f, 0.0f, 0.0f}}};
+
+    VkRenderingAttachmentInfo depthAttachment{};
+    depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+    depthAttachment.imageView = pageDepthView;
+    depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.clearValue.depthStencil = {1.0f, 0};
+
+    VkRenderingInfo renderingInfo{};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    renderingInfo.renderArea.offset = {0, 0};
+    renderingInfo.renderArea.extent = {size, size};
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+    renderingInfo.pDepthAttachment = &depthAttachment;
+    renderingInfo.flags = renderingFlags;
+    vkCmdBeginRendering(cmd, &renderingInfo);
+}
+
+void VirtualShadowRenderer::endPage(VkCommandBuffer cmd, uint32_t physical) {
+    vkCmdEndRendering(cmd);
+
+    // Pages are sampled unblurred by the lit fragment shaders.
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = atlasImage;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, physical, 1 };
+
+    VkDependencyInfo dep{};
+    dep.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dep.imageMemoryBarrierCount = 1;
+    dep.pImageMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(cmd, &dep);
+}
+
+void VirtualShadowRenderer::recordMarkPages(VkCommandBuffer cmd, uint32_t frameIdx, VkImageView depthView,
+                                            const glm::mat4& invViewProj, uint32_t width, uint32_t height,
+                                            const VirtualShadowMap& vsm) {
+    if (frameIdx >= markDescSets_.size() || depthView == VK_NULL_HANDLE || width == 0 || height == 0) return;
+    VkDescriptorSet ds = markDescSets_[frameIdx];
+
+    // The slot's previous submission has retired, so its set may be rewritten.
+    if (markDepthViews_[frameIdx] != depthView) {
+        DescriptorWriter(app_->getDevice())
+            .writeImage(ds, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                        depthSampler, depthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+            .flush();
+        markDepthViews_[frameIdx] = depthView;
+    }
+
+    VkBuffer requests = requestBuffers_[frameIdx].buffer;
+    vkCmdFillBuffer(cmd, requests, 0, VK_WHOLE_SIZE, 0);
+
+    VkBufferMemoryBarrier2 fillBarrier{};
+    fillBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    fillBarrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    fillBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    fillBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    fillBarrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    fillBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    fillBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    fillBarrier.buffer = requests;
+    fillBarrier.offset = 0;
+    fillBarrier.size = VK_WHOLE_SIZE;
+    VkDependencyInfo fillDep{};
+    fillDep.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    fillDep.bufferMemoryBarrierCount = 1;
+    fillDep.pBufferMemoryBarriers = &fillBarrier;
+    vkCmdPipelineBarrier2(cmd, &fillDep);
+
+    if (cmdState) cmdState->bindComputePipeline(cmd, markPipeline);
+    else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, markPipeline);
+    if (cmdState) cmdState->bindComputeDescriptorSets(cmd, markPipelineLayout, 0, 1, &ds, 0, nullptr);
+    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, markPipelineLayout, 0, 1, &ds, 0, nullptr);
+
+    struct {
+        glm::mat4 invViewProj;
+        glm::vec4 screen;
+    } pc{ invViewProj, glm::vec4(float(width), float(height), 1.0f / float(width), 1.0f / float(height)) };
+    vkCmdPushConstants(cmd, markPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pc), &pc);
+    vkCmdDispatch(cmd, (width + 7) / 8, (height + 7) / 8, 1);
+
+    // Host reads the flags after the slot's fence (collectRequests).
+    VkBufferMemoryBarrier2 hostBarrier = fillBarrier;
+    hostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    hostBarrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    hostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    VkDependencyInfo hostDep{};
+    hostDep.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    hostDep.bufferMemoryBarrierCount = 1;
+    hostDep.pBufferMemoryBarriers = &hostBarrier;
+    vkCmdPipelineBarrier2(cmd, &hostDep);
+
+    requestFrames_[frameIdx] = vsm.requestFrame();
+    requestPending_[frameIdx] = true;
+}
+
+size_t VirtualShadowRenderer::getGpuBytes() const {
+    return VirtualShadowMap(config_).atlasBytes() + static_cast<size_t>(pageTableBytes_);
+}
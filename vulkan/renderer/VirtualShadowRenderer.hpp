@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Renderer.hpp"
+#include "../vulkan.hpp"
+#include "../TrackedHandle.hpp"
+#include "../Buffer.hpp"
+#include "../../utils/VirtualShadowMap.hpp"
+#include <vector>
+
+// GPU side of the virtual (clipmapped) shadow map: the physical page atlas,
+// the page table read by the lit shaders (bindless heap slots, frame UBO
+// textureSlots1.z / bufferSlots.z) and the
+// compute pass that marks the pages the camera depth buffer needs.
+//
+// Page management lives in VirtualShadowMap; ShadowRenderer draws the pages
+// (renderVirtualPages) into the atlas layers this class owns.
+//
+// Atlas layers rest in SHADER_READ_ONLY_OPTIMAL; beginPage()/endPage()
+// transition one layer to a colour attachment and back. All pages share one
+// pageTexels² depth buffer (cleared per page).
+//
+// Request readback: recordMarkPages() writes into the frame slot's
+// host-visible request buffer; collectRequests() reads it back the next time
+// the same slot comes round (its fence has been waited), i.e. requests are
+// MAX_FRAMES_IN_FLIGHT frames old when they reach VirtualShadowMap.
+class VirtualShadowRenderer : public Renderer {
+public:
+    void init(VulkanApp* app, const VirtualShadowMap::Config& config, size_t frameCount);
+    void cleanup(VulkanApp* app) override;
+
+    // Bindless heap slots of the atlas and the page table. The page passes
+    // point the atlas slot at the dummy atlas, since they must not reference
+    // the layers being rendered.
+    VkSampler getAtlasSampler() const { return atlasSampler; }
+    VkImageView getAtlasView() const { return atlasArrayView; }
+    uint32_t getAtlasSlot() const { return atlasSlot; }
+    uint32_t getDummyAtlasSlot() const { return dummyArraySlot; }
+    uint32_t getPageTableSlot() const { return pageTableSlot; }
+    VkBuffer getPageTableBuffer() const { return pageTable_.buffer; }
+    VkDeviceSize getPageTableSize() const { return pageTableBytes_; }
+
+    uint32_t getPageTexels() const { return config_.pageTexels; }
+    uint32_t getPhysicalPageCount() const { return config_.physicalPages; }
+
+    // Feed the requests the mark pass wrote into `frameIdx`'s slot the last
+    // time it was used. Call before recording that slot again.
+    void collectRequests(uint32_t frameIdx, VirtualShadowMap& vsm);
+
+    // Copy the current page table to the device table. When disabled only a
+    // header with enabled = 0 is uploaded, once, so the lit shaders fall back
+    // to the EVSM cascades.
+    void uploadPageTable(VkCommandBuffer cmd, uint32_t frameIdx, const VirtualShadowMap& vsm, bool enabled);
+
+    // Render one page into atlas layer `physical`. Pass
+    // VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT when the draws come
+    // from vkCmdExecuteCommands.
+    void beginPage(VkCommandBuffer cmd, uint32_t physical, VkRenderingFlags renderingFlags = 0);
+    void endPage(VkCommandBuffer cmd, uint32_t physical);
+
+    // Mark the pages the given camera depth needs. `depthView` must be in
+    // SHADER_READ_ONLY_OPTIMAL and the page table uploaded this frame.
+    void recordMarkPages(VkCommandBuffer cmd, uint32_t frameIdx, VkImageView depthView,
+                         const glm::mat4& invViewProj, uint32_t width, uint32_t height,
+                         const VirtualShadowMap& vsm);
+
+    // Device memory of the atlas, shared page depth and page table.
+    size_t getGpuBytes() const;
+
+private:
+    void createAtlas(VulkanApp* app);
+    void createMarkPipeline(VulkanApp* app, size_t frameCount);
+
+    VulkanApp* app_ = nullptr;
+    VirtualShadowMap::Config config_;
+
+    VkImage atlasImage = VK_NULL_HANDLE;
+    VmaAllocation atlasAllocation = VK_NULL_HANDLE;
+    VkDeviceMemory atlasMemory = VK_NULL_HANDLE;
+    VkImageView atlasArrayView = VK_NULL_HANDLE;
+    uint32_t atlasSlot = UINT32_MAX;
+    std::vector<VkImageView> atlasLayerViews;
+
+    VkImage pageDepthImage = VK_NULL_HANDLE;
+    VmaAllocation pageDepthAllocation = VK_NULL_HANDLE;
+    VkDeviceMemory pageDepthMemory = VK_NULL_HANDLE;
+    VkImageView pageDepthView = VK_NULL_HANDLE;
+
+    // 1x1, 1-layer RG32F array kept in SHADER_READ_ONLY for the page passes
+    VkImage dummyArrayImage = VK_NULL_HANDLE;
+    VmaAllocation dummyArrayAllocation = VK_NULL_HANDLE;
+    VkDeviceMemory dummyArrayMemory = VK_NULL_HANDLE;
+    VkImageView dummyArrayView = VK_NULL_HANDLE;
+    uint32_t dummyArraySlot = UINT32_MAX;
+
+    TrackedHandle<VkSampler> atlasSampler;
+    TrackedHandle<VkSampler> depthSampler;
+
+    Buffer pageTable_;                       // device-local, read by lit shaders and the mark pass
+    VkDeviceSize pageTableBytes_ = 0;
+    uint32_t pageTableSlot = UINT32_MAX;
+    std::vector<Buffer> tableStaging_;       // per frame slot
+    std::vector<Buffer> requestBuffers_;     // per frame slot, host-visible
+    std::vector<VirtualShadowMap::RequestFrame> requestFrames_;
+    std::vector<bool> requestPending_;
+    bool tableEnabled_ = true;               // forces the first disabled upload
+
+    TrackedHandle<VkPipeline> markPipeline;
+    TrackedHandle<VkPipelineLayout> markPipelineLayout;
+    TrackedHandle<VkDescriptorSetLayout> markDescSetLayout;
+    TrackedHandle<VkDescriptorPool> markDescPool;
+    std::vector<VkDescriptorSet> markDescSets_;
+    std::vector<VkImageView> markDepthViews_; // depth view each set was last written with
+};
@@ -1,7 +1,5 @@
 
 #include "WaterRenderer.hpp"
-#include "DescriptorAllocator.hpp"
-#include "DescriptorWriter.hpp"
 #include <cstdlib>
 #include "RendererUtils.hpp"
 #include "BrushRenderer.hpp"
@@ -37,8 +35,9 @@ void WaterRenderer::init(VulkanApp* app, Buffer& waterParamsBuffer_, const std::
     waterIndirectRenderer.init();
     createSamplers(app);
 
-    // Create water pipelines and initialize the water params SSBO from the provided vector.
-    createWaterPipelines(app, waterParams);
+    // Initialize the water params SSBO from the provided vector and create the
+    // scene-texture set layout; the pipeline is built by createPipelines().
+    createWaterDescriptors(app, waterParams);
 
     // Water render time UBO (binding 10): created here, bound into the scene
     // descriptor sets by SceneRenderer, updated per frame in renderPass().
@@ -96,6 +95,10 @@ void WaterRenderer::updateGPUParamsForLayer(uint32_t layer, const WaterParams& p
 void WaterRenderer::cleanup(VulkanApp* app) {
     waterIndirectRenderer.cleanup(app);
     destroyRenderTargets(app);
+    app->getBindlessHeap().releaseImage(cubemapDummyDepthSlot);
+    app->getBindlessHeap().releaseImage(cubemapDummyCubeSlot);
+    cubemapDummyDepthSlot = BindlessHeap::INVALID_INDEX;
+    cubemapDummyCubeSlot = BindlessHeap::INVALID_INDEX;
     if (waterRenderUBO_.buffer != VK_NULL_HANDLE) waterRenderUBO_ = {};
 }
 
@@ -187,18 +190,10 @@ void WaterRenderer::createRenderTargets(VulkanApp* app, uint32_t width, uint32_t
 
     // Back-face depth targets are owned/created by SceneRenderer
 
-    // NOTE: the per-frame scene-texture descriptor set (waterDepthDescriptorSets) is
-    // allocated once per frame slot in prepareSceneTexturesForFrame() and
-    // reused every frame — only the image-view bindings are refreshed via
-    // vkUpdateDescriptorSets. The set is never updated while a pending command
-    // buffer references it and never needs UPDATE_AFTER_BIND (which trips
-    // GPU-assisted validation).
-
     std::cout << "[WaterRenderer] Created render targets (2 sets) " << width << "x" << height << std::endl;
 }
 
 void WaterRenderer::destroyRenderTargets(VulkanApp* app) {
-    VkDevice device = app->getDevice();
     // Clear per-frame image handles; actual Vulkan destruction
     // will be performed by the VulkanResourceManager.
     for (uint32_t i = 0; i < FRAMES; ++i) {
@@ -223,35 +218,11 @@ void WaterRenderer::destroyRenderTargets(VulkanApp* app) {
     }
     // Back-face depth targets are destroyed by SceneRenderer
 
-    // Reset descriptor pool to free descriptor sets. The old sets may still be
-    // referenced by in-flight command buffers, so we must wait before resetting.
-    // Scope it to the graphics queue (queueWaitIdle) instead of a whole-device
-    // idle: these descriptor sets are only consumed by graphics-queue water draws
-    // (the geometry/transfer queue only performs buffer copies, never binds these
-    // sets), so a graphics-queue idle covers every consumer while leaving compute
-    // and unrelated device work untouched. Per AGENTS.md, vkDeviceWaitIdle is
-    // reserved for shutdown / major rebuilds.
-    if (waterDepthDescriptorPool != VK_NULL_HANDLE && app) {
-        VkResult r = app->queueWaitIdle();
-        if (r == VK_SUCCESS) {
-            VkResult resetResult = vkResetDescriptorPool(device, waterDepthDescriptorPool, 0);
-            if (resetResult != VK_SUCCESS) {
-                std::cerr << "[WaterRenderer] Failed to reset water depth descriptor pool (result=" << (int)resetResult << ")" << std::endl;
-            }
-        } else {
-            std::cerr << "[WaterRenderer] Skipping descriptor pool reset: graphics queue not idle (result=" << (int)r << ")" << std::endl;
-        }
-    }
-    // The per-slot scene-texture sets live in waterDepthDescriptorPool, so the
-    // reset above frees them; just drop the dangling handles.
-    for (uint32_t i = 0; i < FRAMES; ++i) waterDepthDescriptorSets[i] = VK_NULL_HANDLE;
-    for (uint32_t i = 0; i < FRAMES; ++i) cubemapWaterDepthDS[i] = VK_NULL_HANDLE;
-    // The pool reset invalidated every set allocated from it; drop all cached
-    // descriptor-write signatures so the next update always rewrites (a set
-    // handle reused by the allocator must never be skipped against a stale
-    // entry). The async per-task sets use their own pools and are re-created
-    // lazily, so clearing here only costs one extra write for them.
-    sceneTextureWriteCache.clear();
+    // The scene-texture slots may name views that die with these targets (or
+    // the solid/back-face targets recreated alongside them); drop them so the
+    // next writeSceneSlots registers the new views. The heap defers the reuse
+    // until the frames that still read them have retired.
+    releaseSceneSlots(app);
 }
 
 void WaterRenderer::clearRenderTargets(VulkanApp* app, VkCommandBuffer cmd, uint32_t frameIndex) {
@@ -313,99 +284,35 @@ void WaterRenderer::setWaterGeomDepthLayout(uint32_t frameIndex, VkImageLayout l
     if (frameIndex < 3) waterGeomDepthImageLayouts[frameIndex] = layout;
 }
 
-void WaterRenderer::createWaterPipelines(VulkanApp* app, const std::vector<WaterParams>& waterParams) {
+void WaterRenderer::createWaterDescriptors(VulkanApp* app, const std::vector<WaterParams>& waterParams) {
     VkDevice device = app->getDevice();
     
     // Water params buffer is already assigned in init
     initializeWaterParamsBuffer(waterParams);
     std::cout << "[WaterRenderer] Initialized water params buffer from provided layer state" << std::endl;
     
-    // Create descriptor set layout for scene textures (set 2)
-    // Binding 0: Scene color texture
-    // Binding 1: Scene depth texture
-    // Binding 2: Sky color texture
-    // Binding 3: Water back-face depth texture (for volume thickness)
-    // Binding 4: Optional cubemap
-    // Binding 5: Scene position/world-position texture (g-buffer)
-    std::array<VkDescriptorSetLayoutBinding, 5> sceneBindings{};
-    
-    // Scene color (binding 0)
-    sceneBindings[0].binding = 0;
-    sceneBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    sceneBindings[0].descriptorCount = 1;
-    sceneBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    sceneBindings[0].pImmutableSamplers = nullptr;
-    
-    // Scene depth (binding 1) — also accessed by TES for depth-based wave attenuation
-    sceneBindings[1].binding = 1;
-    sceneBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    sceneBindings[1].descriptorCount = 1;
-    sceneBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-    sceneBindings[1].pImmutableSamplers = nullptr;
-
-    // Sky color (binding 2)
-    sceneBindings[2].binding = 2;
-    sceneBindings[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    sceneBindings[2].descriptorCount = 1;
-    sceneBindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    sceneBindings[2].pImmutableSamplers = nullptr;
-
-    // Water back-face depth (binding 3) — for water volume thickness
-    // Also sampled by the tessellation evaluation shader (VUID 07988).
-    sceneBindings[3].binding = 3;
-    sceneBindings[3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    sceneBindings[3].descriptorCount = 1;
-    sceneBindings[3].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-    sceneBindings[3].pImmutableSamplers = nullptr;
-
-    // Optional cubemap sampler (binding 4) — used by water shader when solid 360 is available
-    sceneBindings[4].binding = 4;
-    sceneBindings[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    sceneBindings[4].descriptorCount = 1;
-    sceneBindings[4].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    sceneBindings[4].pImmutableSamplers = nullptr;
-
-    // Scene position/world-position (binding 5) — g-buffer world-space position
-    // Removed binding for Scene position/world-position texture (g-buffer)
-
-    VkDescriptorBindingFlags bindingFlags[5] = {
-        0, 0, 0, 0, 0
-    };
+    // Scene textures (solid color/depth, back-face depth, 360° cube) are read
+    // through heap slots in the frame UBO (writeSceneSlots), so water uses the
+    // shared scene layout: set 0 = UBO, set 1 = bindless heap.
+    std::vector<VkDescriptorSetLayout> waterSetLayouts = app->getSceneSetLayouts();
 
-    DescriptorAllocator descAlloc{device, app};
-    waterDepthDescriptorSetLayout = descAlloc.createLayout(
-        sceneBindings.data(), static_cast<uint32_t>(sceneBindings.size()),
-        0,
-        bindingFlags,
-        "WaterRenderer: waterDepthDescriptorSetLayout");
-
-    // Pool for the per-frame main scene-texture set.  Each frame's set is
-    // allocated once and updated in-place via vkUpdateDescriptorSets (no
-    // per-frame alloc/free).  The pool is bulk-reset on swapchain recreate.
-    // Capacity covers the 3 cubemap sets plus the 3 main sets with headroom.
-    VkDescriptorPoolSize wrPoolSize = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 50};
-    waterDepthDescriptorPool = descAlloc.createPool(
-        &wrPoolSize, 1, 10,
-        0,
-        "WaterRenderer: waterDepthDescriptorPool");
-
-    // Descriptor sets are allocated and updated per-frame in
-    // prepareSceneTexturesForFrame() after scene images are created
-    
-    // Create a custom pipeline layout for water that includes:
-    // Set 0: Material SSBO (from app->getMaterialDescriptorSetLayout())
-    // Set 1: UBO (from app->getDescriptorSetLayout())
-    // Set 2: Scene depth texture (waterDepthDescriptorSetLayout)
-    // Descriptor set ordering: set 0 = global UBO+samplers, set 1 = material set, set 2 = scene depth textures
-    std::array<VkDescriptorSetLayout, 3> waterSetLayouts = {
-        app->getDescriptorSetLayout(),           // Set 0: UBO + samplers
-        app->getMaterialDescriptorSetLayout(),   // Set 1: Materials
-        waterDepthDescriptorSetLayout            // Set 2: Scene depth texture
-    };
-    
-    // No per-mesh model push-constants are used for water (shaders use identity/no model push-constant).
+    VkPipelineLayoutCreateInfo waterLayoutInfo{};
+    waterLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    waterLayoutInfo.setLayoutCount = static_cast<uint32_t>(waterSetLayouts.size());
+    waterLayoutInfo.pSetLayouts = waterSetLayouts.data();
+    waterLayoutInfo.pushConstantRangeCount = 1;
+    waterLayoutInfo.pPushConstantRanges = app->getScenePushConstantRange();
+
+    if (vkCreatePipelineLayout(device, &waterLayoutInfo, nullptr, &waterGeometryPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create water geometry pipeline layout!");
+    }
+    app->resources.addPipelineLayout(waterGeometryPipelineLayout, "WaterRenderer: waterGeometryPipelineLayout");
 
-    std::cout << "[WaterRenderer] Created water pipeline layout with 3 descriptor sets" << std::endl;
+    std::cout << "[WaterRenderer] Created water pipeline layout (scene layouts)" << std::endl;
+}
+
+void WaterRenderer::createPipelines(VulkanApp* app) {
+    VkDevice device = app->getDevice();
 
     // Create water geometry pipeline with dedicated water shaders
     // Load water shaders (vertex, tessellation control, tessellation evaluation, fragment)
@@ -456,19 +363,6 @@ void WaterRenderer::createWaterPipelines(VulkanApp* app, const std::vector<Water
     bindingDesc.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
     auto attrDescs = vk_layouts::defaultAttributes();
 
-    // --- Create pipeline layout manually ---
-    VkPipelineLayoutCreateInfo waterLayoutInfo{};
-    waterLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    waterLayoutInfo.setLayoutCount = static_cast<uint32_t>(waterSetLayouts.size());
-    waterLayoutInfo.pSetLayouts = waterSetLayouts.data();
-    waterLayoutInfo.pushConstantRangeCount = 0;
-    waterLayoutInfo.pPushConstantRanges = nullptr;
-
-    if (vkCreatePipelineLayout(device, &waterLayoutInfo, nullptr, &waterGeometryPipelineLayout) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create water geometry pipeline layout!");
-    }
-    app->resources.addPipelineLayout(waterGeometryPipelineLayout, "WaterRenderer: waterGeometryPipelineLayout");
-
     // --- Create pipeline (dynamic rendering, 1 color attachment VK_FORMAT_R32G32B32A32_SFLOAT) ---
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -665,129 +559,41 @@ void WaterRenderer::endWaterGeometryPass(VkCommandBuffer cmd) {
 
 // Back-face pass is owned and executed by SceneRenderer via its WaterBackFaceRenderer.
 
-void WaterRenderer::updateSceneTexturesBinding(VulkanApp* app, VkDescriptorSet ds, VkImageView colorImageView, VkImageView depthImageView, uint32_t frameIndex, VkImageView skyImageView, VkImageView backFaceDepthView, VkImageView cube360View) {
-    if (ds == VK_NULL_HANDLE || linearSampler == VK_NULL_HANDLE) {
-        return;
-    }
-
-    // Determine the effective cubemap to bind:
-    // - If a new explicit `cube360View` is provided, use it and remember it.
-    // - If `cube360View` is VK_NULL_HANDLE, prefer the previously remembered view
-    //   (so callers that update only color/depth won't accidentally clear the cube).
-    VkImageView finalCubeView = cube360View;
-    if (finalCubeView == VK_NULL_HANDLE) finalCubeView = currentCube360View;
-
-    // If an explicit cube view was provided, remember it for future updates.
-    if (cube360View != VK_NULL_HANDLE) currentCube360View = cube360View;
-
-    // Track cubemap availability and update per-layer GPU params when it changes
-    bool cubeAvail = (finalCubeView != VK_NULL_HANDLE);
-    if (cube360Available != cubeAvail) {
-        cube360Available = cubeAvail;
-        // The upper level must explicitly refresh GPU params for any layer
-        // whose state should change when cubemap availability toggles.
-    }
-
-    // Use the provided image views directly
-    VkImageView colorView = colorImageView;
-    VkImageView depthView = depthImageView;
-
-    std::array<VkDescriptorImageInfo, 5> imageInfos{};
-
-    // Scene color (binding 0)
-    imageInfos[0].sampler = linearSampler;
-    imageInfos[0].imageView = colorView;
-    imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    // Scene depth (binding 1) - sample depth with nearest filtering to avoid invalid interpolated depths
-    imageInfos[1].sampler = nearestSampler;
-    imageInfos[1].imageView = depthView;
-    imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    // Sky color (binding 2)
-    imageInfos[2].sampler = linearSampler;
-    if (skyImageView == VK_NULL_HANDLE) {
-        imageInfos[2].imageView = colorImageView; // fallback to scene color
-    } else {
-        imageInfos[2].imageView = skyImageView;
-    }
-    imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    // Water back-face depth (binding 3) — prefer explicit `backFaceDepthView` if provided.
-    // Use nearest filtering so depth values are not interpolated across geometry edges.
-    imageInfos[3].sampler = nearestSampler;
-    if (backFaceDepthView == VK_NULL_HANDLE) {
-        throw std::runtime_error("WaterRenderer requires a valid backFaceDepthView (no fallback allowed)");
-    }
-    imageInfos[3].imageView = backFaceDepthView;
-    imageInfos[3].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    // Cubemap (binding 4) — prefer `finalCubeView` if available, otherwise fall back to scene color
-    imageInfos[4].sampler = linearSampler;
-    if (finalCubeView == VK_NULL_HANDLE) {
-        throw std::runtime_error("WaterRenderer requires a valid finalCubeView for reflections (no fallback allowed)");
-    }
-    imageInfos[4].imageView = finalCubeView;
-    imageInfos[4].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    // Scene position (binding 5) — g-buffer world position. If not available, fall back to scene color view.
-    // Removed image info for Scene position/world-position texture (g-buffer)
-
-    // Descriptor write cache: skip the vkUpdateDescriptorSets calls when this
-    // set already holds identical bindings. The signature is keyed by the
-    // descriptor set handle, so the per-frame sets (prepareSceneTexturesForFrame)
-    // and the async per-task sets (main.cpp) never interfere; if the async path
-    // feeds different views into the same set, the signature changes and the
-    // writes still happen. A fresh set has no cache entry, so its first update
-    // always writes. Note: in the async path main.cpp re-patches binding 3
-    // (patchBinding3) right after this call with the same dummy view every task,
-    // so skipping here cannot leave that binding stale either way.
-    SceneTextureBindingSignature sig;
-    for (uint32_t i = 0; i < 5; ++i) {
-        sig.samplers[i] = imageInfos[i].sampler;
-        sig.views[i] = imageInfos[i].imageView;
-        sig.layouts[i] = imageInfos[i].imageLayout;
-    }
-    auto cacheIt = sceneTextureWriteCache.find(ds);
-    if (cacheIt != sceneTextureWriteCache.end() && cacheIt->second == sig) {
-        return; // bindings unchanged since the last write to this set
-    }
+uint32_t WaterRenderer::refreshSceneSlot(SceneSlot& entry, VkImageView view, VkSampler sampler) {
+    if (entry.view == view) return entry.slot;
+    BindlessHeap& heap = appPtr->getBindlessHeap();
+    entry.slot = (view != VK_NULL_HANDLE) ? heap.replaceImage(entry.slot, view, sampler) : BindlessHeap::INVALID_INDEX;
+    entry.view = view;
+    return entry.slot;
+}
 
-    DescriptorWriter writer(app->getDevice());
-    for (uint32_t i = 0; i < 5; ++i) {
-        writer.writeImage(ds, i, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                          imageInfos[i].sampler, imageInfos[i].imageView,
-                          imageInfos[i].imageLayout);
-    }
-    writer.flush();
-    sceneTextureWriteCache[ds] = sig;
+void WaterRenderer::writeSceneSlots(UniformObject& ubo, uint32_t frameIndex) {
+    if (!appPtr || frameIndex >= FRAMES || linearSampler == VK_NULL_HANDLE) return;
+
+    // Depths are sampled with nearest filtering so values are never
+    // interpolated across geometry edges.
+    VkImageView colorView = solidRenderer_ ? solidRenderer_->getColorView(frameIndex) : VK_NULL_HANDLE;
+    VkImageView depthView = solidRenderer_ ? solidRenderer_->getDepthView(frameIndex) : VK_NULL_HANDLE;
+    VkImageView backView = backFaceRenderer_ ? backFaceRenderer_->getBackFaceDepthView(frameIndex) : VK_NULL_HANDLE;
+    ubo.sceneSlots.z = refreshSceneSlot(sceneColorSlots[frameIndex], colorView, linearSampler);
+    ubo.sceneSlots.w = refreshSceneSlot(sceneDepthSlots[frameIndex], depthView, nearestSampler);
+    ubo.sceneSlots1.x = refreshSceneSlot(backFaceDepthSlots[frameIndex], backView, nearestSampler);
+
+    // The 360° cube slot is owned by Solid360Renderer; the upper level must
+    // refresh the per-layer GPU params when its availability toggles.
+    const uint32_t cubeSlot = solid360Renderer_ ? solid360Renderer_->getSolid360Slot() : BindlessHeap::INVALID_INDEX;
+    cube360Available = cubeSlot != BindlessHeap::INVALID_INDEX;
+    ubo.sceneSlots1.y = cubeSlot;
 }
 
-VkDescriptorSet WaterRenderer::prepareSceneTexturesForFrame(VulkanApp* app, uint32_t frameIndex,
-                                                             VkImageView colorImageView, VkImageView depthImageView,
-                                                             VkImageView skyImageView, VkImageView backFaceDepthView,
-                                                             VkImageView cube360View) {
-    if (app == nullptr || waterDepthDescriptorPool == VK_NULL_HANDLE ||
-        waterDepthDescriptorSetLayout == VK_NULL_HANDLE || linearSampler == VK_NULL_HANDLE) {
-        return VK_NULL_HANDLE;
-    }
-    if (frameIndex >= FRAMES) return VK_NULL_HANDLE;
-
-    // Allocate this slot's descriptor set once; subsequent frames just rebind
-    // the (potentially different) image views via vkUpdateDescriptorSets.
-    // The pool is reset on swapchain recreate, which drops all sets, so
-    // allocation only happens after a fresh pool is available.
-    if (waterDepthDescriptorSets[frameIndex] == VK_NULL_HANDLE) {
-        DescriptorAllocator descAlloc{app->getDevice(), app};
-        descAlloc.allocateSets(waterDepthDescriptorPool, waterDepthDescriptorSetLayout, 1,
-                               &waterDepthDescriptorSets[frameIndex],
-                               "WaterRenderer: waterDepthDescriptorSet");
-        if (waterDepthDescriptorSets[frameIndex] == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+void WaterRenderer::releaseSceneSlots(VulkanApp* app) {
+    BindlessHeap& heap = app->getBindlessHeap();
+    for (uint32_t i = 0; i < FRAMES; ++i) {
+        for (SceneSlot* entry : { &sceneColorSlots[i], &sceneDepthSlots[i], &backFaceDepthSlots[i] }) {
+            heap.releaseImage(entry->slot);
+            *entry = SceneSlot{};
+        }
     }
-
-    updateSceneTexturesBinding(app, waterDepthDescriptorSets[frameIndex], colorImageView, depthImageView, frameIndex,
-                               skyImageView, backFaceDepthView, cube360View);
-    return waterDepthDescriptorSets[frameIndex];
 }
 
 void WaterRenderer::initializeWaterParamsBuffer(const std::vector<WaterParams>& waterParams) {
@@ -838,8 +644,8 @@ void WaterRenderer::prepareRender(VulkanApp* app, VkCommandBuffer cmd, uint32_t
     // The solid render pass already images to SHADER_READ_ONLY_OPTIMAL via
     // explicit endPass barriers, but we need an execution + memory dependency
     // between the two command sequences on the same command buffer. The
-    // tessellation evaluation shader also samples the back-face depth (set 2
-    // binding 3) for volume bump modulation, so it must be included in the
+    // tessellation evaluation shader also samples the back-face depth (heap
+    // slot sceneSlots1.x) for volume bump modulation, so it must be included in the
     // destination stage mask alongside the fragment shader.
     VkMemoryBarrier2 memBarrier{};
     memBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
@@ -868,7 +674,8 @@ void WaterRenderer::render(VulkanApp* app, VkCommandBuffer cmd, uint32_t frameIn
 
     beginWaterGeometryPass(cmd, frameIndex);
 
-    // Bind descriptor sets (shared between depth pre-pass and main pass)
+    // Bind the main set (shared between depth pre-pass and main pass); the
+    // heap stays bound at set 1 and the frame UBO carries the scene slots.
     VkDescriptorSet mainDs = app->getMainDescriptorSet();
     if (mainDs != VK_NULL_HANDLE) {
         if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd,
@@ -876,13 +683,6 @@ void WaterRenderer::render(VulkanApp* app, VkCommandBuffer cmd, uint32_t frameIn
         else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
             waterGeometryPipelineLayout, 0, 1, &mainDs, 0, nullptr);
     }
-    VkDescriptorSet sceneDs = getWaterDepthDescriptorSet(frameIndex);
-    if (sceneDs != VK_NULL_HANDLE) {
-        if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd,
-            waterGeometryPipelineLayout, 2, 1, &sceneDs, 0, nullptr);
-        else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            waterGeometryPipelineLayout, 2, 1, &sceneDs, 0, nullptr);
-    }
 
     // Main geometry pass
     if (waterGeometryPipeline != VK_NULL_HANDLE) {
@@ -1075,59 +875,21 @@ void WaterRenderer::ensureCubemapResources(VulkanApp* app, VkFormat colorFormat)
         }
     }
 
-    // --- Allocate per-frame set 2 descriptors for cubemap water pass ---
-    // One per frame-in-flight. These sets are written ONCE here with immutable
-    // dummy views and never updated again: renderWaterIntoCubemap is called once
-    // per cubemap face (6×/frame) and re-binding the same set is fine, but
-    // *updating* it a second time while it is already bound in the command
-    // buffer is a VUID-03047 violation. The cubemap pass does not actually
-    // sample scene textures (it uses dummies), so the bindings never change.
-    if (cubemapWaterDepthDS[0] == VK_NULL_HANDLE && waterDepthDescriptorPool != VK_NULL_HANDLE) {
-        for (uint32_t i = 0; i < FRAMES; ++i) {
-            VkDescriptorSetAllocateInfo ai{};
-            ai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            ai.descriptorPool = waterDepthDescriptorPool;
-            ai.descriptorSetCount = 1; ai.pSetLayouts = &waterDepthDescriptorSetLayout;
-            if (vkAllocateDescriptorSets(device, &ai, &cubemapWaterDepthDS[i]) != VK_SUCCESS) {
-                std::cerr << "[WaterRenderer] Warning: Failed to allocate cubemap water depth descriptor set " << i << std::endl;
-                cubemapWaterDepthDS[i] = VK_NULL_HANDLE;
-                continue;
-            }
-            // Write the immutable dummy bindings once at allocation time.
-            VkDescriptorImageInfo dDepth{};
-            dDepth.sampler = linearSampler;
-            dDepth.imageView = cubemapDummyDepthView;
-            dDepth.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            VkDescriptorImageInfo dColor{};
-            dColor.sampler = linearSampler;
-            dColor.imageView = cubemapDummyDepthView;
-            dColor.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            VkDescriptorImageInfo dBack{};
-            dBack.sampler = (nearestSampler != VK_NULL_HANDLE) ? nearestSampler : linearSampler;
-            dBack.imageView = cubemapDummyDepthView;
-            dBack.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            VkDescriptorImageInfo dCube{};
-            dCube.sampler = linearSampler;
-            dCube.imageView = cubemapDummyCubeView;
-            dCube.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            DescriptorWriter w(device);
-            w.writeImage(cubemapWaterDepthDS[i], 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, dColor.sampler, dColor.imageView, dColor.imageLayout);
-            w.writeImage(cubemapWaterDepthDS[i], 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, dDepth.sampler, dDepth.imageView, dDepth.imageLayout);
-            w.writeImage(cubemapWaterDepthDS[i], 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, dColor.sampler, dColor.imageView, dColor.imageLayout);
-            w.writeImage(cubemapWaterDepthDS[i], 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, dBack.sampler, dBack.imageView, dBack.imageLayout);
-            w.writeImage(cubemapWaterDepthDS[i], 4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, dCube.sampler, dCube.imageView, dCube.imageLayout);
-            w.flush();
-        }
+    // --- Heap slots for the dummies; the cube face UBO points the water scene
+    // slots at them (the cubemap pass does not sample the scene targets) ---
+    BindlessHeap& heap = app->getBindlessHeap();
+    if (cubemapDummyDepthSlot == BindlessHeap::INVALID_INDEX) {
+        cubemapDummyDepthSlot = heap.registerImage(cubemapDummyDepthView,
+            (nearestSampler != VK_NULL_HANDLE) ? nearestSampler : linearSampler);
+    }
+    if (cubemapDummyCubeSlot == BindlessHeap::INVALID_INDEX) {
+        cubemapDummyCubeSlot = heap.registerImage(cubemapDummyCubeView, linearSampler);
     }
 }
 
 void WaterRenderer::bindCubemapWaterPipeline(VkCommandBuffer cmd,
-                                             VkDescriptorSet descriptorSet0,
-                                             uint32_t frameIndex) {
+                                             VkDescriptorSet descriptorSet0) {
     if (!appPtr || cubemapWaterPipeline == VK_NULL_HANDLE) return;
-    if (frameIndex >= FRAMES || cubemapWaterDepthDS[frameIndex] == VK_NULL_HANDLE) return;
-
-    VkDescriptorSet cubeDs = cubemapWaterDepthDS[frameIndex];
 
     if (cmdState) cmdState->bindGraphicsPipeline(cmd, cubemapWaterPipeline);
     else vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, cubemapWaterPipeline);
@@ -1135,10 +897,6 @@ void WaterRenderer::bindCubemapWaterPipeline(VkCommandBuffer cmd,
         waterGeometryPipelineLayout, 0, 1, &descriptorSet0, 0, nullptr);
     else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
         waterGeometryPipelineLayout, 0, 1, &descriptorSet0, 0, nullptr);
-    if (cmdState) cmdState->bindGraphicsDescriptorSets(cmd,
-        waterGeometryPipelineLayout, 2, 1, &cubeDs, 0, nullptr);
-    else vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
-        waterGeometryPipelineLayout, 2, 1, &cubeDs, 0, nullptr);
 }
 
 void WaterRenderer::renderWaterIntoCubemap(VkCommandBuffer cmd,
@@ -1204,28 +962,11 @@ void WaterRenderer::renderPass(VulkanApp* app, VkCommandBuffer commandBuffer, ui
     // pass outputs are available for sampling.
     VkImageView sceneColorView = solidRenderer_ ? solidRenderer_->getColorView(frameIdx) : VK_NULL_HANDLE;
     VkImageView sceneDepthView = solidRenderer_ ? solidRenderer_->getDepthView(frameIdx) : VK_NULL_HANDLE;
-    // (Re)allocate and update this slot's scene-texture descriptor set (set 2,
-    // binding 1 = sceneDepthTex) here on the main command buffer, immediately
-    // before any draw that binds it. The async back-face task uses its OWN
-    // per-task set, so this slot's set is only ever referenced by the main
-    // command buffer and is freed/reallocated once its in-flight fence signals
-    // (no VUID-03047, and GPU-assisted validation sees it populated — no
-    // UPDATE_AFTER_BIND needed).
-    {
-        VkImageView wBack = (backFaceRenderer_) ? backFaceRenderer_->getBackFaceDepthView(frameIdx) : VK_NULL_HANDLE;
-        VkImageView wCube = (solid360Renderer_) ? solid360Renderer_->getSolid360View() : VK_NULL_HANDLE;
-        prepareSceneTexturesForFrame(app, frameIdx, sceneColorView, sceneDepthView,
-                                     skyView, wBack, wCube);
-    }
+    // The shaders read these targets through the frame UBO's heap slots
+    // (writeSceneSlots, filled before the frame UBO upload).
 
     bool _wg_env_skip = envDisableWaterGeom_;
 
-    // Scene textures were already bound before the async back-face/solid360 tasks were
-    // launched (see main.cpp), so we must NOT call updateSceneTexturesBinding here.
-    // Calling it after the async tasks submit their command buffers would update a
-    // descriptor set that is already referenced by a pending command buffer
-    // (VUID-vkUpdateDescriptorSets-None-03047).
-
     bool wf = waterWireframeEnabled;
     if (wf && waterWireframe_ && waterWireframe_->getPipeline() != VK_NULL_HANDLE) {
         // Wireframe path: use WaterRenderer for setup/pass management,
@@ -1246,11 +987,6 @@ void WaterRenderer::renderPass(VulkanApp* app, VkCommandBuffer commandBuffer, ui
                     if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, waterLayout, 0, 1, &mainDs, 0, nullptr);
                 }
 
-                VkDescriptorSet sceneDs = getWaterDepthDescriptorSet(frameIdx);
-                if (sceneDs != VK_NULL_HANDLE) {
-                    if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, waterLayout, 2, 1, &sceneDs, 0, nullptr);
-                }
-
                 // Draw filled water geometry (will update depth buffer)
                 getIndirectRenderer().drawPrepared(commandBuffer);
                 if (brushRenderer_) brushRenderer_->getLiquidIR().drawPrepared(commandBuffer);
@@ -1269,10 +1005,6 @@ void WaterRenderer::renderPass(VulkanApp* app, VkCommandBuffer commandBuffer, ui
                 if (wfMainDs != VK_NULL_HANDLE)
                     if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, wfLayout, 0, 1, &wfMainDs, 0, nullptr);
 
-                VkDescriptorSet wfDepthDs = getWaterDepthDescriptorSet(frameIdx);
-                if (wfDepthDs != VK_NULL_HANDLE)
-                    if (cmdState) cmdState->bindGraphicsDescriptorSets(commandBuffer, wfLayout, 2, 1, &wfDepthDs, 0, nullptr);
-
                 getIndirectRenderer().drawPrepared(commandBuffer);
                 if (brushRenderer_) brushRenderer_->getLiquidIR().drawPrepared(commandBuffer);
             }
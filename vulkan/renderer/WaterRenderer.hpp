@@ -12,7 +12,6 @@
 #include "../../utils/Scene.hpp"
 #include "../ubo/UniformObject.hpp"
 #include "../../widgets/SkySettings.hpp"
-#include <unordered_map>
 #include "../../space/Model3DVersion.hpp"
 #include "../../utils/WaterParams.hpp"
 #include "../ubo/WaterParamsGPU.hpp"
@@ -31,6 +30,8 @@ public:
     ~WaterRenderer();
 
     void init(VulkanApp* app, Buffer& waterParamsBuffer_, const std::vector<WaterParams>& waterParams, uint32_t layerCount);
+    // Water geometry pipeline; needs the pipeline layout from init()
+    void createPipelines(VulkanApp* app);
     void cleanup(VulkanApp* app) override;
 
     // Inject the scene sub-renderers the water pass samples from or draws
@@ -42,8 +43,7 @@ public:
                            WireframeRenderer* waterWireframe);
 
     // Full water pass orchestration: updates the water render UBO with the
-    // active layer time, (re)allocates this slot's scene-texture descriptor
-    // set, then records the offscreen water geometry pass (filled, wireframe
+    // active layer time, then records the offscreen water geometry pass (filled, wireframe
     // overlay, or skipped via VULKAN_DISABLE_WATERGEOM) on the same command
     // buffer so the solid pass outputs are available for sampling.
     void renderPass(VulkanApp* app, VkCommandBuffer cmd, uint32_t frameIndex,
@@ -65,9 +65,8 @@ public:
     void endWaterGeometryPass(VkCommandBuffer cmd);
 
     // Back-face depth pre-pass (reversed winding for water volume thickness)
-    // NOTE: back-face depth pre-pass is now owned by SceneRenderer. SceneRenderer
-    // should provide the back-face depth view to WaterRenderer via
-    // `updateSceneTexturesBinding` when available.
+    // NOTE: back-face depth pre-pass is now owned by SceneRenderer; its depth
+    // view reaches the water shaders through writeSceneSlots.
 
     // Execute the water offscreen geometry pass on the provided command buffer.
     // The solid render pass must have already ended on this same command buffer.
@@ -101,21 +100,16 @@ public:
     // Get the water geometry pipeline layout
     VkPipelineLayout getWaterGeometryPipelineLayout() const { return waterGeometryPipelineLayout; }
 
-    // Get the descriptor set layout for scene textures (set 2)
-    VkDescriptorSetLayout getWaterDepthDescriptorSetLayout() const { return waterDepthDescriptorSetLayout; }
-
     // Cubemap-compatible water pipeline (uses swapchain color format)
     VkPipeline getCubemapWaterPipeline() const { return cubemapWaterPipeline; }
 
     // Render water into a given color+depth attachment pair (used by Solid360Renderer).
     // The caller must ensure the attachments are in COLOR_ATTACHMENT_OPTIMAL /
     // DEPTH_STENCIL_ATTACHMENT_OPTIMAL layout before calling, and transition them
-    // back after. descriptorSet0 must contain at least bindings 0, 5, 7, 10.
-    // `frameIndex` selects the per-frame cubemap descriptor set so it is never
-    // updated while a previous frame's command buffer is still pending (no UAB needed).
+    // back after. descriptorSet0 must contain at least bindings 0 and 10, and
+    // the face UBO must point the scene slots at the cubemap dummies below.
     void bindCubemapWaterPipeline(VkCommandBuffer cmd,
-                                  VkDescriptorSet descriptorSet0,
-                                  uint32_t frameIndex);
+                                  VkDescriptorSet descriptorSet0);
 
     void renderWaterIntoCubemap(VkCommandBuffer cmd,
                                 VkImageView colorView, VkImageView depthView,
@@ -129,34 +123,21 @@ public:
                        VkImageView sceneColorView, VkImageView sceneDepthView,
                        VkImageView skyView = VK_NULL_HANDLE);
 
-    // Get water depth descriptor set (for binding scene depth texture)
-    VkDescriptorSet getWaterDepthDescriptorSet(uint32_t frameIndex) const { return (frameIndex < FRAMES) ? waterDepthDescriptorSets[frameIndex] : VK_NULL_HANDLE; }
-
-    // Ensure cubemap water rendering resources exist (pipeline, dummy textures, descriptor set).
-    // Called lazily from renderWaterIntoCubemap.
+    // Ensure cubemap water rendering resources exist (pipeline, dummy textures
+    // and their heap slots). Called lazily by Solid360Renderer.
     void ensureCubemapResources(VulkanApp* app, VkFormat colorFormat);
+    uint32_t getCubemapDummyDepthSlot() const { return cubemapDummyDepthSlot; }
+    uint32_t getCubemapDummyCubeSlot() const { return cubemapDummyCubeSlot; }
 
     // Get sampler for ImGui texture display
     VkSampler getLinearSampler() const { return linearSampler; }
     
-    // Update the scene textures binding (color + depth + sky) for refraction and edge foam.
-    // Writes into `ds` (the caller chooses the per-command-buffer set so the set is
-    // never shared between the async back-face task and the main command buffer).
-    // `backFaceDepthView` and `cube360View` may be VK_NULL_HANDLE if those targets
-    // are not present; SceneRenderer should pass them when available.
-    void updateSceneTexturesBinding(VulkanApp* app, VkDescriptorSet ds, VkImageView colorImageView, VkImageView depthImageView, uint32_t frameIndex, VkImageView skyImageView = VK_NULL_HANDLE, VkImageView backFaceDepthView = VK_NULL_HANDLE, VkImageView cube360View = VK_NULL_HANDLE);
-
-    // Allocate a fresh per-frame scene-texture descriptor set, free the previous
-    // one, and update it with the given views. Returns the new set (or
-    // VK_NULL_HANDLE on failure). The previous set is freed only after its command
-    // buffer has completed (the caller must invoke this from preRenderPass, which
-    // runs after the per-slot in-flight fence wait), so the set is never reused
-    // while pending and never needs UPDATE_AFTER_BIND.
-    VkDescriptorSet prepareSceneTexturesForFrame(VulkanApp* app, uint32_t frameIndex,
-                                                 VkImageView colorImageView, VkImageView depthImageView,
-                                                 VkImageView skyImageView = VK_NULL_HANDLE,
-                                                 VkImageView backFaceDepthView = VK_NULL_HANDLE,
-                                                 VkImageView cube360View = VK_NULL_HANDLE);
+    // Write this frame's scene-texture slots (solid color/depth, back-face
+    // depth, 360° cube) into `ubo`, registering views that changed since the
+    // last call. Must run before the frame UBO upload.
+    void writeSceneSlots(UniformObject& ubo, uint32_t frameIndex);
+    // Drop the scene-texture slots (the targets behind them are being recreated).
+    void releaseSceneSlots(VulkanApp* app);
 
     // Clear per-frame render targets (color/depth) into default values.
     // Call this each frame when water rendering is disabled to avoid sampling
@@ -164,12 +145,10 @@ public:
     void clearRenderTargets(VulkanApp* app, VkCommandBuffer cmd, uint32_t frameIndex);
 
     // Solid 360° cubemap reflection and back-face rendering are owned by SceneRenderer.
-    // SceneRenderer must call `updateSceneTexturesBinding` to provide any required
-    // views (back-face depth, cubemap/equirect) to WaterRenderer.
 
 private:
 
-    void createWaterPipelines(VulkanApp* app, const std::vector<WaterParams>& waterParams);
+    void createWaterDescriptors(VulkanApp* app, const std::vector<WaterParams>& waterParams);
     void initializeWaterParamsBuffer(const std::vector<WaterParams>& waterParams);
     void createSamplers(VulkanApp* app);
 
@@ -204,39 +183,19 @@ private:
     // Water geometry pipeline layout (includes depth texture binding)
     TrackedHandle<VkPipelineLayout> waterGeometryPipelineLayout;
 
-    // Descriptor set for water geometry (scene depth texture)
-    TrackedHandle<VkDescriptorSetLayout> waterDepthDescriptorSetLayout;
-    TrackedHandle<VkDescriptorPool> waterDepthDescriptorPool;
-    // Per-frame descriptor sets for scene textures (3 frames in flight)
-    // One scene-texture descriptor set per in-flight slot. Each slot's set is
-    // freed and reallocated in prepareSceneTexturesForFrame() while the per-slot
-    // in-flight fence guarantees the previous command buffer using that slot has
-    // completed. This avoids both VUID-03047 (update/destroy while pending) and
-    // the GPU-assisted false "length 0" seen with UPDATE_AFTER_BIND.
-    std::array<VkDescriptorSet, FRAMES> waterDepthDescriptorSets{VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE};
-
-    // Cache of the last descriptor contents written per descriptor set by
-    // updateSceneTexturesBinding(). The offscreen target views bound here are
-    // stable per frame slot, so the per-frame vkUpdateDescriptorSets calls can
-    // be skipped while the set already holds identical bindings. Keyed by the
-    // descriptor set handle so the per-frame sets (prepareSceneTexturesForFrame)
-    // and the async per-task sets (allocated in main.cpp) stay independent: if
-    // the async path feeds different views into a set, the signature changes
-    // and the writes still happen. Cleared when the pool is reset so a reused
-    // handle is never skipped against a stale entry.
-    struct SceneTextureBindingSignature {
-        std::array<VkSampler, 5> samplers{};
-        std::array<VkImageView, 5> views{};
-        std::array<VkImageLayout, 5> layouts{};
-        bool operator==(const SceneTextureBindingSignature& o) const {
-            return samplers == o.samplers && views == o.views && layouts == o.layouts;
-        }
+    // Heap slot of one scene texture and the view it was registered for
+    struct SceneSlot {
+        VkImageView view = VK_NULL_HANDLE;
+        uint32_t slot = BindlessHeap::INVALID_INDEX;
     };
-    std::unordered_map<VkDescriptorSet, SceneTextureBindingSignature> sceneTextureWriteCache;
-
-    // Cubemap water pass resources (per-frame to avoid updating a set that a
-    // previous frame's command buffer still has pending)
-    std::array<TrackedHandle<VkDescriptorSet>, FRAMES> cubemapWaterDepthDS{};
+    uint32_t refreshSceneSlot(SceneSlot& entry, VkImageView view, VkSampler sampler);
+    std::array<SceneSlot, FRAMES> sceneColorSlots{};
+    std::array<SceneSlot, FRAMES> sceneDepthSlots{};
+    std::array<SceneSlot, FRAMES> backFaceDepthSlots{};
+
+    // Cubemap water pass resources
+    uint32_t cubemapDummyDepthSlot = BindlessHeap::INVALID_INDEX;
+    uint32_t cubemapDummyCubeSlot = BindlessHeap::INVALID_INDEX;
     VkImage cubemapDummyDepthImage = VK_NULL_HANDLE;
     VmaAllocation cubemapDummyDepthAllocation = VK_NULL_HANDLE;
     VkDeviceMemory cubemapDummyDepthMemory = VK_NULL_HANDLE;
@@ -257,10 +216,8 @@ private:
     TrackedHandle<VkSampler> linearSampler;
     TrackedHandle<VkSampler> nearestSampler;
 
-    // Whether a cubemap reflection is currently available (set by SceneRenderer)
+    // Whether a cubemap reflection is currently available (set by writeSceneSlots)
     bool cube360Available = false;
-    // Last cubemap image view provided by SceneRenderer (preserve across updates)
-    VkImageView currentCube360View = VK_NULL_HANDLE;
 
     uint32_t renderWidth = 0;
     uint32_t renderHeight = 0;
@@ -144,8 +144,10 @@ void WireframeRenderer::createPipeline(VulkanApp* app,
     layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
     layoutInfo.pSetLayouts = setLayouts.data();
-    layoutInfo.pushConstantRangeCount = 0;
-    layoutInfo.pPushConstantRanges = nullptr;
+    // The scene push-constant range keeps the layout compatible with the
+    // scene passes, so binding set 0 leaves the bindless heap bound.
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = app->getScenePushConstantRange();
 
     if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &wireframePipelineLayout) != VK_SUCCESS) {
         std::cerr << "[WireframeRenderer] Failed to create pipeline layout for " << label << std::endl;
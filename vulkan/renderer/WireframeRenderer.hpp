@@ -18,7 +18,8 @@ public:
 
     // Create a wireframe pipeline using dynamic rendering.
     // `colorFormats` must list the color attachment formats (matches the pass).
-    // `setLayouts` are the descriptor set layouts the pipeline needs.
+    // `setLayouts` are the descriptor set layouts the pipeline needs: the
+    // scene layouts (VulkanApp::getSceneSetLayouts) for scene passes.
     // `hasTessellation` enables patch-list topology + tess shaders.
     void createPipeline(VulkanApp* app,
                         const std::vector<VkFormat>& colorFormats,
@@ -0,0 +1,184 @@
+#include "TextureUploadQueue.hpp"
+#include "../VulkanApp.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace streaming {
+
+void TextureUploadQueue::init(VulkanApp* app) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    app_ = app;
+}
+
+TextureLayerResidency& TextureUploadQueue::layerState(uint32_t layer) {
+    if (layer >= layers_.size()) layers_.resize(layer + 1);
+    return layers_[layer];
+}
+
+uint64_t TextureUploadQueue::enqueue(TextureLayerJob&& job) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    uint64_t version = ++layerState(job.layer).requested;
+    // Drop queued (not yet submitted) jobs this one fully overwrites: the same
+    // map, or every map of the layer when the new job rewrites all of them.
+    const uint32_t layer = job.layer;
+    const int map = job.map;
+    queue_.erase(std::remove_if(queue_.begin(), queue_.end(), [&](const QueuedJob& q) {
+        return q.job.layer == layer && (map == -1 || q.job.map == map);
+    }), queue_.end());
+    queue_.push_back(QueuedJob{std::move(job), version});
+    return version;
+}
+
+bool TextureUploadQueue::retireCompleted(std::vector<std::function<void()>>& callbacks) {
+    // VulkanApp owns the submit fences and destroys them once
+    // processPendingCommandBuffers() observes them signaled, so "no longer
+    // pending" is the completion signal; the handle is never queried after that.
+    std::lock_guard<std::mutex> lk(mutex_);
+    bool inFlight = false;
+    for (auto& st : layers_) {
+        if (st.fence == VK_NULL_HANDLE) continue;
+        if (app_->isFencePending(st.fence)) { inFlight = true; continue; }
+        st.resident = std::max(st.resident, st.submitted);
+        st.fence = VK_NULL_HANDLE;
+        if (st.onResident) callbacks.push_back(std::move(st.onResident));
+        st.onResident = nullptr;
+    }
+    return inFlight;
+}
+
+void TextureUploadQueue::processUploads() {
+    if (!app_) return;
+
+    // 1) Retire finished submissions. Callbacks run outside the lock so they may
+    //    enqueue follow-up work.
+    std::vector<std::function<void()>> callbacks;
+    retireCompleted(callbacks);
+    for (auto& cb : callbacks) cb();
+
+    // 2) Pick the oldest queued job of every idle layer. Later jobs for a layer
+    //    that is still busy stay queued (and keep coalescing) until it retires.
+    std::vector<QueuedJob> ready;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        std::vector<char> claimed(layers_.size(), 0);
+        for (auto it = queue_.begin(); it != queue_.end(); ) {
+            uint32_t layer = it->job.layer;
+            if (layers_[layer].fence != VK_NULL_HANDLE || claimed[layer]) { ++it; continue; }
+            claimed[layer] = 1;
+            ready.push_back(std::move(*it));
+            it = queue_.erase(it);
+        }
+    }
+
+    // 3) Record and submit. The graphics queue orders these submissions before
+    //    the next frame, so no semaphore wait is needed for sampling.
+    for (auto& q : ready) {
+        VkFence fence = VK_NULL_HANDLE;
+        try {
+            fence = app_->runSingleTimeCommandsAsync(q.job.record);
+        } catch (const std::exception& e) {
+            std::cerr << "[TextureUploadQueue] submit failed for layer " << q.job.layer
+                      << " map " << q.job.map << ": " << e.what() << std::endl;
+            continue;
+        }
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto& st = layerState(q.job.layer);
+        st.submitted = q.version;
+        st.fence = fence;
+        st.onResident = std::move(q.job.onResident);
+    }
+}
+
+bool TextureUploadQueue::waitInFlight(uint32_t layer, uint64_t timeoutNs) {
+    std::vector<VkFence> fences;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        for (uint32_t i = 0; i < layers_.size(); ++i) {
+            if (layer != UINT32_MAX && i != layer) continue;
+            if (layers_[i].fence != VK_NULL_HANDLE) fences.push_back(layers_[i].fence);
+        }
+    }
+    const auto start = std::chrono::steady_clock::now();
+    bool signaled = true;
+    for (VkFence f : fences) {
+        if (!app_->isFencePending(f)) continue;
+        uint64_t remaining = UINT64_MAX;
+        if (timeoutNs != UINT64_MAX) {
+            const uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            remaining = elapsed < timeoutNs ? timeoutNs - elapsed : 0;
+        }
+        if (VulkanApp::waitFence(app_->getDevice(), f, remaining) == VK_TIMEOUT) {
+            signaled = false;
+            break;
+        }
+    }
+    // Let VulkanApp retire the signaled fences so retireCompleted() sees them.
+    app_->processPendingCommandBuffers();
+    return signaled;
+}
+
+void TextureUploadQueue::flush() {
+    if (!app_) return;
+    for (;;) {
+        processUploads();
+        if (queuedCount() == 0 && inFlightCount() == 0) break;
+        waitInFlight(UINT32_MAX);
+    }
+}
+
+bool TextureUploadQueue::flushLayer(uint32_t layer, uint64_t timeoutNs) {
+    if (!app_) return true;
+    const auto start = std::chrono::steady_clock::now();
+    for (;;) {
+        processUploads();
+        if (!isLayerBusy(layer)) return true;
+        uint64_t remaining = UINT64_MAX;
+        if (timeoutNs != UINT64_MAX) {
+            const uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            if (elapsed >= timeoutNs) return false;
+            remaining = timeoutNs - elapsed;
+        }
+        if (!waitInFlight(layer, remaining)) return false;
+    }
+}
+
+void TextureUploadQueue::destroy() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    queue_.clear();
+    layers_.clear();
+    app_ = nullptr;
+}
+
+bool TextureUploadQueue::isLayerBusy(uint32_t layer) const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (layer < layers_.size() && layers_[layer].fence != VK_NULL_HANDLE) return true;
+    for (const auto& q : queue_) if (q.job.layer == layer) return true;
+    return false;
+}
+
+uint64_t TextureUploadQueue::requestedVersion(uint32_t layer) const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return layer < layers_.size() ? layers_[layer].requested : 0;
+}
+
+uint64_t TextureUploadQueue::residentVersion(uint32_t layer) const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return layer < layers_.size() ? layers_[layer].resident : 0;
+}
+
+size_t TextureUploadQueue::queuedCount() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return queue_.size();
+}
+
+size_t TextureUploadQueue::inFlightCount() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    size_t n = 0;
+    for (const auto& st : layers_) if (st.fence != VK_NULL_HANDLE) ++n;
+    return n;
+}
+
+} // namespace streaming
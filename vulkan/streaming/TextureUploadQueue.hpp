@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class VulkanApp;
+
+namespace streaming {
+
+// One piece of GPU work that rewrites (part of) a texture array layer, e.g. a
+// TextureMixer Perlin blend or an EditableTexture copy. `record` is invoked on
+// the main thread when the job is submitted, NOT when it is enqueued, so it must
+// capture everything it needs by value.
+struct TextureLayerJob {
+    uint32_t layer = 0;
+    int      map   = -1;                          // -1 = all maps, 0..4 = albedo/normal/bump/roughness/ao
+
+    std::function<void(VkCommandBuffer)> record;  // records the transfer/compute work
+
+    // Invoked ONCE on the main thread when the GPU work has completed and the
+    // new content is resident. Not invoked for jobs superseded while queued.
+    std::function<void()> onResident;
+};
+
+// Residency of a single array layer. Versions increase monotonically:
+//   requested  - bumped by every enqueue()
+//   submitted  - version of the job currently (or last) handed to the GPU
+//   resident   - version whose content the GPU has finished writing
+// Shaders keep sampling the previous content until `resident` catches up; the
+// submission itself is ordered on the graphics queue, so no frame ever reads a
+// half-written layer.
+struct TextureLayerResidency {
+    uint64_t requested = 0;
+    uint64_t submitted = 0;
+    uint64_t resident  = 0;
+    VkFence  fence     = VK_NULL_HANDLE;          // in-flight submission, if any
+    std::function<void()> onResident;             // callback of the in-flight job
+};
+
+// Non-blocking replacement for the runSingleTimeCommands() calls texture edits
+// used to make. Mirrors UploadManager:
+//   * processUploads() runs once per frame on the main thread and never waits
+//     on the GPU; completion is polled through VulkanApp's pending-fence list.
+//   * At most one job per layer is in flight. Requests that arrive meanwhile
+//     are coalesced per (layer, map) so dragging a mixer slider only ever keeps
+//     the latest parameters queued instead of stacking one submit per frame.
+class TextureUploadQueue {
+public:
+    void init(VulkanApp* app);
+
+    // Queue a job and return its version for the layer. May be called from any
+    // thread; the job's record callback runs later on the main thread.
+    uint64_t enqueue(TextureLayerJob&& job);
+
+    // --- Called once per frame from the render loop -----------------------
+    // Retires finished submissions (fires onResident) and submits queued jobs
+    // for idle layers. Returns immediately; it never waits on the GPU.
+    void processUploads();
+
+    // Blocking drain of every queued and in-flight job. Only for rare, already
+    // heavy events: array reallocation and teardown.
+    void flush();
+    // Blocking drain of a single layer (queued jobs for other layers stay queued).
+    // Gives up after timeoutNs; returns true once the layer is idle.
+    bool flushLayer(uint32_t layer, uint64_t timeoutNs = UINT64_MAX);
+
+    // Drops queued jobs and residency state. Call after flush().
+    void destroy();
+
+    bool     isLayerBusy(uint32_t layer) const;
+    uint64_t requestedVersion(uint32_t layer) const;
+    uint64_t residentVersion(uint32_t layer) const;
+    size_t   queuedCount() const;
+    size_t   inFlightCount() const;
+
+private:
+    struct QueuedJob {
+        TextureLayerJob job;
+        uint64_t        version = 0;
+    };
+
+    TextureLayerResidency& layerState(uint32_t layer);
+    bool retireCompleted(std::vector<std::function<void()>>& callbacks);
+    // False when timeoutNs elapsed before the in-flight fences signaled
+    bool waitInFlight(uint32_t layer, uint64_t timeoutNs = UINT64_MAX);
+
+    VulkanApp* app_ = nullptr;
+
+    mutable std::mutex mutex_;                     // guards queue_ and layers_
+    std::vector<QueuedJob> queue_;                 // FIFO, coalesced per (layer, map)
+    std::vector<TextureLayerResidency> layers_;    // indexed by array layer, grown on demand
+};
+
+} // namespace streaming
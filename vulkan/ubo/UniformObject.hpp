@@ -24,8 +24,16 @@ struct UniformObject {
     glm::mat4 invViewProjection;     // offset 400, size 64  inverse of viewProjection (camera-constant)
     glm::vec4 brushParams;           // offset 464, size 16  x=brushTextureIndex, y=brushMode (0=overlay, 2=PAINT)
     glm::vec4 brushHSV;              // offset 480, size 16  x=H(0..360), y=S(0..1), z=V(0..1), w=unused
+    glm::vec4 lodParams;             // offset 496, size 16  x=frontier cell size (0 = no geomorph), y=lodBias, z=geomorph band width, w=maxLevel
+    // Bindless heap slots (BindlessHeap); UINT32_MAX = not registered
+    glm::uvec4 textureSlots;         // offset 512, size 16  albedo, normal, height, roughness arrays
+    glm::uvec4 textureSlots1;        // offset 528, size 16  x=AO array, y=environment cubemap, z=virtual shadow atlas, w=unused
+    glm::uvec4 shadowSlots;          // offset 544, size 16  xyz=shadow cascades 0-2, w=unused
+    glm::uvec4 sceneSlots;           // offset 560, size 16  x=brush depth, y=brush back-face depth, z=scene color, w=scene depth
+    glm::uvec4 sceneSlots1;          // offset 576, size 16  x=water back-face depth, y=scene sky cubemap, zw=unused
+    glm::uvec4 bufferSlots;          // offset 592, size 16  x=materials, y=water params, z=virtual shadow table, w=unused
 
-    // Total size: 496 bytes
+    // Total size: 608 bytes
 
     // Note: sky-related data moved to SkyUniform
 
@@ -11,5 +11,6 @@ struct WindParamsUBO {
     glm::vec4 windTurbulence;       // x = turbulence
     glm::vec4 densityParams;        // x = enabled, y = nearDistance, z = farDistance, w = minFactor
     glm::vec4 cameraPosAndFalloff;  // xyz = main camera position, w = density falloff
+    glm::vec4 impostorParams;       // x = octahedral grid size (0 = Fibonacci views), y = views per billboard type
 };
-static_assert(sizeof(WindParamsUBO) == 96, "WindParamsUBO expected 96 bytes");
+static_assert(sizeof(WindParamsUBO) == 112, "WindParamsUBO expected 112 bytes");
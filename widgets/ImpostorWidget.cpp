@@ -55,7 +55,14 @@ void ImpostorWidget::render() {
     // ── Preview mode ────────────────────────────────────────────────
     ImGui::Spacing();
     ImGui::Separator();
-    ImGui::Text("Captured views (%u, Fibonacci sphere):", ImpostorCapture::NUM_VIEWS);
+    const bool octahedral = impostorService->getLayout() == ImpostorCapture::ViewLayout::Octahedral;
+    const uint32_t viewCount = impostorService->viewCount();
+    if (octahedral)
+        ImGui::Text("Captured views (%u, octahedral %ux%u @ %upx):", viewCount,
+                    impostorService->getOctahedralGrid(), impostorService->getOctahedralGrid(),
+                    impostorService->frameSize());
+    else
+        ImGui::Text("Captured views (%u, Fibonacci sphere):", viewCount);
     ImGui::SameLine();
     const char* modeNames[] = { "Albedo", "Normal", "Depth" };
     ImGui::SetNextItemWidth(100.0f);
@@ -63,8 +70,9 @@ void ImpostorWidget::render() {
     ImGui::Spacing();
 
     const float thumbSize = 48.0f;
-    const int   columns   = 5;
-    for (uint32_t i = 0; i < ImpostorCapture::NUM_VIEWS; ++i) {
+    // Octahedral frames are laid out as their grid
+    const int   columns   = octahedral ? static_cast<int>(impostorService->getOctahedralGrid()) : 5;
+    for (uint32_t i = 0; i < viewCount; ++i) {
         if (i % columns != 0) ImGui::SameLine();
         VkDescriptorSet ds = VK_NULL_HANDLE;
         if (previewMode == 0)
@@ -181,7 +181,7 @@ void OctreeExplorerWidget::renderTree(const Octree& tree) {
     ImGui::TextColored(ImVec4(nodeColor.r, nodeColor.g, nodeColor.b, 1.0f), "[lod=%d]", (int)root->getLod()); ImGui::SameLine();
     ImGui::TextColored(ImVec4(nodeColor.r, nodeColor.g, nodeColor.b, 1.0f), "[chunklod=%d]", (int)root->getChunkLod()); ImGui::SameLine();
     ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "v%u", root->version);
-    renderSdfInline(root);
+    renderSdfInline(root, rootCube);
     
     if (open) {
         renderNode(root, rootCube, 0, allocator, rootFlags);
@@ -231,7 +231,7 @@ void OctreeExplorerWidget::renderNode(OctreeNode* node, const BoundingCube& cube
             ImGui::TextColored(ImVec4(nodeColor.r, nodeColor.g, nodeColor.b, 1.0f), "[lod=%d]", (int)child->getLod()); ImGui::SameLine();
             ImGui::TextColored(ImVec4(nodeColor.r, nodeColor.g, nodeColor.b, 1.0f), "[chunklod=%d]", (int)child->getChunkLod()); ImGui::SameLine();
             ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "v%u", child->version);
-            renderSdfInline(child);
+            renderSdfInline(child, childCube);
         } else {
             // Apply expand/collapse to children (single-frame, persistent, or collapse)
             if (applyRayOpenState) {
@@ -251,7 +251,7 @@ void OctreeExplorerWidget::renderNode(OctreeNode* node, const BoundingCube& cube
             ImGui::TextColored(ImVec4(nodeColor.r, nodeColor.g, nodeColor.b, 1.0f), "[lod=%d]", (int)child->getLod()); ImGui::SameLine();
             ImGui::TextColored(ImVec4(nodeColor.r, nodeColor.g, nodeColor.b, 1.0f), "[chunklod=%d]", (int)child->getChunkLod()); ImGui::SameLine();
             ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "v%u", child->version);
-            renderSdfInline(child);
+            renderSdfInline(child, childCube);
             
             if (isExpanded) {
                 // Track this cube as expanded for debug visualization
@@ -263,15 +263,18 @@ void OctreeExplorerWidget::renderNode(OctreeNode* node, const BoundingCube& cube
     }
 }
 
-void OctreeExplorerWidget::renderSdfInline(const OctreeNode* node) {
+void OctreeExplorerWidget::renderSdfInline(const OctreeNode* node, const BoundingCube& cube) {
     if (!showSdf || !node) return;
 
+    float sdf[8];
+    node->getSDF(sdf);
+
     float sMin = std::numeric_limits<float>::max();
     float sMax = -std::numeric_limits<float>::max();
     int farCount = 0;
     int negCount = 0;
     for (int i = 0; i < 8; ++i) {
-        const float v = node->sdf[i];
+        const float v = sdf[i];
         if (v == INFINITY || !std::isfinite(v)) {
             ++farCount;
             continue;
@@ -296,12 +299,13 @@ void OctreeExplorerWidget::renderSdfInline(const OctreeNode* node) {
     }
     if (ImGui::IsItemHovered()) {
         ImGui::BeginTooltip();
-        ImGui::Text("Vertex: (%.2f, %.2f, %.2f)", node->vertex.position.x, node->vertex.position.y, node->vertex.position.z);
+        const glm::vec3 position = node->getPosition(cube);
+        ImGui::Text("Vertex: (%.2f, %.2f, %.2f)", position.x, position.y, position.z);
         for (int i = 0; i < 8; i += 2) {
             auto fmt = [&](int c) {
-                if (node->sdf[c] == INFINITY) return std::string("FAR");
-                if (!std::isfinite(node->sdf[c])) return std::string("NaN");
-                return std::to_string(node->sdf[c]);
+                if (sdf[c] == INFINITY) return std::string("FAR");
+                if (!std::isfinite(sdf[c])) return std::string("NaN");
+                return std::to_string(sdf[c]);
             };
             ImGui::Text("c%d=%s  c%d=%s", i, fmt(i).c_str(), i + 1, fmt(i + 1).c_str());
         }
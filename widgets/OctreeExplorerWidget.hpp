@@ -57,7 +57,7 @@ private:
 
     void renderTree(const Octree& tree);
     void renderNode(OctreeNode* node, const BoundingCube& cube, int depth, OctreeAllocator* allocator, ImGuiTreeNodeFlags extraFlags = 0);
-    void renderSdfInline(const OctreeNode* node);
+    void renderSdfInline(const OctreeNode* node, const BoundingCube& cube);
     void handleRayExpandShortcut(const Octree& tree);
     bool buildMouseRay(const Octree& tree, Ray& outRay) const;
     bool updateRayOpenStateRecursive(OctreeNode* node, const BoundingCube& cube, OctreeAllocator* allocator, const Ray& ray);
@@ -1295,6 +1295,29 @@ void RenderTargetsWidget::render() {
     }
     if (selectedPreview == PreviewTarget::ShadowCascade) {
         ImGui::SliderInt("Cascade", &selectedShadowCascade, 0, SHADOW_CASCADE_COUNT - 1);
+        if (shadowMapper) {
+            // CPU cost of recording each cascade's draws (on a worker thread
+            // when parallel recording is enabled) and of the whole shadow pass.
+            ImGui::Text("Record (ms, %s, %zu workers):",
+                        shadowMapper->isParallelRecording() ? "parallel" : "inline",
+                        shadowMapper->getRecordWorkerCount());
+            for (uint32_t c = 0; c < SHADOW_CASCADE_COUNT; ++c) {
+                ImGui::SameLine();
+                ImGui::Text("C%u %.3f", c, shadowMapper->getCascadeRecordMs(c));
+            }
+            ImGui::SameLine();
+            ImGui::Text("| pass %.3f", shadowMapper->getRecordWallMs());
+        }
+    }
+    if (isSolid360Preview() && sceneRenderer && sceneRenderer->solid360Renderer) {
+        // CPU cost of recording each refreshed face's draws (depth pre-pass
+        // plus colour pass).
+        const Solid360Renderer* cube = sceneRenderer->solid360Renderer.get();
+        ImGui::Text("Record (ms, %s):", cube->isParallelRecording() ? "parallel" : "inline");
+        for (uint32_t f = 0; f < 6; ++f) {
+            ImGui::SameLine();
+            ImGui::Text("F%u %.3f", f, cube->getFaceRecordMs(f));
+        }
     }
     ImGui::Text("Shadow View"); ImGui::SameLine();
     if (ImGui::RadioButton("Linearized", shadowViewMode == RenderTargetsWidget::ShadowViewMode::Linearized)) {
@@ -18,6 +18,15 @@ void SettingsWidget::render() {
 
         }
         ImGuiHelpers::SetTooltipIfHovered("Globally enable or disable all shadowing");
+        static const char* shadowModeNames[] = { "EVSM Cascades", "Virtual Shadow Map" };
+        ImGui::Combo("Shadow Mode", &settings.shadowMode, shadowModeNames, IM_ARRAYSIZE(shadowModeNames));
+        ImGuiHelpers::SetTooltipIfHovered("Virtual: sparse clipmapped pages allocated where the camera sees geometry and cached across frames");
+        if (settings.shadowMode == 1) {
+            ImGui::SliderInt("Pages Per Frame", &settings.virtualShadowPageBudget, 1, 32);
+            ImGuiHelpers::SetTooltipIfHovered("Maximum virtual shadow pages rendered each frame");
+        }
+        ImGui::Checkbox("Parallel Shadow Recording", &settings.parallelShadowRecording);
+        ImGuiHelpers::SetTooltipIfHovered("Record the cascade draws into secondary command buffers on worker threads");
         if (ImGui::Button("Dump Shadow Depth")) {
             if (onDumpShadowDepth) onDumpShadowDepth();
         }
@@ -25,9 +34,22 @@ void SettingsWidget::render() {
         if (shadowParams) {
             ImGui::SliderFloat("Base Ortho Size", &shadowParams->orthoSize, 10.0f, 2048.0f, "%.0f");
             ImGuiHelpers::SetTooltipIfHovered("Shadow camera orthographic size for the base cascade");
+            ImGui::Checkbox("Cache Far Cascades", &shadowParams->cacheCascades);
+            ImGuiHelpers::SetTooltipIfHovered("Re-render cascades with a refresh interval > 1 only when the camera leaves their window, the light turns, an edit touches them, or the interval elapses");
             for (int i = 0; i < SHADOW_CASCADE_COUNT; i++) {
+                ImGui::PushID(i);
+                int interval = static_cast<int>(shadowParams->refreshInterval[i]);
                 ImGui::Text("  Cascade %d", i);
+                ImGui::SameLine();
+                if (ImGui::SliderInt("Refresh Interval", &interval, 1, 60)) {
+                    shadowParams->refreshInterval[i] = static_cast<uint32_t>(interval);
+                }
+                ImGui::SameLine();
+                ImGui::Text("age %u", shadowParams->framesSinceRender(i));
+                ImGui::PopID();
             }
+            ImGui::SliderFloat("Cache Guard Band", &shadowParams->cacheGuardBand, 0.0f, 0.5f, "%.2f");
+            ImGuiHelpers::SetTooltipIfHovered("Extra coverage of cached cascades; larger values re-render less often at lower resolution");
         }
 
         ImGui::Separator();
@@ -54,6 +76,13 @@ void SettingsWidget::render() {
         ImGui::DragFloat("Impostor Distance", &settings.impostorDistance, 5.0f, 0.0f, 5000.0f, "%.0f m");
         ImGuiHelpers::SetTooltipIfHovered("Beyond this distance vegetation is replaced by pre-captured impostors.\nSet to 0 to disable impostor rendering.");
         if (settings.impostorDistance < 0.0f) settings.impostorDistance = 0.0f;
+        static const char* impostorLayoutNames[] = { "Fibonacci (20 views)", "Octahedral" };
+        ImGui::Combo("Impostor Layout", &settings.impostorLayout, impostorLayoutNames, IM_ARRAYSIZE(impostorLayoutNames));
+        ImGuiHelpers::SetTooltipIfHovered("Octahedral: grid of views blended across the 3 nearest frames (no popping).\nChanging the layout re-captures missing types; results are cached on disk.");
+        if (settings.impostorLayout == 1) {
+            ImGui::SliderInt("Octahedral Grid", &settings.impostorGrid, 2, 16);
+            ImGuiHelpers::SetTooltipIfHovered("Frames per side of the octahedral atlas (1024px per type, split evenly)");
+        }
 
         ImGui::Separator();
 
@@ -69,6 +98,13 @@ void SettingsWidget::render() {
                 // toggled
             }
             ImGuiHelpers::SetTooltipIfHovered("When off, water passes are skipped and only the solid scene is composited");
+            ImGui::SliderInt("Cubemap Faces/Frame", &settings.cubemapFacesPerFrame, 1, 6);
+            ImGuiHelpers::SetTooltipIfHovered("Reflection cubemap faces re-rendered per frame (6 = all faces every frame).\nFaces captured far from the camera are always refreshed.");
+            static const char* cubemapUpdateModeNames[] = { "Round-robin", "Camera motion priority" };
+            ImGui::Combo("Cubemap Update", &settings.cubemapUpdateMode, cubemapUpdateModeNames, IM_ARRAYSIZE(cubemapUpdateModeNames));
+            ImGuiHelpers::SetTooltipIfHovered("Camera motion priority refreshes the stalest faces first, favouring those facing the direction of travel");
+            ImGui::Checkbox("Parallel Cubemap Recording", &settings.parallelCubemapRecording);
+            ImGuiHelpers::SetTooltipIfHovered("Record the cubemap face draws into secondary command buffers on worker threads");
             if (ImGui::Checkbox("Render Vegetation", &settings.vegetationEnabled)) {
                 // toggled
             }
@@ -143,6 +179,53 @@ void SettingsWidget::render() {
             "detail farther away (more triangles); smaller = coarser meshes "
             "closer (fewer triangles). 0 = always coarsest, 64+ = full detail "
             "everywhere.");
+        ImGui::SliderFloat("Geomorph Band", &settings.geomorphBand, 0.0f, 1.0f, "%.2f");
+        ImGuiHelpers::SetTooltipIfHovered(
+            "Fraction of each LoD distance band over which vertices blend "
+            "toward the next coarser level, hiding the switch. 0 = discrete "
+            "switching (visible popping); with geomorphing on, the distance "
+            "bias can be lowered for the same visual quality.");
+        static const char* ladderSimplifierNames[] = { "Octree", "Quadric Collapse" };
+        ImGui::Combo("LoD Simplifier", &settings.ladderSimplifier, ladderSimplifierNames, IM_ARRAYSIZE(ladderSimplifierNames));
+        ImGuiHelpers::SetTooltipIfHovered(
+            "How coarse LoD levels are built on the CPU. Octree: each level is "
+            "tessellated at its own resolution. Quadric Collapse: each level is "
+            "tessellated one level finer and simplified by edge collapse, "
+            "keeping detail on curved terrain and fewer triangles on flat "
+            "ground. Applies to chunks generated after the change.");
+        ImGui::Checkbox("Optimize Chunk Meshes", &settings.optimizeChunkMeshes);
+        ImGuiHelpers::SetTooltipIfHovered(
+            "Reorder generated chunk meshes for the GPU vertex cache, overdraw "
+            "and vertex fetch on the worker threads. Applies to chunks "
+            "generated after the change.");
+        ImGui::Checkbox("GPU Chunk Meshing", &settings.gpuMeshing);
+        ImGuiHelpers::SetTooltipIfHovered(
+            "Mesh uniformly refined solid chunks with a Surface Nets compute "
+            "shader instead of the CPU tessellator. Other chunks, water and "
+            "brushes stay on the CPU. Applies to chunks generated after the "
+            "change; the kernel is only built when enabled at startup.");
+        ImGui::SliderInt("Octree Memory Budget", &settings.octreeMemoryBudgetMB, 0, 8192, "%d MB");
+        ImGuiHelpers::SetTooltipIfHovered(
+            "Octree nodes kept in RAM per layer. Past the budget, chunks idle "
+            "longest beyond the paging distance are written to disk and read "
+            "back when walked, edited or approached. 0 = no paging.");
+        ImGui::DragFloat("Paging Distance", &settings.pagingDistance, 16.0f, 0.0f, 100000.0f, "%.0f m");
+        ImGuiHelpers::SetTooltipIfHovered(
+            "Chunks closer to the camera than this always stay in memory.");
+        ImGui::SliderInt("Autosave Interval", &settings.autosaveSeconds, 0, 600, "%d s");
+        ImGuiHelpers::SetTooltipIfHovered(
+            "Once the scene has been saved or loaded, append the chunks edited "
+            "since the last autosave to its journal in the background. "
+            "0 = off.");
+        ImGui::SliderInt("Journal Compaction", &settings.journalCompactMB, 0, 1024, "%d MB");
+        ImGuiHelpers::SetTooltipIfHovered(
+            "Rewrite the scene file and start a new journal once the journal "
+            "grows past this size. 0 = only when needed.");
+        ImGui::Checkbox("Octree Compaction", &settings.octreeCompaction);
+        ImGuiHelpers::SetTooltipIfHovered(
+            "After heavy editing, rebuild the octree nodes one chunk at a time "
+            "on a background thread so each chunk is contiguous in memory, "
+            "and return emptied allocator blocks to the system.");
 
         if (ImGui::Button("Reset to Defaults")) {
             resetToDefaults();